@@ -0,0 +1,440 @@
+#include <EtFramework/stdafx.h>
+#include "Benchmark.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+#include <EtCore/FileSystem/Json/JsonParser.h>
+
+
+namespace et {
+namespace bench {
+
+
+namespace detail {
+
+	//---------------------------------
+	// UseCharPointer
+	//
+	// Defined out of line so the compiler has to assume the value is read
+	//
+	void UseCharPointer(char const volatile* const ptr)
+	{
+		static char const volatile* s_Sink = nullptr;
+		s_Sink = ptr;
+	}
+
+	//---------------------------------
+	// FormatDuration
+	//
+	// Human readable duration with a unit that keeps the number short
+	//
+	std::string FormatDuration(double const ns)
+	{
+		if (ns >= 1000000000.0)
+		{
+			return FS("%.2f s", ns / 1000000000.0);
+		}
+		else if (ns >= 1000000.0)
+		{
+			return FS("%.2f ms", ns / 1000000.0);
+		}
+		else if (ns >= 1000.0)
+		{
+			return FS("%.2f us", ns / 1000.0);
+		}
+
+		return FS("%.1f ns", ns);
+	}
+
+	//---------------------------------
+	// AppendJsonString
+	//
+	void AppendJsonString(std::ostringstream& stream, std::string const& str)
+	{
+		stream << '"';
+		for (char const c : str)
+		{
+			if ((c == '"') || (c == '\\'))
+			{
+				stream << '\\';
+			}
+
+			stream << c;
+		}
+
+		stream << '"';
+	}
+
+	//---------------------------------
+	// WriteTextFile
+	//
+	// Create or overwrite a file with text content
+	//
+	bool WriteTextFile(std::string const& filePath, std::string const& text)
+	{
+		core::File* file = new core::File(filePath, nullptr);
+
+		core::FILE_ACCESS_FLAGS outFlags;
+		outFlags.SetFlags(core::FILE_ACCESS_FLAGS::FLAGS::Create | core::FILE_ACCESS_FLAGS::FLAGS::Exists | core::FILE_ACCESS_FLAGS::FLAGS::Truncate);
+
+		bool success = file->Open(core::FILE_ACCESS_MODE::Write, outFlags);
+		if (success)
+		{
+			success = file->Write(core::FileUtil::FromText(text));
+		}
+
+		if (!success)
+		{
+			std::cerr << "WriteTextFile > unable to write to '" << filePath << "'" << std::endl;
+		}
+
+		SafeDelete(file);
+		return success;
+	}
+
+} // namespace detail
+
+
+//=========
+// Context
+//=========
+
+
+//---------------------------------
+// Context::Skip
+//
+// For benchmarks that can't run in the current environment, e.g because no data directory was provided
+//
+void Context::Skip(std::string const& reason)
+{
+	m_WasSkipped = true;
+	m_SkipReason = reason;
+}
+
+//---------------------------------
+// Context::ToNs
+//
+uint64 Context::ToNs(T_Clock::duration const duration)
+{
+	return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+
+//==============
+// Registration
+//==============
+
+
+//---------------------------------
+// GetRegistrations
+//
+// Function local so that registration works regardless of static initialization order
+//
+std::vector<Registration>& GetRegistrations()
+{
+	static std::vector<Registration> registrations;
+	return registrations;
+}
+
+//---------------------------------
+// Registrar::c-tor
+//
+Registrar::Registrar(char const* const name, char const* const group, T_BenchmarkFn const fn)
+{
+	GetRegistrations().push_back(Registration{ std::string(name), std::string(group), fn });
+}
+
+
+//=======================
+// Running and Reporting
+//=======================
+
+
+//---------------------------------
+// RunBenchmarks
+//
+// Run all registered benchmarks matching the filter, sorted by group so related results are listed together
+//
+std::vector<Statistics> RunBenchmarks(Settings const& settings)
+{
+	std::vector<Registration> registrations = GetRegistrations();
+	std::stable_sort(registrations.begin(), registrations.end(), [](Registration const& lhs, Registration const& rhs)
+		{
+			return lhs.group < rhs.group;
+		});
+
+	std::vector<Statistics> results;
+	for (Registration const& reg : registrations)
+	{
+		if (!settings.filter.empty()
+			&& (reg.name.find(settings.filter) == std::string::npos)
+			&& (reg.group.find(settings.filter) == std::string::npos))
+		{
+			continue;
+		}
+
+		std::cout << "[" << reg.group << "] " << reg.name << " ..." << std::endl;
+
+		Context context(settings);
+		reg.fn(context);
+
+		if (context.WasSkipped())
+		{
+			std::cout << "\tskipped: " << context.GetSkipReason() << std::endl;
+			continue;
+		}
+
+		if (!context.HasRun())
+		{
+			std::cerr << "\tbenchmark didn't run any iterations" << std::endl;
+			continue;
+		}
+
+		Statistics stats = ComputeStatistics(context.GetSamples());
+		stats.name = reg.name;
+		stats.group = reg.group;
+		stats.iterationsPerSample = context.GetIterationsPerSample();
+		if ((context.GetItemsPerIteration() > 0u) && (stats.median > 0.0))
+		{
+			stats.itemsPerSecond = static_cast<double>(context.GetItemsPerIteration()) * 1000000000.0 / stats.median;
+		}
+
+		results.push_back(stats);
+	}
+
+	return results;
+}
+
+//---------------------------------
+// ComputeStatistics
+//
+// Median and percentiles are robust against outliers caused by the OS, so comparisons should use those over the mean
+//
+Statistics ComputeStatistics(std::vector<double> samples)
+{
+	Statistics stats;
+	if (samples.empty())
+	{
+		return stats;
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	size_t const count = samples.size();
+	stats.sampleCount = static_cast<uint32>(count);
+	stats.min = samples.front();
+
+	stats.median = ((count % 2u) == 0u) ? ((samples[count / 2u - 1u] + samples[count / 2u]) * 0.5) : samples[count / 2u];
+
+	// nearest rank percentile
+	size_t const p99Rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(count)));
+	stats.p99 = samples[std::max(p99Rank, static_cast<size_t>(1u)) - 1u];
+
+	double sum = 0.0;
+	for (double const sample : samples)
+	{
+		sum += sample;
+	}
+
+	stats.mean = sum / static_cast<double>(count);
+
+	double variance = 0.0;
+	for (double const sample : samples)
+	{
+		variance += (sample - stats.mean) * (sample - stats.mean);
+	}
+
+	stats.stdDev = std::sqrt(variance / static_cast<double>(count));
+
+	return stats;
+}
+
+//---------------------------------
+// PrintResults
+//
+// Table of results to the standard output
+//
+void PrintResults(std::vector<Statistics> const& results)
+{
+	std::cout << std::endl
+		<< std::left << std::setw(44) << "benchmark"
+		<< std::right << std::setw(12) << "median"
+		<< std::setw(12) << "p99"
+		<< std::setw(12) << "mean"
+		<< std::setw(12) << "min"
+		<< std::setw(9) << "stddev"
+		<< std::setw(16) << "items/s"
+		<< std::setw(14) << "samples" << std::endl;
+
+	std::cout << std::string(131, '-') << std::endl;
+
+	for (Statistics const& stats : results)
+	{
+		std::string const relStdDev = (stats.mean > 0.0) ? FS("%.1f%%", 100.0 * stats.stdDev / stats.mean) : std::string("-");
+		std::string const throughput = (stats.itemsPerSecond > 0.0) ? FS("%.3e", stats.itemsPerSecond) : std::string("-");
+		std::string const samples = FS("%u x %llu", stats.sampleCount, static_cast<unsigned long long>(stats.iterationsPerSample));
+
+		std::cout << std::left << std::setw(44) << (stats.group + "/" + stats.name)
+			<< std::right << std::setw(12) << detail::FormatDuration(stats.median)
+			<< std::setw(12) << detail::FormatDuration(stats.p99)
+			<< std::setw(12) << detail::FormatDuration(stats.mean)
+			<< std::setw(12) << detail::FormatDuration(stats.min)
+			<< std::setw(9) << relStdDev
+			<< std::setw(16) << throughput
+			<< std::setw(14) << samples << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+//---------------------------------
+// WriteCsv
+//
+// One line per benchmark, timings in nanoseconds
+//
+bool WriteCsv(std::vector<Statistics> const& results, std::string const& filePath)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(3);
+	stream << "name,group,samples,iterations,min_ns,median_ns,mean_ns,p99_ns,stddev_ns,items_per_second\n";
+
+	for (Statistics const& stats : results)
+	{
+		stream << '"' << stats.name << "\",\"" << stats.group << "\","
+			<< stats.sampleCount << ',' << stats.iterationsPerSample << ','
+			<< stats.min << ',' << stats.median << ',' << stats.mean << ',' << stats.p99 << ',' << stats.stdDev << ','
+			<< stats.itemsPerSecond << '\n';
+	}
+
+	return detail::WriteTextFile(filePath, stream.str());
+}
+
+//---------------------------------
+// WriteJson
+//
+// The written file can be used as a baseline for later runs
+//
+bool WriteJson(std::vector<Statistics> const& results, std::string const& filePath)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(3);
+	stream << "{\n\t\"benchmarks\": [";
+
+	for (size_t resultIdx = 0u; resultIdx < results.size(); ++resultIdx)
+	{
+		Statistics const& stats = results[resultIdx];
+
+		stream << ((resultIdx == 0u) ? "\n" : ",\n") << "\t\t{\"name\": ";
+		detail::AppendJsonString(stream, stats.name);
+		stream << ", \"group\": ";
+		detail::AppendJsonString(stream, stats.group);
+		stream << ", \"samples\": " << stats.sampleCount
+			<< ", \"iterations\": " << stats.iterationsPerSample
+			<< ", \"min_ns\": " << stats.min
+			<< ", \"median_ns\": " << stats.median
+			<< ", \"mean_ns\": " << stats.mean
+			<< ", \"p99_ns\": " << stats.p99
+			<< ", \"stddev_ns\": " << stats.stdDev
+			<< ", \"items_per_second\": " << stats.itemsPerSecond << "}";
+	}
+
+	stream << "\n\t]\n}\n";
+
+	return detail::WriteTextFile(filePath, stream.str());
+}
+
+//---------------------------------
+// LoadBaseline
+//
+// Read the medians of a previously written json result file
+//
+bool LoadBaseline(std::string const& filePath, T_Baseline& outBaseline)
+{
+	core::File* file = new core::File(filePath, nullptr);
+	if (!file->Open(core::FILE_ACCESS_MODE::Read))
+	{
+		std::cerr << "LoadBaseline > unable to open '" << filePath << "'" << std::endl;
+		SafeDelete(file);
+		return false;
+	}
+
+	core::JSON::Parser parser(core::FileUtil::AsText(file->Read()));
+	SafeDelete(file);
+
+	core::JSON::Object* const root = parser.GetRoot();
+	core::JSON::Value* const benchmarks = (root != nullptr) ? (*root)["benchmarks"] : nullptr;
+	if ((benchmarks == nullptr) || (benchmarks->GetType() != core::JSON::JSON_Array))
+	{
+		std::cerr << "LoadBaseline > '" << filePath << "' doesn't contain a benchmark list" << std::endl;
+		return false;
+	}
+
+	for (core::JSON::Value* const benchVal : benchmarks->arr()->value)
+	{
+		if (benchVal->GetType() != core::JSON::JSON_Object)
+		{
+			continue;
+		}
+
+		core::JSON::Object* const benchObj = benchVal->obj();
+
+		std::string name;
+		double median = 0.0;
+		if (core::JSON::ApplyStrValue(benchObj, name, "name") && core::JSON::ApplyNumValue(benchObj, median, "median_ns"))
+		{
+			outBaseline[name] = median;
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------
+// CompareToBaseline
+//
+// Compare medians against the baseline, and return how many benchmarks got slower by more than the threshold
+//
+uint32 CompareToBaseline(std::vector<Statistics> const& results, T_Baseline const& baseline, double const thresholdPercent)
+{
+	std::cout << "comparison to baseline (threshold " << thresholdPercent << "%):" << std::endl;
+
+	uint32 regressionCount = 0u;
+	for (Statistics const& stats : results)
+	{
+		auto const foundIt = baseline.find(stats.name);
+		if ((foundIt == baseline.cend()) || (foundIt->second <= 0.0))
+		{
+			std::cout << "\t" << std::left << std::setw(44) << stats.name << " new" << std::endl;
+			continue;
+		}
+
+		double const changePercent = 100.0 * (stats.median - foundIt->second) / foundIt->second;
+
+		std::string verdict;
+		if (changePercent > thresholdPercent)
+		{
+			verdict = "REGRESSION";
+			++regressionCount;
+		}
+		else if (changePercent < -thresholdPercent)
+		{
+			verdict = "improved";
+		}
+
+		std::cout << "\t" << std::left << std::setw(44) << stats.name
+			<< std::right << std::setw(12) << detail::FormatDuration(foundIt->second) << " -> "
+			<< std::setw(12) << detail::FormatDuration(stats.median)
+			<< std::setw(10) << FS("%+.1f%%", changePercent) << "  " << verdict << std::endl;
+	}
+
+	std::cout << std::endl;
+	return regressionCount;
+}
+
+
+} // namespace bench
+} // namespace et
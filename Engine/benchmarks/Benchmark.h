@@ -0,0 +1,181 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace et {
+namespace bench {
+
+
+//---------------------------------
+// Settings
+//
+// Controls which benchmarks run and how many samples are taken
+//
+struct Settings final
+{
+	std::string filter; // substring of the benchmark name or group, empty runs everything
+	uint32 sampleCount = 100u;
+	uint64 minSampleNs = 1000000u; // fast benchmarks repeat within a sample until it takes at least this long
+	uint32 maxSetupSamples = 50u; // benchmarks with per sample setup are usually expensive, so they take fewer samples
+};
+
+//---------------------------------
+// Statistics
+//
+// Results of a single benchmark - timings are per iteration in nanoseconds
+//
+struct Statistics final
+{
+	std::string name;
+	std::string group;
+
+	uint32 sampleCount = 0u;
+	uint64 iterationsPerSample = 0u;
+
+	double min = 0.0;
+	double median = 0.0;
+	double mean = 0.0;
+	double p99 = 0.0;
+	double stdDev = 0.0;
+
+	double itemsPerSecond = 0.0; // 0 if the benchmark doesn't declare items per iteration
+};
+
+typedef std::unordered_map<std::string, double> T_Baseline; // benchmark name -> median ns
+
+
+//---------------------------------
+// Context
+//
+// Passed to every benchmark - untimed setup code can run before or around the timed section
+//  - a benchmark calls exactly one of Run, RunWithSetup or Skip
+//
+class Context final
+{
+	// definitions
+	//-------------
+	typedef std::chrono::steady_clock T_Clock;
+
+public:
+	// construct destruct
+	//--------------------
+	Context(Settings const& settings) : m_Settings(settings) {}
+
+	// functionality
+	//---------------
+	void SetItemsPerIteration(uint64 const items) { m_ItemsPerIteration = items; } // for throughput reporting, e.g entities processed per iteration
+
+	template<typename TFn>
+	void Run(TFn&& fn);
+
+	template<typename TSetupFn, typename TFn>
+	void RunWithSetup(TSetupFn&& setup, TFn&& fn); // setup runs untimed before every single iteration
+
+	void Skip(std::string const& reason);
+
+	// accessors
+	//-----------
+	bool HasRun() const { return !m_Samples.empty(); }
+	bool WasSkipped() const { return m_WasSkipped; }
+	std::string const& GetSkipReason() const { return m_SkipReason; }
+
+	std::vector<double> const& GetSamples() const { return m_Samples; }
+	uint64 GetIterationsPerSample() const { return m_IterationsPerSample; }
+	uint64 GetItemsPerIteration() const { return m_ItemsPerIteration; }
+
+	// utility
+	//---------
+private:
+	static uint64 ToNs(T_Clock::duration const duration);
+
+	// Data
+	///////
+
+	Settings const& m_Settings;
+
+	std::vector<double> m_Samples; // ns per iteration
+	uint64 m_IterationsPerSample = 0u;
+	uint64 m_ItemsPerIteration = 0u;
+
+	bool m_WasSkipped = false;
+	std::string m_SkipReason;
+};
+
+
+typedef void(*T_BenchmarkFn)(Context&);
+
+//---------------------------------
+// Registration
+//
+// A benchmark function with its name, collected at static initialization time
+//
+struct Registration final
+{
+	std::string name;
+	std::string group;
+	T_BenchmarkFn fn;
+};
+
+std::vector<Registration>& GetRegistrations();
+
+//---------------------------------
+// Registrar
+//
+// Static instances of this add a benchmark to the registry, use through the ET_BENCHMARK macro
+//
+struct Registrar final
+{
+	Registrar(char const* const name, char const* const group, T_BenchmarkFn const fn);
+};
+
+
+// running and reporting
+//-----------------------
+std::vector<Statistics> RunBenchmarks(Settings const& settings);
+Statistics ComputeStatistics(std::vector<double> samples);
+
+void PrintResults(std::vector<Statistics> const& results);
+bool WriteCsv(std::vector<Statistics> const& results, std::string const& filePath);
+bool WriteJson(std::vector<Statistics> const& results, std::string const& filePath);
+
+bool LoadBaseline(std::string const& filePath, T_Baseline& outBaseline);
+uint32 CompareToBaseline(std::vector<Statistics> const& results, T_Baseline const& baseline, double const thresholdPercent);
+
+
+//---------------------------------
+// DoNotOptimize
+//
+// Prevent the compiler from discarding the computation of a value that is otherwise unused
+//
+namespace detail {
+	void UseCharPointer(char const volatile* const ptr);
+} // namespace detail
+
+template<typename T>
+void DoNotOptimize(T const& value)
+{
+	detail::UseCharPointer(reinterpret_cast<char const volatile*>(&value));
+}
+
+
+} // namespace bench
+} // namespace et
+
+
+#define ET_BENCHMARK_CONCAT_INNER(lhs, rhs) lhs##rhs
+#define ET_BENCHMARK_CONCAT(lhs, rhs) ET_BENCHMARK_CONCAT_INNER(lhs, rhs)
+
+#define ET_BENCHMARK_IMPL(fnName, name, group) \
+	static void fnName(et::bench::Context& context); \
+	static et::bench::Registrar const ET_BENCHMARK_CONCAT(fnName, Registrar)(name, group, &fnName); \
+	static void fnName(et::bench::Context& context)
+
+// declares a benchmark function with a 'context' parameter, e.g ET_BENCHMARK("slot_map insert", "containers") { context.Run(...); }
+#define ET_BENCHMARK(name, group) ET_BENCHMARK_IMPL(ET_BENCHMARK_CONCAT(EtBenchmark, __LINE__), name, group)
+
+
+#include "Benchmark.inl"
@@ -0,0 +1,87 @@
+#pragma once
+
+
+namespace et {
+namespace bench {
+
+
+//=========
+// Context
+//=========
+
+
+//---------------------------------
+// Context::Run
+//
+// Time fn repeatedly
+//  - the number of iterations per sample doubles until a sample takes at least the minimum sample duration, which also warms caches up
+//
+template<typename TFn>
+void Context::Run(TFn&& fn)
+{
+	ET_ASSERT(!HasRun(), "benchmarks should only call Run once");
+
+	uint64 iterations = 1u;
+	for (;;)
+	{
+		T_Clock::time_point const start = T_Clock::now();
+		for (uint64 idx = 0u; idx < iterations; ++idx)
+		{
+			fn();
+		}
+
+		if ((ToNs(T_Clock::now() - start) >= m_Settings.minSampleNs) || (iterations >= (1u << 30)))
+		{
+			break;
+		}
+
+		iterations *= 2u;
+	}
+
+	m_IterationsPerSample = iterations;
+	m_Samples.reserve(m_Settings.sampleCount);
+
+	for (uint32 sampleIdx = 0u; sampleIdx < m_Settings.sampleCount; ++sampleIdx)
+	{
+		T_Clock::time_point const start = T_Clock::now();
+		for (uint64 idx = 0u; idx < iterations; ++idx)
+		{
+			fn();
+		}
+
+		m_Samples.push_back(static_cast<double>(ToNs(T_Clock::now() - start)) / static_cast<double>(iterations));
+	}
+}
+
+//---------------------------------
+// Context::RunWithSetup
+//
+// Time single iterations of fn, each preceded by an untimed call to setup - for benchmarks that consume their input, e.g destroying entities
+//
+template<typename TSetupFn, typename TFn>
+void Context::RunWithSetup(TSetupFn&& setup, TFn&& fn)
+{
+	ET_ASSERT(!HasRun(), "benchmarks should only call Run once");
+
+	// warm up
+	setup();
+	fn();
+
+	uint32 const sampleCount = std::min(m_Settings.sampleCount, m_Settings.maxSetupSamples);
+
+	m_IterationsPerSample = 1u;
+	m_Samples.reserve(sampleCount);
+
+	for (uint32 sampleIdx = 0u; sampleIdx < sampleCount; ++sampleIdx)
+	{
+		setup();
+
+		T_Clock::time_point const start = T_Clock::now();
+		fn();
+		m_Samples.push_back(static_cast<double>(ToNs(T_Clock::now() - start)));
+	}
+}
+
+
+} // namespace bench
+} // namespace et
@@ -0,0 +1,209 @@
+#include <EtFramework/stdafx.h>
+
+#include <unordered_map>
+
+#include <Benchmark.h>
+
+#include <EtCore/Containers/slot_map.h>
+#include <EtCore/Containers/linear_hash_map.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	size_t const s_ElementCount = 10000u;
+	uint32 const s_EmptyKey = 0u;
+
+	//---------------------------------
+	// GenKeys
+	//
+	// Deterministic pseudo random keys (xorshift), never the empty key
+	//
+	std::vector<uint32> GenKeys(size_t const count)
+	{
+		std::vector<uint32> keys;
+		keys.reserve(count);
+
+		uint32 state = 2463534242u;
+		while (keys.size() < count)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+
+			if (state != s_EmptyKey)
+			{
+				keys.push_back(state);
+			}
+		}
+
+		return keys;
+	}
+
+	struct BenchElement final
+	{
+		mat4 transform;
+		uint32 value = 0u;
+	};
+
+} // namespace
+
+
+// slot map
+//**********
+
+ET_BENCHMARK("slot_map insert erase", "containers")
+{
+	core::slot_map<BenchElement> map;
+	map.reserve(s_ElementCount);
+
+	std::vector<core::T_SlotId> ids(s_ElementCount);
+
+	context.SetItemsPerIteration(s_ElementCount * 2u);
+	context.Run([&map, &ids]()
+		{
+			for (size_t idx = 0u; idx < s_ElementCount; ++idx)
+			{
+				BenchElement element;
+				element.value = static_cast<uint32>(idx);
+				ids[idx] = map.insert(std::move(element)).second;
+			}
+
+			// erase every other element first so that erasing shuffles data around
+			for (size_t idx = 0u; idx < s_ElementCount; idx += 2u)
+			{
+				map.erase(ids[idx]);
+			}
+
+			for (size_t idx = 1u; idx < s_ElementCount; idx += 2u)
+			{
+				map.erase(ids[idx]);
+			}
+		});
+}
+
+ET_BENCHMARK("slot_map lookup", "containers")
+{
+	core::slot_map<BenchElement> map;
+
+	std::vector<core::T_SlotId> ids;
+	for (size_t idx = 0u; idx < s_ElementCount; ++idx)
+	{
+		BenchElement element;
+		element.value = static_cast<uint32>(idx);
+		ids.push_back(map.insert(std::move(element)).second);
+	}
+
+	std::vector<uint32> const order = GenKeys(s_ElementCount);
+
+	context.SetItemsPerIteration(s_ElementCount);
+	context.Run([&map, &ids, &order]()
+		{
+			uint32 sum = 0u;
+			for (uint32 const key : order)
+			{
+				sum += map[ids[key % s_ElementCount]].value;
+			}
+
+			bench::DoNotOptimize(sum);
+		});
+}
+
+ET_BENCHMARK("slot_map iterate", "containers")
+{
+	core::slot_map<BenchElement> map;
+	for (size_t idx = 0u; idx < s_ElementCount; ++idx)
+	{
+		BenchElement element;
+		element.value = static_cast<uint32>(idx);
+		map.insert(std::move(element));
+	}
+
+	context.SetItemsPerIteration(s_ElementCount);
+	context.Run([&map]()
+		{
+			uint32 sum = 0u;
+			for (BenchElement const& element : map)
+			{
+				sum += element.value;
+			}
+
+			bench::DoNotOptimize(sum);
+		});
+}
+
+
+// linear hash map
+//*****************
+
+ET_BENCHMARK("lin_hash_map insert", "containers")
+{
+	std::vector<uint32> const keys = GenKeys(s_ElementCount);
+
+	context.SetItemsPerIteration(s_ElementCount);
+	context.Run([&keys]()
+		{
+			core::lin_hash_map<uint32, uint32> map(s_ElementCount * 2u, s_EmptyKey);
+			for (uint32 const key : keys)
+			{
+				map.emplace(key, key);
+			}
+
+			bench::DoNotOptimize(map.size());
+		});
+}
+
+ET_BENCHMARK("lin_hash_map find", "containers")
+{
+	std::vector<uint32> const keys = GenKeys(s_ElementCount * 2u);
+
+	// only half of the keys are inserted so that lookups also miss
+	core::lin_hash_map<uint32, uint32> map(s_ElementCount * 2u, s_EmptyKey);
+	for (size_t idx = 0u; idx < s_ElementCount; ++idx)
+	{
+		map.emplace(keys[idx * 2u], static_cast<uint32>(idx));
+	}
+
+	context.SetItemsPerIteration(keys.size());
+	context.Run([&map, &keys]()
+		{
+			uint32 found = 0u;
+			for (uint32 const key : keys)
+			{
+				if (map.find(key) != map.end())
+				{
+					++found;
+				}
+			}
+
+			bench::DoNotOptimize(found);
+		});
+}
+
+ET_BENCHMARK("std::unordered_map find (reference)", "containers")
+{
+	std::vector<uint32> const keys = GenKeys(s_ElementCount * 2u);
+
+	std::unordered_map<uint32, uint32> map;
+	for (size_t idx = 0u; idx < s_ElementCount; ++idx)
+	{
+		map.emplace(keys[idx * 2u], static_cast<uint32>(idx));
+	}
+
+	context.SetItemsPerIteration(keys.size());
+	context.Run([&map, &keys]()
+		{
+			uint32 found = 0u;
+			for (uint32 const key : keys)
+			{
+				if (map.find(key) != map.end())
+				{
+					++found;
+				}
+			}
+
+			bench::DoNotOptimize(found);
+		});
+}
@@ -0,0 +1,241 @@
+#include <EtFramework/stdafx.h>
+
+#include <rttr/registration>
+
+#include <Benchmark.h>
+
+#include <EtFramework/ECS/EcsController.h>
+#include <EtFramework/ECS/ComponentView.h>
+#include <EtFramework/ECS/System.h>
+#include <EtFramework/Components/TransformComponent.h>
+#include <EtFramework/Systems/TransformSystem.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	size_t const s_EntityCount = 10000u;
+	size_t const s_StructuralChangeCount = 1000u;
+	size_t const s_TransformRootCount = 1000u;
+	size_t const s_TransformChildCount = 9u;
+
+} // namespace
+
+
+// Components
+//************
+
+struct BenchPositionComponent final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	vec3 position;
+};
+
+struct BenchVelocityComponent final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	vec3 velocity = vec3(1.f, 0.f, 0.f);
+};
+
+struct BenchTagComponent final
+{
+	ECS_DECLARE_COMPONENT
+public:
+	uint32 tag = 0u;
+};
+
+
+// reflection
+//------------
+
+RTTR_REGISTRATION
+{
+	using namespace rttr;
+
+	registration::class_<BenchPositionComponent>("bench position component")
+		.property("position", &BenchPositionComponent::position);
+
+	registration::class_<BenchVelocityComponent>("bench velocity component")
+		.property("velocity", &BenchVelocityComponent::velocity);
+
+	registration::class_<BenchTagComponent>("bench tag component")
+		.property("tag", &BenchTagComponent::tag);
+}
+
+ECS_REGISTER_COMPONENT(BenchPositionComponent);
+ECS_REGISTER_COMPONENT(BenchVelocityComponent);
+ECS_REGISTER_COMPONENT(BenchTagComponent);
+
+
+// Systems
+//*********
+
+struct BenchMoveView final : public fw::ComponentView
+{
+	BenchMoveView() : fw::ComponentView()
+	{
+		Declare(position);
+		Declare(velocity);
+	}
+
+	WriteAccess<BenchPositionComponent> position;
+	ReadAccess<BenchVelocityComponent> velocity;
+};
+
+class BenchMoveSystem final : public fw::System<BenchMoveSystem, BenchMoveView>
+{
+public:
+	BenchMoveSystem() = default;
+
+	void Process(fw::ComponentRange<BenchMoveView>& range) override
+	{
+		for (BenchMoveView& view : range)
+		{
+			view.position->position = view.position->position + view.velocity->velocity * 0.016f;
+		}
+	}
+};
+
+
+// Benchmarks
+//************
+
+ET_BENCHMARK("ecs spawn entities", "ecs")
+{
+	fw::EcsController ecs;
+
+	context.SetItemsPerIteration(s_EntityCount);
+	context.RunWithSetup([&ecs]()
+		{
+			ecs.RemoveAllEntities();
+		},
+		[&ecs]()
+		{
+			for (size_t idx = 0u; idx < s_EntityCount; ++idx)
+			{
+				BenchPositionComponent pos;
+				BenchVelocityComponent vel;
+				ecs.AddEntity(pos, vel);
+			}
+		});
+}
+
+ET_BENCHMARK("ecs remove entities", "ecs")
+{
+	fw::EcsController ecs;
+	std::vector<fw::T_EntityId> entities;
+
+	context.SetItemsPerIteration(s_EntityCount);
+	context.RunWithSetup([&ecs, &entities]()
+		{
+			entities.clear();
+			for (size_t idx = 0u; idx < s_EntityCount; ++idx)
+			{
+				BenchPositionComponent pos;
+				BenchVelocityComponent vel;
+				entities.push_back(ecs.AddEntity(pos, vel));
+			}
+		},
+		[&ecs, &entities]()
+		{
+			// reverse order matches how entities are usually torn down, children before parents
+			for (auto entIt = entities.crbegin(); entIt != entities.crend(); ++entIt)
+			{
+				ecs.RemoveEntity(*entIt);
+			}
+		});
+}
+
+ET_BENCHMARK("ecs iterate system", "ecs")
+{
+	fw::EcsController ecs;
+	ecs.RegisterSystem<BenchMoveSystem>();
+
+	for (size_t idx = 0u; idx < s_EntityCount; ++idx)
+	{
+		BenchPositionComponent pos;
+		BenchVelocityComponent vel;
+		ecs.AddEntity(pos, vel);
+	}
+
+	context.SetItemsPerIteration(s_EntityCount);
+	context.Run([&ecs]()
+		{
+			ecs.Process();
+		});
+}
+
+ET_BENCHMARK("ecs add remove component", "ecs")
+{
+	fw::EcsController ecs;
+
+	std::vector<fw::T_EntityId> entities;
+	for (size_t idx = 0u; idx < s_StructuralChangeCount; ++idx)
+	{
+		BenchPositionComponent pos;
+		BenchVelocityComponent vel;
+		entities.push_back(ecs.AddEntity(pos, vel));
+	}
+
+	// every iteration moves each entity to a new archetype and back
+	context.SetItemsPerIteration(s_StructuralChangeCount * 2u);
+	context.Run([&ecs, &entities]()
+		{
+			for (fw::T_EntityId const entity : entities)
+			{
+				BenchTagComponent tag;
+				ecs.AddComponents(entity, tag);
+			}
+
+			for (fw::T_EntityId const entity : entities)
+			{
+				ecs.RemoveComponents<BenchTagComponent>(entity);
+			}
+		});
+}
+
+ET_BENCHMARK("transform system hierachy", "ecs")
+{
+	fw::EcsController ecs;
+	fw::T_CompEventFn<fw::TransformComponent> onAdded(fw::TransformSystem::OnComponentAdded);
+	fw::T_CompEventFn<fw::TransformComponent> onRemoved(fw::TransformSystem::OnComponentRemoved);
+	ecs.RegisterOnComponentAdded(onAdded);
+	ecs.RegisterOnComponentRemoved(onRemoved);
+
+	ecs.RegisterSystem<fw::TransformSystem::Compute>();
+	ecs.RegisterSystem<fw::TransformSystem::Reset>();
+
+	std::vector<fw::T_EntityId> roots;
+	for (size_t rootIdx = 0u; rootIdx < s_TransformRootCount; ++rootIdx)
+	{
+		fw::TransformComponent rootTf;
+		rootTf.SetPosition(static_cast<float>(rootIdx), 0.f, 0.f);
+		fw::T_EntityId const root = ecs.AddEntity(rootTf);
+		roots.push_back(root);
+
+		for (size_t childIdx = 0u; childIdx < s_TransformChildCount; ++childIdx)
+		{
+			fw::TransformComponent childTf;
+			childTf.SetPosition(0.f, static_cast<float>(childIdx), 0.f);
+			ecs.AddEntityChild(root, childTf);
+		}
+	}
+
+	// moving the roots dirties the whole hierachy
+	context.SetItemsPerIteration(s_TransformRootCount * (s_TransformChildCount + 1u));
+	context.Run([&ecs, &roots]()
+		{
+			for (fw::T_EntityId const root : roots)
+			{
+				ecs.GetComponent<fw::TransformComponent>(root).Translate(0.f, 0.f, 0.01f);
+			}
+
+			ecs.Process();
+		});
+
+	ecs.RemoveAllEntities();
+}
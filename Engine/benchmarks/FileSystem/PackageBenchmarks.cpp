@@ -0,0 +1,160 @@
+#include <EtFramework/stdafx.h>
+
+#include <Benchmark.h>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+#include <EtCore/FileSystem/Package/FilePackage.h>
+#include <EtCore/FileSystem/Package/PackageDataStructure.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	size_t const s_PackageEntryCount = 256u;
+	size_t const s_PackageEntrySize = 16u * 1024u;
+
+	//---------------------------------
+	// GenPackageFile
+	//
+	// Write a package with the same layout PackageWriter produces, so that the benchmark doesn't depend on cooked content
+	//
+	std::string GenPackageFile(std::vector<core::HashString>& outIds)
+	{
+		std::string const path = core::FileUtil::GetExecutableDir() + "benchmark_package" + core::FilePackage::s_PackageFileExtension;
+
+		std::vector<std::string> names;
+		for (size_t idx = 0u; idx < s_PackageEntryCount; ++idx)
+		{
+			names.push_back(FS("Resources/Benchmark/entry_%u.bin", static_cast<uint32>(idx)));
+			outIds.emplace_back(names.back().c_str());
+		}
+
+		// offsets
+		core::PkgHeader header;
+		header.numEntries = static_cast<uint64>(s_PackageEntryCount);
+
+		uint64 offset = static_cast<uint64>(sizeof(core::PkgHeader) + sizeof(core::PkgFileInfo) * s_PackageEntryCount);
+
+		std::vector<core::PkgFileInfo> fileInfos;
+		for (size_t idx = 0u; idx < s_PackageEntryCount; ++idx)
+		{
+			core::PkgFileInfo info;
+			info.fileId = outIds[idx];
+			info.offset = offset;
+			fileInfos.push_back(info);
+
+			offset += static_cast<uint64>(sizeof(core::PkgEntry) + names[idx].size() + s_PackageEntrySize);
+		}
+
+		// content
+		std::vector<uint8> data(static_cast<size_t>(offset), 0u);
+		uint8* raw = data.data();
+
+		memcpy(raw, &header, sizeof(core::PkgHeader));
+		offset = sizeof(core::PkgHeader);
+
+		for (core::PkgFileInfo const& info : fileInfos)
+		{
+			memcpy(raw + offset, &info, sizeof(core::PkgFileInfo));
+			offset += sizeof(core::PkgFileInfo);
+		}
+
+		for (size_t idx = 0u; idx < s_PackageEntryCount; ++idx)
+		{
+			core::PkgEntry entry;
+			entry.fileId = outIds[idx];
+			entry.compressionType = core::E_CompressionType::Store;
+			entry.nameLength = static_cast<uint16>(names[idx].size());
+			entry.size = static_cast<uint64>(s_PackageEntrySize);
+
+			memcpy(raw + offset, &entry, sizeof(core::PkgEntry));
+			offset += sizeof(core::PkgEntry);
+
+			memcpy(raw + offset, names[idx].c_str(), names[idx].size());
+			offset += names[idx].size();
+
+			std::fill(raw + offset, raw + offset + s_PackageEntrySize, static_cast<uint8>(idx));
+			offset += s_PackageEntrySize;
+		}
+
+		// write
+		core::File* file = new core::File(path, nullptr);
+
+		core::FILE_ACCESS_FLAGS outFlags;
+		outFlags.SetFlags(core::FILE_ACCESS_FLAGS::FLAGS::Create | core::FILE_ACCESS_FLAGS::FLAGS::Exists | core::FILE_ACCESS_FLAGS::FLAGS::Truncate);
+
+		bool const success = file->Open(core::FILE_ACCESS_MODE::Write, outFlags) && file->Write(data);
+		SafeDelete(file);
+
+		return success ? path : std::string();
+	}
+
+	//---------------------------------
+	// DeletePackageFile
+	//
+	// The file object deletes itself if deleting from disk succeeds
+	//
+	void DeletePackageFile(std::string const& path)
+	{
+		core::File* file = new core::File(path, nullptr);
+		if (!file->Delete())
+		{
+			SafeDelete(file);
+		}
+	}
+
+} // namespace
+
+
+ET_BENCHMARK("file package open", "filesystem")
+{
+	std::vector<core::HashString> ids;
+	std::string const path = GenPackageFile(ids);
+	if (path.empty())
+	{
+		context.Skip("unable to write the package file");
+		return;
+	}
+
+	// opening reads the central directory and all entry headers
+	context.SetItemsPerIteration(s_PackageEntryCount);
+	context.Run([&path]()
+		{
+			core::FilePackage pkg(path);
+			bench::DoNotOptimize(pkg);
+		});
+
+	DeletePackageFile(path);
+}
+
+ET_BENCHMARK("file package read", "filesystem")
+{
+	std::vector<core::HashString> ids;
+	std::string const path = GenPackageFile(ids);
+	if (path.empty())
+	{
+		context.Skip("unable to write the package file");
+		return;
+	}
+
+	{
+		core::FilePackage pkg(path);
+		std::vector<uint8> data; // reused between reads, like the package resource manager does
+
+		context.SetItemsPerIteration(s_PackageEntryCount * s_PackageEntrySize); // bytes
+		context.Run([&pkg, &ids, &data]()
+			{
+				for (core::HashString const id : ids)
+				{
+					pkg.GetEntryData(id, data);
+				}
+
+				bench::DoNotOptimize(data.data());
+			});
+	}
+
+	DeletePackageFile(path);
+}
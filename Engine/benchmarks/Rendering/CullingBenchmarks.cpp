@@ -0,0 +1,187 @@
+#include <EtFramework/stdafx.h>
+
+#include <Benchmark.h>
+
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/GraphicsTypes/Frustum.h>
+#include <EtRendering/GraphicsTypes/FrustumCulling.h>
+#include <EtRendering/PlanetTech/Triangulator.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	size_t const s_SphereCount = 10000u;
+	size_t const s_SceneInstanceCount = 100000u;
+
+	float const s_AspectRatio = 16.f / 9.f;
+	ivec2 const s_ViewDimensions(1920, 1080);
+
+	float const s_PlanetRadius = 1737.f; // same dimensions as the demo moon
+	float const s_PlanetMaxHeight = 10.7f;
+
+	//---------------------------------
+	// SetupCamera
+	//
+	// Cameras usually recalculate through their viewport, so defer all recalculation for headless use
+	//
+	void SetupCamera(render::Camera& camera, vec3 const& pos, vec3 const& forward, float const nearPlane, float const farPlane)
+	{
+		camera.SetTransformation(pos, forward, vec3::UP, true);
+		camera.SetFieldOfView(45.f, true);
+		camera.SetClippingPlanes(nearPlane, farPlane, true);
+	}
+
+	//---------------------------------
+	// GenSpheres
+	//
+	// Deterministic spheres scattered around the origin, roughly a quarter end up inside the frustum
+	//
+	std::vector<math::Sphere> GenSpheres(size_t const count)
+	{
+		std::vector<math::Sphere> spheres;
+		spheres.reserve(count);
+
+		uint32 state = 2463534242u;
+		auto nextFloat = [&state]() -> float
+			{
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				return static_cast<float>(state & 0xFFFFu) / 65535.f;
+			};
+
+		for (size_t idx = 0u; idx < count; ++idx)
+		{
+			vec3 const pos((nextFloat() - 0.5f) * 1000.f, (nextFloat() - 0.5f) * 1000.f, (nextFloat() - 0.5f) * 1000.f);
+			spheres.emplace_back(pos, 1.f + nextFloat() * 4.f);
+		}
+
+		return spheres;
+	}
+
+	//---------------------------------
+	// RunTriangulator
+	//
+	// Full triangulation close to the surface looking towards the horizon, which is where the most patches get generated
+	//  - throughput is reported in triangles the split heuristic was evaluated for
+	//
+	void RunTriangulator(bench::Context& context, bool const isBatched)
+	{
+		render::Triangulator triangulator;
+		triangulator.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+		triangulator.SetCoherent(false); // triangulate everything every iteration
+		triangulator.SetBatched(isBatched);
+
+		render::Camera camera;
+		SetupCamera(camera, vec3(0.f, s_PlanetRadius + 2.f, 0.f), vec3(1.f, 0.f, 0.f), 0.1f, 10000.f);
+
+		mat4 const planetTransform;
+
+		triangulator.Update(planetTransform, camera, s_ViewDimensions);
+		triangulator.GenerateGeometry();
+		context.SetItemsPerIteration(triangulator.GetEvaluatedTriangleCount());
+
+		context.Run([&triangulator, &camera, &planetTransform]()
+			{
+				triangulator.Update(planetTransform, camera, s_ViewDimensions);
+				triangulator.GenerateGeometry();
+
+				bench::DoNotOptimize(triangulator.GetPositions().size());
+			});
+	}
+
+} // namespace
+
+
+ET_BENCHMARK("frustum contains sphere", "culling")
+{
+	render::Camera camera;
+	SetupCamera(camera, vec3(0.f), vec3::FORWARD, 0.1f, 400.f);
+
+	render::Frustum frustum;
+	frustum.SetCullTransform(mat4());
+	frustum.SetToCamera(camera);
+	frustum.Update(s_AspectRatio);
+
+	std::vector<math::Sphere> const spheres = GenSpheres(s_SphereCount);
+
+	context.SetItemsPerIteration(s_SphereCount);
+	context.Run([&frustum, &spheres]()
+		{
+			uint32 visible = 0u;
+			for (math::Sphere const& sphere : spheres)
+			{
+				if (frustum.ContainsSphere(sphere) != render::VolumeCheck::OUTSIDE)
+				{
+					++visible;
+				}
+			}
+
+			bench::DoNotOptimize(visible);
+		});
+}
+
+ET_BENCHMARK("frustum culler batch", "culling")
+{
+	render::Camera camera;
+	SetupCamera(camera, vec3(0.f), vec3::FORWARD, 0.1f, 400.f);
+
+	render::Frustum frustum;
+	frustum.SetCullTransform(mat4());
+	frustum.SetToCamera(camera);
+	frustum.Update(s_AspectRatio);
+
+	render::FrustumCuller const culler(frustum);
+
+	render::SphereBounds bounds;
+	for (math::Sphere const& sphere : GenSpheres(s_SceneInstanceCount))
+	{
+		bounds.Add(sphere);
+	}
+
+	std::vector<uint32> visible;
+
+	context.SetItemsPerIteration(s_SceneInstanceCount);
+	context.Run([&culler, &bounds, &visible]()
+		{
+			culler.Cull(bounds, visible);
+
+			bench::DoNotOptimize(visible.size());
+		});
+}
+
+ET_BENCHMARK("planet triangulator", "culling")
+{
+	RunTriangulator(context, true);
+}
+
+ET_BENCHMARK("planet triangulator recursive", "culling")
+{
+	RunTriangulator(context, false);
+}
+
+ET_BENCHMARK("planet triangulator coherent", "culling")
+{
+	render::Triangulator triangulator;
+	triangulator.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+
+	// same view as above, but moving forward slowly so that subtrees further away can be reused
+	render::Camera camera;
+	mat4 const planetTransform;
+	uint32 frame = 0u;
+
+	context.Run([&triangulator, &camera, &planetTransform, &frame]()
+		{
+			float const angle = static_cast<float>(frame++ % 1000u) * 0.00001f;
+			SetupCamera(camera, vec3(std::sin(angle), std::cos(angle), 0.f) * (s_PlanetRadius + 2.f), vec3(std::cos(angle), -std::sin(angle), 0.f),
+				0.1f, 10000.f);
+
+			triangulator.Update(planetTransform, camera, s_ViewDimensions);
+			triangulator.GenerateGeometry();
+
+			bench::DoNotOptimize(triangulator.GetPositions().size());
+		});
+}
@@ -0,0 +1,101 @@
+#include <EtFramework/stdafx.h>
+
+#include <Benchmark.h>
+#include <mainBenchmarks.h>
+
+#include <EtCore/FileSystem/Entry.h>
+
+#include <EtRendering/SceneStructure/GLTF.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	std::string const s_GltfFileName("Helper/Corset.gltf");
+
+	//---------------------------------
+	// ReadGltfFile
+	//
+	// The asset lives in the unit test data directory, returns false if the file can't be read
+	//
+	bool ReadGltfFile(std::vector<uint8>& outContent, std::string& outPath, std::string& outExtension)
+	{
+		if (global::g_BenchmarkDataDir.empty())
+		{
+			return false;
+		}
+
+		core::File* input = new core::File(global::g_BenchmarkDataDir + s_GltfFileName, nullptr);
+		if (!input->Open(core::FILE_ACCESS_MODE::Read))
+		{
+			SafeDelete(input);
+			return false;
+		}
+
+		outContent = input->Read();
+		outPath = input->GetPath();
+		outExtension = input->GetExtension();
+
+		SafeDelete(input);
+		return !outContent.empty();
+	}
+
+} // namespace
+
+
+ET_BENCHMARK("gltf parse", "gltf")
+{
+	std::vector<uint8> content;
+	std::string path;
+	std::string extension;
+	if (!ReadGltfFile(content, path, extension))
+	{
+		context.Skip("requires --data <Engine/unit_tests/>");
+		return;
+	}
+
+	context.SetItemsPerIteration(content.size()); // bytes
+	context.Run([&content, &path, &extension]()
+		{
+			render::glTF::glTFAsset asset;
+			bool const success = render::glTF::ParseGLTFData(content, path, extension, asset);
+			ET_ASSERT(success);
+			UNUSED(success);
+
+			bench::DoNotOptimize(asset.dom.accessors.size());
+		});
+}
+
+ET_BENCHMARK("gltf accessor data", "gltf")
+{
+	std::vector<uint8> content;
+	std::string path;
+	std::string extension;
+	if (!ReadGltfFile(content, path, extension))
+	{
+		context.Skip("requires --data <Engine/unit_tests/>");
+		return;
+	}
+
+	render::glTF::glTFAsset asset;
+	if (!render::glTF::ParseGLTFData(content, path, extension, asset))
+	{
+		context.Skip("failed to parse " + s_GltfFileName);
+		return;
+	}
+
+	// external buffers are loaded on first access and cached in the asset, so this measures element extraction
+	std::vector<uint8> data;
+	context.SetItemsPerIteration(asset.dom.accessors.size());
+	context.Run([&asset, &data]()
+		{
+			for (uint32 accessorIdx = 0u; accessorIdx < static_cast<uint32>(asset.dom.accessors.size()); ++accessorIdx)
+			{
+				render::glTF::GetAccessorData(asset, accessorIdx, data);
+			}
+
+			bench::DoNotOptimize(data.data());
+		});
+}
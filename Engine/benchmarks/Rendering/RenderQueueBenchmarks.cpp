@@ -0,0 +1,78 @@
+#include <EtFramework/stdafx.h>
+
+#include <Benchmark.h>
+
+#include <EtRendering/SceneRendering/RenderQueue.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	size_t const s_PacketCount = 20000u;
+
+	//---------------------------------
+	// GenEntries
+	//
+	// Keys with a realistic amount of distinct shaders, materials and meshes, in scene traversal order
+	//
+	std::vector<render::RenderQueue::SortEntry> GenEntries(size_t const count)
+	{
+		std::vector<render::RenderQueue::SortEntry> entries;
+		entries.reserve(count);
+
+		uint32 state = 2463534242u;
+		for (size_t idx = 0u; idx < count; ++idx)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+
+			uint64 const key = render::RenderQueue::MakeKey(render::RenderQueue::E_SortMode::StateFrontToBack,
+				state % 16u,
+				(state >> 4u) % 256u,
+				(state >> 12u) % 1024u,
+				static_cast<float>(state & 0xFFFFu) / 65535.f);
+
+			entries.push_back(render::RenderQueue::SortEntry{ key, static_cast<uint32>(idx) });
+		}
+
+		return entries;
+	}
+
+} // namespace
+
+
+ET_BENCHMARK("render queue radix sort", "render queue")
+{
+	std::vector<render::RenderQueue::SortEntry> const source = GenEntries(s_PacketCount);
+	std::vector<render::RenderQueue::SortEntry> entries;
+	std::vector<render::RenderQueue::SortEntry> scratch;
+
+	context.SetItemsPerIteration(s_PacketCount);
+	context.Run([&source, &entries, &scratch]()
+		{
+			entries = source;
+			render::RenderQueue::RadixSort(entries, scratch);
+			bench::DoNotOptimize(entries.data());
+		});
+}
+
+ET_BENCHMARK("render queue std sort", "render queue")
+{
+	std::vector<render::RenderQueue::SortEntry> const source = GenEntries(s_PacketCount);
+	std::vector<render::RenderQueue::SortEntry> entries;
+
+	context.SetItemsPerIteration(s_PacketCount);
+	context.Run([&source, &entries]()
+		{
+			entries = source;
+			std::sort(entries.begin(), entries.end(), [](render::RenderQueue::SortEntry const& lhs, render::RenderQueue::SortEntry const& rhs)
+				{
+					return lhs.key < rhs.key;
+				});
+
+			bench::DoNotOptimize(entries.data());
+		});
+}
@@ -0,0 +1,182 @@
+#include <EtFramework/stdafx.h>
+
+#include <rttr/registration>
+
+#include <Benchmark.h>
+
+#include <EtCore/Reflection/Serialization.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	size_t const s_JsonObjectCount = 2000u;
+	size_t const s_SerialEntryCount = 500u;
+
+	//---------------------------------
+	// GenJsonDocument
+	//
+	// Document with a mix of nested objects, arrays, strings and numbers, similar to scene descriptors and asset databases
+	//
+	std::string GenJsonDocument(size_t const objectCount)
+	{
+		std::string doc("{\n\t\"entities\": [\n");
+		for (size_t idx = 0u; idx < objectCount; ++idx)
+		{
+			doc += FS("\t\t{ \"name\": \"entity_%u\", \"id\": %u, \"visible\": %s, \"position\": [%f, %f, %f], \"scale\": 1.5, \"parent\": null, "
+				"\"components\": { \"model\": \"Meshes/model_%u.gltf\", \"material\": \"Materials/mat_%u.json\" } }%s\n",
+				static_cast<uint32>(idx),
+				static_cast<uint32>(idx),
+				(idx % 2u) == 0u ? "true" : "false",
+				static_cast<float>(idx) * 0.5f, -static_cast<float>(idx), 100.25f,
+				static_cast<uint32>(idx % 64u),
+				static_cast<uint32>(idx % 16u),
+				(idx + 1u < objectCount) ? "," : "");
+		}
+
+		doc += "\t]\n}\n";
+		return doc;
+	}
+
+} // namespace
+
+
+// reflected types
+//*****************
+
+struct BenchSerialEntry final
+{
+	std::string name;
+	uint32 id = 0u;
+	bool enabled = true;
+	vec3 position;
+	quat rotation;
+};
+
+struct BenchSerialDocument final
+{
+	std::string title;
+	std::vector<BenchSerialEntry> entries;
+	std::vector<float> weights;
+};
+
+RTTR_REGISTRATION
+{
+	using namespace rttr;
+
+	registration::class_<BenchSerialEntry>("bench serial entry")
+		.property("name", &BenchSerialEntry::name)
+		.property("id", &BenchSerialEntry::id)
+		.property("enabled", &BenchSerialEntry::enabled)
+		.property("position", &BenchSerialEntry::position)
+		.property("rotation", &BenchSerialEntry::rotation);
+
+	registration::class_<BenchSerialDocument>("bench serial document")
+		.property("title", &BenchSerialDocument::title)
+		.property("entries", &BenchSerialDocument::entries)
+		.property("weights", &BenchSerialDocument::weights);
+}
+
+
+namespace {
+
+	BenchSerialDocument GenSerialDocument()
+	{
+		BenchSerialDocument doc;
+		doc.title = "benchmark document";
+
+		for (size_t idx = 0u; idx < s_SerialEntryCount; ++idx)
+		{
+			BenchSerialEntry entry;
+			entry.name = FS("entry_%u", static_cast<uint32>(idx));
+			entry.id = static_cast<uint32>(idx);
+			entry.enabled = (idx % 3u) != 0u;
+			entry.position = vec3(static_cast<float>(idx), 2.f, -3.f);
+			doc.entries.push_back(entry);
+
+			doc.weights.push_back(static_cast<float>(idx) / static_cast<float>(s_SerialEntryCount));
+		}
+
+		return doc;
+	}
+
+	//---------------------------------
+	// SerializeToString
+	//
+	std::string SerializeToString(BenchSerialDocument const& doc)
+	{
+		core::JSON::Object* const root = static_cast<core::JSON::Object*>(core::serialization::SerializeToJson(doc));
+		ET_ASSERT(root != nullptr);
+
+		core::JSON::Writer writer(true);
+		writer.Write(root);
+
+		delete root;
+		return writer.GetResult();
+	}
+
+} // namespace
+
+
+// JSON
+//******
+
+ET_BENCHMARK("json parse", "serialization")
+{
+	std::string const doc = GenJsonDocument(s_JsonObjectCount);
+
+	context.SetItemsPerIteration(doc.size()); // bytes
+	context.Run([&doc]()
+		{
+			core::JSON::Parser parser(doc);
+			bench::DoNotOptimize(parser.GetRoot());
+		});
+}
+
+ET_BENCHMARK("json write", "serialization")
+{
+	std::string const doc = GenJsonDocument(s_JsonObjectCount);
+	core::JSON::Parser const parser(doc);
+
+	context.SetItemsPerIteration(doc.size()); // bytes
+	context.Run([&parser]()
+		{
+			core::JSON::Writer writer(false);
+			writer.Write(parser.GetRoot());
+			bench::DoNotOptimize(writer.GetResult().size());
+		});
+}
+
+
+// reflection
+//************
+
+ET_BENCHMARK("rttr serialize", "serialization")
+{
+	BenchSerialDocument const doc = GenSerialDocument();
+
+	context.SetItemsPerIteration(s_SerialEntryCount);
+	context.Run([&doc]()
+		{
+			std::string const result = SerializeToString(doc);
+			bench::DoNotOptimize(result.size());
+		});
+}
+
+ET_BENCHMARK("rttr deserialize", "serialization")
+{
+	std::string const jsonString = SerializeToString(GenSerialDocument());
+
+	context.SetItemsPerIteration(s_SerialEntryCount);
+	context.Run([&jsonString]()
+		{
+			BenchSerialDocument doc;
+			bool const success = core::serialization::DeserializeFromJsonString(jsonString, doc);
+			ET_ASSERT(success && (doc.entries.size() == s_SerialEntryCount));
+			UNUSED(success);
+
+			bench::DoNotOptimize(doc.entries.size());
+		});
+}
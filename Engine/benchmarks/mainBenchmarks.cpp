@@ -0,0 +1,166 @@
+#include <EtFramework/stdafx.h>
+
+#include <vector>
+#include <iostream>
+#include <string>
+
+#include "mainBenchmarks.h"
+#include "Benchmark.h"
+
+#include <EtCore/FileSystem/FileUtil.h>
+
+
+using namespace et;
+
+
+std::string global::g_BenchmarkDataDir = std::string();
+
+
+namespace {
+
+	void PrintUsage()
+	{
+		std::cout << "usage: benchmarks [options]" << std::endl
+			<< "\t--data <dir>          directory containing benchmark data files (Engine/unit_tests/)" << std::endl
+			<< "\t--filter <text>       only run benchmarks with a name or group containing the text" << std::endl
+			<< "\t--samples <count>     samples per benchmark (default 100)" << std::endl
+			<< "\t--min-sample-ms <ms>  minimum duration of a sample for fast benchmarks (default 1)" << std::endl
+			<< "\t--csv <file>          write results as csv" << std::endl
+			<< "\t--json <file>         write results as json, usable as a baseline" << std::endl
+			<< "\t--baseline <file>     compare medians against a json result file" << std::endl
+			<< "\t--threshold <percent> slowdown relative to the baseline that counts as a regression (default 10)" << std::endl
+			<< "\t--list                list benchmarks without running them" << std::endl;
+	}
+
+}
+
+
+int main(int argc, char* argv[])
+{
+	// working dir
+	if (argc > 0)
+	{
+		core::FileUtil::SetExecutablePath(argv[0]);
+	}
+	else
+	{
+		std::cerr << "main > Couldn't extract working directory from arguments, exiting!" << std::endl;
+		return 1;
+	}
+
+	// options
+	//---------
+	bench::Settings settings;
+	std::string csvPath;
+	std::string jsonPath;
+	std::string baselinePath;
+	double threshold = 10.0;
+	bool listOnly = false;
+
+	for (int argIdx = 1; argIdx < argc; ++argIdx)
+	{
+		std::string const arg(argv[argIdx]);
+		bool const hasValue = (argIdx + 1) < argc;
+
+		if (arg == "--list")
+		{
+			listOnly = true;
+		}
+		else if ((arg == "--help") || (arg == "-h"))
+		{
+			PrintUsage();
+			return 0;
+		}
+		else if (hasValue && (arg == "--data"))
+		{
+			global::g_BenchmarkDataDir = std::string(argv[++argIdx]);
+			core::FileUtil::UnifyPathDelimiters(global::g_BenchmarkDataDir);
+			if (!global::g_BenchmarkDataDir.empty() && (global::g_BenchmarkDataDir.back() != '/'))
+			{
+				global::g_BenchmarkDataDir += "/";
+			}
+		}
+		else if (hasValue && (arg == "--filter"))
+		{
+			settings.filter = std::string(argv[++argIdx]);
+		}
+		else if (hasValue && (arg == "--samples"))
+		{
+			settings.sampleCount = std::max(static_cast<uint32>(std::stoul(argv[++argIdx])), 1u);
+		}
+		else if (hasValue && (arg == "--min-sample-ms"))
+		{
+			settings.minSampleNs = static_cast<uint64>(std::stod(argv[++argIdx]) * 1000000.0);
+		}
+		else if (hasValue && (arg == "--csv"))
+		{
+			csvPath = std::string(argv[++argIdx]);
+		}
+		else if (hasValue && (arg == "--json"))
+		{
+			jsonPath = std::string(argv[++argIdx]);
+		}
+		else if (hasValue && (arg == "--baseline"))
+		{
+			baselinePath = std::string(argv[++argIdx]);
+		}
+		else if (hasValue && (arg == "--threshold"))
+		{
+			threshold = std::stod(argv[++argIdx]);
+		}
+		else
+		{
+			std::cerr << "main > unknown argument '" << arg << "'" << std::endl;
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	if (listOnly)
+	{
+		for (bench::Registration const& reg : bench::GetRegistrations())
+		{
+			std::cout << "[" << reg.group << "] " << reg.name << std::endl;
+		}
+
+		return 0;
+	}
+
+	// run
+	//-----
+	std::vector<bench::Statistics> const results = bench::RunBenchmarks(settings);
+	bench::PrintResults(results);
+
+	// output
+	//--------
+	int result = 0;
+
+	if (!csvPath.empty() && !bench::WriteCsv(results, csvPath))
+	{
+		result = 4;
+	}
+
+	if (!jsonPath.empty() && !bench::WriteJson(results, jsonPath))
+	{
+		result = 4;
+	}
+
+	// a nonzero exit code lets CI fail on regressions
+	if (!baselinePath.empty())
+	{
+		bench::T_Baseline baseline;
+		if (!bench::LoadBaseline(baselinePath, baseline))
+		{
+			return 5;
+		}
+
+		uint32 const regressionCount = bench::CompareToBaseline(results, baseline, threshold);
+		if (regressionCount > 0u)
+		{
+			std::cerr << "main > " << regressionCount << " benchmark(s) regressed by more than " << threshold << "%" << std::endl;
+			return 3;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+class global
+{
+public:
+	static std::string g_BenchmarkDataDir; // empty if no data directory was passed, benchmarks that need files skip themselves
+};
@@ -0,0 +1,25 @@
+
+//Decoding of the quantized mesh vertex attributes, see vertex_packing in VertexInfo.h
+
+vec2 signNotZero(vec2 v)
+{
+	return vec2((v.x >= 0.0) ? 1.0 : -1.0, (v.y >= 0.0) ? 1.0 : -1.0);
+}
+
+//Octahedral unit vector
+vec3 decodeOctahedral(vec2 enc)
+{
+	vec3 dir = vec3(enc.xy, 1.0 - abs(enc.x) - abs(enc.y));
+	if (dir.z < 0)
+	{
+		dir.xy = (1.0 - abs(dir.yx)) * signNotZero(dir.xy);
+	}
+	return normalize(dir);
+}
+
+//Octahedral tangent in xyz, bitangent sign in w
+vec4 decodeTangent(vec2 enc)
+{
+	float bitangentSign = (enc.y < 0.0) ? -1.0 : 1.0;
+	return vec4(decodeOctahedral(vec2(enc.x, (abs(enc.y) - 0.75) * 4.0)), bitangentSign);
+}
@@ -1,18 +1,23 @@
 <VERTEX>
 	#version 330 core
 	#include "CommonSharedVars.glsl"
+	#include "CommonVertex.glsl"
 	
-	in vec3 position;
-	in vec3 normal;
-	in vec3 tangent;
-	in vec2 texcoord;
+	layout (location = 0) in vec3 position;
+	layout (location = 1) in vec2 normal;
+	layout (location = 2) in vec2 tangent;
+	layout (location = 3) in vec2 texcoord;
 	
 	out vec3 Position;
 	out vec3 Normal;
 	out vec3 Tangent;
 	out vec2 Texcoord;
 	
+#ifdef INSTANCED
+	layout (location = 12) in mat4 model; // per instance, see InstanceBuffer
+#else
 	uniform mat4 model;
+#endif
 	
 	void main()
 	{
@@ -20,8 +25,8 @@
 		
 		mat3 normMat = inverse(mat3(model));
 		normMat = transpose(normMat);
-		Normal = normalize(normMat*normal);
-		Tangent = normalize(normMat*tangent);
+		Normal = normalize(normMat*decodeOctahedral(normal));
+		Tangent = normalize(normMat*decodeTangent(tangent).xyz);
 		
 		vec4 pos = model*vec4(position, 1.0);
 		Position = vec3(pos.x, pos.y, pos.z);
@@ -47,16 +52,20 @@
   uniform sampler2D uTexOcclusion;
   uniform sampler2D uTexEmissive;
 
-  uniform bool uUseBaseColTex;
-  uniform bool uUseNormalTex;
-  uniform bool uUseMetallicRoughnessTex;
-  uniform bool uUseOcclusionTex;
-  uniform bool uUseEmissiveTex;
-
-  uniform vec3 uBaseColor = vec3(1.f);
-  uniform vec3 uEmissiveFactor = vec3(0.f);
-  uniform float uRoughness = 0.f;
-  uniform float uMetallic = 0.f;
+  // std140 uniform buffer per material, block members can't have defaults so materials set all of them
+  layout (std140) uniform MaterialParameters
+  {
+    vec3 uBaseColor;
+    float uRoughness;
+    vec3 uEmissiveFactor;
+    float uMetallic;
+
+    bool uUseBaseColTex;
+    bool uUseNormalTex;
+    bool uUseMetallicRoughnessTex;
+    bool uUseOcclusionTex;
+    bool uUseEmissiveTex;
+  };
 
 
   vec3 mapNormal()
@@ -1,9 +1,13 @@
 <VERTEX>
 	#version 330 core
 	
-	in vec3 position;
+	layout (location = 0) in vec3 position;
 	
+#ifdef INSTANCED
+	layout (location = 12) in mat4 model; // per instance, see InstanceBuffer
+#else
 	uniform mat4 model;
+#endif
 	uniform mat4 worldViewProj; // not using global view matrix as this will be set for lights
 	
 	void main()
@@ -0,0 +1,122 @@
+#include "CookCache.h"
+#include <EtFramework/stdafx.h>
+
+#include <iomanip>
+
+#include <EtCore/Content/Asset.h>
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+#include <EtCore/Reflection/Serialization.h>
+
+#include <EtRendering/GraphicsTypes/FontDataStructure.h>
+#include <EtRendering/GraphicsTypes/MeshDataStructure.h>
+#include <EtRendering/GraphicsTypes/TextureDataStructure.h>
+
+
+namespace et {
+namespace cooker {
+
+
+//============
+// Cook Cache
+//============
+
+
+// static
+uint32 const CookCache::s_Version = 1u;
+std::string const CookCache::s_DirectoryName("cook_cache");
+
+
+//---------------------------------
+// CookCache::HashSettings
+//
+// Hash of the reflected properties of an asset, which includes its name, path and import settings
+//
+uint64 CookCache::HashSettings(core::I_Asset const& asset)
+{
+	std::string settings;
+
+	core::JSON::Object* const root = static_cast<core::JSON::Object*>(core::serialization::SerializeToJson(asset));
+	if (root != nullptr)
+	{
+		core::JSON::Writer writer(true);
+		if (writer.Write(root))
+		{
+			settings = writer.GetResult();
+		}
+
+		delete root;
+	}
+
+	if (settings.empty())
+	{
+		LOG("CookCache::HashSettings > Failed to serialize asset '" + asset.GetName() + std::string("', only its name is hashed"),
+			core::LogLevel::Warning);
+		settings = asset.GetPath() + asset.GetName();
+	}
+
+	return GetDataHash64(reinterpret_cast<uint8 const*>(settings.data()), settings.size());
+}
+
+//---------------------------------
+// CookCache::c-tor
+//
+// Ensures the cache directory exists
+//
+CookCache::CookCache(std::string const& directory)
+	: m_Directory(directory)
+{
+	core::Directory* const dir = new core::Directory(m_Directory, nullptr, true);
+	delete dir;
+}
+
+//---------------------------------
+// CookCache::GetKey
+//
+// Combine the versions of all cooked formats, the asset settings and the source content
+//
+CookCache::T_Key CookCache::GetKey(uint64 const settingsHash, std::vector<uint8> const& sourceData) const
+{
+	uint32 const versions[] = {
+		s_Version,
+		render::FontFileHeader::s_Version,
+		render::MeshFileHeader::s_Version,
+		render::TextureFileHeader::s_Version
+	};
+
+	uint64 const versionHash = GetDataHash64(reinterpret_cast<uint8 const*>(versions), sizeof(versions), settingsHash);
+	return GetDataHash64(sourceData.data(), sourceData.size(), versionHash);
+}
+
+//---------------------------------
+// CookCache::Contains
+//
+bool CookCache::Contains(T_Key const key) const
+{
+	std::ifstream const cachedFile(GetFilePath(key), std::ios::binary);
+	return cachedFile.good();
+}
+
+//---------------------------------
+// CookCache::Store
+//
+// Write the cooked data for a key - the data goes to a temporary file first, so that an interrupted cook never leaves a partial entry
+//
+bool CookCache::Store(T_Key const key, std::vector<uint8> const& cookedData) const
+{
+	return core::FileUtil::WriteFileAtomic(GetFilePath(key), cookedData);
+}
+
+//---------------------------------
+// CookCache::GetFilePath
+//
+std::string CookCache::GetFilePath(T_Key const key) const
+{
+	std::stringstream stream;
+	stream << m_Directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".cooked";
+	return stream.str();
+}
+
+
+} // namespace cooker
+} // namespace et
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <string>
+
+#include <EtCore/Util/AtomicTypes.h>
+
+
+namespace et { namespace core {
+	class I_Asset;
+} }
+
+
+namespace et {
+namespace cooker {
+
+
+//---------------------------------
+// CookCache
+//
+// Keeps cooked assets on disk between runs of the cooker, so that only assets that changed are cooked again
+//  - entries are keyed on the content of the source file, the import settings of the asset and the version of the cooked formats
+//  - nothing is ever evicted, deleting the directory resets the cache
+//
+class CookCache final
+{
+	// definitions
+	//-------------
+public:
+	typedef uint64 T_Key;
+
+	static uint32 const s_Version; // increase when a cooker changes its output without changing the version of its format
+	static std::string const s_DirectoryName;
+
+	// static functionality
+	//----------------------
+	static uint64 HashSettings(core::I_Asset const& asset);
+
+	// construct destruct
+	//--------------------
+	CookCache(std::string const& directory);
+
+	// functionality
+	//---------------
+	T_Key GetKey(uint64 const settingsHash, std::vector<uint8> const& sourceData) const;
+
+	bool Contains(T_Key const key) const;
+	bool Store(T_Key const key, std::vector<uint8> const& cookedData) const;
+
+	// accessors
+	//-----------
+	std::string GetFilePath(T_Key const key) const;
+
+	// Data
+	///////
+
+private:
+	std::string m_Directory;
+};
+
+
+} // namespace cooker
+} // namespace et
@@ -0,0 +1,292 @@
+#include "FontCooker.h"
+#include <EtFramework/stdafx.h>
+
+#include <ft2build.h>
+#include <freetype/freetype.h>
+
+#include <EtCore/Util/JobPool.h>
+
+#include <EtRendering/GraphicsTypes/SpriteFont.h>
+
+
+namespace et {
+namespace cooker {
+
+
+//---------------------------------
+// CookFont
+//
+// Bakes a ttf font into a cooked font with a prebuilt SDF atlas, see FontDataStructure.h
+//  - metrics and atlas packing are shared with the runtime path, so both produce the same layout
+//  - glyphs are rasterized and converted to distance fields on the threads of the job pool, each with its own FreeType face
+//
+bool CookFont(render::FontAsset const& asset, std::vector<uint8> const& ttfData, std::vector<uint8>& cookedData)
+{
+	FT_Library ft;
+	if (FT_Init_FreeType(&ft))
+	{
+		LOG("CookFont > Could not init FreeType Library", core::LogLevel::Warning);
+		return false;
+	}
+
+	FT_Face face;
+	if (FT_New_Memory_Face(ft, ttfData.data(), static_cast<FT_Long>(ttfData.size()), 0, &face))
+	{
+		LOG("CookFont > Failed to load font", core::LogLevel::Warning);
+		FT_Done_FreeType(ft);
+		return false;
+	}
+
+	ivec2 atlasSize;
+	std::unique_ptr<render::SpriteFont> const font(asset.LayoutGlyphs(face, atlasSize));
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(ft);
+
+	render::SpriteFont const& layout = *font;
+
+	std::vector<render::FontMetric const*> glyphs;
+	for (int32 charId = render::SpriteFont::s_MinCharId; charId <= render::SpriteFont::s_MaxCharId; ++charId)
+	{
+		render::FontMetric const& metric = layout.GetMetric(static_cast<wchar_t>(charId));
+		if (metric.IsValid)
+		{
+			glyphs.emplace_back(&metric);
+		}
+	}
+
+	if (glyphs.empty())
+	{
+		LOG("CookFont > Font doesn't contain any supported glyphs", core::LogLevel::Warning);
+		return false;
+	}
+
+	// glyphs write to disjoint texels or to different channels of the same texel, so threads can share the atlas
+	std::vector<uint8> atlas(static_cast<size_t>(atlasSize.x * atlasSize.y * 4), 0u);
+
+	// glyphs are interleaved over one grain per thread, which run inline if the font is cooked on the job pool already
+	core::JobPool* const jobPool = core::JobPool::GetInstance();
+	size_t const threadCount = std::min(jobPool->GetThreadCount(), glyphs.size());
+
+	jobPool->Run(0u, threadCount, 1u, [&asset, &ttfData, &glyphs, threadCount, &atlasSize, &atlas](size_t const grainIdx, size_t const begin, size_t const end)
+		{
+			UNUSED(begin);
+			UNUSED(end);
+			font_detail::BakeGlyphs(asset, ttfData, glyphs, grainIdx, threadCount, atlasSize.x, atlas);
+		});
+
+	render::FontAsset::WriteCookedFont(layout, atlasSize, atlas, cookedData);
+
+	LOG(FS("CookFont > baked %u glyphs into a %ix%i atlas", static_cast<uint32>(glyphs.size()), atlasSize.x, atlasSize.y));
+	return true;
+}
+
+
+namespace font_detail {
+
+	//---------------------------------
+	// DistanceTransform
+	//
+	// Exact squared euclidean distance transform (Felzenszwalb & Huttenlocher) in place
+	//  - input cells are 0 on features and a large value elsewhere, output cells contain the squared distance to the closest feature
+	//
+	void DistanceTransform(std::vector<float>& grid, int32 const width, int32 const height)
+	{
+		int32 const length = std::max(width, height);
+
+		std::vector<float> f(static_cast<size_t>(length));
+		std::vector<float> d(static_cast<size_t>(length));
+		std::vector<int32> v(static_cast<size_t>(length));
+		std::vector<float> z(static_cast<size_t>(length + 1));
+
+		// lower envelope of the parabolas rooted at each cell
+		auto transform1D = [&f, &d, &v, &z](int32 const count)
+			{
+				float const inf = std::numeric_limits<float>::max();
+
+				int32 k = 0;
+				v[0] = 0;
+				z[0] = -inf;
+				z[1] = inf;
+
+				for (int32 q = 1; q < count; ++q)
+				{
+					float const fq = f[q] + static_cast<float>(q * q);
+
+					float s = (fq - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * (q - v[k]));
+					while (s <= z[k])
+					{
+						--k;
+						s = (fq - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * (q - v[k]));
+					}
+
+					++k;
+					v[k] = q;
+					z[k] = s;
+					z[k + 1] = inf;
+				}
+
+				k = 0;
+				for (int32 q = 0; q < count; ++q)
+				{
+					while (z[k + 1] < static_cast<float>(q))
+					{
+						++k;
+					}
+
+					float const dist = static_cast<float>(q - v[k]);
+					d[q] = dist * dist + f[v[k]];
+				}
+			};
+
+		// columns
+		for (int32 x = 0; x < width; ++x)
+		{
+			for (int32 y = 0; y < height; ++y)
+			{
+				f[y] = grid[y * width + x];
+			}
+
+			transform1D(height);
+
+			for (int32 y = 0; y < height; ++y)
+			{
+				grid[y * width + x] = d[y];
+			}
+		}
+
+		// rows
+		for (int32 y = 0; y < height; ++y)
+		{
+			std::copy(grid.cbegin() + y * width, grid.cbegin() + (y + 1) * width, f.begin());
+
+			transform1D(width);
+
+			std::copy(d.cbegin(), d.cbegin() + width, grid.begin() + y * width);
+		}
+	}
+
+	//---------------------------------
+	// BakeGlyphs
+	//
+	// Rasterize every stride'th glyph starting at first at high resolution, and write its distance field into the atlas
+	//  - matches ComputeGlyphSDF.glsl: texels at the edge are 0.5 and the value reaches 0 or 1 at 'spread' texels from it
+	//  - the atlas is in texture row order, with the top of each glyph at its texture coordinate
+	//
+	void BakeGlyphs(render::FontAsset const& asset,
+		std::vector<uint8> const& ttfData,
+		std::vector<render::FontMetric const*> const& glyphs,
+		size_t const first,
+		size_t const stride,
+		int32 const atlasWidth,
+		std::vector<uint8>& atlas)
+	{
+		FT_Library ft;
+		if (FT_Init_FreeType(&ft))
+		{
+			LOG("BakeGlyphs > Could not init FreeType Library", core::LogLevel::Warning);
+			return;
+		}
+
+		FT_Face face;
+		if (FT_New_Memory_Face(ft, ttfData.data(), static_cast<FT_Long>(ttfData.size()), 0, &face))
+		{
+			LOG("BakeGlyphs > Failed to load font", core::LogLevel::Warning);
+			FT_Done_FreeType(ft);
+			return;
+		}
+
+		FT_Set_Pixel_Sizes(face, 0, asset.m_FontSize * asset.m_HighRes);
+
+		int32 const atlasHeight = static_cast<int32>(atlas.size() / 4u) / atlasWidth;
+		int32 const padding = static_cast<int32>(asset.m_Padding);
+		float const spread = static_cast<float>(asset.m_Spread);
+		float const highRes = static_cast<float>(asset.m_HighRes);
+		int32 const margin = static_cast<int32>(asset.m_Spread * asset.m_HighRes);
+		float const farAway = 1e20f;
+
+		std::vector<float> toInside;
+		std::vector<float> toOutside;
+
+		for (size_t glyphIdx = first; glyphIdx < glyphs.size(); glyphIdx += stride)
+		{
+			render::FontMetric const& metric = *glyphs[glyphIdx];
+
+			if (FT_Load_Glyph(face, FT_Get_Char_Index(face, metric.Character), FT_LOAD_DEFAULT))
+			{
+				LOG("BakeGlyphs > Failed to load glyph", core::LogLevel::Warning);
+				continue;
+			}
+
+			if ((face->glyph->format != FT_GLYPH_FORMAT_BITMAP) && FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL))
+			{
+				LOG("BakeGlyphs > Failed to render glyph", core::LogLevel::Warning);
+				continue;
+			}
+
+			FT_Bitmap const& bitmap = face->glyph->bitmap;
+			int32 const bitmapWidth = static_cast<int32>(bitmap.width);
+			int32 const bitmapHeight = static_cast<int32>(bitmap.rows);
+
+			// coverage with a border of 'spread' texels, so distances outside of the glyph are correct
+			int32 const gridWidth = bitmapWidth + margin * 2;
+			int32 const gridHeight = bitmapHeight + margin * 2;
+			size_t const gridSize = static_cast<size_t>(gridWidth * gridHeight);
+
+			toInside.assign(gridSize, farAway);
+			toOutside.assign(gridSize, 0.f);
+			for (int32 y = 0; y < bitmapHeight; ++y)
+			{
+				uint8 const* const row = bitmap.buffer + y * bitmap.pitch;
+				for (int32 x = 0; x < bitmapWidth; ++x)
+				{
+					if (row[x] > 127u)
+					{
+						size_t const cell = static_cast<size_t>((y + margin) * gridWidth + x + margin);
+						toInside[cell] = 0.f;
+						toOutside[cell] = farAway;
+					}
+				}
+			}
+
+			DistanceTransform(toInside, gridWidth, gridHeight);
+			DistanceTransform(toOutside, gridWidth, gridHeight);
+
+			// sample the high resolution field at the center of each atlas texel
+			ivec2 const res(static_cast<int32>(metric.Width) - padding * 2, static_cast<int32>(metric.Height) - padding * 2);
+			ivec2 const origin = math::vecCast<int32>(metric.TexCoord * vec2(static_cast<float>(atlasWidth), static_cast<float>(atlasHeight)) + vec2(0.5f))
+				+ ivec2(padding);
+
+			float const spreadTexels = spread * 2.f;
+			vec2 const innerRes = math::vecCast<float>(res) - vec2(spreadTexels);
+			vec2 const scale((innerRes.x > 0.f) ? (static_cast<float>(bitmapWidth) / innerRes.x) : highRes,
+				(innerRes.y > 0.f) ? (static_cast<float>(bitmapHeight) / innerRes.y) : highRes);
+
+			for (int32 y = 0; y < res.y; ++y)
+			{
+				int32 const gridY = std::min(std::max(margin + static_cast<int32>((static_cast<float>(y) + 0.5f - spread) * scale.y), 0), gridHeight - 1);
+
+				for (int32 x = 0; x < res.x; ++x)
+				{
+					int32 const gridX = std::min(std::max(margin + static_cast<int32>((static_cast<float>(x) + 0.5f - spread) * scale.x), 0), gridWidth - 1);
+					size_t const cell = static_cast<size_t>(gridY * gridWidth + gridX);
+
+					bool const isInside = (toInside[cell] == 0.f);
+					float const dist = std::min(std::sqrt(isInside ? toOutside[cell] : toInside[cell]) / highRes, spread);
+					float const value = 0.5f + (isInside ? dist : -dist) / spreadTexels;
+
+					size_t const texel = static_cast<size_t>((origin.y + y) * atlasWidth + origin.x + x);
+					atlas[texel * 4u + metric.Channel] = static_cast<uint8>(math::Clamp01(value) * 255.f + 0.5f);
+				}
+			}
+		}
+
+		FT_Done_Face(face);
+		FT_Done_FreeType(ft);
+	}
+
+} // namespace font_detail
+
+
+} // namespace cooker
+} // namespace et
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+
+#include <EtCore/Util/AtomicTypes.h>
+
+
+namespace et { namespace render {
+	class FontAsset;
+	struct FontMetric;
+} }
+
+
+namespace et {
+namespace cooker {
+
+
+bool CookFont(render::FontAsset const& asset, std::vector<uint8> const& ttfData, std::vector<uint8>& cookedData);
+
+//---------------------------------
+// font_detail
+//
+// Functionality for baking signed distance fields of glyphs on the CPU
+//
+namespace font_detail {
+
+	void DistanceTransform(std::vector<float>& grid, int32 const width, int32 const height);
+	void BakeGlyphs(render::FontAsset const& asset,
+		std::vector<uint8> const& ttfData,
+		std::vector<render::FontMetric const*> const& glyphs,
+		size_t const first,
+		size_t const stride,
+		int32 const atlasWidth,
+		std::vector<uint8>& atlas);
+
+} // namespace font_detail
+
+
+} // namespace cooker
+} // namespace et
@@ -0,0 +1,825 @@
+#include "MeshCooker.h"
+#include <EtFramework/stdafx.h>
+
+#include <numeric>
+#include <unordered_set>
+
+#include <EtCore/FileSystem/FileUtil.h>
+
+#include <EtRendering/GraphicsTypes/Mesh.h>
+
+
+namespace et {
+namespace cooker {
+
+
+// size of the post transform cache the cooked index order is evaluated with
+static uint32 const s_MeshCacheSize = 16u;
+
+
+//---------------------------------
+// CookMesh
+//
+// Runs the import pipeline on a source mesh once, and writes the result as a cooked mesh, see MeshDataStructure.h
+//  - a simplified level of detail is generated for each ratio of the full detail triangle count, all levels share the vertices
+//  - triangles of each level are reordered for the post transform cache and overdraw, then vertices are reordered in the order they are fetched
+//  - the runtime loader then only reads the header and uploads the vertex and index buffers
+//
+bool CookMesh(std::string const& assetName, 
+	std::vector<float> const& lodRatios, 
+	std::vector<uint8> const& sourceData, 
+	std::vector<uint8>& cookedData)
+{
+	std::unique_ptr<render::MeshDataContainer> const meshContainer(
+		render::MeshAsset::LoadAssimp(sourceData, core::FileUtil::ExtractExtension(assetName)));
+
+	if (meshContainer == nullptr)
+	{
+		LOG("CookMesh > Failed to import mesh", core::LogLevel::Warning);
+		return false;
+	}
+
+	if (meshContainer->m_VertexCount == 0u)
+	{
+		LOG("CookMesh > Mesh doesn't contain any vertices", core::LogLevel::Warning);
+		return false;
+	}
+
+	if (meshContainer->m_Name.empty())
+	{
+		meshContainer->m_Name = assetName;
+	}
+
+	std::vector<uint32>& indices = meshContainer->m_Indices;
+	if (indices.empty() || (indices.size() % 3u != 0u) || (meshContainer->m_Positions.size() != meshContainer->m_VertexCount))
+	{
+		LOG("CookMesh > Mesh isn't an indexed triangle list with positions, skipping optimization", core::LogLevel::Warning);
+		render::MeshAsset::WriteCookedMesh(*meshContainer, cookedData);
+		return true;
+	}
+
+	// levels of detail
+	//------------------
+	std::vector<std::vector<uint32>> lodIndices({ indices });
+	std::vector<float> lodErrors({ 0.f });
+
+	std::vector<float> ratios(lodRatios);
+	std::sort(ratios.begin(), ratios.end(), std::greater<float>());
+
+	float const radius = std::max(meshContainer->GetBoundingSphere().radius, static_cast<float>(ETM_DEFAULT_EPSILON));
+	for (float const ratio : ratios)
+	{
+		size_t const targetIndexCount = static_cast<size_t>(static_cast<float>(indices.size() / 3u) * ratio) * 3u;
+		if ((ratio >= 1.f) || (targetIndexCount < 3u))
+		{
+			continue;
+		}
+
+		float error;
+		std::vector<uint32> simplified = mesh_detail::SimplifyMesh(indices, meshContainer->m_Positions, targetIndexCount, error);
+
+		// stop once simplification is blocked by seams and borders, a level that barely reduces the triangle count isn't worth drawing
+		if (simplified.empty() || (simplified.size() > (lodIndices.back().size() * 9u) / 10u))
+		{
+			break;
+		}
+
+		lodErrors.emplace_back(std::max(error / radius, lodErrors.back()));
+		lodIndices.emplace_back(std::move(simplified));
+	}
+
+	// optimize
+	//----------
+	float const acmrBefore = mesh_detail::ComputeACMR(indices, meshContainer->m_VertexCount, s_MeshCacheSize);
+
+	indices.clear();
+	meshContainer->m_Lods.clear();
+	for (size_t lodIdx = 0u; lodIdx < lodIndices.size(); ++lodIdx)
+	{
+		std::vector<uint32>& lod = lodIndices[lodIdx];
+		mesh_detail::OptimizeVertexCache(lod, meshContainer->m_VertexCount);
+		mesh_detail::OptimizeOverdraw(lod, meshContainer->m_Positions, s_MeshCacheSize);
+
+		render::MeshLod meshLod;
+		meshLod.m_FirstIndex = static_cast<uint32>(indices.size());
+		meshLod.m_IndexCount = static_cast<uint32>(lod.size());
+		meshLod.m_Error = lodErrors[lodIdx];
+		meshContainer->m_Lods.emplace_back(meshLod);
+
+		indices.insert(indices.end(), lod.cbegin(), lod.cend());
+	}
+
+	float const acmrAfter = mesh_detail::ComputeACMR(lodIndices[0], meshContainer->m_VertexCount, s_MeshCacheSize);
+	LOG(FS("CookMesh > ACMR %f -> %f", acmrBefore, acmrAfter));
+
+	// full detail indices come first, so vertices used by all levels are fetched from the front of the buffer
+	mesh_detail::OptimizeVertexFetch(*meshContainer);
+
+	render::MeshAsset::WriteCookedMesh(*meshContainer, cookedData);
+
+	LOG(FS("CookMesh > cooked %u vertices and %u indices in %u levels of detail", static_cast<uint32>(meshContainer->m_VertexCount), 
+		static_cast<uint32>(meshContainer->m_Indices.size()), static_cast<uint32>(meshContainer->m_Lods.size())));
+	return true;
+}
+
+
+namespace mesh_detail {
+
+	//---------------------------------
+	// Quadric
+	//
+	// Area weighted sum of squared distances to a set of planes, stored as the upper triangle of A, b and c in p'Ap + 2b'p + c
+	//
+	struct Quadric final
+	{
+		void AddPlane(vec3 const& normal, float const distance, float const weight)
+		{
+			double const x = static_cast<double>(normal.x);
+			double const y = static_cast<double>(normal.y);
+			double const z = static_cast<double>(normal.z);
+			double const d = static_cast<double>(distance);
+			double const w = static_cast<double>(weight);
+
+			a00 += w * x * x; a01 += w * x * y; a02 += w * x * z;
+			a11 += w * y * y; a12 += w * y * z; a22 += w * z * z;
+			b0 += w * x * d; b1 += w * y * d; b2 += w * z * d;
+			c += w * d * d;
+			area += w;
+		}
+
+		void Add(Quadric const& other)
+		{
+			a00 += other.a00; a01 += other.a01; a02 += other.a02;
+			a11 += other.a11; a12 += other.a12; a22 += other.a22;
+			b0 += other.b0; b1 += other.b1; b2 += other.b2;
+			c += other.c;
+			area += other.area;
+		}
+
+		double Evaluate(vec3 const& p) const
+		{
+			double const x = static_cast<double>(p.x);
+			double const y = static_cast<double>(p.y);
+			double const z = static_cast<double>(p.z);
+
+			double const result = a00 * x * x + a11 * y * y + a22 * z * z 
+				+ 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) 
+				+ 2.0 * (b0 * x + b1 * y + b2 * z) 
+				+ c;
+
+			return std::max(result, 0.0);
+		}
+
+		double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double area = 0.0;
+	};
+
+	//---------------------------------
+	// SimplifyMesh
+	//
+	// Reduce a triangle list towards targetIndexCount indices by collapsing edges in order of their quadric error (Garland & Heckbert)
+	//  - vertices collapse onto one of their neighbours, so the result only references existing vertices and needs no new attributes
+	//  - vertices on open borders and attribute seams (several vertices at the same position) stay in place to keep the silhouette and UVs intact
+	//  - collapses run in passes of independent edges sorted by cost, and collapses that would flip a triangle are rejected
+	//  - can return more indices than the target if no more edges can be collapsed, error is set to the largest collapse distance
+	//
+	std::vector<uint32> SimplifyMesh(std::vector<uint32> const& indices, 
+		std::vector<vec3> const& positions, 
+		size_t const targetIndexCount, 
+		float& error)
+	{
+		size_t const vertexCount = positions.size();
+		error = 0.f;
+
+		// weld vertices by position, so that seams can be found and quadrics are shared between them
+		std::vector<uint32> welded(vertexCount);
+		std::vector<uint32> wedgeCount(vertexCount, 0u);
+		{
+			std::vector<uint32> order(vertexCount);
+			std::iota(order.begin(), order.end(), 0u);
+			std::sort(order.begin(), order.end(), [&positions](uint32 const lhs, uint32 const rhs)
+				{
+					vec3 const& l = positions[lhs];
+					vec3 const& r = positions[rhs];
+					return (l.x != r.x) ? (l.x < r.x) : ((l.y != r.y) ? (l.y < r.y) : (l.z < r.z));
+				});
+
+			for (size_t orderIdx = 0u; orderIdx < vertexCount; ++orderIdx)
+			{
+				uint32 const vertIdx = order[orderIdx];
+				vec3 const& position = positions[vertIdx];
+
+				welded[vertIdx] = vertIdx;
+				if (orderIdx > 0u)
+				{
+					vec3 const& previous = positions[order[orderIdx - 1u]];
+					if ((position.x == previous.x) && (position.y == previous.y) && (position.z == previous.z))
+					{
+						welded[vertIdx] = welded[order[orderIdx - 1u]];
+					}
+				}
+
+				++wedgeCount[welded[vertIdx]];
+			}
+		}
+
+		auto isDegenerate = [&welded](uint32 const* const tri)
+			{
+				return (welded[tri[0]] == welded[tri[1]]) || (welded[tri[1]] == welded[tri[2]]) || (welded[tri[2]] == welded[tri[0]]);
+			};
+
+		std::vector<uint32> result;
+		result.reserve(indices.size());
+		for (size_t idx = 0u; idx + 2u < indices.size(); idx += 3u)
+		{
+			if (!isDegenerate(&indices[idx]))
+			{
+				result.insert(result.end(), indices.cbegin() + idx, indices.cbegin() + idx + 3u);
+			}
+		}
+
+		// lock seams and open borders - edges of the welded mesh that have no opposite edge
+		std::vector<bool> locked(vertexCount, false);
+		{
+			auto edgeKey = [](uint32 const from, uint32 const to)
+				{
+					return (static_cast<uint64>(from) << 32u) | static_cast<uint64>(to);
+				};
+
+			std::unordered_set<uint64> edges;
+			for (size_t idx = 0u; idx < result.size(); idx += 3u)
+			{
+				for (size_t corner = 0u; corner < 3u; ++corner)
+				{
+					edges.emplace(edgeKey(welded[result[idx + corner]], welded[result[idx + (corner + 1u) % 3u]]));
+				}
+			}
+
+			std::vector<bool> border(vertexCount, false);
+			for (uint64 const edge : edges)
+			{
+				uint32 const from = static_cast<uint32>(edge >> 32u);
+				uint32 const to = static_cast<uint32>(edge & 0xFFFFFFFFu);
+				if (edges.find(edgeKey(to, from)) == edges.cend())
+				{
+					border[from] = true;
+					border[to] = true;
+				}
+			}
+
+			for (size_t vertIdx = 0u; vertIdx < vertexCount; ++vertIdx)
+			{
+				locked[vertIdx] = (wedgeCount[welded[vertIdx]] > 1u) || border[welded[vertIdx]];
+			}
+		}
+
+		// plane quadrics per welded vertex
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t idx = 0u; idx < result.size(); idx += 3u)
+		{
+			vec3 const& p0 = positions[result[idx]];
+			vec3 const normal = math::cross(positions[result[idx + 1u]] - p0, positions[result[idx + 2u]] - p0);
+
+			float const length = math::length(normal);
+			if (length <= 0.f)
+			{
+				continue;
+			}
+
+			vec3 const unitNormal = normal / length;
+			float const distance = -math::dot(unitNormal, p0);
+			for (size_t corner = 0u; corner < 3u; ++corner)
+			{
+				quadrics[welded[result[idx + corner]]].AddPlane(unitNormal, distance, length * 0.5f);
+			}
+		}
+
+		auto collapseCost = [&quadrics, &welded, &positions](uint32 const source, uint32 const target)
+			{
+				Quadric combined = quadrics[welded[source]];
+				combined.Add(quadrics[welded[target]]);
+				return combined.Evaluate(positions[target]);
+			};
+
+		struct Collapse
+		{
+			uint32 source;
+			uint32 target;
+			double cost;
+		};
+
+		std::vector<Collapse> collapses;
+		std::vector<uint32> remap(vertexCount);
+		std::vector<bool> touched(vertexCount);
+		std::vector<uint32> triangleOffsets(vertexCount + 1u);
+		std::vector<uint32> vertexTriangles;
+
+		size_t const targetTriangleCount = targetIndexCount / 3u;
+		while (result.size() > targetIndexCount)
+		{
+			size_t triangleCount = result.size() / 3u;
+
+			// triangles per vertex
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0u);
+			for (uint32 const index : result)
+			{
+				++triangleOffsets[index + 1u];
+			}
+
+			std::partial_sum(triangleOffsets.cbegin(), triangleOffsets.cend(), triangleOffsets.begin());
+
+			vertexTriangles.resize(result.size());
+			{
+				std::vector<uint32> fill(triangleOffsets.cbegin(), triangleOffsets.cend() - 1);
+				for (size_t idx = 0u; idx < result.size(); ++idx)
+				{
+					vertexTriangles[fill[result[idx]]++] = static_cast<uint32>(idx / 3u);
+				}
+			}
+
+			// cheapest direction of each edge that has an unlocked vertex, interior edges appear in both directions so only one is used
+			collapses.clear();
+			for (size_t idx = 0u; idx < result.size(); idx += 3u)
+			{
+				for (size_t corner = 0u; corner < 3u; ++corner)
+				{
+					uint32 const v0 = result[idx + corner];
+					uint32 const v1 = result[idx + (corner + 1u) % 3u];
+					if ((v0 > v1) || (locked[v0] && locked[v1]))
+					{
+						continue;
+					}
+
+					double const cost0 = locked[v0] ? std::numeric_limits<double>::max() : collapseCost(v0, v1);
+					double const cost1 = locked[v1] ? std::numeric_limits<double>::max() : collapseCost(v1, v0);
+					collapses.emplace_back((cost0 <= cost1) ? Collapse{ v0, v1, cost0 } : Collapse{ v1, v0, cost1 });
+				}
+			}
+
+			if (collapses.empty())
+			{
+				break;
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](Collapse const& lhs, Collapse const& rhs)
+				{
+					return lhs.cost < rhs.cost;
+				});
+
+			// collapse edges whose neighbourhood wasn't changed in this pass yet, so the adjacency stays valid
+			std::iota(remap.begin(), remap.end(), 0u);
+			std::fill(touched.begin(), touched.end(), false);
+
+			size_t collapseCount = 0u;
+			for (Collapse const& collapse : collapses)
+			{
+				if (triangleCount <= targetTriangleCount)
+				{
+					break;
+				}
+
+				if (touched[collapse.source] || touched[collapse.target])
+				{
+					continue;
+				}
+
+				uint32 const* const firstTri = vertexTriangles.data() + triangleOffsets[collapse.source];
+				uint32 const* const lastTri = vertexTriangles.data() + triangleOffsets[collapse.source + 1u];
+
+				size_t removedCount = 0u;
+				bool flips = false;
+				for (uint32 const* triIt = firstTri; triIt != lastTri; ++triIt)
+				{
+					uint32 const* const tri = &result[*triIt * 3u];
+					if ((tri[0] == collapse.target) || (tri[1] == collapse.target) || (tri[2] == collapse.target))
+					{
+						++removedCount;
+						continue;
+					}
+
+					vec3 corners[3] = { positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+					vec3 const before = math::cross(corners[1] - corners[0], corners[2] - corners[0]);
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						if (tri[corner] == collapse.source)
+						{
+							corners[corner] = positions[collapse.target];
+						}
+					}
+
+					vec3 const after = math::cross(corners[1] - corners[0], corners[2] - corners[0]);
+					if (math::dot(before, after) <= 0.25f * math::length(before) * math::length(after))
+					{
+						flips = true;
+						break;
+					}
+				}
+
+				if (flips)
+				{
+					continue;
+				}
+
+				remap[collapse.source] = collapse.target;
+				quadrics[welded[collapse.target]].Add(quadrics[welded[collapse.source]]);
+
+				double const area = std::max(quadrics[welded[collapse.target]].area, static_cast<double>(ETM_DEFAULT_EPSILON));
+				error = std::max(error, static_cast<float>(std::sqrt(collapse.cost / area)));
+
+				for (uint32 const* triIt = firstTri; triIt != lastTri; ++triIt)
+				{
+					for (size_t corner = 0u; corner < 3u; ++corner)
+					{
+						touched[result[*triIt * 3u + corner]] = true;
+					}
+				}
+
+				triangleCount -= removedCount;
+				++collapseCount;
+			}
+
+			if (collapseCount == 0u)
+			{
+				break;
+			}
+
+			// apply the collapses and drop the triangles that became degenerate
+			size_t writeIdx = 0u;
+			for (size_t idx = 0u; idx < result.size(); idx += 3u)
+			{
+				uint32 const tri[3] = { remap[result[idx]], remap[result[idx + 1u]], remap[result[idx + 2u]] };
+				if (!isDegenerate(tri))
+				{
+					std::copy(tri, tri + 3, result.begin() + writeIdx);
+					writeIdx += 3u;
+				}
+			}
+
+			result.resize(writeIdx);
+		}
+
+		return result;
+	}
+
+	//---------------------------------
+	// OptimizeVertexCache
+	//
+	// Greedy triangle reordering after Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+	//  - vertices are scored by their position in a simulated LRU cache and by how many triangles still use them
+	//  - the next triangle is the best scoring one that uses a cached vertex, or the next unused one in input order at a dead end
+	//
+	void OptimizeVertexCache(std::vector<uint32>& indices, size_t const vertexCount)
+	{
+		static int32 const s_LruSize = 32;
+		static float const s_CacheDecayPower = 1.5f;
+		static float const s_LastTriangleScore = 0.75f;
+		static float const s_ValenceBoostScale = 2.f;
+		static float const s_ValenceBoostPower = 0.5f;
+
+		size_t const triangleCount = indices.size() / 3u;
+
+		// triangles per vertex
+		std::vector<uint32> triangleOffsets(vertexCount + 1u, 0u);
+		for (uint32 const index : indices)
+		{
+			++triangleOffsets[index + 1u];
+		}
+
+		std::partial_sum(triangleOffsets.cbegin(), triangleOffsets.cend(), triangleOffsets.begin());
+
+		std::vector<uint32> liveCount(vertexCount);
+		for (size_t vertIdx = 0u; vertIdx < vertexCount; ++vertIdx)
+		{
+			liveCount[vertIdx] = triangleOffsets[vertIdx + 1u] - triangleOffsets[vertIdx];
+		}
+
+		std::vector<uint32> vertexTriangles(indices.size());
+		{
+			std::vector<uint32> fill(triangleOffsets.cbegin(), triangleOffsets.cend() - 1);
+			for (size_t triIdx = 0u; triIdx < triangleCount; ++triIdx)
+			{
+				for (size_t corner = 0u; corner < 3u; ++corner)
+				{
+					vertexTriangles[fill[indices[triIdx * 3u + corner]]++] = static_cast<uint32>(triIdx);
+				}
+			}
+		}
+
+		auto scoreVertex = [](int32 const cachePosition, uint32 const live) -> float
+			{
+				if (live == 0u)
+				{
+					return -1.f;
+				}
+
+				float score = 0.f;
+				if (cachePosition >= 0)
+				{
+					if (cachePosition < 3)
+					{
+						score = s_LastTriangleScore; // fixed so the triangle just emitted doesn't bias towards its own winding
+					}
+					else
+					{
+						float const scale = 1.f / static_cast<float>(s_LruSize - 3);
+						score = std::pow(1.f - static_cast<float>(cachePosition - 3) * scale, s_CacheDecayPower);
+					}
+				}
+
+				return score + s_ValenceBoostScale * std::pow(static_cast<float>(live), -s_ValenceBoostPower);
+			};
+
+		std::vector<int32> cachePositions(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (size_t vertIdx = 0u; vertIdx < vertexCount; ++vertIdx)
+		{
+			vertexScores[vertIdx] = scoreVertex(-1, liveCount[vertIdx]);
+		}
+
+		std::vector<float> triangleScores(triangleCount);
+		for (size_t triIdx = 0u; triIdx < triangleCount; ++triIdx)
+		{
+			triangleScores[triIdx] = vertexScores[indices[triIdx * 3u]] + vertexScores[indices[triIdx * 3u + 1u]] + vertexScores[indices[triIdx * 3u + 2u]];
+		}
+
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32> output;
+		output.reserve(indices.size());
+
+		std::vector<uint32> cache;
+		std::vector<uint32> nextCache;
+		cache.reserve(s_LruSize + 3);
+		nextCache.reserve(s_LruSize + 3);
+
+		size_t cursor = 0u;
+		int64 bestTriangle = -1;
+		for (size_t emittedCount = 0u; emittedCount < triangleCount; ++emittedCount)
+		{
+			// dead end - continue with the next triangle that wasn't emitted yet
+			if (bestTriangle < 0)
+			{
+				while (emitted[cursor])
+				{
+					++cursor;
+				}
+
+				bestTriangle = static_cast<int64>(cursor);
+			}
+
+			size_t const triIdx = static_cast<size_t>(bestTriangle);
+			emitted[triIdx] = true;
+
+			// emit and remove the triangle from its vertices' live lists
+			nextCache.clear();
+			for (size_t corner = 0u; corner < 3u; ++corner)
+			{
+				uint32 const vertIdx = indices[triIdx * 3u + corner];
+				output.push_back(vertIdx);
+				nextCache.push_back(vertIdx);
+
+				uint32* const first = vertexTriangles.data() + triangleOffsets[vertIdx];
+				uint32* const last = first + liveCount[vertIdx];
+				std::iter_swap(std::find(first, last, static_cast<uint32>(triIdx)), last - 1);
+				--liveCount[vertIdx];
+			}
+
+			// the triangle's vertices move to the front of the cache
+			for (uint32 const vertIdx : cache)
+			{
+				if (std::find(nextCache.cbegin(), nextCache.cend(), vertIdx) == nextCache.cend())
+				{
+					nextCache.push_back(vertIdx);
+				}
+			}
+
+			std::swap(cache, nextCache);
+
+			// rescore vertices whose position in the cache or live count changed
+			for (size_t cacheIdx = 0u; cacheIdx < cache.size(); ++cacheIdx)
+			{
+				uint32 const vertIdx = cache[cacheIdx];
+				cachePositions[vertIdx] = (cacheIdx < static_cast<size_t>(s_LruSize)) ? static_cast<int32>(cacheIdx) : -1;
+
+				float const score = scoreVertex(cachePositions[vertIdx], liveCount[vertIdx]);
+				float const delta = score - vertexScores[vertIdx];
+				vertexScores[vertIdx] = score;
+
+				uint32 const* const first = vertexTriangles.data() + triangleOffsets[vertIdx];
+				for (uint32 const* it = first; it != first + liveCount[vertIdx]; ++it)
+				{
+					triangleScores[*it] += delta;
+				}
+			}
+
+			if (cache.size() > static_cast<size_t>(s_LruSize))
+			{
+				cache.resize(static_cast<size_t>(s_LruSize));
+			}
+
+			// best triangle using a cached vertex
+			bestTriangle = -1;
+			float bestScore = -1.f;
+			for (uint32 const vertIdx : cache)
+			{
+				uint32 const* const first = vertexTriangles.data() + triangleOffsets[vertIdx];
+				for (uint32 const* it = first; it != first + liveCount[vertIdx]; ++it)
+				{
+					if (triangleScores[*it] > bestScore)
+					{
+						bestScore = triangleScores[*it];
+						bestTriangle = static_cast<int64>(*it);
+					}
+				}
+			}
+		}
+
+		indices = std::move(output);
+	}
+
+	//---------------------------------
+	// OptimizeOverdraw
+	//
+	// Sorts clusters of triangles so that outward facing parts of the mesh are drawn first and occlude the rest
+	//  - clusters are split where a triangle misses the cache with all of its vertices, so sorting them keeps the cache efficiency
+	//  - expects the indices to be optimized for the vertex cache already
+	//
+	void OptimizeOverdraw(std::vector<uint32>& indices, std::vector<vec3> const& positions, uint32 const cacheSize)
+	{
+		size_t const triangleCount = indices.size() / 3u;
+
+		// split into clusters with a simulated FIFO cache
+		std::vector<size_t> clusterStarts;
+		{
+			std::vector<uint32> timestamps(positions.size(), 0u);
+			uint32 time = cacheSize + 1u;
+			for (size_t triIdx = 0u; triIdx < triangleCount; ++triIdx)
+			{
+				uint32 misses = 0u;
+				for (size_t corner = 0u; corner < 3u; ++corner)
+				{
+					uint32 const vertIdx = indices[triIdx * 3u + corner];
+					if (time - timestamps[vertIdx] > cacheSize)
+					{
+						timestamps[vertIdx] = time++;
+						++misses;
+					}
+				}
+
+				if ((triIdx == 0u) || (misses == 3u))
+				{
+					clusterStarts.push_back(triIdx);
+				}
+			}
+		}
+
+		if (clusterStarts.size() < 2u)
+		{
+			return;
+		}
+
+		// mesh centroid
+		vec3 meshCenter(0.f);
+		for (vec3 const& position : positions)
+		{
+			meshCenter = meshCenter + position;
+		}
+
+		meshCenter = meshCenter / static_cast<float>(positions.size());
+
+		// score clusters by how much their area weighted normal faces away from the center
+		std::vector<float> clusterScores(clusterStarts.size());
+		for (size_t clusterIdx = 0u; clusterIdx < clusterStarts.size(); ++clusterIdx)
+		{
+			size_t const end = (clusterIdx + 1u < clusterStarts.size()) ? clusterStarts[clusterIdx + 1u] : triangleCount;
+
+			vec3 center(0.f);
+			vec3 normal(0.f);
+			float area = 0.f;
+			for (size_t triIdx = clusterStarts[clusterIdx]; triIdx < end; ++triIdx)
+			{
+				vec3 const& p0 = positions[indices[triIdx * 3u]];
+				vec3 const& p1 = positions[indices[triIdx * 3u + 1u]];
+				vec3 const& p2 = positions[indices[triIdx * 3u + 2u]];
+
+				vec3 const triNormal = math::cross(p1 - p0, p2 - p0); // length is twice the area
+				float const triArea = math::length(triNormal);
+
+				center = center + (p0 + p1 + p2) * (triArea / 3.f);
+				normal = normal + triNormal;
+				area += triArea;
+			}
+
+			if (area <= 0.f)
+			{
+				clusterScores[clusterIdx] = 0.f;
+				continue;
+			}
+
+			center = center / area;
+			float const normalLength = math::length(normal);
+			clusterScores[clusterIdx] = (normalLength > 0.f) ? math::dot(center - meshCenter, normal / normalLength) : 0.f;
+		}
+
+		std::vector<size_t> order(clusterStarts.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&clusterScores](size_t const lhs, size_t const rhs)
+			{
+				return clusterScores[lhs] > clusterScores[rhs];
+			});
+
+		std::vector<uint32> output;
+		output.reserve(indices.size());
+		for (size_t const clusterIdx : order)
+		{
+			size_t const end = (clusterIdx + 1u < clusterStarts.size()) ? clusterStarts[clusterIdx + 1u] : triangleCount;
+			output.insert(output.end(), indices.cbegin() + clusterStarts[clusterIdx] * 3u, indices.cbegin() + end * 3u);
+		}
+
+		indices = std::move(output);
+	}
+
+	//---------------------------------
+	// OptimizeVertexFetch
+	//
+	// Reorder vertices in the order the index buffer first references them, dropping vertices that aren't referenced
+	//
+	void OptimizeVertexFetch(render::MeshDataContainer& mesh)
+	{
+		static uint32 const s_Unused = std::numeric_limits<uint32>::max();
+
+		std::vector<uint32> remap(mesh.m_VertexCount, s_Unused);
+		uint32 nextVertex = 0u;
+		for (uint32& index : mesh.m_Indices)
+		{
+			if (remap[index] == s_Unused)
+			{
+				remap[index] = nextVertex++;
+			}
+
+			index = remap[index];
+		}
+
+		size_t const oldCount = mesh.m_VertexCount;
+		auto remapAttribute = [&remap, oldCount, nextVertex](auto& attribute)
+			{
+				if (attribute.size() != oldCount)
+				{
+					return;
+				}
+
+				std::remove_reference_t<decltype(attribute)> remapped(nextVertex);
+				for (size_t vertIdx = 0u; vertIdx < oldCount; ++vertIdx)
+				{
+					if (remap[vertIdx] != s_Unused)
+					{
+						remapped[remap[vertIdx]] = attribute[vertIdx];
+					}
+				}
+
+				attribute = std::move(remapped);
+			};
+
+		remapAttribute(mesh.m_Positions);
+		remapAttribute(mesh.m_Normals);
+		remapAttribute(mesh.m_BiNormals);
+		remapAttribute(mesh.m_Tangents);
+		remapAttribute(mesh.m_Colors);
+		remapAttribute(mesh.m_TexCoords);
+
+		mesh.m_VertexCount = static_cast<size_t>(nextVertex);
+	}
+
+	//---------------------------------
+	// ComputeACMR
+	//
+	// Average vertex shader invocations per triangle with a FIFO post transform cache of cacheSize vertices
+	//
+	float ComputeACMR(std::vector<uint32> const& indices, size_t const vertexCount, uint32 const cacheSize)
+	{
+		if (indices.size() < 3u)
+		{
+			return 0.f;
+		}
+
+		std::vector<uint32> timestamps(vertexCount, 0u);
+		uint32 time = cacheSize + 1u;
+		uint32 misses = 0u;
+		for (uint32 const index : indices)
+		{
+			if (time - timestamps[index] > cacheSize)
+			{
+				timestamps[index] = time++;
+				++misses;
+			}
+		}
+
+		return static_cast<float>(misses) / static_cast<float>(indices.size() / 3u);
+	}
+
+} // namespace mesh_detail
+
+
+} // namespace cooker
+} // namespace et
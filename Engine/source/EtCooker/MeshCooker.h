@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <string>
+
+#include <EtCore/Util/AtomicTypes.h>
+#include <EtMath/Vector.h>
+
+
+namespace et { namespace render {
+	struct MeshDataContainer;
+} }
+
+
+namespace et {
+namespace cooker {
+
+
+bool CookMesh(std::string const& assetName, 
+	std::vector<float> const& lodRatios, 
+	std::vector<uint8> const& sourceData, 
+	std::vector<uint8>& cookedData);
+
+//---------------------------------
+// mesh_detail
+//
+// Simplification into levels of detail, and reordering of triangles and vertices for post transform cache efficiency, overdraw and vertex fetch
+//
+namespace mesh_detail {
+
+	std::vector<uint32> SimplifyMesh(std::vector<uint32> const& indices, 
+		std::vector<vec3> const& positions, 
+		size_t const targetIndexCount, 
+		float& error);
+
+	void OptimizeVertexCache(std::vector<uint32>& indices, size_t const vertexCount);
+	void OptimizeOverdraw(std::vector<uint32>& indices, std::vector<vec3> const& positions, uint32 const cacheSize);
+	void OptimizeVertexFetch(render::MeshDataContainer& mesh);
+
+	float ComputeACMR(std::vector<uint32> const& indices, size_t const vertexCount, uint32 const cacheSize);
+
+} // namespace mesh_detail
+
+
+} // namespace cooker
+} // namespace et
@@ -46,13 +46,26 @@ PackageWriter::~PackageWriter()
 // Add a file to the writer and create a package entry for it - takes ownership
 //
 void PackageWriter::AddFile(core::File* const file, std::string const& rootDir, core::E_CompressionType const compression)
+{
+	AddFileAs(file, file->GetName(), rootDir, compression);
+}
+
+//---------------------------------
+// PackageWriter::AddFileAs
+//
+// Add a file to the writer with the entry name of a different file, e.g. a cached cooked asset in place of its source - takes ownership
+//
+void PackageWriter::AddFileAs(core::File* const file, 
+	std::string const& fileName, 
+	std::string const& rootDir, 
+	core::E_CompressionType const compression)
 {
 	m_Files.emplace_back(core::PkgEntry(), file, std::string());
 	core::PkgEntry& entry = m_Files[m_Files.size() - 1].entry;
 	std::string& relName = m_Files[m_Files.size() - 1].relName;
 
 	// assign the name the relative path of the file compared to the root directory of the package writer
-	relName = core::FileUtil::GetRelativePath(file->GetName(), rootDir);
+	relName = core::FileUtil::GetRelativePath(fileName, rootDir);
 
 	entry.fileId = GetHash(relName);
 	entry.compressionType = compression; 
@@ -69,6 +82,24 @@ void PackageWriter::AddFile(core::File* const file, std::string const& rootDir,
 	entry.size = file->GetSize();
 }
 
+//---------------------------------
+// PackageWriter::AddData
+//
+// Add generated content to the writer as if it was read from a file with the given name, e.g. cooked assets
+//
+void PackageWriter::AddData(std::vector<uint8>&& data, std::string const& fileName, std::string const& rootDir, core::E_CompressionType const compression)
+{
+	m_Files.emplace_back(core::PkgEntry(), nullptr, core::FileUtil::GetRelativePath(fileName, rootDir));
+	FileEntryInfo& info = m_Files[m_Files.size() - 1];
+
+	info.data = std::move(data);
+
+	info.entry.fileId = GetHash(info.relName);
+	info.entry.compressionType = compression;
+	info.entry.nameLength = static_cast<uint16>(info.relName.size());
+	info.entry.size = static_cast<uint64>(info.data.size());
+}
+
 //---------------------------------
 // PackageWriter::RemoveFile
 //
@@ -96,7 +127,7 @@ void PackageWriter::Cleanup()
 {
 	for (FileEntryInfo& entryFile : m_Files)
 	{
-		if (entryFile.file->IsOpen())
+		if ((entryFile.file != nullptr) && entryFile.file->IsOpen())
 		{
 			entryFile.file->Close();
 
@@ -115,6 +146,48 @@ void PackageWriter::Cleanup()
 // Write the listed files to the data vector
 //
 void PackageWriter::Write(std::vector<uint8>& data)
+{
+	data.clear();
+
+	uint64 const size = WriteContent([&data](std::vector<uint8> const& chunk)
+		{
+			data.insert(data.end(), chunk.cbegin(), chunk.cend());
+		});
+
+	ET_ASSERT(static_cast<uint64>(data.size()) == size);
+	UNUSED(size);
+}
+
+//---------------------------------
+// PackageWriter::Write
+//
+// Stream the listed files into an open file, so that the package is never held in memory as a whole
+//
+bool PackageWriter::Write(core::File& file)
+{
+	ET_ASSERT(file.IsOpen());
+
+	bool success = true;
+	WriteContent([&file, &success](std::vector<uint8> const& chunk)
+		{
+			success = success && file.Write(chunk);
+		});
+
+	if (!success)
+	{
+		LOG("PackageWriter::Write > Failed to write package to '" + file.GetName() + std::string("'"), core::LogLevel::Warning);
+	}
+
+	return success;
+}
+
+//---------------------------------
+// PackageWriter::WriteContent
+//
+// Pass the package to writeChunk in order - the header with the central directory, followed by each entry and its content
+//  - returns the total size of the package
+//
+uint64 PackageWriter::WriteContent(std::function<void(std::vector<uint8> const&)> const& writeChunk)
 {
 	// we do a first pass where we figure out the relative offset for all files
 	//---------------------------
@@ -144,26 +217,24 @@ void PackageWriter::Write(std::vector<uint8>& data)
 		offset += sizeof(core::PkgEntry) + static_cast<uint64>(entry.nameLength) + entry.size;
 	}
 
-	// now we know the total size of the package file will be our offset, so we can initialize our data vector starting with the right size
-	//---------------------------
-	data = std::vector<uint8>(static_cast<size_t>(offset), 0u);
-	uint8* raw = data.data();
+	uint64 const totalSize = offset;
 
-	// finally we can write our data to the vector
+	// header and central dir
 	//---------------------------
+	std::vector<uint8> chunk(sizeof(core::PkgHeader) + sizeof(core::PkgFileInfo) * fileInfos.size());
+	memcpy(chunk.data(), &header, sizeof(core::PkgHeader));
+	offset = sizeof(core::PkgHeader);	// we can reuse it now that we know the package layout
 
-	// header
-	memcpy(raw, &header, sizeof(core::PkgHeader));
-	offset = sizeof(core::PkgHeader);	// we can reuse it now that our vector has bin initialized
-
-	// central dir
 	for (core::PkgFileInfo const& info : fileInfos)
 	{
-		memcpy(raw + offset, &info, sizeof(core::PkgFileInfo));
+		memcpy(chunk.data() + offset, &info, sizeof(core::PkgFileInfo));
 		offset += sizeof(core::PkgFileInfo);
 	}
 
+	writeChunk(chunk);
+
 	// files
+	//---------------------------
 	for (size_t entryIndex = 0u; entryIndex < m_Files.size(); ++entryIndex)
 	{
 		FileEntryInfo& entryFile = m_Files[entryIndex];
@@ -173,30 +244,45 @@ void PackageWriter::Write(std::vector<uint8>& data)
 			LOG("PackageWriter::Write > Entry offset doesn't match expected offset - " + entryFile.relName, core::LogLevel::Error);
 		}
 
-		// copy the entry
-		memcpy(raw + offset, &entryFile.entry, sizeof(core::PkgEntry));
-		offset += sizeof(core::PkgEntry);
-
-		// copy the file name string
+		// the entry and the file name string
 		if (entryFile.entry.nameLength != entryFile.relName.size())
 		{
 			LOG("PackageWriter::Write > Entry name length doesn't match file name length - " + entryFile.relName, core::LogLevel::Error);
 		}
 
-		memcpy(raw + offset, entryFile.relName.c_str(), entryFile.entry.nameLength);
-		offset += entryFile.entry.nameLength;
+		chunk.resize(sizeof(core::PkgEntry) + entryFile.entry.nameLength);
+		memcpy(chunk.data(), &entryFile.entry, sizeof(core::PkgEntry));
+		memcpy(chunk.data() + sizeof(core::PkgEntry), entryFile.relName.c_str(), entryFile.entry.nameLength);
 
-		// copy the file content
-		std::vector<uint8> fileContent = entryFile.file->Read();
+		writeChunk(chunk);
+		offset += static_cast<uint64>(chunk.size());
 
-		if (entryFile.entry.size != static_cast<uint64>(fileContent.size()))
+		// the file content, files are only read now so that only one of them is in memory at a time
+		if (entryFile.file != nullptr)
+		{
+			chunk = entryFile.file->Read();
+		}
+		else
+		{
+			chunk.swap(entryFile.data);
+		}
+
+		if (entryFile.entry.size != static_cast<uint64>(chunk.size()))
 		{
 			LOG("PackageWriter::Write > Entry size doesn't match read file contents size - " + entryFile.relName, core::LogLevel::Error);
+			chunk.resize(static_cast<size_t>(entryFile.entry.size), 0u);
 		}
 
-		memcpy(raw + offset, fileContent.data(), entryFile.entry.size);
+		writeChunk(chunk);
 		offset += entryFile.entry.size;
+
+		if (entryFile.file == nullptr)
+		{
+			chunk.swap(entryFile.data); // keep generated content so that the package can be written again
+		}
 	}
+
+	return totalSize;
 }
 
 
@@ -1,4 +1,6 @@
 #pragma once
+#include <functional>
+
 #include <EtCore/FileSystem/Package/PackageDataStructure.h>
 
 
@@ -15,6 +17,7 @@ namespace cooker {
 // PackageWriter
 //
 // Writes a list of files to a binary package/archive 
+//  - file content is only read when the package is written, one file at a time
 //
 class PackageWriter final
 {
@@ -28,6 +31,7 @@ public:
 		core::PkgEntry entry;
 		core::File* file;
 		std::string relName;
+		std::vector<uint8> data; // content for entries that don't come from a file
 	};
 
 	// c-tor d-tor
@@ -38,14 +42,22 @@ public:
 	// functionality
 	//------------------
 	void AddFile(core::File* const file, std::string const& rootDir, core::E_CompressionType const compression);
+	void AddFileAs(core::File* const file, std::string const& fileName, std::string const& rootDir, core::E_CompressionType const compression);
+	void AddData(std::vector<uint8>&& data, std::string const& fileName, std::string const& rootDir, core::E_CompressionType const compression);
 	void RemoveFile(core::File* const file);
 	void Cleanup();
 
 	void Write(std::vector<uint8>& data);
+	bool Write(core::File& file);
+
+	// utility
+	//------------------
+private:
+	uint64 WriteContent(std::function<void(std::vector<uint8> const&)> const& writeChunk);
 
 	// Data
 	///////
-private:
+
 	std::vector<FileEntryInfo> m_Files;
 };
 
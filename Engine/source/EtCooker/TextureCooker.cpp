@@ -0,0 +1,271 @@
+#include "TextureCooker.h"
+#include <EtFramework/stdafx.h>
+
+#include <stb/stb_image.h>
+
+#include <EtCore/Util/JobPool.h>
+
+#include <EtRendering/GraphicsTypes/TextureData.h>
+#include <EtRendering/GraphicsTypes/TextureCompression.h>
+
+
+namespace et {
+namespace cooker {
+
+
+//---------------------------------
+// CookTexture
+//
+// Decodes a source image once and writes it as a cooked texture with its full mip chain, see TextureDataStructure.h
+//  - mip levels are box filtered, in linear space for sRGB textures
+//  - levels are block compressed as the asset specifies, on the threads of the job pool
+//
+bool CookTexture(render::TextureAsset const& asset, std::vector<uint8> const& sourceData, std::vector<uint8>& cookedData)
+{
+	// formats
+	//---------
+	bool const isSrgb = asset.m_UseSrgb && (asset.m_Compression != render::E_TextureCompression::BC5);
+
+	render::E_ColorFormat internalFormat = isSrgb ? render::E_ColorFormat::SRGB : render::E_ColorFormat::RGB;
+	render::E_ColorFormat format = render::E_ColorFormat::RGB;
+	int32 channels = 3; // uncompressed textures are opaque, same as source images loaded at runtime
+
+	switch (asset.m_Compression)
+	{
+	case render::E_TextureCompression::BC1:
+		internalFormat = isSrgb ? render::E_ColorFormat::BC1_SRGB : render::E_ColorFormat::BC1_RGB;
+		break;
+
+	case render::E_TextureCompression::BC3:
+		internalFormat = isSrgb ? render::E_ColorFormat::BC3_SRGBA : render::E_ColorFormat::BC3_RGBA;
+		format = render::E_ColorFormat::RGBA;
+		channels = 4;
+		break;
+
+	case render::E_TextureCompression::BC5:
+		internalFormat = render::E_ColorFormat::BC5_RG;
+		format = render::E_ColorFormat::RG;
+		channels = 4; // stb only decodes grey and alpha for 2 channels, so the first two channels are taken from RGBA
+		break;
+
+	case render::E_TextureCompression::BC7:
+		internalFormat = isSrgb ? render::E_ColorFormat::BC7_SRGBA : render::E_ColorFormat::BC7_RGBA;
+		format = render::E_ColorFormat::RGBA;
+		channels = 4;
+		break;
+
+	default:
+		break;
+	}
+
+	// decode
+	//--------
+	stbi_set_flip_vertically_on_load(false);
+
+	ivec2 res;
+	int32 sourceChannels = 0;
+	uint8* const bits = stbi_load_from_memory(sourceData.data(), static_cast<int32>(sourceData.size()), &res.x, &res.y, &sourceChannels, channels);
+	if (bits == nullptr)
+	{
+		LOG("CookTexture > Failed to decode image", core::LogLevel::Warning);
+		return false;
+	}
+
+	if ((res.x == 0) || (res.y == 0))
+	{
+		LOG("CookTexture > Image is empty", core::LogLevel::Warning);
+		stbi_image_free(bits);
+		return false;
+	}
+
+	std::vector<std::vector<uint8>> levels;
+	levels.emplace_back(bits, bits + static_cast<size_t>(res.x) * static_cast<size_t>(res.y) * static_cast<size_t>(channels));
+	stbi_image_free(bits);
+
+	// mip chain
+	//-----------
+	ivec2 levelRes = res;
+	if (asset.m_Parameters.genMipMaps)
+	{
+		while ((levelRes.x > 1) || (levelRes.y > 1))
+		{
+			std::vector<uint8> mip;
+			texture_detail::GenerateMip(levels.back(), levelRes, static_cast<uint32>(channels), isSrgb, mip);
+			levels.emplace_back(std::move(mip));
+
+			levelRes = render::TextureData::GetMipResolution(levelRes, 1u);
+		}
+	}
+
+	// compress
+	//----------
+	size_t uncompressedSize = 0u;
+	size_t cookedSize = 0u;
+	for (size_t levelIdx = 0u; levelIdx < levels.size(); ++levelIdx)
+	{
+		ivec2 const mipRes = render::TextureData::GetMipResolution(res, static_cast<uint8>(levelIdx));
+		uncompressedSize += static_cast<size_t>(mipRes.x) * static_cast<size_t>(mipRes.y) * 4u;
+
+		if (asset.m_Compression != render::E_TextureCompression::None)
+		{
+			std::vector<uint8> blocks;
+			texture_detail::CompressLevel(levels[levelIdx], mipRes, static_cast<uint32>(channels), asset.m_Compression, blocks);
+			levels[levelIdx] = std::move(blocks);
+		}
+
+		ET_ASSERT(levels[levelIdx].size() == render::TextureData::GetMipSize(internalFormat, format, mipRes));
+		cookedSize += levels[levelIdx].size();
+	}
+
+	render::TextureAsset::WriteCookedTexture(res, internalFormat, format, levels, cookedData);
+
+	LOG(FS("CookTexture > cooked %ix%i texture with %u levels, %u KB (%u KB as RGBA8)", res.x, res.y, static_cast<uint32>(levels.size()),
+		static_cast<uint32>(cookedSize / 1024u), static_cast<uint32>(uncompressedSize / 1024u)));
+	return true;
+}
+
+
+namespace texture_detail {
+
+	//---------------------------------
+	// GenerateMip
+	//
+	// Average 2x2 texels of the source level into the next level, odd edges reuse their last row or column
+	//
+	void GenerateMip(std::vector<uint8> const& source, ivec2 const sourceRes, uint32 const channels, bool const isSrgb, std::vector<uint8>& target)
+	{
+		static std::array<float, 256u> const s_SrgbToLinear = []()
+			{
+				std::array<float, 256u> table;
+				for (size_t value = 0u; value < table.size(); ++value)
+				{
+					float const normalized = static_cast<float>(value) / 255.f;
+					table[value] = (normalized <= 0.04045f) ? (normalized / 12.92f) : std::pow((normalized + 0.055f) / 1.055f, 2.4f);
+				}
+
+				return table;
+			}();
+
+		auto linearToSrgb = [](float const linear) -> float
+			{
+				return (linear <= 0.0031308f) ? (linear * 12.92f) : (1.055f * std::pow(linear, 1.f / 2.4f) - 0.055f);
+			};
+
+		ivec2 const res = render::TextureData::GetMipResolution(sourceRes, 1u);
+		target.resize(static_cast<size_t>(res.x) * static_cast<size_t>(res.y) * static_cast<size_t>(channels));
+
+		for (int32 y = 0; y < res.y; ++y)
+		{
+			int32 const y0 = std::min(y * 2, sourceRes.y - 1);
+			int32 const y1 = std::min(y * 2 + 1, sourceRes.y - 1);
+
+			for (int32 x = 0; x < res.x; ++x)
+			{
+				int32 const x0 = std::min(x * 2, sourceRes.x - 1);
+				int32 const x1 = std::min(x * 2 + 1, sourceRes.x - 1);
+
+				size_t const corners[4] = {
+					static_cast<size_t>(y0 * sourceRes.x + x0) * channels,
+					static_cast<size_t>(y0 * sourceRes.x + x1) * channels,
+					static_cast<size_t>(y1 * sourceRes.x + x0) * channels,
+					static_cast<size_t>(y1 * sourceRes.x + x1) * channels
+				};
+
+				uint8* const texel = target.data() + static_cast<size_t>(y * res.x + x) * channels;
+				for (uint32 channel = 0u; channel < channels; ++channel)
+				{
+					bool const isLinear = !isSrgb || (channel == 3u); // alpha is never encoded
+
+					float sum = 0.f;
+					for (size_t const corner : corners)
+					{
+						uint8 const value = source[corner + channel];
+						sum += isLinear ? (static_cast<float>(value) / 255.f) : s_SrgbToLinear[value];
+					}
+
+					float const average = sum * 0.25f;
+					float const encoded = isLinear ? average : linearToSrgb(average);
+					texel[channel] = static_cast<uint8>(math::Clamp01(encoded) * 255.f + 0.5f);
+				}
+			}
+		}
+	}
+
+	//---------------------------------
+	// CompressLevel
+	//
+	// Encode a level into 4x4 blocks in row order, block rows are split across the threads of the job pool
+	//  - blocks that extend past the edge repeat the last row or column
+	//
+	void CompressLevel(std::vector<uint8> const& texels,
+		ivec2 const res,
+		uint32 const channels,
+		render::E_TextureCompression const compression,
+		std::vector<uint8>& blocks)
+	{
+		size_t const blockSize = (compression == render::E_TextureCompression::BC1) ? 8u : 16u;
+		int32 const blocksX = (res.x + 3) / 4;
+		int32 const blocksY = (res.y + 3) / 4;
+
+		blocks.resize(static_cast<size_t>(blocksX) * static_cast<size_t>(blocksY) * blockSize);
+
+		core::JobPool::T_GrainFn const compressRows = [&texels, res, channels, compression, blockSize, blocksX, &blocks](size_t const grainIdx,
+			size_t const firstRow,
+			size_t const lastRow)
+			{
+				UNUSED(grainIdx);
+
+				float block[16][4];
+				for (int32 blockY = static_cast<int32>(firstRow); blockY < static_cast<int32>(lastRow); ++blockY)
+				{
+					for (int32 blockX = 0; blockX < blocksX; ++blockX)
+					{
+						for (int32 texel = 0; texel < 16; ++texel)
+						{
+							int32 const x = std::min(blockX * 4 + (texel % 4), res.x - 1);
+							int32 const y = std::min(blockY * 4 + (texel / 4), res.y - 1);
+							uint8 const* const source = texels.data() + static_cast<size_t>(y * res.x + x) * channels;
+
+							for (uint32 channel = 0u; channel < 4u; ++channel)
+							{
+								block[texel][channel] = (channel < channels) ? static_cast<float>(source[channel]) : 255.f;
+							}
+						}
+
+						uint8* const output = blocks.data() + static_cast<size_t>(blockY * blocksX + blockX) * blockSize;
+						switch (compression)
+						{
+						case render::E_TextureCompression::BC1:
+							render::texture_compression::CompressBC1Block(block, output);
+							break;
+
+						case render::E_TextureCompression::BC3:
+							render::texture_compression::CompressBC4Block(block, 3u, output);
+							render::texture_compression::CompressBC1Block(block, output + 8u);
+							break;
+
+						case render::E_TextureCompression::BC5:
+							render::texture_compression::CompressBC4Block(block, 0u, output);
+							render::texture_compression::CompressBC4Block(block, 1u, output + 8u);
+							break;
+
+						case render::E_TextureCompression::BC7:
+							render::texture_compression::CompressBC7Block(block, output);
+							break;
+
+						default:
+							ET_ASSERT(false, "unhandled texture compression");
+							break;
+						}
+					}
+				}
+			};
+
+		core::JobPool::GetInstance()->Run(0u, static_cast<size_t>(blocksY), 1u, compressRows);
+	}
+
+} // namespace texture_detail
+
+
+} // namespace cooker
+} // namespace et
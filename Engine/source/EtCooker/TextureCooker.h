@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+
+#include <EtCore/Util/AtomicTypes.h>
+#include <EtMath/Vector.h>
+
+
+namespace et { namespace render {
+	class TextureAsset;
+	enum class E_TextureCompression : uint8;
+} }
+
+
+namespace et {
+namespace cooker {
+
+
+bool CookTexture(render::TextureAsset const& asset, std::vector<uint8> const& sourceData, std::vector<uint8>& cookedData);
+
+//---------------------------------
+// texture_detail
+//
+// Mip chain generation and level compression of 8 bit textures on the CPU, the block encoders live in render::texture_compression
+//
+namespace texture_detail {
+
+	void GenerateMip(std::vector<uint8> const& source, ivec2 const sourceRes, uint32 const channels, bool const isSrgb, std::vector<uint8>& target);
+	void CompressLevel(std::vector<uint8> const& texels,
+		ivec2 const res,
+		uint32 const channels,
+		render::E_TextureCompression const compression,
+		std::vector<uint8>& blocks);
+
+} // namespace texture_detail
+
+
+} // namespace cooker
+} // namespace et
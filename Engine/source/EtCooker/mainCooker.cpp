@@ -2,10 +2,15 @@
 
 #include "PackageWriter.h"
 #include "CompiledDataGenerator.h"
+#include "CookCache.h"
+#include "FontCooker.h"
+#include "MeshCooker.h"
+#include "TextureCooker.h"
 
 #include <EtBuild/EngineVersion.h>
 
 #include <EtCore/Util/Logger.h>
+#include <EtCore/Util/JobPool.h>
 #include <EtCore/FileSystem/FileUtil.h>
 #include <EtCore/FileSystem/Entry.h>
 #include <EtCore/FileSystem/Package/FilePackage.h>
@@ -13,6 +18,10 @@
 #include <EtCore/Content/AssetDatabase.h>
 #include <EtCore/Content/ResourceManager.h>
 
+#include <EtRendering/GraphicsTypes/SpriteFont.h>
+#include <EtRendering/GraphicsTypes/Mesh.h>
+#include <EtRendering/GraphicsTypes/TextureData.h>
+
 #include <EtFramework/linkerHelper.h>
 #include <EtFramework/Config/BootConfig.h>
 
@@ -43,18 +52,25 @@ namespace cooker {
 
 
 // forward declarations
-void AddPackageToWriter(core::HashString const packageId, std::string const& dbBase, PackageWriter &writer, core::AssetDatabase& db);
+void AddPackageToWriter(core::HashString const packageId, 
+	std::string const& dbBase, 
+	PackageWriter &writer, 
+	core::AssetDatabase& db, 
+	CookCache const& cache);
+bool CookAsset(core::I_Asset const& asset, std::vector<uint8> const& sourceData, std::vector<uint8>& cookedData);
 void CookCompiledPackage(std::string const& dbBase, 
 	std::string const& outPath, 
 	std::string const& resName, 
 	core::AssetDatabase& db, 
 	std::string const& engineDbBase, 
-	core::AssetDatabase& engineDb);
+	core::AssetDatabase& engineDb,
+	CookCache const& cache);
 void CookFilePackages(std::string const& dbBase, 
 	std::string const& outPath, 
 	core::AssetDatabase& db,
 	std::string const& engineDbBase,
-	core::AssetDatabase& engineDb);
+	core::AssetDatabase& engineDb,
+	CookCache const& cache);
 
 
 ////////////////////////////////////////////////////
@@ -103,6 +119,8 @@ int RunCooker(int argc, char *argv[])
 	}
 	std::string engineDbBase = core::FileUtil::ExtractPath(engineDbPath);
 
+	CookCache const cache(CookCache::s_DirectoryName);
+
 	if (genCompiledResource)
 	{
 		if (argc < 5)
@@ -112,15 +130,16 @@ int RunCooker(int argc, char *argv[])
 		}
 		std::string resName(argv[5]);
 
-		CookCompiledPackage(dbBase, outPath, resName, database, engineDbBase, engineDb);
+		CookCompiledPackage(dbBase, outPath, resName, database, engineDbBase, engineDb, cache);
 	}
 	else
 	{
-		CookFilePackages(dbBase, outPath, database, engineDbBase, engineDb);
+		CookFilePackages(dbBase, outPath, database, engineDbBase, engineDb, cache);
 	}
 
 	// Clean up
 	//----------
+	core::JobPool::DestroyInstance();
 	core::Logger::Release();
 
 	return 0;
@@ -131,22 +150,175 @@ int RunCooker(int argc, char *argv[])
 // AddPackageToWriter
 //
 // Gets all assets in a package of that database and adds them to the package writer
+//  - assets that have a cooked format are cooked in parallel, or taken from the cook cache if nothing they depend on changed
+//  - if cooking fails the source file is added instead
+//  - assets are added in database order regardless of when they finish, so that packages are deterministic
 //
-void AddPackageToWriter(core::HashString const packageId, std::string const& dbBase, PackageWriter &writer, core::AssetDatabase& db)
+void AddPackageToWriter(core::HashString const packageId, 
+	std::string const& dbBase, 
+	PackageWriter &writer, 
+	core::AssetDatabase& db, 
+	CookCache const& cache)
 {
-	// Loop over files - add them to the writer
+	struct CookJob
+	{
+		core::I_Asset const* asset;
+		uint64 settingsHash;
+
+		bool isCooked = false;
+		bool isCached = false;
+		bool isUpToDate = false;
+		CookCache::T_Key key = 0u;
+		std::vector<uint8> cookedData; // only if storing in the cache failed
+	};
+
+	// figure out which assets need cooking, settings are serialized here as reflection isn't guaranteed to be thread safe
 	core::AssetDatabase::T_AssetList assets = db.GetAssetsInPackage(packageId);
+
+	std::vector<CookJob> jobs;
 	for (core::I_Asset const* const asset : assets)
 	{
-		std::string const filePath = dbBase + asset->GetPath();
-		std::string const assetName = asset->GetName();
-		core::HashString const id = asset->GetId();
+		LOG(asset->GetName() + std::string(" [") + std::to_string(asset->GetId().Get()) + std::string("] @: ")
+			+ core::FileUtil::GetAbsolutePath(dbBase + asset->GetPath()));
+
+		bool const isFont = (dynamic_cast<render::FontAsset const*>(asset) != nullptr) && (core::FileUtil::ExtractExtension(asset->GetName()) == "ttf");
+		bool const isMesh = (dynamic_cast<render::MeshAsset const*>(asset) != nullptr);
+		bool const isTexture = (dynamic_cast<render::TextureAsset const*>(asset) != nullptr);
+		if (isFont || isMesh || isTexture)
+		{
+			jobs.emplace_back();
+			jobs.back().asset = asset;
+			jobs.back().settingsHash = CookCache::HashSettings(*asset);
+		}
+	}
+
+	// cook on the shared job pool, cookers that split their own work run it inline on the thread of the asset instead of oversubscribing the pool
+	core::JobPool::T_GrainFn const cookJob = [&jobs, &dbBase, &cache](size_t const jobIdx, size_t const begin, size_t const end)
+		{
+			UNUSED(begin);
+			UNUSED(end);
 
-		LOG(assetName + std::string(" [") + std::to_string(id.Get()) + std::string("] @: ") + core::FileUtil::GetAbsolutePath(filePath));
+			CookJob& job = jobs[jobIdx];
+			std::string const fileName = dbBase + job.asset->GetPath() + job.asset->GetName();
+
+			std::vector<uint8> sourceData;
+
+			core::File* const sourceFile = new core::File(fileName, nullptr);
+			if (sourceFile->Open(core::FILE_ACCESS_MODE::Read))
+			{
+				sourceData = sourceFile->Read();
+				sourceFile->Close();
+			}
+
+			delete sourceFile;
+
+			if (sourceData.empty())
+			{
+				LOG("AddPackageToWriter > failed to read '" + fileName + std::string("'"), core::LogLevel::Warning);
+				return;
+			}
+
+			job.key = cache.GetKey(job.settingsHash, sourceData);
+			if (cache.Contains(job.key))
+			{
+				job.isCooked = true;
+				job.isCached = true;
+				job.isUpToDate = true;
+				return;
+			}
+
+			if (!CookAsset(*job.asset, sourceData, job.cookedData))
+			{
+				LOG("AddPackageToWriter > failed to cook '" + job.asset->GetName() + std::string("', adding the source file"), 
+					core::LogLevel::Warning);
+				job.cookedData.clear();
+				return;
+			}
+
+			job.isCooked = true;
+			if (cache.Store(job.key, job.cookedData))
+			{
+				job.isCached = true;
+				job.cookedData.clear();
+				job.cookedData.shrink_to_fit();
+			}
+		};
+
+	core::JobPool::GetInstance()->Run(0u, jobs.size(), 1u, cookJob);
+
+	// add everything to the writer, cooked assets are streamed from the cache when the package is written
+	size_t cookedCount = 0u;
+	size_t upToDateCount = 0u;
+	auto jobIt = jobs.begin();
+	for (core::I_Asset const* const asset : assets)
+	{
+		std::string const fileName = dbBase + asset->GetPath() + asset->GetName();
 
-		core::File* assetFile = new core::File(filePath + assetName, nullptr);
-		writer.AddFile(assetFile, dbBase, core::E_CompressionType::Store);
+		if ((jobIt != jobs.end()) && (jobIt->asset == asset))
+		{
+			CookJob& job = *jobIt++;
+			if (job.isCooked)
+			{
+				if (job.isUpToDate)
+				{
+					++upToDateCount;
+				}
+				else
+				{
+					++cookedCount;
+				}
+
+				if (job.isCached)
+				{
+					writer.AddFileAs(new core::File(cache.GetFilePath(job.key), nullptr), fileName, dbBase, core::E_CompressionType::Store);
+				}
+				else
+				{
+					writer.AddData(std::move(job.cookedData), fileName, dbBase, core::E_CompressionType::Store);
+				}
+
+				continue;
+			}
+		}
+
+		writer.AddFile(new core::File(fileName, nullptr), dbBase, core::E_CompressionType::Store);
+	}
+
+	LOG(FS("AddPackageToWriter > %u assets - cooked %u, %u up to date", 
+		static_cast<uint32>(assets.size()), 
+		static_cast<uint32>(cookedCount), 
+		static_cast<uint32>(upToDateCount)));
+}
+
+//--------------------
+// CookAsset
+//
+// Convert the source data of an asset into its cooked format, returns false if the asset type has none or cooking fails
+//  - ttf fonts are baked into cooked fonts with a prebuilt atlas
+//  - meshes are imported once and stored as cooked meshes with levels of detail
+//  - textures are stored with their mip chain and optional block compression
+//
+bool CookAsset(core::I_Asset const& asset, std::vector<uint8> const& sourceData, std::vector<uint8>& cookedData)
+{
+	render::FontAsset const* const fontAsset = dynamic_cast<render::FontAsset const*>(&asset);
+	if (fontAsset != nullptr)
+	{
+		return CookFont(*fontAsset, sourceData, cookedData);
 	}
+
+	render::MeshAsset const* const meshAsset = dynamic_cast<render::MeshAsset const*>(&asset);
+	if (meshAsset != nullptr)
+	{
+		return CookMesh(asset.GetName(), meshAsset->m_LodRatios, sourceData, cookedData);
+	}
+
+	render::TextureAsset const* const textureAsset = dynamic_cast<render::TextureAsset const*>(&asset);
+	if (textureAsset != nullptr)
+	{
+		return CookTexture(*textureAsset, sourceData, cookedData);
+	}
+
+	return false;
 }
 
 //---------------------
@@ -160,7 +332,8 @@ void CookCompiledPackage(std::string const& dbBase,
 	std::string const& resName, 
 	core::AssetDatabase& db,
 	std::string const& engineDbBase,
-	core::AssetDatabase& engineDb)
+	core::AssetDatabase& engineDb,
+	CookCache const& cache)
 {
 	// Create a package writer - all file paths will be written relative to our database directory
 	PackageWriter packageWriter;
@@ -192,8 +365,8 @@ void CookCompiledPackage(std::string const& dbBase,
 
 	// add all other compiled files to the package
 	static core::HashString const s_CompiledPackageId;
-	AddPackageToWriter(s_CompiledPackageId, dbBase, packageWriter, db);
-	AddPackageToWriter(s_CompiledPackageId, engineDbBase, packageWriter, engineDb);
+	AddPackageToWriter(s_CompiledPackageId, dbBase, packageWriter, db, cache);
+	AddPackageToWriter(s_CompiledPackageId, engineDbBase, packageWriter, engineDb, cache);
 
 	// write our package
 	packageWriter.Write(packageData);
@@ -212,16 +385,17 @@ void CookCompiledPackage(std::string const& dbBase,
 }
 
 //---------------------
-// CookCompiledPackage
+// CookFilePackages
 //
-// Writes the package with compiled data that ends up as a generated source file.
-//  - this includes the file for the asset database
+// Writes a package file for every package in either database
+//  - packages are streamed to disk, so only one asset is in memory at a time while writing
 //
 void CookFilePackages(std::string const& dbBase, 
 	std::string const& outPath, 
 	core::AssetDatabase& db,
 	std::string const& engineDbBase,
-	core::AssetDatabase& engineDb)
+	core::AssetDatabase& engineDb,
+	CookCache const& cache)
 {
 	// Get a unified list of package descriptors
 	std::vector<core::AssetDatabase::PackageDescriptor> descriptors = db.packages;
@@ -241,13 +415,9 @@ void CookFilePackages(std::string const& dbBase,
 	for (core::AssetDatabase::PackageDescriptor const& desc : descriptors)
 	{
 		PackageWriter packageWriter;
-		std::vector<uint8> packageData;
 
-		AddPackageToWriter(desc.GetId(), dbBase, packageWriter, db);
-		AddPackageToWriter(desc.GetId(), engineDbBase, packageWriter, engineDb);
-
-		// write our package
-		packageWriter.Write(packageData);
+		AddPackageToWriter(desc.GetId(), dbBase, packageWriter, db, cache);
+		AddPackageToWriter(desc.GetId(), engineDbBase, packageWriter, engineDb, cache);
 
 		// Ensure the generated file directory exists
 		core::Directory* dir = new core::Directory(outPath + desc.GetPath(), nullptr, true);
@@ -259,11 +429,13 @@ void CookFilePackages(std::string const& dbBase,
 		if (!outFile->Open(core::FILE_ACCESS_MODE::Write, outFlags))
 		{
 			LOG("CookFilePackages > Failed to open file " + outFile->GetName(), core::LogLevel::Warning);
+			SafeDelete(outFile);
+			SafeDelete(dir);
 			continue;
 		}
 
-		// Write the package data
-		outFile->Write(packageData);
+		// write our package
+		packageWriter.Write(*outFile);
 
 		// cleanup
 		SafeDelete(outFile);
@@ -153,6 +153,8 @@ void I_Asset::SetReferenceIds(std::vector<HashString> val)
 //
 void I_Asset::Load()
 {
+	ET_PROFILE_ZONE("I_Asset::Load");
+
 	// Make sure all references are loaded
 	for (Reference& reference : m_References)
 	{
@@ -160,7 +162,13 @@ void I_Asset::Load()
 	}
 
 	// get binary data from the package
-	if (!(ResourceManager::Instance()->GetLoadData(this, m_LoadData)))
+	bool hasLoadData;
+	{
+		ET_PROFILE_ZONE("I_Asset::Load > read package data");
+		hasLoadData = ResourceManager::Instance()->GetLoadData(this, m_LoadData);
+	}
+
+	if (!hasLoadData)
 	{
 		ET_ASSERT(false, "Couldn't get data for '%s' (%i) in package '%s'", 
 			m_PackageEntryId.ToStringDbg(), 
@@ -170,7 +178,13 @@ void I_Asset::Load()
 	}
 
 	// let the asset load from binary data
-	if (!LoadFromMemory(m_LoadData))
+	bool loadSuccess;
+	{
+		ET_PROFILE_ZONE("I_Asset::Load > load from memory");
+		loadSuccess = LoadFromMemory(m_LoadData);
+	}
+
+	if (!loadSuccess)
 	{
 		LOG("I_Asset::Load > Failed loading asset from memory, name: '" + m_Name + std::string("'"), LogLevel::Warning);
 	}
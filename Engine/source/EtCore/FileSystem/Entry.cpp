@@ -194,6 +194,29 @@ std::vector<uint8> File::ReadChunk(uint64 const offset, uint64 const numBytes)
 	return content;
 }
 
+//---------------------------------
+// File::ReadChunk
+//
+// Read into memory owned by the caller, avoiding the allocation of a new container
+//  - the buffer must be able to hold at least numBytes
+//
+bool File::ReadChunk(uint64 const offset, uint64 const numBytes, uint8* const outBuffer)
+{
+	ET_ASSERT(m_IsOpen);
+	ET_ASSERT(offset + numBytes <= GetSize(),
+		"Range of bytes requested exceeds file size! Offset:'%u'; Bytes:'%u'; Total:'%u'; Size:'%u'", 
+		offset, numBytes, offset + numBytes, GetSize());
+
+	uint64 bytesRead = 0u;
+	if (!FILE_BASE::ReadFile(m_Handle, outBuffer, numBytes, offset, &bytesRead) || (bytesRead != numBytes))
+	{
+		LOG("File::ReadChunk > Reading file failed", Error);
+		return false;
+	}
+
+	return true;
+}
+
 //---------------------------------
 // File::Write
 //
@@ -66,6 +66,7 @@ public:
 
 	std::vector<uint8> Read();
 	std::vector<uint8> ReadChunk(uint64 const offset, uint64 const numBytes);
+	bool ReadChunk(uint64 const offset, uint64 const numBytes, uint8* const outBuffer);
 	bool Write(const std::vector<uint8> &lhs);
 	Entry::EntryType GetType()
     	{
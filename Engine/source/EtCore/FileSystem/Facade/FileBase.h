@@ -24,6 +24,7 @@ public:
 	static bool GetEntrySize(FILE_HANDLE handle, int64& size);
 
     static bool ReadFile( FILE_HANDLE handle, std::vector<uint8> & content, uint64 const numBytes, uint64 const offset = 0u );
+    static bool ReadFile( FILE_HANDLE handle, uint8* const buffer, uint64 const numBytes, uint64 const offset = 0u, uint64* const bytesRead = nullptr );
 
     static bool WriteFile( FILE_HANDLE handle, const std::vector<uint8> & content );
 
@@ -15,13 +15,46 @@ bool FILE_BASE::Close( FILE_HANDLE handle )
 	return result != -1;
 }
 
-bool FILE_BASE::ReadFile( FILE_HANDLE handle, std::vector<uint8> & content )
+bool FILE_BASE::ReadFile( FILE_HANDLE handle, std::vector<uint8> & content, uint64 const numBytes, uint64 const offset )
 {
-    char buffer[LINUX_FILE_BUFFER_SIZE];
-    int32 ret_in = 0;
-    while((ret_in = read (handle, &buffer, LINUX_FILE_BUFFER_SIZE)) > 0){}
-    content = buffer;
-    return true;;
+    content.resize( static_cast<size_t>(numBytes) );
+
+    uint64 bytesRead = 0u;
+    if ( !ReadFile( handle, content.data(), numBytes, offset, &bytesRead ) )
+    {
+        content.clear();
+        return false;
+    }
+
+    content.resize( static_cast<size_t>(bytesRead) );
+    return true;
+}
+
+bool FILE_BASE::ReadFile( FILE_HANDLE handle, uint8* const buffer, uint64 const numBytes, uint64 const offset, uint64* const bytesRead )
+{
+    uint64 total = 0u;
+    while ( total < numBytes )
+    {
+        ssize_t const result = pread( handle, buffer + total, static_cast<size_t>(numBytes - total), static_cast<off_t>(offset + total) );
+        if ( result < 0 )
+        {
+            return false;
+        }
+
+        if ( result == 0 ) // end of file
+        {
+            break;
+        }
+
+        total += static_cast<uint64>(result);
+    }
+
+    if ( bytesRead != nullptr )
+    {
+        *bytesRead = total;
+    }
+
+    return true;
 }
 
 bool FILE_BASE::WriteFile( FILE_HANDLE handle, const std::vector<uint8> & content )
@@ -86,29 +86,40 @@ bool FILE_BASE::GetEntrySize(FILE_HANDLE handle, int64& size)
 
 bool FILE_BASE::ReadFile( FILE_HANDLE handle, std::vector<uint8> & content, uint64 const numBytes, uint64 const offset)
 {
-	char* buffer_read = new char[static_cast<DWORD>(numBytes) + 1];
-	DWORD bytes_read = 0;
+	content.resize(static_cast<size_t>(numBytes));
+
+	uint64 bytesRead = 0u;
+	if (!ReadFile(handle, content.data(), numBytes, offset, &bytesRead))
+	{
+		content.clear();
+		return false;
+	}
+
+	content.resize(static_cast<size_t>(bytesRead));
+	return true;
+}
+
+bool FILE_BASE::ReadFile( FILE_HANDLE handle, uint8* const buffer, uint64 const numBytes, uint64 const offset, uint64* const bytesRead )
+{
+	// read straight into the callers memory so that no intermediate buffer is required
+	DWORD readCount = 0;
 
 	OVERLAPPED ov = {};
 	ov.Offset = static_cast<DWORD>(offset);
+	ov.OffsetHigh = static_cast<DWORD>(offset >> 32u);
 
-	if (FALSE == ::ReadFile(handle, buffer_read, static_cast<DWORD>(numBytes), &bytes_read, &ov))
+	if (FALSE == ::ReadFile(handle, buffer, static_cast<DWORD>(numBytes), &readCount, &ov))
 	{
 		DisplayError(TEXT("ReadFile"));
-		delete[] buffer_read;
 		return false;
 	}
 
-	if (bytes_read >= 0 && bytes_read <= static_cast<DWORD>(numBytes)) //move buffer to string
+	if (bytesRead != nullptr)
 	{
-		buffer_read[bytes_read] = '\0'; // NULL character
-		content = std::vector<uint8>(buffer_read, buffer_read + bytes_read);
-		delete[] buffer_read;
-		return true;
+		*bytesRead = static_cast<uint64>(readCount);
 	}
 
-	delete[] buffer_read;
-	return false;
+	return (readCount <= static_cast<DWORD>(numBytes));
 }
 
 bool FILE_BASE::WriteFile( FILE_HANDLE handle, const std::vector<uint8> & content)
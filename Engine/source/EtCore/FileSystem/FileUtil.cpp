@@ -2,6 +2,9 @@
 #include "FileUtil.h"
 
 #include <limits>
+#include <cstdio>
+
+#include "Entry.h"
 
 #ifdef PLATFORM_Win
 #	include <EtCore/Util/WindowsUtil.h>
@@ -85,6 +88,46 @@ bool FileUtil::GetCompiledResource(std::string const& path, std::vector<uint8>&
 	return false;
 }
 
+//---------------------------------
+// FileUtil::WriteFileAtomic
+//
+// Writes data to a temporary file next to the path first and then moves it in place, so that an interrupted write never leaves a partial file
+//  - an existing file at the path is replaced
+//
+bool FileUtil::WriteFileAtomic(std::string const& path, std::vector<uint8> const& data)
+{
+	std::string const tempPath = path + std::string(".tmp");
+
+	File* const tempFile = new File(tempPath, nullptr);
+
+	FILE_ACCESS_FLAGS outFlags;
+	outFlags.SetFlags(FILE_ACCESS_FLAGS::FLAGS::Create | FILE_ACCESS_FLAGS::FLAGS::Exists);
+	if (!tempFile->Open(FILE_ACCESS_MODE::Write, outFlags))
+	{
+		LOG("FileUtil::WriteFileAtomic > Failed to open file '" + tempPath + std::string("'"), LogLevel::Warning);
+		delete tempFile;
+		return false;
+	}
+
+	bool const written = tempFile->Write(data);
+	tempFile->Close();
+	delete tempFile;
+
+	if (written)
+	{
+		std::remove(path.c_str()); // rename doesn't replace existing files on windows
+	}
+
+	if (!written || (std::rename(tempPath.c_str(), path.c_str()) != 0))
+	{
+		LOG("FileUtil::WriteFileAtomic > Failed to write file '" + path + std::string("'"), LogLevel::Warning);
+		std::remove(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
 //---------------------------------
 // FileUtil::ParseLine
 //
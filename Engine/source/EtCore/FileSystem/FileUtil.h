@@ -21,6 +21,7 @@ public:
 	static std::vector<std::string> ParseLines(std::string raw);
 
 	static bool GetCompiledResource(std::string const& path, std::vector<uint8>& data);
+	static bool WriteFileAtomic(std::string const& path, std::vector<uint8> const& data);
 
 	static std::string ExtractPath(std::string const& fileName);
 	static std::string ExtractName(std::string const& fileName);
@@ -4,6 +4,7 @@
 
 #include <EtCore/FileSystem/FileUtil.h>
 #include <EtCore/FileSystem/Entry.h>
+#include <EtCore/Memory/StlAllocators.h>
 
 
 namespace et {
@@ -80,6 +81,7 @@ FilePackage::PackageEntry const* FilePackage::GetEntry(HashString const id) cons
 // FilePackage::GetEntryData
 //
 // This will do a file read from disk
+//  - data is read directly into outData, so reusing the same container for multiple reads avoids reallocating
 //
 bool FilePackage::GetEntryData(HashString const id, std::vector<uint8>& outData)
 {
@@ -90,8 +92,8 @@ bool FilePackage::GetEntryData(HashString const id, std::vector<uint8>& outData)
 		return false;
 	}
 
-	outData = std::move(m_File->ReadChunk(pkgEntry->offset, pkgEntry->size));
-	return true;
+	outData.resize(static_cast<size_t>(pkgEntry->size));
+	return m_File->ReadChunk(pkgEntry->offset, pkgEntry->size, outData.data());
 }
 
 //---------------------------------
@@ -107,39 +109,32 @@ void FilePackage::LoadFileList()
 	//-------------------------
 	uint64 offset = 0u;
 	uint64 nextChunkSize = static_cast<uint64>(sizeof(PkgHeader));
-	std::vector<uint8> readBinData(std::move(m_File->ReadChunk(offset, nextChunkSize)));
+	PkgHeader pkgHeader;
+	m_File->ReadChunk(offset, nextChunkSize, reinterpret_cast<uint8*>(&pkgHeader));
 	offset += nextChunkSize;
-	PkgHeader const pkgHeader(*reinterpret_cast<PkgHeader const*>(readBinData.data()));
 
 	// read the central directory
 	//----------------------------
 
-	// read the entire data chunk for the central directory from the file
-	nextChunkSize = static_cast<uint64>(sizeof(PkgFileInfo)) * pkgHeader.numEntries;
-	readBinData = std::move(m_File->ReadChunk(offset, nextChunkSize));
-
-	// map into that read data
-	offset = 0u;
-	std::vector<PkgFileInfo> centralDirectory;
-	for (size_t infoIdx = 0u; infoIdx < pkgHeader.numEntries; ++infoIdx)
-	{
-		PkgFileInfo const* info = reinterpret_cast<PkgFileInfo const*>(readBinData.data() + static_cast<size_t>(offset));
-		offset += static_cast<uint64>(sizeof(PkgFileInfo));
+	// read the entire data chunk for the central directory from the file straight into temporary memory
+	ScratchScope const scratchScope;
+	ScratchVector<PkgFileInfo> centralDirectory(static_cast<size_t>(pkgHeader.numEntries));
 
-		centralDirectory.emplace_back(*info);
-	}
+	nextChunkSize = static_cast<uint64>(sizeof(PkgFileInfo)) * pkgHeader.numEntries;
+	m_File->ReadChunk(offset, nextChunkSize, reinterpret_cast<uint8*>(centralDirectory.data()));
 
 	// read the files listed
 	//----------------------------
+	PkgEntry entryData;
 	for (PkgFileInfo const& fileInfo : centralDirectory)
 	{
 		// start at the offset from the beginning of the package
 		offset = fileInfo.offset;
 		nextChunkSize = static_cast<uint64>(sizeof(PkgEntry));
-		readBinData = std::move(m_File->ReadChunk(offset, nextChunkSize));
+		m_File->ReadChunk(offset, nextChunkSize, reinterpret_cast<uint8*>(&entryData));
 		offset += nextChunkSize;
 
-		PkgEntry const* entry = reinterpret_cast<PkgEntry const*>(readBinData.data());
+		PkgEntry const* entry = &entryData;
 
 		// get and validate the fileId
 
@@ -164,7 +159,11 @@ void FilePackage::LoadFileList()
 
 		// read the file name and split 
 		nextChunkSize = static_cast<uint64>(entry->nameLength);
-		std::string fullName = FileUtil::AsText(m_File->ReadChunk(offset, nextChunkSize));
+		std::string fullName(static_cast<size_t>(nextChunkSize), '\0');
+		if (nextChunkSize > 0u)
+		{
+			m_File->ReadChunk(offset, nextChunkSize, reinterpret_cast<uint8*>(&fullName[0]));
+		}
 
 		pkgEntry.fileName = FileUtil::ExtractName(fullName);
 		pkgEntry.path = FileUtil::ExtractPath(fullName);
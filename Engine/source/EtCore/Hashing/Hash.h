@@ -14,6 +14,7 @@ typedef uint32 T_Hash;
 
 constexpr T_Hash GetHash(std::string const& str);
 constexpr T_Hash GetDataHash(uint8 const* const data, size_t const count);
+inline uint64 GetDataHash64(uint8 const* const data, size_t const count, uint64 const seed = 0u);
 
 inline constexpr T_Hash operator"" _hash(char const* const s, size_t const count);
 
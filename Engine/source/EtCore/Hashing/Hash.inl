@@ -56,6 +56,24 @@ constexpr T_Hash GetDataHash(uint8 const* const data, size_t const count)
 	return detail::hash_gen(reinterpret_cast<char const*>(data), count);
 }
 
+//-------------------------------
+// GetDataHash64
+//
+// 64 bit FNV-1a of a byte array, iterative so that it can be used on large data unlike GetDataHash
+//  - the seed is mixed into the offset basis, which allows chaining the hashes of several arrays
+//
+inline uint64 GetDataHash64(uint8 const* const data, size_t const count, uint64 const seed)
+{
+	uint64 hash = 14695981039346656037ull ^ seed;
+	for (size_t byteIdx = 0u; byteIdx < count; ++byteIdx)
+	{
+		hash ^= static_cast<uint64>(data[byteIdx]);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
 //-------------------------------
 // operator"" _hash
 //
@@ -0,0 +1,74 @@
+#include "stdafx.h"
+#include "AllocationCounter.h"
+
+
+namespace et {
+namespace core {
+
+
+//====================
+// Allocation Counter
+//====================
+
+
+// static
+std::atomic<bool> AllocationCounter::s_IsEnabled(false);
+std::atomic<size_t> AllocationCounter::s_AllocationCount(0u);
+std::atomic<size_t> AllocationCounter::s_FreeCount(0u);
+std::atomic<size_t> AllocationCounter::s_AllocatedBytes(0u);
+
+
+//---------------------------------
+// AllocationCounter::Enable
+//
+void AllocationCounter::Enable()
+{
+	s_IsEnabled.store(true, std::memory_order_relaxed);
+}
+
+//---------------------------------
+// AllocationCounter::Disable
+//
+void AllocationCounter::Disable()
+{
+	s_IsEnabled.store(false, std::memory_order_relaxed);
+}
+
+//---------------------------------
+// AllocationCounter::Reset
+//
+void AllocationCounter::Reset()
+{
+	s_AllocationCount.store(0u, std::memory_order_relaxed);
+	s_FreeCount.store(0u, std::memory_order_relaxed);
+	s_AllocatedBytes.store(0u, std::memory_order_relaxed);
+}
+
+//---------------------------------
+// AllocationCounter::OnAllocate
+//
+// Called by the allocation hook - must not allocate itself
+//
+void AllocationCounter::OnAllocate(size_t const size)
+{
+	if (IsEnabled())
+	{
+		s_AllocationCount.fetch_add(1u, std::memory_order_relaxed);
+		s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+}
+
+//---------------------------------
+// AllocationCounter::OnFree
+//
+void AllocationCounter::OnFree()
+{
+	if (IsEnabled())
+	{
+		s_FreeCount.fetch_add(1u, std::memory_order_relaxed);
+	}
+}
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// AllocationCounter
+//
+// Hook for counting heap allocations, intended to verify that steady state code paths don't touch the heap
+//  - the engine doesn't replace the global allocation functions itself; a test executable does so and reports to this counter
+//  - counting is only done while enabled, and tracks all threads
+//
+class AllocationCounter final
+{
+public:
+	// static functionality
+	//----------------------
+	static void Enable();
+	static void Disable();
+	static bool IsEnabled() { return s_IsEnabled.load(std::memory_order_relaxed); }
+
+	static void Reset();
+
+	static void OnAllocate(size_t const size);
+	static void OnFree();
+
+	// accessors
+	//-----------
+	static size_t GetAllocationCount() { return s_AllocationCount.load(std::memory_order_relaxed); }
+	static size_t GetFreeCount() { return s_FreeCount.load(std::memory_order_relaxed); }
+	static size_t GetAllocatedBytes() { return s_AllocatedBytes.load(std::memory_order_relaxed); }
+
+	// Data
+	///////
+
+private:
+	static std::atomic<bool> s_IsEnabled;
+
+	static std::atomic<size_t> s_AllocationCount;
+	static std::atomic<size_t> s_FreeCount;
+	static std::atomic<size_t> s_AllocatedBytes;
+};
+
+
+//---------------------------------
+// ScopedAllocationCounter
+//
+// Resets and enables the allocation counter for the lifetime of the object
+//
+class ScopedAllocationCounter final
+{
+public:
+	ScopedAllocationCounter() { AllocationCounter::Reset(); AllocationCounter::Enable(); }
+	~ScopedAllocationCounter() { AllocationCounter::Disable(); }
+
+	ScopedAllocationCounter(ScopedAllocationCounter const&) = delete;
+	ScopedAllocationCounter& operator=(ScopedAllocationCounter const&) = delete;
+
+	size_t GetAllocationCount() const { return AllocationCounter::GetAllocationCount(); }
+};
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,47 @@
+#include "stdafx.h"
+#include "FrameAllocator.h"
+
+
+namespace et {
+namespace core {
+
+
+//=================
+// Frame Allocator
+//=================
+
+
+//---------------------------------
+// FrameAllocator::c-tor
+//
+FrameAllocator::FrameAllocator()
+	: m_ArenaA(s_DefaultCapacity)
+	, m_ArenaB(s_DefaultCapacity)
+	, m_Current(&m_ArenaA)
+	, m_Previous(&m_ArenaB)
+{ }
+
+//---------------------------------
+// FrameAllocator::Allocate
+//
+void* FrameAllocator::Allocate(size_t const size, size_t const alignment)
+{
+	return m_Current->Allocate(size, alignment);
+}
+
+//---------------------------------
+// FrameAllocator::SwapFrames
+//
+// The arena used during the last frame stays intact, while the one from two frames ago is reset and reused
+//
+void FrameAllocator::SwapFrames()
+{
+	std::swap(m_Current, m_Previous);
+	m_Current->Reset();
+
+	++m_FrameIndex;
+}
+
+
+} // namespace core
+} // namespace et
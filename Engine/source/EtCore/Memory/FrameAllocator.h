@@ -0,0 +1,66 @@
+#pragma once
+#include "LinearArena.h"
+
+#include <EtCore/Util/Singleton.h>
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// FrameAllocator
+//
+// Double buffered linear arenas for transient data that lives no longer than the frame after the one it was allocated in
+//  - the tick manager swaps the buffers at the start of every frame, resetting the arena that was used two frames ago
+//  - memory is never freed individually and destructors are not called
+//  - should only be used from the main thread, use the scratch arena for worker threads
+//
+class FrameAllocator final : public Singleton<FrameAllocator>
+{
+	// definitions
+	//-------------
+	friend class Singleton<FrameAllocator>;
+
+public:
+	static constexpr size_t s_DefaultCapacity = 4u * 1024u * 1024u;
+
+	// construct destruct
+	//--------------------
+private:
+	FrameAllocator();
+	virtual ~FrameAllocator() = default;
+
+	// functionality
+	//---------------
+public:
+	void* Allocate(size_t const size, size_t const alignment = LinearArena::s_DefaultAlignment);
+
+	template<typename TDataType>
+	TDataType* AllocateArray(size_t const count) { return m_Current->AllocateArray<TDataType>(count); }
+
+	template<typename TDataType, typename... Args>
+	TDataType* New(Args&&... args) { return m_Current->New<TDataType>(std::forward<Args>(args)...); }
+
+	void SwapFrames(); // called by the tick manager at the start of a frame
+
+	// accessors
+	//-----------
+	LinearArena& GetCurrentArena() { return *m_Current; }
+	uint64 GetFrameIndex() const { return m_FrameIndex; }
+
+	// Data
+	///////
+private:
+	LinearArena m_ArenaA;
+	LinearArena m_ArenaB;
+
+	LinearArena* m_Current = nullptr;
+	LinearArena* m_Previous = nullptr;
+
+	uint64 m_FrameIndex = 0u;
+};
+
+
+} // namespace core
+} // namespace et
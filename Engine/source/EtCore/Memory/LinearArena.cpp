@@ -0,0 +1,222 @@
+#include "stdafx.h"
+#include "LinearArena.h"
+
+
+namespace et {
+namespace core {
+
+
+//==============
+// Linear Arena
+//==============
+
+
+namespace detail {
+
+	//---------------------------------
+	// GetAlignmentPadding
+	//
+	// Offset to add to an address in order to reach the requested alignment - alignment must be a power of two
+	//
+	inline size_t GetAlignmentPadding(uintptr_t const address, size_t const alignment)
+	{
+		ET_ASSERT((alignment & (alignment - 1u)) == 0u, "Alignment must be a power of two!");
+		return static_cast<size_t>((alignment - (address & (alignment - 1u))) & (alignment - 1u));
+	}
+
+} // namespace detail
+
+
+// construct destruct
+//////////////////////
+
+//---------------------------------
+// LinearArena::c-tor
+//
+LinearArena::LinearArena(size_t const capacity)
+	: m_Capacity(capacity)
+{
+	if (m_Capacity > 0u)
+	{
+		m_Buffer = static_cast<uint8*>(::operator new(m_Capacity));
+	}
+}
+
+//---------------------------------
+// LinearArena::d-tor
+//
+LinearArena::~LinearArena()
+{
+	ReleaseOverflow(0u);
+	::operator delete(m_Buffer);
+}
+
+
+// functionality
+/////////////////
+
+//---------------------------------
+// LinearArena::Allocate
+//
+// Bump the offset, if the buffer is exhausted we spill over into a heap block
+//
+void* LinearArena::Allocate(size_t const size, size_t const alignment)
+{
+	uintptr_t const current = reinterpret_cast<uintptr_t>(m_Buffer + m_Offset);
+	size_t const padding = detail::GetAlignmentPadding(current, alignment);
+
+	if (m_Offset + padding + size > m_Capacity)
+	{
+		return AllocateOverflow(size, alignment);
+	}
+
+	void* const ret = m_Buffer + m_Offset + padding;
+	m_Offset += padding + size;
+
+	m_HighWaterMark = std::max(m_HighWaterMark, GetUsed());
+
+	return ret;
+}
+
+//---------------------------------
+// LinearArena::Free
+//
+// Give memory back if it was the last allocation - padding that was added for its alignment remains in use
+//
+void LinearArena::Free(void* const ptr, size_t const size)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	if (Owns(ptr))
+	{
+		uint8* const bytePtr = static_cast<uint8*>(ptr);
+		if (bytePtr + size == m_Buffer + m_Offset)
+		{
+			m_Offset = static_cast<size_t>(bytePtr - m_Buffer);
+		}
+
+		return;
+	}
+
+	// the latest overflow block can be returned to the heap straight away
+	if (!m_Overflow.empty() && (size <= m_Overflow.back().size))
+	{
+		uintptr_t const blockStart = reinterpret_cast<uintptr_t>(m_Overflow.back().block);
+		uintptr_t const address = reinterpret_cast<uintptr_t>(ptr);
+		if ((address >= blockStart) && (address < blockStart + m_Overflow.back().size))
+		{
+			ReleaseOverflow(m_Overflow.size() - 1u);
+		}
+	}
+}
+
+//---------------------------------
+// LinearArena::GetMarker
+//
+LinearArena::Marker LinearArena::GetMarker() const
+{
+	Marker ret;
+	ret.offset = m_Offset;
+	ret.overflowCount = m_Overflow.size();
+	return ret;
+}
+
+//---------------------------------
+// LinearArena::Rewind
+//
+// Release all allocations made since the marker was retrieved - rewinding to the start of the arena acts as a full reset
+//
+void LinearArena::Rewind(Marker const& marker)
+{
+	ET_ASSERT(marker.offset <= m_Offset, "Rewinding to a marker that lies ahead of the arena!");
+
+	if ((marker.offset == 0u) && (marker.overflowCount == 0u))
+	{
+		Reset();
+		return;
+	}
+
+	m_Offset = marker.offset;
+	ReleaseOverflow(marker.overflowCount);
+}
+
+//---------------------------------
+// LinearArena::Reset
+//
+// Release all allocations - if we needed to overflow since the last reset, grow the buffer so that the high water mark fits
+//
+void LinearArena::Reset()
+{
+	bool const overflowed = !m_Overflow.empty();
+	ReleaseOverflow(0u);
+
+	m_Offset = 0u;
+
+	if (overflowed && (m_HighWaterMark > m_Capacity))
+	{
+		::operator delete(m_Buffer);
+
+		m_Capacity = m_HighWaterMark + (m_HighWaterMark / 2u);
+		m_Buffer = static_cast<uint8*>(::operator new(m_Capacity));
+	}
+
+	m_HighWaterMark = 0u;
+}
+
+//---------------------------------
+// LinearArena::Owns
+//
+// Whether the pointer lies within the main block of the arena
+//
+bool LinearArena::Owns(void const* const ptr) const
+{
+	uint8 const* const bytePtr = static_cast<uint8 const*>(ptr);
+	return (bytePtr >= m_Buffer) && (bytePtr < m_Buffer + m_Capacity);
+}
+
+
+// utility
+///////////
+
+//---------------------------------
+// LinearArena::AllocateOverflow
+//
+// Separate heap block for allocations that don't fit in the arena
+//
+void* LinearArena::AllocateOverflow(size_t const size, size_t const alignment)
+{
+	size_t const blockSize = size + alignment;
+
+	OverflowBlock block;
+	block.block = ::operator new(blockSize);
+	block.size = blockSize;
+	m_Overflow.push_back(block);
+
+	m_OverflowSize += blockSize;
+	m_HighWaterMark = std::max(m_HighWaterMark, GetUsed());
+
+	uintptr_t const address = reinterpret_cast<uintptr_t>(block.block);
+	return static_cast<uint8*>(block.block) + detail::GetAlignmentPadding(address, alignment);
+}
+
+//---------------------------------
+// LinearArena::ReleaseOverflow
+//
+// Free overflow blocks until only keepCount blocks remain
+//
+void LinearArena::ReleaseOverflow(size_t const keepCount)
+{
+	while (m_Overflow.size() > keepCount)
+	{
+		m_OverflowSize -= m_Overflow.back().size;
+		::operator delete(m_Overflow.back().block);
+		m_Overflow.pop_back();
+	}
+}
+
+
+} // namespace core
+} // namespace et
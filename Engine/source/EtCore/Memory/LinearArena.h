@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// LinearArena
+//
+// Bump pointer allocator over a single contiguous block of memory
+//
+// Allocations are served by advancing an offset, and are released all at once by resetting or rewinding to a previously retrieved marker
+//  - freeing the most recent allocation is supported, which makes growing containers in an arena cheap
+//
+// Benefits:
+//	* O(1) allocation without locking or searching a free list
+//  * consecutive allocations are contiguous in memory
+//  * no per allocation bookkeeping
+//
+// Tradeoffs:
+//  * individual allocations can't be freed (unless they are the most recent one)
+//  * destructors are not called - only trivially destructible data or objects that are destroyed manually should live in the arena
+//  * not thread safe - use one arena per thread
+//
+// If the capacity is exceeded, allocations spill over into separate heap blocks which are kept until the arena is rewound.
+//  - upon the next full reset the arena grows to fit the high water mark, so that in a steady state no heap allocations happen
+//
+class LinearArena final
+{
+	// definitions
+	//-------------
+public:
+	static constexpr size_t s_DefaultAlignment = alignof(std::max_align_t);
+
+	//---------------------------------
+	// LinearArena::Marker
+	//
+	// Position in the arena that can be rewound to
+	//
+	struct Marker final
+	{
+		size_t offset = 0u;
+		size_t overflowCount = 0u;
+	};
+
+private:
+	struct OverflowBlock final
+	{
+		void* block = nullptr;
+		size_t size = 0u;
+	};
+
+	// construct destruct
+	//--------------------
+public:
+	LinearArena(size_t const capacity);
+	~LinearArena();
+
+	LinearArena(LinearArena const&) = delete;
+	LinearArena& operator=(LinearArena const&) = delete;
+
+	// functionality
+	//---------------
+	void* Allocate(size_t const size, size_t const alignment = s_DefaultAlignment);
+	void Free(void* const ptr, size_t const size); // only has an effect if ptr was the latest allocation
+
+	template<typename TDataType>
+	TDataType* AllocateArray(size_t const count);
+
+	template<typename TDataType, typename... Args>
+	TDataType* New(Args&&... args);
+
+	Marker GetMarker() const;
+	void Rewind(Marker const& marker);
+	void Reset();
+
+	// accessors
+	//-----------
+	size_t GetCapacity() const { return m_Capacity; }
+	size_t GetUsed() const { return m_Offset + m_OverflowSize; }
+	size_t GetHighWaterMark() const { return m_HighWaterMark; }
+	size_t GetOverflowCount() const { return m_Overflow.size(); }
+
+	bool Owns(void const* const ptr) const;
+
+	// utility
+	//---------
+private:
+	void* AllocateOverflow(size_t const size, size_t const alignment);
+	void ReleaseOverflow(size_t const keepCount);
+
+	// Data
+	///////
+
+	uint8* m_Buffer = nullptr;
+	size_t m_Capacity = 0u;
+	size_t m_Offset = 0u;
+
+	std::vector<OverflowBlock> m_Overflow;
+	size_t m_OverflowSize = 0u;
+
+	size_t m_HighWaterMark = 0u;
+};
+
+
+} // namespace core
+} // namespace et
+
+
+#include "LinearArena.inl"
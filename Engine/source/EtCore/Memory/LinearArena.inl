@@ -0,0 +1,37 @@
+#pragma once
+
+
+namespace et {
+namespace core {
+
+
+//==============
+// Linear Arena
+//==============
+
+
+//---------------------------------
+// LinearArena::AllocateArray
+//
+// Uninitialized storage for count elements of the data type
+//
+template<typename TDataType>
+TDataType* LinearArena::AllocateArray(size_t const count)
+{
+	return static_cast<TDataType*>(Allocate(sizeof(TDataType) * count, alignof(TDataType)));
+}
+
+//---------------------------------
+// LinearArena::New
+//
+// Construct an object in the arena - the destructor will not be called when the arena is reset
+//
+template<typename TDataType, typename... Args>
+TDataType* LinearArena::New(Args&&... args)
+{
+	return new(Allocate(sizeof(TDataType), alignof(TDataType))) TDataType(std::forward<Args>(args)...);
+}
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,34 @@
+#pragma once
+#include "PoolAllocator.h"
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// PoolAllocated
+//
+// Base class that routes heap allocations of the derived type through a per thread pool sized for that type
+//  - derived types that are larger than the pooled type fall back to the global heap, so the type can safely be extended
+//  - objects must be deleted on the thread they were created on
+//
+// Intended for small, short lived objects that are created with new at a high frequency, such as event data
+//
+template <typename TPooledType>
+class PoolAllocated
+{
+public:
+	static void* operator new(size_t const size);
+	static void operator delete(void* const ptr, size_t const size);
+
+private:
+	static PoolAllocator& GetPool();
+};
+
+
+} // namespace core
+} // namespace et
+
+
+#include "PoolAllocated.inl"
@@ -0,0 +1,56 @@
+#pragma once
+
+
+namespace et {
+namespace core {
+
+
+//=================
+// Pool Allocated
+//=================
+
+
+//---------------------------------
+// PoolAllocated::new
+//
+template <typename TPooledType>
+void* PoolAllocated<TPooledType>::operator new(size_t const size)
+{
+	if (size > sizeof(TPooledType))
+	{
+		return ::operator new(size);
+	}
+
+	return GetPool().Allocate();
+}
+
+//---------------------------------
+// PoolAllocated::delete
+//
+// Types with a virtual destructor receive the size of the most derived type, so we know where the memory came from
+//
+template <typename TPooledType>
+void PoolAllocated<TPooledType>::operator delete(void* const ptr, size_t const size)
+{
+	if (size > sizeof(TPooledType))
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	GetPool().Free(ptr);
+}
+
+//---------------------------------
+// PoolAllocated::GetPool
+//
+template <typename TPooledType>
+PoolAllocator& PoolAllocated<TPooledType>::GetPool()
+{
+	static thread_local PoolAllocator s_Pool(sizeof(TPooledType), PoolAllocator::s_DefaultBlocksPerChunk, alignof(TPooledType));
+	return s_Pool;
+}
+
+
+} // namespace core
+} // namespace et
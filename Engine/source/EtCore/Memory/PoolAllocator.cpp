@@ -0,0 +1,146 @@
+#include "stdafx.h"
+#include "PoolAllocator.h"
+
+
+namespace et {
+namespace core {
+
+
+//================
+// Pool Allocator
+//================
+
+
+// construct destruct
+//////////////////////
+
+//---------------------------------
+// PoolAllocator::c-tor
+//
+// Blocks are padded so that every block satisfies the alignment and can hold a free list node
+//
+PoolAllocator::PoolAllocator(size_t const blockSize, size_t const blocksPerChunk, size_t const alignment)
+	: m_BlockSize(((std::max(blockSize, sizeof(FreeBlock)) + alignment - 1u) / alignment) * alignment)
+	, m_BlocksPerChunk(blocksPerChunk)
+	, m_Alignment(alignment)
+{
+	ET_ASSERT(m_BlocksPerChunk > 0u);
+	ET_ASSERT(m_Alignment <= alignof(std::max_align_t), "Pools don't support over aligned blocks");
+}
+
+//---------------------------------
+// PoolAllocator::d-tor
+//
+// Blocks that are still in use become invalid - pools with static lifetime may legitimately still be referenced during shutdown
+//
+PoolAllocator::~PoolAllocator()
+{
+	for (uint8* const chunk : m_Chunks)
+	{
+		::operator delete(chunk);
+	}
+}
+
+
+// functionality
+/////////////////
+
+//---------------------------------
+// PoolAllocator::Allocate
+//
+// Pop a block from the free list
+//
+void* PoolAllocator::Allocate()
+{
+	if (m_FreeList == nullptr)
+	{
+		AddChunk();
+	}
+
+	FreeBlock* const block = m_FreeList;
+	m_FreeList = block->next;
+
+	++m_LiveCount;
+	return block;
+}
+
+//---------------------------------
+// PoolAllocator::Free
+//
+// Push the block back onto the free list
+//
+void PoolAllocator::Free(void* const ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	ET_ASSERT(Owns(ptr), "Freeing a block that wasn't allocated by this pool!");
+	ET_ASSERT(m_LiveCount > 0u);
+
+	FreeBlock* const block = static_cast<FreeBlock*>(ptr);
+	block->next = m_FreeList;
+	m_FreeList = block;
+
+	--m_LiveCount;
+}
+
+//---------------------------------
+// PoolAllocator::Reserve
+//
+// Ensure enough chunks exist to serve blockCount simultaneous allocations
+//
+void PoolAllocator::Reserve(size_t const blockCount)
+{
+	while (GetCapacity() < blockCount)
+	{
+		AddChunk();
+	}
+}
+
+//---------------------------------
+// PoolAllocator::Owns
+//
+bool PoolAllocator::Owns(void const* const ptr) const
+{
+	uint8 const* const bytePtr = static_cast<uint8 const*>(ptr);
+	size_t const chunkSize = m_BlockSize * m_BlocksPerChunk;
+
+	for (uint8 const* const chunk : m_Chunks)
+	{
+		if ((bytePtr >= chunk) && (bytePtr < chunk + chunkSize))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// utility
+///////////
+
+//---------------------------------
+// PoolAllocator::AddChunk
+//
+// Allocate a new chunk and thread all of its blocks into the free list
+//
+void PoolAllocator::AddChunk()
+{
+	uint8* const chunk = static_cast<uint8*>(::operator new(m_BlockSize * m_BlocksPerChunk));
+	m_Chunks.push_back(chunk);
+
+	// link in reverse so that blocks are handed out in address order
+	for (size_t blockIdx = m_BlocksPerChunk; blockIdx > 0u; --blockIdx)
+	{
+		FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk + (blockIdx - 1u) * m_BlockSize);
+		block->next = m_FreeList;
+		m_FreeList = block;
+	}
+}
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// PoolAllocator
+//
+// Allocates blocks of a fixed size from chunks of memory, recycling freed blocks through an intrusive free list
+//
+// Benefits:
+//	* O(1) allocation and deallocation
+//  * heap allocations only happen when all blocks are in use and a new chunk is required
+//  * blocks are reused in LIFO order which keeps recently used memory warm
+//
+// Tradeoffs:
+//  * only serves allocations up to the block size
+//  * chunks are not returned to the heap until the pool is destroyed
+//  * not thread safe
+//
+class PoolAllocator final
+{
+	// definitions
+	//-------------
+	struct FreeBlock
+	{
+		FreeBlock* next = nullptr;
+	};
+
+public:
+	static constexpr size_t s_DefaultBlocksPerChunk = 64u;
+
+	// construct destruct
+	//--------------------
+	PoolAllocator(size_t const blockSize, size_t const blocksPerChunk = s_DefaultBlocksPerChunk, size_t const alignment = alignof(std::max_align_t));
+	~PoolAllocator();
+
+	PoolAllocator(PoolAllocator const&) = delete;
+	PoolAllocator& operator=(PoolAllocator const&) = delete;
+
+	// functionality
+	//---------------
+	void* Allocate();
+	void Free(void* const ptr);
+
+	void Reserve(size_t const blockCount);
+
+	// accessors
+	//-----------
+	size_t GetBlockSize() const { return m_BlockSize; }
+	size_t GetLiveCount() const { return m_LiveCount; }
+	size_t GetCapacity() const { return m_Chunks.size() * m_BlocksPerChunk; }
+
+	bool Owns(void const* const ptr) const;
+
+	// utility
+	//---------
+private:
+	void AddChunk();
+
+	// Data
+	///////
+
+	size_t const m_BlockSize;
+	size_t const m_BlocksPerChunk;
+	size_t const m_Alignment;
+
+	std::vector<uint8*> m_Chunks;
+	FreeBlock* m_FreeList = nullptr;
+	size_t m_LiveCount = 0u;
+};
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,65 @@
+#include "stdafx.h"
+#include "ScratchArena.h"
+
+
+namespace et {
+namespace core {
+
+
+namespace {
+
+	// number of scratch scopes currently open on this thread
+	thread_local uint32 s_ScratchScopeDepth = 0u;
+
+}
+
+
+//---------------------------------
+// GetScratchArena
+//
+// Each thread gets its own arena so that no synchronization is required
+//
+LinearArena& GetScratchArena()
+{
+	static thread_local LinearArena s_ScratchArena(s_ScratchArenaCapacity);
+	return s_ScratchArena;
+}
+
+//---------------------------------
+// IsScratchScopeActive
+//
+bool IsScratchScopeActive()
+{
+	return (s_ScratchScopeDepth > 0u);
+}
+
+
+//===============
+// Scratch Scope
+//===============
+
+
+//---------------------------------
+// ScratchScope::c-tor
+//
+ScratchScope::ScratchScope()
+	: m_Arena(GetScratchArena())
+	, m_Marker(m_Arena.GetMarker())
+{ 
+	++s_ScratchScopeDepth;
+}
+
+//---------------------------------
+// ScratchScope::d-tor
+//
+ScratchScope::~ScratchScope()
+{
+	ET_ASSERT(s_ScratchScopeDepth > 0u);
+	--s_ScratchScopeDepth;
+
+	m_Arena.Rewind(m_Marker);
+}
+
+
+} // namespace core
+} // namespace et
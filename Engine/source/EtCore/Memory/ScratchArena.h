@@ -0,0 +1,44 @@
+#pragma once
+#include "LinearArena.h"
+
+
+namespace et {
+namespace core {
+
+
+static constexpr size_t s_ScratchArenaCapacity = 1024u * 1024u;
+
+
+// per thread arena for short lived temporary allocations, lazily created on first use
+LinearArena& GetScratchArena();
+
+// whether the calling thread currently has a ScratchScope open, code that allocates in the scratch arena without owning a scope should check this
+bool IsScratchScopeActive();
+
+
+//---------------------------------
+// ScratchScope
+//
+// Marks the current position of the threads scratch arena and rewinds to it upon destruction
+//  - everything allocated in the scratch arena while the scope is alive becomes invalid when it ends
+//  - scopes can be nested, but have to be destroyed in reverse order of creation
+//
+class ScratchScope final
+{
+public:
+	ScratchScope();
+	~ScratchScope();
+
+	ScratchScope(ScratchScope const&) = delete;
+	ScratchScope& operator=(ScratchScope const&) = delete;
+
+	LinearArena& GetArena() { return m_Arena; }
+
+private:
+	LinearArena& m_Arena;
+	LinearArena::Marker const m_Marker;
+};
+
+
+} // namespace core
+} // namespace et
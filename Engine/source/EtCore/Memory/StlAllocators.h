@@ -0,0 +1,169 @@
+#pragma once
+#include "LinearArena.h"
+#include "ScratchArena.h"
+#include "FrameAllocator.h"
+#include "PoolAllocator.h"
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// LinearStlAllocator
+//
+// STL compatible allocator that takes memory from a linear arena
+//  - deallocation only gives memory back if it was the most recent allocation in the arena, so containers growing in a loop stay compact
+//  - the arena source provides the arena used by default constructed allocators
+//
+template <typename TDataType, typename TArenaSource>
+class LinearStlAllocator
+{
+	// definitions
+	//-------------
+public:
+	using value_type = TDataType;
+
+	template <typename TOther>
+	struct rebind
+	{
+		using other = LinearStlAllocator<TOther, TArenaSource>;
+	};
+
+	// construct
+	//-----------
+	LinearStlAllocator() : m_Arena(&TArenaSource::Get()) {}
+	explicit LinearStlAllocator(LinearArena& arena) : m_Arena(&arena) {}
+
+	template <typename TOther>
+	LinearStlAllocator(LinearStlAllocator<TOther, TArenaSource> const& other) : m_Arena(other.GetArena()) {}
+
+	// allocator interface
+	//---------------------
+	TDataType* allocate(size_t const count) { return m_Arena->AllocateArray<TDataType>(count); }
+	void deallocate(TDataType* const ptr, size_t const count) { m_Arena->Free(ptr, count * sizeof(TDataType)); }
+
+	// accessors
+	//-----------
+	LinearArena* GetArena() const { return m_Arena; }
+
+	// Data
+	///////
+
+private:
+	LinearArena* m_Arena = nullptr;
+};
+
+template <typename TLhs, typename TRhs, typename TArenaSource>
+bool operator==(LinearStlAllocator<TLhs, TArenaSource> const& lhs, LinearStlAllocator<TRhs, TArenaSource> const& rhs)
+{
+	return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename TLhs, typename TRhs, typename TArenaSource>
+bool operator!=(LinearStlAllocator<TLhs, TArenaSource> const& lhs, LinearStlAllocator<TRhs, TArenaSource> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+
+namespace detail {
+
+	struct ScratchArenaSource
+	{
+		static LinearArena& Get() { return GetScratchArena(); }
+	};
+
+	struct FrameArenaSource
+	{
+		static LinearArena& Get() { return FrameAllocator::GetInstance()->GetCurrentArena(); }
+	};
+
+} // namespace detail
+
+
+// allocates from the threads scratch arena - containers must not outlive the enclosing ScratchScope
+template <typename TDataType>
+using ScratchStlAllocator = LinearStlAllocator<TDataType, detail::ScratchArenaSource>;
+
+// allocates from the current frame - containers are valid until the end of the next frame
+template <typename TDataType>
+using FrameStlAllocator = LinearStlAllocator<TDataType, detail::FrameArenaSource>;
+
+template <typename TDataType>
+using ScratchVector = std::vector<TDataType, ScratchStlAllocator<TDataType>>;
+
+template <typename TDataType>
+using FrameVector = std::vector<TDataType, FrameStlAllocator<TDataType>>;
+
+
+//---------------------------------
+// PoolStlAllocator
+//
+// STL compatible allocator for node based containers (lists, maps, sets)
+//  - single element allocations come from a pool shared by all allocators of the same type, larger requests go to the heap
+//  - not thread safe
+//
+template <typename TDataType>
+class PoolStlAllocator
+{
+	// definitions
+	//-------------
+public:
+	using value_type = TDataType;
+
+	template <typename TOther>
+	struct rebind
+	{
+		using other = PoolStlAllocator<TOther>;
+	};
+
+	// construct
+	//-----------
+	PoolStlAllocator() = default;
+
+	template <typename TOther>
+	PoolStlAllocator(PoolStlAllocator<TOther> const&) {}
+
+	// allocator interface
+	//---------------------
+	TDataType* allocate(size_t const count)
+	{
+		if (count == 1u)
+		{
+			return static_cast<TDataType*>(GetPool().Allocate());
+		}
+
+		return static_cast<TDataType*>(::operator new(count * sizeof(TDataType)));
+	}
+
+	void deallocate(TDataType* const ptr, size_t const count)
+	{
+		if (count == 1u)
+		{
+			GetPool().Free(ptr);
+		}
+		else
+		{
+			::operator delete(ptr);
+		}
+	}
+
+	// utility
+	//---------
+	static PoolAllocator& GetPool()
+	{
+		static PoolAllocator s_Pool(sizeof(TDataType), PoolAllocator::s_DefaultBlocksPerChunk, alignof(TDataType));
+		return s_Pool;
+	}
+};
+
+template <typename TLhs, typename TRhs>
+bool operator==(PoolStlAllocator<TLhs> const&, PoolStlAllocator<TRhs> const&) { return true; }
+
+template <typename TLhs, typename TRhs>
+bool operator!=(PoolStlAllocator<TLhs> const&, PoolStlAllocator<TRhs> const&) { return false; }
+
+
+} // namespace core
+} // namespace et
@@ -6,6 +6,7 @@
 #include "RealTimeTickTriggerer.h"
 #include "DefaultTickTriggerer.h"
 #include <EtCore/Util/InputManager.h>
+#include <EtCore/Memory/FrameAllocator.h>
 
 
 namespace et {
@@ -38,33 +39,22 @@ TickManager::Tickable& TickManager::Tickable::operator=(Tickable const& other)
 //---------------------------------
 // TickManager::TriggerRealTime
 //
-// Trigger a tick if this triggerer is currently registered and has already triggered a tick in the last cycle
+// Trigger a tick if this triggerer is currently registered
 //
 void TickManager::TriggerRealTime(I_RealTimeTickTriggerer* const triggerer)
 {
-	std::vector<T_RealTimeTriggerer> triggerersCopy = m_RealTimeTriggerers; // ensure adding or removing during tick doesn't cause issues
-
-	auto findResult = std::find_if(triggerersCopy.begin(), triggerersCopy.end(), [triggerer](T_RealTimeTriggerer const& rt)
+	// the list isn't copied, the tick may add or remove triggerers but the lookup result isn't used after it
+	//  - the ticked flags of real time triggerers are never reset, so every call from a registered triggerer ticks, as it did when this worked on a copy
+	auto const findResult = std::find_if(m_RealTimeTriggerers.cbegin(), m_RealTimeTriggerers.cend(), [triggerer](T_RealTimeTriggerer const& rt)
 	{
 		return rt.first == triggerer;
 	});
 
 	// only trigger a tick if this triggerer is registered
-	if (findResult != triggerersCopy.cend())
+	if ((findResult != m_RealTimeTriggerers.cend()) && findResult->second)
 	{
-		// If this triggerer has already been rendered but is calling again we should update everything
-		if (findResult->second)
-		{
-			EndTick();
-
-			for (T_RealTimeTriggerer& rt : triggerersCopy)
-			{
-				rt.second = false;
-			}
-
-			Tick();
-		}
-		findResult->second = true;
+		EndTick();
+		Tick();
 	}
 }
 
@@ -247,18 +237,29 @@ void TickManager::UnregisterTickable(I_Tickable* const tickableObject)
 //---------------------------------
 // TickManager::Tick
 //
-// Start time and performance monitoring, then tick all tickable objects in order of their priority, and finally update the state of input
+// Start time and performance monitoring, run the fixed simulation steps, then tick all tickable objects in order of their priority, and finally update the state of input
+//  - frame allocations from two frames ago are released before any tickable runs
 //
 void TickManager::Tick()
 {
+	ET_PROFILE_ZONE("TickManager::Tick");
+
+	FrameAllocator::GetInstance()->SwapFrames();
+
+	float frameTime = 0.f;
+
 	BaseContext const* const context = ContextManager::GetInstance()->GetActiveContext();
 	if (context != nullptr)
 	{
 		// start new frame timer and performance
 		context->time->Update();
 		PERFORMANCE->StartFrameTimer();
+
+		frameTime = context->time->DeltaTime();
 	}
 
+	RunFixedSteps(frameTime);
+
 	// tick all objects
 	for (Tickable& tickableObject : m_Tickables)
 	{
@@ -272,12 +273,80 @@ void TickManager::Tick()
 //---------------------------------
 // TickManager::EndTick
 //
-// At the end of the tick stop performance tracking
+// At the end of the tick stop performance tracking, and close the profiler frame
 //
 void TickManager::EndTick()
 {
 	// update performance info
 	PERFORMANCE->Update();
+
+	if (Profiler::IsActive())
+	{
+		Profiler::GetInstance()->EndFrame();
+	}
+}
+
+//---------------------------------
+// TickManager::RunFixedSteps
+//
+// Consume the frame time in fixed size steps, ticking all fixed step objects once per step in order of their priority
+//  - if more steps are due than allowed, the remaining whole steps are dropped, so the simulation runs slower than real time instead of falling further behind
+//  - input queried during a step reflects what happened since the previous step
+//
+void TickManager::RunFixedSteps(float const frameTime)
+{
+	m_Accumulator += std::max(frameTime, 0.f);
+
+	uint32 stepCount = 0u;
+	while ((m_Accumulator >= m_FixedTimestep) && (stepCount < m_MaxFixedSteps))
+	{
+		ET_PROFILE_ZONE("TickManager::FixedStep");
+
+		InputManager::GetInstance()->BeginFixedStep();
+
+		for (Tickable& tickableObject : m_Tickables)
+		{
+			tickableObject.tickable->OnFixedTick();
+		}
+
+		InputManager::GetInstance()->EndFixedStep();
+
+		m_Accumulator -= m_FixedTimestep;
+		++stepCount;
+		++m_FixedStepCount;
+	}
+
+	if (m_Accumulator >= m_FixedTimestep)
+	{
+		m_Accumulator = std::fmod(m_Accumulator, m_FixedTimestep);
+	}
+
+	m_InterpolationAlpha = m_Accumulator / m_FixedTimestep;
+}
+
+//---------------------------------
+// TickManager::SetFixedTimestep
+//
+// Change the simulation rate - the accumulated time is rescaled so that the interpolation state stays consistent
+//
+void TickManager::SetFixedTimestep(float const timestep)
+{
+	ET_ASSERT(timestep > 0.f, "Fixed timestep must be larger than zero");
+
+	m_Accumulator = m_InterpolationAlpha * timestep;
+	m_FixedTimestep = timestep;
+}
+
+//---------------------------------
+// TickManager::SetMaxFixedSteps
+//
+// Limit how many simulation steps can run within a single frame
+//
+void TickManager::SetMaxFixedSteps(uint32 const maxSteps)
+{
+	ET_ASSERT(maxSteps > 0u, "At least one fixed step per frame is required");
+
+	m_MaxFixedSteps = maxSteps;
 }
 
 
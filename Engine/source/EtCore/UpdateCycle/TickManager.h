@@ -16,6 +16,9 @@ class I_DefaultTickTriggerer;
 // TickManager
 //
 // Class that decides when to call a new tick to optimize for vsync or non realtime rendering
+//  - each tick first runs as many fixed simulation steps as the accumulated frame time allows, then the variable rate frame tick
+//  - the number of fixed steps per tick is capped so that a slow frame doesn't cascade into ever slower frames, instead the simulation slows down
+//  - the leftover time is exposed as an interpolation alpha, so that frame rate dependent systems can blend between the last two simulation states
 //
 class TickManager : public Singleton<TickManager>
 {
@@ -46,6 +49,12 @@ private:
 	typedef std::pair<I_RealTimeTickTriggerer const*, bool> T_RealTimeTriggerer;
 	typedef std::pair<I_DefaultTickTriggerer const*, bool> T_DefaultTriggerer;
 
+public:
+	static constexpr float s_DefaultFixedTimestep = 1.f / 60.f;
+	static constexpr uint32 s_DefaultMaxFixedSteps = 4u;
+
+private:
+
 	// Defualt constructor and destructor
 	//----------------------------
 	TickManager() = default;
@@ -75,6 +84,19 @@ private:
 	void Tick();
 	void EndTick();
 
+	// fixed step control
+	//--------------------
+public:
+	void RunFixedSteps(float const frameTime); // called by every tick, can also be used to advance the simulation without rendering a frame
+
+	void SetFixedTimestep(float const timestep);
+	void SetMaxFixedSteps(uint32 const maxSteps);
+
+	float GetFixedTimestep() const { return m_FixedTimestep; }
+	uint32 GetMaxFixedSteps() const { return m_MaxFixedSteps; }
+	float GetInterpolationAlpha() const { return m_InterpolationAlpha; } // [0, 1) - progress from the previous to the current simulation state
+	uint64 GetFixedStepCount() const { return m_FixedStepCount; } // total fixed steps since startup
+
 private:
 
 	// Data
@@ -86,6 +108,12 @@ private:
 	size_t m_DefaultTicks = 0;
 
 	std::vector<Tickable> m_Tickables;
+
+	float m_FixedTimestep = s_DefaultFixedTimestep;
+	uint32 m_MaxFixedSteps = s_DefaultMaxFixedSteps;
+	float m_Accumulator = 0.f;
+	float m_InterpolationAlpha = 0.f;
+	uint64 m_FixedStepCount = 0u;
 };
 
 
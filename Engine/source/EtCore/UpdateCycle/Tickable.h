@@ -9,6 +9,8 @@ namespace core {
 // I_Tickable
 //
 // Interface for things that should update regularly
+//  - OnFixedTick runs zero or more times per frame with a constant timestep (see TickManager::GetFixedTimestep), before OnTick is called
+//  - OnTick runs once per frame
 //
 class I_Tickable
 {
@@ -19,6 +21,7 @@ protected:
 	I_Tickable& operator=(const I_Tickable&) { return *this; } 
 
 public:
+	virtual void OnFixedTick() {}
 	virtual void OnTick() {}
 };
 
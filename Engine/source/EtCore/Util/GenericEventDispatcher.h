@@ -2,6 +2,7 @@
 #include <EtCore/Containers/slot_map.h>
 
 #include <functional>
+#include <memory>
 
 
 namespace et {
@@ -13,6 +14,7 @@ namespace core {
 //
 // Abstract class that can register listeners for events events using bitflags and send event data to the appropriate listeners
 // Event data is sent in pointer form in order to support polymorphism
+//  - the sender owns the event data, so that events can live on the stack and sending them doesn't hit the heap
 //
 template <typename TFlagType, class TEventData>
 class GenericEventDispatcher final
@@ -35,7 +37,7 @@ private:
 		Listener(TFlagType const eventFlags, T_CallbackFn& func);
 
 		TFlagType flags;
-		T_CallbackFn callback;
+		std::shared_ptr<T_CallbackFn const> callback; // shared so that notifying can hold on to callbacks without copying their captures
 	};
 
 public:
@@ -1,6 +1,8 @@
 #pragma once
 #include <algorithm>
 
+#include <EtCore/Memory/StlAllocators.h>
+
 
 namespace et {
 namespace core {
@@ -19,9 +21,8 @@ namespace core {
 template <typename TFlagType, class TEventData>
 GenericEventDispatcher<TFlagType, TEventData>::Listener::Listener(TFlagType const eventFlags, T_CallbackFn& func)
 	: flags(eventFlags)
-{
-	callback = func;
-}
+	, callback(std::make_shared<T_CallbackFn const>(func))
+{ }
 
 
 //===========================
@@ -58,24 +59,24 @@ void GenericEventDispatcher<TFlagType, TEventData>::Unregister(T_CallbackId& cal
 //---------------------------------
 // GenericEventDispatcher::Notify
 //
-// Notify all listeners registered to this event of the change immediately - deletes the event data after all listeners have been notified
+// Notify all listeners registered to this event of the change immediately - the event data is only accessed during the call
 //
 template <typename TFlagType, class TEventData>
 void GenericEventDispatcher<TFlagType, TEventData>::Notify(TFlagType const eventType, TEventData const* const eventData)
 {
-	// iterate over a copy of the lsit in order to make listeners unregistering themselves during their callback safe
-	slot_map<Listener> notificationListeners = m_Listeners;
+	// iterate over a copy of the list in order to make listeners unregistering themselves during their callback safe
+	//  - the copy lives in scratch memory and only shares the callbacks, so that sending events doesn't hit the heap
+	ScratchScope const scratchScope;
+	ScratchVector<Listener> const notificationListeners(m_Listeners.cbegin(), m_Listeners.cend());
 
-	for (Listener& listener : notificationListeners) 
+	for (Listener const& listener : notificationListeners) 
 	{
 		// check if the listener is listening for our event type
 		if (listener.flags & eventType)
 		{
-			listener.callback(eventType, eventData);
+			(*listener.callback)(eventType, eventData);
 		}
 	}
-
-	delete eventData;
 }
 
 
@@ -11,6 +11,15 @@ namespace core {
 //===================
 
 
+//---------------------------------
+// InputManager::c-tor
+//
+InputManager::InputManager()
+{
+	m_MouseButtons.fill(E_KeyState::Up);
+	m_FixedMouseButtons.fill(E_KeyState::Up);
+}
+
 //---------------------------------
 // InputManager::Update
 //
@@ -35,6 +44,29 @@ void InputManager::Update()
 	m_MouseMove = vec2();
 }
 
+//---------------------------------
+// InputManager::EndFixedStep
+//
+// Updates the key states seen by fixed simulation steps, so that edges and mouse movement are only consumed once
+//
+void InputManager::EndFixedStep()
+{
+	for (auto & key : m_FixedKeyStates)
+	{
+		CycleKeyState(key.second);
+	}
+
+	for (auto & button : m_FixedMouseButtons)
+	{
+		CycleKeyState(button);
+	}
+
+	m_FixedMouseWheelDelta = vec2();
+	m_FixedMouseMove = vec2();
+
+	m_IsInFixedStep = false;
+}
+
 //---------------------------------
 // InputManager::GetKeyState
 //
@@ -42,8 +74,10 @@ void InputManager::Update()
 //
 E_KeyState InputManager::GetKeyState(E_KbdKey const key)
 {
-	auto keyIt = m_KeyStates.find(key);
-	if (keyIt != m_KeyStates.cend())
+	std::map<E_KbdKey, E_KeyState> const& keyStates = m_IsInFixedStep ? m_FixedKeyStates : m_KeyStates;
+
+	auto keyIt = keyStates.find(key);
+	if (keyIt != keyStates.cend())
 	{
 		return keyIt->second;
 	}
@@ -63,7 +97,7 @@ E_KeyState InputManager::GetMouseButton(E_MouseButton const button)
 		return E_KeyState::Up;
 	}
 
-	return m_MouseButtons[button];
+	return m_IsInFixedStep ? m_FixedMouseButtons[button] : m_MouseButtons[button];
 }
 
 //---------------------------------
@@ -74,6 +108,7 @@ E_KeyState InputManager::GetMouseButton(E_MouseButton const button)
 void InputManager::OnKeyPressed(E_KbdKey const key)
 {
 	m_KeyStates[key] = E_KeyState::Pressed;
+	m_FixedKeyStates[key] = E_KeyState::Pressed;
 }
 
 //---------------------------------
@@ -84,6 +119,7 @@ void InputManager::OnKeyPressed(E_KbdKey const key)
 void InputManager::OnKeyReleased(E_KbdKey const key)
 {
 	m_KeyStates[key] = E_KeyState::Released;
+	m_FixedKeyStates[key] = E_KeyState::Released;
 }
 
 //---------------------------------
@@ -94,6 +130,7 @@ void InputManager::OnKeyReleased(E_KbdKey const key)
 void InputManager::OnMousePressed(E_MouseButton const button)
 {
 	m_MouseButtons[button] = E_KeyState::Pressed;
+	m_FixedMouseButtons[button] = E_KeyState::Pressed;
 }
 
 //---------------------------------
@@ -104,6 +141,7 @@ void InputManager::OnMousePressed(E_MouseButton const button)
 void InputManager::OnMouseReleased(E_MouseButton const button)
 {
 	m_MouseButtons[button] = E_KeyState::Released;
+	m_FixedMouseButtons[button] = E_KeyState::Released;
 }
 
 //---------------------------------
@@ -115,17 +153,19 @@ void InputManager::OnMouseMoved(ivec2 const& mousePos)
 {
 	vec2 newMouse = math::vecCast<float>(mousePos);
 	m_MouseMove = newMouse - m_MousePos;
+	m_FixedMouseMove = m_FixedMouseMove + m_MouseMove;
 	m_MousePos = newMouse;
 }
 
 //---------------------------------
 // InputManager::SetMouseWheelDelta
 //
-// Sets how much the user scrolled in the last frame
+// Sets how much the user scrolled in the last frame, fixed steps accumulate scrolling until the next step
 //
 void InputManager::SetMouseWheelDelta(ivec2 const& mouseWheel)
 {
 	m_MouseWheelDelta = math::vecCast<float>(mouseWheel);
+	m_FixedMouseWheelDelta = m_FixedMouseWheelDelta + m_MouseWheelDelta;
 }
 
 //---------------------------------
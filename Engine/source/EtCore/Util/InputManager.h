@@ -155,6 +155,7 @@ enum class E_KbdKey : uint32
 // E_KeyState
 //
 // Reflects the state of a keyboard key in a simplistic way - pressed and released are only valid for one frame
+//  - during fixed simulation steps they are valid for one step instead, see InputManager
 //
 enum E_KeyState
 {
@@ -215,6 +216,8 @@ public:
 //
 // Input Manager class 
 //  - doesn't do much on it's own, needs to be provided with input by a library, but abstracts it for all other engine systems
+//  - fixed simulation steps see their own copy of key edges and mouse deltas, which persist until a step consumed them
+//    this way edges are neither missed on frames without steps nor repeated on frames with several steps
 //
 class InputManager : public Singleton<InputManager>
 {
@@ -224,13 +227,16 @@ private:
 
 	// ctor dtor
 	//-----------
-	InputManager() : m_KeyStates() {}
+	InputManager();
 	virtual ~InputManager() = default;
 
 	// framewise
 	//-------------
 	void Update();
 
+	void BeginFixedStep() { m_IsInFixedStep = true; }
+	void EndFixedStep();
+
 public:
 
 	// accessors
@@ -239,8 +245,8 @@ public:
 
 	E_KeyState GetMouseButton(E_MouseButton const button);
 	vec2 const& GetMousePos() const { return m_MousePos; }
-	vec2 const& GetMouseMove() const { return m_MouseMove; }
-	vec2 const& GetMouseWheelDelta() const { return m_MouseWheelDelta; }
+	vec2 const& GetMouseMove() const { return m_IsInFixedStep ? m_FixedMouseMove : m_MouseMove; }
+	vec2 const& GetMouseWheelDelta() const { return m_IsInFixedStep ? m_FixedMouseWheelDelta : m_MouseWheelDelta; }
 
 	bool IsRunning() const { return m_IsRunning; }
 
@@ -281,6 +287,15 @@ private:
 
 	std::array<E_KeyState, E_MouseButton::COUNT> m_MouseButtons;
 
+	// fixed step input
+	bool m_IsInFixedStep = false;
+
+	std::map<E_KbdKey, E_KeyState> m_FixedKeyStates;
+	std::array<E_KeyState, E_MouseButton::COUNT> m_FixedMouseButtons;
+
+	vec2 m_FixedMouseMove;
+	vec2 m_FixedMouseWheelDelta;
+
 	bool m_MouseConsumed = false;
 
 	// if set, will take responsibility for changing the cursor shape
@@ -0,0 +1,185 @@
+#include "stdafx.h"
+#include "JobPool.h"
+
+
+namespace et {
+namespace core {
+
+
+namespace {
+	thread_local bool s_IsInJob = false; // set while a thread works on grains, nested loops run inline so that they can't wait on themselves
+}
+
+
+//==========
+// Job Pool
+//==========
+
+
+//---------------------------------
+// JobPool::c-tor
+//
+// Start a worker for every hardware thread, except the one the calling thread runs on
+//
+JobPool::JobPool()
+	: m_NextGrain(0u)
+	, m_CompletedGrains(0u)
+{
+	size_t const workerCount = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1u)) - 1u;
+	for (size_t workerIdx = 0u; workerIdx < workerCount; ++workerIdx)
+	{
+		m_Workers.emplace_back(&JobPool::WorkerLoop, this, workerIdx);
+	}
+}
+
+//---------------------------------
+// JobPool::d-tor
+//
+JobPool::~JobPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_IsStopping = true;
+	}
+
+	m_WorkCondition.notify_all();
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+}
+
+//---------------------------------
+// JobPool::Run
+//
+// Split [begin, end) into grains and wait until all of them are processed
+//  - maxThreads limits how many threads work on the loop including the calling one, zero allows all of them
+//  - single grain loops, loops without workers and loops started from within another loop run on the calling thread directly
+//  - a new loop is only published once no worker is left over from the previous one, so that none of them can mix up grains of both
+//
+void JobPool::Run(size_t const begin, size_t const end, size_t const grainSize, T_GrainFn const& func, size_t const maxThreads)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+
+	Job job;
+	job.begin = begin;
+	job.end = end;
+	job.grainSize = std::max(grainSize, static_cast<size_t>(1u));
+	job.grainCount = (end - begin + job.grainSize - 1u) / job.grainSize;
+	job.workerCount = (maxThreads == 0u) ? m_Workers.size() : std::min(maxThreads - 1u, m_Workers.size());
+	job.func = &func;
+
+	if ((job.grainCount == 1u) || (job.workerCount == 0u) || s_IsInJob)
+	{
+		for (size_t grainIdx = 0u; grainIdx < job.grainCount; ++grainIdx)
+		{
+			size_t const grainBegin = begin + grainIdx * job.grainSize;
+			func(grainIdx, grainBegin, std::min(grainBegin + job.grainSize, end));
+		}
+
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_DoneCondition.wait(lock, [this]() { return !m_HasJob && (m_BusyWorkers == 0u); });
+
+		m_Job = job;
+		m_NextGrain = 0u;
+		m_CompletedGrains = 0u;
+		m_HasJob = true;
+		++m_Generation;
+	}
+
+	m_WorkCondition.notify_all();
+
+	ProcessGrains(job);
+
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_DoneCondition.wait(lock, [this, &job]() { return m_CompletedGrains.load() == job.grainCount; });
+
+		m_HasJob = false;
+	}
+
+	m_DoneCondition.notify_all(); // loops waiting on other threads can start
+}
+
+//---------------------------------
+// JobPool::ProcessGrains
+//
+// Work on grains of the job until none are left
+//
+void JobPool::ProcessGrains(Job const& job)
+{
+	bool const wasInJob = s_IsInJob;
+	s_IsInJob = true;
+
+	for (;;)
+	{
+		size_t const grainIdx = m_NextGrain.fetch_add(1u);
+		if (grainIdx >= job.grainCount)
+		{
+			break;
+		}
+
+		size_t const grainBegin = job.begin + grainIdx * job.grainSize;
+		(*job.func)(grainIdx, grainBegin, std::min(grainBegin + job.grainSize, job.end));
+
+		if (m_CompletedGrains.fetch_add(1u) + 1u == job.grainCount)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_DoneCondition.notify_all();
+		}
+	}
+
+	s_IsInJob = wasInJob;
+}
+
+//---------------------------------
+// JobPool::WorkerLoop
+//
+// Wait for loops to be published and help process them
+//
+void JobPool::WorkerLoop(size_t const workerIdx)
+{
+	uint64 handledGeneration = 0u;
+
+	for (;;)
+	{
+		Job job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WorkCondition.wait(lock, [this, handledGeneration, workerIdx]()
+				{
+					return m_IsStopping || (m_HasJob && (m_Generation != handledGeneration) && (workerIdx < m_Job.workerCount));
+				});
+
+			if (m_IsStopping)
+			{
+				return;
+			}
+
+			handledGeneration = m_Generation;
+			job = m_Job;
+			++m_BusyWorkers;
+		}
+
+		ProcessGrains(job);
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			--m_BusyWorkers;
+		}
+
+		m_DoneCondition.notify_all();
+	}
+}
+
+
+} // namespace core
+} // namespace et
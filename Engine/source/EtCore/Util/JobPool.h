@@ -0,0 +1,90 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include <EtCore/Util/Singleton.h>
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// JobPool
+//
+// Fixed set of worker threads shared by all systems that split their per frame work into parallel loops
+//  - workers live as long as the pool, so dispatching a loop doesn't create or destroy any threads
+//  - the calling thread works on the loop too, and only returns once all of it is done
+//  - loops are split into grains that threads pull from a shared counter
+//  - one loop runs at a time, loops started from other threads wait for it, and loops started from within a grain run on the calling thread
+//
+class JobPool final : public Singleton<JobPool>
+{
+	// definitions
+	//-------------
+	friend class Singleton<JobPool>;
+
+public:
+	typedef std::function<void(size_t const, size_t const, size_t const)> T_GrainFn; // grain index, begin, end
+
+private:
+	//---------------------------------
+	// JobPool::Job
+	//
+	// A loop split into grains
+	//
+	struct Job
+	{
+		size_t begin = 0u;
+		size_t end = 0u;
+		size_t grainSize = 1u;
+		size_t grainCount = 0u;
+		size_t workerCount = 0u; // workers with a lower index help with the loop
+
+		T_GrainFn const* func = nullptr;
+	};
+
+	// construct destruct
+	//--------------------
+	JobPool();
+	~JobPool();
+
+	// functionality
+	//---------------
+public:
+	void Run(size_t const begin, size_t const end, size_t const grainSize, T_GrainFn const& func, size_t const maxThreads = 0u);
+
+	// accessors
+	//-----------
+	size_t GetThreadCount() const { return m_Workers.size() + 1u; } // including the calling thread
+
+	// utility
+	//---------
+private:
+	void ProcessGrains(Job const& job);
+	void WorkerLoop(size_t const workerIdx);
+
+	// Data
+	///////
+
+	std::vector<std::thread> m_Workers;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkCondition;
+	std::condition_variable m_DoneCondition;
+
+	Job m_Job;
+	uint64 m_Generation = 0u;
+	size_t m_BusyWorkers = 0u;
+	bool m_HasJob = false;
+	bool m_IsStopping = false;
+
+	std::atomic<size_t> m_NextGrain;
+	std::atomic<size_t> m_CompletedGrains;
+};
+
+
+} // namespace core
+} // namespace et
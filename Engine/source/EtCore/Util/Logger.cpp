@@ -18,6 +18,7 @@ Logger::DebugLogger* Logger::m_DebugLogger = nullptr;
 uint8 Logger::m_BreakBitField = LogLevel::Error;
 bool Logger::m_TimestampDate = true;
 bool Logger::m_IsInitialized = false;
+std::mutex Logger::m_Mutex;
 
 void Logger::Initialize()
 {
@@ -108,6 +109,8 @@ void Logger::Log(const std::string& msg, LogLevel level, bool timestamp, ivec2 c
 
 	timestampStream << stream.str();
 
+	std::lock_guard<std::mutex> const lock(m_Mutex);
+
 	//Use specific loggers to log
 	if (m_ConsoleLogger)
 	{
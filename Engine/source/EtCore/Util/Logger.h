@@ -4,6 +4,7 @@
 #include <windows.h>
 #endif
 #include <string>
+#include <mutex>
 
 
 namespace et {
@@ -118,6 +119,8 @@ private:
 	static bool m_TimestampDate;
 	static bool m_IsInitialized;
 
+	static std::mutex m_Mutex; // messages can be logged from worker threads, e.g. in the cooker
+
 private:
 	//Disable default constructor and destructor
 	Logger() = default;
@@ -0,0 +1,426 @@
+#include "stdafx.h"
+#include "Profiler.h"
+
+#include <chrono>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+
+
+namespace et {
+namespace core {
+
+
+namespace detail {
+
+	// buffers are cached per thread, the generation detects buffers belonging to a destroyed profiler
+	thread_local void* s_ProfilerThreadBuffer = nullptr;
+	thread_local uint32 s_ProfilerThreadGeneration = 0u;
+
+	//---------------------------------
+	// AppendJsonString
+	//
+	// Zone names are mostly function names, but escape anyway so the trace is always valid JSON
+	//
+	void AppendJsonString(std::ostringstream& stream, char const* str)
+	{
+		stream << '"';
+		for (; *str != '\0'; ++str)
+		{
+			if ((*str == '"') || (*str == '\\'))
+			{
+				stream << '\\';
+			}
+
+			stream << *str;
+		}
+
+		stream << '"';
+	}
+
+	//---------------------------------
+	// AppendMicroseconds
+	//
+	// Trace timestamps are in microseconds, keep sub microsecond precision as decimals
+	//
+	void AppendMicroseconds(std::ostringstream& stream, uint64 const ns)
+	{
+		stream << (ns / 1000u) << '.';
+
+		uint64 const fraction = ns % 1000u;
+		if (fraction < 100u)
+		{
+			stream << '0';
+		}
+
+		if (fraction < 10u)
+		{
+			stream << '0';
+		}
+
+		stream << fraction;
+	}
+
+} // namespace detail
+
+
+//==========
+// Profiler
+//==========
+
+
+std::atomic<bool> Profiler::s_IsActive(false);
+std::atomic<uint32> Profiler::s_Generation(0u);
+
+
+// construct destruct
+//////////////////////
+
+//---------------------------------
+// Profiler::c-tor
+//
+// Nothing is recorded until the profiler is enabled
+//
+Profiler::Profiler()
+	: m_Generation(++s_Generation)
+{
+	m_FrameEnd = Now();
+}
+
+//---------------------------------
+// Profiler::d-tor
+//
+// Threads still recording will start a new buffer if a new profiler is created
+//
+Profiler::~Profiler()
+{
+	s_IsActive.store(false);
+}
+
+
+// functionality
+/////////////////
+
+//---------------------------------
+// Profiler::Now
+//
+// Nanoseconds from a monotonic clock
+//
+uint64 Profiler::Now()
+{
+	return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//---------------------------------
+// Profiler::SetEnabled
+//
+// Zones entered while the profiler is disabled are not recorded
+//
+void Profiler::SetEnabled(bool const enabled)
+{
+	s_IsActive.store(enabled && (ET_PROFILER_ENABLED != 0));
+}
+
+//---------------------------------
+// Profiler::SetThreadName
+//
+// Name the calling thread in traces
+//
+void Profiler::SetThreadName(std::string const& name)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(m_ThreadMutex);
+	buffer.name = name;
+}
+
+//---------------------------------
+// Profiler::EndFrame
+//
+// Collect all zones recorded since the last frame and aggregate them
+//  - should be called from the main thread once per frame
+//
+void Profiler::EndFrame()
+{
+	m_FrameStart = m_FrameEnd;
+	m_FrameEnd = Now();
+	++m_FrameIdx;
+
+	m_FrameStats.clear();
+	m_StatIndices.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(m_ThreadMutex);
+		for (std::unique_ptr<ThreadBuffer>& buffer : m_Threads)
+		{
+			CollectThread(*buffer);
+		}
+	}
+
+	std::sort(m_FrameStats.begin(), m_FrameStats.end(), [](ProfileZoneStats const& lhs, ProfileZoneStats const& rhs)
+		{
+			return lhs.inclusiveNs > rhs.inclusiveNs;
+		});
+
+	// capture
+	//---------
+	if (m_CaptureFramesLeft > 0u)
+	{
+		m_CaptureFrameTimes.push_back(m_FrameEnd);
+
+		--m_CaptureFramesLeft;
+		if (m_CaptureFramesLeft == 0u)
+		{
+			if (WriteChromeTrace(m_CapturePath))
+			{
+				LOG(FS("Profiler::EndFrame > wrote %u frames to '%s'", static_cast<uint32>(m_CaptureFrameTimes.size() - 1u), m_CapturePath.c_str()), LogLevel::Info);
+			}
+
+			m_CaptureEvents.clear();
+			m_CaptureFrameTimes.clear();
+			m_HasCompletedCapture = true;
+		}
+	}
+}
+
+//---------------------------------
+// Profiler::BeginCapture
+//
+// Record all zones of the next frames, and write them to a trace file once the frames are complete
+//
+void Profiler::BeginCapture(uint32 const frameCount, std::string const& filePath)
+{
+	ET_ASSERT(frameCount > 0u);
+	ET_ASSERT(!IsCapturing(), "a capture is already running");
+
+	m_CaptureFramesLeft = frameCount;
+	m_CapturePath = filePath;
+	m_HasCompletedCapture = false;
+
+	m_CaptureEvents.clear();
+	m_CaptureFrameTimes.clear();
+	m_CaptureFrameTimes.push_back(Now());
+}
+
+//---------------------------------
+// Profiler::WriteChromeTrace
+//
+// Write the captured zones in the chrome trace event format
+//  - zones become complete events, frame boundaries become global instant events
+//
+bool Profiler::WriteChromeTrace(std::string const& filePath) const
+{
+	uint64 const origin = m_CaptureFrameTimes.empty() ? 0u : m_CaptureFrameTimes.front();
+
+	std::ostringstream stream;
+	stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	bool isFirst = true;
+	auto beginEvent = [&stream, &isFirst]()
+		{
+			if (!isFirst)
+			{
+				stream << ",\n";
+			}
+
+			isFirst = false;
+		};
+
+	// thread names
+	{
+		std::lock_guard<std::mutex> lock(m_ThreadMutex);
+		for (std::unique_ptr<ThreadBuffer> const& buffer : m_Threads)
+		{
+			beginEvent();
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+			detail::AppendJsonString(stream, buffer->name.c_str());
+			stream << "}}";
+		}
+	}
+
+	// frames
+	for (size_t frameIdx = 1u; frameIdx < m_CaptureFrameTimes.size(); ++frameIdx)
+	{
+		beginEvent();
+		stream << "{\"name\":\"Frame " << frameIdx << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":";
+		detail::AppendMicroseconds(stream, m_CaptureFrameTimes[frameIdx] - origin);
+		stream << "}";
+	}
+
+	// zones
+	for (ProfileEvent const& evnt : m_CaptureEvents)
+	{
+		if (evnt.start < origin)
+		{
+			continue;
+		}
+
+		beginEvent();
+		stream << "{\"name\":";
+		detail::AppendJsonString(stream, evnt.name);
+		stream << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << evnt.threadId << ",\"ts\":";
+		detail::AppendMicroseconds(stream, evnt.start - origin);
+		stream << ",\"dur\":";
+		detail::AppendMicroseconds(stream, evnt.end - evnt.start);
+		stream << "}";
+	}
+
+	stream << "]}\n";
+
+	// write to disk
+	//---------------
+	File* file = new File(filePath, nullptr);
+
+	FILE_ACCESS_FLAGS outFlags;
+	outFlags.SetFlags(FILE_ACCESS_FLAGS::FLAGS::Create | FILE_ACCESS_FLAGS::FLAGS::Exists | FILE_ACCESS_FLAGS::FLAGS::Truncate);
+
+	bool success = file->Open(FILE_ACCESS_MODE::Write, outFlags);
+	if (success)
+	{
+		success = file->Write(FileUtil::FromText(stream.str()));
+	}
+
+	if (!success)
+	{
+		LOG("Profiler::WriteChromeTrace > unable to write trace to '" + filePath + std::string("'"), LogLevel::Warning);
+	}
+
+	SafeDelete(file);
+	return success;
+}
+
+
+// utility
+///////////
+
+//---------------------------------
+// Profiler::GetThreadBuffer
+//
+// Lazily register a buffer for the calling thread
+//
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+	if ((detail::s_ProfilerThreadBuffer == nullptr) || (detail::s_ProfilerThreadGeneration != m_Generation))
+	{
+		std::lock_guard<std::mutex> lock(m_ThreadMutex);
+
+		uint32 const threadId = static_cast<uint32>(m_Threads.size());
+		m_Threads.emplace_back(new ThreadBuffer(threadId));
+		m_Threads.back()->name = FS("thread %u", threadId);
+
+		detail::s_ProfilerThreadBuffer = m_Threads.back().get();
+		detail::s_ProfilerThreadGeneration = m_Generation;
+	}
+
+	return *static_cast<ThreadBuffer*>(detail::s_ProfilerThreadBuffer);
+}
+
+//---------------------------------
+// Profiler::EnterZone
+//
+void Profiler::EnterZone()
+{
+	++GetThreadBuffer().depth;
+}
+
+//---------------------------------
+// Profiler::LeaveZone
+//
+// Publish a completed zone - nested zones complete before their parents
+//
+void Profiler::LeaveZone(char const* const name, uint64 const start)
+{
+	uint64 const end = Now();
+
+	ThreadBuffer& buffer = GetThreadBuffer();
+	if (buffer.depth > 0u) // the profiler may have been recreated while the zone was open
+	{
+		--buffer.depth;
+	}
+
+	uint64 const writeCount = buffer.writeCount.load(std::memory_order_relaxed);
+	if (writeCount - buffer.readCount.load(std::memory_order_acquire) >= s_ThreadBufferCapacity)
+	{
+		buffer.dropCount.store(buffer.dropCount.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+		return;
+	}
+
+	ProfileEvent& evnt = buffer.events[writeCount & (s_ThreadBufferCapacity - 1u)];
+	evnt.name = name;
+	evnt.start = start;
+	evnt.end = end;
+	evnt.threadId = buffer.threadId;
+	evnt.depth = buffer.depth;
+
+	buffer.writeCount.store(writeCount + 1u, std::memory_order_release);
+}
+
+//---------------------------------
+// Profiler::CollectThread
+//
+// Read all events published by a thread since the last collection
+//  - since children complete before their parents, exclusive time is found by accumulating child durations per depth
+//  - slots are released to the recording thread only after all of them have been read, so they are never written while being read
+//  - if the thread dropped events because its buffer was full, child times can't be attributed reliably and are reset
+//
+void Profiler::CollectThread(ThreadBuffer& buffer)
+{
+	uint64 const writeCount = buffer.writeCount.load(std::memory_order_acquire);
+	uint64 readCount = buffer.readCount.load(std::memory_order_relaxed);
+
+	for (; readCount < writeCount; ++readCount)
+	{
+		ProfileEvent const& evnt = buffer.events[readCount & (s_ThreadBufferCapacity - 1u)];
+
+		uint32 const depth = std::min(evnt.depth, s_MaxDepth - 1u);
+		uint64 const duration = evnt.end - evnt.start;
+		uint64 const childTime = buffer.childTime[depth + 1u];
+
+		buffer.childTime[depth + 1u] = 0u;
+		buffer.childTime[depth] += duration;
+
+		AddToStats(evnt, (duration > childTime) ? (duration - childTime) : 0u);
+
+		if (m_CaptureFramesLeft > 0u)
+		{
+			m_CaptureEvents.push_back(evnt);
+		}
+	}
+
+	buffer.readCount.store(readCount, std::memory_order_release);
+
+	buffer.childTime[0] = 0u; // root zones have no parent to report to
+
+	uint64 const dropCount = buffer.dropCount.load(std::memory_order_relaxed);
+	if (dropCount != buffer.collectedDropCount)
+	{
+		m_DroppedEvents += dropCount - buffer.collectedDropCount;
+		buffer.collectedDropCount = dropCount;
+		std::fill(std::begin(buffer.childTime), std::end(buffer.childTime), 0u);
+	}
+}
+
+//---------------------------------
+// Profiler::AddToStats
+//
+// Zones are identified by their name pointer, which is stable for string literals
+//
+void Profiler::AddToStats(ProfileEvent const& evnt, uint64 const exclusiveNs)
+{
+	auto const foundIt = m_StatIndices.find(evnt.name);
+	if (foundIt == m_StatIndices.cend())
+	{
+		m_StatIndices.emplace(evnt.name, m_FrameStats.size());
+		m_FrameStats.push_back(ProfileZoneStats{ evnt.name, evnt.end - evnt.start, exclusiveNs, 1u });
+		return;
+	}
+
+	ProfileZoneStats& stats = m_FrameStats[foundIt->second];
+	stats.inclusiveNs += evnt.end - evnt.start;
+	stats.exclusiveNs += exclusiveNs;
+	++stats.callCount;
+}
+
+
+} // namespace core
+} // namespace et
@@ -0,0 +1,216 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "Singleton.h"
+
+
+// profiling can be compiled out entirely, in which case zone macros expand to nothing - otherwise it is compiled in but inactive until enabled
+#ifndef ET_PROFILER_ENABLED
+#	ifdef ET_SHIPPING
+#		define ET_PROFILER_ENABLED 0
+#	else
+#		define ET_PROFILER_ENABLED 1
+#	endif
+#endif
+
+
+namespace et {
+namespace core {
+
+
+//---------------------------------
+// ProfileEvent
+//
+// A completed zone - timestamps are in nanoseconds
+//
+struct ProfileEvent final
+{
+	char const* name; // must have static lifetime
+	uint64 start;
+	uint64 end;
+	uint32 threadId;
+	uint32 depth;
+};
+
+//---------------------------------
+// ProfileZoneStats
+//
+// Aggregated timings for all zones with the same name within a frame
+//  - exclusive time doesn't include time spent in nested zones
+//
+struct ProfileZoneStats final
+{
+	char const* name;
+	uint64 inclusiveNs;
+	uint64 exclusiveNs;
+	uint32 callCount;
+};
+
+
+//---------------------------------
+// Profiler
+//
+// Hierarchical CPU profiler collecting scoped zones from any thread
+//  - the profiler starts disabled, zones are only recorded after SetEnabled(true)
+//  - every thread records into its own ring buffer, so recording doesn't lock
+//  - at the end of every frame the buffers are collected on the main thread and aggregated into per zone statistics
+//  - a capture records the raw zones of several frames and writes them as a chrome trace (chrome://tracing, ui.perfetto.dev)
+//  - zones are placed with ET_PROFILE_ZONE / ET_PROFILE_FUNCTION, and cost a single atomic load while the profiler is inactive
+//
+class Profiler final : public Singleton<Profiler>
+{
+	// definitions
+	//-------------
+	friend class Singleton<Profiler>;
+	friend class ProfileZone;
+
+public:
+	static constexpr size_t s_ThreadBufferCapacity = 1u << 14; // events per thread between collections, buffers live as long as the profiler so prefer long lived worker threads
+	static constexpr uint32 s_MaxDepth = 64u;
+
+private:
+	//---------------------------------
+	// ThreadBuffer
+	//
+	// Ring buffer written by a single thread and read by the collecting thread
+	//  - slots are only handed back to the recording thread once they have been read, if the buffer is full new events are dropped
+	//
+	struct ThreadBuffer final
+	{
+		ThreadBuffer(uint32 const id) : threadId(id), events(s_ThreadBufferCapacity) {}
+
+		uint32 const threadId;
+		std::string name;
+
+		std::vector<ProfileEvent> events;
+		std::atomic<uint64> writeCount { 0u }; // published by the recording thread
+		std::atomic<uint64> readCount { 0u }; // published by the collecting thread
+		std::atomic<uint64> dropCount { 0u };
+
+		// owned by the recording thread
+		uint32 depth = 0u;
+
+		// owned by the collecting thread
+		uint64 collectedDropCount = 0u;
+		uint64 childTime[s_MaxDepth + 1u] = {};
+	};
+
+	// construct destruct
+	//--------------------
+	Profiler();
+	~Profiler();
+
+	// functionality
+	//---------------
+public:
+	static bool IsActive() { return s_IsActive.load(std::memory_order_relaxed); }
+	static uint64 Now();
+
+	void SetEnabled(bool const enabled);
+	void SetThreadName(std::string const& name);
+
+	void EndFrame();
+
+	void BeginCapture(uint32 const frameCount, std::string const& filePath);
+	bool WriteChromeTrace(std::string const& filePath) const;
+
+	// accessors
+	//-----------
+	std::vector<ProfileZoneStats> const& GetFrameStats() const { return m_FrameStats; } // sorted by inclusive time
+	uint64 GetFrameDuration() const { return m_FrameEnd - m_FrameStart; }
+	uint64 GetFrameIndex() const { return m_FrameIdx; }
+	uint64 GetDroppedEventCount() const { return m_DroppedEvents; }
+
+	bool IsCapturing() const { return m_CaptureFramesLeft > 0u; }
+	bool HasCompletedCapture() const { return m_HasCompletedCapture; }
+
+	// utility
+	//---------
+private:
+	ThreadBuffer& GetThreadBuffer();
+
+	void EnterZone();
+	void LeaveZone(char const* const name, uint64 const start);
+
+	void CollectThread(ThreadBuffer& buffer);
+	void AddToStats(ProfileEvent const& evnt, uint64 const exclusiveNs);
+
+	// Data
+	///////
+
+	static std::atomic<bool> s_IsActive;
+	static std::atomic<uint32> s_Generation;
+
+	uint32 const m_Generation;
+
+	mutable std::mutex m_ThreadMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> m_Threads;
+
+	// frame statistics
+	uint64 m_FrameIdx = 0u;
+	uint64 m_FrameStart = 0u;
+	uint64 m_FrameEnd = 0u;
+	uint64 m_DroppedEvents = 0u;
+	std::vector<ProfileZoneStats> m_FrameStats;
+	std::unordered_map<char const*, size_t> m_StatIndices;
+
+	// capture
+	uint32 m_CaptureFramesLeft = 0u;
+	std::string m_CapturePath;
+	std::vector<ProfileEvent> m_CaptureEvents;
+	std::vector<uint64> m_CaptureFrameTimes;
+	bool m_HasCompletedCapture = false;
+};
+
+
+//---------------------------------
+// ProfileZone
+//
+// Measures the lifetime of the enclosing scope, use through the ET_PROFILE_ZONE macro
+//
+class ProfileZone final
+{
+public:
+	explicit ProfileZone(char const* const name) : m_Name(Profiler::IsActive() ? name : nullptr)
+	{
+		if (m_Name != nullptr)
+		{
+			Profiler::GetInstance()->EnterZone();
+			m_Start = Profiler::Now();
+		}
+	}
+
+	~ProfileZone()
+	{
+		if (m_Name != nullptr)
+		{
+			Profiler::GetInstance()->LeaveZone(m_Name, m_Start);
+		}
+	}
+
+	ProfileZone(ProfileZone const&) = delete;
+	ProfileZone& operator=(ProfileZone const&) = delete;
+
+private:
+	char const* const m_Name;
+	uint64 m_Start = 0u;
+};
+
+
+} // namespace core
+} // namespace et
+
+
+#if ET_PROFILER_ENABLED
+#	define ET_PROFILE_CONCAT_INNER(lhs, rhs) lhs##rhs
+#	define ET_PROFILE_CONCAT(lhs, rhs) ET_PROFILE_CONCAT_INNER(lhs, rhs)
+#	define ET_PROFILE_ZONE(name) et::core::ProfileZone const ET_PROFILE_CONCAT(etProfileZone, __LINE__)(name)
+#	define ET_PROFILE_FUNCTION() ET_PROFILE_ZONE(__FUNCTION__)
+#	define ET_PROFILE_THREAD(name) if (et::core::Profiler::IsActive()) { et::core::Profiler::GetInstance()->SetThreadName(name); }
+#else
+#	define ET_PROFILE_ZONE(name)
+#	define ET_PROFILE_FUNCTION()
+#	define ET_PROFILE_THREAD(name)
+#endif
@@ -1,10 +1,19 @@
 #pragma once
+#include <atomic>
+#include <mutex>
 
 
 namespace et {
 namespace core {
 
 
+//---------------------------------
+// Singleton
+//
+// Lazily created global instance
+//  - the first call to GetInstance may come from any thread, creation is guarded so only one instance is ever made
+//  - destruction is not synchronized and should happen once no other thread uses the instance anymore
+//
 template<class T>
 class Singleton
 {
@@ -12,29 +21,42 @@ public:
 	
 	static T* GetInstance()
 	{
-		if(!m_Instance)
+		T* instance = m_Instance.load(std::memory_order_acquire);
+		if (instance == nullptr)
 		{
-			m_Instance = new T();
+			std::lock_guard<std::mutex> lock(m_CreateMutex);
+
+			instance = m_Instance.load(std::memory_order_relaxed);
+			if (instance == nullptr)
+			{
+				instance = new T();
+				m_Instance.store(instance, std::memory_order_release);
+			}
 		}
 
-		return m_Instance;
+		return instance;
 	}
 
 	static void DestroyInstance()
 	{
-		if(m_Instance != 0)
+		T* const instance = m_Instance.load(std::memory_order_acquire);
+		if (instance != nullptr)
 		{
-			delete(m_Instance);
-			m_Instance = 0;
+			delete(instance); // the instance is still reachable while its destructor runs
+			m_Instance.store(nullptr, std::memory_order_release);
 		}
 	}
 
 private:
-	static T* m_Instance;
+	static std::atomic<T*> m_Instance;
+	static std::mutex m_CreateMutex;
 };
 
 template<class T> 
-T* Singleton<T>::m_Instance = nullptr;
+std::atomic<T*> Singleton<T>::m_Instance(nullptr);
+
+template<class T> 
+std::mutex Singleton<T>::m_CreateMutex;
 
 
 } // namespace core
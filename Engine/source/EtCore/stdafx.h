@@ -48,6 +48,7 @@ inline void SafeDelete(T &pObjectToDelete)
 #include <EtCore/Util/Time.h>
 #include <EtCore/Util/Logger.h>
 #include <EtCore/Util/PerformanceInfo.h>
+#include <EtCore/Util/Profiler.h>
 #include <EtCore/Util/StringUtil.h>
 #include <EtCore/Hashing/HashString.h>
 #include <EtCore/Reflection/ReflectionUtil.h>
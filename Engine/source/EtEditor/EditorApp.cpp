@@ -17,7 +17,10 @@
 
 #include <EtCore/Util/Commands.h>
 #include <EtCore/Util/InputManager.h>
+#include <EtCore/Util/Profiler.h>
 #include <EtCore/UpdateCycle/TickManager.h>
+#include <EtCore/Memory/FrameAllocator.h>
+#include <EtCore/Util/JobPool.h>
 
 #include <EtFramework/SceneGraph/UnifiedScene.h>
 
@@ -84,6 +87,7 @@ EditorApp::EditorApp()
 EditorApp::~EditorApp()
 {
 	core::PerformanceInfo::DestroyInstance();
+	core::Profiler::DestroyInstance();
 	core::InputManager::DestroyInstance();
 
 	EditorConfig::DestroyInstance();
@@ -92,6 +96,8 @@ EditorApp::~EditorApp()
 
 	core::Logger::Release();
 	core::TickManager::GetInstance()->DestroyInstance();
+	core::FrameAllocator::DestroyInstance();
+	core::JobPool::DestroyInstance();
 }
 
 //---------------------------------
@@ -234,6 +240,9 @@ void EditorApp::InitializeUtilities()
 	core::InputManager::GetInstance();
 
 	core::PerformanceInfo::GetInstance();
+
+	core::Profiler::GetInstance();
+	ET_PROFILE_THREAD("main");
 }
 
 //---------------------------------
@@ -3,6 +3,8 @@
 
 #include <rttr/registration>
 
+#include <EtCore/UpdateCycle/TickManager.h>
+
 #include <EtRendering/GraphicsTypes/Camera.h>
 
 #include <EtFramework/Systems/TransformSystem.h>
@@ -57,7 +59,7 @@ void EditorCameraSystem::Process(fw::ComponentRange<EditorCameraSystemView>& ran
 {
 	// common variables
 	core::InputManager* const input = core::InputManager::GetInstance();
-	float const dt = core::ContextManager::GetInstance()->GetActiveContext()->time->DeltaTime();
+	float const dt = core::TickManager::GetInstance()->GetFixedTimestep();
 
 	for (EditorCameraSystemView& view : range)
 	{
@@ -3,6 +3,8 @@
 
 #include <gtkmm/builder.h>
 
+#include <EtCore/UpdateCycle/TickManager.h>
+
 #include <EtRendering/SceneRendering/ShadedSceneRenderer.h>
 
 #include <EtFramework/SceneGraph/UnifiedScene.h>
@@ -246,9 +248,14 @@ void SceneViewport::OnEditorTick()
 {
 	fw::EcsController& ecs = fw::UnifiedScene::Instance().GetEcs();
 
-	ecs.GetComponent<fw::CameraComponent>(m_Camera).PopulateCamera(m_SceneRenderer->GetCamera(), 
-		*m_Viewport, 
-		ecs.GetComponent<fw::TransformComponent>(m_Camera));
+	vec3 camPosition;
+	quat camRotation;
+	fw::UnifiedScene::Instance().GetTransformInterpolator().Sample(ecs.GetComponent<fw::TransformComponent>(m_Camera),
+		core::TickManager::GetInstance()->GetInterpolationAlpha(),
+		camPosition,
+		camRotation);
+
+	ecs.GetComponent<fw::CameraComponent>(m_Camera).PopulateCamera(m_SceneRenderer->GetCamera(), *m_Viewport, camPosition, camRotation);
 }
 
 //------------------------------------
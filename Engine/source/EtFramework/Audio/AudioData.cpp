@@ -14,6 +14,30 @@ namespace et {
 namespace fw {
 
 
+namespace {
+
+	//---------------------------------
+	// GetFrameSize
+	//
+	// Size in bytes of one sample for every channel
+	//
+	ALsizei GetFrameSize(ALenum const format)
+	{
+		switch (format)
+		{
+		case AL_FORMAT_MONO8: return 1;
+		case AL_FORMAT_MONO16: return 2;
+		case AL_FORMAT_STEREO8: return 2;
+		case AL_FORMAT_STEREO16: return 4;
+		}
+
+		ET_ASSERT(false, "unhandled audio format");
+		return 1;
+	}
+
+} // namespace
+
+
 //===================
 // Audio Data
 //===================
@@ -24,8 +48,23 @@ namespace fw {
 //
 // Construct audio data from a handle
 //
-AudioData::AudioData(ALuint handle) 
+AudioData::AudioData(ALuint const handle, ALenum const format, ALsizei const frequency, float const duration)
 	: m_Buffer(handle)
+	, m_Format(format)
+	, m_Frequency(frequency)
+	, m_Duration(duration)
+{ }
+
+//---------------------------------
+// AudioData::c-tor
+//
+// Construct audio data for streaming from encoded content
+//
+AudioData::AudioData(std::vector<uint8>&& encodedData, ALenum const format, ALsizei const frequency, float const duration)
+	: m_EncodedData(std::move(encodedData))
+	, m_Format(format)
+	, m_Frequency(frequency)
+	, m_Duration(duration)
 { }
 
 //---------------------------------
@@ -35,7 +74,10 @@ AudioData::AudioData(ALuint handle)
 //
 AudioData::~AudioData()
 {
-	alDeleteBuffers(1, &m_Buffer);
+	if (m_Buffer != 0u)
+	{
+		alDeleteBuffers(1, &m_Buffer);
+	}
 }
 
 
@@ -49,6 +91,7 @@ RTTR_REGISTRATION
 {
 	BEGIN_REGISTER_POLYMORPHIC_CLASS(AudioAsset, "audio asset")
 		.property("force mono", &AudioAsset::m_IsMonoForced)
+		.property("stream", &AudioAsset::m_IsStreamed)
 	END_REGISTER_POLYMORPHIC_CLASS(AudioAsset, core::I_Asset);
 }
 DEFINE_FORCED_LINKING(AudioAsset) // force the asset class to be linked as it is only used in reflection
@@ -63,6 +106,23 @@ bool AudioAsset::LoadFromMemory(std::vector<uint8> const& data)
 {
 	std::string extension = core::FileUtil::ExtractExtension(GetName());
 
+	if (m_IsStreamed)
+	{
+		if (extension == "ogg")
+		{
+			if (!LoadOggStream(data))
+			{
+				LOG("AudioAsset::LoadFromMemory > Failed to load audio stream!", core::LogLevel::Warning);
+				return false;
+			}
+
+			return true;
+		}
+
+		LOG("AudioAsset::LoadFromMemory > Only ogg files can be streamed, '" + GetName() + std::string("' is loaded fully"),
+			core::LogLevel::Warning);
+	}
+
 	bool dataLoaded = false;
 	AudioBufferData bufferData;
 
@@ -103,7 +163,8 @@ bool AudioAsset::LoadFromMemory(std::vector<uint8> const& data)
 
 	delete[] bufferData.data;
 
-	m_Data = new AudioData(buffer);
+	float const duration = static_cast<float>(bufferData.size / GetFrameSize(bufferData.format)) / static_cast<float>(bufferData.frequency);
+	m_Data = new AudioData(buffer, bufferData.format, bufferData.frequency, duration);
 
 	// all done
 	return true;
@@ -255,6 +316,35 @@ bool AudioAsset::LoadOggFile(AudioBufferData &bufferData, std::vector<uint8> con
 	return true;
 }
 
+//---------------------------------
+// AudioAsset::LoadOggStream
+//
+// Validate an OGG Vorbis file and keep it encoded - forcing mono is handled by the stream mixing down while decoding
+//
+bool AudioAsset::LoadOggStream(std::vector<uint8> const& binaryContent)
+{
+	int e = 0;
+	stb_vorbis* vorbis = stb_vorbis_open_memory(binaryContent.data(), (int)binaryContent.size(), &e, NULL);
+	if (!vorbis) return false;
+
+	stb_vorbis_info const info = stb_vorbis_get_info(vorbis);
+	float const duration = stb_vorbis_stream_length_in_seconds(vorbis);
+	stb_vorbis_close(vorbis);
+
+	ALenum format;
+	switch (info.channels)
+	{
+	case 1: format = AL_FORMAT_MONO16; break;
+	case 2: format = m_IsMonoForced ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16; break;
+	default:
+		LOG(std::string("Only mono and stereo supported by openAL, numChannels: ") + std::to_string(info.channels), core::LogLevel::Warning);
+		return false;
+	}
+
+	m_Data = new AudioData(std::vector<uint8>(binaryContent), format, static_cast<ALsizei>(info.sample_rate), duration);
+	return true;
+}
+
 //---------------------------------
 // AudioAsset::ConvertToMono
 //
@@ -14,17 +14,31 @@ namespace fw {
 // AudioData
 //
 // Minimal data required for openAL to play a sound effect
+//  - streamed tracks keep their encoded file content instead of a buffer, and are decoded by an AudioStream while they play
 //
 class AudioData final
 {
 public:
-	AudioData(ALuint handle);
+	AudioData(ALuint const handle, ALenum const format, ALsizei const frequency, float const duration);
+	AudioData(std::vector<uint8>&& encodedData, ALenum const format, ALsizei const frequency, float const duration);
 	virtual ~AudioData();
 
 	ALuint GetHandle() const { return m_Buffer; }
 
+	bool IsStreamed() const { return !m_EncodedData.empty(); }
+	std::vector<uint8> const& GetEncodedData() const { return m_EncodedData; }
+
+	ALenum GetFormat() const { return m_Format; }
+	ALsizei GetFrequency() const { return m_Frequency; }
+	float GetDuration() const { return m_Duration; }
+
 private:
 	ALuint m_Buffer = 0u;
+	std::vector<uint8> m_EncodedData; // ogg vorbis
+
+	ALenum m_Format = AL_NONE;
+	ALsizei m_Frequency = 0;
+	float m_Duration = 0.f; // seconds
 };
 
 //---------------------------------
@@ -68,6 +82,7 @@ private:
 
 	bool LoadWavFile(AudioBufferData &bufferData, std::vector<uint8> const& binaryContent);
 	bool LoadOggFile(AudioBufferData &bufferData, std::vector<uint8> const& binaryContent);
+	bool LoadOggStream(std::vector<uint8> const& binaryContent);
 
 	void ConvertToMono(AudioBufferData &bufferData);
 
@@ -78,6 +93,7 @@ private:
 	///////
 public:
 	bool m_IsMonoForced = false;
+	bool m_IsStreamed = false; // decode while playing instead of on load, for long ogg tracks
 
 	RTTR_ENABLE(core::Asset<AudioData, false>)
 };
@@ -47,6 +47,8 @@ void AudioManager::Initialize()
 		return;
 	}
 	LOG("OpenAL loaded\n");
+
+	m_VoiceManager.Initialize(AudioVoiceManager::s_DefaultSourceCount);
 }
 
 bool AudioManager::TestALError(std::string error)
@@ -88,6 +90,8 @@ void AudioManager::MakeContextCurrent()
 
 AudioManager::~AudioManager()
 {
+	m_VoiceManager.Deinit();
+
 	m_Device = alcGetContextsDevice(m_Context);
 	alcMakeContextCurrent(NULL);
 	alcDestroyContext(m_Context);
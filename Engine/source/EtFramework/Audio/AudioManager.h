@@ -4,6 +4,8 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 
+#include "AudioVoiceManager.h"
+
 
 namespace et {
 namespace fw {
@@ -20,12 +22,16 @@ public:
 
 	void MakeContextCurrent();
 
+	AudioVoiceManager& GetVoiceManager() { return m_VoiceManager; }
+
 private:
 	void ListAudioDevices(const ALCchar *devices);
 
 	ALCdevice* m_Device;
 	ALCcontext *m_Context;
 
+	AudioVoiceManager m_VoiceManager;
+
 private:
 	friend class core::Singleton<AudioManager>;
 	AudioManager() {}
@@ -0,0 +1,385 @@
+#include "stdafx.h"
+#include "AudioStream.h"
+
+#include "AudioData.h"
+#include "AudioManager.h"
+#include "AudioStreamer.h"
+
+#include <stb_vorbis.h>
+
+
+namespace et {
+namespace fw {
+
+
+//=======================
+// Audio Stream Decoder
+//=======================
+
+
+//---------------------------------
+// AudioStream::Decoder::c-tor
+//
+// Open the encoded track, stereo tracks are mixed down by the decoder if the data is mono
+//
+AudioStream::Decoder::Decoder(AudioData const& data, uint32 const startFrame, bool const isLooping)
+	: m_ReadIdx(0u)
+	, m_WriteIdx(0u)
+	, m_IsLooping(isLooping)
+	, m_IsEndReached(false)
+{
+	std::vector<uint8> const& encoded = data.GetEncodedData();
+
+	int e = 0;
+	m_Vorbis = stb_vorbis_open_memory(encoded.data(), static_cast<int>(encoded.size()), &e, NULL);
+	if (m_Vorbis == nullptr)
+	{
+		LOG("AudioStream::Decoder::c-tor > Failed to open vorbis stream", core::LogLevel::Warning);
+		m_IsEndReached = true;
+		return;
+	}
+
+	m_Channels = (data.GetFormat() == AL_FORMAT_MONO16) ? 1u : 2u;
+	m_ChunkFrames = std::max(static_cast<uint32>(static_cast<float>(data.GetFrequency()) * s_ChunkDuration), 1u);
+	m_TotalFrames = stb_vorbis_stream_length_in_samples(m_Vorbis);
+
+	m_Chunks.resize(s_BufferCount, std::vector<ALshort>(m_ChunkFrames * m_Channels));
+	m_ChunkFrameCounts.resize(s_BufferCount, 0u);
+
+	uint32 seekFrame = startFrame;
+	if ((m_TotalFrames > 0u) && (seekFrame >= m_TotalFrames))
+	{
+		if (!isLooping)
+		{
+			m_IsEndReached = true;
+			return;
+		}
+
+		seekFrame %= m_TotalFrames;
+	}
+
+	if (seekFrame > 0u)
+	{
+		stb_vorbis_seek(m_Vorbis, seekFrame);
+	}
+}
+
+//---------------------------------
+// AudioStream::Decoder::d-tor
+//
+AudioStream::Decoder::~Decoder()
+{
+	if (m_Vorbis != nullptr)
+	{
+		stb_vorbis_close(m_Vorbis);
+	}
+}
+
+//---------------------------------
+// AudioStream::Decoder::DecodeChunk
+//
+// Decode the next chunk if the ring has space, returns true if a chunk was added
+//  - at the end of the track the decoder starts over if it loops, so chunks can span the loop point
+//
+bool AudioStream::Decoder::DecodeChunk()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	if (m_IsCancelled || m_IsEndReached)
+	{
+		return false;
+	}
+
+	uint32 const writeIdx = m_WriteIdx.load(std::memory_order_relaxed);
+	if (writeIdx - m_ReadIdx.load(std::memory_order_acquire) >= static_cast<uint32>(s_BufferCount))
+	{
+		return false;
+	}
+
+	ET_PROFILE_ZONE("AudioStream::Decoder::DecodeChunk");
+
+	size_t const slot = static_cast<size_t>(writeIdx) % s_BufferCount;
+	std::vector<ALshort>& chunk = m_Chunks[slot];
+
+	uint32 frames = 0u;
+	bool isEnd = false;
+	bool hasRestarted = false; // guards against tracks without any samples
+	while (frames < m_ChunkFrames)
+	{
+		int32 const decoded = stb_vorbis_get_samples_short_interleaved(m_Vorbis,
+			static_cast<int>(m_Channels),
+			chunk.data() + frames * m_Channels,
+			static_cast<int>((m_ChunkFrames - frames) * m_Channels));
+
+		if (decoded > 0)
+		{
+			frames += static_cast<uint32>(decoded);
+			hasRestarted = false;
+			continue;
+		}
+
+		if (!m_IsLooping || hasRestarted)
+		{
+			isEnd = true;
+			break;
+		}
+
+		stb_vorbis_seek_start(m_Vorbis);
+		hasRestarted = true;
+	}
+
+	if (frames > 0u)
+	{
+		m_ChunkFrameCounts[slot] = frames;
+		m_WriteIdx.store(writeIdx + 1u, std::memory_order_release);
+	}
+
+	if (isEnd)
+	{
+		m_IsEndReached.store(true, std::memory_order_release);
+	}
+
+	return (frames > 0u);
+}
+
+//---------------------------------
+// AudioStream::Decoder::Cancel
+//
+// After this returns the decoder doesn't touch the encoded data anymore
+//
+void AudioStream::Decoder::Cancel()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_IsCancelled = true;
+}
+
+//---------------------------------
+// AudioStream::Decoder::HasChunk
+//
+bool AudioStream::Decoder::HasChunk() const
+{
+	return m_ReadIdx.load(std::memory_order_relaxed) != m_WriteIdx.load(std::memory_order_acquire);
+}
+
+//---------------------------------
+// AudioStream::Decoder::GetChunk
+//
+// Oldest decoded chunk, only valid if there is one
+//
+std::vector<ALshort> const& AudioStream::Decoder::GetChunk() const
+{
+	ET_ASSERT(HasChunk());
+	return m_Chunks[static_cast<size_t>(m_ReadIdx.load(std::memory_order_relaxed)) % s_BufferCount];
+}
+
+//---------------------------------
+// AudioStream::Decoder::GetChunkFrames
+//
+uint32 AudioStream::Decoder::GetChunkFrames() const
+{
+	ET_ASSERT(HasChunk());
+	return m_ChunkFrameCounts[static_cast<size_t>(m_ReadIdx.load(std::memory_order_relaxed)) % s_BufferCount];
+}
+
+//---------------------------------
+// AudioStream::Decoder::PopChunk
+//
+// Hand the oldest chunk back to the producer
+//
+void AudioStream::Decoder::PopChunk()
+{
+	ET_ASSERT(HasChunk());
+	m_ReadIdx.store(m_ReadIdx.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+}
+
+//---------------------------------
+// AudioStream::Decoder::IsEndReached
+//
+// True once the whole track has been decoded and consumed
+//
+bool AudioStream::Decoder::IsEndReached() const
+{
+	return m_IsEndReached.load(std::memory_order_acquire) && !HasChunk();
+}
+
+
+//==============
+// Audio Stream
+//==============
+
+
+// static
+size_t const AudioStream::s_BufferCount = 4u;
+float const AudioStream::s_ChunkDuration = 0.25f;
+
+
+//---------------------------------
+// AudioStream::c-tor
+//
+// The first chunk is decoded right away, so that playback can start without waiting for the streamer thread
+//
+AudioStream::AudioStream(AudioStreamer& streamer, AudioData const& data, float const offset, bool const isLooping)
+	: m_Streamer(streamer)
+	, m_Format(data.GetFormat())
+	, m_Frequency(data.GetFrequency())
+{
+	ET_ASSERT(data.IsStreamed());
+
+	uint32 const startFrame = static_cast<uint32>(std::max(offset, 0.f) * static_cast<float>(m_Frequency));
+	m_Decoder = std::make_shared<Decoder>(data, startFrame, isLooping);
+	m_PlayedFrames = static_cast<uint64>(startFrame);
+
+	m_Buffers.resize(s_BufferCount);
+	alGenBuffers(static_cast<ALsizei>(s_BufferCount), m_Buffers.data());
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL gen stream buffers error"));
+
+	m_FreeBuffers = m_Buffers;
+
+	m_Decoder->DecodeChunk();
+	m_Streamer.Register(m_Decoder);
+}
+
+//---------------------------------
+// AudioStream::d-tor
+//
+AudioStream::~AudioStream()
+{
+	m_Decoder->Cancel();
+	m_Streamer.Unregister(m_Decoder.get());
+
+	ET_ASSERT(m_QueuedFrames.empty(), "audio streams should be detached from their source before being destroyed");
+
+	alDeleteBuffers(static_cast<ALsizei>(m_Buffers.size()), m_Buffers.data());
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL delete stream buffers error"));
+}
+
+//---------------------------------
+// AudioStream::Attach
+//
+// Start queueing buffers on a source, playback starts with the next update
+//
+void AudioStream::Attach(ALuint const source)
+{
+	alSourcei(source, AL_LOOPING, AL_FALSE);
+	alSourcei(source, AL_BUFFER, AL_NONE);
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL stream attach error"));
+
+	QueueChunks(source);
+}
+
+//---------------------------------
+// AudioStream::Detach
+//
+// Stop the source and release all of its queued buffers
+//
+void AudioStream::Detach(ALuint const source)
+{
+	alSourceStop(source);
+	alSourcei(source, AL_BUFFER, AL_NONE);
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL stream detach error"));
+
+	m_FreeBuffers = m_Buffers;
+	m_QueuedFrames.clear();
+}
+
+//---------------------------------
+// AudioStream::Update
+//
+// Recycle played buffers and queue newly decoded chunks, returns false once the track played to the end
+//  - if the streamer fell behind the source runs dry and stops, in which case it is restarted as soon as there is data again
+//
+bool AudioStream::Update(ALuint const source)
+{
+	ALint processed = 0;
+	alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+
+	for (ALint bufferIdx = 0; bufferIdx < processed; ++bufferIdx)
+	{
+		ALuint buffer;
+		alSourceUnqueueBuffers(source, 1, &buffer);
+		m_FreeBuffers.push_back(buffer);
+
+		ET_ASSERT(!m_QueuedFrames.empty());
+		m_PlayedFrames += static_cast<uint64>(m_QueuedFrames.front());
+		m_QueuedFrames.pop_front();
+	}
+
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL stream unqueue error"));
+
+	QueueChunks(source);
+
+	if (m_QueuedFrames.empty())
+	{
+		return !m_Decoder->IsEndReached();
+	}
+
+	ALint state;
+	alGetSourcei(source, AL_SOURCE_STATE, &state);
+	if (state != AL_PLAYING)
+	{
+		alSourcePlay(source);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL stream play error"));
+	}
+
+	return true;
+}
+
+//---------------------------------
+// AudioStream::GetPlaybackTime
+//
+// Seconds into the track, the sample offset of a source with a queue is relative to the first buffer in the queue
+//
+float AudioStream::GetPlaybackTime(ALuint const source) const
+{
+	ALint offset = 0;
+	if (!m_QueuedFrames.empty())
+	{
+		alGetSourcei(source, AL_SAMPLE_OFFSET, &offset);
+	}
+
+	uint64 frames = m_PlayedFrames + static_cast<uint64>(std::max(offset, 0));
+
+	uint32 const totalFrames = m_Decoder->GetTotalFrames();
+	if (totalFrames > 0u)
+	{
+		frames %= static_cast<uint64>(totalFrames);
+	}
+
+	return static_cast<float>(frames) / static_cast<float>(m_Frequency);
+}
+
+//---------------------------------
+// AudioStream::QueueChunks
+//
+// Fill free buffers with decoded chunks and queue them, and let the streamer know that there is space for more
+//
+void AudioStream::QueueChunks(ALuint const source)
+{
+	bool hasConsumed = false;
+
+	while (!m_FreeBuffers.empty() && m_Decoder->HasChunk())
+	{
+		ALuint const buffer = m_FreeBuffers.back();
+		m_FreeBuffers.pop_back();
+
+		uint32 const frames = m_Decoder->GetChunkFrames();
+		ALsizei const size = static_cast<ALsizei>(frames * m_Decoder->GetChannels() * sizeof(ALshort));
+
+		alBufferData(buffer, m_Format, m_Decoder->GetChunk().data(), size, m_Frequency);
+		alSourceQueueBuffers(source, 1, &buffer);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL stream queue error"));
+
+		m_QueuedFrames.push_back(frames);
+		m_Decoder->PopChunk();
+		hasConsumed = true;
+	}
+
+	if (hasConsumed)
+	{
+		m_Streamer.Wake();
+	}
+}
+
+
+} // namespace fw
+} // namespace et
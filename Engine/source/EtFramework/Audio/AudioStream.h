@@ -0,0 +1,129 @@
+#pragma once
+#include <AL/al.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+
+struct stb_vorbis;
+
+
+namespace et {
+namespace fw {
+
+
+class AudioData;
+class AudioStreamer;
+
+
+//---------------------------------
+// AudioStream
+//
+// Plays a streamed audio track on a source through a small ring of queued buffers
+//  - chunks are decoded ahead of playback by the audio streamer thread, buffers are filled and queued on the main thread
+//  - looping is done by decoding from the start again, the source itself never loops
+//  - the audio data has to outlive the stream, and the stream has to be detached from its source before it is destroyed
+//
+class AudioStream final
+{
+	// definitions
+	//-------------
+public:
+	static size_t const s_BufferCount;
+	static float const s_ChunkDuration; // seconds of audio per buffer
+
+	//---------------------------------
+	// AudioStream::Decoder
+	//
+	// Decodes chunks of a track into a single producer (streamer thread) single consumer (main thread) ring
+	//
+	class Decoder final
+	{
+	public:
+		Decoder(AudioData const& data, uint32 const startFrame, bool const isLooping);
+		~Decoder();
+
+		Decoder(Decoder const&) = delete;
+		Decoder& operator=(Decoder const&) = delete;
+
+		// producer
+		bool DecodeChunk();
+
+		// consumer
+		void Cancel();
+		void SetLooping(bool const isLooping) { m_IsLooping = isLooping; }
+
+		bool HasChunk() const;
+		std::vector<ALshort> const& GetChunk() const;
+		uint32 GetChunkFrames() const;
+		void PopChunk();
+
+		bool IsEndReached() const;
+
+		uint8 GetChannels() const { return m_Channels; }
+		uint32 GetTotalFrames() const { return m_TotalFrames; }
+
+	private:
+		std::mutex m_Mutex; // held while decoding, so that cancelling waits for the decoder to let go of the encoded data
+		stb_vorbis* m_Vorbis = nullptr;
+		bool m_IsCancelled = false;
+
+		uint8 m_Channels = 0u;
+		uint32 m_ChunkFrames = 0u;
+		uint32 m_TotalFrames = 0u;
+
+		std::vector<std::vector<ALshort>> m_Chunks;
+		std::vector<uint32> m_ChunkFrameCounts;
+		std::atomic<uint32> m_ReadIdx;
+		std::atomic<uint32> m_WriteIdx;
+
+		std::atomic<bool> m_IsLooping;
+		std::atomic<bool> m_IsEndReached;
+	};
+
+	// construct destruct
+	//--------------------
+	AudioStream(AudioStreamer& streamer, AudioData const& data, float const offset, bool const isLooping);
+	~AudioStream();
+
+	AudioStream(AudioStream const&) = delete;
+	AudioStream& operator=(AudioStream const&) = delete;
+
+	// functionality
+	//---------------
+	void Attach(ALuint const source);
+	void Detach(ALuint const source);
+
+	bool Update(ALuint const source);
+
+	void SetLooping(bool const isLooping) { m_Decoder->SetLooping(isLooping); }
+
+	// accessors
+	//-----------
+	float GetPlaybackTime(ALuint const source) const;
+
+	// utility
+	//---------
+private:
+	void QueueChunks(ALuint const source);
+
+	// Data
+	///////
+
+	AudioStreamer& m_Streamer;
+	std::shared_ptr<Decoder> m_Decoder;
+
+	ALenum m_Format = AL_NONE;
+	ALsizei m_Frequency = 0;
+
+	std::vector<ALuint> m_Buffers;
+	std::vector<ALuint> m_FreeBuffers;
+	std::deque<uint32> m_QueuedFrames; // per queued buffer, in queue order
+
+	uint64 m_PlayedFrames = 0u; // frames of unqueued buffers, including the start offset
+};
+
+
+} // namespace fw
+} // namespace et
@@ -0,0 +1,142 @@
+#include "stdafx.h"
+#include "AudioStreamer.h"
+
+
+namespace et {
+namespace fw {
+
+
+//================
+// Audio Streamer
+//================
+
+
+// static
+std::chrono::milliseconds const AudioStreamer::s_MaxSleep(50);
+
+
+//---------------------------------
+// AudioStreamer::d-tor
+//
+AudioStreamer::~AudioStreamer()
+{
+	Stop();
+}
+
+//---------------------------------
+// AudioStreamer::Register
+//
+// Start decoding for a stream, the decoder is kept alive while the thread works on it
+//
+void AudioStreamer::Register(std::shared_ptr<AudioStream::Decoder> const& decoder)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_Decoders.push_back(decoder);
+		m_HasWork = true;
+
+		if (!m_Thread.joinable())
+		{
+			m_IsStopping = false;
+			m_Thread = std::thread(&AudioStreamer::Run, this);
+		}
+	}
+
+	m_Condition.notify_one();
+}
+
+//---------------------------------
+// AudioStreamer::Unregister
+//
+// The decoder should be cancelled first, so that the thread stops using it even if it still holds a reference
+//
+void AudioStreamer::Unregister(AudioStream::Decoder const* const decoder)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	auto const foundIt = std::find_if(m_Decoders.begin(), m_Decoders.end(), [decoder](std::shared_ptr<AudioStream::Decoder> const& registered)
+		{
+			return registered.get() == decoder;
+		});
+
+	if (foundIt != m_Decoders.end())
+	{
+		m_Decoders.erase(foundIt);
+	}
+}
+
+//---------------------------------
+// AudioStreamer::Wake
+//
+// Let the thread know that chunks were consumed
+//
+void AudioStreamer::Wake()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_HasWork = true;
+	}
+
+	m_Condition.notify_one();
+}
+
+//---------------------------------
+// AudioStreamer::Stop
+//
+void AudioStreamer::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_IsStopping = true;
+	}
+
+	m_Condition.notify_one();
+	if (m_Thread.joinable())
+	{
+		m_Thread.join();
+	}
+}
+
+//---------------------------------
+// AudioStreamer::Run
+//
+// Decode one chunk per stream at a time, so that a stream with an empty ring doesn't wait for others to fill theirs
+//
+void AudioStreamer::Run()
+{
+	ET_PROFILE_THREAD("audio streamer");
+
+	std::vector<std::shared_ptr<AudioStream::Decoder>> decoders;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait_for(lock, s_MaxSleep, [this]() { return m_IsStopping || m_HasWork; });
+
+			if (m_IsStopping)
+			{
+				return;
+			}
+
+			m_HasWork = false;
+			decoders = m_Decoders;
+		}
+
+		bool hasDecoded = true;
+		while (hasDecoded)
+		{
+			hasDecoded = false;
+			for (std::shared_ptr<AudioStream::Decoder> const& decoder : decoders)
+			{
+				hasDecoded |= decoder->DecodeChunk();
+			}
+		}
+
+		decoders.clear();
+	}
+}
+
+
+} // namespace fw
+} // namespace et
@@ -0,0 +1,62 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "AudioStream.h"
+
+
+namespace et {
+namespace fw {
+
+
+//---------------------------------
+// AudioStreamer
+//
+// Background thread that keeps the decoders of all playing audio streams topped up
+//  - it sleeps until a stream consumed chunks, with a timeout in case a wake up was missed
+//  - the thread is started with the first stream, and lives until the streamer is stopped
+//
+class AudioStreamer final
+{
+	// definitions
+	//-------------
+	static std::chrono::milliseconds const s_MaxSleep;
+
+	// construct destruct
+	//--------------------
+public:
+	AudioStreamer() = default;
+	~AudioStreamer();
+
+	AudioStreamer(AudioStreamer const&) = delete;
+	AudioStreamer& operator=(AudioStreamer const&) = delete;
+
+	// functionality
+	//---------------
+	void Register(std::shared_ptr<AudioStream::Decoder> const& decoder);
+	void Unregister(AudioStream::Decoder const* const decoder);
+
+	void Wake();
+	void Stop();
+
+	// utility
+	//---------
+private:
+	void Run();
+
+	// Data
+	///////
+
+	std::thread m_Thread;
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+
+	std::vector<std::shared_ptr<AudioStream::Decoder>> m_Decoders;
+	bool m_HasWork = false;
+	bool m_IsStopping = false;
+};
+
+
+} // namespace fw
+} // namespace et
@@ -0,0 +1,616 @@
+#include "stdafx.h"
+#include "AudioVoiceManager.h"
+
+#include "AudioData.h"
+#include "AudioManager.h"
+
+
+namespace et {
+namespace fw {
+
+
+//=====================
+// Audio Voice Manager
+//=====================
+
+
+// static
+AudioVoiceManager::T_VoiceId const AudioVoiceManager::INVALID_VOICE = core::INVALID_SLOT_ID;
+size_t const AudioVoiceManager::s_DefaultSourceCount = 32u;
+float const AudioVoiceManager::s_RealVoiceBias = 1.1f;
+
+
+//---------------------------------
+// AudioVoiceManager::ComputeAttenuation
+//
+// Distance attenuation as openAL computes it for each distance model
+//
+float AudioVoiceManager::ComputeAttenuation(ALenum const distanceModel,
+	float const distance,
+	float const referenceDistance,
+	float const rolloffFactor,
+	float const maxDistance)
+{
+	float dist = distance;
+	switch (distanceModel)
+	{
+	case AL_INVERSE_DISTANCE_CLAMPED:
+	case AL_LINEAR_DISTANCE_CLAMPED:
+	case AL_EXPONENT_DISTANCE_CLAMPED:
+		dist = std::min(std::max(dist, referenceDistance), maxDistance);
+		break;
+	}
+
+	switch (distanceModel)
+	{
+	case AL_INVERSE_DISTANCE:
+	case AL_INVERSE_DISTANCE_CLAMPED:
+		{
+			float const denominator = referenceDistance + rolloffFactor * (dist - referenceDistance);
+			return (denominator > 0.f) ? (referenceDistance / denominator) : 1.f;
+		}
+
+	case AL_LINEAR_DISTANCE:
+	case AL_LINEAR_DISTANCE_CLAMPED:
+		{
+			if (maxDistance <= referenceDistance)
+			{
+				return 1.f;
+			}
+
+			dist = std::min(dist, maxDistance);
+			return std::max(1.f - rolloffFactor * (dist - referenceDistance) / (maxDistance - referenceDistance), 0.f);
+		}
+
+	case AL_EXPONENT_DISTANCE:
+	case AL_EXPONENT_DISTANCE_CLAMPED:
+		{
+			if ((dist <= 0.f) || (referenceDistance <= 0.f))
+			{
+				return 1.f;
+			}
+
+			return std::pow(dist / referenceDistance, -rolloffFactor);
+		}
+	}
+
+	return 1.f; // AL_NONE
+}
+
+//---------------------------------
+// AudioVoiceManager::d-tor
+//
+AudioVoiceManager::~AudioVoiceManager()
+{
+	Deinit();
+}
+
+//---------------------------------
+// AudioVoiceManager::Initialize
+//
+// Generate up to maxSources sources, or as many as the device supports
+//
+void AudioVoiceManager::Initialize(size_t const maxSources)
+{
+	ET_ASSERT(m_Sources.empty());
+
+	alGetError(); // clear errors from earlier calls so that they aren't mistaken for running out of sources
+	for (size_t sourceIdx = 0u; sourceIdx < maxSources; ++sourceIdx)
+	{
+		ALuint source = 0u;
+		alGenSources(1, &source);
+		if ((alGetError() != AL_NO_ERROR) || (source == 0u))
+		{
+			break;
+		}
+
+		m_Sources.push_back(source);
+	}
+
+	m_FreeSources = m_Sources;
+
+	LOG(FS("AudioVoiceManager::Initialize > %u sources available for voices", static_cast<uint32>(m_Sources.size())));
+}
+
+//---------------------------------
+// AudioVoiceManager::Deinit
+//
+void AudioVoiceManager::Deinit()
+{
+	for (Voice& voice : m_Voices)
+	{
+		if (voice.source != 0u)
+		{
+			MakeVirtual(voice);
+		}
+	}
+
+	m_Voices.clear();
+	m_Streamer.Stop();
+
+	if (!m_Sources.empty())
+	{
+		alDeleteSources(static_cast<ALsizei>(m_Sources.size()), m_Sources.data());
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL delete sources error"));
+	}
+
+	m_Sources.clear();
+	m_FreeSources.clear();
+}
+
+//---------------------------------
+// AudioVoiceManager::CreateVoice
+//
+// Relative voices are positioned relative to the listener, e.g for global sounds
+//
+AudioVoiceManager::T_VoiceId AudioVoiceManager::CreateVoice(bool const isRelative)
+{
+	Voice voice;
+	voice.isRelative = isRelative;
+
+	return m_Voices.insert(std::move(voice)).second;
+}
+
+//---------------------------------
+// AudioVoiceManager::DestroyVoice
+//
+void AudioVoiceManager::DestroyVoice(T_VoiceId const voice)
+{
+	Voice& data = m_Voices[voice];
+	if (data.source != 0u)
+	{
+		MakeVirtual(data);
+	}
+
+	m_Voices.erase(voice);
+}
+
+//---------------------------------
+// AudioVoiceManager::Update
+//
+// Hand out sources to the most audible playing voices
+//  - voices that finished playing are stopped, virtual voices advance their playback time
+//  - voices that lose their source are virtualized before sources are handed out, so that those can be reused in the same update
+//
+void AudioVoiceManager::Update(float const deltaTime)
+{
+	ET_PROFILE_FUNCTION();
+
+	ALenum distanceModel = AL_INVERSE_DISTANCE_CLAMPED;
+	vec3 listenerPos;
+	if (!m_Sources.empty())
+	{
+		distanceModel = alGetInteger(AL_DISTANCE_MODEL);
+		alGetListener3f(AL_POSITION, &listenerPos.x, &listenerPos.y, &listenerPos.z);
+	}
+
+	std::vector<Voice*> candidates;
+	for (Voice& voice : m_Voices)
+	{
+		if (voice.state != E_VoiceState::Playing)
+		{
+			continue;
+		}
+
+		if (voice.data == nullptr)
+		{
+			voice.state = E_VoiceState::Stopped;
+			continue;
+		}
+
+		// check whether the voice played to the end
+		//--------------------------------------------
+		bool hasFinished = false;
+		if (voice.source != 0u)
+		{
+			if (voice.stream != nullptr)
+			{
+				hasFinished = !(voice.stream->Update(voice.source));
+			}
+			else
+			{
+				ALint sourceState;
+				alGetSourcei(voice.source, AL_SOURCE_STATE, &sourceState);
+				hasFinished = (sourceState == AL_STOPPED);
+			}
+
+			if (hasFinished)
+			{
+				MakeVirtual(voice);
+			}
+		}
+		else
+		{
+			voice.playbackTime += deltaTime * voice.pitch;
+
+			float const duration = voice.data->GetDuration();
+			if (voice.playbackTime >= duration)
+			{
+				if (voice.isLooping && (duration > 0.f))
+				{
+					voice.playbackTime = std::fmod(voice.playbackTime, duration);
+				}
+				else
+				{
+					hasFinished = true;
+				}
+			}
+		}
+
+		if (hasFinished)
+		{
+			voice.state = E_VoiceState::Stopped;
+			voice.playbackTime = 0.f;
+			continue;
+		}
+
+		voice.audibility = ComputeAudibility(voice, distanceModel, listenerPos);
+		if (voice.source != 0u)
+		{
+			voice.audibility *= s_RealVoiceBias;
+		}
+
+		candidates.push_back(&voice);
+	}
+
+	// assign sources
+	//----------------
+	size_t const realCount = std::min(candidates.size(), m_Sources.size());
+	std::partial_sort(candidates.begin(), candidates.begin() + realCount, candidates.end(), [](Voice const* const lhs, Voice const* const rhs)
+		{
+			return lhs->audibility > rhs->audibility;
+		});
+
+	for (size_t candidateIdx = realCount; candidateIdx < candidates.size(); ++candidateIdx)
+	{
+		if (candidates[candidateIdx]->source != 0u)
+		{
+			MakeVirtual(*candidates[candidateIdx]);
+		}
+	}
+
+	for (size_t candidateIdx = 0u; candidateIdx < realCount; ++candidateIdx)
+	{
+		if (candidates[candidateIdx]->source == 0u)
+		{
+			MakeReal(*candidates[candidateIdx]);
+		}
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetTrack
+//
+// Changing the track starts it from the beginning, a paused voice is stopped
+//
+void AudioVoiceManager::SetTrack(T_VoiceId const voice, AudioData const* const data)
+{
+	Voice& target = m_Voices[voice];
+	if (target.data == data)
+	{
+		return;
+	}
+
+	if (target.source != 0u)
+	{
+		MakeVirtual(target);
+	}
+
+	target.data = data;
+	target.playbackTime = 0.f;
+
+	if (target.state == E_VoiceState::Paused)
+	{
+		target.state = E_VoiceState::Stopped;
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetState
+//
+// Playing voices get a source during the next update, paused and stopped voices give theirs up right away
+//
+void AudioVoiceManager::SetState(T_VoiceId const voice, E_VoiceState const state)
+{
+	Voice& target = m_Voices[voice];
+	if (target.state == state)
+	{
+		return;
+	}
+
+	if (target.source != 0u)
+	{
+		MakeVirtual(target);
+	}
+
+	if (state == E_VoiceState::Stopped)
+	{
+		target.playbackTime = 0.f;
+	}
+
+	target.state = state;
+}
+
+//---------------------------------
+// AudioVoiceManager::SetGain
+//
+void AudioVoiceManager::SetGain(T_VoiceId const voice, float const gain, float const minGain, float const maxGain)
+{
+	Voice& target = m_Voices[voice];
+	target.gain = gain;
+	target.minGain = minGain;
+	target.maxGain = maxGain;
+
+	if (target.source != 0u)
+	{
+		alSourcef(target.source, AL_GAIN, gain);
+		alSourcef(target.source, AL_MIN_GAIN, minGain);
+		alSourcef(target.source, AL_MAX_GAIN, maxGain);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source gain error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetPitch
+//
+void AudioVoiceManager::SetPitch(T_VoiceId const voice, float const pitch)
+{
+	Voice& target = m_Voices[voice];
+	target.pitch = pitch;
+
+	if (target.source != 0u)
+	{
+		alSourcef(target.source, AL_PITCH, pitch);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source pitch error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetLooping
+//
+// Streams loop by themselves, so their source never loops
+//
+void AudioVoiceManager::SetLooping(T_VoiceId const voice, bool const isLooping)
+{
+	Voice& target = m_Voices[voice];
+	if (target.isLooping == isLooping)
+	{
+		return;
+	}
+
+	target.isLooping = isLooping;
+
+	if (target.stream != nullptr)
+	{
+		target.stream->SetLooping(isLooping);
+	}
+	else if (target.source != 0u)
+	{
+		alSourcei(target.source, AL_LOOPING, (isLooping ? AL_TRUE : AL_FALSE));
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source looping error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetPosition
+//
+void AudioVoiceManager::SetPosition(T_VoiceId const voice, vec3 const& position)
+{
+	Voice& target = m_Voices[voice];
+	target.position = position;
+
+	if (target.source != 0u)
+	{
+		alSource3f(target.source, AL_POSITION, position.x, position.y, position.z);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source position error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetVelocity
+//
+void AudioVoiceManager::SetVelocity(T_VoiceId const voice, vec3 const& velocity)
+{
+	Voice& target = m_Voices[voice];
+	target.velocity = velocity;
+
+	if (target.source != 0u)
+	{
+		alSource3f(target.source, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source velocity error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetDirection
+//
+// A zero direction makes the voice omnidirectional
+//
+void AudioVoiceManager::SetDirection(T_VoiceId const voice, vec3 const& direction)
+{
+	Voice& target = m_Voices[voice];
+	target.direction = direction;
+
+	if (target.source != 0u)
+	{
+		alSource3f(target.source, AL_DIRECTION, direction.x, direction.y, direction.z);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source direction error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetDistance
+//
+// Parameters for distance attenuation
+//
+void AudioVoiceManager::SetDistance(T_VoiceId const voice, float const referenceDistance, float const rolloffFactor, float const maxDistance)
+{
+	Voice& target = m_Voices[voice];
+	target.referenceDistance = referenceDistance;
+	target.rolloffFactor = rolloffFactor;
+	target.maxDistance = maxDistance;
+
+	if (target.source != 0u)
+	{
+		alSourcef(target.source, AL_REFERENCE_DISTANCE, referenceDistance);
+		alSourcef(target.source, AL_ROLLOFF_FACTOR, rolloffFactor);
+		alSourcef(target.source, AL_MAX_DISTANCE, maxDistance);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source distance error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::SetCone
+//
+void AudioVoiceManager::SetCone(T_VoiceId const voice, float const innerAngle, float const outerAngle, float const outerGain)
+{
+	Voice& target = m_Voices[voice];
+	target.innerConeAngle = innerAngle;
+	target.outerConeAngle = outerAngle;
+	target.outerConeGain = outerGain;
+
+	if (target.source != 0u)
+	{
+		alSourcef(target.source, AL_CONE_INNER_ANGLE, innerAngle);
+		alSourcef(target.source, AL_CONE_OUTER_ANGLE, outerAngle);
+		alSourcef(target.source, AL_CONE_OUTER_GAIN, outerGain);
+		ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source cone error"));
+	}
+}
+
+//---------------------------------
+// AudioVoiceManager::GetPlaybackTime
+//
+float AudioVoiceManager::GetPlaybackTime(T_VoiceId const voice) const
+{
+	return ReadPlaybackTime(m_Voices[voice]);
+}
+
+//---------------------------------
+// AudioVoiceManager::ComputeAudibility
+//
+// Gain after attenuation, cones are ignored as they only matter while the voice is close
+//
+float AudioVoiceManager::ComputeAudibility(Voice const& voice, ALenum const distanceModel, vec3 const& listenerPos) const
+{
+	float const distance = voice.isRelative ? math::length(voice.position) : math::distance(voice.position, listenerPos);
+	float const attenuation = ComputeAttenuation(distanceModel, distance, voice.referenceDistance, voice.rolloffFactor, voice.maxDistance);
+
+	return std::min(std::max(voice.gain * attenuation, voice.minGain), voice.maxGain);
+}
+
+//---------------------------------
+// AudioVoiceManager::ReadPlaybackTime
+//
+// Real voices ask their source, so that the time doesn't drift from what was actually played
+//
+float AudioVoiceManager::ReadPlaybackTime(Voice const& voice) const
+{
+	if (voice.source == 0u)
+	{
+		return voice.playbackTime;
+	}
+
+	if (voice.stream != nullptr)
+	{
+		return voice.stream->GetPlaybackTime(voice.source);
+	}
+
+	float offset = 0.f;
+	alGetSourcef(voice.source, AL_SEC_OFFSET, &offset);
+	return offset;
+}
+
+//---------------------------------
+// AudioVoiceManager::MakeReal
+//
+// Play a voice on a free source from where its playback time is
+//
+void AudioVoiceManager::MakeReal(Voice& voice)
+{
+	ET_ASSERT(voice.source == 0u);
+	ET_ASSERT(!m_FreeSources.empty());
+	ET_ASSERT(voice.data != nullptr);
+
+	voice.source = m_FreeSources.back();
+	m_FreeSources.pop_back();
+
+	ApplySourceParams(voice);
+
+	if (voice.data->IsStreamed())
+	{
+		voice.stream = std::make_unique<AudioStream>(m_Streamer, *voice.data, voice.playbackTime, voice.isLooping);
+		voice.stream->Attach(voice.source);
+		voice.stream->Update(voice.source);
+	}
+	else
+	{
+		alSourcei(voice.source, AL_BUFFER, voice.data->GetHandle());
+		alSourcei(voice.source, AL_LOOPING, (voice.isLooping ? AL_TRUE : AL_FALSE));
+		alSourcef(voice.source, AL_SEC_OFFSET, voice.playbackTime);
+		alSourcePlay(voice.source);
+	}
+
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL make voice real error"));
+}
+
+//---------------------------------
+// AudioVoiceManager::MakeVirtual
+//
+// Remember where the voice is in its track and return its source to the pool
+//
+void AudioVoiceManager::MakeVirtual(Voice& voice)
+{
+	ET_ASSERT(voice.source != 0u);
+
+	voice.playbackTime = ReadPlaybackTime(voice);
+
+	if (voice.stream != nullptr)
+	{
+		voice.stream->Detach(voice.source);
+		voice.stream.reset();
+	}
+	else
+	{
+		alSourceStop(voice.source);
+		alSourcei(voice.source, AL_BUFFER, AL_NONE);
+	}
+
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL make voice virtual error"));
+
+	m_FreeSources.push_back(voice.source);
+	voice.source = 0u;
+}
+
+//---------------------------------
+// AudioVoiceManager::ApplySourceParams
+//
+// Sources are shared between voices, so every parameter is set when a voice gets one
+//
+void AudioVoiceManager::ApplySourceParams(Voice const& voice) const
+{
+	ALuint const source = voice.source;
+
+	alSourcef(source, AL_GAIN, voice.gain);
+	alSourcef(source, AL_MIN_GAIN, voice.minGain);
+	alSourcef(source, AL_MAX_GAIN, voice.maxGain);
+	alSourcef(source, AL_PITCH, voice.pitch);
+	alSourcei(source, AL_SOURCE_RELATIVE, (voice.isRelative ? AL_TRUE : AL_FALSE));
+
+	alSource3f(source, AL_POSITION, voice.position.x, voice.position.y, voice.position.z);
+	alSource3f(source, AL_VELOCITY, voice.velocity.x, voice.velocity.y, voice.velocity.z);
+	alSource3f(source, AL_DIRECTION, voice.direction.x, voice.direction.y, voice.direction.z);
+
+	alSourcef(source, AL_REFERENCE_DISTANCE, voice.referenceDistance);
+	alSourcef(source, AL_ROLLOFF_FACTOR, voice.rolloffFactor);
+	alSourcef(source, AL_MAX_DISTANCE, voice.maxDistance);
+	alSourcef(source, AL_CONE_INNER_ANGLE, voice.innerConeAngle);
+	alSourcef(source, AL_CONE_OUTER_ANGLE, voice.outerConeAngle);
+	alSourcef(source, AL_CONE_OUTER_GAIN, voice.outerConeGain);
+
+	ET_ASSERT(!AudioManager::GetInstance()->TestALError("AL source params error"));
+}
+
+
+} // namespace fw
+} // namespace et
@@ -0,0 +1,152 @@
+#pragma once
+#include <AL/al.h>
+
+#include <EtCore/Containers/slot_map.h>
+
+#include "AudioStreamer.h"
+
+
+namespace et {
+namespace fw {
+
+
+class AudioData;
+
+
+//---------------------------------
+// AudioVoiceManager
+//
+// Maps any number of voices onto a fixed pool of openAL sources
+//  - every update the most audible playing voices get a source, the others are virtual and only keep track of their playback time
+//  - audibility is the gain of a voice after distance attenuation with the distance model openAL uses
+//  - voices keep all of their source state, so a voice that becomes real again continues where it would have been
+//  - streamed tracks are decoded while they play by an audio stream per real voice
+//
+class AudioVoiceManager final
+{
+	// definitions
+	//-------------
+public:
+	typedef core::T_SlotId T_VoiceId;
+	static T_VoiceId const INVALID_VOICE;
+
+	static size_t const s_DefaultSourceCount;
+	static float const s_RealVoiceBias; // keeps voices with a source from swapping places with virtual voices that are about as audible
+
+	enum class E_VoiceState : uint8
+	{
+		Stopped,
+		Paused,
+		Playing
+	};
+
+private:
+	//---------------------------------
+	// AudioVoiceManager::Voice
+	//
+	// State of a logical source, positions are in openAL space
+	//
+	struct Voice
+	{
+		AudioData const* data = nullptr;
+		std::unique_ptr<AudioStream> stream;
+
+		float gain = 1.f;
+		float minGain = 0.f;
+		float maxGain = 1.f;
+		float pitch = 1.f;
+		bool isLooping = false;
+		bool isRelative = false;
+
+		vec3 position;
+		vec3 velocity;
+		vec3 direction;
+
+		float referenceDistance = 1.f;
+		float rolloffFactor = 1.f;
+		float maxDistance = std::numeric_limits<float>::max();
+		float innerConeAngle = 360.f;
+		float outerConeAngle = 360.f;
+		float outerConeGain = 0.f;
+
+		E_VoiceState state = E_VoiceState::Stopped;
+		float playbackTime = 0.f; // seconds into the track
+		ALuint source = 0u; // zero while the voice is virtual
+		float audibility = 0.f;
+	};
+
+	// static functionality
+	//----------------------
+public:
+	static float ComputeAttenuation(ALenum const distanceModel,
+		float const distance,
+		float const referenceDistance,
+		float const rolloffFactor,
+		float const maxDistance);
+
+	// construct destruct
+	//--------------------
+	AudioVoiceManager() = default;
+	~AudioVoiceManager();
+
+	AudioVoiceManager(AudioVoiceManager const&) = delete;
+	AudioVoiceManager& operator=(AudioVoiceManager const&) = delete;
+
+	void Initialize(size_t const maxSources);
+	void Deinit();
+
+	// functionality
+	//---------------
+	T_VoiceId CreateVoice(bool const isRelative);
+	void DestroyVoice(T_VoiceId const voice);
+
+	void Update(float const deltaTime);
+
+	// modifiers
+	//-----------
+	void SetTrack(T_VoiceId const voice, AudioData const* const data);
+	void SetState(T_VoiceId const voice, E_VoiceState const state);
+
+	void SetGain(T_VoiceId const voice, float const gain, float const minGain, float const maxGain);
+	void SetPitch(T_VoiceId const voice, float const pitch);
+	void SetLooping(T_VoiceId const voice, bool const isLooping);
+
+	void SetPosition(T_VoiceId const voice, vec3 const& position);
+	void SetVelocity(T_VoiceId const voice, vec3 const& velocity);
+	void SetDirection(T_VoiceId const voice, vec3 const& direction);
+	void SetDistance(T_VoiceId const voice, float const referenceDistance, float const rolloffFactor, float const maxDistance);
+	void SetCone(T_VoiceId const voice, float const innerAngle, float const outerAngle, float const outerGain);
+
+	// accessors
+	//-----------
+	E_VoiceState GetState(T_VoiceId const voice) const { return m_Voices[voice].state; }
+	bool IsVirtual(T_VoiceId const voice) const { return m_Voices[voice].source == 0u; }
+	float GetPlaybackTime(T_VoiceId const voice) const;
+
+	size_t GetSourceCount() const { return m_Sources.size(); }
+	size_t GetVoiceCount() const { return static_cast<size_t>(m_Voices.size()); }
+
+	// utility
+	//---------
+private:
+	float ComputeAudibility(Voice const& voice, ALenum const distanceModel, vec3 const& listenerPos) const;
+	float ReadPlaybackTime(Voice const& voice) const;
+
+	void MakeReal(Voice& voice);
+	void MakeVirtual(Voice& voice);
+	void ApplySourceParams(Voice const& voice) const;
+
+	// Data
+	///////
+
+	core::slot_map<Voice> m_Voices;
+
+	std::vector<ALuint> m_Sources;
+	std::vector<ALuint> m_FreeSources;
+
+	AudioStreamer m_Streamer;
+};
+
+
+} // namespace fw
+} // namespace et
@@ -1,8 +1,8 @@
 #pragma once
-#include <AL/al.h>
-
 #include <EtCore/Content/AssetPointer.h>
 
+#include <EtFramework/Audio/AudioVoiceManager.h>
+
 #include <EtFramework/SceneGraph/ComponentDescriptor.h>
 #include <EtFramework/ECS/EcsController.h>
 
@@ -18,6 +18,7 @@ class AudioData;
 // AudioSourceComponent
 //
 // Component that plays sound effects at the location of the entity
+//  - playback goes through a voice, which only has an openAL source while it is among the most audible ones
 //
 class AudioSourceComponent final
 {
@@ -28,12 +29,7 @@ class AudioSourceComponent final
 	friend class AudioSourceSystem;
 
 public:
-	enum class E_PlaybackState : uint8
-	{
-		Stopped,
-		Paused,
-		Playing
-	};
+	typedef AudioVoiceManager::E_VoiceState E_PlaybackState;
 
 	// construct destruct
 	//--------------------
@@ -59,7 +55,7 @@ public:
 
 private:
 	// handle
-	ALuint m_Source = 0u;
+	AudioVoiceManager::T_VoiceId m_Voice = AudioVoiceManager::INVALID_VOICE;
 
 	// sfx
 	AssetPtr<AudioData> m_AudioData;
@@ -38,11 +38,14 @@ ECS_REGISTER_COMPONENT(CameraComponent);
 //---------------------------------
 // CameraComponent::PopulateCamera
 //
-// fill out a render camera from the component
+// fill out a render camera from the component, viewing from a world position and rotation
+//  - the view transform should be sampled from the TransformInterpolator, so that the camera moves in phase with the scene it renders
 //
-void CameraComponent::PopulateCamera(render::Camera& target, render::Viewport const& viewport, TransformComponent const& tfComp) const
+void CameraComponent::PopulateCamera(render::Camera& target, render::Viewport const& viewport, vec3 const& position, quat const& rotation) const
 {
-	target.SetTransformation(tfComp.GetPosition(), tfComp.GetForward(), tfComp.GetUp(), true);
+	vec3 const forward = rotation * vec3::FORWARD;
+	vec3 const right = rotation * vec3::RIGHT;
+	target.SetTransformation(position, forward, math::cross(forward, right), true);
 
 	target.SetIsPerspective(true, true); // #todo: support ortho cameras
 	target.SetFieldOfView(m_FieldOfView, true);
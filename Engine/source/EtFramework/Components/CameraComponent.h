@@ -6,8 +6,6 @@
 namespace et { namespace render {
 	class Camera;
 	class Viewport;
-}  namespace fw {
-	class TransformComponent;
 } }
 
 
@@ -47,7 +45,7 @@ public:
 	void UsePerspectiveProjection() { m_IsPerspective = true; }
 	void UseOrthographicProjection() { m_IsPerspective = false; }
 
-	void PopulateCamera(render::Camera& target, render::Viewport const& viewport, TransformComponent const& tfComp) const;
+	void PopulateCamera(render::Camera& target, render::Viewport const& viewport, vec3 const& position, quat const& rotation) const;
 
 	// Data
 	///////
@@ -54,6 +54,8 @@ public:
 	void SetScale(float x, float y, float z);
 	void SetScale(const vec3& scale);
 
+	void SkipInterpolation() { m_IsInterpolated = false; } // the next change is shown immediately instead of blending from the previous state, e.g for teleports
+
 	// accessors
 	//-----------
 	const vec3& GetPosition() const { return m_Position; }
@@ -100,6 +102,7 @@ private:
 
 	T_TransformChanged m_TransformChanged = E_TransformChanged::None;
 	core::T_SlotId m_NodeId = core::INVALID_SLOT_ID;
+	bool m_IsInterpolated = false; // new components appear at their initial transform
 };
 
 
@@ -28,11 +28,25 @@ RTTR_REGISTRATION
 		.property("fullscreen resolution", &Config::Settings::Window::FullscreenRes)
 		.property("windowed resolution", &Config::Settings::Window::WindowedRes) ;
 
+	registration::class_<Config::Settings::Profiling>("profiling")
+		.constructor<>()
+		.property("enabled", &Config::Settings::Profiling::Enabled)
+		.property("capture frames", &Config::Settings::Profiling::CaptureFrames)
+		.property("capture file", &Config::Settings::Profiling::CaptureFile)
+		.property("exit after capture", &Config::Settings::Profiling::ExitAfterCapture) ;
+
+	registration::class_<Config::Settings::Physics>("physics")
+		.constructor<>()
+		.property("multithreaded", &Config::Settings::Physics::Multithreaded)
+		.property("thread count", &Config::Settings::Physics::ThreadCount) ;
+
 	registration::class_<Config::Settings>("settings")
 		.constructor<>()
 		.property("graphics", &Config::Settings::m_Graphics)
 		.property("window", &Config::Settings::m_Window)
-		.property("screenshot dir", &Config::Settings::m_ScreenshotDir);
+		.property("screenshot dir", &Config::Settings::m_ScreenshotDir)
+		.property("profiling", &Config::Settings::m_Profiling)
+		.property("physics", &Config::Settings::m_Physics);
 }
 
 
@@ -112,7 +126,7 @@ void Config::Initialize()
 //---------------------------------
 // Config::InitRenderConfig
 //
-// Pass the graphics settings to the rendering configuration
+// Pass the graphics settings to the rendering configuration, precomputed textures are cached in the user directory
 //
 void Config::InitRenderConfig()
 {
@@ -125,6 +139,8 @@ void Config::InitRenderConfig()
 		render::RenderingSystems::AddReference(m_Settings.m_Graphics);
 		m_HasRenderRef = true;
 	}
+
+	render::RenderingSystems::Instance()->GetPrecomputeCache().SetDirectory(GetUserDirPath() + render::PrecomputeCache::s_DirectoryName);
 }
 
 //---------------------------------
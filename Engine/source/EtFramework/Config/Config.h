@@ -66,9 +66,40 @@ public:
 			size_t WindowedRes;
 		};
 
+		//---------------------------------
+		// Config::Settings::Profiling
+		//
+		// Allows capturing a CPU trace of the first frames after the start scene is loaded, e.g for automated performance runs
+		//  - the profiler doesn't record anything unless it is enabled, or a capture is requested
+		//
+		struct Profiling
+		{
+			Profiling() = default;
+
+			bool Enabled = false;
+			uint32 CaptureFrames = 0u; // no capture if zero
+			std::string CaptureFile = "profile_trace.json"; // relative to the user directory
+			bool ExitAfterCapture = false;
+		};
+
+		//---------------------------------
+		// Config::Settings::Physics
+		//
+		// Whether physics worlds step on multiple threads
+		//
+		struct Physics
+		{
+			Physics() = default;
+
+			bool Multithreaded = false;
+			uint32 ThreadCount = 0u; // including the main thread, all hardware threads if zero
+		};
+
 		render::GraphicsSettings m_Graphics;
 		Window m_Window;
 		std::string m_ScreenshotDir;
+		Profiling m_Profiling;
+		Physics m_Physics;
 
 		RTTR_ENABLE()
 	};
@@ -92,6 +123,8 @@ public:
 	Settings::Window & GetWindow() { return m_Settings.m_Window; }
 
 	std::string const& GetScreenshotDir() const { return m_Settings.m_ScreenshotDir; }
+	Settings::Profiling const& GetProfiling() const { return m_Settings.m_Profiling; }
+	Settings::Physics const& GetPhysics() const { return m_Settings.m_Physics; }
 
 	// initialization
 	void Initialize();
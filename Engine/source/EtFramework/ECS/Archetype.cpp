@@ -94,11 +94,21 @@ T_EntityId Archetype::GetEntity(size_t const idx) const
 //
 size_t Archetype::AddEntity(T_EntityId const entity, std::vector<RawComponentPtr> const& components)
 {
-	ET_ASSERT(m_Signature.MatchesComponentsUnsorted(components));
+	return AddEntity(entity, components.data(), components.size());
+}
 
-	for (RawComponentPtr const& component : components)
+//----------------------
+// Archetype::AddEntity
+//
+// Version taking a raw list, so that callers can keep their component lists in scratch memory
+//
+size_t Archetype::AddEntity(T_EntityId const entity, RawComponentPtr const* const components, size_t const count)
+{
+	ET_ASSERT(m_Signature.MatchesComponentsUnsorted(components, count));
+
+	for (size_t compIdx = 0u; compIdx < count; ++compIdx)
 	{
-		m_ComponentPools[m_Mapping[component.typeIdx]].Append(component.data);
+		m_ComponentPools[m_Mapping[components[compIdx].typeIdx]].Append(components[compIdx].data);
 	}
 
 	size_t const idx = m_Entities.size();
@@ -151,6 +161,21 @@ void Archetype::Clear()
 	m_Entities.clear();
 }
 
+//-------------------------
+// Archetype::Reserve
+//
+// Make room for count entities in total in the entity list and all component pools
+//
+void Archetype::Reserve(size_t const count)
+{
+	for (ComponentPool& pool : m_ComponentPools)
+	{
+		pool.Reserve(count);
+	}
+
+	m_Entities.reserve(count);
+}
+
 
 } // namespace fw
 } // namespace et
@@ -36,8 +36,10 @@ public:
 	// functionality
 	//---------------
 	size_t AddEntity(T_EntityId const entity, std::vector<RawComponentPtr> const& components);
+	size_t AddEntity(T_EntityId const entity, RawComponentPtr const* const components, size_t const count);
 	T_EntityId RemoveEntity(size_t const idx);
 	void Clear();
+	void Reserve(size_t const count);
 
 	// Data
 	///////
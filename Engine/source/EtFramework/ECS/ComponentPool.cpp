@@ -104,6 +104,16 @@ void ComponentPool::Clear()
 	m_Buffer.clear();
 }
 
+//------------------------
+// ComponentPool::Reserve
+//
+// Make room for count components in total, so that appending up to that many doesn't grow the buffer
+//
+void ComponentPool::Reserve(size_t const count)
+{
+	m_Buffer.reserve(count * ComponentRegistry::Instance().GetSize(m_ComponentType));
+}
+
 
 } // namespace fw
 } // namespace et
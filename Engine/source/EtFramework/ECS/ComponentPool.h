@@ -39,6 +39,7 @@ public:
 
 	void Erase(size_t const idx); // swap with last element and pop_back
 	void Clear();
+	void Reserve(size_t const count);
 
 	// Data
 	///////
@@ -1,4 +1,5 @@
 #pragma once
+#include <EtCore/Memory/ScratchArena.h>
 
 
 namespace et {
@@ -54,6 +55,7 @@ public:
 	// iterator
 	//
 	// iterates over the component range. upon initialization, creates the view type and can only iterate forwards
+	//  - the view is created in the threads scratch arena, which requires an active ScratchScope
 	//
 	class iterator final
 	{
@@ -67,7 +69,7 @@ public:
 		//--------------------
 		iterator() = default;
 		iterator(BaseComponentRange* const range);
-		~iterator() { delete m_View; }
+		~iterator();
 
 		// functionality
 		//---------------
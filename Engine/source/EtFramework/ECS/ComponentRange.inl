@@ -14,14 +14,31 @@ namespace fw {
 // ComponentRange::iterator::c-tor
 //
 // Construct a new view of the range and use it to iterate
+//  - the view is only released by an enclosing scratch scope, so iterating without one would leak it
 //
 template<typename TViewType>
 ComponentRange<TViewType>::iterator::iterator(BaseComponentRange* const range)
-	: m_View(new TViewType())
 {
+	ET_ASSERT(core::IsScratchScopeActive(), "Component ranges should only be iterated within a ScratchScope");
+
+	m_View = core::GetScratchArena().New<TViewType>();
 	m_View->Init(range);
 }
 
+//---------------------------------
+// ComponentRange::iterator::d-tor
+//
+// Scratch memory is not released here, but by the scratch scope enclosing the iteration
+//
+template<typename TViewType>
+ComponentRange<TViewType>::iterator::~iterator()
+{
+	if (m_View != nullptr)
+	{
+		m_View->~TViewType();
+	}
+}
+
 //---------------------------------
 // ComponentRange::iterator:: ++
 //
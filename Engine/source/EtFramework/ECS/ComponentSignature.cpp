@@ -55,14 +55,22 @@ T_CompTypeIdx ComponentSignature::GetMaxComponentType() const
 //
 bool ComponentSignature::MatchesComponentsUnsorted(std::vector<RawComponentPtr> const& list) const
 {
-	if (m_Impl.size() != list.size())
+	return MatchesComponentsUnsorted(list.data(), list.size());
+}
+
+//-----------------------------------------------
+// ComponentSignature::MatchesComponentsUnsorted
+//
+bool ComponentSignature::MatchesComponentsUnsorted(RawComponentPtr const* const list, size_t const count) const
+{
+	if (m_Impl.size() != count)
 	{
 		return false;
 	}
 
-	for (RawComponentPtr const& data : list)
+	for (size_t idx = 0u; idx < count; ++idx)
 	{
-		if (std::find(m_Impl.cbegin(), m_Impl.cend(), data.typeIdx) == m_Impl.cend())
+		if (std::find(m_Impl.cbegin(), m_Impl.cend(), list[idx].typeIdx) == m_Impl.cend())
 		{
 			return false;
 		}
@@ -115,7 +123,17 @@ bool ComponentSignature::Contains(ComponentSignature const& other) const
 //
 T_Hash ComponentSignature::GenId() const
 {
-	return GetDataHash(reinterpret_cast<uint8 const*>(m_Impl.data()), m_Impl.size() * sizeof(T_CompTypeIdx));
+	return GenId(m_Impl.data(), m_Impl.size());
+}
+
+//----------------------------
+// ComponentSignature::GenId
+//
+// Static version allowing to look up archetypes without constructing a signature - types must be sorted
+//
+T_Hash ComponentSignature::GenId(T_CompTypeIdx const* const sortedTypes, size_t const count)
+{
+	return GetDataHash(reinterpret_cast<uint8 const*>(sortedTypes), count * sizeof(T_CompTypeIdx));
 }
 
 //-------------------------------
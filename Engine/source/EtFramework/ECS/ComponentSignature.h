@@ -26,9 +26,14 @@ public:
 	size_t GetSize() const { return m_Impl.size(); }
 	T_CompTypeIdx GetMaxComponentType() const;
 	bool MatchesComponentsUnsorted(std::vector<RawComponentPtr> const& list) const;
+	bool MatchesComponentsUnsorted(RawComponentPtr const* const list, size_t const count) const;
 	bool Contains(ComponentSignature const& other) const;
 	T_Hash GenId() const;
 
+	// utility
+	//---------
+	static T_Hash GenId(T_CompTypeIdx const* const sortedTypes, size_t const count);
+
 	// Data
 	///////
 
@@ -3,6 +3,8 @@
 #include "ComponentRange.h"
 #include "ComponentSignature.h"
 
+#include <EtCore/Memory/StlAllocators.h>
+
 
 namespace et {
 namespace fw {
@@ -26,6 +28,7 @@ enum class E_ComponentAccess : uint8
 // ComponentView
 //
 // Iteratable view of a selection of components
+//  - internal lists are allocated in the threads scratch arena, so views should only be created within a ScratchScope
 //
 class ComponentView
 {
@@ -159,10 +162,10 @@ protected:
 	///////
 
 private:
-	std::vector<Accessor> m_Accessors;
-	std::vector<Accessor> m_ParentAccessors;
-	std::vector<EcsController const**> m_ControllerPtrs;
-	T_CompTypeList m_Includes;
+	core::ScratchVector<Accessor> m_Accessors;
+	core::ScratchVector<Accessor> m_ParentAccessors;
+	core::ScratchVector<EcsController const**> m_ControllerPtrs;
+	core::ScratchVector<T_CompTypeIdx> m_Includes;
 	size_t m_Current = 0u;
 	BaseComponentRange* m_Range = nullptr;
 };
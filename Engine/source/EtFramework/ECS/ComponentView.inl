@@ -75,6 +75,7 @@ void ComponentView::Include()
 template<typename TViewType>
 ComponentSignature SignatureFromView()
 {
+	core::ScratchScope const scratchScope;
 	TViewType temp;
 	return ComponentSignature(temp.GetTypeList());
 }
@@ -8,6 +8,14 @@ namespace et {
 namespace fw {
 
 
+namespace detail {
+
+	// index of the command stream the current thread records into
+	static thread_local uint32 s_WorkerIndex = 0u;
+
+} // namespace detail
+
+
 //====================
 // ECS Command Buffer
 //====================
@@ -16,24 +24,63 @@ namespace fw {
 // construct destruct
 //////////////////////
 
+//-------------------------
+// EcsCommandBuffer::c-tor
+//
+// By default only the main thread records commands
+//
+EcsCommandBuffer::EcsCommandBuffer()
+{
+	SetStreamCount(1u);
+}
+
 //-------------------------
 // EcsCommandBuffer::d-tor
 //
 EcsCommandBuffer::~EcsCommandBuffer()
 {
-	ET_ASSERT(m_ReparentEntities.empty(), "deleting command buffer before it was merged!");
-	ET_ASSERT(m_RemoveEntities.empty(), "deleting command buffer before it was merged!");
-	ET_ASSERT(m_AddComponents.empty(), "deleting command buffer before it was merged!");
-	ET_ASSERT(m_RemoveComponents.empty(), "deleting command buffer before it was merged!");
-	
-	for (std::pair<T_EntityId const, AddBuffer>& addPair : m_AddComponents)
+	ET_ASSERT(IsEmpty(), "deleting command buffer before it was merged!");
+
+	for (std::unique_ptr<CommandStream>& stream : m_Streams)
 	{
-		for (RawComponentPtr const& ptr : addPair.second.components)
-		{
-			// match malloc with free - hence we don't use the full destructor
-			ComponentRegistry::Instance().GetDestructor(ptr.typeIdx)(ptr.data);
-			free(ptr.data);
-		}
+		DestroyComponentData(*stream);
+	}
+}
+
+
+// worker threads
+//////////////////
+
+//----------------------------------
+// EcsCommandBuffer::SetWorkerIndex
+//
+// Worker threads should call this once before recording commands, so that they record into their own stream
+//
+void EcsCommandBuffer::SetWorkerIndex(uint32 const workerIdx)
+{
+	detail::s_WorkerIndex = workerIdx;
+}
+
+//----------------------------------
+// EcsCommandBuffer::GetWorkerIndex
+//
+uint32 EcsCommandBuffer::GetWorkerIndex()
+{
+	return detail::s_WorkerIndex;
+}
+
+//----------------------------------
+// EcsCommandBuffer::SetStreamCount
+//
+// Ensure every worker that records commands has a stream - existing streams are kept so that their memory can be reused
+//
+void EcsCommandBuffer::SetStreamCount(uint32 const count)
+{
+	ET_ASSERT(count > 0u);
+
+	while (m_Streams.size() < static_cast<size_t>(count))
+	{
+		m_Streams.emplace_back(new CommandStream());
 	}
 }
 
@@ -67,15 +114,18 @@ T_EntityId EcsCommandBuffer::DuplicateEntity(T_EntityId const dupe)
 	T_EntityId const ret = m_Controller->AddEntityChild(m_Controller->GetParent(dupe));
 
 	// get the entities component list
+	core::ScratchScope const scratchScope;
+
 	T_CompTypeList const& compTypes = m_Controller->GetComponentTypes(dupe);
-	std::vector<RawComponentPtr> components;
+	core::ScratchVector<RawComponentPtr> components;
+	components.reserve(compTypes.size());
 	for (T_CompTypeIdx const typeId : compTypes)
 	{
 		components.emplace_back(typeId, m_Controller->GetComponentData(dupe, typeId));
 	}
 
 	// copy those components and queue them for later merge into the newly created entity
-	AddComponentList(ret, components);
+	AddComponentList(ret, components.data(), components.size());
 
 	// return the new entities ID
 	return ret;
@@ -90,22 +140,31 @@ T_EntityId EcsCommandBuffer::DuplicateEntity(T_EntityId const dupe)
 //
 void EcsCommandBuffer::ReparentEntity(T_EntityId const entity, T_EntityId const newParent)
 {
-	ET_ASSERT(std::find_if(m_ReparentEntities.cbegin(), m_ReparentEntities.cend(), [entity](std::pair<T_EntityId, T_EntityId> const& pair)
+	CommandStream& stream = GetStream();
+
+	ET_ASSERT(std::find_if(stream.commands.cbegin(), stream.commands.cend(), [entity](Command const& cmd)
 		{
-			return (entity == pair.first);
-		}) == m_ReparentEntities.cend(), "Entity was already queued for reparenting!");
+			return ((cmd.type == E_Command::Reparent) && (cmd.entity == entity));
+		}) == stream.commands.cend(), "Entity was already queued for reparenting!");
 
-	m_ReparentEntities.emplace_back(entity, newParent);
+	stream.commands.emplace_back(E_Command::Reparent, entity, static_cast<uint32>(newParent));
 }
 
 //----------------------------------
 // EcsCommandBuffer::RemoveEntity
 //
+// Duplicate removals from different workers are filtered when merging
+//
 void EcsCommandBuffer::RemoveEntity(T_EntityId const entity)
 {
-	ET_ASSERT(std::find(m_RemoveEntities.cbegin(), m_RemoveEntities.cend(), entity) == m_RemoveEntities.cend(), "It's like beating a dead horse!");
+	CommandStream& stream = GetStream();
 
-	m_RemoveEntities.emplace_back(entity);
+	ET_ASSERT(std::find_if(stream.commands.cbegin(), stream.commands.cend(), [entity](Command const& cmd)
+		{
+			return ((cmd.type == E_Command::RemoveEntity) && (cmd.entity == entity));
+		}) == stream.commands.cend(), "It's like beating a dead horse!");
+
+	stream.commands.emplace_back(E_Command::RemoveEntity, entity, 0u);
 }
 
 
@@ -117,17 +176,28 @@ void EcsCommandBuffer::RemoveEntity(T_EntityId const entity)
 //
 void EcsCommandBuffer::AddComponentList(T_EntityId const entity, std::vector<RawComponentPtr> const& components)
 {
-	// get the component pointer buffer for the entity
-	auto buffer = m_AddComponents.emplace(entity, AddBuffer()).first;
-	
-	// add components to buffer
-	for (RawComponentPtr const& comp : components)
+	AddComponentList(entity, components.data(), components.size());
+}
+
+//------------------------------------
+// EcsCommandBuffer::AddComponentList
+//
+// Components are copied into the streams arena, where they stay until the merge
+//
+void EcsCommandBuffer::AddComponentList(T_EntityId const entity, RawComponentPtr const* const components, size_t const count)
+{
+	CommandStream& stream = GetStream();
+	ComponentRegistry const& registry = ComponentRegistry::Instance();
+
+	for (size_t compIdx = 0u; compIdx < count; ++compIdx)
 	{
-		// copy construct the component pointer
-		RawComponentPtr copy(comp.typeIdx, malloc(ComponentRegistry::Instance().GetSize(comp.typeIdx)));
-		ComponentRegistry::Instance().GetCopyAssign(comp.typeIdx)(comp.data, copy.data);
+		RawComponentPtr const& comp = components[compIdx];
+
+		// copy construct the component into the stream
+		void* const copy = stream.componentData.Allocate(registry.GetSize(comp.typeIdx));
+		registry.GetCopyAssign(comp.typeIdx)(comp.data, copy);
 
-		buffer->second.components.push_back(copy);
+		stream.commands.emplace_back(E_Command::AddComponent, entity, static_cast<uint32>(comp.typeIdx), copy);
 	}
 }
 
@@ -136,13 +206,19 @@ void EcsCommandBuffer::AddComponentList(T_EntityId const entity, std::vector<Raw
 //
 void EcsCommandBuffer::RemoveComponentTypes(T_EntityId const entity, T_CompTypeList const& componentTypes)
 {
-	// get the component type buffer for the entity
-	auto buffer = m_RemoveComponents.emplace(entity, T_CompTypeList()).first;
+	RemoveComponentTypes(entity, componentTypes.data(), componentTypes.size());
+}
 
-	// add components to remove to the buffer
-	for (T_CompTypeIdx const compType : componentTypes)
+//----------------------------------------
+// EcsCommandBuffer::RemoveComponentTypes
+//
+void EcsCommandBuffer::RemoveComponentTypes(T_EntityId const entity, T_CompTypeIdx const* const componentTypes, size_t const count)
+{
+	CommandStream& stream = GetStream();
+
+	for (size_t typeIdx = 0u; typeIdx < count; ++typeIdx)
 	{
-		buffer->second.push_back(compType);
+		stream.commands.emplace_back(E_Command::RemoveComponent, entity, static_cast<uint32>(componentTypes[typeIdx]));
 	}
 }
 
@@ -151,10 +227,10 @@ void EcsCommandBuffer::RemoveComponentTypes(T_EntityId const entity, T_CompTypeL
 //
 void EcsCommandBuffer::OnMerge(T_EntityId const entity, T_OnMergeFn& fn)
 {
-	// get the component pointer buffer for the entity
-	auto buffer = m_AddComponents.emplace(entity, AddBuffer()).first;
+	CommandStream& stream = GetStream();
 
-	buffer->second.callbacks.emplace_back(fn);
+	stream.commands.emplace_back(E_Command::OnMerge, entity, static_cast<uint32>(stream.callbacks.size()));
+	stream.callbacks.emplace_back(fn);
 }
 
 
@@ -164,57 +240,321 @@ void EcsCommandBuffer::OnMerge(T_EntityId const entity, T_OnMergeFn& fn)
 //--------------------------
 // EcsCommandBuffer::Merge
 //
-// This function should be called by the system once it finishes executing in order to actually execute the commands
+// This function should be called by the system once it finishes executing (and all its workers are done) in order to actually execute the commands
 //
 void EcsCommandBuffer::Merge()
 {
 	ET_ASSERT(m_Controller != nullptr);
 
-	// reparent entities
-	for (std::pair<T_EntityId, T_EntityId> const repPair : m_ReparentEntities)
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	core::ScratchScope const scratchScope;
+	core::ScratchVector<MergeEntry> entries;
+
+	MergeReparents(entries);
+	MergeRemoveComponents(entries);
+	MergeAddComponents(entries);
+	MergeRemoveEntities(entries);
+
+	// reset the streams but keep their memory around for the next frame
+	for (std::unique_ptr<CommandStream>& stream : m_Streams)
+	{
+		DestroyComponentData(*stream);
+		stream->commands.clear();
+		stream->callbacks.clear();
+	}
+}
+
+
+// utility
+///////////
+
+//-----------------------------
+// EcsCommandBuffer::GetStream
+//
+// Stream for the calling thread - no synchronization needed as long as each worker has a unique index
+//
+EcsCommandBuffer::CommandStream& EcsCommandBuffer::GetStream()
+{
+	uint32 const workerIdx = detail::s_WorkerIndex;
+	ET_ASSERT(static_cast<size_t>(workerIdx) < m_Streams.size(), "No command stream for worker %u, increase the stream count!", workerIdx);
+
+	return *m_Streams[workerIdx];
+}
+
+//---------------------------
+// EcsCommandBuffer::IsEmpty
+//
+bool EcsCommandBuffer::IsEmpty() const
+{
+	for (std::unique_ptr<CommandStream> const& stream : m_Streams)
+	{
+		if (!stream->commands.empty())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//----------------------------------
+// EcsCommandBuffer::MergeReparents
+//
+void EcsCommandBuffer::MergeReparents(core::ScratchVector<MergeEntry>& entries)
+{
+	entries.clear();
+	GatherCommands(E_Command::Reparent, entries);
+	std::sort(entries.begin(), entries.end(), CompareMergeEntries);
+
+	for (MergeEntry const& entry : entries)
 	{
-		m_Controller->ReparentEntity(repPair.first, repPair.second);
+		m_Controller->ReparentEntity(entry.entity, static_cast<T_EntityId>(GetCommand(entry).payload));
 	}
+}
 
-	m_ReparentEntities.clear();
+//-----------------------------------------
+// EcsCommandBuffer::MergeRemoveComponents
+//
+// Removals for the same entity are applied in one go, so that the entity only changes archetype once
+//
+void EcsCommandBuffer::MergeRemoveComponents(core::ScratchVector<MergeEntry>& entries)
+{
+	entries.clear();
+	GatherCommands(E_Command::RemoveComponent, entries);
+	std::sort(entries.begin(), entries.end(), CompareMergeEntries);
 
-	// remove components
-	for (std::pair<T_EntityId, T_CompTypeList> const& remComps : m_RemoveComponents)
+	core::ScratchVector<T_CompTypeIdx> types;
+
+	size_t groupStart = 0u;
+	while (groupStart < entries.size())
 	{
-		m_Controller->RemoveComponents(remComps.first, remComps.second);
+		T_EntityId const entity = entries[groupStart].entity;
+
+		types.clear();
+		size_t groupEnd = groupStart;
+		for (; (groupEnd < entries.size()) && (entries[groupEnd].entity == entity); ++groupEnd)
+		{
+			T_CompTypeIdx const type = static_cast<T_CompTypeIdx>(GetCommand(entries[groupEnd]).payload);
+			if (std::find(types.cbegin(), types.cend(), type) == types.cend()) // several workers may remove the same component
+			{
+				types.emplace_back(type);
+			}
+		}
+
+		m_Controller->RemoveComponents(entity, types.data(), types.size());
+
+		groupStart = groupEnd;
 	}
+}
 
-	m_RemoveComponents.clear();
+//--------------------------------------
+// EcsCommandBuffer::MergeAddComponents
+//
+// Commands are grouped by entity, and the groups are applied ordered by the archetype the entity ends up in
+//  - this keeps consecutive writes within the same component pools
+//  - each run of entities sharing a target archetype is moved with a single controller call
+//  - merge callbacks for an entity are executed after the components of its whole run were added
+//
+void EcsCommandBuffer::MergeAddComponents(core::ScratchVector<MergeEntry>& entries)
+{
+	//---------------------------------
+	// AddGroup
+	//
+	// Range of merge entries targeting the same entity
+	//
+	struct AddGroup
+	{
+		T_Hash targetArchetype;
+		T_EntityId entity;
+		size_t start;
+		size_t end;
+	};
+
+	entries.clear();
+	GatherCommands(E_Command::AddComponent, entries);
+	GatherCommands(E_Command::OnMerge, entries);
+	std::sort(entries.begin(), entries.end(), CompareMergeEntries);
+
+	// find groups and their target archetypes
+	core::ScratchVector<AddGroup> groups;
+	core::ScratchVector<T_CompTypeIdx> types;
+
+	size_t groupStart = 0u;
+	while (groupStart < entries.size())
+	{
+		AddGroup group;
+		group.entity = entries[groupStart].entity;
+		group.start = groupStart;
+
+		T_CompTypeList const& currentTypes = m_Controller->GetComponentTypes(group.entity);
+		types.assign(currentTypes.cbegin(), currentTypes.cend());
+
+		group.end = groupStart;
+		for (; (group.end < entries.size()) && (entries[group.end].entity == group.entity); ++group.end)
+		{
+			Command const& cmd = GetCommand(entries[group.end]);
+			if (cmd.type == E_Command::AddComponent)
+			{
+				types.emplace_back(static_cast<T_CompTypeIdx>(cmd.payload));
+			}
+		}
+
+		std::sort(types.begin(), types.end());
+		group.targetArchetype = ComponentSignature::GenId(types.data(), types.size());
 
-	// add components
-	for (std::pair<T_EntityId const, AddBuffer>& addComps : m_AddComponents)
+		groups.emplace_back(group);
+		groupStart = group.end;
+	}
+
+	std::sort(groups.begin(), groups.end(), [](AddGroup const& lhs, AddGroup const& rhs)
+		{
+			return (lhs.targetArchetype == rhs.targetArchetype) ? (lhs.entity < rhs.entity) : (lhs.targetArchetype < rhs.targetArchetype);
+		});
+
+	// apply runs of groups that end up in the same archetype together
+	core::ScratchVector<T_EntityId> runEntities;
+	core::ScratchVector<RawComponentPtr> components;
+	core::ScratchVector<size_t> componentCounts;
+
+	size_t runStart = 0u;
+	while (runStart < groups.size())
 	{
-		m_Controller->AddComponents(addComps.first, std::vector<RawComponentPtr>(addComps.second.components));
+		size_t runEnd = runStart;
+		for (; (runEnd < groups.size()) && (groups[runEnd].targetArchetype == groups[runStart].targetArchetype); ++runEnd)
+		{
+			AddGroup const& group = groups[runEnd];
+
+			size_t const prevCount = components.size();
+			for (size_t entryIdx = group.start; entryIdx < group.end; ++entryIdx)
+			{
+				Command const& cmd = GetCommand(entries[entryIdx]);
+				if (cmd.type == E_Command::AddComponent)
+				{
+					components.emplace_back(static_cast<T_CompTypeIdx>(cmd.payload), cmd.data);
+				}
+			}
+
+			if (components.size() > prevCount) // groups with only callbacks don't move their entity
+			{
+				runEntities.emplace_back(group.entity);
+				componentCounts.emplace_back(components.size() - prevCount);
+			}
+		}
+
+		if (!runEntities.empty())
+		{
+			m_Controller->AddComponentsToEntities(runEntities.data(), runEntities.size(), components.data(), componentCounts.data());
+		}
 
 		// callbacks
-		for (T_OnMergeFn& fn : addComps.second.callbacks)
+		for (size_t groupIdx = runStart; groupIdx < runEnd; ++groupIdx)
+		{
+			AddGroup const& group = groups[groupIdx];
+			for (size_t entryIdx = group.start; entryIdx < group.end; ++entryIdx)
+			{
+				Command const& cmd = GetCommand(entries[entryIdx]);
+				if (cmd.type == E_Command::OnMerge)
+				{
+					m_Streams[entries[entryIdx].stream]->callbacks[cmd.payload](*m_Controller, group.entity);
+				}
+			}
+		}
+
+		runEntities.clear();
+		components.clear();
+		componentCounts.clear();
+		runStart = runEnd;
+	}
+}
+
+//---------------------------------------
+// EcsCommandBuffer::MergeRemoveEntities
+//
+void EcsCommandBuffer::MergeRemoveEntities(core::ScratchVector<MergeEntry>& entries)
+{
+	entries.clear();
+	GatherCommands(E_Command::RemoveEntity, entries);
+	std::sort(entries.begin(), entries.end(), CompareMergeEntries);
+
+	for (size_t entryIdx = 0u; entryIdx < entries.size(); ++entryIdx)
+	{
+		// skip removals that were already queued by another worker
+		if ((entryIdx > 0u) && (entries[entryIdx - 1u].entity == entries[entryIdx].entity))
+		{
+			continue;
+		}
+
+		m_Controller->RemoveEntity(entries[entryIdx].entity);
+	}
+}
+
+//----------------------------------
+// EcsCommandBuffer::GatherCommands
+//
+// Append references to all commands of a type across streams
+//
+void EcsCommandBuffer::GatherCommands(E_Command const type, core::ScratchVector<MergeEntry>& entries) const
+{
+	for (size_t streamIdx = 0u; streamIdx < m_Streams.size(); ++streamIdx)
+	{
+		std::vector<Command> const& commands = m_Streams[streamIdx]->commands;
+		for (size_t cmdIdx = 0u; cmdIdx < commands.size(); ++cmdIdx)
 		{
-			fn(*m_Controller, addComps.first);
+			if (commands[cmdIdx].type == type)
+			{
+				MergeEntry entry;
+				entry.entity = commands[cmdIdx].entity;
+				entry.stream = static_cast<uint32>(streamIdx);
+				entry.index = static_cast<uint32>(cmdIdx);
+				entries.emplace_back(entry);
+			}
 		}
+	}
+}
+
+//----------------------------------------
+// EcsCommandBuffer::DestroyComponentData
+//
+// Components have been copied into the ECS when merging, so the copies in the stream can be destroyed without freeing their memory
+//
+void EcsCommandBuffer::DestroyComponentData(CommandStream& stream)
+{
+	ComponentRegistry const& registry = ComponentRegistry::Instance();
 
-		// delete the components in the buffer as they have now been copied into the ECS
-		for (RawComponentPtr const& ptr : addComps.second.components)
+	for (Command const& cmd : stream.commands)
+	{
+		if (cmd.type == E_Command::AddComponent)
 		{
-			// match malloc with free - hence we don't use the full destructor
-			ComponentRegistry::Instance().GetDestructor(ptr.typeIdx)(ptr.data);
-			free(ptr.data);
+			registry.GetDestructor(static_cast<T_CompTypeIdx>(cmd.payload))(cmd.data);
 		}
 	}
 
-	m_AddComponents.clear();
+	stream.componentData.Reset();
+}
+
+
+//---------------------------------------
+// EcsCommandBuffer::CompareMergeEntries
+//
+// Total ordering for commands, independent of the timing of the threads that recorded them
+//
+bool EcsCommandBuffer::CompareMergeEntries(MergeEntry const& lhs, MergeEntry const& rhs)
+{
+	if (lhs.entity != rhs.entity)
+	{
+		return lhs.entity < rhs.entity;
+	}
 
-	// remove entities
-	for (T_EntityId const remEnt : m_RemoveEntities)
+	if (lhs.stream != rhs.stream)
 	{
-		m_Controller->RemoveEntity(remEnt);
+		return lhs.stream < rhs.stream;
 	}
 
-	m_RemoveEntities.clear();
+	return lhs.index < rhs.index;
 }
 
 
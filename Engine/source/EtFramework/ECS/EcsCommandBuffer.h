@@ -2,6 +2,8 @@
 #include "ComponentRegistry.h"
 #include "RawComponentPointer.h"
 
+#include <EtCore/Memory/StlAllocators.h>
+
 
 namespace et {
 namespace fw {
@@ -16,8 +18,18 @@ class EcsController;
 // Queues modifications to the ECS in a concurrency friendly way, so that systems can modify the entity layout
 //  - components added to the buffer cannot be used until the buffer is merged with the ECS
 //
+//  - Every worker thread records into its own command stream, so recording doesn't require any locking
+//		- commands are stored as fixed size records, and component copies live in a linear arena owned by the stream
+//		- workers identify themselves through SetWorkerIndex, the main thread uses stream 0
+//		- the number of streams has to be set before workers start recording
+//
+//  - Merging is deterministic regardless of which worker recorded a command:
+//		- within each stage, commands are sorted by entity, then by stream and recording order
+//		- component additions are grouped per entity and applied ordered by the archetype they move the entity to
+//
 //  - Merge order:
 //		- Create new empty entities immediately, including duplications, but queue duplicate components for later addition
+//			- as this resolves immediately it's not thread safe, and should be done from the thread that owns the controller
 //
 //		- Reparent entities
 //		- Remove Components
@@ -31,27 +43,90 @@ class EcsCommandBuffer final
 public:
 	typedef std::function<void(EcsController&, T_EntityId const)> T_OnMergeFn;
 
+	static constexpr size_t s_StreamArenaCapacity = 16u * 1024u;
+
 private:
-	struct AddBuffer
+	//---------------------------------
+	// E_Command
+	//
+	// Type of a recorded command - the order matches the merge order
+	//
+	enum class E_Command : uint8
+	{
+		Reparent,
+		RemoveComponent,
+		AddComponent,
+		OnMerge,
+		RemoveEntity
+	};
+
+	//---------------------------------
+	// Command
+	//
+	// Fixed size record - the meaning of the payload depends on the command type:
+	//  - Reparent: new parent
+	//  - RemoveComponent / AddComponent: component type
+	//  - OnMerge: index into the streams callback list
+	//
+	struct Command final
 	{
-		std::vector<RawComponentPtr> components;
+		Command(E_Command const cmdType, T_EntityId const ent, uint32 const cmdPayload, void* const cmdData = nullptr)
+			: type(cmdType), entity(ent), payload(cmdPayload), data(cmdData) {}
+
+		E_Command type;
+		T_EntityId entity;
+		uint32 payload;
+		void* data; // copied component for AddComponent
+	};
+
+	//---------------------------------
+	// CommandStream
+	//
+	// Commands recorded by a single worker - memory is retained between merges
+	//
+	struct CommandStream final
+	{
+		CommandStream() : componentData(s_StreamArenaCapacity) {}
+
+		std::vector<Command> commands;
 		std::vector<T_OnMergeFn> callbacks;
+		core::LinearArena componentData;
+	};
+
+	//---------------------------------
+	// MergeEntry
+	//
+	// Reference to a command used for sorting during the merge
+	//
+	struct MergeEntry final
+	{
+		T_EntityId entity;
+		uint32 stream;
+		uint32 index;
 	};
 
 	friend class SystemBase;
 
 	// construct destruct
 	//--------------------
-	EcsCommandBuffer() = default;
+	EcsCommandBuffer();
 	~EcsCommandBuffer();
 
 	// no copying the buffer
 	EcsCommandBuffer(EcsCommandBuffer const&) = delete;
 	void operator=(EcsCommandBuffer const&) = delete;
 
+	// worker threads
+	//----------------
+public:
+	static void SetWorkerIndex(uint32 const workerIdx); // call once per worker thread
+	static uint32 GetWorkerIndex();
+
+	void SetStreamCount(uint32 const count); // not thread safe - call before workers record commands
+	uint32 GetStreamCount() const { return static_cast<uint32>(m_Streams.size()); }
+
 	// create new entities
 	//---------------------
-public:
 	T_EntityId AddEntity();
 	T_EntityId AddEntityChild(T_EntityId const parent);
 	T_EntityId DuplicateEntity(T_EntityId const dupe);
@@ -66,10 +141,12 @@ public:
 	template<typename TComponentType, typename... Args>
 	void AddComponents(T_EntityId const entity, TComponentType& component1, Args... args);
 	void AddComponentList(T_EntityId const entity, std::vector<RawComponentPtr> const& components);
+	void AddComponentList(T_EntityId const entity, RawComponentPtr const* const components, size_t const count);
 
 	template<typename TComponentType, typename... Args>
 	void RemoveComponents(T_EntityId const entity);
 	void RemoveComponentTypes(T_EntityId const entity, T_CompTypeList const& componentTypes);
+	void RemoveComponentTypes(T_EntityId const entity, T_CompTypeIdx const* const componentTypes, size_t const count);
 
 	// callbacks when adding components to entities
 	//----------------------------------------------
@@ -81,16 +158,28 @@ private:
 	void SetController(EcsController* const ecs) { m_Controller = ecs; }
 	void Merge();
 
+	// utility
+	//---------
+	CommandStream& GetStream();
+	bool IsEmpty() const;
+
+	void MergeReparents(core::ScratchVector<MergeEntry>& entries);
+	void MergeRemoveComponents(core::ScratchVector<MergeEntry>& entries);
+	void MergeAddComponents(core::ScratchVector<MergeEntry>& entries);
+	void MergeRemoveEntities(core::ScratchVector<MergeEntry>& entries);
+
+	void GatherCommands(E_Command const type, core::ScratchVector<MergeEntry>& entries) const;
+	Command const& GetCommand(MergeEntry const& entry) const { return m_Streams[entry.stream]->commands[entry.index]; }
+
+	void DestroyComponentData(CommandStream& stream);
+
+	static bool CompareMergeEntries(MergeEntry const& lhs, MergeEntry const& rhs);
+
 	// Data
 	///////
 
 	EcsController* m_Controller = nullptr;
-
-	std::vector<std::pair<T_EntityId, T_EntityId>> m_ReparentEntities; // [to reparent, new parent]
-	std::vector<T_EntityId> m_RemoveEntities;
-
-	std::unordered_map<T_EntityId, AddBuffer> m_AddComponents;
-	std::unordered_map<T_EntityId, T_CompTypeList> m_RemoveComponents;
+	std::vector<std::unique_ptr<CommandStream>> m_Streams;
 };
 
 
@@ -5,31 +5,6 @@ namespace et {
 namespace fw {
 
 
-namespace detail {
-
-	//-------------------------------
-	// EcsCommandBuffer::AddToBuffer
-	//
-	// variadic template recursively adds components to a raw component pointer list and finally add the list to the buffer
-	// adding the components in the last recursion call prevents components from going out of scope for some reason
-	//
-	template<typename TComponentType>
-	void AddToBuffer(EcsCommandBuffer& buffer, T_EntityId const entity, std::vector<RawComponentPtr>& list, TComponentType& component)
-	{
-		list.emplace_back(MakeRawComponent(component));
-		buffer.AddComponentList(entity, list);
-	}
-
-	template<typename TComponentType, typename... Args>
-	void AddToBuffer(EcsCommandBuffer& buffer, T_EntityId const entity, std::vector<RawComponentPtr>& list, TComponentType& component1, Args... args)
-	{
-		list.emplace_back(MakeRawComponent(component1));
-		AddToBuffer(buffer, entity, list, args...);
-	}
-
-}
-
-
 //====================
 // ECS Command Buffer
 //====================
@@ -41,11 +16,13 @@ namespace detail {
 //---------------------------------
 // EcsCommandBuffer::AddComponents
 //
+// Components are gathered on the stack, as the number of components is known at compile time
+//
 template<typename TComponentType, typename... Args>
 void EcsCommandBuffer::AddComponents(T_EntityId const entity, TComponentType& component1, Args... args)
 {
-	std::vector<RawComponentPtr> list;
-	detail::AddToBuffer(*this, entity, list, component1, args...);
+	RawComponentPtr const list[] = { MakeRawComponent(component1), MakeRawComponent(args)... };
+	AddComponentList(entity, list, sizeof...(Args) + 1u);
 }
 
 //------------------------------------
@@ -54,7 +31,8 @@ void EcsCommandBuffer::AddComponents(T_EntityId const entity, TComponentType& co
 template<typename TComponentType, typename... Args>
 void EcsCommandBuffer::RemoveComponents(T_EntityId const entity)
 {
-	RemoveComponentTypes(entity, GenCompTypeList<TComponentType, Args...>());
+	T_CompTypeIdx const types[] = { TComponentType::GetTypeIndex(), Args::GetTypeIndex()... };
+	RemoveComponentTypes(entity, types, sizeof...(Args) + 1u);
 }
 
 
@@ -87,6 +87,8 @@ T_EntityId EcsController::AddEntityBatched(std::vector<RawComponentPtr> const& c
 //
 T_EntityId EcsController::AddEntityBatched(T_EntityId const parent, std::vector<RawComponentPtr> const& components)
 {
+	core::ScratchScope const scratchScope;
+
 	// create the entity data
 	auto ent = m_Entities.insert(EntityData());
 
@@ -102,20 +104,29 @@ T_EntityId EcsController::AddEntityBatched(T_EntityId const parent, std::vector<
 	}
 
 	// find the archetype for the new component list
-	ent.first->archetype = FindOrCreateArchetype(ComponentSignature(components), ent.first->layer);
-	ent.first->index = ent.first->archetype->AddEntity(ent.second, components);
+	T_ScratchTypeList compTypes;
+	compTypes.reserve(components.size());
+	for (RawComponentPtr const& comp : components)
+	{
+		compTypes.emplace_back(comp.typeIdx);
+	}
+
+	ent.first->archetype = FindOrCreateArchetype(compTypes, ent.first->layer);
+	ent.first->index = ent.first->archetype->AddEntity(ent.second, components.data(), components.size());
 
 	// emit events for the added components
-	std::vector<RawComponentPtr> addedComponents;
+	T_ScratchComponentList addedComponents;
 	GetComponentsAndTypes(*(ent.first), addedComponents);
 
 	for (RawComponentPtr& comp : addedComponents)
 	{
-		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, new detail::ComponentEventData(this, comp.data, ent.second));
+		detail::ComponentEventData const eventData(this, comp.data, ent.second);
+		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, &eventData);
 	}
 
 	// entity events
-	m_EntityEvents.Notify(detail::E_EcsEvent::Added, new detail::EntityEventData(this, ent.second));
+	detail::EntityEventData const eventData(this, ent.second);
+	m_EntityEvents.Notify(detail::E_EcsEvent::Added, &eventData);
 
 	// return the ID
 	return ent.second;
@@ -128,9 +139,11 @@ T_EntityId EcsController::AddEntityBatched(T_EntityId const parent, std::vector<
 //
 T_EntityId EcsController::DuplicateEntityAddComponents(T_EntityId const dupe, std::vector<RawComponentPtr> const& components)
 {
+	core::ScratchScope const scratchScope;
+
 	// get referred entities current components
-	std::vector<RawComponentPtr> currentComponents;
-	T_CompTypeList compTypes = GetComponentsAndTypes(m_Entities[dupe], currentComponents);
+	T_ScratchComponentList currentComponents;
+	T_ScratchTypeList compTypes = GetComponentsAndTypes(m_Entities[dupe], currentComponents);
 
 	// add the new components
 	for (RawComponentPtr const& comp : components)
@@ -155,20 +168,22 @@ T_EntityId EcsController::DuplicateEntityAddComponents(T_EntityId const dupe, st
 	}
 
 	// find the archetype for the new component list
-	ent.first->archetype = FindOrCreateArchetype(ComponentSignature(currentComponents), ent.first->layer);
-	ent.first->index = ent.first->archetype->AddEntity(ent.second, currentComponents);
+	ent.first->archetype = FindOrCreateArchetype(compTypes, ent.first->layer);
+	ent.first->index = ent.first->archetype->AddEntity(ent.second, currentComponents.data(), currentComponents.size());
 
 	// emit events for the added components
-	std::vector<RawComponentPtr> addedComponents;
+	T_ScratchComponentList addedComponents;
 	GetComponentsAndTypes(*(ent.first), addedComponents);
 
 	for (RawComponentPtr& comp : addedComponents)
 	{
-		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, new detail::ComponentEventData(this, comp.data, ent.second));
+		detail::ComponentEventData const eventData(this, comp.data, ent.second);
+		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, &eventData);
 	}
 
 	// entity events
-	m_EntityEvents.Notify(detail::E_EcsEvent::Added, new detail::EntityEventData(this, ent.second));
+	detail::EntityEventData const eventData(this, ent.second);
+	m_EntityEvents.Notify(detail::E_EcsEvent::Added, &eventData);
 
 	// return the ID
 	return ent.second;
@@ -188,8 +203,9 @@ void EcsController::ReparentEntity(T_EntityId const entity, T_EntityId const new
 	// remove from current parent
 	RemoveEntityFromParent(entity, ent.parent);
 
-	std::vector<RawComponentPtr> components;
-	T_CompTypeList compTypes = GetComponentsAndTypes(ent, components);
+	core::ScratchScope const scratchScope;
+	T_ScratchComponentList components;
+	T_ScratchTypeList const compTypes = GetComponentsAndTypes(ent, components);
 
 	// add to new parent, and get new layer
 	ent.parent = newParent;
@@ -224,17 +240,22 @@ void EcsController::ReparentEntity(T_EntityId const entity, T_EntityId const new
 void EcsController::RemoveEntity(T_EntityId const entity)
 {
 	// entity events
-	m_EntityEvents.Notify(detail::E_EcsEvent::Removed, new detail::EntityEventData(this, entity));
+	detail::EntityEventData const eventData(this, entity);
+	m_EntityEvents.Notify(detail::E_EcsEvent::Removed, &eventData);
 
 	// get referred entity
 	EntityData& ent = m_Entities[entity];
 
 	// emit events for the entities components
-	std::vector<RawComponentPtr> components;
-	GetComponentsAndTypes(ent, components);
-	for (RawComponentPtr& comp : components)
 	{
-		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, comp.data, entity));
+		core::ScratchScope const scratchScope;
+		T_ScratchComponentList components;
+		GetComponentsAndTypes(ent, components);
+		for (RawComponentPtr& comp : components)
+		{
+			detail::ComponentEventData const eventData(this, comp.data, entity);
+			m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Removed, &eventData);
+		}
 	}
 
 	RemoveEntityFromParent(entity, ent.parent);
@@ -264,7 +285,8 @@ void EcsController::RemoveAllEntities()
 		std::vector<T_EntityId> const& entities = GetEntities();
 		for (T_EntityId const entity : entities)
 		{
-			m_EntityEvents.Notify(detail::E_EcsEvent::Removed, new detail::EntityEventData(this, entity));
+			detail::EntityEventData const eventData(this, entity);
+			m_EntityEvents.Notify(detail::E_EcsEvent::Removed, &eventData);
 		}
 	}
 
@@ -284,7 +306,8 @@ void EcsController::RemoveAllEntities()
 					{
 						for (size_t idx = 0u; idx < entityCount; ++idx)
 						{
-							events.Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, pool.At(idx), arch.second->GetEntity(idx)));
+							detail::ComponentEventData const eventData(this, pool.At(idx), arch.second->GetEntity(idx));
+							events.Notify(detail::E_EcsEvent::Removed, &eventData);
 						}
 					}
 				}
@@ -315,27 +338,108 @@ void EcsController::RemoveAllEntities()
 // Add a list of components to an entity
 //
 void EcsController::AddComponents(T_EntityId const entity, std::vector<RawComponentPtr>& components)
+{
+	AddComponents(entity, components.data(), components.size());
+}
+
+//-----------------------------
+// EcsController::AddComponent
+//
+// Add a list of components to an entity - the component pointers are reassigned to the data within the ECS
+//
+void EcsController::AddComponents(T_EntityId const entity, RawComponentPtr* const components, size_t const count)
 {
 	// get referred entity
 	EntityData& ent = m_Entities[entity];
 
-	std::vector<RawComponentPtr> currentComponents;
-	T_CompTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
+	core::ScratchScope const scratchScope;
+	T_ScratchComponentList currentComponents;
+	T_ScratchTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
 
 	// add the new components
-	for (RawComponentPtr const& comp : components)
+	for (size_t compIdx = 0u; compIdx < count; ++compIdx)
 	{
-		compTypes.emplace_back(comp.typeIdx);
-		currentComponents.emplace_back(comp);
+		compTypes.emplace_back(components[compIdx].typeIdx);
+		currentComponents.emplace_back(components[compIdx]);
 	}
 
 	MoveArchetype(entity, ent, compTypes, currentComponents);
 
 	// reassign the component pointers and emit component add events
-	for (RawComponentPtr& comp : components)
+	for (size_t compIdx = 0u; compIdx < count; ++compIdx)
 	{
+		RawComponentPtr& comp = components[compIdx];
 		comp.data = ent.archetype->GetPool(comp.typeIdx).At(ent.index);
-		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, new detail::ComponentEventData(this, comp.data, entity));
+		detail::ComponentEventData const eventData(this, comp.data, entity);
+		m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, &eventData);
+	}
+}
+
+//---------------------------------------
+// EcsController::AddComponentsToEntities
+//
+// Add components to a run of entities which all end up in the same archetype
+//  - components holds the lists of all entities back to back, componentCounts how many of them belong to each entity
+//  - the archetype is only looked up once per hierachy layer and grown once for the whole run, instead of per entity
+//  - component add events are emitted after all entities were moved, and the component pointers are reassigned like in AddComponents
+//
+void EcsController::AddComponentsToEntities(T_EntityId const* const entities,
+	size_t const entityCount,
+	RawComponentPtr* const components,
+	size_t const* const componentCounts)
+{
+	Archetype* target = nullptr;
+	uint8 targetLayer = 0u;
+
+	size_t compOffset = 0u;
+	for (size_t entityIdx = 0u; entityIdx < entityCount; ++entityIdx)
+	{
+		T_EntityId const entity = entities[entityIdx];
+		EntityData& ent = m_Entities[entity];
+
+		core::ScratchScope const scratchScope;
+		T_ScratchComponentList currentComponents;
+		T_ScratchTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
+
+		for (size_t compIdx = compOffset; compIdx < compOffset + componentCounts[entityIdx]; ++compIdx)
+		{
+			compTypes.emplace_back(components[compIdx].typeIdx);
+			currentComponents.emplace_back(components[compIdx]);
+		}
+
+		// entities of the run may still live in different hierachy layers
+		if ((target == nullptr) || (ent.layer != targetLayer))
+		{
+			target = FindOrCreateArchetype(compTypes, ent.layer);
+			targetLayer = ent.layer;
+			target->Reserve(target->GetSize() + entityCount - entityIdx);
+		}
+
+		size_t const nextIdx = target->AddEntity(entity, currentComponents.data(), currentComponents.size());
+		RemoveEntityFromArchetype(ent);
+
+		ent.archetype = target;
+		ent.index = nextIdx;
+
+		compOffset += componentCounts[entityIdx];
+	}
+
+	// reassign the component pointers and emit component add events
+	compOffset = 0u;
+	for (size_t entityIdx = 0u; entityIdx < entityCount; ++entityIdx)
+	{
+		T_EntityId const entity = entities[entityIdx];
+		for (size_t compIdx = compOffset; compIdx < compOffset + componentCounts[entityIdx]; ++compIdx)
+		{
+			EntityData const& ent = m_Entities[entity]; // event listeners may move entities around
+
+			RawComponentPtr& comp = components[compIdx];
+			comp.data = ent.archetype->GetPool(comp.typeIdx).At(ent.index);
+			detail::ComponentEventData const eventData(this, comp.data, entity);
+			m_ComponentEvents[comp.typeIdx].Notify(detail::E_EcsEvent::Added, &eventData);
+		}
+
+		compOffset += componentCounts[entityIdx];
 	}
 }
 
@@ -345,16 +449,28 @@ void EcsController::AddComponents(T_EntityId const entity, std::vector<RawCompon
 // Remove a list of components from an entity
 //
 void EcsController::RemoveComponents(T_EntityId const entity, T_CompTypeList const& componentTypes)
+{
+	RemoveComponents(entity, componentTypes.data(), componentTypes.size());
+}
+
+//---------------------------------
+// EcsController::RemoveComponents
+//
+// Remove a list of components from an entity
+//
+void EcsController::RemoveComponents(T_EntityId const entity, T_CompTypeIdx const* const componentTypes, size_t const count)
 {
 	// get referred entity
 	EntityData& ent = m_Entities[entity];
 
-	std::vector<RawComponentPtr> currentComponents;
-	T_CompTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
+	core::ScratchScope const scratchScope;
+	T_ScratchComponentList currentComponents;
+	T_ScratchTypeList compTypes = GetComponentsAndTypes(ent, currentComponents);
 
 	// remove the components and emit events for them
-	for (T_CompTypeIdx const comp : componentTypes)
+	for (size_t typeIdx = 0u; typeIdx < count; ++typeIdx)
 	{
+		T_CompTypeIdx const comp = componentTypes[typeIdx];
 		if (compTypes.size() == 1u)
 		{
 			ET_ASSERT(compTypes[0u] == comp);
@@ -362,7 +478,8 @@ void EcsController::RemoveComponents(T_EntityId const entity, T_CompTypeList con
 
 			ET_ASSERT(currentComponents.size() == 1u);
 			ET_ASSERT(currentComponents[0u].typeIdx == comp);
-			m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, currentComponents[0u].data, entity));
+			detail::ComponentEventData const eventData(this, currentComponents[0u].data, entity);
+			m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, &eventData);
 			currentComponents.clear();
 		}
 		else
@@ -376,7 +493,8 @@ void EcsController::RemoveComponents(T_EntityId const entity, T_CompTypeList con
 			compTypes[idx] = compTypes[compTypes.size() - 1];
 			compTypes.pop_back();
 
-			m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, new detail::ComponentEventData(this, currentComponents[idx].data, entity));
+			detail::ComponentEventData const eventData(this, currentComponents[idx].data, entity);
+			m_ComponentEvents[comp].Notify(detail::E_EcsEvent::Removed, &eventData);
 			currentComponents[idx] = currentComponents[currentComponents.size() - 1];
 			currentComponents.pop_back();
 		}
@@ -436,8 +554,12 @@ void EcsController::UnregisterEntityEvent(T_EntityEventId& callbackId)
 //
 void EcsController::Process()
 {
+	ET_PROFILE_ZONE("EcsController::Process");
+
 	for (RegisteredSystem* const sys : m_Schedule)
 	{
+		ET_PROFILE_ZONE(sys->system->GetTypeName());
+
 		sys->system->SetCommandController(this);
 
 		for (RegisteredSystem::ArchetypeLayer& layer : sys->matchingArchetypes)
@@ -451,7 +573,10 @@ void EcsController::Process()
 			}
 		}
 
-		sys->system->MergeCommands();
+		{
+			ET_PROFILE_ZONE("EcsController::MergeCommands");
+			sys->system->MergeCommands();
+		}
 	}
 }
 
@@ -527,10 +652,12 @@ void const* EcsController::GetComponentData(T_EntityId const entity, T_CompTypeI
 // EcsController::FindOrCreateArchetype
 //
 // Get the associated archetype or create a new one
+//  - the type list is taken by value as it gets sorted, but a signature is only constructed if the archetype doesn't exist yet
 //
-Archetype* EcsController::FindOrCreateArchetype(ComponentSignature const& sig, uint8 const layer)
+Archetype* EcsController::FindOrCreateArchetype(T_ScratchTypeList compTypes, uint8 const layer)
 {
-	T_Hash const sigId = sig.GenId();
+	std::sort(compTypes.begin(), compTypes.end());
+	T_Hash const sigId = ComponentSignature::GenId(compTypes.data(), compTypes.size());
 
 	// ensure we have an archetype container for the hierachy layer we are on
 	while (m_HierachyLevels.size() <= static_cast<size_t>(layer))
@@ -543,7 +670,7 @@ Archetype* EcsController::FindOrCreateArchetype(ComponentSignature const& sig, u
 	auto foundA = cont.archetypes.find(sigId);
 	if (foundA == cont.archetypes.cend())
 	{
-		auto res = cont.archetypes.emplace(sigId, new Archetype(sig));
+		auto res = cont.archetypes.emplace(sigId, new Archetype(ComponentSignature(T_CompTypeList(compTypes.cbegin(), compTypes.cend()))));
 		ET_ASSERT(res.second == true);
 		foundA = res.first;
 
@@ -570,13 +697,13 @@ Archetype* EcsController::FindOrCreateArchetype(ComponentSignature const& sig, u
 //
 // Move an entities component data to the correct archetype
 //
-void EcsController::MoveArchetype(T_EntityId const entId, EntityData& ent, T_CompTypeList const& compTypes, std::vector<RawComponentPtr> const& components)
+void EcsController::MoveArchetype(T_EntityId const entId, EntityData& ent, T_ScratchTypeList const& compTypes, T_ScratchComponentList const& components)
 {
 	// find the archetype for the new component list
-	Archetype* const nextA = FindOrCreateArchetype(ComponentSignature(compTypes), ent.layer);
+	Archetype* const nextA = FindOrCreateArchetype(compTypes, ent.layer);
 
 	// add our entity to the next archetype
-	size_t const nextIdx = nextA->AddEntity(entId, components);
+	size_t const nextIdx = nextA->AddEntity(entId, components.data(), components.size());
 
 	RemoveEntityFromArchetype(ent);
 
@@ -602,9 +729,14 @@ void EcsController::RemoveEntityFromArchetype(EntityData& ent)
 //--------------------------------------
 // EcsController::GetComponentsAndTypes
 //
-T_CompTypeList EcsController::GetComponentsAndTypes(EntityData& ent, std::vector<RawComponentPtr>& components)
+// Both lists are allocated in scratch memory and are only valid within the callers scratch scope
+//
+EcsController::T_ScratchTypeList EcsController::GetComponentsAndTypes(EntityData& ent, T_ScratchComponentList& components)
 {
-	T_CompTypeList compTypes = ent.archetype->GetSignature().GetTypes();
+	T_CompTypeList const& sigTypes = ent.archetype->GetSignature().GetTypes();
+	T_ScratchTypeList compTypes(sigTypes.cbegin(), sigTypes.cend());
+
+	components.reserve(components.size() + compTypes.size());
 	for (T_CompTypeIdx const type : compTypes)
 	{
 		components.emplace_back(type, ent.archetype->GetPool(type).At(ent.index));
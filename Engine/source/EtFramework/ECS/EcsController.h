@@ -38,6 +38,10 @@ class EcsController final
 		std::unordered_map<T_Hash, Archetype*> archetypes;
 	};
 
+	// temporary lists used during structural changes
+	typedef core::ScratchVector<T_CompTypeIdx> T_ScratchTypeList;
+	typedef core::ScratchVector<RawComponentPtr> T_ScratchComponentList;
+
 	struct RegisteredSystem final
 	{
 		struct ArchetypeLayer
@@ -94,10 +98,16 @@ public:
 	template<typename TComponentType, typename... Args>
 	void AddComponents(T_EntityId const entity, TComponentType& component1, Args... args);
 	void AddComponents(T_EntityId const entity, std::vector<RawComponentPtr>& components);
+	void AddComponents(T_EntityId const entity, RawComponentPtr* const components, size_t const count);
+	void AddComponentsToEntities(T_EntityId const* const entities,
+		size_t const entityCount,
+		RawComponentPtr* const components,
+		size_t const* const componentCounts);
 
 	template<typename TComponentType, typename... Args>
 	void RemoveComponents(T_EntityId const entity);
 	void RemoveComponents(T_EntityId const entity, T_CompTypeList const& componentTypes);
+	void RemoveComponents(T_EntityId const entity, T_CompTypeIdx const* const componentTypes, size_t const count);
 
 	// component events
 	template<typename TComponentType>
@@ -152,10 +162,10 @@ public:
 	// utility
 	//---------
 private:
-	Archetype* FindOrCreateArchetype(ComponentSignature const& sig, uint8 const layer);
-	void MoveArchetype(T_EntityId const entId, EntityData& ent, T_CompTypeList const& compTypes, std::vector<RawComponentPtr> const& components);
+	Archetype* FindOrCreateArchetype(T_ScratchTypeList compTypes, uint8 const layer);
+	void MoveArchetype(T_EntityId const entId, EntityData& ent, T_ScratchTypeList const& compTypes, T_ScratchComponentList const& components);
 	void RemoveEntityFromArchetype(EntityData& ent);
-	T_CompTypeList GetComponentsAndTypes(EntityData& ent, std::vector<RawComponentPtr>& components);
+	T_ScratchTypeList GetComponentsAndTypes(EntityData& ent, T_ScratchComponentList& components);
 
 	void RemoveEntityFromParent(T_EntityId const entity, T_EntityId const parent);
 
@@ -2,6 +2,7 @@
 #include "EntityFwd.h"
 
 #include <EtCore/Util/GenericEventDispatcher.h>
+#include <EtCore/Memory/PoolAllocated.h>
 
 
 namespace et {
@@ -40,7 +41,7 @@ enum E_EcsEvent : T_EcsEvent
 //---------------------------
 // ComponentEventData
 //
-struct ComponentEventData
+struct ComponentEventData : public core::PoolAllocated<ComponentEventData>
 {
 public:
 	ComponentEventData(EcsController* const ecsController, void* const comp, T_EntityId const e) 
@@ -63,7 +64,7 @@ typedef T_ComponentEventDispatcher::T_CallbackFn T_ComponentEventCallbackInterna
 //---------------------------
 // EntityEventData
 //
-struct EntityEventData
+struct EntityEventData : public core::PoolAllocated<EntityEventData>
 {
 public:
 	EntityEventData(EcsController* const ecsController, T_EntityId const e)
@@ -35,6 +35,7 @@ public:
 	// interface
 	//-----------
 	virtual T_SystemType GetTypeId() const = 0;
+	virtual char const* GetTypeName() const = 0; // static lifetime, used for profiling
 	virtual ComponentSignature GetSignature() const = 0;
 
 	// the important one
@@ -89,6 +90,7 @@ public:
 	// System Base interface implementation
 	//--------------------------------------
 	T_SystemType GetTypeId() const override;
+	char const* GetTypeName() const override;
 	ComponentSignature GetSignature() const override;
 
 	void RootProcess(EcsController* const controller, Archetype* const archetype, size_t const offset, size_t const count) override;
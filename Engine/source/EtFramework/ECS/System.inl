@@ -78,6 +78,17 @@ T_SystemType fw::System<TSystemType, TViewType>::GetTypeId() const
 	return rttr::type::get<TSystemType>().get_id();
 }
 
+//---------------------
+// System::GetTypeName
+//
+// The name is owned by the type registry and stays valid for the lifetime of the program
+//
+template <class TSystemType, typename TViewType>
+char const* fw::System<TSystemType, TViewType>::GetTypeName() const
+{
+	return rttr::type::get<TSystemType>().get_name().data();
+}
+
 //---------------------
 // System::GetSignature
 //
@@ -91,10 +102,12 @@ ComponentSignature fw::System<TSystemType, TViewType>::GetSignature() const
 // System::RootProcess
 //
 // Implements the low level accessible base process method by generating a range for the derived system class to use
+//  - views and other temporaries created while processing are released once the range is done
 //
 template <class TSystemType, typename TViewType>
 void System<TSystemType, TViewType>::RootProcess(EcsController* const control, Archetype* const archetype, size_t const offset, size_t const count) 
 {
+	core::ScratchScope const scratchScope;
 	Process(ComponentRange<TViewType>(control, archetype, offset, count));
 }
 	
@@ -2,7 +2,11 @@
 #include "PhysicsManager.h"
 
 #include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include "BulletETM.h"
+#include "PhysicsTaskScheduler.h"
 
 
 namespace et {
@@ -12,14 +16,40 @@ namespace fw {
 PhysicsManager::PhysicsManager() { }
 PhysicsManager::~PhysicsManager() { Destroy(); }
 
-void PhysicsManager::Initialize()
+//---------------------------------
+// PhysicsManager::Initialize
+//
+// Create the shared bullet objects, multithreaded worlds use the thread safe variants of the dispatcher and solver
+//  - a thread count of zero uses all hardware threads
+//
+void PhysicsManager::Initialize(bool const multithreaded, uint32 const threadCount)
 {
 	if (m_IsInitialized)return;
 
-	m_pCollisionConfiguration = new btDefaultCollisionConfiguration();
-	m_pDispatcher = new btCollisionDispatcher(m_pCollisionConfiguration);
 	m_pOverlappingPairCache = new btDbvtBroadphase();
-	m_pSolver = new btSequentialImpulseConstraintSolver;
+
+	if (multithreaded)
+	{
+		// collision algorithms are allocated from pools shared by all threads, so they need more room up front
+		btDefaultCollisionConstructionInfo constructionInfo;
+		constructionInfo.m_defaultMaxPersistentManifoldPoolSize = 80000;
+		constructionInfo.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+		m_pCollisionConfiguration = new btDefaultCollisionConfiguration(constructionInfo);
+
+		m_pDispatcher = new btCollisionDispatcherMt(m_pCollisionConfiguration);
+		m_pSolverPool = new btConstraintSolverPoolMt(BT_MAX_THREAD_COUNT);
+		m_pSolver = new btSequentialImpulseConstraintSolverMt();
+
+		uint32 const hardwareThreads = static_cast<uint32>(std::thread::hardware_concurrency());
+		m_pTaskScheduler = new PhysicsTaskScheduler((threadCount == 0u) ? std::max(hardwareThreads, 1u) : threadCount);
+		btSetTaskScheduler(m_pTaskScheduler);
+	}
+	else
+	{
+		m_pCollisionConfiguration = new btDefaultCollisionConfiguration();
+		m_pDispatcher = new btCollisionDispatcher(m_pCollisionConfiguration);
+		m_pSolver = new btSequentialImpulseConstraintSolver;
+	}
 
 	m_IsInitialized = true;
 }
@@ -32,14 +62,31 @@ void PhysicsManager::Destroy()
 	for (auto shape : m_pShapes)delete shape;
 	m_pShapes.clear();
 
+	if (m_pTaskScheduler != nullptr)
+	{
+		btSetTaskScheduler(btGetSequentialTaskScheduler());
+		delete m_pTaskScheduler;
+		m_pTaskScheduler = nullptr;
+	}
+
 	delete m_pSolver;
+	delete m_pSolverPool;
+	m_pSolverPool = nullptr;
 	delete m_pOverlappingPairCache;
 	delete m_pDispatcher;
 	delete m_pCollisionConfiguration;
 }
 
+//---------------------------------
+// PhysicsManager::CreateWorld
+//
 btDiscreteDynamicsWorld* PhysicsManager::CreateWorld()
 {
+	if (m_pTaskScheduler != nullptr)
+	{
+		return new btDiscreteDynamicsWorldMt(m_pDispatcher, m_pOverlappingPairCache, m_pSolverPool, m_pSolver, m_pCollisionConfiguration);
+	}
+
 	btDiscreteDynamicsWorld* pWorld = new btDiscreteDynamicsWorld(m_pDispatcher, m_pOverlappingPairCache, m_pSolver, m_pCollisionConfiguration);
 	return pWorld;
 }
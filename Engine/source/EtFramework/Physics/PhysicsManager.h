@@ -5,7 +5,8 @@
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 class btBroadphaseInterface;
-class btSequentialImpulseConstraintSolver;
+class btConstraintSolver;
+class btConstraintSolverPoolMt;
 
 class btDiscreteDynamicsWorld;
 
@@ -18,10 +19,19 @@ namespace et {
 namespace fw {
 
 
+class PhysicsTaskScheduler;
+
+
+//---------------------------------
+// PhysicsManager
+//
+// Owns the bullet objects that are shared between physics worlds
+//  - multithreaded worlds step on a task scheduler that is registered with bullet for the lifetime of the manager
+//
 class PhysicsManager : public core::Singleton<PhysicsManager>
 {
 public:
-	void Initialize();
+	void Initialize(bool const multithreaded = false, uint32 const threadCount = 0u);
 	void Destroy();
 
 	btDiscreteDynamicsWorld* CreateWorld();
@@ -29,13 +39,18 @@ public:
 	btBoxShape* CreateBoxShape(const vec3 &halfExtents);
 	btSphereShape* CreateSphereShape(float radius);
 
+	bool IsMultithreaded() const { return m_pTaskScheduler != nullptr; }
+
 private:
 	bool m_IsInitialized = false;
 
 	btDefaultCollisionConfiguration* m_pCollisionConfiguration = nullptr;
 	btCollisionDispatcher* m_pDispatcher = nullptr;
 	btBroadphaseInterface* m_pOverlappingPairCache = nullptr;
-	btSequentialImpulseConstraintSolver* m_pSolver = nullptr;
+	btConstraintSolver* m_pSolver = nullptr;
+	btConstraintSolverPoolMt* m_pSolverPool = nullptr; // only used by multithreaded worlds
+
+	PhysicsTaskScheduler* m_pTaskScheduler = nullptr;
 
 	btDiscreteDynamicsWorld* m_pPhysicsWorld = nullptr;
 
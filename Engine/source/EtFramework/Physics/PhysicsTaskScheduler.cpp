@@ -0,0 +1,104 @@
+#include "stdafx.h"
+#include "PhysicsTaskScheduler.h"
+
+#include <EtCore/Util/JobPool.h>
+
+
+namespace et {
+namespace fw {
+
+
+//========================
+// Physics Task Scheduler
+//========================
+
+
+//---------------------------------
+// PhysicsTaskScheduler::c-tor
+//
+// The calling thread counts towards the thread count, which is limited by the threads of the job pool
+//
+PhysicsTaskScheduler::PhysicsTaskScheduler(uint32 const threadCount)
+	: btITaskScheduler("ETEngine")
+{
+	m_MaxThreadCount = std::min(core::JobPool::GetInstance()->GetThreadCount(), static_cast<size_t>(getMaxNumThreads()));
+	m_ThreadCount = std::min(static_cast<size_t>(std::max(threadCount, 1u)), m_MaxThreadCount);
+}
+
+//---------------------------------
+// PhysicsTaskScheduler::getMaxNumThreads
+//
+int PhysicsTaskScheduler::getMaxNumThreads() const
+{
+	return BT_MAX_THREAD_COUNT;
+}
+
+//---------------------------------
+// PhysicsTaskScheduler::getNumThreads
+//
+int PhysicsTaskScheduler::getNumThreads() const
+{
+	return static_cast<int>(m_ThreadCount);
+}
+
+//---------------------------------
+// PhysicsTaskScheduler::setNumThreads
+//
+// Thread counts beyond the threads available when the scheduler was created are ignored
+//
+void PhysicsTaskScheduler::setNumThreads(int numThreads)
+{
+	m_ThreadCount = std::min(static_cast<size_t>(std::max(numThreads, 1)), m_MaxThreadCount);
+}
+
+//---------------------------------
+// PhysicsTaskScheduler::parallelFor
+//
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, btIParallelForBody const& body)
+{
+	if (iEnd <= iBegin)
+	{
+		return;
+	}
+
+	core::JobPool::T_GrainFn const func = [&body](size_t const grainIdx, size_t const begin, size_t const end)
+		{
+			UNUSED(grainIdx);
+			body.forLoop(static_cast<int>(begin), static_cast<int>(end));
+		};
+
+	core::JobPool::GetInstance()->Run(static_cast<size_t>(iBegin), static_cast<size_t>(iEnd), static_cast<size_t>(std::max(grainSize, 1)), func, m_ThreadCount);
+}
+
+//---------------------------------
+// PhysicsTaskScheduler::parallelSum
+//
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, btIParallelSumBody const& body)
+{
+	if (iEnd <= iBegin)
+	{
+		return btScalar(0);
+	}
+
+	int32 const clampedGrainSize = std::max(grainSize, 1);
+	std::vector<btScalar> grainSums(static_cast<size_t>((iEnd - iBegin + clampedGrainSize - 1) / clampedGrainSize), btScalar(0));
+
+	core::JobPool::T_GrainFn const func = [&body, &grainSums](size_t const grainIdx, size_t const begin, size_t const end)
+		{
+			grainSums[grainIdx] = body.sumLoop(static_cast<int>(begin), static_cast<int>(end));
+		};
+
+	core::JobPool::GetInstance()->Run(static_cast<size_t>(iBegin), static_cast<size_t>(iEnd), static_cast<size_t>(clampedGrainSize), func, m_ThreadCount);
+
+	btScalar sum = btScalar(0);
+	for (btScalar const grainSum : grainSums)
+	{
+		sum += grainSum;
+	}
+
+	return sum;
+}
+
+
+} // namespace fw
+} // namespace et
@@ -0,0 +1,44 @@
+#pragma once
+#include <LinearMath/btThreads.h>
+
+
+namespace et {
+namespace fw {
+
+
+//---------------------------------
+// PhysicsTaskScheduler
+//
+// Runs the parallel loops of the multithreaded bullet world on the engines shared job pool
+//  - bullet hands out thread indices from a global counter that is never reset and limited to BT_MAX_THREAD_COUNT,
+//    the pool workers live as long as the pool and loops always use the workers with the lowest indices, so only a fixed set of threads ever takes an index
+//  - sums are added up in grain order so that results are deterministic
+//
+class PhysicsTaskScheduler final : public btITaskScheduler
+{
+	// construct destruct
+	//--------------------
+public:
+	PhysicsTaskScheduler(uint32 const threadCount);
+	~PhysicsTaskScheduler() = default;
+
+	// task scheduler interface
+	//--------------------------
+	int getMaxNumThreads() const override;
+	int getNumThreads() const override;
+	void setNumThreads(int numThreads) override;
+
+	void parallelFor(int iBegin, int iEnd, int grainSize, btIParallelForBody const& body) override;
+	btScalar parallelSum(int iBegin, int iEnd, int grainSize, btIParallelSumBody const& body) override;
+
+	// Data
+	///////
+
+private:
+	size_t m_MaxThreadCount = 1u;
+	size_t m_ThreadCount = 1u;
+};
+
+
+} // namespace fw
+} // namespace et
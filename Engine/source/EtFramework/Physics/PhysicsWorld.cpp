@@ -46,11 +46,12 @@ void PhysicsWorld::Deinit()
 	m_pWorld = nullptr;
 }
 
-void PhysicsWorld::Update()
+// Advance the simulation by exactly one internal step - substepping is handled by the fixed step loop of the tick manager
+void PhysicsWorld::Update(float const timestep)
 {
 	if (!m_pWorld) return;
 
-	m_pWorld->stepSimulation(TIME->DeltaTime(), m_MaxSubsteps);
+	m_pWorld->stepSimulation(timestep, 1, timestep);
 }
 
 
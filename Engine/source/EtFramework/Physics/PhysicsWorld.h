@@ -16,14 +16,12 @@ public:
 	void Initialize();
 	void Deinit();
 
-	void Update();
+	void Update(float const timestep);
 
 	btDiscreteDynamicsWorld* GetWorld() const { return m_pWorld; }
 
 private:
 	btDiscreteDynamicsWorld* m_pWorld = nullptr;
-
-	uint32 m_MaxSubsteps = 10;
 };
 
 
@@ -0,0 +1,166 @@
+#include "stdafx.h"
+#include "TransformInterpolator.h"
+
+#include <EtRendering/SceneStructure/RenderScene.h>
+
+#include <EtFramework/Components/TransformComponent.h>
+
+
+namespace et {
+namespace fw {
+
+
+//========================
+// Transform Interpolator
+//========================
+
+
+//------------------------------------
+// TransformInterpolator::BeginStep
+//
+// Called before a fixed step runs
+//  - the state at the end of the previous step becomes the state we blend from
+//  - nodes that didn't move during the previous step have reached their final transform
+//
+void TransformInterpolator::BeginStep(render::Scene& renderScene)
+{
+	size_t entryIdx = 0u;
+	while (entryIdx < m_Entries.size())
+	{
+		Entry& entry = m_Entries[entryIdx];
+		if (entry.movedThisStep)
+		{
+			entry.prevPosition = entry.position;
+			entry.prevRotation = entry.rotation;
+			entry.prevScale = entry.scale;
+
+			entry.movedThisStep = false;
+			++entryIdx;
+			continue;
+		}
+
+		renderScene.UpdateNode(entry.node, math::scale(entry.scale) * math::rotate(entry.rotation) * math::translate(entry.position));
+		RemoveAt(entryIdx);
+	}
+}
+
+//------------------------------------
+// TransformInterpolator::Record
+//
+// A node moved during the current step - nodes that weren't tracked yet start blending from the previous world transform
+//
+void TransformInterpolator::Record(core::T_SlotId const node, mat4 const& prevWorld, mat4 const& world)
+{
+	auto const foundIt = m_EntryIndices.find(node);
+	if (foundIt == m_EntryIndices.cend())
+	{
+		m_EntryIndices.emplace(node, m_Entries.size());
+		m_Entries.emplace_back();
+
+		Entry& entry = m_Entries.back();
+		entry.node = node;
+		math::decomposeTRS(prevWorld, entry.prevPosition, entry.prevRotation, entry.prevScale);
+		math::decomposeTRS(world, entry.position, entry.rotation, entry.scale);
+		entry.movedThisStep = true;
+		return;
+	}
+
+	Entry& entry = m_Entries[foundIt->second];
+	math::decomposeTRS(world, entry.position, entry.rotation, entry.scale);
+	entry.movedThisStep = true;
+}
+
+//------------------------------------
+// TransformInterpolator::Snap
+//
+// Move a node without blending, for instance when it was just created or teleported
+//
+void TransformInterpolator::Snap(render::Scene& renderScene, core::T_SlotId const node, mat4 const& world)
+{
+	Remove(node);
+	renderScene.UpdateNode(node, world);
+}
+
+//------------------------------------
+// TransformInterpolator::Remove
+//
+// Stop tracking a node, should be called before the node is removed from the render scene
+//
+void TransformInterpolator::Remove(core::T_SlotId const node)
+{
+	auto const foundIt = m_EntryIndices.find(node);
+	if (foundIt != m_EntryIndices.cend())
+	{
+		RemoveAt(foundIt->second);
+	}
+}
+
+//------------------------------------
+// TransformInterpolator::Clear
+//
+void TransformInterpolator::Clear()
+{
+	m_Entries.clear();
+	m_EntryIndices.clear();
+}
+
+//------------------------------------
+// TransformInterpolator::Apply
+//
+// Write the blended transforms of all moving nodes into the render scene
+//  - alpha is the progress from the previous to the current simulation step
+//
+void TransformInterpolator::Apply(render::Scene& renderScene, float const alpha) const
+{
+	for (Entry const& entry : m_Entries)
+	{
+		vec3 const position = math::lerp(entry.prevPosition, entry.position, alpha);
+		quat const rotation = math::nlerp(entry.prevRotation, entry.rotation, alpha);
+		vec3 const scale = math::lerp(entry.prevScale, entry.scale, alpha);
+
+		renderScene.UpdateNode(entry.node, math::scale(scale) * math::rotate(rotation) * math::translate(position));
+	}
+}
+
+//------------------------------------
+// TransformInterpolator::Sample
+//
+// Blended world position and rotation of a transform for the current frame
+//  - transforms that aren't tracked are at rest or were snapped (see TransformComponent::SkipInterpolation), so their current state is returned
+//
+void TransformInterpolator::Sample(TransformComponent const& transform, float const alpha, vec3& position, quat& rotation) const
+{
+	auto const foundIt = m_EntryIndices.find(transform.GetNodeId());
+	if (foundIt == m_EntryIndices.cend())
+	{
+		position = transform.GetWorldPosition();
+		rotation = transform.GetWorldRotation();
+		return;
+	}
+
+	Entry const& entry = m_Entries[foundIt->second];
+	position = math::lerp(entry.prevPosition, entry.position, alpha);
+	rotation = math::nlerp(entry.prevRotation, entry.rotation, alpha);
+}
+
+//------------------------------------
+// TransformInterpolator::RemoveAt
+//
+// Swap and pop, keeping the index lookup in sync
+//
+void TransformInterpolator::RemoveAt(size_t const entryIdx)
+{
+	m_EntryIndices.erase(m_Entries[entryIdx].node);
+
+	if (entryIdx != m_Entries.size() - 1u)
+	{
+		m_Entries[entryIdx] = m_Entries.back();
+		m_EntryIndices[m_Entries[entryIdx].node] = entryIdx;
+	}
+
+	m_Entries.pop_back();
+}
+
+
+} // namespace fw
+} // namespace et
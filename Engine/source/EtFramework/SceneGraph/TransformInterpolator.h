@@ -0,0 +1,80 @@
+#pragma once
+#include <EtCore/Containers/slot_map.h>
+
+
+namespace et {
+namespace render {
+	class Scene;
+}
+namespace fw {
+	class TransformComponent;
+}
+}
+
+
+namespace et {
+namespace fw {
+
+
+//----------------------
+// TransformInterpolator
+//
+// Blends render scene nodes between the last two fixed simulation steps, so that movement looks smooth regardless of the frame rate
+//  - only nodes that moved during the latest step are tracked, once a node stops moving it snaps to its final transform and is released
+//  - transforms are blended as translation / rotation / scale in world space
+//  - views that aren't render nodes, like the camera, can sample the same blend so that they move in phase with the scene
+//
+class TransformInterpolator final
+{
+	// definitions
+	//-------------
+	struct Entry final
+	{
+		core::T_SlotId node;
+
+		vec3 prevPosition;
+		quat prevRotation;
+		vec3 prevScale;
+
+		vec3 position;
+		quat rotation;
+		vec3 scale;
+
+		bool movedThisStep;
+	};
+
+	// construct destruct
+	//--------------------
+public:
+	TransformInterpolator() = default;
+
+	// functionality
+	//---------------
+	void BeginStep(render::Scene& renderScene);
+	void Record(core::T_SlotId const node, mat4 const& prevWorld, mat4 const& world);
+	void Snap(render::Scene& renderScene, core::T_SlotId const node, mat4 const& world);
+	void Remove(core::T_SlotId const node);
+	void Clear();
+
+	void Apply(render::Scene& renderScene, float const alpha) const;
+	void Sample(TransformComponent const& transform, float const alpha, vec3& position, quat& rotation) const;
+
+	// accessors
+	//-----------
+	size_t GetActiveCount() const { return m_Entries.size(); }
+
+	// utility
+	//---------
+private:
+	void RemoveAt(size_t const entryIdx);
+
+	// Data
+	///////
+
+	std::vector<Entry> m_Entries;
+	std::unordered_map<core::T_SlotId, size_t> m_EntryIndices;
+};
+
+
+} // namespace fw
+} // namespace et
@@ -5,8 +5,10 @@
 
 #include <EtCore/Util/Context.h>
 #include <EtCore/Content/ResourceManager.h>
+#include <EtCore/UpdateCycle/TickManager.h>
 
 #include <EtFramework/Physics/BulletETM.h>
+#include <EtFramework/Audio/AudioManager.h>
 #include <EtFramework/Systems/TransformSystem.h>
 #include <EtFramework/Systems/RigidBodySystem.h>
 #include <EtFramework/Systems/LightSystem.h>
@@ -82,18 +84,38 @@ void UnifiedScene::Init()
 	m_Scene.RegisterSystem<LightSystem>();
 
 	// allow users of the framework to also register for events
-	m_EventDispatcher.Notify(E_SceneEvent::RegisterSystems, new SceneEventData(this));
+	SceneEventData const eventData(this);
+	m_EventDispatcher.Notify(E_SceneEvent::RegisterSystems, &eventData);
 }
 
-//----------------------
+//----------------------------
+// UnifiedScene::OnFixedTick
+//
+// Advance the simulation by one fixed step - ECS systems and physics run zero or more times per frame
+//
+void UnifiedScene::OnFixedTick()
+{
+	if (m_CurrentScene != 0u)
+	{
+		m_TransformInterpolator.BeginStep(m_RenderScene);
+
+		m_Scene.Process();
+		m_PhysicsWorld.Update(core::TickManager::GetInstance()->GetFixedTimestep());
+	}
+}
+
+//-----------------------
 // UnifiedScene::OnTick
 //
+// Once per frame - blend render transforms between the last two simulation steps, and assign audio sources to the most audible voices
+//
 void UnifiedScene::OnTick()
 {
 	if (m_CurrentScene != 0u)
 	{
-		m_Scene.Process();
-		m_PhysicsWorld.Update();
+		m_TransformInterpolator.Apply(m_RenderScene, core::TickManager::GetInstance()->GetInterpolationAlpha());
+
+		AudioManager::GetInstance()->GetVoiceManager().Update(m_Context.time->DeltaTime());
 
 		// update camera in render scene
 	}
@@ -108,7 +130,8 @@ void UnifiedScene::LoadScene(core::HashString const assetId)
 	//-------------
 
 	// notification before beginning the process so systems can prepare (splash screen, loading bar, timer etc)
-	m_EventDispatcher.Notify(E_SceneEvent::SceneSwitch, new SceneEventData(this));
+	SceneEventData const switchEvent(this);
+	m_EventDispatcher.Notify(E_SceneEvent::SceneSwitch, &switchEvent);
 
 	if (m_CurrentScene != 0u)
 	{
@@ -170,7 +193,8 @@ void UnifiedScene::LoadScene(core::HashString const assetId)
 
 	// done loading
 	//--------------
-	m_EventDispatcher.Notify(E_SceneEvent::Activated, new SceneEventData(this));
+	SceneEventData const activatedEvent(this);
+	m_EventDispatcher.Notify(E_SceneEvent::Activated, &activatedEvent);
 	m_Context.time->Start();
 }
 
@@ -180,10 +204,12 @@ void UnifiedScene::LoadScene(core::HashString const assetId)
 void UnifiedScene::UnloadScene()
 {
 	// notification first
-	m_EventDispatcher.Notify(E_SceneEvent::Deactivated, new SceneEventData(this));
+	SceneEventData const eventData(this);
+	m_EventDispatcher.Notify(E_SceneEvent::Deactivated, &eventData);
 
 	// clear
 	m_Scene.RemoveAllEntities();
+	m_TransformInterpolator.Clear();
 
 	// reset rendering
 	m_RenderScene.SetSkyboxMap(core::HashString());
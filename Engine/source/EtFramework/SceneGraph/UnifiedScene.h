@@ -1,6 +1,7 @@
 #pragma once
 #include "SceneEvents.h"
 #include "SceneDescriptor.h"
+#include "TransformInterpolator.h"
 
 #include <EtCore/Util/Context.h>
 #include <EtCore/UpdateCycle/Tickable.h>
@@ -41,6 +42,7 @@ public:
 	// tickable interface
 	//--------------------
 protected:
+	void OnFixedTick() override;
 	void OnTick() override;
 
 	// functionality
@@ -59,6 +61,7 @@ public:
 
 	render::Scene& GetRenderScene() { return m_RenderScene; }
 	PhysicsWorld& GetPhysicsWorld() { return m_PhysicsWorld; }
+	TransformInterpolator& GetTransformInterpolator() { return m_TransformInterpolator; }
 
 	T_SceneEventDispatcher& GetEventDispatcher() { return m_EventDispatcher; }
 
@@ -81,6 +84,7 @@ private:
 
 	render::Scene m_RenderScene;
 	PhysicsWorld m_PhysicsWorld;
+	TransformInterpolator m_TransformInterpolator;
 
 	T_SceneEventDispatcher m_EventDispatcher;
 };
@@ -73,6 +73,8 @@ void RigidBodySystem::OnComponentRemoved(EcsController& controller, RigidBodyCom
 //
 // Synchronize physics transforms
 //  - if the rigid body was externally transformed, it moves the rigid body, otherwise the rigid body moves the transform
+//  - static and sleeping bodies don't move, so they are skipped without touching the transform, which keeps its flags clean
+//  - transforms are only written when the body actually moved
 //
 void RigidBodySystem::Process(ComponentRange<RigidBodySystemView>& range) 
 {
@@ -84,49 +86,59 @@ void RigidBodySystem::Process(ComponentRange<RigidBodySystemView>& range)
 			continue;
 		}
 
-		// extract bullet transform
-		//--------------------------
-		ET_ASSERT(view.rigidBody->m_Body != nullptr);
+		btRigidBody* const body = view.rigidBody->m_Body;
+		ET_ASSERT(body != nullptr);
 
-		btMotionState* const motionState = view.rigidBody->m_Body->getMotionState();
+		btMotionState* const motionState = body->getMotionState();
 		ET_ASSERT(motionState != nullptr);
 
-		btTransform rbTransform;
-		motionState->getWorldTransform(rbTransform);
-
-		bool modified = false;
+		bool const translationChanged = view.transf->HasTranslationChanged();
+		bool const rotationChanged = view.transf->HasRotationChanged();
 
 		// #todo: deal with transform hierachy
 
-		// deal with translations
-		//--------------------------
-		if (view.transf->HasTranslationChanged())
+		// write external transform changes to the rigid body
+		//-----------------------------------------------------
+		if (translationChanged || rotationChanged)
 		{
-			rbTransform.setOrigin(ToBtVec3(view.transf->GetPosition()));
-			modified = true;
-		}
-		else
-		{
-			view.transf->SetPosition(ToEtmVec3(rbTransform.getOrigin())); // will make flags dirty
+			btTransform rbTransform = body->getWorldTransform();
+			if (translationChanged)
+			{
+				rbTransform.setOrigin(ToBtVec3(view.transf->GetPosition()));
+			}
+
+			if (rotationChanged)
+			{
+				rbTransform.setRotation(ToBtQuat(view.transf->GetRotation()));
+			}
+
+			body->setWorldTransform(rbTransform);
+			body->setInterpolationWorldTransform(rbTransform);
+			motionState->setWorldTransform(rbTransform);
+			body->activate();
+			continue;
 		}
 
-		// deal with rotations
-		//--------------------------
-		if (view.transf->HasRotationChanged())
+		// bullet only updates motion states of active bodies
+		//----------------------------------------------------
+		if (!(body->isActive()))
 		{
-			rbTransform.setRotation(ToBtQuat(view.transf->GetRotation()));
-			modified = true;
+			continue;
 		}
-		else
+
+		btTransform rbTransform;
+		motionState->getWorldTransform(rbTransform);
+
+		vec3 const position = ToEtmVec3(rbTransform.getOrigin());
+		if (!(position == view.transf->GetPosition()))
 		{
-			view.transf->SetRotation(ToEtmQuat(rbTransform.getRotation())); // will also make flags dirty
+			view.transf->SetPosition(position); // will make flags dirty
 		}
 
-		// write back transform changes to rigid body
-		//--------------------------------------------
-		if (modified)
+		quat const rotation = ToEtmQuat(rbTransform.getRotation());
+		if (!math::nearEqualsV(rotation.v4, view.transf->GetRotation().v4))
 		{
-			motionState->setWorldTransform(rbTransform);
+			view.transf->SetRotation(rotation); // will also make flags dirty
 		}
 	}
 }
@@ -38,6 +38,7 @@ void TransformSystem::OnComponentRemoved(EcsController& controller, TransformCom
 	UNUSED(controller);
 	UNUSED(entity);
 
+	UnifiedScene::Instance().GetTransformInterpolator().Remove(component.GetNodeId());
 	UnifiedScene::Instance().GetRenderScene().RemoveNode(component.GetNodeId());
 }
 
@@ -57,10 +58,12 @@ TransformSystem::Compute::Compute()
 // TransformSystem::Compute::Process
 //
 // Update transforms
+//  - the render scene blends towards the new transform over the next simulation step, unless interpolation was skipped
 //
 void TransformSystem::Compute::Process(ComponentRange<TransformSystem::ComputeView>& range) 
 {
 	render::Scene& renderScene = UnifiedScene::Instance().GetRenderScene();
+	TransformInterpolator& interpolator = UnifiedScene::Instance().GetTransformInterpolator();
 
 	for (ComputeView& view : range)
 	{
@@ -70,6 +73,8 @@ void TransformSystem::Compute::Process(ComponentRange<TransformSystem::ComputeVi
 			continue;
 		}
 
+		mat4 const prevWorld = view.transf->m_WorldTransform;
+
 		// this is the local matrix
 		view.transf->m_WorldTransform = math::scale(view.transf->m_Scale) 
 			* math::rotate(view.transf->m_Rotation) 
@@ -98,7 +103,15 @@ void TransformSystem::Compute::Process(ComponentRange<TransformSystem::ComputeVi
 		view.transf->m_Up = math::cross(view.transf->m_Forward, view.transf->m_Right);
 
 		// update in the rendering scene
-		renderScene.UpdateNode(view.transf->m_NodeId, view.transf->m_WorldTransform);
+		if (view.transf->m_IsInterpolated)
+		{
+			interpolator.Record(view.transf->m_NodeId, prevWorld, view.transf->m_WorldTransform);
+		}
+		else
+		{
+			interpolator.Snap(renderScene, view.transf->m_NodeId, view.transf->m_WorldTransform);
+			view.transf->m_IsInterpolated = true;
+		}
 
 		// since we changed our transform we need to set the transform changed flags so that the change trickles down to children
 		view.transf->m_TransformChanged = TransformComponent::E_TransformChanged::All;
@@ -70,6 +70,10 @@ vector<3, T> operator*(const quaternion<T>& q, const vector<3, T>& vec);
 template <typename T>
 quaternion<T>& normalize(quaternion<T>& q);
 
+//normalized linear interpolation along the shortest arc - cheaper than slerp and accurate enough for small angles
+template <typename T>
+quaternion<T> nlerp(const quaternion<T>& lhs, const quaternion<T>& rhs, T const alpha);
+
 //unit quaternion inversion - cheap assuming q is normalized
 template <typename T>
 quaternion<T> inverse(const quaternion<T>& q);
@@ -139,6 +139,17 @@ inline quaternion<T> & normalize(quaternion<T>& q)
 	return q;
 }
 
+template <typename T>
+inline quaternion<T> nlerp(const quaternion<T>& lhs, const quaternion<T>& rhs, T const alpha)
+{
+	// q and -q represent the same rotation, flip the target so we take the short path
+	vector<4, T> const target = (dot(lhs.v4, rhs.v4) < static_cast<T>(0)) ? (rhs.v4 * static_cast<T>(-1)) : rhs.v4;
+
+	quaternion<T> result;
+	result.v4 = math::normalize(lerp(lhs.v4, target, alpha));
+	return result;
+}
+
 template <typename T>
 inline quaternion<T> inverse(const quaternion<T>& q)
 {
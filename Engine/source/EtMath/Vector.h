@@ -298,6 +298,10 @@ vector<n, T> normalize(const vector<n, T> &vec);
 template <uint8 n, class T>
 vector<n, T> pow(const vector<n, T> &vec, T exponent);
 
+//linear interpolation - alpha is not clamped
+template <uint8 n, class T>
+vector<n, T> lerp(const vector<n, T> &lhs, const vector<n, T> &rhs, T const alpha);
+
 //Vectors need to be prenormalized
 //if input vectors are zero it will generate NaN
 template <uint8 n, class T>
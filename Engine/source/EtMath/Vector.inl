@@ -567,6 +567,12 @@ pow(const vector<n, T> &vec, T exponent)
 	return result;
 }
 
+template <uint8 n, class T>
+vector<n, T> lerp(const vector<n, T> &lhs, const vector<n, T> &rhs, T const alpha)
+{
+	return lhs + (rhs - lhs) * alpha;
+}
+
 
 template <uint8 n, class T>
 T angleFastUnsigned(const vector<n, T>& lhs, const vector<n, T>& rhs)
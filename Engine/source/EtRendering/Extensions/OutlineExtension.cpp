@@ -52,6 +52,7 @@ void OutlineExtension::AddMesh(AssetPtr<MeshData> const mesh, render::T_NodeId c
 		foundMeshIt->m_VAO = vao;
 		foundMeshIt->m_IndexCount = static_cast<uint32>(mesh->GetIndexCount());
 		foundMeshIt->m_IndexDataType = mesh->GetIndexDataType();
+		foundMeshIt->m_Lods = mesh->GetLods();
 		foundMeshIt->m_BoundingVolume = mesh->GetBoundingSphere();
 	}
 
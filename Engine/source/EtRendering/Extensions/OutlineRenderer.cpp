@@ -172,6 +172,7 @@ void OutlineRenderer::Draw(T_FbLoc const targetFb,
 	ShaderData const* const shader = mat->GetShader();
 
 	api->SetShader(shader);
+	ShaderData::UniformHandle const modelHandle = shader->GetUniformHandle("model"_hash);
 	shader->Upload("uViewSize"_hash, math::vecCast<float>(dim));
 
 	shader->Upload("uOcclusionFactor"_hash, 0.15f);
@@ -194,7 +195,7 @@ void OutlineRenderer::Draw(T_FbLoc const targetFb,
 
 				if (cam.GetFrustum().ContainsSphere(instSphere) != VolumeCheck::OUTSIDE)
 				{
-					shader->Upload("model"_hash, transform);
+					shader->Upload(modelHandle, transform);
 					api->DrawElements(E_DrawMode::Triangles, mesh.m_IndexCount, mesh.m_IndexDataType, 0);
 				}
 			}
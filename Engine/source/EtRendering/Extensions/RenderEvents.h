@@ -1,5 +1,6 @@
 #pragma once
 #include <EtCore/Util/GenericEventDispatcher.h>
+#include <EtCore/Memory/PoolAllocated.h>
 
 
 namespace et {
@@ -32,8 +33,9 @@ enum E_RenderEvent : T_RenderEventFlags
 // RenderEventData
 //
 // Base scene event data contains only event type and source renderer, but can be derived from to provide additional data
+//  - allocated from a pool as events are sent several times per frame
 //
-struct RenderEventData
+struct RenderEventData : public core::PoolAllocated<RenderEventData>
 {
 public:
 	RenderEventData(I_ViewportRenderer const* const r, T_FbLoc const fb) : renderer(r), targetFb(fb) {}
@@ -76,8 +76,20 @@ void AtmospherePrecompute::Unload()//unload textures and fbos needed for precomp
 	m_IsInitialized = false;
 }
 
+//---------------------------------
+// AtmospherePrecompute::Precalculate
+//
+// Compute the look up textures of an atmosphere, unless they were cached by a previous run
+//  - the precomputation resources are only initialized when the tables actually need to be computed
+//
 void AtmospherePrecompute::Precalculate(Atmosphere* atmo)
 {
+	PrecomputeCache::T_Key const cacheKey = GetCacheKey(atmo->m_Params);
+	if (LoadCached(atmo, cacheKey))
+	{
+		return;
+	}
+
 	if (!m_IsInitialized)
 	{
 		Init();
@@ -231,6 +243,70 @@ void AtmospherePrecompute::Precalculate(Atmosphere* atmo)
 	api->SetBlendEnabled(false);
 
 	Unload();
+
+	RenderingSystems::Instance()->GetPrecomputeCache().Store(cacheKey, 
+		std::vector<TextureData const*>({ atmo->m_TexTransmittance, atmo->m_TexIrradiance, atmo->m_TexInscatter }));
+}
+
+//---------------------------------
+// AtmospherePrecompute::GetCacheKey
+//
+// The tables depend on the atmosphere parameters and the layout of the textures they are stored in
+//
+PrecomputeCache::T_Key AtmospherePrecompute::GetCacheKey(AtmosphereParameters const& params) const
+{
+	int32 const layout[] = {
+		m_Settings.TRANSMITTANCE_W,
+		m_Settings.TRANSMITTANCE_H,
+		m_Settings.IRRADIANCE_W,
+		m_Settings.IRRADIANCE_H,
+		m_Settings.INSCATTER_R,
+		m_Settings.INSCATTER_MU,
+		m_Settings.INSCATTER_MU_S,
+		m_Settings.INSCATTER_NU,
+		static_cast<int32>(AtmosphereSettings::INTERNAL2D),
+		static_cast<int32>(AtmosphereSettings::INTERNAL3D),
+		static_cast<int32>(PrecomputeCache::s_Version)
+	};
+
+	uint64 const layoutHash = GetDataHash64(reinterpret_cast<uint8 const*>(layout), sizeof(layout), "atmosphere"_hash);
+	return GetDataHash64(reinterpret_cast<uint8 const*>(&params), sizeof(AtmosphereParameters), layoutHash);
+}
+
+//---------------------------------
+// AtmospherePrecompute::LoadCached
+//
+// Restore the look up textures of an atmosphere from the precompute cache
+//
+bool AtmospherePrecompute::LoadCached(Atmosphere* const atmo, PrecomputeCache::T_Key const key) const
+{
+	std::vector<TextureData*> textures;
+	if (!RenderingSystems::Instance()->GetPrecomputeCache().Load(key, textures))
+	{
+		return false;
+	}
+
+	if (textures.size() != 3u)
+	{
+		LOG("AtmospherePrecompute::LoadCached > Unexpected texture count in cache entry, recomputing", core::LogLevel::Warning);
+		for (TextureData* const texture : textures)
+		{
+			delete texture;
+		}
+
+		return false;
+	}
+
+	atmo->m_TexTransmittance = textures[0];
+	atmo->m_TexIrradiance = textures[1];
+	atmo->m_TexInscatter = textures[2];
+
+	for (TextureData* const texture : textures)
+	{
+		texture->SetParameters(m_Settings.m_TexParams);
+	}
+
+	return true;
 }
 
 void AtmospherePrecompute::SetUniforms(ShaderData* shader, TextureData* transmittance, TextureData* scattering, TextureData* irradiance, TextureData* mie)
@@ -243,11 +319,13 @@ void AtmospherePrecompute::SetUniforms(ShaderData* shader, TextureData* transmit
 	shader->Upload("uTexMie"_hash, static_cast<TextureData const*>(mie));
 }
 
-void AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(const std::vector<double>& wavelengths,
-	const std::vector<double>& solar_irradiance, double lambda_power, dvec3 &color)
+void AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(CIE const& cie, 
+	const std::vector<double>& wavelengths,
+	const std::vector<double>& solar_irradiance, 
+	double lambda_power, 
+	dvec3 &color)
 {
 	color = dvec3(0);
-	CIE& cie = RenderingSystems::Instance()->GetCie();
 	int32 dlambda = 1;
 	dvec3 lambdaVec = dvec3(AtmosphereSettings::kLambdaR, AtmosphereSettings::kLambdaG, AtmosphereSettings::kLambdaB);
 	dvec3 solarRGB = cie.Interpolate(wavelengths, solar_irradiance, lambdaVec);
@@ -3,6 +3,8 @@
 
 #include <EtRendering/PlanetTech/AtmosphereSettings.h>
 
+#include "PrecomputeCache.h"
+
 
 namespace et {
 namespace render {
@@ -23,11 +25,19 @@ public:
 	void SetUniforms(ShaderData* shader, TextureData* transmittance,
 		TextureData* scattering, TextureData* irradiance, TextureData* mie);
 
-	static void ComputeSpectralRadianceToLuminanceFactors(const std::vector<double>& wavelengths, const std::vector<double>& solar_irradiance, double lambda_power, dvec3 &color);
+	static void ComputeSpectralRadianceToLuminanceFactors(CIE const& cie, 
+		const std::vector<double>& wavelengths, 
+		const std::vector<double>& solar_irradiance, 
+		double lambda_power, 
+		dvec3 &color);
 
 	const AtmosphereSettings& GetSettings() { return m_Settings; }
 
+	PrecomputeCache::T_Key GetCacheKey(AtmosphereParameters const& params) const;
+
 private:
+	bool LoadCached(Atmosphere* const atmo, PrecomputeCache::T_Key const key) const;
+
 	void ConvertSpectrumToLinearSrgb(const std::vector<double>& wavelengths, const std::vector<double>& spectrum, dvec3 &rgb);
 
 	friend class Atmosphere;// #temp
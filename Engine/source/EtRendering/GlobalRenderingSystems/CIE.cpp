@@ -11,19 +11,46 @@ namespace et {
 namespace render {
 
 
+//---------------------------------
+// CIE::LoadData
+//
+// Load the color matching functions through the resource manager
+//
 void CIE::LoadData()
 {
 	AssetPtr<core::StubData> jsonCieText = core::ResourceManager::Instance()->GetAssetData<core::StubData>(core::HashString("cie.json"));
 
 	core::JSON::Parser parser = core::JSON::Parser(std::string(jsonCieText->GetText(), jsonCieText->GetLength()));
-	core::JSON::Object* root = parser.GetRoot();
+	if (!Load(parser.GetRoot()))
+	{
+		LOG("CIE::LoadData > Failed to load color matching functions from 'cie.json'", core::LogLevel::Warning);
+	}
+}
+
+//---------------------------------
+// CIE::Load
+//
+// Read the color matching table and the XYZ to RGB conversion from parsed JSON, e.g. when running without a resource manager
+//
+bool CIE::Load(core::JSON::Object* const root)
+{
+	if (root == nullptr)
+	{
+		return false;
+	}
+
+	core::JSON::Value* const jtable = (*root)["2 deg color matching"];
+	core::JSON::Value* const jxyz = (*root)["xyz to rgb"];
+	if ((jtable == nullptr) || (jtable->GetType() != core::JSON::JSON_Array) || (jxyz == nullptr))
+	{
+		return false;
+	}
 
-	m_Table = (*root)["2 deg color matching"]->arr()->NumArr();
-	auto jxyz = (*root)["xyz to rgb"];
-	core::JSON::ArrayMatrix(jxyz, m_CieToRgb);
+	m_Table = jtable->arr()->NumArr();
+	return core::JSON::ArrayMatrix(jxyz, m_CieToRgb);
 }
 
-dvec3 CIE::GetValue(double wavelength, double lambdaMin, double lambdaMax)
+dvec3 CIE::GetValue(double wavelength, double lambdaMin, double lambdaMax) const
 {
 	dvec3 ret;
 	for (uint8 column = 1; column < 4; ++column)
@@ -42,12 +69,12 @@ dvec3 CIE::GetValue(double wavelength, double lambdaMin, double lambdaMax)
 	return ret;
 }
 
-dvec3 CIE::GetRGB(const dvec3 &xyz)
+dvec3 CIE::GetRGB(const dvec3 &xyz) const
 {
 	return m_CieToRgb * xyz;
 }
 
-double CIE::Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, double wavelength)
+double CIE::Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, double wavelength) const
 {
 	assert(wavelength_function.size() == wavelengths.size());
 	if (wavelength < wavelengths[0])
@@ -65,7 +92,7 @@ double CIE::Interpolate(const std::vector<double>& wavelengths, const std::vecto
 	return wavelength_function[wavelength_function.size() - 1];
 }
 
-dvec3 CIE::Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, const dvec3 &xyz)
+dvec3 CIE::Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, const dvec3 &xyz) const
 {
 	dvec3 ret = dvec3();
 	for (uint8 i = 0; i < 3; ++i)
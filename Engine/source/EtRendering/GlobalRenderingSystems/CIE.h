@@ -1,22 +1,38 @@
 #pragma once
 
+
+namespace et { namespace core { namespace JSON {
+	struct Object;
+} } }
+
+
 namespace et {
 namespace render {
 
 
+//---------------------------------
+// CIE
+//
+// Color matching functions for converting spectral quantities to RGB
+//  - doesn't depend on a graphics context, so the spectral integration of the atmosphere parameters can run headless
+//
 class CIE final
 {
 public:
-	void LoadData();
-	dvec3 GetValue(double wavelength, double lambdaMin, double lambdaMax);
-	dvec3 GetRGB(const dvec3 &xyz);
-	double Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, double wavelength);
-	dvec3 Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, const dvec3 &xyz);
-private:
-	friend class RenderingSystems;
 	CIE() = default;
 	~CIE() = default;
 
+	void LoadData();
+	bool Load(core::JSON::Object* const root);
+
+	bool IsLoaded() const { return !m_Table.empty(); }
+
+	dvec3 GetValue(double wavelength, double lambdaMin, double lambdaMax) const;
+	dvec3 GetRGB(const dvec3 &xyz) const;
+	double Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, double wavelength) const;
+	dvec3 Interpolate(const std::vector<double>& wavelengths, const std::vector<double>& wavelength_function, const dvec3 &xyz) const;
+
+private:
 	std::vector<double> m_Table;
 	dmat3 m_CieToRgb;
 };
@@ -4,6 +4,7 @@
 #include <rttr/registration>
 
 #include <EtCore/Content/ResourceManager.h>
+#include <EtCore/FileSystem/FileUtil.h>
 
 
 namespace et {
@@ -112,12 +113,14 @@ void RenderingSystems::RemoveReference()
 // RenderingSystems::Initialize
 //
 // Called upon first reference creation, and initializes all rendering systems
+//  - precomputed textures are cached next to the executable unless the application points the cache elsewhere
+//  - atmosphere precomputation resources are only created once an atmosphere isn't found in the cache
 //
 void RenderingSystems::Initialize()
 {
 	m_SharedVarController.Init();
 
-	m_AtmospherePrecompute.Init();
+	m_PrecomputeCache.SetDirectory(core::FileUtil::GetExecutableDir() + PrecomputeCache::s_DirectoryName);
 
 	m_Cie.LoadData();
 	m_PbrPrefilter.Precompute(m_GraphicsSettings.PbrBrdfLutSize);
@@ -4,6 +4,7 @@
 #include "PrimitiveRenderer.h"
 #include "PbrPrefilter.h"
 #include "AtmospherePrecompute.h"
+#include "PrecomputeCache.h"
 #include "CIE.h"
 #include "LightVolume.h"
 #include "SharedVarController.h"
@@ -64,6 +65,7 @@ public:
 	DirectLightVolume& GetDirectLightVolume() { return m_DirectLightVolume; }
 	PointLightVolume& GetPointLightVolume() { return m_PointLightVolume; }
 	AtmospherePrecompute& GetAtmospherPrecompute() { return m_AtmospherePrecompute; }
+	PrecomputeCache& GetPrecomputeCache() { return m_PrecomputeCache; }
 	Patch& GetPatch() { return m_Patch; }
 	Material const* GetNullMaterial() const { return m_NullMaterial.get(); }
 	Material const* GetColorMaterial() const { return m_ColorMaterial.get(); }
@@ -86,6 +88,7 @@ private:
 	PointLightVolume m_PointLightVolume;
 
 	AtmospherePrecompute m_AtmospherePrecompute;
+	PrecomputeCache m_PrecomputeCache;
 	Patch m_Patch;
 
 	AssetPtr<Material> m_NullMaterial;
@@ -0,0 +1,260 @@
+#include "stdafx.h"
+#include "PrecomputeCache.h"
+
+#include <iomanip>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+
+#include <EtRendering/GraphicsTypes/TextureData.h>
+
+
+namespace et {
+namespace render {
+
+
+namespace {
+
+	//---------------------------------
+	// PrecomputeFileHeader
+	//
+	// Start of a cache entry, followed by textureCount textures
+	//
+	struct PrecomputeFileHeader
+	{
+		static uint32 const s_Magic = 0x50435445u; // "ETCP"
+
+		uint32 magic;
+		uint32 version;
+		uint32 textureCount;
+	};
+
+	//---------------------------------
+	// PrecomputeFileTexture
+	//
+	// Description of a texture, followed by the data of its levels as returned by TextureData::GetLevelDataSize
+	//
+	struct PrecomputeFileTexture
+	{
+		uint8 targetType;
+		uint8 internalFormat;
+		uint8 format;
+		uint8 dataType;
+		uint32 levelCount;
+		int32 width;
+		int32 height;
+		int32 depth;
+	};
+
+} // namespace
+
+
+//===================
+// Precompute Cache
+//===================
+
+
+// static
+uint32 const PrecomputeCache::s_Version = 1u;
+std::string const PrecomputeCache::s_DirectoryName("precompute_cache");
+
+
+//---------------------------------
+// PrecomputeCache::SetDirectory
+//
+// Ensures the cache directory exists, an empty directory disables the cache
+//
+void PrecomputeCache::SetDirectory(std::string const& directory)
+{
+	m_Directory = directory;
+	if (m_Directory.empty())
+	{
+		return;
+	}
+
+	core::Directory* const dir = new core::Directory(m_Directory, nullptr, true);
+	delete dir;
+}
+
+//---------------------------------
+// PrecomputeCache::Load
+//
+// Create the textures of an entry, fails without side effects if there is no valid entry for the key
+//
+bool PrecomputeCache::Load(T_Key const key, std::vector<TextureData*>& textures) const
+{
+	if (!IsEnabled())
+	{
+		return false;
+	}
+
+	std::string const filePath = GetFilePath(key);
+	{
+		std::ifstream const cachedFile(filePath, std::ios::binary);
+		if (!cachedFile.good())
+		{
+			return false;
+		}
+	}
+
+	std::vector<uint8> data;
+	core::File* const file = new core::File(filePath, nullptr);
+	if (file->Open(core::FILE_ACCESS_MODE::Read))
+	{
+		data = file->Read();
+		file->Close();
+	}
+
+	delete file;
+
+	PrecomputeFileHeader header;
+	if (data.size() < sizeof(PrecomputeFileHeader))
+	{
+		LOG("PrecomputeCache::Load > Cache entry '" + filePath + std::string("' is truncated"), core::LogLevel::Warning);
+		return false;
+	}
+
+	memcpy(&header, data.data(), sizeof(PrecomputeFileHeader));
+	if ((header.magic != PrecomputeFileHeader::s_Magic) || (header.version != s_Version))
+	{
+		LOG("PrecomputeCache::Load > Cache entry '" + filePath + std::string("' is outdated"), core::LogLevel::Warning);
+		return false;
+	}
+
+	std::vector<TextureData*> loaded;
+	size_t offset = sizeof(PrecomputeFileHeader);
+	bool isValid = true;
+	for (uint32 texIdx = 0u; texIdx < header.textureCount; ++texIdx)
+	{
+		PrecomputeFileTexture fileTexture;
+		if (offset + sizeof(PrecomputeFileTexture) > data.size())
+		{
+			isValid = false;
+			break;
+		}
+
+		memcpy(&fileTexture, data.data() + offset, sizeof(PrecomputeFileTexture));
+		offset += sizeof(PrecomputeFileTexture);
+
+		ivec2 const res(fileTexture.width, fileTexture.height);
+		E_TextureType const targetType = static_cast<E_TextureType>(fileTexture.targetType);
+
+		TextureData* texture = nullptr;
+		if (targetType == E_TextureType::CubeMap)
+		{
+			texture = new TextureData(E_TextureType::CubeMap, res);
+		}
+		else
+		{
+			texture = new TextureData(res,
+				static_cast<E_ColorFormat>(fileTexture.internalFormat),
+				static_cast<E_ColorFormat>(fileTexture.format),
+				static_cast<E_DataType>(fileTexture.dataType),
+				fileTexture.depth);
+		}
+
+		loaded.push_back(texture);
+
+		std::vector<TextureData::MipLevel> levels;
+		for (uint32 levelIdx = 0u; levelIdx < fileTexture.levelCount; ++levelIdx)
+		{
+			size_t const levelSize = texture->GetLevelDataSize(static_cast<uint8>(levelIdx));
+			if (offset + levelSize > data.size())
+			{
+				isValid = false;
+				break;
+			}
+
+			levels.push_back(TextureData::MipLevel{ data.data() + offset, levelSize });
+			offset += levelSize;
+		}
+
+		if (!isValid || levels.empty() || (texture->GetTargetType() != targetType))
+		{
+			isValid = false;
+			break;
+		}
+
+		texture->BuildMipChain(levels);
+	}
+
+	if (!isValid)
+	{
+		LOG("PrecomputeCache::Load > Cache entry '" + filePath + std::string("' is invalid"), core::LogLevel::Warning);
+		for (TextureData* const texture : loaded)
+		{
+			delete texture;
+		}
+
+		return false;
+	}
+
+	textures = loaded;
+	return true;
+}
+
+//---------------------------------
+// PrecomputeCache::Store
+//
+// Read the textures back from the GPU and write them for a key
+//  - the data goes to a temporary file first, so that an interrupted write never leaves a partial entry
+//
+bool PrecomputeCache::Store(T_Key const key, std::vector<TextureData const*> const& textures) const
+{
+	if (!IsEnabled())
+	{
+		return false;
+	}
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	PrecomputeFileHeader header;
+	header.magic = PrecomputeFileHeader::s_Magic;
+	header.version = s_Version;
+	header.textureCount = static_cast<uint32>(textures.size());
+
+	std::vector<uint8> data(sizeof(PrecomputeFileHeader));
+	memcpy(data.data(), &header, sizeof(PrecomputeFileHeader));
+
+	for (TextureData const* const texture : textures)
+	{
+		ET_ASSERT(texture != nullptr);
+
+		PrecomputeFileTexture fileTexture;
+		fileTexture.targetType = static_cast<uint8>(texture->GetTargetType());
+		fileTexture.internalFormat = static_cast<uint8>(texture->GetInternalFormat());
+		fileTexture.format = static_cast<uint8>(texture->GetFormat());
+		fileTexture.dataType = static_cast<uint8>(texture->GetDataType());
+		fileTexture.levelCount = static_cast<uint32>(std::max(texture->GetNumMipLevels(), 1));
+		fileTexture.width = texture->GetResolution().x;
+		fileTexture.height = texture->GetResolution().y;
+		fileTexture.depth = texture->GetDepth();
+
+		size_t offset = data.size();
+		data.resize(offset + sizeof(PrecomputeFileTexture));
+		memcpy(data.data() + offset, &fileTexture, sizeof(PrecomputeFileTexture));
+
+		for (uint32 levelIdx = 0u; levelIdx < fileTexture.levelCount; ++levelIdx)
+		{
+			offset = data.size();
+			data.resize(offset + texture->GetLevelDataSize(static_cast<uint8>(levelIdx)));
+			api->GetTextureData(*texture, static_cast<uint8>(levelIdx), data.data() + offset);
+		}
+	}
+
+	return core::FileUtil::WriteFileAtomic(GetFilePath(key), data);
+}
+
+//---------------------------------
+// PrecomputeCache::GetFilePath
+//
+std::string PrecomputeCache::GetFilePath(T_Key const key) const
+{
+	std::stringstream stream;
+	stream << m_Directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".precomputed";
+	return stream.str();
+}
+
+
+} // namespace render
+} // namespace et
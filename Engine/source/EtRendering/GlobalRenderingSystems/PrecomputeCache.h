@@ -0,0 +1,54 @@
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+class TextureData;
+
+
+//---------------------------------
+// PrecomputeCache
+//
+// Keeps textures that are expensive to generate on the GPU on disk, so that they are only computed the first time they are needed
+//  - used for the atmosphere look up tables and prefiltered environment maps
+//  - entries are keyed on everything that went into computing them, nothing is ever evicted, deleting the directory resets the cache
+//  - all mip levels of a texture are stored, so that prefiltered mip chains are restored exactly
+//
+class PrecomputeCache final
+{
+	// definitions
+	//-------------
+public:
+	typedef uint64 T_Key;
+
+	static uint32 const s_Version; // increase when a precomputation changes its output
+	static std::string const s_DirectoryName;
+
+	// construct destruct
+	//--------------------
+	PrecomputeCache() = default;
+	~PrecomputeCache() = default;
+
+	// functionality
+	//---------------
+	void SetDirectory(std::string const& directory);
+
+	bool Load(T_Key const key, std::vector<TextureData*>& textures) const;
+	bool Store(T_Key const key, std::vector<TextureData const*> const& textures) const;
+
+	// accessors
+	//-----------
+	bool IsEnabled() const { return !m_Directory.empty(); }
+	std::string GetFilePath(T_Key const key) const;
+
+	// Data
+	///////
+private:
+	std::string m_Directory;
+};
+
+
+} // namespace render
+} // namespace et
@@ -179,6 +179,7 @@ public:
 	void SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const override; 
 
 	void* MapBuffer(E_BufferType const target, E_AccessMode const access) const override;
+	void* MapBufferRange(E_BufferType const target, int64 const offset, int64 const size, bool const unsynchronized) const override;
 	void UnmapBuffer(E_BufferType const target) const override;
 
 	void BindBufferRange(E_BufferType const target,
@@ -190,6 +191,8 @@ public:
 	T_TextureLoc GenerateTexture() const override;
 	void DeleteTexture(T_TextureLoc& texLoc) override;
 	void SetTextureData(TextureData& texture, void* data) override;
+	void SetTextureMipData(TextureData const& texture, uint8 const mipLevel, void const* const data, size_t const size) override;
+	void GetTextureData(TextureData const& texture, uint8 const mipLevel, void* const data) override;
 	void SetTextureParams(TextureData const& texture, 
 		uint8& mipLevels, 
 		TextureParameters& prev, 
@@ -228,6 +228,14 @@ GLenum ConvColorFormat(E_ColorFormat const fmt)
 	case E_ColorFormat::RGBA16f:		return GL_RGBA16F;
 	case E_ColorFormat::RGBA32f:		return GL_RGBA32F;
 	case E_ColorFormat::SRGB:			return GL_SRGB;
+
+	case E_ColorFormat::BC1_RGB:		return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case E_ColorFormat::BC1_SRGB:		return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+	case E_ColorFormat::BC3_RGBA:		return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case E_ColorFormat::BC3_SRGBA:		return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+	case E_ColorFormat::BC5_RG:			return GL_COMPRESSED_RG_RGTC2;
+	case E_ColorFormat::BC7_RGBA:		return GL_COMPRESSED_RGBA_BPTC_UNORM;
+	case E_ColorFormat::BC7_SRGBA:		return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
 	}
 
 	ET_ASSERT(true, "Unhandled color format!");
@@ -1203,6 +1211,23 @@ void* GL_CONTEXT_CLASSNAME::MapBuffer(E_BufferType const target, E_AccessMode co
 	return glMapBuffer(GL_CONTEXT_NS::ConvBufferType(target), GL_CONTEXT_NS::ConvAccessMode(access));
 }
 
+//---------------------------------
+// GlContext::MapBufferRange
+//
+// Map part of a buffer for writing, the previous content of the range is discarded
+//  - unsynchronized mapping skips waiting for the GPU, so the caller must ensure the range isn't in use anymore
+//
+void* GL_CONTEXT_CLASSNAME::MapBufferRange(E_BufferType const target, int64 const offset, int64 const size, bool const unsynchronized) const
+{
+	GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+	if (unsynchronized)
+	{
+		access |= GL_MAP_UNSYNCHRONIZED_BIT;
+	}
+
+	return glMapBufferRange(GL_CONTEXT_NS::ConvBufferType(target), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), access);
+}
+
 //---------------------------------
 // GlContext::UnmapBuffer
 //
@@ -1299,6 +1324,114 @@ void GL_CONTEXT_CLASSNAME::SetTextureData(TextureData& texture, void* data)
 	}
 }
 
+//---------------------------------
+// GlContext::SetTextureMipData
+//
+// Upload a prebuilt mip level, levels are expected in order so that the last one limits sampling
+//  - block compressed internal formats take the data as is, other formats are read with the textures format and data type
+//  - cube maps are stored as RGB16f, so their faces follow each other as RGB half floats
+//
+void GL_CONTEXT_CLASSNAME::SetTextureMipData(TextureData const& texture, uint8 const mipLevel, void const* const data, size_t const size)
+{
+	uint32 const target = GL_CONTEXT_NS::ConvTextureType(texture.GetTargetType());
+	BindTexture(texture.GetTargetType(), texture.GetLocation(), true);
+
+	ivec2 const res = TextureData::GetMipResolution(texture.GetResolution(), mipLevel);
+	GLenum const intFmt = GL_CONTEXT_NS::ConvColorFormat(texture.GetInternalFormat());
+	GLenum const format = GL_CONTEXT_NS::ConvColorFormat(texture.GetFormat());
+	GLenum const dataType = GL_CONTEXT_NS::ConvDataType(texture.GetDataType());
+
+	switch (texture.GetTargetType())
+	{
+	case E_TextureType::Texture2D:
+		if (TextureData::IsCompressedFormat(texture.GetInternalFormat()))
+		{
+			glCompressedTexImage2D(target, static_cast<GLint>(mipLevel), intFmt, res.x, res.y, 0, static_cast<GLsizei>(size), data);
+		}
+		else
+		{
+			glTexImage2D(target, static_cast<GLint>(mipLevel), static_cast<GLint>(intFmt), res.x, res.y, 0, format, dataType, data);
+		}
+
+		break;
+
+	case E_TextureType::Texture3D:
+		ET_ASSERT(!TextureData::IsCompressedFormat(texture.GetInternalFormat()), "3D textures can't be block compressed!");
+		glTexImage3D(target, 
+			static_cast<GLint>(mipLevel), 
+			static_cast<GLint>(intFmt), 
+			res.x, 
+			res.y, 
+			std::max(texture.GetDepth() >> mipLevel, 1), 
+			0, 
+			format, 
+			dataType, 
+			data);
+		break;
+
+	case E_TextureType::CubeMap:
+	{
+		ET_ASSERT(res.x == res.y);
+
+		size_t const faceSize = size / static_cast<size_t>(TextureData::s_NumCubeFaces);
+		for (uint8 face = 0u; face < TextureData::s_NumCubeFaces; ++face)
+		{
+			uint8 const* const faceData = (data != nullptr) ? (static_cast<uint8 const*>(data) + face * faceSize) : nullptr;
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 
+				static_cast<GLint>(mipLevel), 
+				GL_RGB16F, 
+				res.x, 
+				res.y, 
+				0, 
+				GL_RGB, 
+				GL_HALF_FLOAT, 
+				faceData);
+		}
+	}
+	break;
+	}
+
+	glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipLevel));
+}
+
+//---------------------------------
+// GlContext::GetTextureData
+//
+// Read a mip level back from the GPU with the same layout SetTextureMipData expects, so that it can be uploaded again later
+//
+void GL_CONTEXT_CLASSNAME::GetTextureData(TextureData const& texture, uint8 const mipLevel, void* const data)
+{
+	ET_ASSERT(!TextureData::IsCompressedFormat(texture.GetInternalFormat()), "Reading back block compressed textures is not supported!");
+
+	uint32 const target = GL_CONTEXT_NS::ConvTextureType(texture.GetTargetType());
+	BindTexture(texture.GetTargetType(), texture.GetLocation(), true);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	if (texture.GetTargetType() == E_TextureType::CubeMap)
+	{
+		size_t const faceSize = texture.GetLevelDataSize(mipLevel) / static_cast<size_t>(TextureData::s_NumCubeFaces);
+		for (uint8 face = 0u; face < TextureData::s_NumCubeFaces; ++face)
+		{
+			glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 
+				static_cast<GLint>(mipLevel), 
+				GL_RGB, 
+				GL_HALF_FLOAT, 
+				static_cast<uint8*>(data) + face * faceSize);
+		}
+	}
+	else
+	{
+		glGetTexImage(target, 
+			static_cast<GLint>(mipLevel), 
+			GL_CONTEXT_NS::ConvColorFormat(texture.GetFormat()), 
+			GL_CONTEXT_NS::ConvDataType(texture.GetDataType()), 
+			data);
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
 //---------------------------------
 // GlContext::SetTextureParams
 //
@@ -1634,6 +1767,12 @@ void GL_CONTEXT_CLASSNAME::GetActiveUniforms(T_ShaderLoc const program, uint32 c
 	std::string uniName = std::string(name, length);
 	std::string endName;
 
+	// members of uniform blocks have an offset instead of a location
+	GLint blockOffset = -1;
+	GLint arrayStride = 0;
+	glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &blockOffset);
+	glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_ARRAY_STRIDE, &arrayStride);
+
 	// if we have an array of structs, separate out the beginning and end bit so we can create our name with the index
 	if (arrayCount > 1)
 	{
@@ -1663,6 +1802,7 @@ void GL_CONTEXT_CLASSNAME::GetActiveUniforms(T_ShaderLoc const program, uint32 c
 		uni.type = GL_CONTEXT_NS::ParseParamType(type);
 
 		uni.location = glGetUniformLocation(program, uni.name.c_str());
+		uni.blockOffset = (blockOffset >= 0) ? (blockOffset + arrayIdx * arrayStride) : -1;
 	}
 }
 
@@ -97,6 +97,7 @@ public:
 	virtual void SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const = 0; 
 
 	virtual void* MapBuffer(E_BufferType const target, E_AccessMode const access) const = 0;
+	virtual void* MapBufferRange(E_BufferType const target, int64 const offset, int64 const size, bool const unsynchronized) const = 0; // write only
 	virtual void UnmapBuffer(E_BufferType const target) const = 0;
 
 	virtual void BindBufferRange(E_BufferType const target, 
@@ -108,6 +109,8 @@ public:
 	virtual T_TextureLoc GenerateTexture() const = 0;
 	virtual void DeleteTexture(T_TextureLoc& texLoc) = 0;
 	virtual void SetTextureData(TextureData& texture, void* data) = 0;
+	virtual void SetTextureMipData(TextureData const& texture, uint8 const mipLevel, void const* const data, size_t const size) = 0; // levels in order
+	virtual void GetTextureData(TextureData const& texture, uint8 const mipLevel, void* const data) = 0; // see TextureData::GetLevelDataSize
 	virtual void SetTextureParams(TextureData const& texture, 
 		uint8& mipLevels, 
 		TextureParameters& prev, 
@@ -0,0 +1,553 @@
+#include "stdafx.h"
+#include "GraphicsCommandLog.h"
+
+#include <unordered_set>
+
+#include "GraphicsTypes.h"
+
+
+namespace et {
+namespace render {
+
+
+namespace {
+
+	//---------------------------------
+	// E_ResourceKind
+	//
+	// GL objects live in separate namespaces, so the validator keys handles by kind
+	//
+	enum class E_ResourceKind : uint8
+	{
+		VertexArray,
+		Buffer,
+		Texture,
+		Shader,
+		Program,
+		Framebuffer,
+		Renderbuffer,
+
+		None
+	};
+
+	//---------------------------------
+	// E_ResourceAction
+	//
+	enum class E_ResourceAction : uint8
+	{
+		Create,
+		Delete,
+		Use,
+
+		None
+	};
+
+	//---------------------------------
+	// GetResourceAccess
+	//
+	// How a command affects the object referenced by its handle
+	//
+	void GetResourceAccess(E_GraphicsCommand const cmd, E_ResourceKind& kind, E_ResourceAction& action)
+	{
+		kind = E_ResourceKind::None;
+		action = E_ResourceAction::None;
+
+		switch (cmd)
+		{
+		case E_GraphicsCommand::CreateVertexArray:		kind = E_ResourceKind::VertexArray; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteVertexArray:		kind = E_ResourceKind::VertexArray; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::BindVertexArray:		kind = E_ResourceKind::VertexArray; action = E_ResourceAction::Use; return;
+
+		case E_GraphicsCommand::CreateBuffer:			kind = E_ResourceKind::Buffer; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteBuffer:			kind = E_ResourceKind::Buffer; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::BindBuffer:
+		case E_GraphicsCommand::BindBufferRange:		kind = E_ResourceKind::Buffer; action = E_ResourceAction::Use; return;
+
+		case E_GraphicsCommand::GenerateTexture:		kind = E_ResourceKind::Texture; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteTexture:			kind = E_ResourceKind::Texture; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::BindTexture:
+		case E_GraphicsCommand::UnbindTexture:
+		case E_GraphicsCommand::SetTextureData:
+		case E_GraphicsCommand::SetTextureMipData:
+		case E_GraphicsCommand::GetTextureData:
+		case E_GraphicsCommand::SetTextureParams:
+		case E_GraphicsCommand::GetTextureHandle:
+		case E_GraphicsCommand::LinkTextureToFbo:		kind = E_ResourceKind::Texture; action = E_ResourceAction::Use; return;
+
+		case E_GraphicsCommand::CreateShader:			kind = E_ResourceKind::Shader; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteShader:			kind = E_ResourceKind::Shader; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::CompileShader:			kind = E_ResourceKind::Shader; action = E_ResourceAction::Use; return;
+
+		case E_GraphicsCommand::CreateProgram:			kind = E_ResourceKind::Program; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteProgram:			kind = E_ResourceKind::Program; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::SetShader:
+		case E_GraphicsCommand::AttachShader:
+		case E_GraphicsCommand::LinkProgram:
+		case E_GraphicsCommand::BindFragmentDataLocation:
+		case E_GraphicsCommand::SetUniformBlockBinding:
+		case E_GraphicsCommand::PopulateUniform:		kind = E_ResourceKind::Program; action = E_ResourceAction::Use; return;
+
+		case E_GraphicsCommand::GenFramebuffer:			kind = E_ResourceKind::Framebuffer; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteFramebuffer:		kind = E_ResourceKind::Framebuffer; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::BindFramebuffer:
+		case E_GraphicsCommand::BindReadFramebuffer:
+		case E_GraphicsCommand::BindDrawFramebuffer:	kind = E_ResourceKind::Framebuffer; action = E_ResourceAction::Use; return;
+
+		case E_GraphicsCommand::GenRenderbuffer:		kind = E_ResourceKind::Renderbuffer; action = E_ResourceAction::Create; return;
+		case E_GraphicsCommand::DeleteRenderbuffer:		kind = E_ResourceKind::Renderbuffer; action = E_ResourceAction::Delete; return;
+		case E_GraphicsCommand::BindRenderbuffer:
+		case E_GraphicsCommand::LinkRenderbufferToFbo:	kind = E_ResourceKind::Renderbuffer; action = E_ResourceAction::Use; return;
+		}
+	}
+
+	//---------------------------------
+	// GetResourceKey
+	//
+	uint64 GetResourceKey(E_ResourceKind const kind, uint32 const handle)
+	{
+		return (static_cast<uint64>(kind) << 32u) | static_cast<uint64>(handle);
+	}
+
+} // namespace
+
+
+//======================
+// Graphics Command
+//======================
+
+
+//---------------------------------
+// GraphicsCommand::operator==
+//
+bool GraphicsCommand::operator==(GraphicsCommand const& other) const
+{
+	return (type == other.type) && (target == other.target) && (handle == other.handle) && (count == other.count) && (bytes == other.bytes);
+}
+
+
+//======================
+// Graphics Command Log
+//======================
+
+
+// static
+size_t const GraphicsCommandLog::s_NoDifference = std::numeric_limits<size_t>::max();
+
+
+//---------------------------------
+// GraphicsCommandLog::GetCommandName
+//
+char const* GraphicsCommandLog::GetCommandName(E_GraphicsCommand const cmd)
+{
+	switch (cmd)
+	{
+	case E_GraphicsCommand::Initialize:						return "Initialize";
+	case E_GraphicsCommand::SetDepthEnabled:				return "SetDepthEnabled";
+	case E_GraphicsCommand::SetBlendEnabled:				return "SetBlendEnabled";
+	case E_GraphicsCommand::SetStencilEnabled:				return "SetStencilEnabled";
+	case E_GraphicsCommand::SetCullEnabled:					return "SetCullEnabled";
+	case E_GraphicsCommand::SetSeamlessCubemapsEnabled:		return "SetSeamlessCubemapsEnabled";
+	case E_GraphicsCommand::SetFaceCullingMode:				return "SetFaceCullingMode";
+	case E_GraphicsCommand::SetBlendEquation:				return "SetBlendEquation";
+	case E_GraphicsCommand::SetBlendFunction:				return "SetBlendFunction";
+	case E_GraphicsCommand::SetViewport:					return "SetViewport";
+	case E_GraphicsCommand::SetClearColor:					return "SetClearColor";
+	case E_GraphicsCommand::SetShader:						return "SetShader";
+	case E_GraphicsCommand::BindFramebuffer:				return "BindFramebuffer";
+	case E_GraphicsCommand::BindReadFramebuffer:			return "BindReadFramebuffer";
+	case E_GraphicsCommand::BindDrawFramebuffer:			return "BindDrawFramebuffer";
+	case E_GraphicsCommand::BindRenderbuffer:				return "BindRenderbuffer";
+	case E_GraphicsCommand::BindTexture:					return "BindTexture";
+	case E_GraphicsCommand::UnbindTexture:					return "UnbindTexture";
+	case E_GraphicsCommand::BindVertexArray:				return "BindVertexArray";
+	case E_GraphicsCommand::BindBuffer:						return "BindBuffer";
+	case E_GraphicsCommand::SetLineWidth:					return "SetLineWidth";
+	case E_GraphicsCommand::DrawArrays:						return "DrawArrays";
+	case E_GraphicsCommand::DrawElements:					return "DrawElements";
+	case E_GraphicsCommand::DrawElementsInstanced:			return "DrawElementsInstanced";
+	case E_GraphicsCommand::Flush:							return "Flush";
+	case E_GraphicsCommand::Finish:							return "Finish";
+	case E_GraphicsCommand::Clear:							return "Clear";
+	case E_GraphicsCommand::CreateVertexArray:				return "CreateVertexArray";
+	case E_GraphicsCommand::CreateBuffer:					return "CreateBuffer";
+	case E_GraphicsCommand::DeleteVertexArray:				return "DeleteVertexArray";
+	case E_GraphicsCommand::DeleteBuffer:					return "DeleteBuffer";
+	case E_GraphicsCommand::SetBufferData:					return "SetBufferData";
+	case E_GraphicsCommand::SetVertexAttributeArrayEnabled:	return "SetVertexAttributeArrayEnabled";
+	case E_GraphicsCommand::MapBuffer:						return "MapBuffer";
+	case E_GraphicsCommand::MapBufferRange:					return "MapBufferRange";
+	case E_GraphicsCommand::UnmapBuffer:					return "UnmapBuffer";
+	case E_GraphicsCommand::BindBufferRange:				return "BindBufferRange";
+	case E_GraphicsCommand::GenerateTexture:				return "GenerateTexture";
+	case E_GraphicsCommand::DeleteTexture:					return "DeleteTexture";
+	case E_GraphicsCommand::SetTextureData:					return "SetTextureData";
+	case E_GraphicsCommand::SetTextureMipData:				return "SetTextureMipData";
+	case E_GraphicsCommand::GetTextureData:					return "GetTextureData";
+	case E_GraphicsCommand::SetTextureParams:				return "SetTextureParams";
+	case E_GraphicsCommand::GetTextureHandle:				return "GetTextureHandle";
+	case E_GraphicsCommand::SetTextureHandleResidency:		return "SetTextureHandleResidency";
+	case E_GraphicsCommand::CreateShader:					return "CreateShader";
+	case E_GraphicsCommand::CreateProgram:					return "CreateProgram";
+	case E_GraphicsCommand::DeleteShader:					return "DeleteShader";
+	case E_GraphicsCommand::DeleteProgram:					return "DeleteProgram";
+	case E_GraphicsCommand::CompileShader:					return "CompileShader";
+	case E_GraphicsCommand::BindFragmentDataLocation:		return "BindFragmentDataLocation";
+	case E_GraphicsCommand::AttachShader:					return "AttachShader";
+	case E_GraphicsCommand::LinkProgram:					return "LinkProgram";
+	case E_GraphicsCommand::SetUniformBlockBinding:			return "SetUniformBlockBinding";
+	case E_GraphicsCommand::PopulateUniform:				return "PopulateUniform";
+	case E_GraphicsCommand::UploadUniform:					return "UploadUniform";
+	case E_GraphicsCommand::DefineVertexAttributePointer:	return "DefineVertexAttributePointer";
+	case E_GraphicsCommand::DefineVertexAttribIPointer:		return "DefineVertexAttribIPointer";
+	case E_GraphicsCommand::DefineVertexAttribDivisor:		return "DefineVertexAttribDivisor";
+	case E_GraphicsCommand::GenFramebuffer:					return "GenFramebuffer";
+	case E_GraphicsCommand::DeleteFramebuffer:				return "DeleteFramebuffer";
+	case E_GraphicsCommand::GenRenderbuffer:				return "GenRenderbuffer";
+	case E_GraphicsCommand::DeleteRenderbuffer:				return "DeleteRenderbuffer";
+	case E_GraphicsCommand::SetRenderbufferStorage:			return "SetRenderbufferStorage";
+	case E_GraphicsCommand::LinkTextureToFbo:				return "LinkTextureToFbo";
+	case E_GraphicsCommand::LinkRenderbufferToFbo:			return "LinkRenderbufferToFbo";
+	case E_GraphicsCommand::SetDrawBufferCount:				return "SetDrawBufferCount";
+	case E_GraphicsCommand::SetReadBufferEnabled:			return "SetReadBufferEnabled";
+	case E_GraphicsCommand::CopyDepthReadToDrawFbo:			return "CopyDepthReadToDrawFbo";
+	case E_GraphicsCommand::SetPixelUnpackAlignment:		return "SetPixelUnpackAlignment";
+	case E_GraphicsCommand::SetDepthFunction:				return "SetDepthFunction";
+	case E_GraphicsCommand::ReadPixels:						return "ReadPixels";
+	case E_GraphicsCommand::DebugPushGroup:					return "DebugPushGroup";
+	case E_GraphicsCommand::DebugPopGroup:					return "DebugPopGroup";
+	}
+
+	return "Invalid";
+}
+
+//---------------------------------
+// GraphicsCommandLog::IsDrawCommand
+//
+bool GraphicsCommandLog::IsDrawCommand(E_GraphicsCommand const cmd)
+{
+	return (cmd == E_GraphicsCommand::DrawArrays) || (cmd == E_GraphicsCommand::DrawElements) || (cmd == E_GraphicsCommand::DrawElementsInstanced);
+}
+
+//---------------------------------
+// GraphicsCommandLog::Record
+//
+void GraphicsCommandLog::Record(E_GraphicsCommand const cmd, uint8 const target, uint32 const handle, uint32 const count, uint64 const bytes)
+{
+	ET_ASSERT(cmd < E_GraphicsCommand::COUNT);
+
+	m_Commands.emplace_back(cmd, target, handle, count, bytes);
+
+	m_Counts[static_cast<size_t>(cmd)]++;
+	m_Bytes[static_cast<size_t>(cmd)] += bytes;
+}
+
+//---------------------------------
+// GraphicsCommandLog::Clear
+//
+// Keeps the allocated command storage, so that per frame logs don't reallocate
+//
+void GraphicsCommandLog::Clear()
+{
+	m_Commands.clear();
+
+	m_Counts.fill(0u);
+	m_Bytes.fill(0u);
+}
+
+//---------------------------------
+// GraphicsCommandLog::Validate
+//
+// Replay the log and report api misuse, returns true if no errors were found
+//  - handles that are used before being created in this log are assumed to predate the recording
+//  - resources that are still alive at the end are not reported, as logs usually cover a single frame
+//
+bool GraphicsCommandLog::Validate(std::vector<std::string>& errors) const
+{
+	size_t const initialErrorCount = errors.size();
+
+	std::unordered_set<uint64> liveHandles;
+	std::unordered_set<uint64> deletedHandles;
+
+	uint32 boundProgram = 0u;
+	uint32 boundVertexArray = 0u;
+	std::array<uint32, 3u> boundBuffers = { 0u, 0u, 0u }; // per E_BufferType
+	std::array<bool, 3u> mappedBuffers = { false, false, false };
+
+	uint32 debugGroupDepth = 0u;
+
+	auto addError = [&errors](size_t const cmdIdx, GraphicsCommand const& cmd, std::string const& message)
+		{
+			errors.push_back(FS("#%u %s (%u): %s", static_cast<uint32>(cmdIdx), GetCommandName(cmd.type), cmd.handle, message.c_str()));
+		};
+
+	for (size_t cmdIdx = 0u; cmdIdx < m_Commands.size(); ++cmdIdx)
+	{
+		GraphicsCommand const& cmd = m_Commands[cmdIdx];
+
+		// object lifetime
+		//-----------------
+		E_ResourceKind kind;
+		E_ResourceAction action;
+		GetResourceAccess(cmd.type, kind, action);
+
+		if ((kind != E_ResourceKind::None) && (cmd.handle != 0u))
+		{
+			uint64 const key = GetResourceKey(kind, cmd.handle);
+
+			switch (action)
+			{
+			case E_ResourceAction::Create:
+				if (!liveHandles.insert(key).second)
+				{
+					addError(cmdIdx, cmd, "handle was created while still alive");
+				}
+
+				deletedHandles.erase(key);
+				break;
+
+			case E_ResourceAction::Delete:
+				if (deletedHandles.find(key) != deletedHandles.cend())
+				{
+					addError(cmdIdx, cmd, "handle was deleted twice");
+				}
+
+				liveHandles.erase(key);
+				deletedHandles.insert(key);
+
+				// deleting bound objects reverts the binding to the default
+				if ((kind == E_ResourceKind::Program) && (boundProgram == cmd.handle))
+				{
+					boundProgram = 0u;
+				}
+				else if ((kind == E_ResourceKind::VertexArray) && (boundVertexArray == cmd.handle))
+				{
+					boundVertexArray = 0u;
+				}
+				else if (kind == E_ResourceKind::Buffer)
+				{
+					for (uint32& buffer : boundBuffers)
+					{
+						if (buffer == cmd.handle)
+						{
+							buffer = 0u;
+						}
+					}
+				}
+
+				break;
+
+			case E_ResourceAction::Use:
+				if (deletedHandles.find(key) != deletedHandles.cend())
+				{
+					addError(cmdIdx, cmd, "handle was used after being deleted");
+				}
+
+				break;
+			}
+		}
+		else if (action == E_ResourceAction::Create)
+		{
+			addError(cmdIdx, cmd, "created an invalid handle");
+		}
+
+		// bindings
+		//----------
+		switch (cmd.type)
+		{
+		case E_GraphicsCommand::SetShader:
+			boundProgram = cmd.handle;
+			break;
+
+		case E_GraphicsCommand::BindVertexArray:
+			boundVertexArray = cmd.handle;
+			break;
+
+		case E_GraphicsCommand::BindBuffer:
+			if (cmd.target < boundBuffers.size())
+			{
+				if (mappedBuffers[cmd.target] && (boundBuffers[cmd.target] != cmd.handle))
+				{
+					addError(cmdIdx, cmd, "rebinding a buffer target while it is mapped");
+				}
+
+				boundBuffers[cmd.target] = cmd.handle;
+			}
+
+			break;
+
+		case E_GraphicsCommand::SetBufferData:
+			if ((cmd.target < boundBuffers.size()) && (boundBuffers[cmd.target] == 0u))
+			{
+				addError(cmdIdx, cmd, "no buffer bound to the target");
+			}
+
+			break;
+
+		case E_GraphicsCommand::MapBuffer:
+		case E_GraphicsCommand::MapBufferRange:
+			if (cmd.target < mappedBuffers.size())
+			{
+				if (boundBuffers[cmd.target] == 0u)
+				{
+					addError(cmdIdx, cmd, "no buffer bound to the target");
+				}
+
+				if (mappedBuffers[cmd.target])
+				{
+					addError(cmdIdx, cmd, "buffer target is already mapped");
+				}
+
+				mappedBuffers[cmd.target] = true;
+			}
+
+			break;
+
+		case E_GraphicsCommand::UnmapBuffer:
+			if (cmd.target < mappedBuffers.size())
+			{
+				if (!mappedBuffers[cmd.target])
+				{
+					addError(cmdIdx, cmd, "buffer target isn't mapped");
+				}
+
+				mappedBuffers[cmd.target] = false;
+			}
+
+			break;
+
+		case E_GraphicsCommand::DrawArrays:
+		case E_GraphicsCommand::DrawElements:
+		case E_GraphicsCommand::DrawElementsInstanced:
+			if (boundProgram == 0u)
+			{
+				addError(cmdIdx, cmd, "draw without a bound shader");
+			}
+
+			if (boundVertexArray == 0u)
+			{
+				addError(cmdIdx, cmd, "draw without a bound vertex array");
+			}
+
+			if (std::find(mappedBuffers.cbegin(), mappedBuffers.cend(), true) != mappedBuffers.cend())
+			{
+				addError(cmdIdx, cmd, "draw while a buffer is mapped");
+			}
+
+			break;
+
+		case E_GraphicsCommand::DebugPushGroup:
+			++debugGroupDepth;
+			break;
+
+		case E_GraphicsCommand::DebugPopGroup:
+			if (debugGroupDepth == 0u)
+			{
+				addError(cmdIdx, cmd, "popped a debug group that wasn't pushed");
+			}
+			else
+			{
+				--debugGroupDepth;
+			}
+
+			break;
+		}
+	}
+
+	// end of log
+	//------------
+	if (debugGroupDepth > 0u)
+	{
+		errors.push_back(FS("%u debug group(s) weren't popped", debugGroupDepth));
+	}
+
+	for (size_t targetIdx = 0u; targetIdx < mappedBuffers.size(); ++targetIdx)
+	{
+		if (mappedBuffers[targetIdx])
+		{
+			errors.push_back(FS("buffer target %u is still mapped", static_cast<uint32>(targetIdx)));
+		}
+	}
+
+	return (errors.size() == initialErrorCount);
+}
+
+//---------------------------------
+// GraphicsCommandLog::FindFirstDifference
+//
+// Index of the first command that doesn't match, or s_NoDifference if both logs are identical
+//
+size_t GraphicsCommandLog::FindFirstDifference(GraphicsCommandLog const& other) const
+{
+	size_t const commonCount = std::min(m_Commands.size(), other.m_Commands.size());
+	for (size_t cmdIdx = 0u; cmdIdx < commonCount; ++cmdIdx)
+	{
+		if (m_Commands[cmdIdx] != other.m_Commands[cmdIdx])
+		{
+			return cmdIdx;
+		}
+	}
+
+	if (m_Commands.size() != other.m_Commands.size())
+	{
+		return commonCount;
+	}
+
+	return s_NoDifference;
+}
+
+//---------------------------------
+// GraphicsCommandLog::GetSummary
+//
+// Human readable table of all recorded commands
+//
+std::string GraphicsCommandLog::GetSummary() const
+{
+	std::string summary = FS("%u commands, %u draws, %llu bytes\n",
+		static_cast<uint32>(m_Commands.size()),
+		GetDrawCount(),
+		static_cast<unsigned long long>(GetTotalBytes()));
+
+	for (size_t cmdIdx = 0u; cmdIdx < m_Counts.size(); ++cmdIdx)
+	{
+		if (m_Counts[cmdIdx] == 0u)
+		{
+			continue;
+		}
+
+		summary += FS("\t%-32s %8u", GetCommandName(static_cast<E_GraphicsCommand>(cmdIdx)), m_Counts[cmdIdx]);
+		if (m_Bytes[cmdIdx] > 0u)
+		{
+			summary += FS(" %12llu bytes", static_cast<unsigned long long>(m_Bytes[cmdIdx]));
+		}
+
+		summary += "\n";
+	}
+
+	return summary;
+}
+
+//---------------------------------
+// GraphicsCommandLog::GetDrawCount
+//
+uint32 GraphicsCommandLog::GetDrawCount() const
+{
+	return GetCount(E_GraphicsCommand::DrawArrays) + GetCount(E_GraphicsCommand::DrawElements) + GetCount(E_GraphicsCommand::DrawElementsInstanced);
+}
+
+//---------------------------------
+// GraphicsCommandLog::GetTotalBytes
+//
+uint64 GraphicsCommandLog::GetTotalBytes() const
+{
+	uint64 total = 0u;
+	for (uint64 const bytes : m_Bytes)
+	{
+		total += bytes;
+	}
+
+	return total;
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,181 @@
+#pragma once
+#include <array>
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// E_GraphicsCommand
+//
+// One entry for every call on the graphics api interface
+//
+enum class E_GraphicsCommand : uint8
+{
+	Initialize,
+
+	SetDepthEnabled,
+	SetBlendEnabled,
+	SetStencilEnabled,
+	SetCullEnabled,
+	SetSeamlessCubemapsEnabled,
+	SetFaceCullingMode,
+	SetBlendEquation,
+	SetBlendFunction,
+	SetViewport,
+	SetClearColor,
+	SetShader,
+	BindFramebuffer,
+	BindReadFramebuffer,
+	BindDrawFramebuffer,
+	BindRenderbuffer,
+	BindTexture,
+	UnbindTexture,
+	BindVertexArray,
+	BindBuffer,
+	SetLineWidth,
+
+	DrawArrays,
+	DrawElements,
+	DrawElementsInstanced,
+
+	Flush,
+	Finish,
+	Clear,
+
+	CreateVertexArray,
+	CreateBuffer,
+	DeleteVertexArray,
+	DeleteBuffer,
+	SetBufferData,
+	SetVertexAttributeArrayEnabled,
+	MapBuffer,
+	MapBufferRange,
+	UnmapBuffer,
+	BindBufferRange,
+
+	GenerateTexture,
+	DeleteTexture,
+	SetTextureData,
+	SetTextureMipData,
+	GetTextureData,
+	SetTextureParams,
+	GetTextureHandle,
+	SetTextureHandleResidency,
+
+	CreateShader,
+	CreateProgram,
+	DeleteShader,
+	DeleteProgram,
+	CompileShader,
+	BindFragmentDataLocation,
+	AttachShader,
+	LinkProgram,
+	SetUniformBlockBinding,
+	PopulateUniform,
+	UploadUniform,
+
+	DefineVertexAttributePointer,
+	DefineVertexAttribIPointer,
+	DefineVertexAttribDivisor,
+
+	GenFramebuffer,
+	DeleteFramebuffer,
+	GenRenderbuffer,
+	DeleteRenderbuffer,
+	SetRenderbufferStorage,
+	LinkTextureToFbo,
+	LinkRenderbufferToFbo,
+	SetDrawBufferCount,
+	SetReadBufferEnabled,
+	CopyDepthReadToDrawFbo,
+	SetPixelUnpackAlignment,
+	SetDepthFunction,
+	ReadPixels,
+
+	DebugPushGroup,
+	DebugPopGroup,
+
+	COUNT
+};
+
+//---------------------------------
+// GraphicsCommand
+//
+// Compact record of a single api call
+//  - target holds the buffer / texture / shader type or draw mode, depending on the command
+//  - handle is the object the command operates on, 0 for none
+//  - count is the element / vertex / index count, bytes the amount of data the command moves
+//
+struct GraphicsCommand final
+{
+	GraphicsCommand() = default;
+	GraphicsCommand(E_GraphicsCommand const cmd, uint8 const tgt, uint32 const hnd, uint32 const cnt, uint64 const size)
+		: type(cmd), target(tgt), handle(hnd), count(cnt), bytes(size) {}
+
+	bool operator==(GraphicsCommand const& other) const;
+	bool operator!=(GraphicsCommand const& other) const { return !(*this == other); }
+
+	E_GraphicsCommand type = E_GraphicsCommand::COUNT;
+	uint8 target = 0u;
+	uint32 handle = 0u;
+	uint32 count = 0u;
+	uint64 bytes = 0u;
+};
+
+
+//---------------------------------
+// GraphicsCommandLog
+//
+// Ordered list of recorded api calls with running per command statistics
+//  - the validation pass replays the log through a minimal state tracker to catch api misuse without a GPU
+//  - logs can be compared against each other to catch changes in the submitted command stream
+//
+class GraphicsCommandLog final
+{
+	// definitions
+	//-------------
+public:
+	static size_t const s_NoDifference;
+
+	static char const* GetCommandName(E_GraphicsCommand const cmd);
+	static bool IsDrawCommand(E_GraphicsCommand const cmd);
+
+	// construct destruct
+	//--------------------
+	GraphicsCommandLog() { Clear(); }
+
+	// functionality
+	//---------------
+	void Record(E_GraphicsCommand const cmd, uint8 const target = 0u, uint32 const handle = 0u, uint32 const count = 0u, uint64 const bytes = 0u);
+	void Clear();
+
+	bool Validate(std::vector<std::string>& errors) const;
+	size_t FindFirstDifference(GraphicsCommandLog const& other) const;
+
+	std::string GetSummary() const;
+
+	// accessors
+	//-----------
+	std::vector<GraphicsCommand> const& GetCommands() const { return m_Commands; }
+
+	uint32 GetCount(E_GraphicsCommand const cmd) const { return m_Counts[static_cast<size_t>(cmd)]; }
+	uint64 GetBytes(E_GraphicsCommand const cmd) const { return m_Bytes[static_cast<size_t>(cmd)]; }
+
+	uint32 GetDrawCount() const;
+	uint64 GetTotalBytes() const;
+
+	// Data
+	///////
+
+private:
+	std::vector<GraphicsCommand> m_Commands;
+
+	std::array<uint32, static_cast<size_t>(E_GraphicsCommand::COUNT)> m_Counts;
+	std::array<uint64, static_cast<size_t>(E_GraphicsCommand::COUNT)> m_Bytes;
+};
+
+
+} // namespace render
+} // namespace et
@@ -247,7 +247,16 @@ enum class E_ColorFormat : uint8
 	RGBA8,
 	RGBA16f,
 	RGBA32f,
-	SRGB
+	SRGB,
+
+	// block compressed, only for internal formats
+	BC1_RGB,
+	BC1_SRGB,
+	BC3_RGBA,
+	BC3_SRGBA,
+	BC5_RG,
+	BC7_RGBA,
+	BC7_SRGBA
 };
 
 //---------------------------------
@@ -301,6 +310,7 @@ struct UniformDescriptor
 	T_UniformLoc location;
 	E_ParamType type;
 	std::string name;
+	int32 blockOffset = -1; // std140 offset for members of uniform blocks
 };
 
 
@@ -0,0 +1,1840 @@
+#include "stdafx.h"
+#include "NullGraphicsContext.h"
+
+#include <EtRendering/GraphicsTypes/ParameterBlock.h>
+#include <EtRendering/GraphicsTypes/Shader.h>
+#include <EtRendering/GraphicsTypes/TextureData.h>
+
+
+namespace et {
+namespace render {
+
+
+//==================
+// GLSL reflection
+//==================
+
+
+namespace {
+
+	//---------------------------------
+	// GlslVariable
+	//
+	// Declaration found at the global scope of a shader stage
+	//
+	struct GlslVariable final
+	{
+		std::string type;
+		std::string name;
+		uint32 arrayCount;
+		int32 location;
+	};
+
+	//---------------------------------
+	// GlslDeclarations
+	//
+	struct GlslDeclarations final
+	{
+		std::vector<std::string> uniformBlocks;
+		std::vector<std::vector<GlslVariable>> blockMembers; // parallel to uniformBlocks
+		std::vector<GlslVariable> uniforms;
+		std::vector<GlslVariable> inputs;
+	};
+
+	//---------------------------------
+	// StripGlslComments
+	//
+	// Replaces comments with whitespace, newlines are preserved so that preprocessor lines stay intact
+	//
+	std::string StripGlslComments(std::string const& source)
+	{
+		std::string result;
+		result.reserve(source.size());
+
+		size_t idx = 0u;
+		while (idx < source.size())
+		{
+			if ((source[idx] == '/') && (idx + 1u < source.size()) && (source[idx + 1u] == '/'))
+			{
+				while ((idx < source.size()) && (source[idx] != '\n'))
+				{
+					++idx;
+				}
+			}
+			else if ((source[idx] == '/') && (idx + 1u < source.size()) && (source[idx + 1u] == '*'))
+			{
+				idx += 2u;
+				while ((idx + 1u < source.size()) && !((source[idx] == '*') && (source[idx + 1u] == '/')))
+				{
+					if (source[idx] == '\n')
+					{
+						result += '\n';
+					}
+
+					++idx;
+				}
+
+				idx += 2u;
+				result += ' ';
+			}
+			else
+			{
+				result += source[idx++];
+			}
+		}
+
+		return result;
+	}
+
+	//---------------------------------
+	// TokenizeGlsl
+	//
+	// Splits the source into identifiers / numbers and single character symbols, and collects simple defines for array sizes
+	//
+	void TokenizeGlsl(std::string const& source, std::vector<std::string>& tokens, std::unordered_map<std::string, std::string>& defines)
+	{
+		std::istringstream stream(StripGlslComments(source));
+
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			size_t const first = line.find_first_not_of(" \t\r");
+			if (first == std::string::npos)
+			{
+				continue;
+			}
+
+			// preprocessor
+			if (line[first] == '#')
+			{
+				std::istringstream directive(line.substr(first + 1u));
+
+				std::string keyword;
+				std::string name;
+				std::string value;
+				if ((directive >> keyword >> name >> value) && (keyword == "define"))
+				{
+					defines[name] = value;
+				}
+
+				continue;
+			}
+
+			std::string current;
+			for (char const c : line)
+			{
+				if ((std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '_') || (c == '.'))
+				{
+					current += c;
+					continue;
+				}
+
+				if (!current.empty())
+				{
+					tokens.push_back(current);
+					current.clear();
+				}
+
+				if (std::isspace(static_cast<unsigned char>(c)) == 0)
+				{
+					tokens.emplace_back(1u, c);
+				}
+			}
+
+			if (!current.empty())
+			{
+				tokens.push_back(current);
+			}
+		}
+	}
+
+	//---------------------------------
+	// ParseGlslCount
+	//
+	uint32 ParseGlslCount(std::string const& token, std::unordered_map<std::string, std::string> const& defines)
+	{
+		auto const defineIt = defines.find(token);
+		std::string const& value = (defineIt != defines.cend()) ? defineIt->second : token;
+
+		if (value.empty() || (value.find_first_not_of("0123456789") != std::string::npos))
+		{
+			return 1u;
+		}
+
+		return static_cast<uint32>(std::stoul(value));
+	}
+
+	//---------------------------------
+	// IsGlslQualifier
+	//
+	// Qualifiers that may precede a storage qualifier or type and don't change reflection
+	//
+	bool IsGlslQualifier(std::string const& token)
+	{
+		static std::vector<std::string> const s_Qualifiers = {
+			"flat", "smooth", "noperspective", "centroid", "sample", "invariant", "precise", "highp", "mediump", "lowp"
+		};
+
+		return (std::find(s_Qualifiers.cbegin(), s_Qualifiers.cend(), token) != s_Qualifiers.cend());
+	}
+
+	//---------------------------------
+	// ScanGlslDeclarations
+	//
+	// Collect uniforms, uniform blocks and optionally stage inputs declared at the global scope
+	//
+	void ScanGlslDeclarations(std::string const& source, bool const scanInputs, GlslDeclarations& declarations)
+	{
+		std::vector<std::string> tokens;
+		std::unordered_map<std::string, std::string> defines;
+		TokenizeGlsl(source, tokens, defines);
+
+		auto tokenAt = [&tokens](size_t const idx) -> std::string const&
+			{
+				static std::string const s_Empty;
+				return (idx < tokens.size()) ? tokens[idx] : s_Empty;
+			};
+
+		int32 braceDepth = 0;
+		int32 parenDepth = 0;
+
+		for (size_t idx = 0u; idx < tokens.size(); ++idx)
+		{
+			std::string const& token = tokens[idx];
+
+			if (token == "{")
+			{
+				++braceDepth;
+				continue;
+			}
+			else if (token == "}")
+			{
+				--braceDepth;
+				continue;
+			}
+			else if (token == "(")
+			{
+				++parenDepth;
+				continue;
+			}
+			else if (token == ")")
+			{
+				--parenDepth;
+				continue;
+			}
+
+			if ((braceDepth > 0) || (parenDepth > 0))
+			{
+				continue;
+			}
+
+			size_t const declarationStart = idx;
+
+			// layout qualifiers
+			int32 location = -1;
+			if ((token == "layout") && (tokenAt(idx + 1u) == "("))
+			{
+				idx += 2u;
+				while ((idx < tokens.size()) && (tokens[idx] != ")"))
+				{
+					if ((tokens[idx] == "location") && (tokenAt(idx + 1u) == "="))
+					{
+						location = static_cast<int32>(ParseGlslCount(tokenAt(idx + 2u), defines));
+					}
+
+					++idx;
+				}
+
+				++idx;
+			}
+
+			while (IsGlslQualifier(tokenAt(idx)))
+			{
+				++idx;
+			}
+
+			bool const isUniform = (tokenAt(idx) == "uniform");
+			bool const isInput = scanInputs && (tokenAt(idx) == "in");
+			if (!(isUniform || isInput))
+			{
+				if ((idx > declarationStart) && (idx < tokens.size()))
+				{
+					--idx; // reprocess the token following the qualifiers, it might open a scope
+				}
+
+				continue;
+			}
+
+			++idx;
+			while (IsGlslQualifier(tokenAt(idx)))
+			{
+				++idx;
+			}
+
+			// interface blocks - the opening brace is handled by the next iteration, except for uniform block members
+			if (tokenAt(idx + 1u) == "{")
+			{
+				if (isUniform)
+				{
+					declarations.uniformBlocks.push_back(tokenAt(idx));
+					declarations.blockMembers.emplace_back();
+
+					idx += 2u;
+					while ((idx < tokens.size()) && (tokens[idx] != "}"))
+					{
+						// skip member layout qualifiers
+						if ((tokens[idx] == "layout") && (tokenAt(idx + 1u) == "("))
+						{
+							while ((idx < tokens.size()) && (tokens[idx] != ")"))
+							{
+								++idx;
+							}
+
+							++idx;
+						}
+
+						while (IsGlslQualifier(tokenAt(idx)))
+						{
+							++idx;
+						}
+
+						std::string const memberType = tokenAt(idx++);
+						while ((idx < tokens.size()) && (tokens[idx] != ";") && (tokens[idx] != "}"))
+						{
+							GlslVariable member;
+							member.type = memberType;
+							member.name = tokenAt(idx++);
+							member.arrayCount = 1u;
+							member.location = -1;
+
+							if (tokenAt(idx) == "[")
+							{
+								member.arrayCount = ParseGlslCount(tokenAt(idx + 1u), defines);
+								idx += 3u;
+							}
+
+							declarations.blockMembers.back().push_back(member);
+
+							if (tokenAt(idx) == ",")
+							{
+								++idx;
+							}
+						}
+
+						if (tokenAt(idx) == ";")
+						{
+							++idx;
+						}
+					}
+
+					--idx; // the closing brace is handled by the next iteration
+				}
+
+				continue;
+			}
+
+			// variables, possibly several per declaration
+			std::string const type = tokenAt(idx++);
+			while (idx < tokens.size())
+			{
+				GlslVariable variable;
+				variable.type = type;
+				variable.name = tokenAt(idx++);
+				variable.arrayCount = 1u;
+				variable.location = location;
+
+				if (tokenAt(idx) == "[")
+				{
+					variable.arrayCount = ParseGlslCount(tokenAt(idx + 1u), defines);
+					idx += 3u;
+				}
+
+				if (isUniform)
+				{
+					declarations.uniforms.push_back(variable);
+				}
+				else
+				{
+					declarations.inputs.push_back(variable);
+				}
+
+				if (tokenAt(idx) != ",")
+				{
+					break;
+				}
+
+				++idx;
+				location = -1;
+			}
+
+			// skip initializers
+			while ((idx < tokens.size()) && (tokens[idx] != ";"))
+			{
+				++idx;
+			}
+		}
+	}
+
+	//---------------------------------
+	// ParseGlslParamType
+	//
+	// Same subset as the GL implementation supports
+	//
+	E_ParamType ParseGlslParamType(std::string const& type)
+	{
+		if (type == "sampler2D")			return E_ParamType::Texture2D;
+		if (type == "sampler3D")			return E_ParamType::Texture3D;
+		if (type == "samplerCube")			return E_ParamType::TextureCube;
+		if (type == "sampler2DShadow")		return E_ParamType::TextureShadow;
+		if (type == "mat4")					return E_ParamType::Matrix4x4;
+		if (type == "mat3")					return E_ParamType::Matrix3x3;
+		if (type == "vec4")					return E_ParamType::Vector4;
+		if (type == "vec3")					return E_ParamType::Vector3;
+		if (type == "vec2")					return E_ParamType::Vector2;
+		if (type == "uint")					return E_ParamType::UInt;
+		if (type == "int")					return E_ParamType::Int;
+		if (type == "float")				return E_ParamType::Float;
+		if (type == "bool")					return E_ParamType::Boolean;
+
+		return E_ParamType::Invalid;
+	}
+
+	//---------------------------------
+	// GetStd140Layout
+	//
+	// Base alignment and size of a uniform block member, array elements are rounded up to vec4 alignment
+	//
+	void GetStd140Layout(E_ParamType const type, uint32 const arrayCount, int32& alignment, int32& size)
+	{
+		switch (type)
+		{
+		case E_ParamType::Matrix4x4:	alignment = 16; size = 64; break;
+		case E_ParamType::Matrix3x3:	alignment = 16; size = 48; break;
+		case E_ParamType::Vector4:		alignment = 16; size = 16; break;
+		case E_ParamType::Vector3:		alignment = 16; size = 12; break;
+		case E_ParamType::Vector2:		alignment = 8; size = 8; break;
+		default:						alignment = 4; size = 4; break;
+		}
+
+		if (arrayCount > 1u)
+		{
+			alignment = 16;
+			size = 16 * ((size + 15) / 16) * static_cast<int32>(arrayCount);
+		}
+	}
+
+	//---------------------------------
+	// ParseGlslAttributeType
+	//
+	bool ParseGlslAttributeType(std::string const& type, E_DataType& dataType, uint32& dataCount)
+	{
+		if (type.empty())
+		{
+			return false;
+		}
+
+		// scalar type from the prefix
+		std::string shape = type;
+		switch (type[0])
+		{
+		case 'i': dataType = E_DataType::Int; break;
+		case 'u': dataType = E_DataType::UInt; break;
+		case 'd': dataType = E_DataType::Double; break;
+		default: dataType = E_DataType::Float; break;
+		}
+
+		if ((dataType != E_DataType::Float) && (type != "int") && (type != "uint") && (type != "double"))
+		{
+			shape = type.substr(1u);
+		}
+
+		// component count from the shape
+		if ((shape == "float") || (shape == "int") || (shape == "uint") || (shape == "double"))
+		{
+			dataCount = 1u;
+		}
+		else if ((shape.size() == 4u) && (shape.compare(0u, 3u, "vec") == 0))
+		{
+			dataCount = static_cast<uint32>(shape[3] - '0');
+		}
+		else if ((shape.size() == 4u) && (shape.compare(0u, 3u, "mat") == 0))
+		{
+			uint32 const dim = static_cast<uint32>(shape[3] - '0');
+			dataCount = dim * dim;
+		}
+		else if ((shape.size() == 6u) && (shape.compare(0u, 3u, "mat") == 0) && (shape[4] == 'x'))
+		{
+			dataCount = static_cast<uint32>(shape[3] - '0') * static_cast<uint32>(shape[5] - '0');
+		}
+		else
+		{
+			return false;
+		}
+
+		return (dataCount >= 1u) && (dataCount <= 16u);
+	}
+
+	//---------------------------------
+	// GetDataTypeSize
+	//
+	uint64 GetDataTypeSize(E_DataType const type)
+	{
+		switch (type)
+		{
+		case E_DataType::Byte:
+		case E_DataType::UByte:
+			return 1u;
+
+		case E_DataType::Short:
+		case E_DataType::UShort:
+		case E_DataType::Half:
+			return 2u;
+
+		case E_DataType::Int:
+		case E_DataType::UInt:
+		case E_DataType::Float:
+			return 4u;
+
+		case E_DataType::Double:
+			return 8u;
+		}
+
+		return 0u;
+	}
+
+	//---------------------------------
+	// GetChannelCount
+	//
+	uint64 GetChannelCount(E_ColorFormat const format)
+	{
+		switch (format)
+		{
+		case E_ColorFormat::Depth:
+		case E_ColorFormat::Red:
+			return 1u;
+
+		case E_ColorFormat::DepthStencil:
+		case E_ColorFormat::RG:
+			return 2u;
+
+		case E_ColorFormat::RGB:
+			return 3u;
+
+		case E_ColorFormat::RGBA:
+			return 4u;
+		}
+
+		return 4u;
+	}
+
+	//---------------------------------
+	// GetMipPixelCount
+	//
+	// Texels in a mip level across all layers and cube faces
+	//
+	uint64 GetMipPixelCount(TextureData const& texture, uint8 const mipLevel)
+	{
+		ivec2 const res = TextureData::GetMipResolution(texture.GetResolution(), mipLevel);
+		uint64 const layers = (texture.GetTargetType() == E_TextureType::CubeMap) 
+			? static_cast<uint64>(TextureData::s_NumCubeFaces) 
+			: static_cast<uint64>(std::max(texture.GetDepth() >> mipLevel, 1));
+
+		return static_cast<uint64>(res.x) * static_cast<uint64>(res.y) * layers;
+	}
+
+} // namespace
+
+
+//=======================
+// Null Graphics Context
+//=======================
+
+
+//---------------------------------
+// NullGraphicsContext::Initialize
+//
+void NullGraphicsContext::Initialize(ivec2 const dimensions)
+{
+	m_ViewportSize = dimensions;
+	Record(E_GraphicsCommand::Initialize);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetDepthEnabled
+//
+void NullGraphicsContext::SetDepthEnabled(bool const enabled)
+{
+	Record(E_GraphicsCommand::SetDepthEnabled, static_cast<uint8>(enabled));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetBlendEnabled
+//
+void NullGraphicsContext::SetBlendEnabled(bool const enabled)
+{
+	Record(E_GraphicsCommand::SetBlendEnabled, static_cast<uint8>(enabled));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetBlendEnabled
+//
+// Blending for a single draw buffer
+//
+void NullGraphicsContext::SetBlendEnabled(bool const enabled, uint32 const index)
+{
+	Record(E_GraphicsCommand::SetBlendEnabled, static_cast<uint8>(enabled), 0u, index + 1u);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetBlendEnabled
+//
+void NullGraphicsContext::SetBlendEnabled(std::vector<bool> const& blendBuffers)
+{
+	for (size_t idx = 0u; idx < blendBuffers.size(); ++idx)
+	{
+		SetBlendEnabled(blendBuffers[idx], static_cast<uint32>(idx));
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::SetStencilEnabled
+//
+void NullGraphicsContext::SetStencilEnabled(bool const enabled)
+{
+	Record(E_GraphicsCommand::SetStencilEnabled, static_cast<uint8>(enabled));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetCullEnabled
+//
+void NullGraphicsContext::SetCullEnabled(bool const enabled)
+{
+	Record(E_GraphicsCommand::SetCullEnabled, static_cast<uint8>(enabled));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetSeamlessCubemapsEnabled
+//
+void NullGraphicsContext::SetSeamlessCubemapsEnabled(bool const enabled)
+{
+	Record(E_GraphicsCommand::SetSeamlessCubemapsEnabled, static_cast<uint8>(enabled));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetFaceCullingMode
+//
+void NullGraphicsContext::SetFaceCullingMode(E_FaceCullMode const cullMode)
+{
+	Record(E_GraphicsCommand::SetFaceCullingMode, static_cast<uint8>(cullMode));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetBlendEquation
+//
+void NullGraphicsContext::SetBlendEquation(E_BlendEquation const equation)
+{
+	Record(E_GraphicsCommand::SetBlendEquation, static_cast<uint8>(equation));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetBlendFunction
+//
+void NullGraphicsContext::SetBlendFunction(E_BlendFactor const sFactor, E_BlendFactor const dFactor)
+{
+	Record(E_GraphicsCommand::SetBlendFunction, static_cast<uint8>(sFactor), 0u, static_cast<uint32>(dFactor));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetViewport
+//
+void NullGraphicsContext::SetViewport(ivec2 const pos, ivec2 const size)
+{
+	m_ViewportPosition = pos;
+	m_ViewportSize = size;
+
+	Record(E_GraphicsCommand::SetViewport, 0u, 0u, static_cast<uint32>(size.x * size.y));
+}
+
+//---------------------------------
+// NullGraphicsContext::GetViewport
+//
+void NullGraphicsContext::GetViewport(ivec2& pos, ivec2& size)
+{
+	pos = m_ViewportPosition;
+	size = m_ViewportSize;
+}
+
+//---------------------------------
+// NullGraphicsContext::SetClearColor
+//
+void NullGraphicsContext::SetClearColor(vec4 const& col)
+{
+	UNUSED(col);
+	Record(E_GraphicsCommand::SetClearColor);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetShader
+//
+void NullGraphicsContext::SetShader(ShaderData const* pShader)
+{
+	m_pBoundShader = pShader;
+	Record(E_GraphicsCommand::SetShader, 0u, (pShader != nullptr) ? pShader->GetProgram() : 0u);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindFramebuffer
+//
+void NullGraphicsContext::BindFramebuffer(T_FbLoc const handle)
+{
+	m_ReadFramebuffer = handle;
+	m_DrawFramebuffer = handle;
+	Record(E_GraphicsCommand::BindFramebuffer, 0u, handle);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindReadFramebuffer
+//
+void NullGraphicsContext::BindReadFramebuffer(T_FbLoc const handle)
+{
+	m_ReadFramebuffer = handle;
+	Record(E_GraphicsCommand::BindReadFramebuffer, 0u, handle);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindDrawFramebuffer
+//
+void NullGraphicsContext::BindDrawFramebuffer(T_FbLoc const handle)
+{
+	m_DrawFramebuffer = handle;
+	Record(E_GraphicsCommand::BindDrawFramebuffer, 0u, handle);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindRenderbuffer
+//
+void NullGraphicsContext::BindRenderbuffer(T_RbLoc const handle)
+{
+	Record(E_GraphicsCommand::BindRenderbuffer, 0u, handle);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindTexture
+//
+// Textures keep their unit until it is needed by another texture
+//
+T_TextureUnit NullGraphicsContext::BindTexture(E_TextureType const target, T_TextureLoc const texLoc, bool const ensureActive)
+{
+	UNUSED(ensureActive);
+
+	Record(E_GraphicsCommand::BindTexture, static_cast<uint8>(target), texLoc);
+
+	auto const foundIt = m_TextureUnits.find(texLoc);
+	if (foundIt != m_TextureUnits.cend())
+	{
+		return foundIt->second;
+	}
+
+	T_TextureUnit const unit = m_NextTextureUnit;
+	m_NextTextureUnit = (m_NextTextureUnit + 1u) % s_TextureUnitCount;
+
+	m_TextureUnits.erase(m_UnitTextures[unit]);
+	m_UnitTextures[unit] = texLoc;
+	m_TextureUnits[texLoc] = unit;
+
+	return unit;
+}
+
+//---------------------------------
+// NullGraphicsContext::UnbindTexture
+//
+void NullGraphicsContext::UnbindTexture(E_TextureType const target, T_TextureLoc const texLoc)
+{
+	Record(E_GraphicsCommand::UnbindTexture, static_cast<uint8>(target), texLoc);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindVertexArray
+//
+void NullGraphicsContext::BindVertexArray(T_ArrayLoc const vertexArray)
+{
+	m_BoundVertexArray = vertexArray;
+	Record(E_GraphicsCommand::BindVertexArray, 0u, vertexArray);
+}
+
+//---------------------------------
+// NullGraphicsContext::BindBuffer
+//
+void NullGraphicsContext::BindBuffer(E_BufferType const target, T_BufferLoc const buffer)
+{
+	m_BoundBuffers[static_cast<size_t>(target)] = buffer;
+	Record(E_GraphicsCommand::BindBuffer, static_cast<uint8>(target), buffer);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetLineWidth
+//
+void NullGraphicsContext::SetLineWidth(float const lineWidth)
+{
+	UNUSED(lineWidth);
+	Record(E_GraphicsCommand::SetLineWidth);
+}
+
+//---------------------------------
+// NullGraphicsContext::GetActiveFramebuffer
+//
+T_FbLoc NullGraphicsContext::GetActiveFramebuffer()
+{
+	return m_DrawFramebuffer;
+}
+
+//---------------------------------
+// NullGraphicsContext::DrawArrays
+//
+void NullGraphicsContext::DrawArrays(E_DrawMode const mode, uint32 const first, uint32 const count)
+{
+	UNUSED(first);
+	Record(E_GraphicsCommand::DrawArrays, static_cast<uint8>(mode), m_BoundVertexArray, count);
+}
+
+//---------------------------------
+// NullGraphicsContext::DrawElements
+//
+void NullGraphicsContext::DrawElements(E_DrawMode const mode, uint32 const count, E_DataType const type, const void * indices)
+{
+	UNUSED(indices);
+	Record(E_GraphicsCommand::DrawElements, static_cast<uint8>(mode), m_BoundVertexArray, count, static_cast<uint64>(count) * GetDataTypeSize(type));
+}
+
+//---------------------------------
+// NullGraphicsContext::DrawElementsInstanced
+//
+// The count is the total amount of processed indices across all instances
+//
+void NullGraphicsContext::DrawElementsInstanced(E_DrawMode const mode, uint32 const count, E_DataType const type, const void * indices, uint32 const primcount)
+{
+	UNUSED(indices);
+	Record(E_GraphicsCommand::DrawElementsInstanced,
+		static_cast<uint8>(mode),
+		m_BoundVertexArray,
+		count * primcount,
+		static_cast<uint64>(count) * GetDataTypeSize(type));
+}
+
+//---------------------------------
+// NullGraphicsContext::Flush
+//
+void NullGraphicsContext::Flush() const
+{
+	Record(E_GraphicsCommand::Flush);
+}
+
+//---------------------------------
+// NullGraphicsContext::Finish
+//
+void NullGraphicsContext::Finish() const
+{
+	Record(E_GraphicsCommand::Finish);
+}
+
+//---------------------------------
+// NullGraphicsContext::Clear
+//
+void NullGraphicsContext::Clear(T_ClearFlags const mask) const
+{
+	Record(E_GraphicsCommand::Clear, static_cast<uint8>(mask));
+}
+
+//---------------------------------
+// NullGraphicsContext::CreateVertexArray
+//
+T_ArrayLoc NullGraphicsContext::CreateVertexArray() const
+{
+	T_ArrayLoc const loc = GenHandle();
+	Record(E_GraphicsCommand::CreateVertexArray, 0u, loc);
+	return loc;
+}
+
+//---------------------------------
+// NullGraphicsContext::CreateBuffer
+//
+T_BufferLoc NullGraphicsContext::CreateBuffer() const
+{
+	T_BufferLoc const loc = GenHandle();
+	m_Buffers[loc] = std::vector<uint8>();
+
+	Record(E_GraphicsCommand::CreateBuffer, 0u, loc);
+	return loc;
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteVertexArray
+//
+void NullGraphicsContext::DeleteVertexArray(T_ArrayLoc& loc) const
+{
+	Record(E_GraphicsCommand::DeleteVertexArray, 0u, loc);
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteBuffer
+//
+void NullGraphicsContext::DeleteBuffer(T_BufferLoc& loc) const
+{
+	m_Buffers.erase(loc);
+	for (T_BufferLoc& bound : m_BoundBuffers)
+	{
+		if (bound == loc)
+		{
+			bound = 0u;
+		}
+	}
+
+	Record(E_GraphicsCommand::DeleteBuffer, 0u, loc);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetBufferData
+//
+// Contents are kept so that mapping the buffer later returns memory of the right size
+//
+void NullGraphicsContext::SetBufferData(E_BufferType const target, int64 const size, void const* const data, E_UsageHint const usage) const
+{
+	UNUSED(usage);
+
+	T_BufferLoc const buffer = GetBoundBuffer(target);
+	if (buffer != 0u)
+	{
+		std::vector<uint8>& storage = m_Buffers[buffer];
+		storage.resize(static_cast<size_t>(size));
+		if (data != nullptr)
+		{
+			memcpy(storage.data(), data, static_cast<size_t>(size));
+		}
+	}
+
+	Record(E_GraphicsCommand::SetBufferData, static_cast<uint8>(target), buffer, 0u, static_cast<uint64>(size));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetVertexAttributeArrayEnabled
+//
+void NullGraphicsContext::SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const
+{
+	Record(E_GraphicsCommand::SetVertexAttributeArrayEnabled, static_cast<uint8>(enabled), 0u, index);
+}
+
+//---------------------------------
+// NullGraphicsContext::MapBuffer
+//
+// Mapping counts the entire buffer as transferred, as we can't know how much of it is written
+//
+void* NullGraphicsContext::MapBuffer(E_BufferType const target, E_AccessMode const access) const
+{
+	UNUSED(access);
+
+	T_BufferLoc const buffer = GetBoundBuffer(target);
+
+	void* mapped = nullptr;
+	uint64 size = 0u;
+	if (buffer != 0u)
+	{
+		std::vector<uint8>& storage = m_Buffers[buffer];
+		mapped = static_cast<void*>(storage.data());
+		size = static_cast<uint64>(storage.size());
+	}
+
+	Record(E_GraphicsCommand::MapBuffer, static_cast<uint8>(target), buffer, 0u, size);
+	return mapped;
+}
+
+//---------------------------------
+// NullGraphicsContext::MapBufferRange
+//
+void* NullGraphicsContext::MapBufferRange(E_BufferType const target, int64 const offset, int64 const size, bool const unsynchronized) const
+{
+	UNUSED(unsynchronized);
+
+	T_BufferLoc const buffer = GetBoundBuffer(target);
+
+	void* mapped = nullptr;
+	if (buffer != 0u)
+	{
+		std::vector<uint8>& storage = m_Buffers[buffer];
+		if ((offset >= 0) && (size >= 0) && (static_cast<size_t>(offset + size) <= storage.size()))
+		{
+			mapped = static_cast<void*>(storage.data() + offset);
+		}
+	}
+
+	Record(E_GraphicsCommand::MapBufferRange, static_cast<uint8>(target), buffer, 0u, static_cast<uint64>(size));
+	return mapped;
+}
+
+//---------------------------------
+// NullGraphicsContext::UnmapBuffer
+//
+void NullGraphicsContext::UnmapBuffer(E_BufferType const target) const
+{
+	Record(E_GraphicsCommand::UnmapBuffer, static_cast<uint8>(target), GetBoundBuffer(target));
+}
+
+//---------------------------------
+// NullGraphicsContext::BindBufferRange
+//
+void NullGraphicsContext::BindBufferRange(E_BufferType const target, uint32 const index, T_BufferLoc const buffer, size_t const offset, size_t const size) const
+{
+	UNUSED(offset);
+
+	m_BoundBuffers[static_cast<size_t>(target)] = buffer;
+	Record(E_GraphicsCommand::BindBufferRange, static_cast<uint8>(target), buffer, index, static_cast<uint64>(size));
+}
+
+//---------------------------------
+// NullGraphicsContext::GenerateTexture
+//
+T_TextureLoc NullGraphicsContext::GenerateTexture() const
+{
+	T_TextureLoc const loc = GenHandle();
+	Record(E_GraphicsCommand::GenerateTexture, 0u, loc);
+	return loc;
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteTexture
+//
+void NullGraphicsContext::DeleteTexture(T_TextureLoc& texLoc)
+{
+	auto const foundIt = m_TextureUnits.find(texLoc);
+	if (foundIt != m_TextureUnits.cend())
+	{
+		m_UnitTextures[foundIt->second] = 0u;
+		m_TextureUnits.erase(foundIt);
+	}
+
+	Record(E_GraphicsCommand::DeleteTexture, 0u, texLoc);
+	texLoc = 0u;
+}
+
+//---------------------------------
+// NullGraphicsContext::SetTextureData
+//
+void NullGraphicsContext::SetTextureData(TextureData& texture, void* data)
+{
+	ivec2 const res = texture.GetResolution();
+	uint64 pixelCount = static_cast<uint64>(res.x) * static_cast<uint64>(res.y) * static_cast<uint64>(std::max(texture.GetDepth(), 1));
+	if (texture.GetTargetType() == E_TextureType::CubeMap)
+	{
+		pixelCount *= static_cast<uint64>(TextureData::s_NumCubeFaces);
+	}
+
+	uint64 const bytes = (data != nullptr) ? (pixelCount * GetChannelCount(texture.GetFormat()) * GetDataTypeSize(texture.GetDataType())) : 0u;
+
+	Record(E_GraphicsCommand::SetTextureData, static_cast<uint8>(texture.GetTargetType()), texture.GetLocation(), static_cast<uint32>(pixelCount), bytes);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetTextureMipData
+//
+void NullGraphicsContext::SetTextureMipData(TextureData const& texture, uint8 const mipLevel, void const* const data, size_t const size)
+{
+	Record(E_GraphicsCommand::SetTextureMipData, 
+		static_cast<uint8>(texture.GetTargetType()), 
+		texture.GetLocation(), 
+		static_cast<uint32>(GetMipPixelCount(texture, mipLevel)), 
+		(data != nullptr) ? static_cast<uint64>(size) : 0u);
+}
+
+//---------------------------------
+// NullGraphicsContext::GetTextureData
+//
+// Read back data is zeroed
+//
+void NullGraphicsContext::GetTextureData(TextureData const& texture, uint8 const mipLevel, void* const data)
+{
+	uint64 const bytes = static_cast<uint64>(texture.GetLevelDataSize(mipLevel));
+	if (data != nullptr)
+	{
+		memset(data, 0, static_cast<size_t>(bytes));
+	}
+
+	Record(E_GraphicsCommand::GetTextureData, 
+		static_cast<uint8>(texture.GetTargetType()), 
+		texture.GetLocation(), 
+		static_cast<uint32>(GetMipPixelCount(texture, mipLevel)), 
+		bytes);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetTextureParams
+//
+// Mip level calculation matches the GL implementation, so that texture data reports the same amount of levels
+//
+void NullGraphicsContext::SetTextureParams(TextureData const& texture, uint8& mipLevels, TextureParameters& prev, TextureParameters const& next, bool const force)
+{
+	if ((!prev.genMipMaps && next.genMipMaps) || (next.genMipMaps && force) || (next.genMipMaps && (mipLevels == 0u)))
+	{
+		ivec2 const res = texture.GetResolution();
+		float const largerRes = static_cast<float>(std::max(res.x, res.y));
+		mipLevels = 1u + static_cast<uint8>(floor(log10(largerRes) / log10(2.f)));
+	}
+
+	prev = next;
+
+	Record(E_GraphicsCommand::SetTextureParams, static_cast<uint8>(texture.GetTargetType()), texture.GetLocation(), static_cast<uint32>(mipLevels));
+}
+
+//---------------------------------
+// NullGraphicsContext::GetTextureHandle
+//
+T_TextureHandle NullGraphicsContext::GetTextureHandle(T_TextureLoc const texLoc) const
+{
+	Record(E_GraphicsCommand::GetTextureHandle, 0u, texLoc);
+	return static_cast<T_TextureHandle>(texLoc);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetTextureHandleResidency
+//
+void NullGraphicsContext::SetTextureHandleResidency(T_TextureHandle const handle, bool const isResident) const
+{
+	Record(E_GraphicsCommand::SetTextureHandleResidency, static_cast<uint8>(isResident), static_cast<uint32>(handle));
+}
+
+//---------------------------------
+// NullGraphicsContext::CreateShader
+//
+T_ShaderLoc NullGraphicsContext::CreateShader(E_ShaderType const type) const
+{
+	T_ShaderLoc const loc = GenHandle();
+
+	ShaderSource& shader = m_Shaders[loc];
+	shader.type = type;
+
+	Record(E_GraphicsCommand::CreateShader, static_cast<uint8>(type), loc);
+	return loc;
+}
+
+//---------------------------------
+// NullGraphicsContext::CreateProgram
+//
+T_ShaderLoc NullGraphicsContext::CreateProgram() const
+{
+	T_ShaderLoc const loc = GenHandle();
+	m_Programs[loc] = ProgramInfo();
+
+	Record(E_GraphicsCommand::CreateProgram, 0u, loc);
+	return loc;
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteShader
+//
+void NullGraphicsContext::DeleteShader(T_ShaderLoc const shader)
+{
+	m_Shaders.erase(shader);
+	Record(E_GraphicsCommand::DeleteShader, 0u, shader);
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteProgram
+//
+void NullGraphicsContext::DeleteProgram(T_ShaderLoc const program)
+{
+	m_Programs.erase(program);
+	Record(E_GraphicsCommand::DeleteProgram, 0u, program);
+}
+
+//---------------------------------
+// NullGraphicsContext::CompileShader
+//
+// The source is kept for reflection once the program is linked
+//
+void NullGraphicsContext::CompileShader(T_ShaderLoc const shader, std::string const& source) const
+{
+	auto const foundIt = m_Shaders.find(shader);
+	if (foundIt != m_Shaders.cend())
+	{
+		foundIt->second.source = source;
+		foundIt->second.isCompiled = !source.empty();
+	}
+
+	Record(E_GraphicsCommand::CompileShader, 0u, shader, 0u, static_cast<uint64>(source.size()));
+}
+
+//---------------------------------
+// NullGraphicsContext::BindFragmentDataLocation
+//
+void NullGraphicsContext::BindFragmentDataLocation(T_ShaderLoc const program, uint32 const colorNumber, std::string const& name) const
+{
+	UNUSED(name);
+	Record(E_GraphicsCommand::BindFragmentDataLocation, 0u, program, colorNumber);
+}
+
+//---------------------------------
+// NullGraphicsContext::AttachShader
+//
+void NullGraphicsContext::AttachShader(T_ShaderLoc const program, T_ShaderLoc const shader) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if (foundIt != m_Programs.cend())
+	{
+		foundIt->second.shaders.push_back(shader);
+	}
+
+	Record(E_GraphicsCommand::AttachShader, 0u, program, shader);
+}
+
+//---------------------------------
+// NullGraphicsContext::LinkProgram
+//
+void NullGraphicsContext::LinkProgram(T_ShaderLoc const program) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if (foundIt != m_Programs.cend())
+	{
+		ReflectProgram(foundIt->second);
+	}
+
+	Record(E_GraphicsCommand::LinkProgram, 0u, program);
+}
+
+//---------------------------------
+// NullGraphicsContext::IsShaderCompiled
+//
+bool NullGraphicsContext::IsShaderCompiled(T_ShaderLoc const shader) const
+{
+	auto const foundIt = m_Shaders.find(shader);
+	return (foundIt != m_Shaders.cend()) && foundIt->second.isCompiled;
+}
+
+//---------------------------------
+// NullGraphicsContext::GetShaderInfo
+//
+void NullGraphicsContext::GetShaderInfo(T_ShaderLoc const shader, std::string& info) const
+{
+	info = IsShaderCompiled(shader) ? std::string() : std::string("null context: shader has no source");
+}
+
+//---------------------------------
+// NullGraphicsContext::GetUniformBlockIndex
+//
+T_BlockIndex NullGraphicsContext::GetUniformBlockIndex(T_ShaderLoc const program, std::string const& blockName) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if (foundIt != m_Programs.cend())
+	{
+		std::vector<std::string> const& blocks = foundIt->second.uniformBlocks;
+
+		auto const blockIt = std::find(blocks.cbegin(), blocks.cend(), blockName);
+		if (blockIt != blocks.cend())
+		{
+			return static_cast<T_BlockIndex>(blockIt - blocks.cbegin());
+		}
+	}
+
+	return -1;
+}
+
+//---------------------------------
+// NullGraphicsContext::IsBlockIndexValid
+//
+bool NullGraphicsContext::IsBlockIndexValid(T_BlockIndex const index) const
+{
+	return (index >= 0);
+}
+
+//---------------------------------
+// NullGraphicsContext::GetUniformBlockNames
+//
+std::vector<std::string> NullGraphicsContext::GetUniformBlockNames(T_ShaderLoc const program) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if (foundIt != m_Programs.cend())
+	{
+		return foundIt->second.uniformBlocks;
+	}
+
+	return std::vector<std::string>();
+}
+
+//---------------------------------
+// NullGraphicsContext::GetUniformIndicesForBlock
+//
+std::vector<int32> NullGraphicsContext::GetUniformIndicesForBlock(T_ShaderLoc const program, T_BlockIndex const blockIndex) const
+{
+	std::vector<int32> indices;
+
+	auto const foundIt = m_Programs.find(program);
+	if (foundIt != m_Programs.cend())
+	{
+		std::vector<ProgramUniform> const& uniforms = foundIt->second.uniforms;
+		for (size_t uniIdx = 0u; uniIdx < uniforms.size(); ++uniIdx)
+		{
+			if (uniforms[uniIdx].blockIndex == blockIndex)
+			{
+				indices.push_back(static_cast<int32>(uniIdx));
+			}
+		}
+	}
+
+	return indices;
+}
+
+//---------------------------------
+// NullGraphicsContext::SetUniformBlockBinding
+//
+void NullGraphicsContext::SetUniformBlockBinding(T_ShaderLoc const program, T_BlockIndex const blockIndex, uint32 const bindingIndex) const
+{
+	Record(E_GraphicsCommand::SetUniformBlockBinding, static_cast<uint8>(blockIndex), program, bindingIndex);
+}
+
+//---------------------------------
+// NullGraphicsContext::GetAttributeCount
+//
+int32 NullGraphicsContext::GetAttributeCount(T_ShaderLoc const program) const
+{
+	auto const foundIt = m_Programs.find(program);
+	return (foundIt != m_Programs.cend()) ? static_cast<int32>(foundIt->second.attributes.size()) : 0;
+}
+
+//---------------------------------
+// NullGraphicsContext::GetUniformCount
+//
+int32 NullGraphicsContext::GetUniformCount(T_ShaderLoc const program) const
+{
+	auto const foundIt = m_Programs.find(program);
+	return (foundIt != m_Programs.cend()) ? static_cast<int32>(foundIt->second.uniforms.size()) : 0;
+}
+
+//---------------------------------
+// NullGraphicsContext::GetActiveUniforms
+//
+// Arrays are expanded into one descriptor per element, like the GL implementation does
+//
+void NullGraphicsContext::GetActiveUniforms(T_ShaderLoc const program, uint32 const index, std::vector<UniformDescriptor>& uniforms) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if ((foundIt == m_Programs.cend()) || (index >= static_cast<uint32>(foundIt->second.uniforms.size())))
+	{
+		return;
+	}
+
+	ProgramUniform const& uniform = foundIt->second.uniforms[index];
+	for (uint32 arrayIdx = 0u; arrayIdx < uniform.arrayCount; ++arrayIdx)
+	{
+		uniforms.push_back(UniformDescriptor());
+		UniformDescriptor& uni = uniforms.back();
+
+		uni.name = uniform.name;
+		if (uniform.arrayCount > 1u)
+		{
+			uni.name += "[" + std::to_string(arrayIdx) + "]";
+		}
+
+		uni.type = uniform.type;
+
+		if (uniform.blockIndex >= 0)
+		{
+			uni.location = -1;
+			uni.blockOffset = uniform.blockOffset + static_cast<int32>(arrayIdx) * 16 * ((static_cast<int32>(parameters::GetSize(uniform.type)) + 15) / 16);
+		}
+		else
+		{
+			uni.location = uniform.location + static_cast<T_UniformLoc>(arrayIdx);
+		}
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::GetActiveAttribute
+//
+void NullGraphicsContext::GetActiveAttribute(T_ShaderLoc const program, uint32 const index, AttributeDescriptor& info) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if ((foundIt != m_Programs.cend()) && (index < static_cast<uint32>(foundIt->second.attributes.size())))
+	{
+		info = foundIt->second.attributes[index];
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::GetAttributeLocation
+//
+T_AttribLoc NullGraphicsContext::GetAttributeLocation(T_ShaderLoc const program, std::string const& name) const
+{
+	auto const foundIt = m_Programs.find(program);
+	if (foundIt != m_Programs.cend())
+	{
+		ProgramInfo const& info = foundIt->second;
+		for (size_t attribIdx = 0u; attribIdx < info.attributes.size(); ++attribIdx)
+		{
+			if (info.attributes[attribIdx].name == name)
+			{
+				return info.attributeLocations[attribIdx];
+			}
+		}
+	}
+
+	return -1;
+}
+
+//---------------------------------
+// NullGraphicsContext::PopulateUniform
+//
+// Uniforms are never initialized by the null context, which matches the zero initialization a driver does
+//
+void NullGraphicsContext::PopulateUniform(T_ShaderLoc const program, T_UniformLoc const location, E_ParamType const type, void* data) const
+{
+	switch (type)
+	{
+	case E_ParamType::Texture2D:
+	case E_ParamType::Texture3D:
+	case E_ParamType::TextureCube:
+	case E_ParamType::TextureShadow:
+		*static_cast<TextureData const**>(data) = nullptr;
+		break;
+
+	default:
+		memset(data, 0, parameters::GetSize(type));
+		break;
+	}
+
+	Record(E_GraphicsCommand::PopulateUniform, static_cast<uint8>(type), program, static_cast<uint32>(location));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, bool const data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Boolean), 0u, static_cast<uint32>(location), sizeof(int32));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, int32 const data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Int), 0u, static_cast<uint32>(location), sizeof(int32));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, uint32 const data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::UInt), 0u, static_cast<uint32>(location), sizeof(uint32));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, float const data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Float), 0u, static_cast<uint32>(location), sizeof(float));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, vec2 const data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Vector2), 0u, static_cast<uint32>(location), sizeof(vec2));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, vec3 const& data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Vector3), 0u, static_cast<uint32>(location), sizeof(vec3));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, vec4 const& data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Vector4), 0u, static_cast<uint32>(location), sizeof(vec4));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, mat3 const& data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Matrix3x3), 0u, static_cast<uint32>(location), sizeof(mat3));
+}
+
+//---------------------------------
+// NullGraphicsContext::UploadUniform
+//
+void NullGraphicsContext::UploadUniform(T_UniformLoc const location, mat4 const& data) const
+{
+	UNUSED(data);
+	Record(E_GraphicsCommand::UploadUniform, static_cast<uint8>(E_ParamType::Matrix4x4), 0u, static_cast<uint32>(location), sizeof(mat4));
+}
+
+//---------------------------------
+// NullGraphicsContext::DefineVertexAttributePointer
+//
+void NullGraphicsContext::DefineVertexAttributePointer(uint32 const index, int32 const size, E_DataType const type, bool const norm, int32 const stride, size_t const offset) const
+{
+	UNUSED(size);
+	UNUSED(norm);
+	UNUSED(stride);
+	UNUSED(offset);
+
+	Record(E_GraphicsCommand::DefineVertexAttributePointer, static_cast<uint8>(type), m_BoundVertexArray, index);
+}
+
+//---------------------------------
+// NullGraphicsContext::DefineVertexAttribIPointer
+//
+void NullGraphicsContext::DefineVertexAttribIPointer(uint32 const index, int32 const size, E_DataType const type, int32 const stride, size_t const offset) const
+{
+	UNUSED(size);
+	UNUSED(stride);
+	UNUSED(offset);
+
+	Record(E_GraphicsCommand::DefineVertexAttribIPointer, static_cast<uint8>(type), m_BoundVertexArray, index);
+}
+
+//---------------------------------
+// NullGraphicsContext::DefineVertexAttribDivisor
+//
+void NullGraphicsContext::DefineVertexAttribDivisor(uint32 const index, uint32 const divisor) const
+{
+	Record(E_GraphicsCommand::DefineVertexAttribDivisor, static_cast<uint8>(divisor), m_BoundVertexArray, index);
+}
+
+//---------------------------------
+// NullGraphicsContext::GenFramebuffers
+//
+void NullGraphicsContext::GenFramebuffers(int32 const n, T_FbLoc *ids) const
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		ids[idx] = GenHandle();
+		Record(E_GraphicsCommand::GenFramebuffer, 0u, ids[idx]);
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteFramebuffers
+//
+void NullGraphicsContext::DeleteFramebuffers(int32 const n, T_FbLoc *ids)
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		if (ids[idx] == m_ReadFramebuffer)
+		{
+			m_ReadFramebuffer = 0u;
+		}
+
+		if (ids[idx] == m_DrawFramebuffer)
+		{
+			m_DrawFramebuffer = 0u;
+		}
+
+		Record(E_GraphicsCommand::DeleteFramebuffer, 0u, ids[idx]);
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::GenRenderBuffers
+//
+void NullGraphicsContext::GenRenderBuffers(int32 const n, T_RbLoc *ids) const
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		ids[idx] = GenHandle();
+		Record(E_GraphicsCommand::GenRenderbuffer, 0u, ids[idx]);
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::DeleteRenderBuffers
+//
+void NullGraphicsContext::DeleteRenderBuffers(int32 const n, T_RbLoc *ids)
+{
+	for (int32 idx = 0; idx < n; ++idx)
+	{
+		Record(E_GraphicsCommand::DeleteRenderbuffer, 0u, ids[idx]);
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::SetRenderbufferStorage
+//
+void NullGraphicsContext::SetRenderbufferStorage(E_RenderBufferFormat const format, ivec2 const dimensions) const
+{
+	Record(E_GraphicsCommand::SetRenderbufferStorage, static_cast<uint8>(format), 0u, static_cast<uint32>(dimensions.x * dimensions.y));
+}
+
+//---------------------------------
+// NullGraphicsContext::LinkTextureToFbo
+//
+void NullGraphicsContext::LinkTextureToFbo(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const
+{
+	Record(E_GraphicsCommand::LinkTextureToFbo, attachment, texHandle, static_cast<uint32>(level));
+}
+
+//---------------------------------
+// NullGraphicsContext::LinkTextureToFbo2D
+//
+void NullGraphicsContext::LinkTextureToFbo2D(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const
+{
+	Record(E_GraphicsCommand::LinkTextureToFbo, attachment, texHandle, static_cast<uint32>(level));
+}
+
+//---------------------------------
+// NullGraphicsContext::LinkCubeMapFaceToFbo2D
+//
+void NullGraphicsContext::LinkCubeMapFaceToFbo2D(uint8 const face, T_TextureLoc const texHandle, int32 const level) const
+{
+	Record(E_GraphicsCommand::LinkTextureToFbo, face, texHandle, static_cast<uint32>(level));
+}
+
+//---------------------------------
+// NullGraphicsContext::LinkTextureToFboDepth
+//
+void NullGraphicsContext::LinkTextureToFboDepth(T_TextureLoc const texHandle) const
+{
+	Record(E_GraphicsCommand::LinkTextureToFbo, 0u, texHandle);
+}
+
+//---------------------------------
+// NullGraphicsContext::LinkRenderbufferToFbo
+//
+void NullGraphicsContext::LinkRenderbufferToFbo(E_RenderBufferFormat const attachment, uint32 const rboHandle) const
+{
+	Record(E_GraphicsCommand::LinkRenderbufferToFbo, static_cast<uint8>(attachment), rboHandle);
+}
+
+//---------------------------------
+// NullGraphicsContext::SetDrawBufferCount
+//
+void NullGraphicsContext::SetDrawBufferCount(size_t const count) const
+{
+	Record(E_GraphicsCommand::SetDrawBufferCount, 0u, 0u, static_cast<uint32>(count));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetReadBufferEnabled
+//
+void NullGraphicsContext::SetReadBufferEnabled(bool const val) const
+{
+	Record(E_GraphicsCommand::SetReadBufferEnabled, static_cast<uint8>(val));
+}
+
+//---------------------------------
+// NullGraphicsContext::IsFramebufferComplete
+//
+bool NullGraphicsContext::IsFramebufferComplete() const
+{
+	return true;
+}
+
+//---------------------------------
+// NullGraphicsContext::CopyDepthReadToDrawFbo
+//
+void NullGraphicsContext::CopyDepthReadToDrawFbo(ivec2 const source, ivec2 const target) const
+{
+	UNUSED(target);
+	Record(E_GraphicsCommand::CopyDepthReadToDrawFbo, 0u, 0u, static_cast<uint32>(source.x * source.y));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetPixelUnpackAlignment
+//
+void NullGraphicsContext::SetPixelUnpackAlignment(int32 const val) const
+{
+	Record(E_GraphicsCommand::SetPixelUnpackAlignment, static_cast<uint8>(val));
+}
+
+//---------------------------------
+// NullGraphicsContext::SetDepthFunction
+//
+void NullGraphicsContext::SetDepthFunction(E_DepthFunc const func) const
+{
+	Record(E_GraphicsCommand::SetDepthFunction, static_cast<uint8>(func));
+}
+
+//---------------------------------
+// NullGraphicsContext::ReadPixels
+//
+// Read back data is zeroed
+//
+void NullGraphicsContext::ReadPixels(ivec2 const pos, ivec2 const size, E_ColorFormat const format, E_DataType const type, void* data) const
+{
+	UNUSED(pos);
+
+	uint64 const pixelCount = static_cast<uint64>(size.x) * static_cast<uint64>(size.y);
+	uint64 const bytes = pixelCount * GetChannelCount(format) * GetDataTypeSize(type);
+	if (data != nullptr)
+	{
+		memset(data, 0, static_cast<size_t>(bytes));
+	}
+
+	Record(E_GraphicsCommand::ReadPixels, static_cast<uint8>(format), m_ReadFramebuffer, static_cast<uint32>(pixelCount), bytes);
+}
+
+//---------------------------------
+// NullGraphicsContext::DebugPushGroup
+//
+void NullGraphicsContext::DebugPushGroup(std::string const& message, bool const isThirdParty) const
+{
+	UNUSED(message);
+	Record(E_GraphicsCommand::DebugPushGroup, static_cast<uint8>(isThirdParty));
+}
+
+//---------------------------------
+// NullGraphicsContext::DebugPopGroup
+//
+void NullGraphicsContext::DebugPopGroup() const
+{
+	Record(E_GraphicsCommand::DebugPopGroup);
+}
+
+//---------------------------------
+// NullGraphicsContext::Record
+//
+void NullGraphicsContext::Record(E_GraphicsCommand const cmd, uint8 const target, uint32 const handle, uint32 const count, uint64 const bytes) const
+{
+	if (m_IsRecording)
+	{
+		m_Log.Record(cmd, target, handle, count, bytes);
+	}
+}
+
+//---------------------------------
+// NullGraphicsContext::GenHandle
+//
+// All object types share one counter, which makes accidentally mixing up handles of different types visible
+//
+uint32 NullGraphicsContext::GenHandle() const
+{
+	return ++m_LastHandle;
+}
+
+//---------------------------------
+// NullGraphicsContext::ReflectProgram
+//
+// Merge declarations from all attached stages - uniforms get sequential locations, vertex inputs keep explicit locations
+//  - uniform block members are listed after the default uniforms, with std140 offsets instead of locations
+//
+void NullGraphicsContext::ReflectProgram(ProgramInfo& program) const
+{
+	program.uniformBlocks.clear();
+	program.uniforms.clear();
+	program.attributes.clear();
+	program.attributeLocations.clear();
+
+	T_UniformLoc nextUniformLocation = 0;
+	T_AttribLoc nextAttributeLocation = 0;
+
+	std::vector<std::vector<GlslVariable>> blockMembers;
+
+	for (T_ShaderLoc const shaderLoc : program.shaders)
+	{
+		auto const shaderIt = m_Shaders.find(shaderLoc);
+		if (shaderIt == m_Shaders.cend())
+		{
+			continue;
+		}
+
+		GlslDeclarations declarations;
+		ScanGlslDeclarations(shaderIt->second.source, (shaderIt->second.type == E_ShaderType::Vertex), declarations);
+
+		// blocks
+		for (size_t blockIdx = 0u; blockIdx < declarations.uniformBlocks.size(); ++blockIdx)
+		{
+			std::string const& block = declarations.uniformBlocks[blockIdx];
+			if (std::find(program.uniformBlocks.cbegin(), program.uniformBlocks.cend(), block) == program.uniformBlocks.cend())
+			{
+				program.uniformBlocks.push_back(block);
+				blockMembers.push_back(declarations.blockMembers[blockIdx]);
+			}
+		}
+
+		// default uniforms - stages may declare the same uniform
+		for (GlslVariable const& variable : declarations.uniforms)
+		{
+			E_ParamType const type = ParseGlslParamType(variable.type);
+			if (type == E_ParamType::Invalid)
+			{
+				continue;
+			}
+
+			auto const existingIt = std::find_if(program.uniforms.cbegin(), program.uniforms.cend(), [&variable](ProgramUniform const& uni)
+				{
+					return uni.name == variable.name;
+				});
+
+			if (existingIt != program.uniforms.cend())
+			{
+				continue;
+			}
+
+			program.uniforms.push_back(ProgramUniform{ variable.name, type, variable.arrayCount, nextUniformLocation });
+			nextUniformLocation += static_cast<T_UniformLoc>(variable.arrayCount);
+		}
+
+		// vertex inputs
+		for (GlslVariable const& variable : declarations.inputs)
+		{
+			AttributeDescriptor attribute;
+			attribute.name = variable.name;
+			if (!ParseGlslAttributeType(variable.type, attribute.dataType, attribute.dataCount))
+			{
+				continue;
+			}
+
+			T_AttribLoc const location = (variable.location >= 0) ? static_cast<T_AttribLoc>(variable.location) : nextAttributeLocation;
+			nextAttributeLocation = std::max(nextAttributeLocation, location + 1);
+
+			program.attributes.push_back(attribute);
+			program.attributeLocations.push_back(location);
+		}
+	}
+
+	// block members
+	for (size_t blockIdx = 0u; blockIdx < blockMembers.size(); ++blockIdx)
+	{
+		int32 offset = 0;
+		for (GlslVariable const& member : blockMembers[blockIdx])
+		{
+			E_ParamType const type = ParseGlslParamType(member.type);
+			if (type == E_ParamType::Invalid)
+			{
+				continue;
+			}
+
+			int32 alignment;
+			int32 size;
+			GetStd140Layout(type, member.arrayCount, alignment, size);
+
+			offset = alignment * ((offset + alignment - 1) / alignment);
+
+			ProgramUniform uniform{ member.name, type, member.arrayCount, -1 };
+			uniform.blockIndex = static_cast<T_BlockIndex>(blockIdx);
+			uniform.blockOffset = offset;
+			program.uniforms.push_back(uniform);
+
+			offset += size;
+		}
+	}
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,300 @@
+#pragma once
+#include <unordered_map>
+
+#include "GraphicsApiContext.h"
+#include "GraphicsCommandLog.h"
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// NullGraphicsContext
+//
+// Graphics api implementation that doesn't talk to a GPU, for benchmarking and testing CPU side rendering code headless
+//  - every call is recorded into a command log, which can be validated or compared against a previously recorded log
+//  - objects get unique fake handles, buffer contents are kept in memory so that mapping works as expected
+//  - shader programs are reflected by scanning the GLSL source for uniforms, uniform blocks and vertex inputs
+//     - unlike a real driver, unused declarations are not optimized out
+//
+class NullGraphicsContext final : public I_GraphicsApiContext
+{
+	// definitions
+	//-------------
+	static constexpr T_TextureUnit s_TextureUnitCount = 32u;
+
+	//---------------------------------
+	// ShaderSource
+	//
+	struct ShaderSource final
+	{
+		E_ShaderType type;
+		std::string source;
+		bool isCompiled = false;
+	};
+
+	//---------------------------------
+	// ProgramUniform
+	//
+	// arrays occupy a contiguous range of locations
+	//
+	struct ProgramUniform final
+	{
+		std::string name;
+		E_ParamType type;
+		uint32 arrayCount;
+		T_UniformLoc location;
+		T_BlockIndex blockIndex = -1;
+		int32 blockOffset = -1; // std140, arrays use a stride of 16 bytes
+	};
+
+	//---------------------------------
+	// ProgramInfo
+	//
+	struct ProgramInfo final
+	{
+		std::vector<T_ShaderLoc> shaders;
+
+		std::vector<std::string> uniformBlocks;
+		std::vector<ProgramUniform> uniforms;
+		std::vector<AttributeDescriptor> attributes;
+		std::vector<T_AttribLoc> attributeLocations;
+	};
+
+public:
+	// init deinit
+	//--------------
+	NullGraphicsContext() : I_GraphicsApiContext() { m_UnitTextures.fill(0u); }
+	~NullGraphicsContext() = default;
+
+	// functionality
+	//---------------
+	void SetRecording(bool const isRecording) { m_IsRecording = isRecording; }
+
+	// accessors
+	//-----------
+	GraphicsCommandLog& GetLog() { return m_Log; }
+	GraphicsCommandLog const& GetLog() const { return m_Log; }
+
+	bool IsRecording() const { return m_IsRecording; }
+
+	//===============================
+	// Interface implementation
+	//===============================
+
+	void Initialize(ivec2 const dimensions) override;
+
+	// State changes
+	//--------------
+	void SetDepthEnabled(bool const enabled) override;
+	void SetBlendEnabled(bool const enabled) override;
+	void SetBlendEnabled(bool const enabled, uint32 const index) override;
+	void SetBlendEnabled(std::vector<bool> const& blendBuffers) override;
+	void SetStencilEnabled(bool const enabled) override;
+	void SetCullEnabled(bool const enabled) override;
+
+	void SetSeamlessCubemapsEnabled(bool const enabled) override;
+
+	void SetFaceCullingMode(E_FaceCullMode const cullMode) override;
+	void SetBlendEquation(E_BlendEquation const equation) override;
+	void SetBlendFunction(E_BlendFactor const sFactor, E_BlendFactor const dFactor) override;
+
+	void SetViewport(ivec2 const pos, ivec2 const size) override;
+	void GetViewport(ivec2& pos, ivec2& size) override;
+
+	void SetClearColor(vec4 const& col) override;
+
+	void SetShader(ShaderData const* pShader) override;
+
+	void BindFramebuffer(T_FbLoc const handle) override;
+	void BindReadFramebuffer(T_FbLoc const handle) override;
+	void BindDrawFramebuffer(T_FbLoc const handle) override;
+
+	void BindRenderbuffer(T_RbLoc const handle) override;
+
+	T_TextureUnit BindTexture(E_TextureType const target, T_TextureLoc const texLoc, bool const ensureActive) override;
+	void UnbindTexture(E_TextureType const target, T_TextureLoc const texLoc) override;
+
+	void BindVertexArray(T_ArrayLoc const vertexArray) override;
+	void BindBuffer(E_BufferType const target, T_BufferLoc const buffer) override;
+
+	void SetLineWidth(float const lineWidth) override;
+
+	T_FbLoc GetActiveFramebuffer() override;
+
+	//Draw Calls
+	//--------------
+	void DrawArrays(E_DrawMode const mode, uint32 const first, uint32 const count) override;
+	void DrawElements(E_DrawMode const mode, uint32 const count, E_DataType const type, const void * indices) override;
+	void DrawElementsInstanced(E_DrawMode const mode,
+		uint32 const count,
+		E_DataType const type,
+		const void * indices,
+		uint32 const primcount) override;
+
+	// other commands
+	//--------------
+	void Flush() const override;
+	void Finish() const override;
+	void Clear(T_ClearFlags const mask) const override;
+
+	T_ArrayLoc CreateVertexArray() const override;
+	T_BufferLoc CreateBuffer() const override;
+
+	void DeleteVertexArray(T_ArrayLoc& loc) const override;
+	void DeleteBuffer(T_BufferLoc& loc) const override;
+
+	void SetBufferData(E_BufferType const target,
+		int64 const size,
+		void const* const data,
+		E_UsageHint const usage) const override;
+	void SetVertexAttributeArrayEnabled(uint32 const index, bool const enabled) const override;
+
+	void* MapBuffer(E_BufferType const target, E_AccessMode const access) const override;
+	void* MapBufferRange(E_BufferType const target, int64 const offset, int64 const size, bool const unsynchronized) const override;
+	void UnmapBuffer(E_BufferType const target) const override;
+
+	void BindBufferRange(E_BufferType const target,
+		uint32 const index,
+		T_BufferLoc const buffer,
+		size_t const offset,
+		size_t const size) const override;
+
+	T_TextureLoc GenerateTexture() const override;
+	void DeleteTexture(T_TextureLoc& texLoc) override;
+	void SetTextureData(TextureData& texture, void* data) override;
+	void SetTextureMipData(TextureData const& texture, uint8 const mipLevel, void const* const data, size_t const size) override;
+	void GetTextureData(TextureData const& texture, uint8 const mipLevel, void* const data) override;
+	void SetTextureParams(TextureData const& texture,
+		uint8& mipLevels,
+		TextureParameters& prev,
+		TextureParameters const& next,
+		bool const force) override;
+	T_TextureHandle GetTextureHandle(T_TextureLoc const texLoc) const override;
+	void SetTextureHandleResidency(T_TextureHandle const handle, bool const isResident) const override;
+
+	T_ShaderLoc CreateShader(E_ShaderType const type) const override;
+	T_ShaderLoc CreateProgram() const override;
+	void DeleteShader(T_ShaderLoc const shader) override;
+	void DeleteProgram(T_ShaderLoc const program) override;
+
+	void CompileShader(T_ShaderLoc const shader, std::string const& source) const override;
+	void BindFragmentDataLocation(T_ShaderLoc const program, uint32 const colorNumber, std::string const& name) const override;
+	void AttachShader(T_ShaderLoc const program, T_ShaderLoc const shader) const override;
+	void LinkProgram(T_ShaderLoc const program) const override;
+
+	bool IsShaderCompiled(T_ShaderLoc const shader) const override;
+	void GetShaderInfo(T_ShaderLoc const shader, std::string& info) const override;
+
+	T_BlockIndex GetUniformBlockIndex(T_ShaderLoc const program, std::string const& blockName) const override;
+	bool IsBlockIndexValid(T_BlockIndex const index) const override;
+	std::vector<std::string> GetUniformBlockNames(T_ShaderLoc const program) const override;
+	std::vector<int32> GetUniformIndicesForBlock(T_ShaderLoc const program, T_BlockIndex const blockIndex) const override;
+
+	void SetUniformBlockBinding(T_ShaderLoc const program, T_BlockIndex const blockIndex, uint32 const bindingIndex) const override;
+
+	int32 GetAttributeCount(T_ShaderLoc const program) const override;
+	int32 GetUniformCount(T_ShaderLoc const program) const override;
+	void GetActiveUniforms(T_ShaderLoc const program, uint32 const index, std::vector<UniformDescriptor>& uniforms) const override;
+	void GetActiveAttribute(T_ShaderLoc const program, uint32 const index, AttributeDescriptor& info) const override;
+	T_AttribLoc GetAttributeLocation(T_ShaderLoc const program, std::string const& name) const override;
+
+	void PopulateUniform(T_ShaderLoc const program, T_UniformLoc const location, E_ParamType const type, void* data) const override;
+
+	void UploadUniform(T_UniformLoc const location, bool const data) const override;
+	void UploadUniform(T_UniformLoc const location, int32 const data) const override;
+	void UploadUniform(T_UniformLoc const location, uint32 const data) const override;
+	void UploadUniform(T_UniformLoc const location, float const data) const override;
+	void UploadUniform(T_UniformLoc const location, vec2 const data) const override;
+	void UploadUniform(T_UniformLoc const location, vec3 const& data) const override;
+	void UploadUniform(T_UniformLoc const location, vec4 const& data) const override;
+	void UploadUniform(T_UniformLoc const location, mat3 const& data) const override;
+	void UploadUniform(T_UniformLoc const location, mat4 const& data) const override;
+
+	void DefineVertexAttributePointer(uint32 const index,
+		int32 const size,
+		E_DataType const type,
+		bool const norm,
+		int32 const stride,
+		size_t const offset) const override;
+	void DefineVertexAttribIPointer(uint32 const index,
+		int32 const size,
+		E_DataType const type,
+		int32 const stride,
+		size_t const offset) const override;
+	void DefineVertexAttribDivisor(uint32 const index, uint32 const divisor) const override;
+
+	void GenFramebuffers(int32 const n, T_FbLoc *ids) const override;
+	void DeleteFramebuffers(int32 const n, T_FbLoc *ids) override;
+
+	void GenRenderBuffers(int32 const n, T_RbLoc *ids) const override;
+	void DeleteRenderBuffers(int32 const n, T_RbLoc *ids) override;
+
+	void SetRenderbufferStorage(E_RenderBufferFormat const format, ivec2 const dimensions) const override;
+
+	void LinkTextureToFbo(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const override;
+	void LinkTextureToFbo2D(uint8 const attachment, T_TextureLoc const texHandle, int32 const level) const override;
+	void LinkCubeMapFaceToFbo2D(uint8 const face, T_TextureLoc const texHandle, int32 const level) const override;
+	void LinkTextureToFboDepth(T_TextureLoc const texHandle) const override;
+
+	void LinkRenderbufferToFbo(E_RenderBufferFormat const attachment, uint32 const rboHandle) const override;
+
+	void SetDrawBufferCount(size_t const count) const override;
+	void SetReadBufferEnabled(bool const val) const override;
+
+	bool IsFramebufferComplete() const override;
+
+	void CopyDepthReadToDrawFbo(ivec2 const source, ivec2 const target) const override;
+
+	void SetPixelUnpackAlignment(int32 const val) const override;
+
+	void SetDepthFunction(E_DepthFunc const func) const override;
+
+	void ReadPixels(ivec2 const pos, ivec2 const size, E_ColorFormat const format, E_DataType const type, void* data) const override;
+
+	void DebugPushGroup(std::string const& message, bool const isThirdParty = false) const override;
+	void DebugPopGroup() const override;
+
+	// utility
+	//---------
+private:
+	void Record(E_GraphicsCommand const cmd, uint8 const target = 0u, uint32 const handle = 0u, uint32 const count = 0u, uint64 const bytes = 0u) const;
+	uint32 GenHandle() const;
+
+	T_BufferLoc GetBoundBuffer(E_BufferType const target) const { return m_BoundBuffers[static_cast<size_t>(target)]; }
+
+	void ReflectProgram(ProgramInfo& program) const;
+
+
+	// Data
+	///////
+
+	// const functions on the interface still create objects and record, so most state is mutable
+	mutable GraphicsCommandLog m_Log;
+	bool m_IsRecording = true;
+
+	mutable uint32 m_LastHandle = 0u;
+
+	ivec2 m_ViewportPosition = ivec2(0);
+	ivec2 m_ViewportSize = ivec2(0);
+
+	ShaderData const* m_pBoundShader = nullptr;
+	T_ArrayLoc m_BoundVertexArray = 0u;
+	mutable std::array<T_BufferLoc, 3u> m_BoundBuffers = { { 0u, 0u, 0u } }; // per E_BufferType
+
+	T_FbLoc m_ReadFramebuffer = 0u;
+	T_FbLoc m_DrawFramebuffer = 0u;
+
+	std::unordered_map<T_TextureLoc, T_TextureUnit> m_TextureUnits;
+	std::array<T_TextureLoc, s_TextureUnitCount> m_UnitTextures; // reverse lookup, units are reassigned round robin
+	T_TextureUnit m_NextTextureUnit = 0u;
+
+	mutable std::unordered_map<T_BufferLoc, std::vector<uint8>> m_Buffers;
+	mutable std::unordered_map<T_ShaderLoc, ShaderSource> m_Shaders;
+	mutable std::unordered_map<T_ShaderLoc, ProgramInfo> m_Programs;
+};
+
+
+} // namespace render
+} // namespace et
@@ -167,7 +167,8 @@ void Viewport::OnResize(vec2 const resolution)
 		m_Renderer->OnResize(m_Dimensions);
 	}
 
-	m_Events.Notify(render::E_ViewportEvent::VP_Resized, new render::ViewportEventData(this, m_Dimensions));
+	render::ViewportEventData const eventData(this, m_Dimensions);
+	m_Events.Notify(render::E_ViewportEvent::VP_Resized, &eventData);
 }
 
 //---------------------------------
@@ -1,4 +1,6 @@
 #pragma once
+#include <limits>
+
 
 namespace et {
 namespace render {
@@ -19,6 +21,34 @@ class DirectionalShadowData final
 	//-------------
 public:
 
+	//------------------------------------
+	// DirectionalShadowData::CasterList
+	//
+	// Shadow casters that can draw into a cascade, valid while neither the cascade projection nor the casters change
+	//
+	struct CasterList
+	{
+		//-----------------------------------------------
+		// DirectionalShadowData::CasterList::MeshGroup
+		//
+		// Visible instances of a mesh that draw with the same level of detail
+		//
+		struct MeshGroup
+		{
+			uint32 mesh; // ID
+			uint32 lod;
+			uint32 count; // number of visible instances
+		};
+
+		bool IsValid(mat4 const& viewProj, uint32 const casterRevision) const { return (revision == casterRevision) && (lightVP == viewProj); }
+
+		mat4 lightVP;
+		uint32 revision = std::numeric_limits<uint32>::max();
+
+		std::vector<MeshGroup> meshes;
+		std::vector<uint32> instances; // indices into the instance lists of all meshes, in group order
+	};
+
 	//------------------------------------
 	// DirectionalShadowData::CascadeData
 	//
@@ -31,6 +61,8 @@ public:
 
 		T_FbLoc fbo;
 		TextureData* texture;
+
+		CasterList casters;
 	};
 
 	// construct destruct
@@ -16,6 +16,47 @@ namespace et {
 namespace render {
 
 
+namespace {
+
+	//---------------------------------
+	// GetEnvironmentCacheKey
+	//
+	// Prefiltered maps depend on the source image and the resolutions they are rendered at
+	//
+	PrecomputeCache::T_Key GetEnvironmentCacheKey(std::vector<uint8> const& data, EnvironmentMapAsset const& asset)
+	{
+		int32 const settings[] = {
+			asset.m_CubemapRes,
+			asset.m_IrradianceRes,
+			asset.m_RadianceRes,
+			static_cast<int32>(PrecomputeCache::s_Version)
+		};
+
+		uint64 const settingsHash = GetDataHash64(reinterpret_cast<uint8 const*>(settings), sizeof(settings), "environment map"_hash);
+		return GetDataHash64(data.data(), data.size(), settingsHash);
+	}
+
+	//---------------------------------
+	// GetCubeParameters
+	//
+	// Filtering of the cube maps an environment map consists of, as set up by EquirectangularToCubeMap and PbrPrefilter::PrefilterCube
+	//
+	TextureParameters GetCubeParameters(bool const useMipMaps)
+	{
+		TextureParameters params(false);
+		params.minFilter = E_TextureFilterMode::Linear;
+		params.magFilter = E_TextureFilterMode::Linear;
+		params.wrapS = E_TextureWrapMode::ClampToEdge;
+		params.wrapT = E_TextureWrapMode::ClampToEdge;
+		params.wrapR = E_TextureWrapMode::ClampToEdge;
+		params.genMipMaps = useMipMaps;
+
+		return params;
+	}
+
+} // namespace
+
+
 //=================
 // Environment Map
 //=================
@@ -70,11 +111,35 @@ DEFINE_FORCED_LINKING(EnvironmentMapAsset) // force the shader class to be linke
 // EnvironmentMapAsset::LoadFromMemory
 //
 // Loads an equirectangular texture, converts it to a cubemap, and prefilters irradiance and radiance cubemaps for IBL
+//  - the resulting cube maps and their mip chains are cached, so that an unchanged environment is only prefiltered once
 //
 bool EnvironmentMapAsset::LoadFromMemory(std::vector<uint8> const& data)
 {
 	Viewport::GetCurrentApiContext()->SetSeamlessCubemapsEnabled(true);
 
+	PrecomputeCache const& cache = RenderingSystems::Instance()->GetPrecomputeCache();
+	PrecomputeCache::T_Key const cacheKey = GetEnvironmentCacheKey(data, *this);
+
+	std::vector<TextureData*> cached;
+	if (cache.Load(cacheKey, cached))
+	{
+		if ((cached.size() == 3u) && (cached[2]->GetNumMipLevels() > 2))
+		{
+			cached[0]->SetParameters(GetCubeParameters(true));
+			cached[1]->SetParameters(GetCubeParameters(false));
+			cached[2]->SetParameters(GetCubeParameters(true));
+
+			m_Data = new EnvironmentMap(cached[0], cached[1], cached[2]);
+			return true;
+		}
+
+		LOG("EnvironmentMapAsset::LoadFromMemory > Unexpected cache entry, prefiltering again", core::LogLevel::Warning);
+		for (TextureData* const texture : cached)
+		{
+			delete texture;
+		}
+	}
+
 	//load equirectangular texture
 	//****************************
 	std::string extension = core::FileUtil::ExtractExtension(GetName());
@@ -117,6 +182,8 @@ bool EnvironmentMapAsset::LoadFromMemory(std::vector<uint8> const& data)
 	TextureData* radianceMap = nullptr;
 	PbrPrefilter::PrefilterCube(envCubemap, irradianceMap, radianceMap, m_CubemapRes, m_IrradianceRes, m_RadianceRes);
 
+	cache.Store(cacheKey, std::vector<TextureData const*>({ envCubemap, irradianceMap, radianceMap }));
+
 	m_Data = new EnvironmentMap(envCubemap, irradianceMap, radianceMap);
 
 	return true;
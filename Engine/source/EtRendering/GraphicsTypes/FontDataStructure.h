@@ -0,0 +1,71 @@
+// Data structures for the layout of a cooked font
+
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// FontFileHeader
+//
+// Start of a cooked font, followed by:
+//  - the font name (nameLength chars)
+//  - a FontFileGlyph for every character in SpriteFont's range
+//  - kerningCount FontFileKerning pairs
+//  - the RGBA8 SDF atlas (atlasWidth * atlasHeight * 4 bytes)
+//
+struct FontFileHeader
+{
+	static uint32 const s_Magic = 0x4E465445u; // "ETFN"
+	static uint32 const s_Version = 1u;
+
+	uint32 magic;
+	uint32 version;
+	int16 fontSize;
+	uint8 useKerning;
+	uint8 reserved;
+	uint32 characterCount;
+	uint32 nameLength;
+	uint32 glyphCount;
+	uint32 kerningCount;
+	uint32 atlasWidth;
+	uint32 atlasHeight;
+};
+
+//---------------------------------
+// FontFileGlyph
+//
+// Metrics of a single character, texture coordinates are normalized
+//
+struct FontFileGlyph
+{
+	uint16 character;
+	uint16 width;
+	uint16 height;
+	int16 offsetX;
+	int16 offsetY;
+	uint8 isValid;
+	uint8 channel;
+	float advanceX;
+	float texCoordX;
+	float texCoordY;
+};
+
+//---------------------------------
+// FontFileKerning
+//
+// Offset applied to character when it follows previous, pairs are sorted by character and then by previous
+//
+struct FontFileKerning
+{
+	uint16 character;
+	uint16 previous;
+	float x;
+	float y;
+};
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,52 @@
+#pragma once
+#include <EtCore/Util/GenericEventDispatcher.h>
+
+
+namespace et {
+namespace render {
+
+
+class SpriteFont;
+
+
+//---------------------------
+// E_FontEvent
+//
+// List of events in the lifetime of a font asset
+//
+typedef uint8 T_FontEventFlags;
+enum E_FontEvent : T_FontEventFlags
+{
+	FE_Invalid = 0,
+
+	FE_Unloaded	= 1 << 0,
+
+	FE_All = 0xFF
+};
+
+
+//---------------------------
+// FontEventData
+//
+// Identifies the font asset an event was sent for, the font data is still valid while listeners are notified
+//
+struct FontEventData final
+{
+public:
+	FontEventData(core::HashString const id, SpriteFont const* const f) : assetId(id), font(f) {}
+	virtual ~FontEventData() = default;
+
+	core::HashString const assetId;
+	SpriteFont const* const font = nullptr;
+};
+
+
+typedef core::GenericEventDispatcher<T_FontEventFlags, FontEventData> T_FontEventDispatcher;
+
+
+typedef T_FontEventDispatcher::T_CallbackId T_FontEventCallbackId;
+typedef T_FontEventDispatcher::T_CallbackFn T_FontEventCallback;
+
+
+} // namespace render
+} // namespace et
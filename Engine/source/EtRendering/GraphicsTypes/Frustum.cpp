@@ -52,9 +52,13 @@ void Frustum::SetToCamera(Camera const& camera)
 
 void Frustum::Update(Viewport const* const viewport)
 {
-	//calculate generalized relative width and aspect ratio
+	Update(viewport->GetAspectRatio());
+}
+
+void Frustum::Update(float const aspectRatio)
+{
+	//calculate generalized relative width
 	float normHalfWidth = tan(math::radians(m_FOV));
-	float aspectRatio = viewport->GetAspectRatio();
 
 	//calculate width and height for near and far plane
 	float nearHW = normHalfWidth*m_NearPlane;
@@ -102,19 +106,18 @@ void Frustum::Update(Viewport const* const viewport)
 	m_RadInvFOV = 1 / math::radians(m_FOV);
 
 	//construct planes
-	m_Planes.clear();
 	//winding in an outside perspective so the cross product creates normals pointing inward
-	m_Planes.push_back(math::Plane(m_Corners.na, m_Corners.nb, m_Corners.nc));//Near
-	m_Planes.push_back(math::Plane(m_Corners.fb, m_Corners.fa, m_Corners.fd));//Far 
-	m_Planes.push_back(math::Plane(m_Corners.fa, m_Corners.na, m_Corners.fc));//Left
-	m_Planes.push_back(math::Plane(m_Corners.nb, m_Corners.fb, m_Corners.nd));//Right
-	m_Planes.push_back(math::Plane(m_Corners.fa, m_Corners.fb, m_Corners.na));//Top
-	m_Planes.push_back(math::Plane(m_Corners.nc, m_Corners.nd, m_Corners.fc));//Bottom
+	m_Planes[0] = math::Plane(m_Corners.na, m_Corners.nb, m_Corners.nc);//Near
+	m_Planes[1] = math::Plane(m_Corners.fb, m_Corners.fa, m_Corners.fd);//Far 
+	m_Planes[2] = math::Plane(m_Corners.fa, m_Corners.na, m_Corners.fc);//Left
+	m_Planes[3] = math::Plane(m_Corners.nb, m_Corners.fb, m_Corners.nd);//Right
+	m_Planes[4] = math::Plane(m_Corners.fa, m_Corners.fb, m_Corners.na);//Top
+	m_Planes[5] = math::Plane(m_Corners.nc, m_Corners.nd, m_Corners.fc);//Bottom
 }
 
 VolumeCheck Frustum::ContainsPoint(const vec3 &point) const
 {
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		if (math::dot(plane.n, point - plane.d) < 0)return VolumeCheck::OUTSIDE;
 	}
@@ -123,7 +126,7 @@ VolumeCheck Frustum::ContainsPoint(const vec3 &point) const
 VolumeCheck Frustum::ContainsSphere(math::Sphere const& sphere) const
 {
 	VolumeCheck ret = VolumeCheck::CONTAINS;
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		float dist = math::dot(plane.n, sphere.pos - plane.d);
 		if (dist < -sphere.radius)return VolumeCheck::OUTSIDE;
@@ -137,7 +140,7 @@ VolumeCheck Frustum::ContainsSphere(math::Sphere const& sphere) const
 VolumeCheck Frustum::ContainsTriangle(vec3 &a, vec3 &b, vec3 &c)
 {
 	VolumeCheck ret = VolumeCheck::CONTAINS;
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		char rejects = 0;
 		if (math::dot(plane.n, a - plane.d) < 0)rejects++;
@@ -154,7 +157,7 @@ VolumeCheck Frustum::ContainsTriangle(vec3 &a, vec3 &b, vec3 &c)
 VolumeCheck Frustum::ContainsTriVolume(vec3 &a, vec3 &b, vec3 &c, float height)
 {
 	VolumeCheck ret = VolumeCheck::CONTAINS;
-	for (auto plane : m_Planes)
+	for (math::Plane const& plane : m_Planes)
 	{
 		char rejects = 0;
 		if (math::dot(plane.n, a - plane.d) < 0)rejects++;
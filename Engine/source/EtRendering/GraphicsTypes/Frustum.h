@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+
 
 namespace et {
 namespace render {
@@ -38,6 +40,7 @@ public:
 	~Frustum();
 
 	void Update(Viewport const* const viewport);
+	void Update(float const aspectRatio); // doesn't require a viewport, e.g for headless culling
 
 	void SetToCamera(Camera const& camera);
 	void SetCullTransform(mat4 objectWorld);
@@ -52,13 +55,14 @@ public:
 	float GetRadInvFOV() const { return m_RadInvFOV; }
 
 	FrustumCorners const& GetCorners() const { return m_Corners; }
+	std::array<math::Plane, 6u> const& GetPlanes() const { return m_Planes; }
 
 private:
 	//transform to the culled objects object space and back to world space
 	mat4 m_CullWorld, m_CullInverse;
 
 	//stuff in the culled objects object space
-	std::vector<math::Plane> m_Planes;
+	std::array<math::Plane, 6u> m_Planes; // near, far, left, right, top, bottom
 	FrustumCorners m_Corners;
 	vec3 m_PositionObject;
 
@@ -0,0 +1,334 @@
+#include "stdafx.h"
+#include "FrustumCulling.h"
+
+#include "Frustum.h"
+
+#include <EtCore/Util/JobPool.h>
+
+#if defined(__AVX__)
+#	define ET_CULLING_AVX
+#	include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	define ET_CULLING_SSE
+#	include <xmmintrin.h>
+#endif
+
+
+namespace et {
+namespace render {
+
+
+//===============
+// Sphere Bounds
+//===============
+
+
+//---------------------------------
+// SphereBounds::TransformSphere
+//
+// Object space bounds to world space, the radius is scaled conservatively so non uniform scale stays inside the sphere
+//
+math::Sphere SphereBounds::TransformSphere(math::Sphere const& sphere, mat4 const& transform)
+{
+	return math::Sphere((transform * vec4(sphere.pos, 1.f)).xyz, math::length(math::decomposeScale(transform)) * sphere.radius);
+}
+
+//---------------------------------
+// SphereBounds::Add
+//
+void SphereBounds::Add(math::Sphere const& sphere)
+{
+	m_X.push_back(sphere.pos.x);
+	m_Y.push_back(sphere.pos.y);
+	m_Z.push_back(sphere.pos.z);
+	m_Radius.push_back(sphere.radius);
+}
+
+//---------------------------------
+// SphereBounds::Set
+//
+void SphereBounds::Set(size_t const idx, math::Sphere const& sphere)
+{
+	ET_ASSERT(idx < Size());
+
+	m_X[idx] = sphere.pos.x;
+	m_Y[idx] = sphere.pos.y;
+	m_Z[idx] = sphere.pos.z;
+	m_Radius[idx] = sphere.radius;
+}
+
+//---------------------------------
+// SphereBounds::RemoveSwap
+//
+void SphereBounds::RemoveSwap(size_t const idx)
+{
+	ET_ASSERT(idx < Size());
+
+	size_t const last = Size() - 1u;
+	if (idx != last)
+	{
+		Set(idx, Get(last));
+	}
+
+	m_X.pop_back();
+	m_Y.pop_back();
+	m_Z.pop_back();
+	m_Radius.pop_back();
+}
+
+//---------------------------------
+// SphereBounds::Clear
+//
+void SphereBounds::Clear()
+{
+	m_X.clear();
+	m_Y.clear();
+	m_Z.clear();
+	m_Radius.clear();
+}
+
+//---------------------------------
+// SphereBounds::Get
+//
+math::Sphere SphereBounds::Get(size_t const idx) const
+{
+	ET_ASSERT(idx < Size());
+
+	return math::Sphere(vec3(m_X[idx], m_Y[idx], m_Z[idx]), m_Radius[idx]);
+}
+
+
+//================
+// Frustum Culler
+//================
+
+
+// static
+size_t const FrustumCuller::s_BatchSize = 8u;
+size_t const FrustumCuller::s_ParallelThreshold = 32768u;
+size_t const FrustumCuller::s_MinChunkSize = 16384u;
+
+
+//---------------------------------
+// FrustumCuller::SetFrustum
+//
+// Planes are stored as a point and a normal, precompute the distance from the origin so a test is a single dot product
+//
+void FrustumCuller::SetFrustum(Frustum const& frustum)
+{
+	std::array<math::Plane, 6u> const& planes = frustum.GetPlanes();
+	for (size_t planeIdx = 0u; planeIdx < planes.size(); ++planeIdx)
+	{
+		math::Plane const& plane = planes[planeIdx];
+
+		m_NormalX[planeIdx] = plane.n.x;
+		m_NormalY[planeIdx] = plane.n.y;
+		m_NormalZ[planeIdx] = plane.n.z;
+		m_W[planeIdx] = math::dot(plane.n, plane.d);
+	}
+}
+
+//---------------------------------
+// FrustumCuller::SetViewProjection
+//
+// Extract the clip planes from a matrix mapping world space to OpenGL clip space (-w <= x, y, z <= w)
+//  - each plane is the last row of the matrix plus or minus one of the other rows
+//
+void FrustumCuller::SetViewProjection(mat4 const& viewProj)
+{
+	vec4 const row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+	vec4 const row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+	vec4 const row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+	vec4 const row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+	std::array<vec4, 6u> const planes = { row3 + row2, row3 - row2, row3 + row0, row3 - row0, row3 - row1, row3 + row1 };
+	for (size_t planeIdx = 0u; planeIdx < planes.size(); ++planeIdx)
+	{
+		vec4 const& plane = planes[planeIdx];
+		float const invLength = 1.f / std::max(math::length(plane.xyz), static_cast<float>(ETM_DEFAULT_EPSILON));
+
+		m_NormalX[planeIdx] = plane.x * invLength;
+		m_NormalY[planeIdx] = plane.y * invLength;
+		m_NormalZ[planeIdx] = plane.z * invLength;
+		m_W[planeIdx] = -plane.w * invLength;
+	}
+}
+
+//---------------------------------
+// FrustumCuller::Cull
+//
+// Replaces the contents of visible with the indices of all spheres that are at least partially inside the frustum, in ascending order
+//
+void FrustumCuller::Cull(SphereBounds const& bounds, std::vector<uint32>& visible) const
+{
+	ET_PROFILE_ZONE("FrustumCuller::Cull");
+
+	size_t const count = bounds.Size();
+	visible.resize(count);
+
+	if (count < s_ParallelThreshold)
+	{
+		visible.resize(CullRange(bounds, 0u, count, visible.data()));
+		return;
+	}
+
+	// chunks are aligned to batches so only the last chunk has a scalar tail
+	core::JobPool* const jobPool = core::JobPool::GetInstance();
+
+	size_t const threadCount = jobPool->GetThreadCount();
+	size_t chunkSize = std::max((count + threadCount - 1u) / threadCount, s_MinChunkSize);
+	chunkSize = ((chunkSize + s_BatchSize - 1u) / s_BatchSize) * s_BatchSize;
+
+	// each chunk writes its results to the start of its own range in the output
+	std::vector<size_t> chunkVisible((count + chunkSize - 1u) / chunkSize);
+	jobPool->Run(0u, count, chunkSize, [this, &bounds, &visible, &chunkVisible](size_t const chunkIdx, size_t const begin, size_t const end)
+		{
+			chunkVisible[chunkIdx] = CullRange(bounds, begin, end, visible.data() + begin);
+		});
+
+	// compact - the write position never overtakes the chunk being read
+	size_t visibleCount = 0u;
+	for (size_t chunkIdx = 0u; chunkIdx < chunkVisible.size(); ++chunkIdx)
+	{
+		size_t const chunkBegin = chunkIdx * chunkSize;
+		if (visibleCount != chunkBegin)
+		{
+			std::copy(visible.begin() + chunkBegin, visible.begin() + chunkBegin + chunkVisible[chunkIdx], visible.begin() + visibleCount);
+		}
+
+		visibleCount += chunkVisible[chunkIdx];
+	}
+
+	visible.resize(visibleCount);
+}
+
+//---------------------------------
+// FrustumCuller::CullRange
+//
+// Cull spheres [begin, end) and write visible indices to the output, which needs space for (end - begin) entries
+//  - indices are written unconditionally and the write position only advances for visible spheres, so there are no branches on the result
+//
+size_t FrustumCuller::CullRange(SphereBounds const& bounds, size_t const begin, size_t const end, uint32* const visible) const
+{
+	ET_ASSERT(end <= bounds.Size());
+
+	float const* const xs = bounds.m_X.data();
+	float const* const ys = bounds.m_Y.data();
+	float const* const zs = bounds.m_Z.data();
+	float const* const radii = bounds.m_Radius.data();
+
+	size_t count = 0u;
+	size_t idx = begin;
+
+#if defined(ET_CULLING_AVX)
+
+	__m256 nx[6], ny[6], nz[6], w[6];
+	for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+	{
+		nx[planeIdx] = _mm256_set1_ps(m_NormalX[planeIdx]);
+		ny[planeIdx] = _mm256_set1_ps(m_NormalY[planeIdx]);
+		nz[planeIdx] = _mm256_set1_ps(m_NormalZ[planeIdx]);
+		w[planeIdx] = _mm256_set1_ps(m_W[planeIdx]);
+	}
+
+	__m256 const zero = _mm256_setzero_ps();
+
+	for (; idx + s_BatchSize <= end; idx += s_BatchSize)
+	{
+		__m256 const x = _mm256_loadu_ps(xs + idx);
+		__m256 const y = _mm256_loadu_ps(ys + idx);
+		__m256 const z = _mm256_loadu_ps(zs + idx);
+		__m256 const r = _mm256_loadu_ps(radii + idx);
+
+		__m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+		for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+		{
+			__m256 dist = _mm256_mul_ps(nx[planeIdx], x);
+			dist = _mm256_add_ps(dist, _mm256_mul_ps(ny[planeIdx], y));
+			dist = _mm256_add_ps(dist, _mm256_mul_ps(nz[planeIdx], z));
+			dist = _mm256_add_ps(_mm256_sub_ps(dist, w[planeIdx]), r);
+
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, zero, _CMP_GE_OQ));
+		}
+
+		uint32 const mask = static_cast<uint32>(_mm256_movemask_ps(inside));
+		for (uint32 lane = 0u; lane < s_BatchSize; ++lane)
+		{
+			visible[count] = static_cast<uint32>(idx + lane);
+			count += (mask >> lane) & 1u;
+		}
+	}
+
+#elif defined(ET_CULLING_SSE)
+
+	__m128 nx[6], ny[6], nz[6], w[6];
+	for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+	{
+		nx[planeIdx] = _mm_set1_ps(m_NormalX[planeIdx]);
+		ny[planeIdx] = _mm_set1_ps(m_NormalY[planeIdx]);
+		nz[planeIdx] = _mm_set1_ps(m_NormalZ[planeIdx]);
+		w[planeIdx] = _mm_set1_ps(m_W[planeIdx]);
+	}
+
+	__m128 const zero = _mm_setzero_ps();
+
+	// two registers per batch to keep the same batch size as the AVX path
+	for (; idx + s_BatchSize <= end; idx += s_BatchSize)
+	{
+		__m128 const x0 = _mm_loadu_ps(xs + idx);
+		__m128 const y0 = _mm_loadu_ps(ys + idx);
+		__m128 const z0 = _mm_loadu_ps(zs + idx);
+		__m128 const r0 = _mm_loadu_ps(radii + idx);
+
+		__m128 const x1 = _mm_loadu_ps(xs + idx + 4u);
+		__m128 const y1 = _mm_loadu_ps(ys + idx + 4u);
+		__m128 const z1 = _mm_loadu_ps(zs + idx + 4u);
+		__m128 const r1 = _mm_loadu_ps(radii + idx + 4u);
+
+		__m128 inside0 = _mm_cmpeq_ps(zero, zero);
+		__m128 inside1 = inside0;
+		for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+		{
+			__m128 dist0 = _mm_mul_ps(nx[planeIdx], x0);
+			__m128 dist1 = _mm_mul_ps(nx[planeIdx], x1);
+			dist0 = _mm_add_ps(dist0, _mm_mul_ps(ny[planeIdx], y0));
+			dist1 = _mm_add_ps(dist1, _mm_mul_ps(ny[planeIdx], y1));
+			dist0 = _mm_add_ps(dist0, _mm_mul_ps(nz[planeIdx], z0));
+			dist1 = _mm_add_ps(dist1, _mm_mul_ps(nz[planeIdx], z1));
+			dist0 = _mm_add_ps(_mm_sub_ps(dist0, w[planeIdx]), r0);
+			dist1 = _mm_add_ps(_mm_sub_ps(dist1, w[planeIdx]), r1);
+
+			inside0 = _mm_and_ps(inside0, _mm_cmpge_ps(dist0, zero));
+			inside1 = _mm_and_ps(inside1, _mm_cmpge_ps(dist1, zero));
+		}
+
+		uint32 const mask = static_cast<uint32>(_mm_movemask_ps(inside0)) | (static_cast<uint32>(_mm_movemask_ps(inside1)) << 4u);
+		for (uint32 lane = 0u; lane < s_BatchSize; ++lane)
+		{
+			visible[count] = static_cast<uint32>(idx + lane);
+			count += (mask >> lane) & 1u;
+		}
+	}
+
+#endif
+
+	// scalar path for the remainder, or everything if no SIMD instructions are available
+	for (; idx < end; ++idx)
+	{
+		bool inside = true;
+		for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+		{
+			float const dist = m_NormalX[planeIdx] * xs[idx] + m_NormalY[planeIdx] * ys[idx] + m_NormalZ[planeIdx] * zs[idx] - m_W[planeIdx];
+			inside = inside && (dist + radii[idx] >= 0.f);
+		}
+
+		visible[count] = static_cast<uint32>(idx);
+		count += inside ? 1u : 0u;
+	}
+
+	return count;
+}
+
+
+} // namespace render
+} // namespace et
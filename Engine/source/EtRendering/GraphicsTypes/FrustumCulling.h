@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+
+#include <EtMath/Geometry.h>
+
+
+namespace et {
+namespace render {
+
+
+class Frustum;
+
+
+//---------------------------------
+// SphereBounds
+//
+// World space bounding spheres stored as a structure of arrays so they can be tested in batches
+//
+struct SphereBounds final
+{
+	// static functionality
+	//----------------------
+	static math::Sphere TransformSphere(math::Sphere const& sphere, mat4 const& transform);
+
+	// functionality
+	//---------------
+	void Add(math::Sphere const& sphere);
+	void Set(size_t const idx, math::Sphere const& sphere);
+	void RemoveSwap(size_t const idx); // moves the last sphere into the removed slot, same as the instance lists
+	void Clear();
+
+	// accessors
+	//-----------
+	size_t Size() const { return m_Radius.size(); }
+	math::Sphere Get(size_t const idx) const;
+
+	// Data
+	///////
+
+	std::vector<float> m_X;
+	std::vector<float> m_Y;
+	std::vector<float> m_Z;
+	std::vector<float> m_Radius;
+};
+
+
+//---------------------------------
+// FrustumCuller
+//
+// Tests sphere bounds against the 6 frustum planes, 8 spheres at a time, and writes the indices of visible spheres
+//  - uses AVX if the build targets it, SSE on other x86 builds and a scalar loop otherwise
+//  - large inputs are split into chunks that are culled on the threads of the job pool
+//  - only rejects fully outside spheres, equivalent to Frustum::ContainsSphere() != OUTSIDE
+//  - planes can also be taken from a view projection matrix, e.g. for orthographic light projections
+//
+class FrustumCuller final
+{
+	// definitions
+	//-------------
+public:
+	static size_t const s_BatchSize;
+	static size_t const s_ParallelThreshold;
+	static size_t const s_MinChunkSize;
+
+	// construct destruct
+	//--------------------
+	FrustumCuller() = default;
+	FrustumCuller(Frustum const& frustum) { SetFrustum(frustum); }
+
+	// functionality
+	//---------------
+	void SetFrustum(Frustum const& frustum);
+	void SetViewProjection(mat4 const& viewProj);
+
+	void Cull(SphereBounds const& bounds, std::vector<uint32>& visible) const;
+	size_t CullRange(SphereBounds const& bounds, size_t const begin, size_t const end, uint32* const visible) const;
+
+	// Data
+	///////
+private:
+	// planes in SoA layout, dist = n.x * x + n.y * y + n.z * z - w
+	std::array<float, 6u> m_NormalX;
+	std::array<float, 6u> m_NormalY;
+	std::array<float, 6u> m_NormalZ;
+	std::array<float, 6u> m_W;
+};
+
+
+} // namespace render
+} // namespace et
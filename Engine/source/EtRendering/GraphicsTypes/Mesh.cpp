@@ -13,6 +13,8 @@
 #include <EtRendering/SceneStructure/GLTF.h>
 #include <EtRendering/MaterialSystem/MaterialData.h>
 
+#include "MeshDataStructure.h"
+
 
 namespace et {
 namespace render {
@@ -166,6 +168,181 @@ bool MeshDataContainer::ConstructTangentSpace(std::vector<vec4>& tangentInfo)
 }
 
 
+//-------------------------------------------
+// MeshDataContainer::GetSupportedFlags
+//
+// Derive vertex flags from which attributes cover all vertices
+//  - binormals only contribute the bitangent sign of the tangent attribute
+//
+T_VertexFlags MeshDataContainer::GetSupportedFlags() const
+{
+	T_VertexFlags flags = 0u;
+
+	if (m_Positions.size() == m_VertexCount)
+	{
+		flags |= E_VertexFlag::POSITION;
+	}
+	if (m_Normals.size() == m_VertexCount)
+	{
+		flags |= E_VertexFlag::NORMAL;
+	}
+	if (m_Tangents.size() == m_VertexCount)
+	{
+		flags |= E_VertexFlag::TANGENT;
+	}
+	if (m_Colors.size() == m_VertexCount)
+	{
+		flags |= E_VertexFlag::COLOR;
+	}
+	if (m_TexCoords.size() == m_VertexCount)
+	{
+		flags |= E_VertexFlag::TEXCOORD;
+	}
+
+	return flags;
+}
+
+//-------------------------------------------
+// MeshDataContainer::GetBoundingSphere
+//
+// Sphere around the average position, enclosing all vertices
+//
+math::Sphere MeshDataContainer::GetBoundingSphere() const
+{
+	// get center
+	vec3 center = vec3(0);
+	for (size_t i = 0u; i < m_Positions.size(); i++)
+	{
+		center = center + m_Positions[i];
+	}
+
+	float rcp = 1.f / static_cast<float>(m_Positions.size());
+	center = center * rcp;
+
+	// greatest distance from center
+	float maxRadius = 0.f;
+	for (size_t i = 0u; i < m_Positions.size(); i++)
+	{
+		float dist = math::distanceSquared(center, m_Positions[i]);
+		if (dist > maxRadius)maxRadius = dist;
+	}
+
+	return math::Sphere(center, sqrtf(maxRadius));
+}
+
+//-------------------------------------------
+// MeshDataContainer::WriteInterleaved
+//
+// Quantize the attributes in flags and interleave them into a single vertex stream, in the order and formats AttributeDescriptor expects
+//  - without binormals the bitangent sign is positive
+//
+void MeshDataContainer::WriteInterleaved(T_VertexFlags const flags, std::vector<uint8>& vertices) const
+{
+	bool const hasBiNormals = (m_BiNormals.size() == m_VertexCount) && (m_Normals.size() == m_VertexCount);
+
+	uint16 const vertexSize = AttributeDescriptor::GetVertexSize(flags);
+	vertices.resize(m_VertexCount * static_cast<size_t>(vertexSize));
+	uint8* const interleaved = vertices.data();
+
+	auto writeSnorm2 = [interleaved](size_t& offset, vec2 const& value)
+		{
+			int16 const packed[2] = { vertex_packing::PackSnorm16(value.x), vertex_packing::PackSnorm16(value.y) };
+			memcpy(interleaved + offset, packed, sizeof(packed));
+			offset += sizeof(packed);
+		};
+
+	for (size_t vertIdx = 0u; vertIdx < m_VertexCount; vertIdx++)
+	{
+		size_t offset = vertIdx * vertexSize;
+
+		if (flags & E_VertexFlag::POSITION)
+		{
+			memcpy(interleaved + offset, &(m_Positions[vertIdx]), sizeof(vec3));
+			offset += sizeof(vec3);
+		}
+
+		if (flags & E_VertexFlag::NORMAL)
+		{
+			writeSnorm2(offset, vertex_packing::EncodeOctahedral(math::normalize(m_Normals[vertIdx])));
+		}
+
+		if (flags & E_VertexFlag::TANGENT)
+		{
+			float bitangentSign = 1.f;
+			if (hasBiNormals && (math::dot(math::cross(m_Normals[vertIdx], m_Tangents[vertIdx]), m_BiNormals[vertIdx]) < 0.f))
+			{
+				bitangentSign = -1.f;
+			}
+
+			writeSnorm2(offset, vertex_packing::EncodeTangent(math::normalize(m_Tangents[vertIdx]), bitangentSign));
+		}
+
+		if (flags & E_VertexFlag::COLOR)
+		{
+			vec4 const& color = m_Colors[vertIdx];
+			uint8 const packed[4] = { 
+				vertex_packing::PackUnorm8(color.r), 
+				vertex_packing::PackUnorm8(color.g), 
+				vertex_packing::PackUnorm8(color.b), 
+				vertex_packing::PackUnorm8(color.a) 
+			};
+
+			memcpy(interleaved + offset, packed, sizeof(packed));
+			offset += sizeof(packed);
+		}
+
+		if (flags & E_VertexFlag::TEXCOORD)
+		{
+			vec2 const& texCoord = m_TexCoords[vertIdx];
+			uint16 const packed[2] = { vertex_packing::PackHalf(texCoord.x), vertex_packing::PackHalf(texCoord.y) };
+			memcpy(interleaved + offset, packed, sizeof(packed));
+			offset += sizeof(packed);
+		}
+	}
+}
+
+//-------------------------------------------
+// MeshDataContainer::WriteIndices
+//
+// Write the index buffer with 16 bits per index if all vertices can be addressed that way, returns the index type used
+//
+E_DataType MeshDataContainer::WriteIndices(std::vector<uint8>& indices) const
+{
+	if (m_VertexCount <= static_cast<size_t>(std::numeric_limits<uint16>::max()) + 1u)
+	{
+		indices.resize(m_Indices.size() * sizeof(uint16));
+		uint16* const shortIndices = reinterpret_cast<uint16*>(indices.data());
+		for (size_t i = 0u; i < m_Indices.size(); ++i)
+		{
+			shortIndices[i] = static_cast<uint16>(m_Indices[i]);
+		}
+
+		return E_DataType::UShort;
+	}
+
+	indices.resize(m_Indices.size() * sizeof(uint32));
+	memcpy(indices.data(), m_Indices.data(), indices.size());
+	return E_DataType::UInt;
+}
+
+//-------------------------------------------
+// MeshDataContainer::GetLods
+//
+// Levels of detail in the index list, or a single level with all indices if none were generated
+//
+std::vector<MeshLod> MeshDataContainer::GetLods() const
+{
+	if (!m_Lods.empty())
+	{
+		return m_Lods;
+	}
+
+	MeshLod lod;
+	lod.m_IndexCount = static_cast<uint32>(m_Indices.size());
+	return std::vector<MeshLod>({ lod });
+}
+
+
 //==============
 // Mesh Surface
 //==============
@@ -269,131 +446,49 @@ MeshData::MeshData(MeshDataContainer const* const cpuData)
 	m_Name = cpuData->m_Name;
 
 	m_IndexCount = cpuData->m_Indices.size();
+	m_Lods = cpuData->GetLods();
 	m_VertexCount = cpuData->m_VertexCount;
 	ET_ASSERT(m_VertexCount > 0u, "Expected mesh to have vertices!");
 
-	// Surface container will contain vertex arrays per material
-	m_Surfaces = new SurfaceContainer();
-
-	// derive flags from data sizes
-	//------------------------------
-	if (cpuData->m_Positions.size() == m_VertexCount)
-	{
-		m_SupportedFlags |= E_VertexFlag::POSITION;
-	}
-	if (cpuData->m_Normals.size() == m_VertexCount)
-	{
-		m_SupportedFlags |= E_VertexFlag::NORMAL;
-	}
-	if (cpuData->m_BiNormals.size() == m_VertexCount)
-	{
-		m_SupportedFlags |= E_VertexFlag::BINORMAL;
-	}
-	if (cpuData->m_Tangents.size() == m_VertexCount)
-	{
-		m_SupportedFlags |= E_VertexFlag::TANGENT;
-	}
-	if (cpuData->m_Colors.size() == m_VertexCount)
-	{
-		m_SupportedFlags |= E_VertexFlag::COLOR;
-	}
-	if (cpuData->m_TexCoords.size() == m_VertexCount)
-	{
-		m_SupportedFlags |= E_VertexFlag::TEXCOORD;
-	}
-
-	// calculate bounding sphere
-	//---------------------------
+	m_SupportedFlags = cpuData->GetSupportedFlags();
+	m_BoundingSphere = cpuData->GetBoundingSphere();
 
-	// get center
-	vec3 center = vec3(0);
-	for (size_t i = 0u; i < cpuData->m_Positions.size(); i++)
-	{
-		center = center + cpuData->m_Positions[i];
-	}
+	std::vector<uint8> vertices;
+	cpuData->WriteInterleaved(m_SupportedFlags, vertices);
 
-	float rcp = 1.f / static_cast<float>(cpuData->m_Positions.size());
-	center = center * rcp;
+	std::vector<uint8> indices;
+	m_IndexDataType = cpuData->WriteIndices(indices);
 
-	// greatest distance from center
-	float maxRadius = 0.f;
-	for (size_t i = 0u; i < cpuData->m_Positions.size(); i++)
-	{
-		float dist = math::distanceSquared(center, cpuData->m_Positions[i]);
-		if (dist > maxRadius)maxRadius = dist;
-	}
-
-	m_BoundingSphere = math::Sphere(center, sqrtf(maxRadius));
-
-	// create interleaved buffer data
-	//--------------------------------
-
-	// create memory buffer
-	uint16 const vertexSize = AttributeDescriptor::GetVertexSize(m_SupportedFlags);
-	size_t const bufferSize = m_VertexCount * static_cast<size_t>(vertexSize);
-	uint8* interleaved = new uint8[bufferSize];
-
-	// fill interleaved buffer with vertex data
-	for (size_t vertIdx = 0u; vertIdx < m_VertexCount; vertIdx++)
-	{
-		size_t offset = vertIdx * vertexSize;
-
-		if (m_SupportedFlags & E_VertexFlag::POSITION)
-		{
-			memcpy(interleaved + offset, &(cpuData->m_Positions[vertIdx]), sizeof(vec3));
-			offset += sizeof(vec3);
-		}
-
-		if (m_SupportedFlags & E_VertexFlag::NORMAL)
-		{
-			memcpy(interleaved + offset, &(cpuData->m_Normals[vertIdx]), sizeof(vec3));
-			offset += sizeof(vec3);
-		}
-
-		if (m_SupportedFlags & E_VertexFlag::BINORMAL)
-		{
-			memcpy(interleaved + offset, &(cpuData->m_BiNormals[vertIdx]), sizeof(vec3));
-			offset += sizeof(vec3);
-		}
-
-		if (m_SupportedFlags & E_VertexFlag::TANGENT)
-		{
-			memcpy(interleaved + offset, &(cpuData->m_Tangents[vertIdx]), sizeof(vec3));
-			offset += sizeof(vec3);
-		}
-
-		if (m_SupportedFlags & E_VertexFlag::COLOR)
-		{
-			memcpy(interleaved + offset, &(cpuData->m_Colors[vertIdx].xyz), sizeof(vec3));
-			offset += sizeof(vec3);
-		}
-
-		if (m_SupportedFlags & E_VertexFlag::TEXCOORD)
-		{
-			memcpy(interleaved + offset, &(cpuData->m_TexCoords[vertIdx]), sizeof(vec2));
-			offset += sizeof(vec2);
-		}
-	}
-
-	// copy data to GPU
-	//------------------
-
-	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
-
-	// vertex buffer
-	m_VertexBuffer = api->CreateBuffer();
-	api->BindBuffer(E_BufferType::Vertex, m_VertexBuffer);
-	api->SetBufferData(E_BufferType::Vertex, bufferSize, interleaved, E_UsageHint::Static);
+	CreateBuffers(vertices.data(), indices.data());
+}
 
-	// index buffer - #todo: might be okay to store index buffer with 16bits per index
-	m_IndexBuffer = api->CreateBuffer();
-	api->BindBuffer(E_BufferType::Index, m_IndexBuffer);
-	api->SetBufferData(E_BufferType::Index, sizeof(uint32) * cpuData->m_Indices.size(), cpuData->m_Indices.data(), E_UsageHint::Static);
+//---------------------------------
+// MeshData::c-tor
+//
+// Construct Mesh data from vertex data that is already interleaved, as stored in cooked meshes
+//
+MeshData::MeshData(std::string const& name,
+	T_VertexFlags const flags,
+	math::Sphere const& boundingSphere,
+	size_t const vertexCount,
+	uint8 const* const vertices,
+	size_t const indexCount,
+	E_DataType const indexType,
+	uint8 const* const indices,
+	std::vector<MeshLod> const& lods)
+	: m_Name(name)
+	, m_SupportedFlags(flags)
+	, m_IndexDataType(indexType)
+	, m_BoundingSphere(boundingSphere)
+	, m_VertexCount(vertexCount)
+	, m_IndexCount(indexCount)
+	, m_Lods(lods)
+{
+	ET_ASSERT(m_VertexCount > 0u, "Expected mesh to have vertices!");
+	ET_ASSERT((m_IndexDataType == E_DataType::UShort) || (m_IndexDataType == E_DataType::UInt));
+	ET_ASSERT(!m_Lods.empty() && (m_Lods[0].m_FirstIndex == 0u), "Expected the full detail level to start at the first index!");
 
-	// free CPU side data
-	//--------------------
-	delete[] interleaved;
-	interleaved = nullptr;
+	CreateBuffers(vertices, indices);
 }
 
 //---------------------------------
@@ -421,6 +516,33 @@ MeshSurface const* MeshData::GetSurface(render::Material const* const material)
 	return m_Surfaces->GetSurface(this, material);
 }
 
+//---------------------------------
+// MeshData::CreateBuffers
+//
+// Upload interleaved vertices and indices matching the mesh's flags and index type to the GPU
+//
+void MeshData::CreateBuffers(uint8 const* const vertices, uint8 const* const indices)
+{
+	// Surface container will contain vertex arrays per material
+	m_Surfaces = new SurfaceContainer();
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	// vertex buffer
+	size_t const vertexBufferSize = m_VertexCount * static_cast<size_t>(AttributeDescriptor::GetVertexSize(m_SupportedFlags));
+
+	m_VertexBuffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Vertex, m_VertexBuffer);
+	api->SetBufferData(E_BufferType::Vertex, vertexBufferSize, vertices, E_UsageHint::Static);
+
+	// index buffer
+	size_t const indexBufferSize = m_IndexCount * static_cast<size_t>(DataTypeInfo::GetTypeSize(m_IndexDataType));
+
+	m_IndexBuffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Index, m_IndexBuffer);
+	api->SetBufferData(E_BufferType::Index, indexBufferSize, indices, E_UsageHint::Static);
+}
+
 
 //===================
 // Mesh Asset
@@ -431,6 +553,7 @@ MeshSurface const* MeshData::GetSurface(render::Material const* const material)
 RTTR_REGISTRATION
 {
 	BEGIN_REGISTER_POLYMORPHIC_CLASS(MeshAsset, "mesh asset")
+		.property("lod ratios", &MeshAsset::m_LodRatios)
 	END_REGISTER_POLYMORPHIC_CLASS(MeshAsset, core::I_Asset);
 }
 DEFINE_FORCED_LINKING(MeshAsset) // force the shader class to be linked as it is only used in reflection
@@ -443,6 +566,18 @@ DEFINE_FORCED_LINKING(MeshAsset) // force the shader class to be linked as it is
 //
 bool MeshAsset::LoadFromMemory(std::vector<uint8> const& data)
 {
+	if (IsCookedMesh(data))
+	{
+		m_Data = LoadCooked(data);
+		if (m_Data == nullptr)
+		{
+			LOG("MeshAsset::LoadFromMemory > Failed to load cooked mesh asset!", core::LogLevel::Warning);
+			return false;
+		}
+
+		return true;
+	}
+
 	std::string const extension = core::FileUtil::ExtractExtension(GetName());
 	MeshDataContainer* meshContainer = nullptr;
 
@@ -464,6 +599,167 @@ bool MeshAsset::LoadFromMemory(std::vector<uint8> const& data)
 	return true;
 }
 
+//---------------------------------
+// MeshAsset::IsCookedMesh
+//
+bool MeshAsset::IsCookedMesh(std::vector<uint8> const& data)
+{
+	if (data.size() < sizeof(MeshFileHeader))
+	{
+		return false;
+	}
+
+	uint32 magic;
+	memcpy(&magic, data.data(), sizeof(uint32));
+	return (magic == MeshFileHeader::s_Magic);
+}
+
+//---------------------------------
+// MeshAsset::WriteCookedMesh
+//
+// Serialize a mesh into the layout described in MeshDataStructure.h, using the same vertex layout and index type as MeshData
+//
+void MeshAsset::WriteCookedMesh(MeshDataContainer const& cpuData, std::vector<uint8>& data)
+{
+	T_VertexFlags const flags = cpuData.GetSupportedFlags();
+	math::Sphere const boundingSphere = cpuData.GetBoundingSphere();
+
+	std::vector<uint8> vertices;
+	cpuData.WriteInterleaved(flags, vertices);
+
+	std::vector<uint8> indices;
+	E_DataType const indexType = cpuData.WriteIndices(indices);
+
+	std::vector<MeshLod> const lods = cpuData.GetLods();
+
+	MeshFileHeader header;
+	header.magic = MeshFileHeader::s_Magic;
+	header.version = MeshFileHeader::s_Version;
+	header.vertexFlags = flags;
+	header.indexType = static_cast<uint8>(indexType);
+	header.lodCount = static_cast<uint16>(lods.size());
+	header.nameLength = static_cast<uint32>(cpuData.m_Name.size());
+	header.vertexCount = static_cast<uint64>(cpuData.m_VertexCount);
+	header.indexCount = static_cast<uint64>(cpuData.m_Indices.size());
+	header.boundingCenterX = boundingSphere.pos.x;
+	header.boundingCenterY = boundingSphere.pos.y;
+	header.boundingCenterZ = boundingSphere.pos.z;
+	header.boundingRadius = boundingSphere.radius;
+
+	data.resize(sizeof(MeshFileHeader) + header.nameLength + header.lodCount * sizeof(MeshFileLod) + vertices.size() + indices.size());
+	uint8* raw = data.data();
+
+	memcpy(raw, &header, sizeof(MeshFileHeader));
+	raw += sizeof(MeshFileHeader);
+
+	memcpy(raw, cpuData.m_Name.data(), header.nameLength);
+	raw += header.nameLength;
+
+	for (MeshLod const& lod : lods)
+	{
+		MeshFileLod const fileLod{ lod.m_FirstIndex, lod.m_IndexCount, lod.m_Error };
+		memcpy(raw, &fileLod, sizeof(MeshFileLod));
+		raw += sizeof(MeshFileLod);
+	}
+
+	memcpy(raw, vertices.data(), vertices.size());
+	raw += vertices.size();
+
+	memcpy(raw, indices.data(), indices.size());
+}
+
+//---------------------------------
+// MeshAsset::LoadCooked
+//
+// Loads a mesh written by the cooker - vertex and index data are uploaded straight from the asset content
+//
+MeshData* MeshAsset::LoadCooked(std::vector<uint8> const& data)
+{
+	MeshFileHeader header;
+	memcpy(&header, data.data(), sizeof(MeshFileHeader));
+
+	if (header.version != MeshFileHeader::s_Version)
+	{
+		LOG(FS("MeshAsset::LoadCooked > Unsupported cooked mesh version %u, expected %u", header.version, MeshFileHeader::s_Version), 
+			core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	E_DataType const indexType = static_cast<E_DataType>(header.indexType);
+	if (!((indexType == E_DataType::UShort) || (indexType == E_DataType::UInt)))
+	{
+		LOG("MeshAsset::LoadCooked > Invalid index type", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	if (header.vertexCount == 0u)
+	{
+		LOG("MeshAsset::LoadCooked > Cooked mesh has no vertices", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	if (header.lodCount == 0u)
+	{
+		LOG("MeshAsset::LoadCooked > Cooked mesh has no levels of detail", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	size_t const vertexSize = static_cast<size_t>(header.vertexCount) * static_cast<size_t>(AttributeDescriptor::GetVertexSize(header.vertexFlags));
+	size_t const indexSize = static_cast<size_t>(header.indexCount) * static_cast<size_t>(DataTypeInfo::GetTypeSize(indexType));
+	size_t const lodSize = static_cast<size_t>(header.lodCount) * sizeof(MeshFileLod);
+	if (data.size() < sizeof(MeshFileHeader) + header.nameLength + lodSize + vertexSize + indexSize)
+	{
+		LOG("MeshAsset::LoadCooked > Cooked mesh data is truncated", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	uint8 const* raw = data.data() + sizeof(MeshFileHeader);
+
+	std::string name(reinterpret_cast<char const*>(raw), header.nameLength);
+	raw += header.nameLength;
+	if (name.empty())
+	{
+		name = GetName();
+	}
+
+	std::vector<MeshLod> lods(static_cast<size_t>(header.lodCount));
+	for (MeshLod& lod : lods)
+	{
+		MeshFileLod fileLod;
+		memcpy(&fileLod, raw, sizeof(MeshFileLod));
+		raw += sizeof(MeshFileLod);
+
+		if (static_cast<uint64>(fileLod.firstIndex) + static_cast<uint64>(fileLod.indexCount) > header.indexCount)
+		{
+			LOG("MeshAsset::LoadCooked > Level of detail exceeds the index buffer", core::LogLevel::Warning);
+			return nullptr;
+		}
+
+		lod.m_FirstIndex = fileLod.firstIndex;
+		lod.m_IndexCount = fileLod.indexCount;
+		lod.m_Error = fileLod.error;
+	}
+
+	if (lods[0].m_FirstIndex != 0u)
+	{
+		LOG("MeshAsset::LoadCooked > Full detail level doesn't start at the first index", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	uint8 const* const vertices = raw;
+	raw += vertexSize;
+
+	return new MeshData(name,
+		header.vertexFlags,
+		math::Sphere(vec3(header.boundingCenterX, header.boundingCenterY, header.boundingCenterZ), header.boundingRadius),
+		static_cast<size_t>(header.vertexCount),
+		vertices,
+		static_cast<size_t>(header.indexCount),
+		indexType,
+		raw,
+		lods);
+}
+
 //---------------------------------
 // MeshAsset::LoadAssimp
 //
@@ -1,5 +1,6 @@
 #pragma once
 #include "VertexInfo.h"
+#include "MeshLod.h"
 
 #include <EtCore/Content/Asset.h>
 #include <EtCore/Util/LinkerUtils.h>
@@ -18,11 +19,18 @@ class Material;
 // MeshDataContainer
 //
 // CPU side vertex and index data
+//  - indices can contain several levels of detail back to back, if no LODs are listed all indices form a single level
 //
 struct MeshDataContainer final
 {
 	bool ConstructTangentSpace(std::vector<vec4>& tangentInfo);
 
+	T_VertexFlags GetSupportedFlags() const;
+	math::Sphere GetBoundingSphere() const;
+	void WriteInterleaved(T_VertexFlags const flags, std::vector<uint8>& vertices) const;
+	E_DataType WriteIndices(std::vector<uint8>& indices) const;
+	std::vector<MeshLod> GetLods() const;
+
 	size_t m_VertexCount = 0u;
 
 	std::vector<vec3> m_Positions;
@@ -33,6 +41,7 @@ struct MeshDataContainer final
 	std::vector<vec2> m_TexCoords;
 
 	std::vector<uint32> m_Indices;
+	std::vector<MeshLod> m_Lods;
 
 	std::string m_Name;
 };
@@ -99,6 +108,15 @@ public:
 	// c-tor d-tor
 	//-------------
 	MeshData(MeshDataContainer const* const cpuData);
+	MeshData(std::string const& name,
+		T_VertexFlags const flags,
+		math::Sphere const& boundingSphere,
+		size_t const vertexCount,
+		uint8 const* const vertices,
+		size_t const indexCount,
+		E_DataType const indexType,
+		uint8 const* const indices,
+		std::vector<MeshLod> const& lods);
 	~MeshData();
 
 	// accessors
@@ -106,15 +124,20 @@ public:
 	std::string const& GetName() const { return m_Name; }
 	T_VertexFlags GetSupportedFlags() const { return m_SupportedFlags; }
 	math::Sphere const& GetBoundingSphere() const { return m_BoundingSphere; }
-	size_t GetIndexCount() const { return m_IndexCount; }
+	size_t GetIndexCount() const { return static_cast<size_t>(m_Lods[0].m_IndexCount); } // full detail level
+	std::vector<MeshLod> const& GetLods() const { return m_Lods; }
 	E_DataType GetIndexDataType() const { return m_IndexDataType; }
 	T_BufferLoc GetVertexBuffer() const { return m_VertexBuffer; }
 	T_BufferLoc GetIndexBuffer() const { return m_IndexBuffer; }
 	MeshSurface const* GetSurface(render::Material const* const material) const;
 
+	// utility
+	//---------
+private:
+	void CreateBuffers(uint8 const* const vertices, uint8 const* const indices);
+
 	// Data
 	///////
-private:
 
 	std::string m_Name;
 
@@ -124,7 +147,8 @@ private:
 	math::Sphere m_BoundingSphere;
 
 	size_t m_VertexCount = 0u;
-	size_t m_IndexCount = 0u;
+	size_t m_IndexCount = 0u; // all levels of detail
+	std::vector<MeshLod> m_Lods;
 
 	T_BufferLoc m_VertexBuffer = 0u;
 	T_BufferLoc m_IndexBuffer = 0u;
@@ -137,11 +161,22 @@ private:
 // MeshAsset
 //
 // Loadable Mesh Data
+//  - source meshes are imported with assimp at load time, cooked meshes are uploaded as they are
+//  - cooked meshes keep the source asset name and are recognized by their header
+//  - the cooker generates a level of detail for every ratio of the full detail triangle count
 //
 class MeshAsset final : public core::Asset<MeshData, false>
 {
 	DECLARE_FORCED_LINKING()
 public:
+	// static functionality
+	//----------------------
+	static bool IsCookedMesh(std::vector<uint8> const& data);
+	static void WriteCookedMesh(MeshDataContainer const& cpuData, std::vector<uint8>& data);
+
+	static MeshDataContainer* LoadAssimp(std::vector<uint8> const& data, std::string const& extension);
+	static MeshDataContainer* LoadGLTF(std::vector<uint8> const& data, std::string const& path, std::string const& extension);
+
 	// Construct destruct
 	//---------------------
 	MeshAsset() : core::Asset<MeshData, false>() {}
@@ -150,12 +185,14 @@ public:
 	// Asset overrides
 	//---------------------
 	bool LoadFromMemory(std::vector<uint8> const& data) override;
-	MeshDataContainer* LoadAssimp(std::vector<uint8> const& data, std::string const& extension);
-	MeshDataContainer* LoadGLTF(std::vector<uint8> const& data, std::string const& path, std::string const& extension);
+
+private:
+	MeshData* LoadCooked(std::vector<uint8> const& data);
 
 	// Data
 	///////
 public:
+	std::vector<float> m_LodRatios = { 0.5f, 0.25f, 0.125f };
 
 	RTTR_ENABLE(core::Asset<MeshData, false>)
 };
@@ -0,0 +1,52 @@
+// Data structures for the layout of a cooked mesh
+
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// MeshFileHeader
+//
+// Start of a cooked mesh, followed by:
+//  - the mesh name (nameLength chars)
+//  - lodCount MeshFileLod entries, from full to lowest detail
+//  - the interleaved, quantized vertex stream (vertexCount * the vertex size of vertexFlags bytes), see AttributeDescriptor
+//  - the index buffer (indexCount indices of indexType - either E_DataType::UShort or E_DataType::UInt), containing all levels of detail
+//
+struct MeshFileHeader
+{
+	static uint32 const s_Magic = 0x534D5445u; // "ETMS"
+	static uint32 const s_Version = 3u; // 2: quantized vertex attributes, 3: levels of detail
+
+	uint32 magic;
+	uint32 version;
+	uint8 vertexFlags;
+	uint8 indexType;
+	uint16 lodCount;
+	uint32 nameLength;
+	uint64 vertexCount;
+	uint64 indexCount;
+	float boundingCenterX;
+	float boundingCenterY;
+	float boundingCenterZ;
+	float boundingRadius;
+};
+
+//---------------------------------
+// MeshFileLod
+//
+// Index range of a level of detail, the error is relative to the bounding radius, see MeshLod
+//
+struct MeshFileLod
+{
+	uint32 firstIndex;
+	uint32 indexCount;
+	float error;
+};
+
+
+} // namespace render
+} // namespace et
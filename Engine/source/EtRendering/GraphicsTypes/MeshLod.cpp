@@ -0,0 +1,56 @@
+#include "stdafx.h"
+#include "MeshLod.h"
+
+#include "VertexInfo.h"
+
+
+namespace et {
+namespace render {
+
+
+//==========
+// Mesh LOD
+//==========
+
+
+// static
+float const MeshLod::s_ScreenErrorThreshold = 0.001f; // fraction of the viewport height, about a pixel at 1080p
+float const MeshLod::s_ShadowErrorScale = 4.f; // shadow maps are filtered, so casters can deviate further
+
+
+//---------------------------------
+// MeshLod::Select
+//
+// Returns the coarsest level of detail whose error stays below the threshold on screen
+//  - the projected radius is the bounding sphere radius as a fraction of the viewport height
+//  - expects errors to increase with each level, as the cooker generates them
+//
+uint32 MeshLod::Select(std::vector<MeshLod> const& lods, float const projectedRadius, float const threshold)
+{
+	uint32 selected = 0u;
+	for (uint32 lodIdx = 1u; lodIdx < static_cast<uint32>(lods.size()); ++lodIdx)
+	{
+		if (lods[lodIdx].m_Error * projectedRadius > threshold)
+		{
+			break;
+		}
+
+		selected = lodIdx;
+	}
+
+	return selected;
+}
+
+//---------------------------------
+// MeshLod::GetIndexOffset
+//
+// Byte offset of a level's first index into the bound index buffer, in the form draw calls expect it
+//
+void const* MeshLod::GetIndexOffset(uint32 const firstIndex, E_DataType const indexType)
+{
+	return reinterpret_cast<void const*>(static_cast<size_t>(firstIndex) * static_cast<size_t>(DataTypeInfo::GetTypeSize(indexType)));
+}
+
+
+} // namespace render
+} // namespace et
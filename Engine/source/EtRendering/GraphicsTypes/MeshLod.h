@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+
+#include <EtCore/Util/AtomicTypes.h>
+
+#include <EtRendering/GraphicsContext/GraphicsTypes.h>
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// MeshLod
+//
+// Range of a mesh's index buffer that draws one level of detail, all levels share the mesh's vertex buffer
+//  - levels are ordered from the full detail mesh to the coarsest one, level 0 always starts at the first index
+//  - the error is the geometric deviation from the full detail mesh, relative to the bounding sphere radius
+//
+struct MeshLod final
+{
+	// static functionality
+	//----------------------
+	static float const s_ScreenErrorThreshold;
+	static float const s_ShadowErrorScale;
+
+	static uint32 Select(std::vector<MeshLod> const& lods, float const projectedRadius, float const threshold);
+	static void const* GetIndexOffset(uint32 const firstIndex, E_DataType const indexType);
+
+	// Data
+	///////
+
+	uint32 m_FirstIndex = 0u;
+	uint32 m_IndexCount = 0u;
+	float m_Error = 0.f;
+};
+
+
+} // namespace render
+} // namespace et
@@ -19,6 +19,12 @@ namespace render {
 //===================
 
 
+// static
+char const* const ShaderData::s_InstancedDefine = "INSTANCED";
+char const* const ShaderData::s_MaterialBlockName = "MaterialParameters";
+uint32 const ShaderData::s_MaterialBlockBinding = 1u; // the shared variable block uses 0
+
+
 // Construct destruct
 ///////////////
 
@@ -38,6 +44,8 @@ ShaderData::ShaderData(T_ShaderLoc const program)
 //
 ShaderData::~ShaderData()
 {
+	delete m_InstancedVariant;
+
 	Viewport::GetCurrentApiContext()->DeleteProgram(m_ShaderProgram);
 
 	render::parameters::DestroyBlock(m_CurrentUniforms);
@@ -57,19 +65,76 @@ render::T_ParameterBlock ShaderData::CopyParameterBlock(render::T_ConstParameter
 	return ret;
 }
 
+//--------------------------------
+// ShaderData::GetUniformHandle
+//
+// Binary search in the lookup table built at link time, the returned handle is invalid if the shader doesn't have the uniform
+//
+ShaderData::UniformHandle ShaderData::GetUniformHandle(T_Hash const uniform) const
+{
+	auto const foundIt = std::lower_bound(m_UniformLookup.cbegin(), m_UniformLookup.cend(), uniform, 
+		[](std::pair<T_Hash, uint32> const& entry, T_Hash const hash)
+		{
+			return entry.first < hash;
+		});
+
+	if ((foundIt == m_UniformLookup.cend()) || (foundIt->first != uniform))
+	{
+		return UniformHandle();
+	}
+
+	return UniformHandle(foundIt->second);
+}
+
+//--------------------------------
+// ShaderData::CreateParameterBuffer
+//
+// Create a uniform buffer holding the material block part of a parameter block, or nothing if the shader has no material block
+//  - parameter blocks of materials don't change after loading, so the buffer is static
+//
+T_BufferLoc ShaderData::CreateParameterBuffer(render::T_ConstParameterBlock const block) const
+{
+	if (m_MaterialBlockSize == 0u)
+	{
+		return 0u;
+	}
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	T_BufferLoc const buffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Uniform, buffer);
+	api->SetBufferData(E_BufferType::Uniform, static_cast<int64>(m_MaterialBlockSize), block, E_UsageHint::Static);
+
+	return buffer;
+}
+
 //----------------------------------
 // ShaderData::UploadParameterBlock
 //
 // Upload all variables in a parameter block according to the shaders layout
+//  - the material block is set by binding the buffer created from the same parameter block
+//  - loose uniforms are only uploaded if they changed
 //
-void ShaderData::UploadParameterBlock(render::T_ConstParameterBlock const block) const
+void ShaderData::UploadParameterBlock(render::T_ConstParameterBlock const block, T_BufferLoc const parameterBuffer) const
 {
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
-	for (render::UniformParam const& param : m_UniformLayout)
+	if (m_MaterialBlockSize > 0u)
 	{
-		// textures are alwats updated as we are not storing their binding points at the moement 
-		// #todo: this can and should be improved
+		ET_ASSERT(parameterBuffer != 0u, "Shader has a material block, parameters need to be uploaded with a parameter buffer");
+		api->BindBufferRange(E_BufferType::Uniform, s_MaterialBlockBinding, parameterBuffer, 0u, m_MaterialBlockSize);
+	}
+
+	for (uint32 paramIdx = 0u; paramIdx < static_cast<uint32>(m_UniformLayout.size()); ++paramIdx)
+	{
+		render::UniformParam const& param = m_UniformLayout[paramIdx];
+
+		// material block members, or not used by this variant
+		if (param.location < 0)
+		{
+			continue;
+		}
+
 		switch (param.type)
 		{
 		case E_ParamType::Texture2D:
@@ -80,8 +145,7 @@ void ShaderData::UploadParameterBlock(render::T_ConstParameterBlock const block)
 			TextureData const* const texture = render::parameters::Read<TextureData const*>(block, param.offset);
 			if (texture != nullptr)
 			{
-				T_TextureUnit const binding = api->BindTexture(texture->GetTargetType(), texture->GetLocation(), false);
-				api->UploadUniform(param.location, static_cast<int32>(binding));
+				BindSampler(paramIdx, texture);
 			}
 		}
 		continue;
@@ -143,6 +207,27 @@ void ShaderData::UploadParameterBlock(render::T_ConstParameterBlock const block)
 }
 
 
+//----------------------------------
+// ShaderData::BindSampler
+//
+// Bind a texture and point the sampler at its unit
+//  - the context skips textures that are already bound, and the sampler uniform is only set if the unit changed
+//
+void ShaderData::BindSampler(uint32 const layoutIdx, TextureData const* const texture) const
+{
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	int32 const unit = static_cast<int32>(api->BindTexture(texture->GetTargetType(), texture->GetLocation(), false));
+
+	int32& currentUnit = m_SamplerUnits[layoutIdx];
+	if (currentUnit != unit)
+	{
+		api->UploadUniform(m_UniformLayout[layoutIdx].location, unit);
+		currentUnit = unit;
+	}
+}
+
+
 //===================
 // Shader Asset
 //===================
@@ -187,64 +272,24 @@ bool ShaderAsset::LoadFromMemory(std::vector<uint8> const& data)
 
 	// Compile
 	//------------------
-	T_ShaderLoc const vertexShader = CompileShader(vertSource, E_ShaderType::Vertex);
-
-	T_ShaderLoc geoShader = 0;
-	if (useGeo)
-	{
-		geoShader = CompileShader(geoSource, E_ShaderType::Geometry);
-	}
-
-	T_ShaderLoc fragmentShader = 0;
-	if (useFrag)
-	{
-		fragmentShader = CompileShader(fragSource, E_ShaderType::Fragment);
-	}
-
-	// Combine Shaders into a program
-	//------------------
-
-	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
-
-	T_ShaderLoc const shaderProgram = api->CreateProgram();
-
-	api->AttachShader(shaderProgram, vertexShader);
-
-	if (useGeo)
-	{
-		api->AttachShader(shaderProgram, geoShader);
-	}
-
-	if (useFrag)
-	{
-		api->AttachShader(shaderProgram, fragmentShader);
-		api->BindFragmentDataLocation(shaderProgram, 0, "outColor");
-	}
-
-	api->LinkProgram(shaderProgram);
-
-	// Delete shader objects now that we have a program
-	api->DeleteShader(vertexShader);
-
-	if (useGeo)
-	{
-		api->DeleteShader(geoShader);
-	}
-
-	if (useFrag)
-	{
-		api->DeleteShader(fragmentShader);
-	}
+	T_ShaderLoc const shaderProgram = BuildProgram(vertSource, geoSource, fragSource, useGeo, useFrag);
 
 	// Create shader data
 	m_Data = new ShaderData(shaderProgram);
 
 	// Extract uniform info
 	//------------------
-	api->SetShader(m_Data);
-	InitUniforms();
+	Viewport::GetCurrentApiContext()->SetShader(m_Data);
+	InitUniforms(*m_Data);
 	GetAttributes(shaderProgram, m_Data->m_Attributes);
 
+	// Variants
+	//------------------
+	if (vertSource.find(ShaderData::s_InstancedDefine) != std::string::npos)
+	{
+		InitInstancedVariant(vertSource, geoSource, fragSource, useGeo, useFrag);
+	}
+
 	// all done
 	return true;
 }
@@ -289,6 +334,69 @@ T_ShaderLoc ShaderAsset::CompileShader(std::string const& shaderSourceStr, E_Sha
 	return shader;
 }
 
+//---------------------------------
+// ShaderAsset::BuildProgram
+//
+// Compile shader sources and link them into a program
+//
+T_ShaderLoc ShaderAsset::BuildProgram(std::string const& vertSource, 
+	std::string const& geoSource, 
+	std::string const& fragSource, 
+	bool const useGeo, 
+	bool const useFrag)
+{
+	T_ShaderLoc const vertexShader = CompileShader(vertSource, E_ShaderType::Vertex);
+
+	T_ShaderLoc geoShader = 0;
+	if (useGeo)
+	{
+		geoShader = CompileShader(geoSource, E_ShaderType::Geometry);
+	}
+
+	T_ShaderLoc fragmentShader = 0;
+	if (useFrag)
+	{
+		fragmentShader = CompileShader(fragSource, E_ShaderType::Fragment);
+	}
+
+	// Combine Shaders into a program
+	//------------------
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	T_ShaderLoc const shaderProgram = api->CreateProgram();
+
+	api->AttachShader(shaderProgram, vertexShader);
+
+	if (useGeo)
+	{
+		api->AttachShader(shaderProgram, geoShader);
+	}
+
+	if (useFrag)
+	{
+		api->AttachShader(shaderProgram, fragmentShader);
+		api->BindFragmentDataLocation(shaderProgram, 0, "outColor");
+	}
+
+	api->LinkProgram(shaderProgram);
+
+	// Delete shader objects now that we have a program
+	api->DeleteShader(vertexShader);
+
+	if (useGeo)
+	{
+		api->DeleteShader(geoShader);
+	}
+
+	if (useFrag)
+	{
+		api->DeleteShader(fragmentShader);
+	}
+
+	return shaderProgram;
+}
+
 //---------------------------------
 // ShaderAsset::Precompile
 //
@@ -451,44 +559,83 @@ bool ShaderAsset::ReplaceInclude(std::string &line)
 //
 // Extract shader uniforms from a program
 //
-void ShaderAsset::InitUniforms()
+void ShaderAsset::InitUniforms(ShaderData& data)
 {
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
 	// uniform blocks
 	//----------------
-	std::vector<std::string> blockNames = api->GetUniformBlockNames(m_Data->m_ShaderProgram);
+	std::vector<std::string> blockNames = api->GetUniformBlockNames(data.m_ShaderProgram);
 	for (std::string const& blockName : blockNames)
 	{
-		m_Data->m_UniformBlocks.emplace_back(GetHash(blockName));
+		data.m_UniformBlocks.emplace_back(GetHash(blockName));
 	}
 
 	// hook up shared uniform variables if the shader requires it
 	render::SharedVarController const& sharedVarController = RenderingSystems::Instance()->GetSharedVarController();
 
 	core::HashString const sharedBlockId(sharedVarController.GetBlockName().c_str());
-	auto const foundBlock = std::find(m_Data->m_UniformBlocks.cbegin(), m_Data->m_UniformBlocks.cend(), sharedBlockId);
+	auto const foundBlock = std::find(data.m_UniformBlocks.cbegin(), data.m_UniformBlocks.cend(), sharedBlockId);
 
-	if (foundBlock != m_Data->m_UniformBlocks.cend())
+	if (foundBlock != data.m_UniformBlocks.cend())
 	{
-		T_BlockIndex const blockIndex = static_cast<T_BlockIndex>(foundBlock - m_Data->m_UniformBlocks.cbegin());
-		api->SetUniformBlockBinding(m_Data->m_ShaderProgram, blockIndex, sharedVarController.GetBufferBinding());
+		T_BlockIndex const blockIndex = static_cast<T_BlockIndex>(foundBlock - data.m_UniformBlocks.cbegin());
+		api->SetUniformBlockBinding(data.m_ShaderProgram, blockIndex, sharedVarController.GetBufferBinding());
 	}
 
 	// get all uniforms that are contained by uniform blocsk so we can exclude them
 	std::vector<int32> blockContainedUniIndices;
-	for (T_BlockIndex blockIdx = 0; blockIdx < static_cast<T_BlockIndex>(m_Data->m_UniformBlocks.size()); ++blockIdx)
+	for (T_BlockIndex blockIdx = 0; blockIdx < static_cast<T_BlockIndex>(data.m_UniformBlocks.size()); ++blockIdx)
 	{
-		std::vector<int32> indicesForCurrentBlock = api->GetUniformIndicesForBlock(m_Data->m_ShaderProgram, blockIdx);
+		std::vector<int32> indicesForCurrentBlock = api->GetUniformIndicesForBlock(data.m_ShaderProgram, blockIdx);
 
 		// merge with blockContainedUniIndices
 		blockContainedUniIndices.reserve(blockContainedUniIndices.size() + indicesForCurrentBlock.size());
 		blockContainedUniIndices.insert(blockContainedUniIndices.end(), indicesForCurrentBlock.begin(), indicesForCurrentBlock.end());
 	}
 
+	// material parameters - members keep their std140 offsets, so this part of parameter blocks can be copied to a uniform buffer as is
+	core::HashString const materialBlockId(ShaderData::s_MaterialBlockName);
+	auto const foundMaterialBlock = std::find(data.m_UniformBlocks.cbegin(), data.m_UniformBlocks.cend(), materialBlockId);
+
+	if (foundMaterialBlock != data.m_UniformBlocks.cend())
+	{
+		T_BlockIndex const blockIndex = static_cast<T_BlockIndex>(foundMaterialBlock - data.m_UniformBlocks.cbegin());
+		api->SetUniformBlockBinding(data.m_ShaderProgram, blockIndex, ShaderData::s_MaterialBlockBinding);
+
+		for (int32 const uniIdx : api->GetUniformIndicesForBlock(data.m_ShaderProgram, blockIndex))
+		{
+			std::vector<UniformDescriptor> unis;
+			api->GetActiveUniforms(data.m_ShaderProgram, static_cast<uint32>(uniIdx), unis);
+
+			for (UniformDescriptor const& uni : unis)
+			{
+				ET_ASSERT(uni.blockOffset >= 0);
+				ET_ASSERT(uni.type != E_ParamType::Matrix3x3, "std140 pads mat3 columns, use mat4 for material block member '%s'", uni.name.c_str());
+
+				core::HashString const hash(uni.name.c_str());
+				ET_ASSERT(std::find(data.m_UniformIds.cbegin(), data.m_UniformIds.cend(), hash) == data.m_UniformIds.cend());
+
+				data.m_UniformIds.push_back(hash);
+
+				render::UniformParam uniParam;
+				uniParam.location = -1;
+				uniParam.type = uni.type;
+				uniParam.offset = static_cast<size_t>(uni.blockOffset);
+				data.m_UniformLayout.push_back(uniParam);
+
+				data.m_MaterialBlockSize = std::max(data.m_MaterialBlockSize, uniParam.offset + render::parameters::GetSize(uni.type));
+			}
+		}
+
+		// blocks are sized in multiples of vec4, loose uniforms follow
+		data.m_MaterialBlockSize = 16u * ((data.m_MaterialBlockSize + 15u) / 16u);
+		data.m_UniformDataSize = data.m_MaterialBlockSize;
+	}
+
 	// default uniform variables
 	//-----------------------------
-	int32 const count = api->GetUniformCount(m_Data->m_ShaderProgram);
+	int32 const count = api->GetUniformCount(data.m_ShaderProgram);
 
 	for (int32 uniIdx = 0; uniIdx < count; ++uniIdx)
 	{
@@ -500,7 +647,7 @@ void ShaderAsset::InitUniforms()
 
 		// get all descriptors for index (may be more than one if contained by array)
 		std::vector<UniformDescriptor> unis;
-		api->GetActiveUniforms(m_Data->m_ShaderProgram, static_cast<uint32>(uniIdx), unis);
+		api->GetActiveUniforms(data.m_ShaderProgram, static_cast<uint32>(uniIdx), unis);
 
 		// create a layout for each
 		for (UniformDescriptor const& uni : unis)
@@ -508,28 +655,117 @@ void ShaderAsset::InitUniforms()
 			core::HashString const hash(uni.name.c_str());
 
 			// ensure no hash collisions
-			ET_ASSERT(std::find(m_Data->m_UniformIds.cbegin(), m_Data->m_UniformIds.cend(), hash) == m_Data->m_UniformIds.cend());
+			ET_ASSERT(std::find(data.m_UniformIds.cbegin(), data.m_UniformIds.cend(), hash) == data.m_UniformIds.cend());
 
-			m_Data->m_UniformIds.push_back(hash);
+			data.m_UniformIds.push_back(hash);
 
-			m_Data->m_UniformLayout.push_back(render::UniformParam());
-			render::UniformParam& uniParam = m_Data->m_UniformLayout[m_Data->m_UniformLayout.size() - 1];
+			data.m_UniformLayout.push_back(render::UniformParam());
+			render::UniformParam& uniParam = data.m_UniformLayout[data.m_UniformLayout.size() - 1];
 			uniParam.location = uni.location;
 			uniParam.type = uni.type;
-			uniParam.offset = m_Data->m_UniformDataSize;
+			uniParam.offset = data.m_UniformDataSize;
 
-			m_Data->m_UniformDataSize += render::parameters::GetSize(uni.type);
+			data.m_UniformDataSize += render::parameters::GetSize(uni.type);
 		}
 	}
 
 	// allocate parameters
-	m_Data->m_CurrentUniforms = render::parameters::CreateBlock(m_Data->m_UniformDataSize);
+	data.m_CurrentUniforms = render::parameters::CreateBlock(data.m_UniformDataSize);
+	data.m_SamplerUnits.assign(data.m_UniformLayout.size(), -1);
+
+	// init defaults - block members can't have initializers, and padding needs to stay zeroed for booleans which are 4 bytes in std140
+	std::fill(data.m_CurrentUniforms, data.m_CurrentUniforms + data.m_MaterialBlockSize, static_cast<uint8>(0u));
+	for (render::UniformParam const& param : data.m_UniformLayout)
+	{
+		if (param.location >= 0)
+		{
+			api->PopulateUniform(data.m_ShaderProgram, param.location, param.type, static_cast<void*>(data.m_CurrentUniforms + param.offset));
+		}
+	}
 
-	// init defaults
-	for (render::UniformParam const& param : m_Data->m_UniformLayout)
+	// lookup by name
+	data.m_UniformLookup.clear();
+	for (size_t paramIdx = 0u; paramIdx < data.m_UniformIds.size(); ++paramIdx)
 	{
-		api->PopulateUniform(m_Data->m_ShaderProgram, param.location, param.type, static_cast<void*>(m_Data->m_CurrentUniforms + param.offset));
+		data.m_UniformLookup.emplace_back(data.m_UniformIds[paramIdx].Get(), static_cast<uint32>(paramIdx));
 	}
+
+	std::sort(data.m_UniformLookup.begin(), data.m_UniformLookup.end());
+}
+
+//---------------------------------
+// ShaderAsset::InitInstancedVariant
+//
+// Compile the shader again with the instanced define, and give it the same uniform layout as the base shader
+//  - uniforms the variant doesn't use (such as the model matrix) keep their slot in the layout with an invalid location
+//  - uniforms only the variant uses are not accessible
+//
+void ShaderAsset::InitInstancedVariant(std::string vertSource, 
+	std::string const& geoSource, 
+	std::string const& fragSource, 
+	bool const useGeo, 
+	bool const useFrag)
+{
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	// defines have to follow the version directive
+	size_t insertPos = 0u;
+	size_t const versionPos = vertSource.find("#version");
+	if (versionPos != std::string::npos)
+	{
+		insertPos = vertSource.find('\n', versionPos);
+		insertPos = (insertPos == std::string::npos) ? vertSource.size() : insertPos + 1u;
+	}
+
+	vertSource.insert(insertPos, std::string("#define ") + ShaderData::s_InstancedDefine + "\n");
+
+	ShaderData* const variant = new ShaderData(BuildProgram(vertSource, geoSource, fragSource, useGeo, useFrag));
+
+	api->SetShader(variant);
+	InitUniforms(*variant);
+	GetAttributes(variant->m_ShaderProgram, variant->m_Attributes);
+
+	// meshes set up their vertex arrays for the base shader, so both need to read vertex data from the same locations
+	for (ShaderData::T_AttributeLocation const& baseAttrib : m_Data->m_Attributes)
+	{
+		auto const attribIt = std::find_if(variant->m_Attributes.cbegin(), variant->m_Attributes.cend(), 
+			[&baseAttrib](ShaderData::T_AttributeLocation const& loc)
+			{
+				return loc.second.name == baseAttrib.second.name;
+			});
+
+		ET_ASSERT(attribIt == variant->m_Attributes.cend() || attribIt->first == baseAttrib.first,
+			"Attribute '%s' has a different location in the instanced variant, use explicit locations", baseAttrib.second.name.c_str());
+	}
+
+	// match the base layout
+	std::vector<render::UniformParam> layout = m_Data->m_UniformLayout;
+	for (size_t paramIdx = 0u; paramIdx < layout.size(); ++paramIdx)
+	{
+		auto const foundIt = std::find(variant->m_UniformIds.cbegin(), variant->m_UniformIds.cend(), m_Data->m_UniformIds[paramIdx]);
+		if (foundIt == variant->m_UniformIds.cend())
+		{
+			layout[paramIdx].location = -1; // uploads are ignored
+		}
+		else
+		{
+			layout[paramIdx].location = variant->m_UniformLayout[foundIt - variant->m_UniformIds.cbegin()].location;
+		}
+	}
+
+	variant->m_UniformLayout = layout;
+	variant->m_UniformIds = m_Data->m_UniformIds;
+	variant->m_UniformLookup = m_Data->m_UniformLookup;
+	variant->m_UniformDataSize = m_Data->m_UniformDataSize;
+	variant->m_MaterialBlockSize = m_Data->m_MaterialBlockSize;
+	variant->m_SamplerUnits.assign(layout.size(), -1);
+
+	render::parameters::DestroyBlock(variant->m_CurrentUniforms);
+	variant->m_CurrentUniforms = m_Data->CopyParameterBlock(m_Data->m_CurrentUniforms);
+
+	api->SetShader(m_Data);
+
+	m_Data->m_InstancedVariant = variant;
 }
 
 //---------------------------------
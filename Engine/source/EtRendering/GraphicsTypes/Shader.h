@@ -1,4 +1,6 @@
 #pragma once
+#include <limits>
+
 #include "VertexInfo.h"
 #include "ParameterBlock.h"
 
@@ -28,6 +30,28 @@ class ShaderData final
 public:
 	typedef std::pair<T_AttribLoc, AttributeDescriptor> T_AttributeLocation;
 
+	static char const* const s_InstancedDefine;
+	static char const* const s_MaterialBlockName;
+	static uint32 const s_MaterialBlockBinding;
+
+	//---------------------------------
+	// UniformHandle
+	//
+	// Pre resolved slot in the uniform layout, so frequent uploads can skip the lookup by name
+	//  - only valid for the shader that resolved it (and its variants, which share the layout)
+	//
+	struct UniformHandle final
+	{
+		static constexpr uint32 s_Invalid = std::numeric_limits<uint32>::max();
+
+		UniformHandle() = default;
+		explicit UniformHandle(uint32 const idx) : index(idx) {}
+
+		bool IsValid() const { return index != s_Invalid; }
+
+		uint32 index = s_Invalid;
+	};
+
 	// Construct destruct
 	//---------------------
 	ShaderData() = default;
@@ -43,17 +67,31 @@ public:
 	std::vector<render::UniformParam> const& GetUniformLayout() const { return m_UniformLayout; }
 	std::vector<core::HashString> const& GetUniformIds() const { return m_UniformIds; }
 	render::T_ConstParameterBlock GetCurrentUniforms() const { return m_CurrentUniforms; }
+	size_t GetMaterialBlockSize() const { return m_MaterialBlockSize; }
+
+	ShaderData const* GetInstancedVariant() const { return m_InstancedVariant; }
+
+	UniformHandle GetUniformHandle(T_Hash const uniform) const;
 
 	// functionliaty
 	//---------------------
 	render::T_ParameterBlock CopyParameterBlock(render::T_ConstParameterBlock const source) const;
-	void UploadParameterBlock(render::T_ConstParameterBlock const block) const;
+	T_BufferLoc CreateParameterBuffer(render::T_ConstParameterBlock const block) const;
+	void UploadParameterBlock(render::T_ConstParameterBlock const block, T_BufferLoc const parameterBuffer = 0u) const;
 
 	template<typename TDataType>
 	bool Upload(T_Hash const uniform, TDataType const& data, bool const reportWarnings = true) const;
 
+	template<typename TDataType>
+	void Upload(UniformHandle const handle, TDataType const& data) const;
+
 	template<>
-	bool Upload<TextureData const*>(T_Hash const uniform, TextureData const* const& textureData, bool const reportWarnings) const;
+	void Upload<TextureData const*>(UniformHandle const handle, TextureData const* const& textureData) const;
+
+	// utility
+	//---------------------
+private:
+	void BindSampler(uint32 const layoutIdx, TextureData const* const texture) const;
 
 	// Data
 	///////
@@ -71,11 +109,20 @@ private:
 	// loose uniforms
 	std::vector<render::UniformParam> m_UniformLayout;
 	std::vector<core::HashString> m_UniformIds;
+	std::vector<std::pair<T_Hash, uint32>> m_UniformLookup; // sorted by hash, maps to layout indices
 	render::T_ParameterBlock m_CurrentUniforms = nullptr;
 	size_t m_UniformDataSize = 0u;
+	mutable std::vector<int32> m_SamplerUnits; // texture unit last uploaded to each sampler in the layout, -1 if unknown
+
+	// material block members are stored in std140 layout at the start of parameter blocks, and uploaded with uniform buffers
+	size_t m_MaterialBlockSize = 0u;
 
 	// within blocks
 	std::vector<core::HashString> m_UniformBlocks; // addressed by their indices
+
+	// variants
+	//----------
+	ShaderData* m_InstancedVariant = nullptr; // compiled with s_InstancedDefine, shares the uniform layout so parameter blocks can be used with both
 };
 
 //---------------------------------
@@ -100,6 +147,11 @@ public:
 	//---------------------
 private:
 	T_ShaderLoc CompileShader(std::string const& shaderSourceStr, E_ShaderType const type);
+	T_ShaderLoc BuildProgram(std::string const& vertSource, 
+		std::string const& geoSource, 
+		std::string const& fragSource, 
+		bool const useGeo, 
+		bool const useFrag);
 
 	bool Precompile(std::string &shaderContent, 
 		bool &useGeo, 
@@ -110,7 +162,12 @@ private:
 
 	bool ReplaceInclude(std::string &line);
 
-	void InitUniforms();
+	void InitUniforms(ShaderData& data);
+	void InitInstancedVariant(std::string vertSource, 
+		std::string const& geoSource, 
+		std::string const& fragSource, 
+		bool const useGeo, 
+		bool const useFrag);
 	void GetAttributes(T_ShaderLoc const shaderProgram, std::vector<ShaderData::T_AttributeLocation>& attributes);
 
 	RTTR_ENABLE(core::Asset<ShaderData, false>)
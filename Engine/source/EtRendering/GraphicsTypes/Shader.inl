@@ -22,9 +22,8 @@ template<typename TDataType>
 bool ShaderData::Upload(T_Hash const uniform, const TDataType &data, bool const reportWarnings) const
 {
 	// Try finding the uniform
-	auto const idIt = std::find(m_UniformIds.cbegin(), m_UniformIds.cend(), uniform);
-
-	if (idIt == m_UniformIds.cend())
+	UniformHandle const handle = GetUniformHandle(uniform);
+	if (!handle.IsValid())
 	{
 		if (reportWarnings)
 		{
@@ -34,11 +33,25 @@ bool ShaderData::Upload(T_Hash const uniform, const TDataType &data, bool const
 		return false;
 	}
 
-	render::UniformParam const& param = m_UniformLayout[idIt - m_UniformIds.cbegin()];
+	Upload(handle, data);
+	return true;
+}
+
+//-------------------------------
+// ShaderData::Upload
+//
+// Upload through a pre resolved handle
+//
+template<typename TDataType>
+void ShaderData::Upload(UniformHandle const handle, TDataType const& data) const
+{
+	ET_ASSERT(handle.IsValid());
+	render::UniformParam const& param = m_UniformLayout[handle.index];
+	ET_ASSERT(param.offset >= m_MaterialBlockSize, "Material block members can only be set through parameter blocks");
 
 	if (render::parameters::Read<TDataType>(m_CurrentUniforms, param.offset) == data)
 	{
-		return true; // no need for API call as the state wouldn't change
+		return; // no need for API call as the state wouldn't change
 	}
 
 	ET_ASSERT(render::parameters::GetTypeId(param.type) == typeid(TDataType));
@@ -47,8 +60,6 @@ bool ShaderData::Upload(T_Hash const uniform, const TDataType &data, bool const
 
 	// ensure the shader reflects the GPU state
 	render::parameters::Write<TDataType>(m_CurrentUniforms, param.offset, data);
-
-	return true;
 }
 
 //-------------------------------
@@ -57,22 +68,10 @@ bool ShaderData::Upload(T_Hash const uniform, const TDataType &data, bool const
 // Upload a texture to a shader
 //
 template<>
-bool ShaderData::Upload<TextureData const*>(T_Hash const uniform, TextureData const* const& textureData, bool const reportWarnings) const
+void ShaderData::Upload<TextureData const*>(UniformHandle const handle, TextureData const* const& textureData) const
 {
-	// Try finding the uniform
-	auto const idIt = std::find(m_UniformIds.cbegin(), m_UniformIds.cend(), uniform);
-
-	if (idIt == m_UniformIds.cend())
-	{
-		if (reportWarnings)
-		{
-			ET_ASSERT(false, "Couldn't find uniform!");
-		}
-
-		return false;
-	}
-
-	render::UniformParam const& param = m_UniformLayout[idIt - m_UniformIds.cbegin()];
+	ET_ASSERT(handle.IsValid());
+	render::UniformParam const& param = m_UniformLayout[handle.index];
 
 	ET_ASSERT(render::parameters::MatchesTexture(param.type, textureData->GetTargetType()));
 
@@ -81,7 +80,7 @@ bool ShaderData::Upload<TextureData const*>(T_Hash const uniform, TextureData co
 	//{
 	//	if (render::parameters::Read<TextureData const*>(m_CurrentUniforms, param.offset) == textureData)
 	//	{
-	//		return true; // no need for API call as the state wouldn't change
+	//		return; // no need for API call as the state wouldn't change
 	//	}
 
 	//	ET_ASSERT(false, "Uploading bindless textures is not yet supported!");
@@ -89,17 +88,11 @@ bool ShaderData::Upload<TextureData const*>(T_Hash const uniform, TextureData co
 	//}
 	//else
 	//{
-		// we overwrite sampler uniforms every time because the bindings may have changed for bound textures
-		I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
-
-		T_TextureUnit const binding = api->BindTexture(textureData->GetTargetType(), textureData->GetLocation(), false);
-		api->UploadUniform(param.location, static_cast<int32>(binding));
+		BindSampler(handle.index, textureData);
 	//}
 
 	// ensure the shader reflects the GPU state
 	render::parameters::Write<TextureData const*>(m_CurrentUniforms, param.offset, textureData);
-
-	return true;
 }
 
 
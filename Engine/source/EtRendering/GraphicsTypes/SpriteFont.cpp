@@ -3,6 +3,7 @@
 
 #include "TextureData.h"
 #include "Shader.h"
+#include "FontDataStructure.h"
 
 #include <ft2build.h>
 #include <freetype/freetype.h>
@@ -31,9 +32,12 @@ namespace render {
 //
 vec2 FontMetric::GetKerningVec(wchar_t previous) const
 {
-	auto kerningIt = Kerning.find(previous);
+	auto kerningIt = std::lower_bound(Kerning.cbegin(), Kerning.cend(), previous, [](std::pair<wchar_t, vec2> const& pair, wchar_t const character)
+		{
+			return pair.first < character;
+		});
 
-	if (kerningIt != Kerning.end())
+	if ((kerningIt != Kerning.cend()) && (kerningIt->first == previous))
 	{
 		return kerningIt->second;
 	}
@@ -117,6 +121,17 @@ RTTR_REGISTRATION
 DEFINE_FORCED_LINKING(FontAsset) // force the shader class to be linked as it is only used in reflection
 
 
+//---------------------------------
+// FontAsset::GetEventDispatcher
+//
+// Listeners are notified before the data of any font asset is deleted
+//
+T_FontEventDispatcher& FontAsset::GetEventDispatcher()
+{
+	static T_FontEventDispatcher s_EventDispatcher;
+	return s_EventDispatcher;
+}
+
 //---------------------------------
 // TextureAsset::LoadFromMemory
 //
@@ -130,7 +145,14 @@ bool FontAsset::LoadFromMemory(std::vector<uint8> const& data)
 
 	if (extension == "ttf")
 	{
-		m_Data = LoadTtf(binaryContent);
+		if (IsCookedFont(binaryContent))
+		{
+			m_Data = LoadCooked(binaryContent);
+		}
+		else
+		{
+			m_Data = LoadTtf(binaryContent);
+		}
 	}
 	else if (extension == "fnt")
 	{
@@ -152,20 +174,112 @@ bool FontAsset::LoadFromMemory(std::vector<uint8> const& data)
 }
 
 //---------------------------------
-// TextureAsset::LoadTtf
+// FontAsset::UnloadInternal
 //
-// Rasterizes a ttf font into a SDF texture and generates SpriteFont data from it
+// Notify listeners that cache data derived from the font before deleting it
 //
-SpriteFont* FontAsset::LoadTtf(const std::vector<uint8>& binaryContent)
+void FontAsset::UnloadInternal()
 {
-	FT_Library ft;
-	if (FT_Init_FreeType(&ft))
-		LOG("FREETYPE: Could not init FreeType Library", core::LogLevel::Warning);
+	if (m_Data != nullptr)
+	{
+		FontEventData const eventData(GetId(), m_Data);
+		GetEventDispatcher().Notify(E_FontEvent::FE_Unloaded, &eventData);
+	}
 
-	FT_Face face;
-	if (FT_New_Memory_Face(ft, binaryContent.data(), (FT_Long)binaryContent.size(), 0, &face))
-		LOG("FREETYPE: Failed to load font", core::LogLevel::Warning);
+	core::Asset<SpriteFont, false>::UnloadInternal();
+}
+
+//---------------------------------
+// FontAsset::IsCookedFont
+//
+bool FontAsset::IsCookedFont(std::vector<uint8> const& data)
+{
+	if (data.size() < sizeof(FontFileHeader))
+	{
+		return false;
+	}
 
+	uint32 magic;
+	memcpy(&magic, data.data(), sizeof(uint32));
+	return (magic == FontFileHeader::s_Magic);
+}
+
+//---------------------------------
+// FontAsset::WriteCookedFont
+//
+// Serialize font metrics and an RGBA8 SDF atlas into the layout described in FontDataStructure.h
+//
+void FontAsset::WriteCookedFont(SpriteFont const& font, ivec2 const atlasSize, std::vector<uint8> const& atlas, std::vector<uint8>& data)
+{
+	ET_ASSERT(atlas.size() == static_cast<size_t>(atlasSize.x * atlasSize.y * 4));
+
+	std::vector<FontFileGlyph> glyphs;
+	std::vector<FontFileKerning> kerning;
+	for (int32 charIdx = 0; charIdx < SpriteFont::s_CharCount; ++charIdx)
+	{
+		FontMetric const& metric = font.m_CharTable[charIdx];
+
+		FontFileGlyph glyph;
+		glyph.character = static_cast<uint16>(charIdx + SpriteFont::s_MinCharId);
+		glyph.width = metric.Width;
+		glyph.height = metric.Height;
+		glyph.offsetX = metric.OffsetX;
+		glyph.offsetY = metric.OffsetY;
+		glyph.isValid = metric.IsValid ? 1u : 0u;
+		glyph.channel = metric.Channel;
+		glyph.advanceX = metric.AdvanceX;
+		glyph.texCoordX = metric.TexCoord.x;
+		glyph.texCoordY = metric.TexCoord.y;
+		glyphs.emplace_back(glyph);
+
+		for (std::pair<wchar_t, vec2> const& pair : metric.Kerning)
+		{
+			kerning.emplace_back(FontFileKerning{ glyph.character, static_cast<uint16>(pair.first), pair.second.x, pair.second.y });
+		}
+	}
+
+	FontFileHeader header;
+	header.magic = FontFileHeader::s_Magic;
+	header.version = FontFileHeader::s_Version;
+	header.fontSize = font.m_FontSize;
+	header.useKerning = font.m_UseKerning ? 1u : 0u;
+	header.reserved = 0u;
+	header.characterCount = static_cast<uint32>(font.m_CharacterCount);
+	header.nameLength = static_cast<uint32>(font.m_FontName.size());
+	header.glyphCount = static_cast<uint32>(glyphs.size());
+	header.kerningCount = static_cast<uint32>(kerning.size());
+	header.atlasWidth = static_cast<uint32>(atlasSize.x);
+	header.atlasHeight = static_cast<uint32>(atlasSize.y);
+
+	size_t const glyphSize = glyphs.size() * sizeof(FontFileGlyph);
+	size_t const kerningSize = kerning.size() * sizeof(FontFileKerning);
+
+	data.resize(sizeof(FontFileHeader) + header.nameLength + glyphSize + kerningSize + atlas.size());
+	uint8* raw = data.data();
+
+	memcpy(raw, &header, sizeof(FontFileHeader));
+	raw += sizeof(FontFileHeader);
+
+	memcpy(raw, font.m_FontName.data(), header.nameLength);
+	raw += header.nameLength;
+
+	memcpy(raw, glyphs.data(), glyphSize);
+	raw += glyphSize;
+
+	memcpy(raw, kerning.data(), kerningSize);
+	raw += kerningSize;
+
+	memcpy(raw, atlas.data(), atlas.size());
+}
+
+//---------------------------------
+// FontAsset::LayoutGlyphs
+//
+// Generates metrics for all characters and packs them into the 4 channels of an atlas, with the font size set on the face
+//  - texture coordinates are normalized to the resulting atlas size
+//
+SpriteFont* FontAsset::LayoutGlyphs(FT_FaceRec_* const face, ivec2& atlasSize) const
+{
 	FT_Set_Pixel_Sizes(face, 0, m_FontSize);
 
 	SpriteFont* pFont = new SpriteFont();
@@ -185,27 +299,36 @@ SpriteFont* FontAsset::LoadTtf(const std::vector<uint8>& binaryContent)
 
 	uint32 totPadding = m_Padding + m_Spread;
 
+	// glyph indices are looked up once, so kerning pairs don't query them again for every previous character
+	uint32 glyphIndices[SpriteFont::s_CharCount];
+	for (int32 c = 0; c < SpriteFont::s_CharCount; c++)
+	{
+		glyphIndices[c] = FT_Get_Char_Index(face, c);
+	}
+
 	//Load individual character metrics
-	std::map<int32, FontMetric*> characters;
 	for (int32 c = 0; c < SpriteFont::s_CharCount - 1; c++)
 	{
 		FontMetric* metric = &(pFont->GetMetric(static_cast<wchar_t>(c)));
 		metric->Character = static_cast<wchar_t>(c);
 
-		uint32 glyphIdx = FT_Get_Char_Index(face, c);
+		uint32 glyphIdx = glyphIndices[c];
 
 		if (pFont->m_UseKerning && glyphIdx)
 		{
 			for (int32 previous = 0; previous < SpriteFont::s_CharCount - 1; previous++)
 			{
-				FT_Vector delta;
+				if (glyphIndices[previous] == 0u)
+				{
+					continue;
+				}
 
-				uint32 prevIdx = FT_Get_Char_Index(face, previous);
-				FT_Get_Kerning(face, prevIdx, glyphIdx, FT_KERNING_DEFAULT, &delta);
+				FT_Vector delta;
+				FT_Get_Kerning(face, glyphIndices[previous], glyphIdx, FT_KERNING_DEFAULT, &delta);
 
 				if (delta.x || delta.y)
 				{
-					metric->Kerning[static_cast<wchar_t>(previous)] = vec2((float)delta.x / 64.f, (float)delta.y / 64.f);
+					metric->Kerning.emplace_back(static_cast<wchar_t>(previous), vec2((float)delta.x / 64.f, (float)delta.y / 64.f));
 				}
 			}
 		}
@@ -263,12 +386,43 @@ SpriteFont* FontAsset::LoadTtf(const std::vector<uint8>& binaryContent)
 		}
 
 		metric->IsValid = true;
+	}
+
+	atlasSize.x = std::max(std::max(maxPos[0].x, maxPos[1].x), std::max(maxPos[2].x, maxPos[3].x));
+	atlasSize.y = std::max(std::max(maxPos[0].y, maxPos[1].y), std::max(maxPos[2].y, maxPos[3].y));
 
-		characters[c] = metric;
+	vec2 const texSize = math::vecCast<float>(atlasSize);
+	for (FontMetric& metric : pFont->m_CharTable)
+	{
+		if (metric.IsValid)
+		{
+			metric.TexCoord = metric.TexCoord / texSize;
+		}
 	}
 
-	int32 const texWidth = std::max(std::max(maxPos[0].x, maxPos[1].x), std::max(maxPos[2].x, maxPos[3].x));
-	int32 const texHeight = std::max(std::max(maxPos[0].y, maxPos[1].y), std::max(maxPos[2].y, maxPos[3].y));
+	return pFont;
+}
+
+//---------------------------------
+// TextureAsset::LoadTtf
+//
+// Rasterizes a ttf font into a SDF texture and generates SpriteFont data from it
+//
+SpriteFont* FontAsset::LoadTtf(const std::vector<uint8>& binaryContent)
+{
+	FT_Library ft;
+	if (FT_Init_FreeType(&ft))
+		LOG("FREETYPE: Could not init FreeType Library", core::LogLevel::Warning);
+
+	FT_Face face;
+	if (FT_New_Memory_Face(ft, binaryContent.data(), (FT_Long)binaryContent.size(), 0, &face))
+		LOG("FREETYPE: Failed to load font", core::LogLevel::Warning);
+
+	ivec2 texSize;
+	SpriteFont* const pFont = LayoutGlyphs(face, texSize);
+
+	int32 const texWidth = texSize.x;
+	int32 const texHeight = texSize.y;
 
 	//Setup rendering
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
@@ -316,9 +470,15 @@ SpriteFont* FontAsset::LoadTtf(const std::vector<uint8>& binaryContent)
 	//Render to Glyphs atlas
 	FT_Set_Pixel_Sizes(face, 0, m_FontSize * m_HighRes);
 	api->SetPixelUnpackAlignment(1);
-	for (auto& character : characters)
+	for (FontMetric& character : pFont->m_CharTable)
 	{
-		auto metric = character.second;
+		if (!character.IsValid)
+		{
+			continue;
+		}
+
+		FontMetric* const metric = &character;
+		ivec2 const atlasPos = math::vecCast<int32>(metric->TexCoord * math::vecCast<float>(texSize) + vec2(0.5f));
 
 		uint32 glyphIdx = FT_Get_Char_Index(face, metric->Character);
 		if (FT_Load_Glyph(face, glyphIdx, FT_LOAD_DEFAULT))
@@ -342,16 +502,13 @@ SpriteFont* FontAsset::LoadTtf(const std::vector<uint8>& binaryContent)
 		pTexture->SetParameters(params);
 
 		ivec2 res = ivec2(metric->Width - m_Padding * 2, metric->Height - m_Padding * 2);
-		api->SetViewport(math::vecCast<int32>(metric->TexCoord) + ivec2(m_Padding), res);
+		api->SetViewport(atlasPos + ivec2(m_Padding), res);
 		computeSdf->Upload("uTex"_hash, static_cast<TextureData const*>(pTexture));
 		computeSdf->Upload("uChannel"_hash, static_cast<int32>(metric->Channel));
 		computeSdf->Upload("uResolution"_hash, math::vecCast<float>(res));
 		RenderingSystems::Instance()->GetPrimitiveRenderer().Draw<primitives::Quad>();
 
 		delete pTexture;
-
-		//modify texture coordinates after rendering sprites
-		metric->TexCoord = metric->TexCoord / vec2(static_cast<float>(texWidth), static_cast<float>(texHeight));
 	}
 	api->SetPixelUnpackAlignment(4);
 
@@ -513,6 +670,109 @@ SpriteFont* FontAsset::LoadFnt(const std::vector<uint8>& binaryContent)
 	return pFont;
 }
 
+//---------------------------------
+// FontAsset::LoadCooked
+//
+// Loads a font baked by the cooker - metrics are copied as they are and the atlas is uploaded directly
+//
+SpriteFont* FontAsset::LoadCooked(std::vector<uint8> const& data)
+{
+	FontFileHeader header;
+	memcpy(&header, data.data(), sizeof(FontFileHeader));
+
+	if (header.version != FontFileHeader::s_Version)
+	{
+		LOG(FS("FontAsset::LoadCooked > Unsupported cooked font version %u, expected %u", header.version, FontFileHeader::s_Version), core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	if (header.glyphCount != static_cast<uint32>(SpriteFont::s_CharCount))
+	{
+		LOG("FontAsset::LoadCooked > Cooked font was baked for a different character range", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	size_t const atlasSize = static_cast<size_t>(header.atlasWidth) * static_cast<size_t>(header.atlasHeight) * 4u;
+	size_t const expectedSize = sizeof(FontFileHeader) 
+		+ header.nameLength 
+		+ header.glyphCount * sizeof(FontFileGlyph) 
+		+ header.kerningCount * sizeof(FontFileKerning) 
+		+ atlasSize;
+
+	if (data.size() < expectedSize)
+	{
+		LOG("FontAsset::LoadCooked > Cooked font data is truncated", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	uint8 const* raw = data.data() + sizeof(FontFileHeader);
+
+	SpriteFont* pFont = new SpriteFont();
+	pFont->m_FontSize = header.fontSize;
+	pFont->m_UseKerning = (header.useKerning != 0u);
+	pFont->m_CharacterCount = static_cast<int32>(header.characterCount);
+
+	pFont->m_FontName = std::string(reinterpret_cast<char const*>(raw), header.nameLength);
+	raw += header.nameLength;
+
+	// metrics
+	for (uint32 glyphIdx = 0u; glyphIdx < header.glyphCount; ++glyphIdx)
+	{
+		FontFileGlyph glyph;
+		memcpy(&glyph, raw, sizeof(FontFileGlyph));
+		raw += sizeof(FontFileGlyph);
+
+		FontMetric& metric = pFont->m_CharTable[glyphIdx];
+		metric.IsValid = (glyph.isValid != 0u);
+		metric.Character = static_cast<wchar_t>(glyph.character);
+		metric.Width = glyph.width;
+		metric.Height = glyph.height;
+		metric.OffsetX = glyph.offsetX;
+		metric.OffsetY = glyph.offsetY;
+		metric.AdvanceX = glyph.advanceX;
+		metric.Page = 0u;
+		metric.Channel = glyph.channel;
+		metric.TexCoord = vec2(glyph.texCoordX, glyph.texCoordY);
+	}
+
+	// kerning pairs are grouped by character and already sorted by the previous character
+	for (uint32 pairIdx = 0u; pairIdx < header.kerningCount; ++pairIdx)
+	{
+		FontFileKerning pair;
+		memcpy(&pair, raw, sizeof(FontFileKerning));
+		raw += sizeof(FontFileKerning);
+
+		if (!(SpriteFont::IsCharValid(static_cast<wchar_t>(pair.character))))
+		{
+			continue;
+		}
+
+		pFont->GetMetric(static_cast<wchar_t>(pair.character)).Kerning.emplace_back(static_cast<wchar_t>(pair.previous), vec2(pair.x, pair.y));
+	}
+
+	// atlas
+	TextureParameters params(false);
+	params.minFilter = E_TextureFilterMode::Linear;
+	params.magFilter = E_TextureFilterMode::Linear;
+	params.wrapS = E_TextureWrapMode::ClampToEdge;
+	params.wrapT = E_TextureWrapMode::ClampToEdge;
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+	api->SetPixelUnpackAlignment(1);
+
+	TextureData* const texture = new TextureData(ivec2(static_cast<int32>(header.atlasWidth), static_cast<int32>(header.atlasHeight)), 
+		E_ColorFormat::RGBA8, 
+		E_ColorFormat::RGBA, 
+		E_DataType::UByte);
+	texture->Build(const_cast<uint8*>(raw));
+	texture->SetParameters(params);
+	pFont->m_pTexture = texture;
+
+	api->SetPixelUnpackAlignment(4);
+
+	return pFont;
+}
+
 
 } // namespace render
 } // namespace et
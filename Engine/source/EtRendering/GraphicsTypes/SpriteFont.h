@@ -1,9 +1,15 @@
 #pragma once
+#include <utility>
+
 #include "TextureData.h"
+#include "FontEvents.h"
 
 #include <EtCore/Content/AssetPointer.h>
 
 
+struct FT_FaceRec_;
+
+
 namespace et {
 namespace render {
 
@@ -36,7 +42,7 @@ struct FontMetric
 
 	// spacing between characters
 	float AdvanceX = 0;
-	std::map<wchar_t, vec2> Kerning;
+	std::vector<std::pair<wchar_t, vec2>> Kerning; // sorted by the previous character
 
 	// addressing in texture
 	uint8 Page = 0;
@@ -109,11 +115,20 @@ private:
 // FontAsset
 //
 // Loadable Font Data
+//  - ttf fonts are either rasterized into an SDF atlas on the GPU at load time, or baked into a cooked font by the cooker
+//  - cooked fonts keep the ttf asset name and are recognized by their header
 //
 class FontAsset final : public core::Asset<SpriteFont, false>
 {
 	DECLARE_FORCED_LINKING()
 public:
+	// static functionality
+	//----------------------
+	static bool IsCookedFont(std::vector<uint8> const& data);
+	static void WriteCookedFont(SpriteFont const& font, ivec2 const atlasSize, std::vector<uint8> const& atlas, std::vector<uint8>& data);
+
+	static T_FontEventDispatcher& GetEventDispatcher();
+
 	// Construct destruct
 	//---------------------
 	FontAsset() : core::Asset<SpriteFont, false>() {}
@@ -122,10 +137,19 @@ public:
 	// Asset overrides
 	//---------------------
 	bool LoadFromMemory(std::vector<uint8> const& data) override;
+protected:
+	void UnloadInternal() override;
+
+public:
+
+	// utility
+	//---------
+	SpriteFont* LayoutGlyphs(FT_FaceRec_* const face, ivec2& atlasSize) const;
 
 private:
 	SpriteFont* LoadTtf(const std::vector<uint8>& binaryContent);
 	SpriteFont* LoadFnt(const std::vector<uint8>& binaryContent);
+	SpriteFont* LoadCooked(std::vector<uint8> const& data);
 
 	// Data
 	///////
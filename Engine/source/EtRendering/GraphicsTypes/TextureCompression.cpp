@@ -0,0 +1,416 @@
+#include "stdafx.h"
+#include "TextureCompression.h"
+
+
+namespace et {
+namespace render {
+
+
+namespace texture_compression {
+
+
+//---------------------------------
+// FitEndpoints
+//
+// Extremes of the block's texels along their principal axis, found by power iteration on the covariance matrix
+//
+void FitEndpoints(float const (&texels)[16][4], uint32 const channels, float (&low)[4], float (&high)[4])
+{
+	float mean[4] = { 0.f, 0.f, 0.f, 0.f };
+	for (uint32 texel = 0u; texel < 16u; ++texel)
+	{
+		for (uint32 channel = 0u; channel < channels; ++channel)
+		{
+			mean[channel] += texels[texel][channel] / 16.f;
+		}
+	}
+
+	float covariance[4][4] = {};
+	for (uint32 texel = 0u; texel < 16u; ++texel)
+	{
+		for (uint32 row = 0u; row < channels; ++row)
+		{
+			for (uint32 col = 0u; col < channels; ++col)
+			{
+				covariance[row][col] += (texels[texel][row] - mean[row]) * (texels[texel][col] - mean[col]);
+			}
+		}
+	}
+
+	float axis[4] = { 1.f, 1.f, 1.f, 1.f };
+	for (uint32 iteration = 0u; iteration < 8u; ++iteration)
+	{
+		float next[4] = { 0.f, 0.f, 0.f, 0.f };
+		float length = 0.f;
+		for (uint32 row = 0u; row < channels; ++row)
+		{
+			for (uint32 col = 0u; col < channels; ++col)
+			{
+				next[row] += covariance[row][col] * axis[col];
+			}
+
+			length = std::max(length, std::abs(next[row]));
+		}
+
+		if (length <= 0.f)
+		{
+			break; // uniform block, any axis works
+		}
+
+		for (uint32 channel = 0u; channel < channels; ++channel)
+		{
+			axis[channel] = next[channel] / length;
+		}
+	}
+
+	float minProjection = std::numeric_limits<float>::max();
+	float maxProjection = -std::numeric_limits<float>::max();
+	for (uint32 texel = 0u; texel < 16u; ++texel)
+	{
+		float projection = 0.f;
+		for (uint32 channel = 0u; channel < channels; ++channel)
+		{
+			projection += (texels[texel][channel] - mean[channel]) * axis[channel];
+		}
+
+		minProjection = std::min(minProjection, projection);
+		maxProjection = std::max(maxProjection, projection);
+	}
+
+	float axisLengthSq = 0.f;
+	for (uint32 channel = 0u; channel < channels; ++channel)
+	{
+		axisLengthSq += axis[channel] * axis[channel];
+	}
+
+	float const scale = (axisLengthSq > 0.f) ? (1.f / axisLengthSq) : 0.f;
+	for (uint32 channel = 0u; channel < channels; ++channel)
+	{
+		low[channel] = math::Clamp(mean[channel] + axis[channel] * minProjection * scale, 255.f, 0.f);
+		high[channel] = math::Clamp(mean[channel] + axis[channel] * maxProjection * scale, 255.f, 0.f);
+	}
+}
+
+//---------------------------------
+// CompressBC1Block
+//
+// Opaque 4 color block with 565 endpoints, writes 8 bytes
+//  - endpoints are always ordered for 4 color mode so the block decodes the same as the color part of BC3
+//
+void CompressBC1Block(float const (&texels)[16][4], uint8* const output)
+{
+	float low[4];
+	float high[4];
+	FitEndpoints(texels, 3u, low, high);
+
+	auto to565 = [](float const (&color)[4]) -> uint16
+		{
+			uint16 const r = static_cast<uint16>(color[0] * 31.f / 255.f + 0.5f);
+			uint16 const g = static_cast<uint16>(color[1] * 63.f / 255.f + 0.5f);
+			uint16 const b = static_cast<uint16>(color[2] * 31.f / 255.f + 0.5f);
+			return static_cast<uint16>((r << 11u) | (g << 5u) | b);
+		};
+
+	auto from565 = [](uint16 const packed, float (&color)[4])
+		{
+			color[0] = static_cast<float>(((packed >> 11u) & 31u) * 255u / 31u);
+			color[1] = static_cast<float>(((packed >> 5u) & 63u) * 255u / 63u);
+			color[2] = static_cast<float>((packed & 31u) * 255u / 31u);
+		};
+
+	uint16 color0 = to565(high);
+	uint16 color1 = to565(low);
+	if (color0 < color1)
+	{
+		std::swap(color0, color1);
+	}
+
+	uint32 indices = 0u;
+	if (color0 != color1)
+	{
+		float palette[4][4];
+		from565(color0, palette[0]);
+		from565(color1, palette[1]);
+		for (uint32 channel = 0u; channel < 3u; ++channel)
+		{
+			palette[2][channel] = (2.f * palette[0][channel] + palette[1][channel]) / 3.f;
+			palette[3][channel] = (palette[0][channel] + 2.f * palette[1][channel]) / 3.f;
+		}
+
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			uint32 best = 0u;
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32 entry = 0u; entry < 4u; ++entry)
+			{
+				float error = 0.f;
+				for (uint32 channel = 0u; channel < 3u; ++channel)
+				{
+					float const delta = texels[texel][channel] - palette[entry][channel];
+					error += delta * delta;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					best = entry;
+				}
+			}
+
+			indices |= best << (texel * 2u);
+		}
+	}
+
+	memcpy(output, &color0, sizeof(uint16));
+	memcpy(output + 2u, &color1, sizeof(uint16));
+	memcpy(output + 4u, &indices, sizeof(uint32));
+}
+
+//---------------------------------
+// CompressBC4Block
+//
+// Single channel block with 8 interpolated values, writes 8 bytes
+//
+void CompressBC4Block(float const (&texels)[16][4], uint32 const channel, uint8* const output)
+{
+	float minValue = 255.f;
+	float maxValue = 0.f;
+	for (uint32 texel = 0u; texel < 16u; ++texel)
+	{
+		minValue = std::min(minValue, texels[texel][channel]);
+		maxValue = std::max(maxValue, texels[texel][channel]);
+	}
+
+	uint8 const value0 = static_cast<uint8>(maxValue + 0.5f);
+	uint8 const value1 = static_cast<uint8>(minValue + 0.5f);
+
+	uint64 indices = 0u;
+	if (value0 != value1)
+	{
+		float palette[8];
+		palette[0] = static_cast<float>(value0);
+		palette[1] = static_cast<float>(value1);
+		for (uint32 entry = 1u; entry < 7u; ++entry)
+		{
+			palette[entry + 1u] = (static_cast<float>(7u - entry) * palette[0] + static_cast<float>(entry) * palette[1]) / 7.f;
+		}
+
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			uint64 best = 0u;
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32 entry = 0u; entry < 8u; ++entry)
+			{
+				float const error = std::abs(texels[texel][channel] - palette[entry]);
+				if (error < bestError)
+				{
+					bestError = error;
+					best = static_cast<uint64>(entry);
+				}
+			}
+
+			indices |= best << (texel * 3u);
+		}
+	}
+
+	output[0] = value0;
+	output[1] = value1;
+	for (uint32 byteIdx = 0u; byteIdx < 6u; ++byteIdx)
+	{
+		output[2u + byteIdx] = static_cast<uint8>((indices >> (byteIdx * 8u)) & 0xFFu);
+	}
+}
+
+//---------------------------------
+// CompressBC7Block
+//
+// RGBA block in mode 6 - a single subset with 7 bit endpoints plus a shared bit per endpoint and 16 interpolated values, writes 16 bytes
+//  - endpoints are fit along the principal axis, then refined once by least squares on the chosen indices
+//
+void CompressBC7Block(float const (&texels)[16][4], uint8* const output)
+{
+	static uint32 const s_Weights[16] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+	// quantize an endpoint to 7 bits per channel and the p bit that fits it best
+	auto quantize = [](float const (&endpoint)[4], uint32 (&quantized)[4], uint32& pBit)
+		{
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32 p = 0u; p < 2u; ++p)
+			{
+				uint32 candidate[4];
+				float error = 0.f;
+				for (uint32 channel = 0u; channel < 4u; ++channel)
+				{
+					float const value = (endpoint[channel] - static_cast<float>(p)) * 0.5f + 0.5f;
+					candidate[channel] = static_cast<uint32>(math::Clamp(value, 127.f, 0.f));
+
+					float const delta = static_cast<float>((candidate[channel] << 1u) | p) - endpoint[channel];
+					error += delta * delta;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					pBit = p;
+					std::copy(candidate, candidate + 4, quantized);
+				}
+			}
+		};
+
+	// pick the closest interpolated value for each texel, returns the total squared error
+	auto assignIndices = [](float const (&texels)[16][4], uint32 const (&e0)[4], uint32 const (&e1)[4], uint32 (&indices)[16]) -> float
+		{
+			float palette[16][4];
+			for (uint32 entry = 0u; entry < 16u; ++entry)
+			{
+				for (uint32 channel = 0u; channel < 4u; ++channel)
+				{
+					palette[entry][channel] = static_cast<float>(((64u - s_Weights[entry]) * e0[channel] + s_Weights[entry] * e1[channel] + 32u) >> 6u);
+				}
+			}
+
+			float totalError = 0.f;
+			for (uint32 texel = 0u; texel < 16u; ++texel)
+			{
+				float bestError = std::numeric_limits<float>::max();
+				for (uint32 entry = 0u; entry < 16u; ++entry)
+				{
+					float error = 0.f;
+					for (uint32 channel = 0u; channel < 4u; ++channel)
+					{
+						float const delta = texels[texel][channel] - palette[entry][channel];
+						error += delta * delta;
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						indices[texel] = entry;
+					}
+				}
+
+				totalError += bestError;
+			}
+
+			return totalError;
+		};
+
+	auto encode = [&quantize, &assignIndices, &texels](float const (&low)[4], float const (&high)[4],
+		uint32 (&e0)[4], uint32 (&e1)[4], uint32 (&p)[2], uint32 (&indices)[16]) -> float
+		{
+			uint32 q0[4];
+			uint32 q1[4];
+			quantize(low, q0, p[0]);
+			quantize(high, q1, p[1]);
+			for (uint32 channel = 0u; channel < 4u; ++channel)
+			{
+				e0[channel] = (q0[channel] << 1u) | p[0];
+				e1[channel] = (q1[channel] << 1u) | p[1];
+			}
+
+			return assignIndices(texels, e0, e1, indices);
+		};
+
+	float low[4];
+	float high[4];
+	FitEndpoints(texels, 4u, low, high);
+
+	uint32 e0[4];
+	uint32 e1[4];
+	uint32 p[2];
+	uint32 indices[16];
+	float error = encode(low, high, e0, e1, p, indices);
+
+	// least squares endpoints for the chosen weights
+	{
+		float aa = 0.f;
+		float bb = 0.f;
+		float ab = 0.f;
+		float ax[4] = { 0.f, 0.f, 0.f, 0.f };
+		float bx[4] = { 0.f, 0.f, 0.f, 0.f };
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			float const b = static_cast<float>(s_Weights[indices[texel]]) / 64.f;
+			float const a = 1.f - b;
+
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+			for (uint32 channel = 0u; channel < 4u; ++channel)
+			{
+				ax[channel] += a * texels[texel][channel];
+				bx[channel] += b * texels[texel][channel];
+			}
+		}
+
+		float const determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) > 1e-6f)
+		{
+			float refinedLow[4];
+			float refinedHigh[4];
+			for (uint32 channel = 0u; channel < 4u; ++channel)
+			{
+				refinedLow[channel] = math::Clamp((ax[channel] * bb - bx[channel] * ab) / determinant, 255.f, 0.f);
+				refinedHigh[channel] = math::Clamp((bx[channel] * aa - ax[channel] * ab) / determinant, 255.f, 0.f);
+			}
+
+			uint32 refinedE0[4];
+			uint32 refinedE1[4];
+			uint32 refinedP[2];
+			uint32 refinedIndices[16];
+			float const refinedError = encode(refinedLow, refinedHigh, refinedE0, refinedE1, refinedP, refinedIndices);
+			if (refinedError < error)
+			{
+				std::copy(refinedE0, refinedE0 + 4, e0);
+				std::copy(refinedE1, refinedE1 + 4, e1);
+				std::copy(refinedP, refinedP + 2, p);
+				std::copy(refinedIndices, refinedIndices + 16, indices);
+			}
+		}
+	}
+
+	// the anchor index is stored without its top bit
+	if (indices[0] >= 8u)
+	{
+		std::swap(e0, e1);
+		std::swap(p[0], p[1]);
+		for (uint32& index : indices)
+		{
+			index = 15u - index;
+		}
+	}
+
+	// mode 6 layout, least significant bit first
+	uint64 bits[2] = { 0u, 0u };
+	uint32 position = 0u;
+	auto write = [&bits, &position](uint32 const value, uint32 const count)
+		{
+			for (uint32 bit = 0u; bit < count; ++bit, ++position)
+			{
+				bits[position / 64u] |= static_cast<uint64>((value >> bit) & 1u) << (position % 64u);
+			}
+		};
+
+	write(1u << 6u, 7u);
+	for (uint32 channel = 0u; channel < 4u; ++channel)
+	{
+		write(e0[channel] >> 1u, 7u);
+		write(e1[channel] >> 1u, 7u);
+	}
+
+	write(p[0], 1u);
+	write(p[1], 1u);
+	for (uint32 texel = 0u; texel < 16u; ++texel)
+	{
+		write(indices[texel], (texel == 0u) ? 3u : 4u);
+	}
+
+	memcpy(output, bits, sizeof(bits));
+}
+
+
+} // namespace texture_compression
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,26 @@
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// texture_compression
+//
+// Block compression of 8 bit texels on the CPU, used by the cooker to write compressed mip levels
+//  - blocks are 4x4 texels in row order, with channels in the [0, 255] range
+//  - channels a format doesn't store are ignored
+//
+namespace texture_compression {
+
+	void FitEndpoints(float const (&texels)[16][4], uint32 const channels, float (&low)[4], float (&high)[4]);
+	void CompressBC1Block(float const (&texels)[16][4], uint8* const output);
+	void CompressBC4Block(float const (&texels)[16][4], uint32 const channel, uint8* const output);
+	void CompressBC7Block(float const (&texels)[16][4], uint8* const output);
+
+} // namespace texture_compression
+
+
+} // namespace render
+} // namespace et
@@ -8,6 +8,8 @@
 
 #include <EtRendering/GlobalRenderingSystems/GlobalRenderingSystems.h>
 
+#include "TextureDataStructure.h"
+
 
 namespace et {
 namespace render {
@@ -18,6 +20,75 @@ namespace render {
 //==============
 
 
+//---------------------------------
+// TextureData::IsCompressedFormat
+//
+bool TextureData::IsCompressedFormat(E_ColorFormat const format)
+{
+	switch (format)
+	{
+	case E_ColorFormat::BC1_RGB:
+	case E_ColorFormat::BC1_SRGB:
+	case E_ColorFormat::BC3_RGBA:
+	case E_ColorFormat::BC3_SRGBA:
+	case E_ColorFormat::BC5_RG:
+	case E_ColorFormat::BC7_RGBA:
+	case E_ColorFormat::BC7_SRGBA:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+//---------------------------------
+// TextureData::GetMipResolution
+//
+// Each level halves the resolution of the previous one, rounding down and never below one texel
+//
+ivec2 TextureData::GetMipResolution(ivec2 const res, uint8 const mipLevel)
+{
+	return ivec2(std::max(res.x >> mipLevel, 1), std::max(res.y >> mipLevel, 1));
+}
+
+//---------------------------------
+// TextureData::GetMipSize
+//
+// Bytes in a level of unsigned byte texels - block compressed formats store 4x4 texel blocks, and pad partial blocks at the edges
+//
+size_t TextureData::GetMipSize(E_ColorFormat const internalFormat, E_ColorFormat const format, ivec2 const res)
+{
+	size_t const blocks = static_cast<size_t>((res.x + 3) / 4) * static_cast<size_t>((res.y + 3) / 4);
+
+	switch (internalFormat)
+	{
+	case E_ColorFormat::BC1_RGB:
+	case E_ColorFormat::BC1_SRGB:
+		return blocks * 8u;
+
+	case E_ColorFormat::BC3_RGBA:
+	case E_ColorFormat::BC3_SRGBA:
+	case E_ColorFormat::BC5_RG:
+	case E_ColorFormat::BC7_RGBA:
+	case E_ColorFormat::BC7_SRGBA:
+		return blocks * 16u;
+
+	default:
+		break;
+	}
+
+	size_t channels = 4u;
+	switch (format)
+	{
+	case E_ColorFormat::Red: channels = 1u; break;
+	case E_ColorFormat::RG: channels = 2u; break;
+	case E_ColorFormat::RGB: channels = 3u; break;
+	default: break;
+	}
+
+	return static_cast<size_t>(res.x) * static_cast<size_t>(res.y) * channels;
+}
+
 //---------------------------------
 // TextureData::c-tor
 //
@@ -65,6 +136,50 @@ TextureData::~TextureData()
 	api->DeleteTexture(m_Location);
 }
 
+//---------------------------------
+// TextureData::GetLevelDataSize
+//
+// Bytes of an uncompressed mip level in the layout graphics contexts read and write with GetTextureData and SetTextureMipData
+//  - layers of 3D textures and faces of cube maps follow each other, cube maps are always exchanged as RGB half floats
+//
+size_t TextureData::GetLevelDataSize(uint8 const mipLevel) const
+{
+	ET_ASSERT(!IsCompressedFormat(m_Internal));
+
+	ivec2 const res = GetMipResolution(m_Resolution, mipLevel);
+	size_t const texels = static_cast<size_t>(res.x) * static_cast<size_t>(res.y);
+
+	if (m_TargetType == E_TextureType::CubeMap)
+	{
+		return texels * static_cast<size_t>(s_NumCubeFaces) * 3u * 2u;
+	}
+
+	size_t channels = 4u;
+	switch (m_Format)
+	{
+	case E_ColorFormat::Depth:
+	case E_ColorFormat::Red: channels = 1u; break;
+	case E_ColorFormat::DepthStencil:
+	case E_ColorFormat::RG: channels = 2u; break;
+	case E_ColorFormat::RGB: channels = 3u; break;
+	default: break;
+	}
+
+	size_t channelSize = 4u;
+	switch (m_DataType)
+	{
+	case E_DataType::Byte:
+	case E_DataType::UByte: channelSize = 1u; break;
+	case E_DataType::Short:
+	case E_DataType::UShort:
+	case E_DataType::Half: channelSize = 2u; break;
+	case E_DataType::Double: channelSize = 8u; break;
+	default: break;
+	}
+
+	return texels * static_cast<size_t>(std::max(m_Depth >> mipLevel, 1)) * channels * channelSize;
+}
+
 //---------------------------------
 // TextureData::Build
 //
@@ -77,6 +192,30 @@ void TextureData::Build(void* data)
 	Viewport::GetCurrentApiContext()->SetTextureData(*this, data);
 }
 
+//---------------------------------
+// TextureData::BuildMipChain
+//
+// Upload prebuilt mip levels starting at the textures resolution, parameters set afterwards won't regenerate them
+//  - rows of small uncompressed levels aren't aligned to 4 bytes, so they are unpacked tightly
+//
+void TextureData::BuildMipChain(std::vector<MipLevel> const& levels)
+{
+	ET_ASSERT(m_Handle == 0u, "Shouldn't build after a handle was created!");
+	ET_ASSERT(!levels.empty());
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	api->SetPixelUnpackAlignment(1);
+	for (size_t levelIdx = 0u; levelIdx < levels.size(); ++levelIdx)
+	{
+		api->SetTextureMipData(*this, static_cast<uint8>(levelIdx), levels[levelIdx].data, levels[levelIdx].size);
+	}
+
+	api->SetPixelUnpackAlignment(4);
+
+	m_MipLevels = static_cast<uint8>(levels.size());
+}
+
 //---------------------------------
 // TextureData::SetParameters
 //
@@ -155,9 +294,17 @@ void TextureData::CreateHandle()
 // reflection
 RTTR_REGISTRATION
 {
+	rttr::registration::enumeration<E_TextureCompression>("E_TextureCompression") (
+		rttr::value("None", E_TextureCompression::None),
+		rttr::value("BC1", E_TextureCompression::BC1),
+		rttr::value("BC3", E_TextureCompression::BC3),
+		rttr::value("BC5", E_TextureCompression::BC5),
+		rttr::value("BC7", E_TextureCompression::BC7));
+
 	BEGIN_REGISTER_POLYMORPHIC_CLASS(TextureAsset, "texture asset")
 		.property("use SRGB", &TextureAsset::m_UseSrgb)
 		.property("force resolution", &TextureAsset::m_ForceResolution)
+		.property("compression", &TextureAsset::m_Compression)
 		.property("parameters", &TextureAsset::m_Parameters)
 	END_REGISTER_POLYMORPHIC_CLASS(TextureAsset, core::I_Asset);
 }
@@ -171,6 +318,18 @@ DEFINE_FORCED_LINKING(TextureAsset) // force the shader class to be linked as it
 //
 bool TextureAsset::LoadFromMemory(std::vector<uint8> const& data)
 {
+	if (IsCookedTexture(data))
+	{
+		m_Data = LoadCooked(data);
+		if (m_Data == nullptr)
+		{
+			LOG("TextureAsset::LoadFromMemory > Failed to load cooked texture!", core::LogLevel::Warning);
+			return false;
+		}
+
+		return true;
+	}
+
 	// check image format
 
 	stbi_set_flip_vertically_on_load(false);
@@ -232,5 +391,136 @@ bool TextureAsset::LoadFromMemory(std::vector<uint8> const& data)
 }
 
 
+//---------------------------------
+// TextureAsset::IsCookedTexture
+//
+bool TextureAsset::IsCookedTexture(std::vector<uint8> const& data)
+{
+	if (data.size() < sizeof(TextureFileHeader))
+	{
+		return false;
+	}
+
+	uint32 magic;
+	memcpy(&magic, data.data(), sizeof(uint32));
+	return (magic == TextureFileHeader::s_Magic);
+}
+
+//---------------------------------
+// TextureAsset::WriteCookedTexture
+//
+// Serialize a mip chain into the layout described in TextureDataStructure.h
+//
+void TextureAsset::WriteCookedTexture(ivec2 const res,
+	E_ColorFormat const internalFormat,
+	E_ColorFormat const format,
+	std::vector<std::vector<uint8>> const& levels,
+	std::vector<uint8>& data)
+{
+	TextureFileHeader header;
+	header.magic = TextureFileHeader::s_Magic;
+	header.version = TextureFileHeader::s_Version;
+	header.width = static_cast<uint32>(res.x);
+	header.height = static_cast<uint32>(res.y);
+	header.internalFormat = static_cast<uint8>(internalFormat);
+	header.format = static_cast<uint8>(format);
+	header.levelCount = static_cast<uint8>(levels.size());
+	header.reserved = 0u;
+
+	size_t const tableSize = sizeof(TextureFileHeader) + levels.size() * sizeof(TextureFileLevel);
+
+	size_t totalSize = tableSize;
+	for (std::vector<uint8> const& level : levels)
+	{
+		totalSize += level.size();
+	}
+
+	data.resize(totalSize);
+	memcpy(data.data(), &header, sizeof(TextureFileHeader));
+
+	// smallest levels first
+	size_t offset = tableSize;
+	for (size_t levelIdx = levels.size(); levelIdx-- > 0u;)
+	{
+		std::vector<uint8> const& level = levels[levelIdx];
+
+		TextureFileLevel const fileLevel{ static_cast<uint64>(offset), static_cast<uint64>(level.size()) };
+		memcpy(data.data() + sizeof(TextureFileHeader) + levelIdx * sizeof(TextureFileLevel), &fileLevel, sizeof(TextureFileLevel));
+
+		memcpy(data.data() + offset, level.data(), level.size());
+		offset += level.size();
+	}
+}
+
+//---------------------------------
+// TextureAsset::LoadCooked
+//
+// Uploads the mip chain of a texture written by the cooker without decoding it
+//  - instead of resampling, the texture scale factor drops the largest levels - each halving of the scale skips one
+//
+TextureData* TextureAsset::LoadCooked(std::vector<uint8> const& data)
+{
+	TextureFileHeader header;
+	memcpy(&header, data.data(), sizeof(TextureFileHeader));
+
+	if (header.version != TextureFileHeader::s_Version)
+	{
+		LOG(FS("TextureAsset::LoadCooked > Unsupported cooked texture version %u, expected %u", header.version, TextureFileHeader::s_Version),
+			core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	if ((header.levelCount == 0u) || (header.width == 0u) || (header.height == 0u))
+	{
+		LOG("TextureAsset::LoadCooked > Cooked texture is empty", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	if (data.size() < sizeof(TextureFileHeader) + header.levelCount * sizeof(TextureFileLevel))
+	{
+		LOG("TextureAsset::LoadCooked > Cooked texture data is truncated", core::LogLevel::Warning);
+		return nullptr;
+	}
+
+	E_ColorFormat const internalFormat = static_cast<E_ColorFormat>(header.internalFormat);
+	E_ColorFormat const format = static_cast<E_ColorFormat>(header.format);
+	ivec2 const fullRes(static_cast<int32>(header.width), static_cast<int32>(header.height));
+
+	// levels to skip
+	uint8 firstLevel = 0u;
+	render::GraphicsSettings const& graphicsSettings = RenderingSystems::Instance()->GetGraphicsSettings();
+	if (!m_ForceResolution && (graphicsSettings.TextureScaleFactor < 1.f) && (graphicsSettings.TextureScaleFactor > 0.f))
+	{
+		float const skipped = std::floor(-std::log2(graphicsSettings.TextureScaleFactor) + 0.5f);
+		firstLevel = static_cast<uint8>(std::min(skipped, static_cast<float>(header.levelCount - 1u)));
+	}
+
+	std::vector<TextureData::MipLevel> levels;
+	for (uint8 levelIdx = firstLevel; levelIdx < header.levelCount; ++levelIdx)
+	{
+		TextureFileLevel fileLevel;
+		memcpy(&fileLevel, data.data() + sizeof(TextureFileHeader) + levelIdx * sizeof(TextureFileLevel), sizeof(TextureFileLevel));
+
+		ivec2 const res = TextureData::GetMipResolution(fullRes, levelIdx);
+		if ((fileLevel.size != static_cast<uint64>(TextureData::GetMipSize(internalFormat, format, res))) 
+			|| (fileLevel.offset + fileLevel.size > static_cast<uint64>(data.size())))
+		{
+			LOG(FS("TextureAsset::LoadCooked > Invalid mip level %u", static_cast<uint32>(levelIdx)), core::LogLevel::Warning);
+			return nullptr;
+		}
+
+		levels.push_back(TextureData::MipLevel{ data.data() + fileLevel.offset, static_cast<size_t>(fileLevel.size) });
+	}
+
+	TextureData* const texture = new TextureData(TextureData::GetMipResolution(fullRes, firstLevel), internalFormat, format, E_DataType::UByte);
+	texture->BuildMipChain(levels);
+	texture->SetParameters(m_Parameters);
+
+	texture->CreateHandle();
+
+	return texture;
+}
+
+
 } // namespace render
 } // namespace et
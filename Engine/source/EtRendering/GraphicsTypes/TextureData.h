@@ -22,6 +22,23 @@ public:
 	// definitions
 	static constexpr uint8 s_NumCubeFaces = 6u;
 
+	//---------------------------------
+	// TextureData::MipLevel
+	//
+	// Prebuilt data of a single level, block compressed if the internal format is
+	//
+	struct MipLevel
+	{
+		uint8 const* data;
+		size_t size;
+	};
+
+	// static functionality
+	//----------------------
+	static bool IsCompressedFormat(E_ColorFormat const format);
+	static ivec2 GetMipResolution(ivec2 const res, uint8 const mipLevel);
+	static size_t GetMipSize(E_ColorFormat const internalFormat, E_ColorFormat const format, ivec2 const res);
+
 	// c-tor d-tor
 	//------------
 	TextureData(ivec2 const res, E_ColorFormat const intern, E_ColorFormat const format, E_DataType const type, int32 const depth = 1);
@@ -42,9 +59,12 @@ public:
 	E_TextureType GetTargetType() const { return m_TargetType; }
 	int32 GetDepth() const { return m_Depth; }
 
+	size_t GetLevelDataSize(uint8 const mipLevel) const;
+
 	// Functionality
 	//--------------
 	void Build(void* data = nullptr);
+	void BuildMipChain(std::vector<MipLevel> const& levels);
 	void SetParameters(TextureParameters const& params, bool const force = false);
 	bool Resize(ivec2 const& newSize);
 	void CreateHandle();
@@ -73,15 +93,41 @@ private:
 };
 
 
+//---------------------------------
+// E_TextureCompression
+//
+// Block compression the cooker applies to a texture
+//
+enum class E_TextureCompression : uint8
+{
+	None,
+	BC1, // RGB, 4 bits per texel
+	BC3, // RGBA, 8 bits per texel
+	BC5, // RG, 8 bits per texel - e.g. normal maps that reconstruct z
+	BC7 // RGBA, 8 bits per texel with a higher quality than BC3
+};
+
+
 //---------------------------------
 // TextureAsset
 //
 // Loadable Texture Data
+//  - source images are decoded at load time, and the GPU generates their mip maps
+//  - cooked textures contain their mip chain and are uploaded as they are, the texture scale factor skips their largest levels
 //
 class TextureAsset final : public core::Asset<TextureData, false>
 {
 	DECLARE_FORCED_LINKING()
 public:
+	// static functionality
+	//----------------------
+	static bool IsCookedTexture(std::vector<uint8> const& data);
+	static void WriteCookedTexture(ivec2 const res,
+		E_ColorFormat const internalFormat,
+		E_ColorFormat const format,
+		std::vector<std::vector<uint8>> const& levels,
+		std::vector<uint8>& data);
+
 	// Construct destruct
 	//---------------------
 	TextureAsset() : core::Asset<TextureData, false>() {}
@@ -91,11 +137,15 @@ public:
 	//---------------------
 	bool LoadFromMemory(std::vector<uint8> const& data) override;
 
+private:
+	TextureData* LoadCooked(std::vector<uint8> const& data);
+
 	// Data
 	///////
 public:
 	bool m_UseSrgb = false;
 	bool m_ForceResolution = false;
+	E_TextureCompression m_Compression = E_TextureCompression::None; // only applied by the cooker
 	TextureParameters m_Parameters;
 
 	RTTR_ENABLE(core::Asset<TextureData, false>)
@@ -0,0 +1,45 @@
+// Data structures for the layout of a cooked texture
+
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// TextureFileHeader
+//
+// Start of a cooked texture, followed by:
+//  - levelCount TextureFileLevel entries, from the full resolution level to the smallest one
+//  - the data of each level, stored from the smallest level to the largest so that coarse levels come first when reading in order
+//
+struct TextureFileHeader
+{
+	static uint32 const s_Magic = 0x58544554u; // "ETTX"
+	static uint32 const s_Version = 1u;
+
+	uint32 magic;
+	uint32 version;
+	uint32 width; // of the first level
+	uint32 height;
+	uint8 internalFormat; // E_ColorFormat, either block compressed or matching format
+	uint8 format; // E_ColorFormat channel layout, texels are unsigned bytes
+	uint8 levelCount;
+	uint8 reserved;
+};
+
+//---------------------------------
+// TextureFileLevel
+//
+// Location of a mip level's data, the offset is from the start of the cooked texture
+//
+struct TextureFileLevel
+{
+	uint64 offset;
+	uint64 size;
+};
+
+
+} // namespace render
+} // namespace et
@@ -56,12 +56,11 @@ uint16 DataTypeInfo::GetTypeSize(E_DataType const dataType)
 // static definition for how vertex data should be laid out in a shader and mesh
 std::map<E_VertexFlag, AttributeDescriptor const> const AttributeDescriptor::s_VertexAttributes =
 {
-	{ E_VertexFlag::POSITION,	{ "position",	E_DataType::Float, 3 } },
-	{ E_VertexFlag::NORMAL,		{ "normal",		E_DataType::Float, 3 } },
-	{ E_VertexFlag::BINORMAL,	{ "binormal",	E_DataType::Float, 3 } },
-	{ E_VertexFlag::TANGENT,	{ "tangent",	E_DataType::Float, 3 } },
-	{ E_VertexFlag::COLOR,		{ "color",		E_DataType::Float, 3 } },
-	{ E_VertexFlag::TEXCOORD,	{ "texcoord",	E_DataType::Float, 2 } }
+	{ E_VertexFlag::POSITION,	{ "position",	E_DataType::Float,	3, false } },
+	{ E_VertexFlag::NORMAL,		{ "normal",		E_DataType::Short,	2, true } },	// octahedral
+	{ E_VertexFlag::TANGENT,	{ "tangent",	E_DataType::Short,	2, true } },	// octahedral, bitangent sign in y
+	{ E_VertexFlag::COLOR,		{ "color",		E_DataType::UByte,	4, true } },
+	{ E_VertexFlag::TEXCOORD,	{ "texcoord",	E_DataType::Half,	2, false } }
 };
 
 
@@ -146,7 +145,7 @@ void AttributeDescriptor::DefineAttributeArray(T_VertexFlags const flags, std::v
 			api->DefineVertexAttributePointer(locations[locationIdx],
 				it->second.dataCount,
 				it->second.dataType,
-				false,
+				it->second.normalized,
 				stride,
 				static_cast<size_t>(startPos));
 
@@ -185,7 +184,7 @@ void AttributeDescriptor::DefineAttributeArray(T_VertexFlags const supportedFlag
 				api->DefineVertexAttributePointer(locations[locationIdx],
 					it->second.dataCount,
 					it->second.dataType,
-					false,
+					it->second.normalized,
 					stride,
 					static_cast<size_t>(startPos));
 
@@ -227,5 +226,203 @@ bool AttributeDescriptor::GetVertexFlag(AttributeDescriptor const& desc, E_Verte
 }
 
 
+//================
+// Vertex Packing
+//================
+
+
+namespace vertex_packing {
+
+
+//---------------------------------
+// EncodeOctahedral
+//
+// Project a unit vector onto an octahedron and unfold it into [-1, 1]^2
+//
+vec2 EncodeOctahedral(vec3 const& direction)
+{
+	float const l1 = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+	if (l1 <= 0.f)
+	{
+		return vec2(0.f);
+	}
+
+	vec2 encoded(direction.x / l1, direction.y / l1);
+	if (direction.z < 0.f)
+	{
+		vec2 const folded(1.f - std::abs(encoded.y), 1.f - std::abs(encoded.x));
+		encoded = vec2((encoded.x >= 0.f) ? folded.x : -folded.x, (encoded.y >= 0.f) ? folded.y : -folded.y);
+	}
+
+	return encoded;
+}
+
+//---------------------------------
+// DecodeOctahedral
+//
+vec3 DecodeOctahedral(vec2 const& encoded)
+{
+	vec3 direction(encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y));
+	if (direction.z < 0.f)
+	{
+		vec2 const folded(1.f - std::abs(direction.y), 1.f - std::abs(direction.x));
+		direction.x = (direction.x >= 0.f) ? folded.x : -folded.x;
+		direction.y = (direction.y >= 0.f) ? folded.y : -folded.y;
+	}
+
+	return math::normalize(direction);
+}
+
+//---------------------------------
+// EncodeTangent
+//
+// Octahedral tangent with the bitangent sign as the sign of y, which is remapped to [0.5, 1] so it is never zero
+//
+vec2 EncodeTangent(vec3 const& tangent, float const bitangentSign)
+{
+	vec2 const encoded = EncodeOctahedral(tangent);
+	float const y = encoded.y * 0.25f + 0.75f;
+	return vec2(encoded.x, (bitangentSign < 0.f) ? -y : y);
+}
+
+//---------------------------------
+// DecodeTangent
+//
+// Tangent in xyz, bitangent sign in w
+//
+vec4 DecodeTangent(vec2 const& encoded)
+{
+	float const sign = (encoded.y < 0.f) ? -1.f : 1.f;
+	vec3 const tangent = DecodeOctahedral(vec2(encoded.x, (std::abs(encoded.y) - 0.75f) * 4.f));
+	return vec4(tangent, sign);
+}
+
+//---------------------------------
+// PackSnorm16
+//
+int16 PackSnorm16(float const value)
+{
+	return static_cast<int16>(std::round(math::Clamp(value, 1.f, -1.f) * 32767.f));
+}
+
+//---------------------------------
+// UnpackSnorm16
+//
+// Matches how the graphics API converts normalized signed integers
+//
+float UnpackSnorm16(int16 const value)
+{
+	return std::max(static_cast<float>(value) / 32767.f, -1.f);
+}
+
+//---------------------------------
+// PackUnorm8
+//
+uint8 PackUnorm8(float const value)
+{
+	return static_cast<uint8>(std::round(math::Clamp01(value) * 255.f));
+}
+
+//---------------------------------
+// PackHalf
+//
+// IEEE 754 half precision with round to nearest even, values out of range become infinity
+//
+uint16 PackHalf(float const value)
+{
+	uint32 bits;
+	memcpy(&bits, &value, sizeof(float));
+
+	uint16 const sign = static_cast<uint16>((bits >> 16u) & 0x8000u);
+	uint32 const exponent = (bits >> 23u) & 0xFFu;
+	uint32 mantissa = bits & 0x7FFFFFu;
+
+	if (exponent == 0xFFu) // inf or nan
+	{
+		return static_cast<uint16>(sign | 0x7C00u | ((mantissa != 0u) ? 0x200u : 0u));
+	}
+
+	int32 const halfExponent = static_cast<int32>(exponent) - 127 + 15;
+	if (halfExponent >= 31) // overflow
+	{
+		return static_cast<uint16>(sign | 0x7C00u);
+	}
+
+	if (halfExponent <= 0) // subnormal or zero
+	{
+		if (halfExponent < -10)
+		{
+			return sign;
+		}
+
+		mantissa |= 0x800000u;
+		uint32 const shift = static_cast<uint32>(14 - halfExponent);
+		uint32 halfMantissa = mantissa >> shift;
+		uint32 const remainder = mantissa & ((1u << shift) - 1u);
+		uint32 const halfway = 1u << (shift - 1u);
+		if ((remainder > halfway) || ((remainder == halfway) && (halfMantissa & 1u)))
+		{
+			++halfMantissa;
+		}
+
+		return static_cast<uint16>(sign | halfMantissa);
+	}
+
+	uint32 half = (static_cast<uint32>(halfExponent) << 10u) | (mantissa >> 13u);
+	uint32 const remainder = mantissa & 0x1FFFu;
+	if ((remainder > 0x1000u) || ((remainder == 0x1000u) && (half & 1u)))
+	{
+		++half; // may carry into the exponent, which correctly rounds up to the next power of two or infinity
+	}
+
+	return static_cast<uint16>(sign | half);
+}
+
+//---------------------------------
+// UnpackHalf
+//
+float UnpackHalf(uint16 const value)
+{
+	uint32 const sign = static_cast<uint32>(value & 0x8000u) << 16u;
+	uint32 exponent = (value >> 10u) & 0x1Fu;
+	uint32 mantissa = value & 0x3FFu;
+
+	uint32 bits;
+	if (exponent == 0u)
+	{
+		if (mantissa == 0u)
+		{
+			bits = sign;
+		}
+		else // subnormal, normalize it
+		{
+			exponent = 127u - 15u + 1u;
+			while ((mantissa & 0x400u) == 0u)
+			{
+				mantissa <<= 1u;
+				--exponent;
+			}
+
+			bits = sign | (exponent << 23u) | ((mantissa & 0x3FFu) << 13u);
+		}
+	}
+	else if (exponent == 0x1Fu)
+	{
+		bits = sign | 0x7F800000u | (mantissa << 13u);
+	}
+	else
+	{
+		bits = sign | ((exponent + 127u - 15u) << 23u) | (mantissa << 13u);
+	}
+
+	float result;
+	memcpy(&result, &bits, sizeof(float));
+	return result;
+}
+
+
+} // namespace vertex_packing
+
+
 } // namespace render
 } // namespace et
@@ -34,12 +34,12 @@ typedef uint8 T_VertexFlags;
 // E_VertexFlag
 //
 // Bitflags specifying what vertex info should be present for mesh shaders
+//  - there is no binormal attribute, shaders reconstruct it from the normal and the tangent, which carries the bitangent sign
 //
 enum E_VertexFlag : T_VertexFlags
 {
 	POSITION = 1 << 0,
 	NORMAL   = 1 << 1,
-	BINORMAL = 1 << 2,
 	TANGENT  = 1 << 3,
 	COLOR    = 1 << 4,
 	TEXCOORD = 1 << 5
@@ -49,6 +49,7 @@ enum E_VertexFlag : T_VertexFlags
 // AttributeDescriptor
 //
 // Per vertex type data for automatic input layout definition
+//  - normalized integer attributes are converted to floats in [-1, 1] or [0, 1] when the shader reads them
 //
 struct AttributeDescriptor
 {
@@ -71,8 +72,33 @@ struct AttributeDescriptor
 	std::string name;
 	E_DataType dataType;
 	uint32 dataCount;
+	bool normalized = false;
 };
 
+//---------------------------------
+// vertex_packing
+//
+// Quantization of mesh attributes into the formats listed in AttributeDescriptor::s_VertexAttributes
+//  - unit vectors are stored octahedrally encoded in two snorm16 components, CommonVertex.glsl decodes them
+//
+namespace vertex_packing {
+
+	vec2 EncodeOctahedral(vec3 const& direction);
+	vec3 DecodeOctahedral(vec2 const& encoded);
+
+	vec2 EncodeTangent(vec3 const& tangent, float const bitangentSign);
+	vec4 DecodeTangent(vec2 const& encoded);
+
+	int16 PackSnorm16(float const value);
+	float UnpackSnorm16(int16 const value);
+
+	uint8 PackUnorm8(float const value);
+
+	uint16 PackHalf(float const value);
+	float UnpackHalf(uint16 const value);
+
+} // namespace vertex_packing
+
 
 } // namespace render
 } // namespace et
@@ -66,6 +66,11 @@ Material::Material(AssetPtr<ShaderData> const shader,
 			m_LayoutFlags |= it->first;
 		}
 	}
+
+	if (m_DefaultParameters != nullptr)
+	{
+		m_ParameterBuffer = m_Shader->CreateParameterBuffer(m_DefaultParameters);
+	}
 }
 
 //--------------------------
@@ -73,6 +78,11 @@ Material::Material(AssetPtr<ShaderData> const shader,
 //
 Material::~Material()
 {
+	if (m_ParameterBuffer != 0u)
+	{
+		Viewport::GetCurrentApiContext()->DeleteBuffer(m_ParameterBuffer);
+	}
+
 	if (m_DefaultParameters != nullptr)
 	{
 		parameters::DestroyBlock(m_DefaultParameters);
@@ -51,6 +51,7 @@ public:
 	//---------------------
 	Material const* GetBaseMaterial() const override { return this; }
 	T_ConstParameterBlock GetParameters() const override { return m_DefaultParameters; }
+	T_BufferLoc GetParameterBuffer() const override { return m_ParameterBuffer; }
 
 	// accessors
 	//---------------------
@@ -75,6 +76,7 @@ private:
 
 	// parameters
 	T_ParameterBlock m_DefaultParameters = nullptr;
+	T_BufferLoc m_ParameterBuffer = 0u;
 
 	// utility
 	std::vector<AssetPtr<TextureData>> m_TextureReferences; // prevent textures from unloading
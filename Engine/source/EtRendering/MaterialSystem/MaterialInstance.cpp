@@ -39,7 +39,12 @@ MaterialInstance::MaterialInstance(AssetPtr<Material> const material,
 	, m_Material(material)
 	, m_Parameters(params)
 	, m_TextureReferences(textureRefs)
-{ }
+{ 
+	if (m_Parameters != nullptr)
+	{
+		m_ParameterBuffer = m_Material->GetShader()->CreateParameterBuffer(m_Parameters);
+	}
+}
 
 //--------------------------
 // MaterialInstance::c-tor
@@ -58,6 +63,11 @@ MaterialInstance::MaterialInstance(AssetPtr<MaterialInstance> const parent,
 	ET_ASSERT(m_Parent != nullptr);
 
 	m_Material = m_Parent->GetMaterialAsset();
+
+	if (m_Parameters != nullptr)
+	{
+		m_ParameterBuffer = m_Material->GetShader()->CreateParameterBuffer(m_Parameters);
+	}
 }
 
 //--------------------------
@@ -65,6 +75,11 @@ MaterialInstance::MaterialInstance(AssetPtr<MaterialInstance> const parent,
 //
 MaterialInstance::~MaterialInstance()
 {
+	if (m_ParameterBuffer != 0u)
+	{
+		Viewport::GetCurrentApiContext()->DeleteBuffer(m_ParameterBuffer);
+	}
+
 	parameters::DestroyBlock(m_Parameters);
 }
 
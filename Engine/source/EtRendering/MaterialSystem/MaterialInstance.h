@@ -24,6 +24,7 @@ public:
 	//---------------------
 	Material const* GetBaseMaterial() const override { return m_Material.get(); }
 	T_ConstParameterBlock GetParameters() const override { return m_Parameters; }
+	T_BufferLoc GetParameterBuffer() const override { return m_ParameterBuffer; }
 
 	// accessors
 	//---------------------
@@ -40,6 +41,7 @@ private:
 
 	// parameters
 	T_ParameterBlock m_Parameters = nullptr;
+	T_BufferLoc m_ParameterBuffer = 0u;
 
 	// utility
 	std::vector<AssetPtr<TextureData>> m_TextureReferences; // prevent textures from unloading
@@ -21,6 +21,7 @@ public:
 
 	virtual Material const* GetBaseMaterial() const = 0;
 	virtual T_ConstParameterBlock GetParameters() const = 0;
+	virtual T_BufferLoc GetParameterBuffer() const = 0; // material block of the parameters, 0 if the shader doesn't have one
 };
 
 
@@ -12,9 +12,9 @@ namespace et {
 namespace render {
 
 
-vec3 InterpolatedSpectrum(const std::vector<double_t> &wavelengths, const std::vector<double_t> &v, const dvec3 &lambdas, float scale)
+vec3 InterpolatedSpectrum(CIE const& cie, const std::vector<double_t> &wavelengths, const std::vector<double_t> &v, const dvec3 &lambdas, float scale)
 {
-	dvec3 ret = RenderingSystems::Instance()->GetCie().Interpolate(wavelengths, v, lambdas);
+	dvec3 ret = cie.Interpolate(wavelengths, v, lambdas);
 	return vec3((float)ret.x, (float)ret.y, (float)ret.z) * scale;
 }
 
@@ -34,8 +34,12 @@ AtmosphereParameters::AtmosphereParameters(core::HashString const assetId, dvec3
 	AssetPtr<core::StubData> jsonText = core::ResourceManager::Instance()->GetAssetData<core::StubData>(assetId);
 
 	core::JSON::Parser parser = core::JSON::Parser(std::string(jsonText->GetText(), jsonText->GetLength()));
-	core::JSON::Object* root = parser.GetRoot();
+	*this = AtmosphereParameters(parser.GetRoot(), RenderingSystems::Instance()->GetCie(), skyColor, sunColor);
+}
 
+// Computes the parameters from their spectral description on the CPU only, so that it can run without a graphics context
+AtmosphereParameters::AtmosphereParameters(core::JSON::Object* const root, CIE const& cie, dvec3 &skyColor, dvec3 &sunColor)
+{
 	// CALCULATE ATMOSPHERE PARAMETERS
 	// *******************************
 	int32 kLambdaMin; core::JSON::ApplyNumValue(root, kLambdaMin, "lambdaMin"); // min wavelength
@@ -95,26 +99,26 @@ AtmosphereParameters::AtmosphereParameters(core::HashString const assetId, dvec3
 	dvec3 lambdas = dvec3(settings.kLambdaR, settings.kLambdaG, settings.kLambdaB);
 	double kLengthUnitInMeters; core::JSON::ApplyNumValue(root, kLengthUnitInMeters, "length unit in meters");
 
-	solarIrradiance = InterpolatedSpectrum(wavelengths, solar_irradiance, lambdas, 1.f);
+	solarIrradiance = InterpolatedSpectrum(cie, wavelengths, solar_irradiance, lambdas, 1.f);
 	core::JSON::ApplyNumValue(root, sun_angular_radius, "sun angular diameter"); sun_angular_radius /= 2.0;
 	core::JSON::ApplyNumValue(root, bottom_radius, "bottom radius"); bottom_radius /= (float)kLengthUnitInMeters;
 	core::JSON::ApplyNumValue(root, top_radius, "top radius"); top_radius /= (float)kLengthUnitInMeters;
 	bottom_radius = 1737.1f;// #temp , moon specific
 	top_radius = 1837.1f;// #temp , moon specific
 	rayleigh_density = DensityProfile({ rayleigh_layer }, (float)kLengthUnitInMeters);
-	rayleighScattering = InterpolatedSpectrum(wavelengths, rayleigh_scattering, lambdas, (float)kLengthUnitInMeters);
+	rayleighScattering = InterpolatedSpectrum(cie, wavelengths, rayleigh_scattering, lambdas, (float)kLengthUnitInMeters);
 	mie_density = DensityProfile({ mie_layer }, (float)kLengthUnitInMeters);
-	mieScattering = InterpolatedSpectrum(wavelengths, mie_scattering, lambdas, (float)kLengthUnitInMeters);
-	mieExtinction = InterpolatedSpectrum(wavelengths, mie_extinction, lambdas, (float)kLengthUnitInMeters);
+	mieScattering = InterpolatedSpectrum(cie, wavelengths, mie_scattering, lambdas, (float)kLengthUnitInMeters);
+	mieExtinction = InterpolatedSpectrum(cie, wavelengths, mie_extinction, lambdas, (float)kLengthUnitInMeters);
 	mie_phase_function_g = (float)0.8f;
 	core::JSON::ApplyNumValue(root, mie_phase_function_g, "mie phase function");
 	absorption_density = DensityProfile(ozone_density, (float)kLengthUnitInMeters);
-	absorptionExtinction = InterpolatedSpectrum(wavelengths, absorption_extinction, lambdas, (float)kLengthUnitInMeters);
-	groundAlbedo = InterpolatedSpectrum(wavelengths, ground_albedo, lambdas, 1.f);
+	absorptionExtinction = InterpolatedSpectrum(cie, wavelengths, absorption_extinction, lambdas, (float)kLengthUnitInMeters);
+	groundAlbedo = InterpolatedSpectrum(cie, wavelengths, ground_albedo, lambdas, 1.f);
 	core::JSON::ApplyNumValue(root, mu_s_min, "mu s min"); mu_s_min = cosf(math::radians(mu_s_min));
 
-	AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(wavelengths, solar_irradiance, -3, skyColor);
-	AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(wavelengths, solar_irradiance, 0, sunColor);
+	AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(cie, wavelengths, solar_irradiance, -3, skyColor);
+	AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(cie, wavelengths, solar_irradiance, 0, sunColor);
 }
 
 void AtmosphereParameters::Upload(ShaderData const* const shader, const std::string &varName) const
@@ -6,10 +6,18 @@
 //Values copied from https://ebruneton.github.io/precomputed_atmospheric_scattering/atmosphere/constants.h.html
 
 
+namespace et { namespace core { namespace JSON {
+	struct Object;
+} } }
+
+
 namespace et {
 namespace render { 
 
 
+class CIE;
+
+
 struct DensityProfileLayer
 {
 	DensityProfileLayer();
@@ -30,6 +38,7 @@ struct AtmosphereParameters
 {
 	AtmosphereParameters() {}
 	AtmosphereParameters(core::HashString const assetId, dvec3 &skyColor, dvec3 &sunColor);
+	AtmosphereParameters(core::JSON::Object* const root, CIE const& cie, dvec3 &skyColor, dvec3 &sunColor);
 	void Upload(ShaderData const* const shader, const std::string &varName) const;
 
 	vec3 solarIrradiance;
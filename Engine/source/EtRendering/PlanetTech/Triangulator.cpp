@@ -1,21 +1,184 @@
 #include "stdafx.h"
 #include "Triangulator.h"
 
+#include <atomic>
+
 #include "Planet.h"
 
+#include <EtCore/Util/JobPool.h>
+
 #include <EtRendering/GraphicsTypes/Frustum.h>
 #include <EtRendering/SceneRendering/ShadedSceneRenderer.h>
 
+#if defined(__AVX__)
+#	define ET_TRIANGULATOR_AVX
+#	include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	define ET_TRIANGULATOR_SSE
+#	include <xmmintrin.h>
+#endif
+
 
 namespace et {
 namespace render {
 
 
+namespace {
+
+#if defined(ET_TRIANGULATOR_AVX)
+
+	// the batched split heuristic is written once against these wrappers, lanes hold the same value for 8 triangles
+	typedef __m256 T_Lanes;
+	size_t const s_LaneCount = 8u;
+
+	inline T_Lanes Load(float const* const data) { return _mm256_loadu_ps(data); }
+	inline void Store(float* const data, T_Lanes const val) { _mm256_storeu_ps(data, val); }
+	inline T_Lanes Set(float const val) { return _mm256_set1_ps(val); }
+
+	inline T_Lanes Add(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_add_ps(lhs, rhs); }
+	inline T_Lanes Sub(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_sub_ps(lhs, rhs); }
+	inline T_Lanes Mul(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_mul_ps(lhs, rhs); }
+	inline T_Lanes Div(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_div_ps(lhs, rhs); }
+	inline T_Lanes Min(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_min_ps(lhs, rhs); }
+	inline T_Lanes Sqrt(T_Lanes const val) { return _mm256_sqrt_ps(val); }
+	inline T_Lanes Abs(T_Lanes const val) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), val); }
+
+	inline T_Lanes And(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_and_ps(lhs, rhs); }
+	inline T_Lanes AndNot(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_andnot_ps(lhs, rhs); } // ~lhs & rhs
+	inline T_Lanes Or(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_or_ps(lhs, rhs); }
+	inline T_Lanes Select(T_Lanes const mask, T_Lanes const lhs, T_Lanes const rhs) { return _mm256_blendv_ps(rhs, lhs, mask); }
+
+	inline T_Lanes Less(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ); }
+	inline T_Lanes GreaterEqual(T_Lanes const lhs, T_Lanes const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ); }
+	inline uint32 GetMask(T_Lanes const mask) { return static_cast<uint32>(_mm256_movemask_ps(mask)); }
+
+#elif defined(ET_TRIANGULATOR_SSE)
+
+	// the batched split heuristic is written once against these wrappers, lanes hold the same value for 4 triangles
+	typedef __m128 T_Lanes;
+	size_t const s_LaneCount = 4u;
+
+	inline T_Lanes Load(float const* const data) { return _mm_loadu_ps(data); }
+	inline void Store(float* const data, T_Lanes const val) { _mm_storeu_ps(data, val); }
+	inline T_Lanes Set(float const val) { return _mm_set1_ps(val); }
+
+	inline T_Lanes Add(T_Lanes const lhs, T_Lanes const rhs) { return _mm_add_ps(lhs, rhs); }
+	inline T_Lanes Sub(T_Lanes const lhs, T_Lanes const rhs) { return _mm_sub_ps(lhs, rhs); }
+	inline T_Lanes Mul(T_Lanes const lhs, T_Lanes const rhs) { return _mm_mul_ps(lhs, rhs); }
+	inline T_Lanes Div(T_Lanes const lhs, T_Lanes const rhs) { return _mm_div_ps(lhs, rhs); }
+	inline T_Lanes Min(T_Lanes const lhs, T_Lanes const rhs) { return _mm_min_ps(lhs, rhs); }
+	inline T_Lanes Sqrt(T_Lanes const val) { return _mm_sqrt_ps(val); }
+	inline T_Lanes Abs(T_Lanes const val) { return _mm_andnot_ps(_mm_set1_ps(-0.f), val); }
+
+	inline T_Lanes And(T_Lanes const lhs, T_Lanes const rhs) { return _mm_and_ps(lhs, rhs); }
+	inline T_Lanes AndNot(T_Lanes const lhs, T_Lanes const rhs) { return _mm_andnot_ps(lhs, rhs); } // ~lhs & rhs
+	inline T_Lanes Or(T_Lanes const lhs, T_Lanes const rhs) { return _mm_or_ps(lhs, rhs); }
+	inline T_Lanes Select(T_Lanes const mask, T_Lanes const lhs, T_Lanes const rhs) { return _mm_or_ps(_mm_and_ps(mask, lhs), _mm_andnot_ps(mask, rhs)); }
+
+	inline T_Lanes Less(T_Lanes const lhs, T_Lanes const rhs) { return _mm_cmplt_ps(lhs, rhs); }
+	inline T_Lanes GreaterEqual(T_Lanes const lhs, T_Lanes const rhs) { return _mm_cmpge_ps(lhs, rhs); }
+	inline uint32 GetMask(T_Lanes const mask) { return static_cast<uint32>(_mm_movemask_ps(mask)); }
+
+#else
+
+	size_t const s_LaneCount = 1u;
+
+#endif
+
+#if defined(ET_TRIANGULATOR_AVX) || defined(ET_TRIANGULATOR_SSE)
+
+	// same order of operations as math::dot, so that batched and scalar results are identical
+	inline T_Lanes Dot(T_Lanes const lx, T_Lanes const ly, T_Lanes const lz, T_Lanes const rx, T_Lanes const ry, T_Lanes const rz)
+	{
+		return Add(Add(Mul(lx, rx), Mul(ly, ry)), Mul(lz, rz));
+	}
+
+	inline T_Lanes DistanceSquared(T_Lanes const lx, T_Lanes const ly, T_Lanes const lz, T_Lanes const rx, T_Lanes const ry, T_Lanes const rz)
+	{
+		T_Lanes const x = Sub(lx, rx);
+		T_Lanes const y = Sub(ly, ry);
+		T_Lanes const z = Sub(lz, rz);
+		return Dot(x, y, z, x, y, z);
+	}
+
+#endif
+
+} // namespace
+
+
+// static
+int16 const Triangulator::s_CacheLevel = 3;
+size_t const Triangulator::s_MinTaskCount = 256u;
+float const Triangulator::s_MarginScale = 0.99f; // leaves room for rounding errors in the margins
+size_t const Triangulator::s_BatchSize = s_LaneCount;
+size_t const Triangulator::s_TasksPerBatch = 16u; // enough triangles per level to fill batches, while leaving enough groups to balance threads
+
+
+//---------------------------------
+// Triangulator::Output::Reset
+//
+void Triangulator::Output::Reset()
+{
+	positions.clear();
+	lodMargin = std::numeric_limits<float>::max();
+	frustumMargin = std::numeric_limits<float>::max();
+	evaluatedCount = 0u;
+}
+
+//---------------------------------
+// Triangulator::TriangleBatch::Add
+//
+void Triangulator::TriangleBatch::Add(vec3 const& a, vec3 const& b, vec3 const& c, bool const cull, size_t const output)
+{
+	ax.push_back(a.x);
+	ay.push_back(a.y);
+	az.push_back(a.z);
+	bx.push_back(b.x);
+	by.push_back(b.y);
+	bz.push_back(b.z);
+	cx.push_back(c.x);
+	cy.push_back(c.y);
+	cz.push_back(c.z);
+	frustumCull.push_back(cull ? 1u : 0u);
+	outputIdx.push_back(output);
+}
+
+//---------------------------------
+// Triangulator::TriangleBatch::Clear
+//
+void Triangulator::TriangleBatch::Clear()
+{
+	ax.clear();
+	ay.clear();
+	az.clear();
+	bx.clear();
+	by.clear();
+	bz.clear();
+	cx.clear();
+	cy.clear();
+	cz.clear();
+	frustumCull.clear();
+	outputIdx.clear();
+}
+
+
+
 void Triangulator::Init(Planet* const planet)
 {
-	m_Planet = planet;
+	Init(planet->GetRadius(), planet->GetMaxHeight(), Viewport::GetCurrentViewport()->GetDimensions());
+}
+
+void Triangulator::Init(float const radius, float const maxHeight, ivec2 const viewDimensions)
+{
+	m_Radius = radius;
+	m_MaxHeight = maxHeight;
+	m_ViewDimensions = viewDimensions;
+
+	m_Icosahedron.clear();
+	m_Subtrees.clear();
+	m_CoherentMaxLevel = -1;
 
-	auto ico = math::GetIcosahedronPositions(m_Planet->GetRadius());
+	auto ico = math::GetIcosahedronPositions(m_Radius);
 	auto indices = math::GetIcosahedronIndices();
 	for (size_t i = 0; i < indices.size(); i+=3)
 	{
@@ -30,6 +193,14 @@ void Triangulator::Init(Planet* const planet)
 
 bool Triangulator::Update(mat4 const& transform, Camera const& camera)
 {
+	return Update(transform, camera, Viewport::GetCurrentViewport()->GetDimensions());
+}
+
+bool Triangulator::Update(mat4 const& transform, Camera const& camera, ivec2 const viewDimensions)
+{
+	ET_PROFILE_ZONE("Triangulator::Update");
+
+	m_ViewDimensions = viewDimensions;
 	m_MaxLevel = 22;
 	Precalculate();
 
@@ -40,7 +211,7 @@ bool Triangulator::Update(mat4 const& transform, Camera const& camera)
 		m_Frustum.SetToCamera(camera);
 	}
 
-	m_Frustum.Update(Viewport::GetCurrentViewport());
+	m_Frustum.Update(static_cast<float>(m_ViewDimensions.x) / static_cast<float>(m_ViewDimensions.y));
 
 	return true;
 }
@@ -48,7 +219,7 @@ bool Triangulator::Update(mat4 const& transform, Camera const& camera)
 void Triangulator::Precalculate()
 {
 	//determine culling angle behind planet based on max height
-	float cullingAngle = acosf(m_Planet->GetRadius()/(m_Planet->GetRadius()+m_Planet->GetMaxHeight()));
+	float cullingAngle = acosf(m_Radius/(m_Radius+m_MaxHeight));
 	//Dot Product LUT
 	m_TriLevelDotLUT.clear();
 	m_TriLevelDotLUT.push_back(0.5f+sinf(cullingAngle));
@@ -64,110 +235,792 @@ void Triangulator::Precalculate()
 	vec3 b = m_Icosahedron[0].b;
 	vec3 c = m_Icosahedron[0].c;
 	vec3 center = (a + b + c) / 3.f;
-	center = center * m_Planet->GetRadius() / math::length(center);//+maxHeight
+	center = center * m_Radius / math::length(center);//+maxHeight
 	m_HeightMultLUT.push_back(1 / math::dot( math::normalize(a), math::normalize(center)));
-	float normMaxHeight = m_Planet->GetMaxHeight() / m_Planet->GetRadius();
+	float normMaxHeight = m_MaxHeight / m_Radius;
 	for (int32 i = 1; i <= m_MaxLevel; i++)
 	{
 		vec3 A = b + ((c - b)*0.5f);
 		vec3 B = c + ((a - c)*0.5f);
 		c = a + ((b - a)*0.5f);
-		a = A * m_Planet->GetRadius() / math::length(A);
-		b = B * m_Planet->GetRadius() / math::length(B);
-		c = c * m_Planet->GetRadius() / math::length(c);
+		a = A * m_Radius / math::length(A);
+		b = B * m_Radius / math::length(B);
+		c = c * m_Radius / math::length(c);
 		m_HeightMultLUT.push_back(1 / math::dot( math::normalize(a), math::normalize(center)) + normMaxHeight);
 	}
 }
 
+//---------------------------------
+// Triangulator::GenerateGeometry
+//
+// Triangulate the planet for the current frustum
+//  - triangles above the cache level are split on the calling thread, subtrees below it are reused or turned into tasks
+//  - positions are gathered in subtree order, so the result doesn't depend on how tasks were scheduled
+//
 void Triangulator::GenerateGeometry()
 {
+	ET_PROFILE_ZONE("Triangulator::GenerateGeometry");
+
 	//Precalculate Distance LUT
 	//The distances generated should keep the triangles smaller than m_AllowedTriPx at any level
 	//In future only recalculate on FOV or triangle density change
 	m_DistanceLUT.clear();
 	float sizeL = math::length(m_Icosahedron[0].a - m_Icosahedron[0].b);
-	float frac = tanf((m_AllowedTriPx * math::radians(m_Frustum.GetFOV())) / Viewport::GetCurrentViewport()->GetDimensions().x);
+	float frac = tanf((m_AllowedTriPx * math::radians(m_Frustum.GetFOV())) / static_cast<float>(m_ViewDimensions.x));
 	for (int32 level = 0; level < m_MaxLevel+5; level++)
 	{
 		m_DistanceLUT.push_back(sizeL / frac);
 		sizeL *= 0.5f;
 	}
 
+	size_t const subtreeCount = m_Icosahedron.size() << (2 * s_CacheLevel);
+	if (m_Subtrees.size() != subtreeCount)
+	{
+		m_Subtrees = std::vector<Subtree>(subtreeCount);
+	}
+
+	UpdateBatchPlanes();
+
+	bool const isCoherent = UpdateCoherence();
+	for (Subtree& subtree : m_Subtrees)
+	{
+		subtree.isValid = subtree.isValid && isCoherent;
+		subtree.isReached = false;
+	}
+
 	//Recursion start
+	m_TopOutput.Reset();
+	m_DirtySubtrees.clear();
+	m_Tasks.clear();
+
+	for (size_t faceIdx = 0u; faceIdx < m_Icosahedron.size(); ++faceIdx)
+	{
+		Tri const& t = m_Icosahedron[faceIdx];
+		TraverseToCacheLevel(t.a, t.b, t.c, t.level, true, faceIdx);
+	}
+
+	SplitTasks();
+	RunTasks();
+	GatherPositions();
+
+	m_EvaluatedCount = m_TopOutput.evaluatedCount;
+	for (size_t const subtreeIdx : m_DirtySubtrees)
+	{
+		m_EvaluatedCount += m_Subtrees[subtreeIdx].output.evaluatedCount;
+	}
+}
+
+//---------------------------------
+// Triangulator::UpdateCoherence
+//
+// Returns false if subtrees from previous frames can't be reused because the level of detail settings changed
+//
+bool Triangulator::UpdateCoherence()
+{
+	bool const isCoherent = m_IsCoherent && (m_CoherentMaxLevel == m_MaxLevel) && (m_CoherentDistanceLUT == m_DistanceLUT);
+
+	m_CoherentMaxLevel = m_MaxLevel;
+	m_CoherentDistanceLUT = m_DistanceLUT;
+
+	return isCoherent;
+}
+
+//---------------------------------
+// Triangulator::GetPlaneOffset
+//
+// Signed distance of the camera to a frustum plane, this only changes with the FOV, aspect ratio or clipping planes
+//
+float Triangulator::GetPlaneOffset(math::Plane const& plane) const
+{
+	return math::dot(plane.n, plane.d - m_Frustum.GetPositionOS());
+}
+
+//---------------------------------
+// Triangulator::UpdateBatchPlanes
+//
+// Copy the frustum planes to the SoA layout used by SplitHeuristicBatch
+//
+void Triangulator::UpdateBatchPlanes()
+{
+	std::array<math::Plane, 6u> const& planes = m_Frustum.GetPlanes();
+	for (size_t planeIdx = 0u; planeIdx < planes.size(); ++planeIdx)
+	{
+		math::Plane const& plane = planes[planeIdx];
+
+		m_PlaneNormalX[planeIdx] = plane.n.x;
+		m_PlaneNormalY[planeIdx] = plane.n.y;
+		m_PlaneNormalZ[planeIdx] = plane.n.z;
+		m_PlanePointX[planeIdx] = plane.d.x;
+		m_PlanePointY[planeIdx] = plane.d.y;
+		m_PlanePointZ[planeIdx] = plane.d.z;
+	}
+}
+
+//---------------------------------
+// Triangulator::TraverseToCacheLevel
+//
+// Split triangles down to the cache level, and add a task for each subtree reached there that can't be reused
+//
+void Triangulator::TraverseToCacheLevel(vec3 const& a, vec3 const& b, vec3 const& c, int16 const level, bool const frustumCull, size_t const subtreeIdx)
+{
+	if (level == s_CacheLevel)
+	{
+		Subtree& subtree = m_Subtrees[subtreeIdx];
+		subtree.isReached = true;
+
+		if (CanReuse(subtree, frustumCull))
+		{
+			return;
+		}
+
+		subtree.output.Reset();
+
+		subtree.position = m_Frustum.GetPositionOS();
+		std::array<math::Plane, 6u> const& planes = m_Frustum.GetPlanes();
+		for (size_t planeIdx = 0u; planeIdx < planes.size(); ++planeIdx)
+		{
+			subtree.normals[planeIdx] = planes[planeIdx].n;
+			subtree.offsets[planeIdx] = GetPlaneOffset(planes[planeIdx]);
+		}
+
+		subtree.frustumCull = frustumCull;
+		subtree.isValid = false;
+
+		m_DirtySubtrees.emplace_back(subtreeIdx);
+		m_Tasks.push_back(Task{ a, b, c, level, frustumCull, subtreeIdx });
+		return;
+	}
+
+	TriNext const next = SplitHeuristic(a, b, c, level, frustumCull, m_TopOutput);
+	if (next == CULL) return;
+	else if (next == SPLIT || next == SPLITCULL)
+	{
+		vec3 A, B, C;
+		SplitTriangle(a, b, c, A, B, C);
+
+		int16 const nLevel = level + 1;
+		size_t const childIdx = subtreeIdx * 4u;
+		TraverseToCacheLevel(a, B, C, nLevel, next == SPLITCULL, childIdx);//Winding is inverted
+		TraverseToCacheLevel(A, b, C, nLevel, next == SPLITCULL, childIdx + 1u);//Winding is inverted
+		TraverseToCacheLevel(A, B, c, nLevel, next == SPLITCULL, childIdx + 2u);//Winding is inverted
+		TraverseToCacheLevel(A, B, C, nLevel, next == SPLITCULL, childIdx + 3u);
+	}
+	else //put the triangle in the buffer
+	{
+		m_TopOutput.positions.push_back(PatchInstance((BYTE)level, a, b-a, c-a));
+	}
+}
+
+//---------------------------------
+// Triangulator::CanReuse
+//
+// A subtree is still valid if the camera didn't move further than the margin of any decision taken within it
+//  - moving by a distance can change distances to the camera by at most that much
+//  - relative to the camera, frustum planes move by the change of their offset, plus the change of their normal times the distance to the
+//    camera, which itself changed by at most the distance moved
+//
+bool Triangulator::CanReuse(Subtree const& subtree, bool const frustumCull) const
+{
+	if (!(subtree.isValid && (subtree.frustumCull == frustumCull)))
+	{
+		return false;
+	}
+
+	float const moved = math::length(m_Frustum.GetPositionOS() - subtree.position);
+	if (moved >= subtree.output.lodMargin * s_MarginScale)
+	{
+		return false;
+	}
+
+	float shifted = 0.f;
+	float turned = 0.f;
+	std::array<math::Plane, 6u> const& planes = m_Frustum.GetPlanes();
+	for (size_t planeIdx = 0u; planeIdx < planes.size(); ++planeIdx)
+	{
+		shifted = std::max(shifted, std::abs(GetPlaneOffset(planes[planeIdx]) - subtree.offsets[planeIdx]));
+		turned = std::max(turned, math::length(planes[planeIdx].n - subtree.normals[planeIdx]));
+	}
+
+	return (std::max(moved * (1.f + turned) + shifted, turned) < subtree.output.frustumMargin * s_MarginScale);
+}
+
+//---------------------------------
+// Triangulator::SplitTasks
+//
+// Subtrees close to the camera contain most of the patches, so tasks are split breadth first until there are enough to balance threads
+//  - leaves found while splitting go to the output of their subtree
+//
+void Triangulator::SplitTasks()
+{
+	while (!m_Tasks.empty() && (m_Tasks.size() < s_MinTaskCount))
+	{
+		m_NextTasks.clear();
+		for (Task const& task : m_Tasks)
+		{
+			Output& output = m_Subtrees[task.subtreeIdx].output;
+
+			TriNext const next = SplitHeuristic(task.a, task.b, task.c, task.level, task.frustumCull, output);
+			if (next == CULL) continue;
+			else if (next == SPLIT || next == SPLITCULL)
+			{
+				vec3 A, B, C;
+				SplitTriangle(task.a, task.b, task.c, A, B, C);
+
+				int16 const nLevel = task.level + 1;
+				m_NextTasks.push_back(Task{ task.a, B, C, nLevel, next == SPLITCULL, task.subtreeIdx });//Winding is inverted
+				m_NextTasks.push_back(Task{ A, task.b, C, nLevel, next == SPLITCULL, task.subtreeIdx });//Winding is inverted
+				m_NextTasks.push_back(Task{ A, B, task.c, nLevel, next == SPLITCULL, task.subtreeIdx });//Winding is inverted
+				m_NextTasks.push_back(Task{ A, B, C, nLevel, next == SPLITCULL, task.subtreeIdx });
+			}
+			else
+			{
+				output.positions.push_back(PatchInstance((BYTE)task.level, task.a, task.b - task.a, task.c - task.a));
+			}
+		}
+
+		m_Tasks.swap(m_NextTasks);
+	}
+}
+
+//---------------------------------
+// Triangulator::RunTasks
+//
+// Triangulate all tasks on the threads of the job pool, each into its own output, and append the outputs to their subtrees
+//
+void Triangulator::RunTasks()
+{
+	if (m_TaskOutputs.size() < m_Tasks.size())
+	{
+		m_TaskOutputs.resize(m_Tasks.size());
+	}
+
+	// in batched mode workers take groups of tasks, which are triangulated breadth first together
+	size_t const groupSize = m_IsBatched ? s_TasksPerBatch : 1u;
+
+	std::atomic<size_t> nextTask(0u);
+	auto runTasks = [this, &nextTask, groupSize](BatchBuffers& buffers)
+		{
+			for (size_t firstTask = nextTask.fetch_add(groupSize); firstTask < m_Tasks.size(); firstTask = nextTask.fetch_add(groupSize))
+			{
+				size_t const lastTask = std::min(firstTask + groupSize, m_Tasks.size());
+				for (size_t taskIdx = firstTask; taskIdx < lastTask; ++taskIdx)
+				{
+					m_TaskOutputs[taskIdx].Reset();
+				}
+
+				if (m_IsBatched)
+				{
+					BatchedTriangles(firstTask, lastTask, buffers, m_TaskOutputs.data());
+				}
+				else
+				{
+					for (size_t taskIdx = firstTask; taskIdx < lastTask; ++taskIdx)
+					{
+						Task const& task = m_Tasks[taskIdx];
+						RecursiveTriangle(task.a, task.b, task.c, task.level, task.frustumCull, m_TaskOutputs[taskIdx]);
+					}
+				}
+			}
+		};
+
+	// one grain per thread, each with its own buffers, grains pull groups of tasks until none are left
+	core::JobPool* const jobPool = core::JobPool::GetInstance();
+
+	size_t const groupCount = (m_Tasks.size() + groupSize - 1u) / groupSize;
+	size_t const threadCount = std::min(jobPool->GetThreadCount(), groupCount);
+	if (m_WorkerBuffers.size() < threadCount)
+	{
+		m_WorkerBuffers.resize(threadCount);
+	}
+
+	jobPool->Run(0u, threadCount, 1u, [this, &runTasks](size_t const grainIdx, size_t const begin, size_t const end)
+		{
+			UNUSED(begin);
+			UNUSED(end);
+			runTasks(m_WorkerBuffers[grainIdx]);
+		});
+
+	for (size_t taskIdx = 0u; taskIdx < m_Tasks.size(); ++taskIdx)
+	{
+		Output const& taskOutput = m_TaskOutputs[taskIdx];
+		Output& output = m_Subtrees[m_Tasks[taskIdx].subtreeIdx].output;
+
+		output.positions.insert(output.positions.end(), taskOutput.positions.cbegin(), taskOutput.positions.cend());
+		output.lodMargin = std::min(output.lodMargin, taskOutput.lodMargin);
+		output.frustumMargin = std::min(output.frustumMargin, taskOutput.frustumMargin);
+		output.evaluatedCount += taskOutput.evaluatedCount;
+	}
+
+	// margins are only recorded in coherent mode, so subtrees triangulated without it can't be reused once it is switched on
+	for (size_t const subtreeIdx : m_DirtySubtrees)
+	{
+		m_Subtrees[subtreeIdx].isValid = m_IsCoherent;
+	}
+}
+
+//---------------------------------
+// Triangulator::GatherPositions
+//
+// Concatenate the leaves above the cache level with the output of every subtree reached this frame
+//
+void Triangulator::GatherPositions()
+{
+	size_t count = m_TopOutput.positions.size();
+	for (Subtree const& subtree : m_Subtrees)
+	{
+		if (subtree.isReached)
+		{
+			count += subtree.output.positions.size();
+		}
+	}
+
 	m_Positions.clear();
+	m_Positions.reserve(count);
 
-	for (auto t : m_Icosahedron)
+	m_Positions.insert(m_Positions.end(), m_TopOutput.positions.cbegin(), m_TopOutput.positions.cend());
+	for (Subtree const& subtree : m_Subtrees)
 	{
-		RecursiveTriangle(t.a, t.b, t.c, t.level, true);
+		if (subtree.isReached)
+		{
+			m_Positions.insert(m_Positions.end(), subtree.output.positions.cbegin(), subtree.output.positions.cend());
+		}
 	}
 }
 
-TriNext Triangulator::SplitHeuristic(vec3 &a, vec3 &b, vec3 &c, int16 level, bool frustumCull)
+//---------------------------------
+// Triangulator::SplitHeuristic
+//
+// Decide whether a triangle is culled, becomes a patch or is split further, and lower the margins of the output accordingly
+//
+TriNext Triangulator::SplitHeuristic(vec3 const& a, vec3 const& b, vec3 const& c, int16 const level, bool const frustumCull, Output& output) const
 {
+	++output.evaluatedCount;
+
+	vec3 const& camPos = m_Frustum.GetPositionOS();
+
 	vec3 center = (a + b + c) / 3.f;
-	//Perform backface culling
-	float dotNV = math::dot( math::normalize(center), math::normalize(center - m_Frustum.GetPositionOS()));
+	//Perform backface culling - moving the camera by x changes the direction to the center by at most 2x / distance
+	vec3 const toCenter = center - camPos;
+	float const centerDist = math::length(toCenter);
+	float dotNV = math::dot( math::normalize(center), toCenter / centerDist);
+	output.lodMargin = std::min(output.lodMargin, std::abs(dotNV - m_TriLevelDotLUT[level]) * centerDist * 0.5f);
 	if (dotNV >= m_TriLevelDotLUT[level])
 	{
 		return TriNext::CULL;
 	}
 
 	//Perform Frustum culling
+	bool isContained = false;
 	if (frustumCull)
 	{
-		auto intersect = m_Frustum.ContainsTriVolume(a, b, c, m_HeightMultLUT[level]);
-		//auto intersect = m_Frustum.ContainsTriangle(a, b, c);
+		auto intersect = FrustumCheck(a, b, c, m_HeightMultLUT[level], output.frustumMargin);
 		if (intersect == VolumeCheck::OUTSIDE) return TriNext::CULL;
-		if (intersect == VolumeCheck::CONTAINS)//stop frustum culling -> all children are also inside the frustum
-		{
-			//check if new splits are allowed
-			if (level >= m_MaxLevel)return TriNext::LEAF;
-			//split according to distance
-			float aDistSq = math::distanceSquared(a, m_Frustum.GetPositionOS());
-			float bDistSq = math::distanceSquared(b, m_Frustum.GetPositionOS());
-			float cDistSq = math::distanceSquared(c, m_Frustum.GetPositionOS());
-			float splitDistSq = m_DistanceLUT[level] * m_DistanceLUT[level];
-			if (std::fminf(aDistSq, std::fminf(bDistSq, cDistSq)) < splitDistSq) return TriNext::SPLIT;
-			return TriNext::LEAF;
-		}
+		isContained = (intersect == VolumeCheck::CONTAINS);//stop frustum culling -> all children are also inside the frustum
 	}
+
 	//check if new splits are allowed
 	if (level >= m_MaxLevel)return TriNext::LEAF;
+
 	//split according to distance
-	float aDistSq = math::distanceSquared(a, m_Frustum.GetPositionOS());
-	float bDistSq = math::distanceSquared(b, m_Frustum.GetPositionOS());
-	float cDistSq = math::distanceSquared(c, m_Frustum.GetPositionOS());
+	float aDistSq = math::distanceSquared(a, camPos);
+	float bDistSq = math::distanceSquared(b, camPos);
+	float cDistSq = math::distanceSquared(c, camPos);
+	float minDistSq = std::fminf(aDistSq, std::fminf(bDistSq, cDistSq));
 	float splitDistSq = m_DistanceLUT[level] * m_DistanceLUT[level];
-	if (std::fminf(aDistSq, std::fminf(bDistSq, cDistSq)) < splitDistSq) return TriNext::SPLITCULL;
+	if (m_IsCoherent)
+	{
+		output.lodMargin = std::min(output.lodMargin, std::abs(std::sqrt(minDistSq) - m_DistanceLUT[level]));
+	}
+
+	if (minDistSq < splitDistSq) return isContained ? TriNext::SPLIT : TriNext::SPLITCULL;
 	return TriNext::LEAF;
 }
 
-void Triangulator::RecursiveTriangle(vec3 a, vec3 b, vec3 c, int16 level, bool frustumCull)
+//---------------------------------
+// Triangulator::FrustumCheck
+//
+// Same as Frustum::ContainsTriVolume, but also lowers the margin to the smallest distance of a tested point to a plane
+//  - distances are divided by one plus the distance to the camera, as that is how much planes move when rotating around the camera
+//
+VolumeCheck Triangulator::FrustumCheck(vec3 const& a, vec3 const& b, vec3 const& c, float const height, float& margin) const
+{
+	vec3 const& camPos = m_Frustum.GetPositionOS();
+
+	// scale factors for the margin, per tested point
+	float scale[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+	bool hasVolumeScale = false;
+	if (m_IsCoherent)
+	{
+		scale[0] = 1.f / (1.f + math::distance(a, camPos));
+		scale[1] = 1.f / (1.f + math::distance(b, camPos));
+		scale[2] = 1.f / (1.f + math::distance(c, camPos));
+	}
+
+	VolumeCheck ret = VolumeCheck::CONTAINS;
+	for (math::Plane const& plane : m_Frustum.GetPlanes())
+	{
+		float const distA = math::dot(plane.n, a - plane.d);
+		float const distB = math::dot(plane.n, b - plane.d);
+		float const distC = math::dot(plane.n, c - plane.d);
+		margin = std::min(margin, std::min(std::abs(distA) * scale[0], std::min(std::abs(distB) * scale[1], std::abs(distC) * scale[2])));
+
+		char rejects = 0;
+		if (distA < 0)rejects++;
+		if (distB < 0)rejects++;
+		if (distC < 0)rejects++;
+		// if all three are outside a plane the triangle is outside the frustrum
+		if (rejects >= 3)
+		{
+			vec3 const ha = a * height;
+			vec3 const hb = b * height;
+			vec3 const hc = c * height;
+			if (m_IsCoherent && !hasVolumeScale)
+			{
+				scale[3] = 1.f / (1.f + math::distance(ha, camPos));
+				scale[4] = 1.f / (1.f + math::distance(hb, camPos));
+				scale[5] = 1.f / (1.f + math::distance(hc, camPos));
+				hasVolumeScale = true;
+			}
+
+			float const distHA = math::dot(plane.n, ha - plane.d);
+			float const distHB = math::dot(plane.n, hb - plane.d);
+			float const distHC = math::dot(plane.n, hc - plane.d);
+			margin = std::min(margin, std::min(std::abs(distHA) * scale[3], std::min(std::abs(distHB) * scale[4], std::abs(distHC) * scale[5])));
+
+			if (distHA < 0)rejects++;
+			if (distHB < 0)rejects++;
+			if (distHC < 0)rejects++;
+			if (rejects >= 6)return VolumeCheck::OUTSIDE;
+			else ret = VolumeCheck::INTERSECT;
+		}
+		// if at least one is outside the triangle intersects at least one plane
+		else if (rejects > 0)ret = VolumeCheck::INTERSECT;
+	}
+	return ret;
+}
+
+//---------------------------------
+// Triangulator::RecursiveTriangle
+//
+// Triangulate a triangle and everything below it into an output, only reads shared state so it can run on any thread
+//
+void Triangulator::RecursiveTriangle(vec3 const& a, vec3 const& b, vec3 const& c, int16 const level, bool const frustumCull, Output& output) const
 {
-	TriNext next = SplitHeuristic(a, b, c, level, frustumCull);
+	TriNext next = SplitHeuristic(a, b, c, level, frustumCull, output);
 	if (next == CULL) return;
 	//check if subdivision is needed based on camera distance
 	else if (next == SPLIT || next == SPLITCULL)
 	{
-		//find midpoints
-		vec3 A = b + ((c - b)*0.5f);
-		vec3 B = c + ((a - c)*0.5f);
-		vec3 C = a + ((b - a)*0.5f);
-		//make the distance from center larger according to planet radius
-		A = A * m_Planet->GetRadius() / math::length(A);
-		B = B * m_Planet->GetRadius() / math::length(B);
-		C = C * m_Planet->GetRadius() / math::length(C);
+		vec3 A, B, C;
+		SplitTriangle(a, b, c, A, B, C);
+
 		//Make 4 new triangles
 		int16 nLevel = level + 1;
-		RecursiveTriangle(a, B, C, nLevel, next == SPLITCULL);//Winding is inverted
-		RecursiveTriangle(A, b, C, nLevel, next == SPLITCULL);//Winding is inverted
-		RecursiveTriangle(A, B, c, nLevel, next == SPLITCULL);//Winding is inverted
-		RecursiveTriangle(A, B, C, nLevel, next == SPLITCULL);
+		RecursiveTriangle(a, B, C, nLevel, next == SPLITCULL, output);//Winding is inverted
+		RecursiveTriangle(A, b, C, nLevel, next == SPLITCULL, output);//Winding is inverted
+		RecursiveTriangle(A, B, c, nLevel, next == SPLITCULL, output);//Winding is inverted
+		RecursiveTriangle(A, B, C, nLevel, next == SPLITCULL, output);
 	}
 	else //put the triangle in the buffer
 	{
-		m_Positions.push_back(PatchInstance((BYTE)level, a, b-a, c-a));
+		output.positions.push_back(PatchInstance((BYTE)level, a, b-a, c-a));
+	}
+}
+
+//---------------------------------
+// Triangulator::SplitHeuristicBatch
+//
+// Same decisions and margins as SplitHeuristic for all triangles of a batch, which are at the same level
+//  - s_BatchSize triangles are evaluated at once, with the operations in the same order as the scalar version so results are identical
+//  - margins are lowered in the output each triangle refers to
+//  - all triangles go through frustum culling, the flag of each triangle only decides whether the result is used
+//  - the remainder of the batch is evaluated with the scalar version
+//
+void Triangulator::SplitHeuristicBatch(TriangleBatch const& batch, int16 const level, Output* const outputs, TriNext* const decisions) const
+{
+	size_t idx = 0u;
+
+#if defined(ET_TRIANGULATOR_AVX) || defined(ET_TRIANGULATOR_SSE)
+
+	vec3 const& camPos = m_Frustum.GetPositionOS();
+	T_Lanes const camX = Set(camPos.x);
+	T_Lanes const camY = Set(camPos.y);
+	T_Lanes const camZ = Set(camPos.z);
+
+	T_Lanes nx[6], ny[6], nz[6], px[6], py[6], pz[6];
+	for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+	{
+		nx[planeIdx] = Set(m_PlaneNormalX[planeIdx]);
+		ny[planeIdx] = Set(m_PlaneNormalY[planeIdx]);
+		nz[planeIdx] = Set(m_PlaneNormalZ[planeIdx]);
+		px[planeIdx] = Set(m_PlanePointX[planeIdx]);
+		py[planeIdx] = Set(m_PlanePointY[planeIdx]);
+		pz[planeIdx] = Set(m_PlanePointZ[planeIdx]);
 	}
+
+	T_Lanes const zero = Set(0.f);
+	T_Lanes const one = Set(1.f);
+	T_Lanes const half = Set(0.5f);
+	T_Lanes const three = Set(3.f);
+	T_Lanes const maxMargin = Set(std::numeric_limits<float>::max());
+
+	T_Lanes const dotLimit = Set(m_TriLevelDotLUT[level]);
+	T_Lanes const height = Set(m_HeightMultLUT[level]);
+
+	bool const canSplit = (level < m_MaxLevel);
+	T_Lanes const splitDist = Set(m_DistanceLUT[level]);
+	T_Lanes const splitDistSq = Set(m_DistanceLUT[level] * m_DistanceLUT[level]);
+
+	float backfaceMargins[s_LaneCount];
+	float frustumMargins[s_LaneCount];
+	float distanceMargins[s_LaneCount];
+
+	for (; idx + s_BatchSize <= batch.Size(); idx += s_BatchSize)
+	{
+		T_Lanes const ax = Load(batch.ax.data() + idx);
+		T_Lanes const ay = Load(batch.ay.data() + idx);
+		T_Lanes const az = Load(batch.az.data() + idx);
+		T_Lanes const bx = Load(batch.bx.data() + idx);
+		T_Lanes const by = Load(batch.by.data() + idx);
+		T_Lanes const bz = Load(batch.bz.data() + idx);
+		T_Lanes const cx = Load(batch.cx.data() + idx);
+		T_Lanes const cy = Load(batch.cy.data() + idx);
+		T_Lanes const cz = Load(batch.cz.data() + idx);
+
+		//Perform backface culling
+		T_Lanes const centerX = Div(Add(Add(ax, bx), cx), three);
+		T_Lanes const centerY = Div(Add(Add(ay, by), cy), three);
+		T_Lanes const centerZ = Div(Add(Add(az, bz), cz), three);
+
+		T_Lanes const toCenterX = Sub(centerX, camX);
+		T_Lanes const toCenterY = Sub(centerY, camY);
+		T_Lanes const toCenterZ = Sub(centerZ, camZ);
+		T_Lanes const centerDist = Sqrt(Dot(toCenterX, toCenterY, toCenterZ, toCenterX, toCenterY, toCenterZ));
+		T_Lanes const centerLength = Sqrt(Dot(centerX, centerY, centerZ, centerX, centerY, centerZ));
+
+		T_Lanes const dotNV = Dot(Div(centerX, centerLength), Div(centerY, centerLength), Div(centerZ, centerLength),
+			Div(toCenterX, centerDist), Div(toCenterY, centerDist), Div(toCenterZ, centerDist));
+		uint32 const backfaceMask = GetMask(GreaterEqual(dotNV, dotLimit));
+
+		T_Lanes const aDistSq = DistanceSquared(ax, ay, az, camX, camY, camZ);
+		T_Lanes const bDistSq = DistanceSquared(bx, by, bz, camX, camY, camZ);
+		T_Lanes const cDistSq = DistanceSquared(cx, cy, cz, camX, camY, camZ);
+
+		//Perform Frustum culling - lanes are only outside once all 6 points are behind the same plane
+		T_Lanes scaleA = zero;
+		T_Lanes scaleB = zero;
+		T_Lanes scaleC = zero;
+		if (m_IsCoherent)
+		{
+			scaleA = Div(one, Add(one, Sqrt(aDistSq)));
+			scaleB = Div(one, Add(one, Sqrt(bDistSq)));
+			scaleC = Div(one, Add(one, Sqrt(cDistSq)));
+		}
+
+		T_Lanes outside = zero;
+		T_Lanes intersect = zero;
+		T_Lanes frustumMargin = maxMargin;
+		for (size_t planeIdx = 0u; planeIdx < 6u; ++planeIdx)
+		{
+			T_Lanes const distA = Dot(nx[planeIdx], ny[planeIdx], nz[planeIdx], Sub(ax, px[planeIdx]), Sub(ay, py[planeIdx]), Sub(az, pz[planeIdx]));
+			T_Lanes const distB = Dot(nx[planeIdx], ny[planeIdx], nz[planeIdx], Sub(bx, px[planeIdx]), Sub(by, py[planeIdx]), Sub(bz, pz[planeIdx]));
+			T_Lanes const distC = Dot(nx[planeIdx], ny[planeIdx], nz[planeIdx], Sub(cx, px[planeIdx]), Sub(cy, py[planeIdx]), Sub(cz, pz[planeIdx]));
+
+			T_Lanes const rejectA = Less(distA, zero);
+			T_Lanes const rejectB = Less(distB, zero);
+			T_Lanes const rejectC = Less(distC, zero);
+			T_Lanes const allRejected = And(And(rejectA, rejectB), rejectC);
+
+			// the scalar version returns as soon as a triangle is outside, so later planes don't lower its margin
+			if (m_IsCoherent)
+			{
+				T_Lanes const margin = Min(Mul(Abs(distA), scaleA), Min(Mul(Abs(distB), scaleB), Mul(Abs(distC), scaleC)));
+				frustumMargin = Min(frustumMargin, Select(outside, maxMargin, margin));
+			}
+
+			T_Lanes const testVolume = AndNot(outside, allRejected);
+			if (GetMask(testVolume) != 0u)
+			{
+				T_Lanes const hax = Mul(ax, height);
+				T_Lanes const hay = Mul(ay, height);
+				T_Lanes const haz = Mul(az, height);
+				T_Lanes const hbx = Mul(bx, height);
+				T_Lanes const hby = Mul(by, height);
+				T_Lanes const hbz = Mul(bz, height);
+				T_Lanes const hcx = Mul(cx, height);
+				T_Lanes const hcy = Mul(cy, height);
+				T_Lanes const hcz = Mul(cz, height);
+
+				T_Lanes const distHA = Dot(nx[planeIdx], ny[planeIdx], nz[planeIdx], Sub(hax, px[planeIdx]), Sub(hay, py[planeIdx]), Sub(haz, pz[planeIdx]));
+				T_Lanes const distHB = Dot(nx[planeIdx], ny[planeIdx], nz[planeIdx], Sub(hbx, px[planeIdx]), Sub(hby, py[planeIdx]), Sub(hbz, pz[planeIdx]));
+				T_Lanes const distHC = Dot(nx[planeIdx], ny[planeIdx], nz[planeIdx], Sub(hcx, px[planeIdx]), Sub(hcy, py[planeIdx]), Sub(hcz, pz[planeIdx]));
+
+				if (m_IsCoherent)
+				{
+					T_Lanes const scaleHA = Div(one, Add(one, Sqrt(DistanceSquared(hax, hay, haz, camX, camY, camZ))));
+					T_Lanes const scaleHB = Div(one, Add(one, Sqrt(DistanceSquared(hbx, hby, hbz, camX, camY, camZ))));
+					T_Lanes const scaleHC = Div(one, Add(one, Sqrt(DistanceSquared(hcx, hcy, hcz, camX, camY, camZ))));
+
+					T_Lanes const margin = Min(Mul(Abs(distHA), scaleHA), Min(Mul(Abs(distHB), scaleHB), Mul(Abs(distHC), scaleHC)));
+					frustumMargin = Min(frustumMargin, Select(testVolume, margin, maxMargin));
+				}
+
+				T_Lanes const allHeightsRejected = And(And(Less(distHA, zero), Less(distHB, zero)), Less(distHC, zero));
+				outside = Or(outside, And(testVolume, allHeightsRejected));
+			}
+
+			intersect = Or(intersect, Or(Or(rejectA, rejectB), rejectC));
+		}
+
+		uint32 const outsideMask = GetMask(outside);
+		uint32 const intersectMask = GetMask(intersect);
+
+		//split according to distance
+		T_Lanes const minDistSq = Min(aDistSq, Min(bDistSq, cDistSq));
+		uint32 const splitMask = GetMask(Less(minDistSq, splitDistSq));
+
+		if (m_IsCoherent)
+		{
+			Store(backfaceMargins, Mul(Mul(Abs(Sub(dotNV, dotLimit)), centerDist), half));
+			Store(frustumMargins, frustumMargin);
+			Store(distanceMargins, Abs(Sub(Sqrt(minDistSq), splitDist)));
+		}
+
+		// combine the results in the same order as SplitHeuristic
+		for (size_t lane = 0u; lane < s_BatchSize; ++lane)
+		{
+			TriNext& decision = decisions[idx + lane];
+			Output& output = outputs[batch.outputIdx[idx + lane]];
+			++output.evaluatedCount;
+
+			if (m_IsCoherent)
+			{
+				output.lodMargin = std::min(output.lodMargin, backfaceMargins[lane]);
+			}
+
+			if ((backfaceMask >> lane) & 1u)
+			{
+				decision = TriNext::CULL;
+				continue;
+			}
+
+			bool isContained = false;
+			if (batch.frustumCull[idx + lane] != 0u)
+			{
+				if (m_IsCoherent)
+				{
+					output.frustumMargin = std::min(output.frustumMargin, frustumMargins[lane]);
+				}
+
+				if ((outsideMask >> lane) & 1u)
+				{
+					decision = TriNext::CULL;
+					continue;
+				}
+
+				isContained = (((intersectMask >> lane) & 1u) == 0u);
+			}
+
+			if (!canSplit)
+			{
+				decision = TriNext::LEAF;
+				continue;
+			}
+
+			if (m_IsCoherent)
+			{
+				output.lodMargin = std::min(output.lodMargin, distanceMargins[lane]);
+			}
+
+			if ((splitMask >> lane) & 1u)
+			{
+				decision = isContained ? TriNext::SPLIT : TriNext::SPLITCULL;
+			}
+			else
+			{
+				decision = TriNext::LEAF;
+			}
+		}
+	}
+
+#endif
+
+	for (; idx < batch.Size(); ++idx)
+	{
+		decisions[idx] = SplitHeuristic(batch.GetA(idx), batch.GetB(idx), batch.GetC(idx), level, batch.frustumCull[idx] != 0u,
+			outputs[batch.outputIdx[idx]]);
+	}
+}
+
+//---------------------------------
+// Triangulator::BatchedTriangles
+//
+// Breadth first version of RecursiveTriangle for a range of tasks, all triangles of a level are evaluated as one batch before any is split
+//  - tasks all start at the same level, see SplitTasks
+//
+void Triangulator::BatchedTriangles(size_t const firstTask, size_t const lastTask, BatchBuffers& buffers, Output* const outputs) const
+{
+	buffers.current.Clear();
+	for (size_t taskIdx = firstTask; taskIdx < lastTask; ++taskIdx)
+	{
+		Task const& task = m_Tasks[taskIdx];
+		ET_ASSERT(task.level == m_Tasks[firstTask].level);
+
+		buffers.current.Add(task.a, task.b, task.c, task.frustumCull, taskIdx);
+	}
+
+	for (int16 level = m_Tasks[firstTask].level; buffers.current.Size() > 0u; ++level)
+	{
+		TriangleBatch const& current = buffers.current;
+
+		buffers.decisions.resize(current.Size());
+		SplitHeuristicBatch(current, level, outputs, buffers.decisions.data());
+
+		buffers.next.Clear();
+		for (size_t idx = 0u; idx < current.Size(); ++idx)
+		{
+			TriNext const next = buffers.decisions[idx];
+			if (next == CULL) continue;
+
+			vec3 const a = current.GetA(idx);
+			vec3 const b = current.GetB(idx);
+			vec3 const c = current.GetC(idx);
+			size_t const outputIdx = current.outputIdx[idx];
+			if (next == SPLIT || next == SPLITCULL)
+			{
+				vec3 A, B, C;
+				SplitTriangle(a, b, c, A, B, C);
+
+				buffers.next.Add(a, B, C, next == SPLITCULL, outputIdx);//Winding is inverted
+				buffers.next.Add(A, b, C, next == SPLITCULL, outputIdx);//Winding is inverted
+				buffers.next.Add(A, B, c, next == SPLITCULL, outputIdx);//Winding is inverted
+				buffers.next.Add(A, B, C, next == SPLITCULL, outputIdx);
+			}
+			else //put the triangle in the buffer
+			{
+				outputs[outputIdx].positions.push_back(PatchInstance((BYTE)level, a, b-a, c-a));
+			}
+		}
+
+		std::swap(buffers.current, buffers.next);
+	}
+}
+
+//---------------------------------
+// Triangulator::SplitTriangle
+//
+// Midpoints of the edges opposite to each corner, projected onto the sphere
+//
+void Triangulator::SplitTriangle(vec3 const& a, vec3 const& b, vec3 const& c, vec3& A, vec3& B, vec3& C) const
+{
+	//find midpoints
+	A = b + ((c - b)*0.5f);
+	B = c + ((a - c)*0.5f);
+	C = a + ((b - a)*0.5f);
+	//make the distance from center larger according to planet radius
+	A = A * m_Radius / math::length(A);
+	B = B * m_Radius / math::length(B);
+	C = C * m_Radius / math::length(C);
 }
 
 
@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+
 #include "Patch.h"
 #include <EtRendering/GraphicsTypes/Frustum.h>
 
@@ -41,21 +43,113 @@ struct Tri
 	vec3 c;
 };
 
+//---------------------------------
+// Triangulator
+//
+// Subdivides the icosahedron of a planet into patches depending on the distance to the camera, and culls them against the frustum
+//  - subtrees below s_CacheLevel are triangulated on the threads of the job pool, each task writing to its own buffer
+//  - in batched mode groups of tasks are triangulated breadth first, evaluating the split heuristic for each level in SIMD batches
+//  - in coherent mode the output of each subtree is kept between frames, and is only triangulated again if the camera moved far enough
+//    for one of its split or cull decisions to change
+//
 class Triangulator final
 {
+	// definitions
+	//-------------
+	struct Output
+	{
+		void Reset();
+
+		std::vector<PatchInstance> positions;
+		float lodMargin; // how far the camera can move before a backface or distance decision may change
+		float frustumMargin; // how far frustum planes can move relative to the distance from the camera, see FrustumCheck
+		size_t evaluatedCount = 0u; // triangles the split heuristic ran for
+	};
+
+	// output and state of the camera the last time a subtree at the cache level was triangulated
+	struct Subtree
+	{
+		Output output;
+		std::array<vec3, 6u> normals;
+		std::array<float, 6u> offsets; // of the frustum planes relative to the camera, see GetPlaneOffset
+		vec3 position;
+		bool frustumCull = true;
+		bool isValid = false;
+		bool isReached = false;
+	};
+
+	// triangle that is triangulated on a worker thread, along with everything below it
+	struct Task
+	{
+		vec3 a;
+		vec3 b;
+		vec3 c;
+		int16 level;
+		bool frustumCull;
+		size_t subtreeIdx;
+	};
+
+	// triangles of one level in SoA layout, so that the split heuristic can be evaluated for several at once
+	struct TriangleBatch
+	{
+		void Add(vec3 const& a, vec3 const& b, vec3 const& c, bool const cull, size_t const output);
+		void Clear();
+
+		size_t Size() const { return frustumCull.size(); }
+		vec3 GetA(size_t const idx) const { return vec3(ax[idx], ay[idx], az[idx]); }
+		vec3 GetB(size_t const idx) const { return vec3(bx[idx], by[idx], bz[idx]); }
+		vec3 GetC(size_t const idx) const { return vec3(cx[idx], cy[idx], cz[idx]); }
+
+		std::vector<float> ax;
+		std::vector<float> ay;
+		std::vector<float> az;
+		std::vector<float> bx;
+		std::vector<float> by;
+		std::vector<float> bz;
+		std::vector<float> cx;
+		std::vector<float> cy;
+		std::vector<float> cz;
+		std::vector<uint8> frustumCull; // not a vector<bool> so that reading it stays cheap
+		std::vector<size_t> outputIdx; // triangles of several tasks are batched together, each writing to the output of its task
+	};
+
+	// scratch memory of a worker thread for breadth first triangulation
+	struct BatchBuffers
+	{
+		TriangleBatch current;
+		TriangleBatch next;
+		std::vector<TriNext> decisions;
+	};
+
 public:
+	static int16 const s_CacheLevel;
+	static size_t const s_MinTaskCount;
+	static float const s_MarginScale;
+	static size_t const s_BatchSize; // triangles evaluated at once by the batched split heuristic, 8 with AVX, 4 with SSE and 1 otherwise
+	static size_t const s_TasksPerBatch;
+
 	Triangulator() = default;
 	~Triangulator() = default;
 
 	//Member functions
 	void Init(Planet* const planet);
+	void Init(float const radius, float const maxHeight, ivec2 const viewDimensions); // doesn't require a planet or viewport, e.g for benchmarks
 	bool Update(mat4 const& transform, Camera const& camera);
+	bool Update(mat4 const& transform, Camera const& camera, ivec2 const viewDimensions);
 	void GenerateGeometry();
 
 	bool IsFrustumLocked() { return m_LockFrustum; }
 	Frustum& GetFrustum() { return m_Frustum; }
 	Frustum const& GetFrustum() const { return m_Frustum; }
 
+	bool IsCoherent() const { return m_IsCoherent; }
+	void SetCoherent(bool const isCoherent) { m_IsCoherent = isCoherent; }
+	size_t GetTriangulatedSubtreeCount() const { return m_DirtySubtrees.size(); } // in the last call to GenerateGeometry
+
+	bool IsBatched() const { return m_IsBatched; }
+	void SetBatched(bool const isBatched) { m_IsBatched = isBatched; }
+	size_t GetEvaluatedTriangleCount() const { return m_EvaluatedCount; } // in the last call to GenerateGeometry
+
 	std::vector<PatchInstance> const& GetPositions() const { return m_Positions; }
 	std::vector<float> const& GetDistanceLUT() const { return m_DistanceLUT; }
 
@@ -63,8 +157,23 @@ private:
 	friend class Planet;
 
 	void Precalculate();
-	TriNext SplitHeuristic(vec3 &a, vec3 &b, vec3 &c, int16 level, bool frustumCull);
-	void RecursiveTriangle(vec3 a, vec3 b, vec3 c, int16 level, bool frustumCull);
+	bool UpdateCoherence();
+	float GetPlaneOffset(math::Plane const& plane) const;
+	void UpdateBatchPlanes();
+	void TraverseToCacheLevel(vec3 const& a, vec3 const& b, vec3 const& c, int16 const level, bool const frustumCull, size_t const subtreeIdx);
+	bool CanReuse(Subtree const& subtree, bool const frustumCull) const;
+	void SplitTasks();
+	void RunTasks();
+	void GatherPositions();
+
+	TriNext SplitHeuristic(vec3 const& a, vec3 const& b, vec3 const& c, int16 const level, bool const frustumCull, Output& output) const;
+	VolumeCheck FrustumCheck(vec3 const& a, vec3 const& b, vec3 const& c, float const height, float& margin) const;
+	void RecursiveTriangle(vec3 const& a, vec3 const& b, vec3 const& c, int16 const level, bool const frustumCull, Output& output) const;
+
+	void SplitHeuristicBatch(TriangleBatch const& batch, int16 const level, Output* const outputs, TriNext* const decisions) const;
+	void BatchedTriangles(size_t const firstTask, size_t const lastTask, BatchBuffers& buffers, Output* const outputs) const;
+
+	void SplitTriangle(vec3 const& a, vec3 const& b, vec3 const& c, vec3& A, vec3& B, vec3& C) const;
 
 	//Triangulation paramenters
 	float m_AllowedTriPx = 300.f;
@@ -77,10 +186,37 @@ private:
 
 	std::vector<Tri*> m_Leafs;
 
-	Planet* m_Planet = nullptr;
+	float m_Radius = 0.f;
+	float m_MaxHeight = 0.f;
+	ivec2 m_ViewDimensions;
+
 	Frustum m_Frustum;
 	bool m_LockFrustum = false;
 
+	// subtrees and tasks
+	std::vector<Subtree> m_Subtrees; // indexed by icosahedron face and then by child index at each level
+	std::vector<size_t> m_DirtySubtrees;
+	std::vector<Task> m_Tasks;
+	std::vector<Task> m_NextTasks;
+	std::vector<Output> m_TaskOutputs; // kept between frames to reuse their buffers
+	Output m_TopOutput; // leaves above the cache level
+	size_t m_EvaluatedCount = 0u;
+
+	// batched triangulation
+	bool m_IsBatched = true;
+	std::vector<BatchBuffers> m_WorkerBuffers; // one per worker thread, kept between frames
+	std::array<float, 6u> m_PlaneNormalX = {}; // frustum planes in SoA layout, dist = dot(n, p - d)
+	std::array<float, 6u> m_PlaneNormalY = {};
+	std::array<float, 6u> m_PlaneNormalZ = {};
+	std::array<float, 6u> m_PlanePointX = {};
+	std::array<float, 6u> m_PlanePointY = {};
+	std::array<float, 6u> m_PlanePointZ = {};
+
+	// coherence
+	bool m_IsCoherent = true;
+	std::vector<float> m_CoherentDistanceLUT;
+	int32 m_CoherentMaxLevel = -1;
+
 	std::vector<PatchInstance> m_Positions;
 };
 
@@ -0,0 +1,144 @@
+#include "stdafx.h"
+#include "InstanceBuffer.h"
+
+
+namespace et {
+namespace render {
+
+
+//=================
+// Instance Buffer
+//=================
+
+
+// static
+uint32 const InstanceBuffer::s_TransformLocation = 12u;
+uint32 const InstanceBuffer::s_FrameCount = 3u;
+size_t const InstanceBuffer::s_InitialCapacity = 1024u;
+
+
+//---------------------------------
+// InstanceBuffer::d-tor
+//
+InstanceBuffer::~InstanceBuffer()
+{
+	Deinit();
+}
+
+//---------------------------------
+// InstanceBuffer::Initialize
+//
+// Allocate storage for a number of instances per frame
+//
+void InstanceBuffer::Initialize(size_t const capacity)
+{
+	ET_ASSERT(!IsInitialized());
+	ET_ASSERT(capacity > 0u);
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	m_Capacity = capacity;
+	m_Segment = 0u;
+	m_Used = 0u;
+
+	m_Buffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+	api->SetBufferData(E_BufferType::Vertex, static_cast<int64>(m_Capacity * s_FrameCount * sizeof(mat4)), nullptr, E_UsageHint::Dynamic);
+}
+
+//---------------------------------
+// InstanceBuffer::Deinit
+//
+void InstanceBuffer::Deinit()
+{
+	if (IsInitialized())
+	{
+		Viewport::GetCurrentApiContext()->DeleteBuffer(m_Buffer);
+		m_Buffer = 0u;
+	}
+
+	m_Capacity = 0u;
+	m_Used = 0u;
+}
+
+//---------------------------------
+// InstanceBuffer::BeginFrame
+//
+// Move on to the segment that was written the longest time ago
+//
+void InstanceBuffer::BeginFrame()
+{
+	m_Segment = (m_Segment + 1u) % s_FrameCount;
+	m_Used = 0u;
+}
+
+//---------------------------------
+// InstanceBuffer::Map
+//
+// Reserve space for a number of transforms in the current frames segment and map it for writing
+//  - if the segment is full the buffer is reallocated with more space, the driver keeps the old storage alive for pending draws
+//
+mat4* InstanceBuffer::Map(size_t const count, size_t& firstInstance)
+{
+	ET_ASSERT(IsInitialized());
+	ET_ASSERT(count > 0u);
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+
+	if (m_Used + count > m_Capacity)
+	{
+		m_Capacity = std::max(m_Capacity * 2u, m_Used + count);
+		m_Segment = 0u;
+		m_Used = 0u;
+
+		api->SetBufferData(E_BufferType::Vertex, static_cast<int64>(m_Capacity * s_FrameCount * sizeof(mat4)), nullptr, E_UsageHint::Dynamic);
+	}
+
+	firstInstance = m_Segment * m_Capacity + m_Used;
+	m_Used += count;
+
+	return static_cast<mat4*>(api->MapBufferRange(E_BufferType::Vertex, 
+		static_cast<int64>(firstInstance * sizeof(mat4)), 
+		static_cast<int64>(count * sizeof(mat4)), 
+		true));
+}
+
+//---------------------------------
+// InstanceBuffer::Unmap
+//
+void InstanceBuffer::Unmap() const
+{
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+	api->UnmapBuffer(E_BufferType::Vertex);
+}
+
+//---------------------------------
+// InstanceBuffer::SetupAttributes
+//
+// Point the transform attributes of the bound vertex array at the instances starting from firstInstance
+//  - there is no base instance in GL 3.3, so the offset is baked into the attribute pointers instead
+//  - shaders that don't use the attributes ignore them, so they can stay enabled on the vertex array
+//
+void InstanceBuffer::SetupAttributes(size_t const firstInstance) const
+{
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+
+	size_t const offset = firstInstance * sizeof(mat4);
+	for (uint32 column = 0u; column < 4u; ++column)
+	{
+		uint32 const location = s_TransformLocation + column;
+
+		api->SetVertexAttributeArrayEnabled(location, true);
+		api->DefineVertexAttributePointer(location, 4, E_DataType::Float, false, static_cast<int32>(sizeof(mat4)), offset + column * sizeof(vec4));
+		api->DefineVertexAttribDivisor(location, 1u);
+	}
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,62 @@
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// InstanceBuffer
+//
+// Per instance model matrices for instanced draws, streamed into a single vertex buffer
+//  - the buffer is split into one segment per frame in flight, so writes never have to wait for the GPU
+//  - there is no fence based synchronization, this relies on the driver not queuing more than s_FrameCount - 1 frames
+//  - transforms from a mapping need to be drawn before mapping again, as growing the buffer starts a new allocation
+//
+class InstanceBuffer final
+{
+	// definitions
+	//-------------
+public:
+	static uint32 const s_TransformLocation; // first of the 4 attribute locations shaders use for 'model', see DefUberShader
+	static uint32 const s_FrameCount;
+	static size_t const s_InitialCapacity;
+
+	// construct destruct
+	//--------------------
+	InstanceBuffer() = default;
+	~InstanceBuffer();
+
+	InstanceBuffer(InstanceBuffer const&) = delete;
+	InstanceBuffer& operator=(InstanceBuffer const&) = delete;
+
+	void Initialize(size_t const capacity);
+	void Deinit();
+
+	// functionality
+	//---------------
+	void BeginFrame();
+
+	mat4* Map(size_t const count, size_t& firstInstance);
+	void Unmap() const;
+
+	void SetupAttributes(size_t const firstInstance) const;
+
+	// accessors
+	//-----------
+	bool IsInitialized() const { return m_Buffer != 0u; }
+	size_t GetCapacity() const { return m_Capacity; }
+
+	// Data
+	///////
+private:
+	T_BufferLoc m_Buffer = 0u;
+
+	size_t m_Capacity = 0u; // instances per frame segment
+	uint32 m_Segment = 0u;
+	size_t m_Used = 0u;
+};
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,377 @@
+#include "stdafx.h"
+#include "RenderQueue.h"
+
+#include "InstanceBuffer.h"
+
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/GraphicsTypes/Shader.h>
+#include <EtRendering/MaterialSystem/MaterialData.h>
+
+
+namespace et {
+namespace render {
+
+
+//==============
+// Render Queue
+//==============
+
+
+// static
+uint32 const RenderQueue::s_ShaderBits = 12u;
+uint32 const RenderQueue::s_MaterialBits = 16u;
+uint32 const RenderQueue::s_VaoBits = 16u;
+uint32 const RenderQueue::s_DepthBits = 20u;
+
+size_t const RenderQueue::s_MinInstancedRun = 8u;
+
+
+//---------------------------------
+// RenderQueue::MakeKey
+//
+// Ids that don't fit their bit range wrap around, which only costs redundant state changes as submission compares the actual state
+//
+uint64 RenderQueue::MakeKey(E_SortMode const mode, uint32 const shaderId, uint32 const materialId, uint32 const geometryId, float const normalizedDepth)
+{
+	uint64 const shader = static_cast<uint64>(shaderId) & ((1ull << s_ShaderBits) - 1ull);
+	uint64 const material = static_cast<uint64>(materialId) & ((1ull << s_MaterialBits) - 1ull);
+	uint64 const vao = static_cast<uint64>(geometryId) & ((1ull << s_VaoBits) - 1ull);
+
+	uint64 const maxDepth = (1ull << s_DepthBits) - 1ull;
+	uint64 const depth = static_cast<uint64>(math::Clamp01(normalizedDepth) * static_cast<float>(maxDepth));
+
+	switch (mode)
+	{
+	case E_SortMode::StateFrontToBack:
+		return (shader << (s_MaterialBits + s_VaoBits + s_DepthBits))
+			| (material << (s_VaoBits + s_DepthBits))
+			| (vao << s_DepthBits)
+			| depth;
+
+	case E_SortMode::BackToFront:
+		return ((maxDepth - depth) << (s_ShaderBits + s_MaterialBits + s_VaoBits))
+			| (shader << (s_MaterialBits + s_VaoBits))
+			| (material << s_VaoBits)
+			| vao;
+	}
+
+	ET_ASSERT(false, "unhandled sort mode");
+	return 0u;
+}
+
+//---------------------------------
+// RenderQueue::RadixSort
+//
+// Stable LSD radix sort on 8 bit digits, passes in which all keys share the same digit are skipped
+//
+void RenderQueue::RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+{
+	size_t const count = entries.size();
+	if (count < 2u)
+	{
+		return;
+	}
+
+	scratch.resize(count);
+
+	// histograms for all digits in a single pass over the data
+	std::array<std::array<uint32, 256u>, 8u> histograms;
+	for (std::array<uint32, 256u>& histogram : histograms)
+	{
+		histogram.fill(0u);
+	}
+
+	for (SortEntry const& entry : entries)
+	{
+		for (uint32 digit = 0u; digit < 8u; ++digit)
+		{
+			histograms[digit][(entry.key >> (digit * 8u)) & 0xFFu]++;
+		}
+	}
+
+	SortEntry* source = entries.data();
+	SortEntry* target = scratch.data();
+
+	for (uint32 digit = 0u; digit < 8u; ++digit)
+	{
+		std::array<uint32, 256u>& histogram = histograms[digit];
+		if (histogram[(source[0].key >> (digit * 8u)) & 0xFFu] == static_cast<uint32>(count))
+		{
+			continue;
+		}
+
+		// exclusive prefix sum
+		uint32 offset = 0u;
+		for (uint32& bucket : histogram)
+		{
+			uint32 const bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		for (size_t idx = 0u; idx < count; ++idx)
+		{
+			target[histogram[(source[idx].key >> (digit * 8u)) & 0xFFu]++] = source[idx];
+		}
+
+		std::swap(source, target);
+	}
+
+	if (source != entries.data())
+	{
+		entries.swap(scratch);
+	}
+}
+
+//---------------------------------
+// RenderQueue::ProjectRadius
+//
+// Radius of a sphere on screen as a fraction of the viewport height
+//  - r * proj[1][1] / 2w, with w = depth for perspective and 1 for orthographic projections
+//
+float RenderQueue::ProjectRadius(mat4 const& proj, float const viewDepth, float const radius)
+{
+	float const w = std::max(viewDepth * proj[2][3] + proj[3][3], static_cast<float>(ETM_DEFAULT_EPSILON));
+	return radius * proj[1][1] * 0.5f / w;
+}
+
+//---------------------------------
+// RenderQueue::Clear
+//
+// Storage is kept between frames
+//
+void RenderQueue::Clear()
+{
+	m_Packets.clear();
+	m_Entries.clear();
+
+	m_ShaderIds.clear();
+	m_MaterialIds.clear();
+	m_GeometryIds.clear();
+}
+
+//---------------------------------
+// RenderQueue::AddCollectionGroup
+//
+// Cull all mesh instances in a group of material collections against the camera and add packets for the visible ones
+//  - culling runs in batches over the world space bounds the scene keeps per mesh
+//  - visible instances select the coarsest level of detail whose error stays below MeshLod::s_ScreenErrorThreshold
+//
+void RenderQueue::AddCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup,
+	core::slot_map<mat4> const& nodes,
+	Camera const& camera,
+	E_SortMode const mode)
+{
+	FrustumCuller const culler(camera.GetFrustum());
+	vec3 const& camPos = camera.GetPosition();
+	vec3 const& camForward = camera.GetForward();
+	float const depthScale = 1.f / std::max(camera.GetFarPlane(), static_cast<float>(ETM_DEFAULT_EPSILON));
+	mat4 const& proj = camera.GetProj();
+
+	for (MaterialCollection const& collection : collectionGroup)
+	{
+		ShaderData const* const shader = collection.m_Shader.get();
+		uint32 const shaderId = GetId(m_ShaderIds, shader);
+
+		for (MaterialCollection::MaterialInstance const& material : collection.m_Materials)
+		{
+			ET_ASSERT(shader == material.m_Material->GetBaseMaterial()->GetShader());
+
+			uint32 const materialId = GetId(m_MaterialIds, material.m_Material);
+			for (MaterialCollection::Mesh const& mesh : material.m_Meshes)
+			{
+				ET_ASSERT(mesh.m_InstanceBounds.Size() == mesh.m_Instances.size());
+
+				culler.Cull(mesh.m_InstanceBounds, m_Visible);
+				if (m_Visible.empty())
+				{
+					continue;
+				}
+
+				for (uint32 const instIdx : m_Visible)
+				{
+					SphereBounds const& bounds = mesh.m_InstanceBounds;
+					float const viewDepth = math::dot(vec3(bounds.m_X[instIdx], bounds.m_Y[instIdx], bounds.m_Z[instIdx]) - camPos, camForward);
+					float const projectedRadius = ProjectRadius(proj, viewDepth, bounds.m_Radius[instIdx]);
+					uint32 const lodIdx = MeshLod::Select(mesh.m_Lods, projectedRadius, MeshLod::s_ScreenErrorThreshold);
+					MeshLod const& lod = mesh.m_Lods[lodIdx];
+
+					uint32 const geometryId = GetId(m_GeometryIds, (static_cast<uint64>(mesh.m_VAO) << 8u) | static_cast<uint64>(lodIdx));
+					m_Entries.push_back(SortEntry{ MakeKey(mode, shaderId, materialId, geometryId, viewDepth * depthScale), static_cast<uint32>(m_Packets.size()) });
+
+					m_Packets.push_back(DrawPacket());
+					DrawPacket& packet = m_Packets.back();
+					packet.m_Shader = shader;
+					packet.m_Material = material.m_Material;
+					packet.m_VAO = mesh.m_VAO;
+					packet.m_FirstIndex = lod.m_FirstIndex;
+					packet.m_IndexCount = lod.m_IndexCount;
+					packet.m_IndexDataType = mesh.m_IndexDataType;
+					packet.m_Transform = &nodes[mesh.m_Instances[instIdx]];
+				}
+			}
+		}
+	}
+}
+
+//---------------------------------
+// RenderQueue::Sort
+//
+void RenderQueue::Sort()
+{
+	ET_PROFILE_ZONE("RenderQueue::Sort");
+
+	RadixSort(m_Entries, m_SortScratch);
+}
+
+//---------------------------------
+// RenderQueue::Submit
+//
+// Draw all packets in key order, only changing state that differs from the previous packet
+//  - without an instance buffer every packet is drawn individually
+//
+void RenderQueue::Submit(InstanceBuffer* const instanceBuffer)
+{
+	ET_PROFILE_ZONE("RenderQueue::Submit");
+
+	GatherRuns(instanceBuffer);
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	ShaderData const* currentShader = nullptr;
+	ShaderData::UniformHandle modelHandle;
+	I_Material const* currentMaterial = nullptr;
+	T_ArrayLoc currentVao = 0u;
+
+	for (DrawRun const& run : m_Runs)
+	{
+		DrawPacket const& packet = m_Packets[m_Entries[run.firstEntry].packet];
+
+		ShaderData const* const shader = run.isInstanced ? packet.m_Shader->GetInstancedVariant() : packet.m_Shader;
+		if (shader != currentShader)
+		{
+			currentShader = shader;
+			modelHandle = currentShader->GetUniformHandle("model"_hash);
+			currentMaterial = nullptr; // parameters need to be uploaded to the new shader
+			api->SetShader(currentShader);
+		}
+
+		if (packet.m_Material != currentMaterial)
+		{
+			currentMaterial = packet.m_Material;
+			currentShader->UploadParameterBlock(currentMaterial->GetParameters(), currentMaterial->GetParameterBuffer());
+		}
+
+		if (packet.m_VAO != currentVao)
+		{
+			currentVao = packet.m_VAO;
+			api->BindVertexArray(currentVao);
+		}
+
+		if (run.isInstanced)
+		{
+			instanceBuffer->SetupAttributes(run.firstInstance);
+			api->DrawElementsInstanced(E_DrawMode::Triangles, 
+				packet.m_IndexCount, 
+				packet.m_IndexDataType, 
+				MeshLod::GetIndexOffset(packet.m_FirstIndex, packet.m_IndexDataType), 
+				static_cast<uint32>(run.count));
+			continue;
+		}
+
+		for (size_t entryIdx = run.firstEntry; entryIdx < run.firstEntry + run.count; ++entryIdx)
+		{
+			DrawPacket const& runPacket = m_Packets[m_Entries[entryIdx].packet];
+
+			currentShader->Upload(modelHandle, *runPacket.m_Transform);
+			api->DrawElements(E_DrawMode::Triangles, 
+				runPacket.m_IndexCount, 
+				runPacket.m_IndexDataType, 
+				MeshLod::GetIndexOffset(runPacket.m_FirstIndex, runPacket.m_IndexDataType));
+		}
+	}
+}
+
+//---------------------------------
+// RenderQueue::GatherRuns
+//
+// Split the sorted entries into runs of identical state, and write the transforms of all instanced runs in a single mapping
+//
+void RenderQueue::GatherRuns(InstanceBuffer* const instanceBuffer)
+{
+	m_Runs.clear();
+
+	size_t instanceCount = 0u;
+	for (size_t entryIdx = 0u; entryIdx < m_Entries.size();)
+	{
+		DrawPacket const& packet = m_Packets[m_Entries[entryIdx].packet];
+
+		DrawRun run;
+		run.firstEntry = entryIdx;
+
+		for (++entryIdx; entryIdx < m_Entries.size(); ++entryIdx)
+		{
+			DrawPacket const& next = m_Packets[m_Entries[entryIdx].packet];
+			if ((next.m_Shader != packet.m_Shader) 
+				|| (next.m_Material != packet.m_Material) 
+				|| (next.m_VAO != packet.m_VAO) 
+				|| (next.m_FirstIndex != packet.m_FirstIndex))
+			{
+				break;
+			}
+		}
+
+		run.count = entryIdx - run.firstEntry;
+		run.isInstanced = (instanceBuffer != nullptr) 
+			&& (run.count >= s_MinInstancedRun) 
+			&& (packet.m_Shader->GetInstancedVariant() != nullptr);
+
+		if (run.isInstanced)
+		{
+			instanceCount += run.count;
+		}
+
+		m_Runs.push_back(run);
+	}
+
+	if (instanceCount == 0u)
+	{
+		return;
+	}
+
+	size_t firstInstance = 0u;
+	mat4* const transforms = instanceBuffer->Map(instanceCount, firstInstance);
+	ET_ASSERT(transforms != nullptr);
+
+	mat4* target = transforms;
+	for (DrawRun& run : m_Runs)
+	{
+		if (!run.isInstanced)
+		{
+			continue;
+		}
+
+		run.firstInstance = firstInstance + static_cast<size_t>(target - transforms);
+		for (size_t entryIdx = run.firstEntry; entryIdx < run.firstEntry + run.count; ++entryIdx)
+		{
+			*target++ = *m_Packets[m_Entries[entryIdx].packet].m_Transform;
+		}
+	}
+
+	instanceBuffer->Unmap();
+}
+
+//---------------------------------
+// RenderQueue::GetId
+//
+// Dense per frame id in order of first appearance
+//
+template <typename TKey>
+uint32 RenderQueue::GetId(std::unordered_map<TKey, uint32>& ids, TKey const key)
+{
+	return ids.emplace(key, static_cast<uint32>(ids.size())).first->second;
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,135 @@
+#pragma once
+#include <unordered_map>
+
+#include <EtRendering/SceneStructure/MaterialCollection.h>
+
+
+namespace et {
+namespace render {
+
+
+class Camera;
+class InstanceBuffer;
+
+
+//---------------------------------
+// DrawPacket
+//
+// Everything needed to submit a single mesh instance, gathered from the scene structure
+//
+struct DrawPacket final
+{
+	ShaderData const* m_Shader = nullptr;
+	I_Material const* m_Material = nullptr;
+	T_ArrayLoc m_VAO = 0u;
+	uint32 m_FirstIndex = 0u; // of the selected level of detail
+	uint32 m_IndexCount = 0u;
+	E_DataType m_IndexDataType = E_DataType::UInt;
+	mat4 const* m_Transform = nullptr;
+};
+
+
+//---------------------------------
+// RenderQueue
+//
+// Flat list of visible draw packets that is ordered by a 64 bit sort key before submission
+//  - the key packs shader | material | geometry | depth, so that sorting groups state changes and orders by depth within a group
+//  - geometry identifies a VAO and level of detail, which is selected per instance from the size of its bounding sphere on screen
+//  - for blended geometry depth moves to the most significant bits to draw back to front
+//  - ids in the key are assigned per frame in order of appearance, the key only needs to group identical state together
+//  - long runs of packets with identical state are drawn with a single instanced call if the shader has an instanced variant
+//
+class RenderQueue final
+{
+	// definitions
+	//-------------
+public:
+	//---------------------------------
+	// E_SortMode
+	//
+	enum class E_SortMode : uint8
+	{
+		StateFrontToBack, // opaque - minimize state changes, then reduce overdraw
+		BackToFront // blended - correct ordering, then state
+	};
+
+	//---------------------------------
+	// SortEntry
+	//
+	struct SortEntry final
+	{
+		uint64 key;
+		uint32 packet;
+	};
+
+	//---------------------------------
+	// DrawRun
+	//
+	// Consecutive sorted entries that share shader, material, VAO and level of detail
+	//
+	struct DrawRun final
+	{
+		size_t firstEntry = 0u;
+		size_t count = 0u;
+		bool isInstanced = false;
+		size_t firstInstance = 0u; // in the instance buffer
+	};
+
+	static uint32 const s_ShaderBits;
+	static uint32 const s_MaterialBits;
+	static uint32 const s_VaoBits;
+	static uint32 const s_DepthBits;
+
+	static size_t const s_MinInstancedRun;
+
+	// static functionality
+	//----------------------
+	static uint64 MakeKey(E_SortMode const mode, uint32 const shaderId, uint32 const materialId, uint32 const geometryId, float const normalizedDepth);
+	static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+	static float ProjectRadius(mat4 const& proj, float const viewDepth, float const radius);
+
+	// construct destruct
+	//--------------------
+	RenderQueue() = default;
+
+	// functionality
+	//---------------
+	void Clear();
+	void AddCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup,
+		core::slot_map<mat4> const& nodes,
+		Camera const& camera,
+		E_SortMode const mode);
+	void Sort();
+	void Submit(InstanceBuffer* const instanceBuffer);
+
+	// accessors
+	//-----------
+	std::vector<DrawPacket> const& GetPackets() const { return m_Packets; }
+	std::vector<SortEntry> const& GetEntries() const { return m_Entries; }
+	std::vector<DrawRun> const& GetRuns() const { return m_Runs; } // from the last submission
+
+	// utility
+	//---------
+private:
+	template <typename TKey>
+	static uint32 GetId(std::unordered_map<TKey, uint32>& ids, TKey const key);
+
+	void GatherRuns(InstanceBuffer* const instanceBuffer);
+
+	// Data
+	///////
+
+	std::vector<DrawPacket> m_Packets;
+	std::vector<SortEntry> m_Entries;
+	std::vector<SortEntry> m_SortScratch;
+	std::vector<uint32> m_Visible;
+	std::vector<DrawRun> m_Runs;
+
+	std::unordered_map<ShaderData const*, uint32> m_ShaderIds;
+	std::unordered_map<I_Material const*, uint32> m_MaterialIds;
+	std::unordered_map<uint64, uint32> m_GeometryIds; // < VAO | LOD >
+};
+
+
+} // namespace render
+} // namespace et
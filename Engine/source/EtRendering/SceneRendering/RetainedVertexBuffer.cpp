@@ -0,0 +1,150 @@
+#include "stdafx.h"
+#include "RetainedVertexBuffer.h"
+
+
+namespace et {
+namespace render {
+
+
+//========================
+// Retained Vertex Buffer
+//========================
+
+
+// static
+size_t const RetainedVertexBuffer::s_InitialCapacity = 256u;
+
+
+//---------------------------------
+// RetainedVertexBuffer::FindChangedRange
+//
+// Range of vertices in current that differ from previous, returns false if nothing needs to be written
+//  - vertices past the end of previous always count as changed, shrinking alone doesn't require a write
+//
+bool RetainedVertexBuffer::FindChangedRange(uint8 const* const previous,
+	size_t const previousCount,
+	uint8 const* const current,
+	size_t const currentCount,
+	size_t const stride,
+	size_t& first,
+	size_t& count)
+{
+	size_t const common = std::min(previousCount, currentCount);
+
+	size_t begin = 0u;
+	while ((begin < common) && (memcmp(previous + begin * stride, current + begin * stride, stride) == 0))
+	{
+		++begin;
+	}
+
+	size_t end = currentCount;
+	if (currentCount <= previousCount)
+	{
+		while ((end > begin) && (memcmp(previous + (end - 1u) * stride, current + (end - 1u) * stride, stride) == 0))
+		{
+			--end;
+		}
+	}
+
+	if (end <= begin)
+	{
+		return false;
+	}
+
+	first = begin;
+	count = end - begin;
+	return true;
+}
+
+//---------------------------------
+// RetainedVertexBuffer::d-tor
+//
+RetainedVertexBuffer::~RetainedVertexBuffer()
+{
+	Deinit();
+}
+
+//---------------------------------
+// RetainedVertexBuffer::Initialize
+//
+void RetainedVertexBuffer::Initialize(size_t const stride)
+{
+	ET_ASSERT(!IsInitialized());
+	ET_ASSERT(stride > 0u);
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+
+	m_Stride = stride;
+	m_Capacity = s_InitialCapacity;
+	m_Uploaded.clear();
+
+	m_Buffer = api->CreateBuffer();
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+	api->SetBufferData(E_BufferType::Vertex, static_cast<int64>(m_Capacity * m_Stride), nullptr, E_UsageHint::Dynamic);
+}
+
+//---------------------------------
+// RetainedVertexBuffer::Deinit
+//
+void RetainedVertexBuffer::Deinit()
+{
+	if (IsInitialized())
+	{
+		Viewport::GetCurrentApiContext()->DeleteBuffer(m_Buffer);
+		m_Buffer = 0u;
+	}
+
+	m_Capacity = 0u;
+	m_Uploaded.clear();
+}
+
+//---------------------------------
+// RetainedVertexBuffer::Upload
+//
+// Make the first count vertices in the buffer match the input
+//  - growing reallocates the storage, after which everything is written again
+//
+void RetainedVertexBuffer::Upload(void const* const vertices, size_t const count)
+{
+	ET_ASSERT(IsInitialized());
+
+	uint8 const* const data = static_cast<uint8 const*>(vertices);
+	size_t const previousCount = m_Uploaded.size() / m_Stride;
+
+	size_t first = 0u;
+	size_t changed = 0u;
+	if (!FindChangedRange(m_Uploaded.data(), previousCount, data, count, m_Stride, first, changed))
+	{
+		m_Uploaded.resize(count * m_Stride);
+		return;
+	}
+
+	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+	api->BindBuffer(E_BufferType::Vertex, m_Buffer);
+
+	if (count > m_Capacity)
+	{
+		m_Capacity = std::max(m_Capacity * 2u, count);
+		api->SetBufferData(E_BufferType::Vertex, static_cast<int64>(m_Capacity * m_Stride), nullptr, E_UsageHint::Dynamic);
+
+		first = 0u;
+		changed = count;
+	}
+
+	size_t const offset = first * m_Stride;
+	size_t const size = changed * m_Stride;
+
+	void* const mapped = api->MapBufferRange(E_BufferType::Vertex, static_cast<int64>(offset), static_cast<int64>(size), false);
+	ET_ASSERT(mapped != nullptr);
+	memcpy(mapped, data + offset, size);
+	api->UnmapBuffer(E_BufferType::Vertex);
+
+	m_Uploaded.resize(count * m_Stride);
+	memcpy(m_Uploaded.data() + offset, data + offset, size);
+
+	api->BindBuffer(E_BufferType::Vertex, 0u);
+}
+
+
+} // namespace render
+} // namespace et
@@ -0,0 +1,66 @@
+#pragma once
+
+
+namespace et {
+namespace render {
+
+
+//---------------------------------
+// RetainedVertexBuffer
+//
+// Vertex buffer for data that is rebuilt on the CPU every frame but mostly stays the same, like sprites and text
+//  - keeps a copy of the last uploaded vertices and only writes the range between the first and last vertex that changed
+//  - the buffer object stays the same when it grows, so vertex arrays that reference it don't need to be set up again
+//
+class RetainedVertexBuffer final
+{
+	// definitions
+	//-------------
+public:
+	static size_t const s_InitialCapacity;
+
+	// static functionality
+	//----------------------
+	static bool FindChangedRange(uint8 const* const previous,
+		size_t const previousCount,
+		uint8 const* const current,
+		size_t const currentCount,
+		size_t const stride,
+		size_t& first,
+		size_t& count);
+
+	// construct destruct
+	//--------------------
+	RetainedVertexBuffer() = default;
+	~RetainedVertexBuffer();
+
+	RetainedVertexBuffer(RetainedVertexBuffer const&) = delete;
+	RetainedVertexBuffer& operator=(RetainedVertexBuffer const&) = delete;
+
+	void Initialize(size_t const stride); // leaves the buffer bound so vertex attributes can be defined
+	void Deinit();
+
+	// functionality
+	//---------------
+	void Upload(void const* const vertices, size_t const count);
+
+	// accessors
+	//-----------
+	bool IsInitialized() const { return m_Buffer != 0u; }
+	T_BufferLoc GetBuffer() const { return m_Buffer; }
+	size_t GetCapacity() const { return m_Capacity; }
+
+	// Data
+	///////
+private:
+	T_BufferLoc m_Buffer = 0u;
+
+	size_t m_Stride = 0u;
+	size_t m_Capacity = 0u; // in vertices
+
+	std::vector<uint8> m_Uploaded;
+};
+
+
+} // namespace render
+} // namespace et
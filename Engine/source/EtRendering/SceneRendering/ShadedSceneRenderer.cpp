@@ -84,6 +84,8 @@ void ShadedSceneRenderer::InitRenderingSystems()
 
 	m_SSR.Initialize();
 
+	m_InstanceBuffer.Initialize(InstanceBuffer::s_InitialCapacity);
+
 	m_ClearColor = vec3(200.f / 255.f, 114.f / 255.f, 200.f / 255.f)*0.0f;
 
 	m_SkyboxShader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("FwdSkyboxShader.glsl"));
@@ -119,8 +121,12 @@ void ShadedSceneRenderer::OnResize(ivec2 const dim)
 //
 void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 {
+	ET_PROFILE_ZONE("ShadedSceneRenderer::OnRender");
+
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
+	m_InstanceBuffer.BeginFrame();
+
 	// Global variables for all rendering systems
 	//********************************************
 	RenderingSystems::Instance()->GetSharedVarController().UpdataData(m_Camera, m_GBuffer);
@@ -180,11 +186,12 @@ void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 	// render opaque objects to GBuffer
 	api->DebugPushGroup("opaque objects");
 	api->SetCullEnabled(true);
-	DrawMaterialCollectionGroup(m_RenderScene->GetOpaqueRenderables());
+	DrawMaterialCollectionGroup(m_RenderScene->GetOpaqueRenderables(), RenderQueue::E_SortMode::StateFrontToBack);
 	api->DebugPopGroup();
 
 	api->DebugPushGroup("extensions");
-	m_Events.Notify(E_RenderEvent::RenderDeferred, new RenderEventData(this, m_GBuffer.Get()));
+	RenderEventData const deferredEvent(this, m_GBuffer.Get());
+	m_Events.Notify(E_RenderEvent::RenderDeferred, &deferredEvent);
 	api->DebugPopGroup();
 
 	api->DebugPopGroup();
@@ -264,7 +271,8 @@ void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 	api->DebugPopGroup(); // light volumes
 
 	api->DebugPushGroup("extensions");
-	m_Events.Notify(E_RenderEvent::RenderLights, new RenderEventData(this, m_SSR.GetTargetFBO()));
+	RenderEventData const lightsEvent(this, m_SSR.GetTargetFBO());
+	m_Events.Notify(E_RenderEvent::RenderLights, &lightsEvent);
 	api->DebugPopGroup(); 
 
 	// draw SSR
@@ -314,11 +322,12 @@ void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 	// forward rendering
 	api->DebugPushGroup("forward renderables");
 	api->SetCullEnabled(true);
-	DrawMaterialCollectionGroup(m_RenderScene->GetForwardRenderables());
+	DrawMaterialCollectionGroup(m_RenderScene->GetForwardRenderables(), RenderQueue::E_SortMode::BackToFront);
 	api->DebugPopGroup();
 
 	api->DebugPushGroup("extensions");
-	m_Events.Notify(E_RenderEvent::RenderForward, new RenderEventData(this, m_PostProcessing.GetTargetFBO()));
+	RenderEventData const forwardEvent(this, m_PostProcessing.GetTargetFBO());
+	m_Events.Notify(E_RenderEvent::RenderForward, &forwardEvent);
 	api->DebugPopGroup();
 	
 	// draw atmospheres
@@ -373,28 +382,122 @@ void ShadedSceneRenderer::OnRender(T_FbLoc const targetFb)
 //---------------------------------
 // ShadedSceneRenderer::DrawShadow
 //
-// Render the scene to the depth buffer of the current framebuffer
+// Render the shadow casters of a cascade to the depth buffer of the current framebuffer
+//  - casters are culled against the cascades light projection instead of the camera, so casters outside of the view still cast into it
+//  - the caster list is kept until the light projection changes or any caster is added, removed or moved, the projection is snapped to shadow map texels so it stays the same while the camera is still
+//  - casters select a level of detail from their size in the shadow map, with a larger error threshold than the camera view
+//  - meshes with enough visible casters are drawn instanced with the null shaders instanced variant
 //
-void ShadedSceneRenderer::DrawShadow(I_Material const* const nullMaterial)
+void ShadedSceneRenderer::DrawShadow(I_Material const* const nullMaterial, DirectionalShadowData::CascadeData& cascade)
 {
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
+	MaterialCollection::MaterialInstance const& shadowCasters = m_RenderScene->GetShadowCasters();
+	DirectionalShadowData::CasterList& casters = cascade.casters;
+
+	uint32 const revision = m_RenderScene->GetShadowCasterRevision();
+	if (!casters.IsValid(cascade.lightVP, revision))
+	{
+		ET_PROFILE_ZONE("ShadedSceneRenderer::CullShadowCasters");
+
+		casters.lightVP = cascade.lightVP;
+		casters.revision = revision;
+		casters.meshes.clear();
+		casters.instances.clear();
+
+		FrustumCuller culler;
+		culler.SetViewProjection(cascade.lightVP);
+
+		// the light projection is orthographic, so the size in the shadow map only depends on the vertical scale of the projection
+		mat4 const& lightVP = cascade.lightVP;
+		float const radiusScale = math::length(vec3(lightVP[0][1], lightVP[1][1], lightVP[2][1])) * 0.5f;
+		float const threshold = MeshLod::s_ScreenErrorThreshold * MeshLod::s_ShadowErrorScale;
+
+		for (auto meshIt = shadowCasters.m_Meshes.cbegin(); meshIt != shadowCasters.m_Meshes.cend(); ++meshIt)
+		{
+			culler.Cull(meshIt->m_InstanceBounds, m_VisibleCasters);
+			if (m_VisibleCasters.empty())
+			{
+				continue;
+			}
+
+			uint32 const meshId = static_cast<uint32>(shadowCasters.m_Meshes.iterator_id(meshIt));
+
+			m_CasterLods.clear();
+			for (uint32 const instIdx : m_VisibleCasters)
+			{
+				m_CasterLods.emplace_back(MeshLod::Select(meshIt->m_Lods, meshIt->m_InstanceBounds.m_Radius[instIdx] * radiusScale, threshold));
+			}
+
+			// group instances by level of detail
+			for (uint32 lodIdx = 0u; lodIdx < static_cast<uint32>(meshIt->m_Lods.size()); ++lodIdx)
+			{
+				size_t const groupStart = casters.instances.size();
+				for (size_t visibleIdx = 0u; visibleIdx < m_VisibleCasters.size(); ++visibleIdx)
+				{
+					if (m_CasterLods[visibleIdx] == lodIdx)
+					{
+						casters.instances.emplace_back(m_VisibleCasters[visibleIdx]);
+					}
+				}
+
+				if (casters.instances.size() > groupStart)
+				{
+					casters.meshes.push_back(DirectionalShadowData::CasterList::MeshGroup{ 
+						meshId, 
+						lodIdx, 
+						static_cast<uint32>(casters.instances.size() - groupStart) 
+					});
+				}
+			}
+		}
+	}
+
 	// No need to set shaders or upload material parameters as that is the calling functions responsibility
-	for (MaterialCollection::Mesh const& mesh : m_RenderScene->GetShadowCasters().m_Meshes)
+	ShaderData const* const shader = nullMaterial->GetBaseMaterial()->GetShader();
+	ShaderData const* const instancedShader = shader->GetInstancedVariant();
+	ShaderData::UniformHandle const modelHandle = shader->GetUniformHandle("model"_hash);
+	core::slot_map<mat4> const& nodes = m_RenderScene->GetNodes();
+
+	size_t instanceIdx = 0u;
+	T_ArrayLoc currentVao = 0u;
+	for (DirectionalShadowData::CasterList::MeshGroup const& group : casters.meshes)
 	{
-		api->BindVertexArray(mesh.m_VAO);
-		for (T_NodeId const node : mesh.m_Instances)
+		MaterialCollection::Mesh const& mesh = shadowCasters.m_Meshes[group.mesh];
+		if (mesh.m_VAO != currentVao)
 		{
-			// #todo: collect a list of transforms and draw this instanced
-			mat4 const& transform = m_RenderScene->GetNodes()[node];
-			math::Sphere instSphere = math::Sphere((transform * vec4(mesh.m_BoundingVolume.pos, 1.f)).xyz,
-				math::length(math::decomposeScale(transform)) * mesh.m_BoundingVolume.radius);
+			currentVao = mesh.m_VAO;
+			api->BindVertexArray(currentVao);
+		}
 
-			if (true) // #todo: light frustum check
+		MeshLod const& lod = mesh.m_Lods[group.lod];
+		void const* const indexOffset = MeshLod::GetIndexOffset(lod.m_FirstIndex, mesh.m_IndexDataType);
+
+		size_t const meshEnd = instanceIdx + group.count;
+		if ((instancedShader != nullptr) && (group.count >= RenderQueue::s_MinInstancedRun))
+		{
+			size_t firstInstance = 0u;
+			mat4* transforms = m_InstanceBuffer.Map(group.count, firstInstance);
+			for (; instanceIdx < meshEnd; ++instanceIdx)
 			{
-				nullMaterial->GetBaseMaterial()->GetShader()->Upload("model"_hash, transform);
-				api->DrawElements(E_DrawMode::Triangles, mesh.m_IndexCount, mesh.m_IndexDataType, 0);
+				*transforms++ = nodes[mesh.m_Instances[casters.instances[instanceIdx]]];
 			}
+
+			m_InstanceBuffer.Unmap();
+			m_InstanceBuffer.SetupAttributes(firstInstance);
+
+			api->SetShader(instancedShader);
+			instancedShader->Upload("worldViewProj"_hash, cascade.lightVP);
+			api->DrawElementsInstanced(E_DrawMode::Triangles, lod.m_IndexCount, mesh.m_IndexDataType, indexOffset, group.count);
+			api->SetShader(shader);
+
+			continue;
+		}
+
+		for (; instanceIdx < meshEnd; ++instanceIdx)
+		{
+			shader->Upload(modelHandle, nodes[mesh.m_Instances[casters.instances[instanceIdx]]]);
+			api->DrawElements(E_DrawMode::Triangles, lod.m_IndexCount, mesh.m_IndexDataType, indexOffset);
 		}
 	}
 }
@@ -402,39 +505,16 @@ void ShadedSceneRenderer::DrawShadow(I_Material const* const nullMaterial)
 //--------------------------------------------------
 // ShadedSceneRenderer::DrawMaterialCollectionGroup
 //
-// Draws all meshes in a list of shaders
+// Collects visible meshes of a group of collections into the render queue, and draws them in sorted order
 //
-void ShadedSceneRenderer::DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup)
+void ShadedSceneRenderer::DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup, RenderQueue::E_SortMode const sortMode)
 {
-	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+	ET_PROFILE_ZONE("ShadedSceneRenderer::DrawMaterialCollectionGroup");
 
-	for (MaterialCollection const& collection : collectionGroup)
-	{
-		api->SetShader(collection.m_Shader.get());
-		for (MaterialCollection::MaterialInstance const& material : collection.m_Materials)
-		{
-			ET_ASSERT(collection.m_Shader.get() == material.m_Material->GetBaseMaterial()->GetShader());
-
-			collection.m_Shader->UploadParameterBlock(material.m_Material->GetParameters());
-			for (MaterialCollection::Mesh const& mesh : material.m_Meshes)
-			{
-				api->BindVertexArray(mesh.m_VAO);
-				for (T_NodeId const node : mesh.m_Instances)
-				{
-					// #todo: collect a list of transforms and draw this instanced
-					mat4 const& transform = m_RenderScene->GetNodes()[node];
-					math::Sphere instSphere = math::Sphere((transform * vec4(mesh.m_BoundingVolume.pos, 1.f)).xyz, 
-						math::length(math::decomposeScale(transform)) * mesh.m_BoundingVolume.radius);
-
-					if (m_Camera.GetFrustum().ContainsSphere(instSphere) != VolumeCheck::OUTSIDE)
-					{
-						collection.m_Shader->Upload("model"_hash, transform);
-						api->DrawElements(E_DrawMode::Triangles, mesh.m_IndexCount, mesh.m_IndexDataType, 0);
-					}
-				}
-			}
-		}
-	}
+	m_RenderQueue.Clear();
+	m_RenderQueue.AddCollectionGroup(collectionGroup, m_RenderScene->GetNodes(), m_Camera, sortMode);
+	m_RenderQueue.Sort();
+	m_RenderQueue.Submit(&m_InstanceBuffer);
 }
 
 //-----------------------------------
@@ -452,7 +532,8 @@ void ShadedSceneRenderer::DrawOverlays(T_FbLoc const targetFb)
 	m_TextRenderer.Draw();
 
 	api->DebugPushGroup("extensions");
-	m_Events.Notify(E_RenderEvent::RenderOutlines, new RenderEventData(this, targetFb));
+	RenderEventData const eventData(this, targetFb);
+	m_Events.Notify(E_RenderEvent::RenderOutlines, &eventData);
 	api->DebugPopGroup(); // extensions
 
 	api->DebugPopGroup(); // draw overlays
@@ -6,6 +6,8 @@
 #include "PostProcessingRenderer.h"
 #include "TextRenderer.h"
 #include "SpriteRenderer.h"
+#include "RenderQueue.h"
+#include "InstanceBuffer.h"
 
 #include <EtRendering/GraphicsTypes/Camera.h>
 #include <EtRendering/GraphicsContext/ViewportRenderer.h>
@@ -51,7 +53,7 @@ protected:
 	// Shadow Renderer Interface
 	//-----------------------------
 public:
-	void DrawShadow(I_Material const* const nullMaterial) override;
+	void DrawShadow(I_Material const* const nullMaterial, DirectionalShadowData::CascadeData& cascade) override;
 
 	Camera const& GetCamera() const override { return m_Camera; }
 
@@ -77,7 +79,7 @@ public:
 	// utility
 	//---------
 private:
-	void DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup);
+	void DrawMaterialCollectionGroup(core::slot_map<MaterialCollection> const& collectionGroup, RenderQueue::E_SortMode const sortMode);
 
 	// Data
 	///////
@@ -91,6 +93,10 @@ private:
 	Camera m_Camera;
 
 	render::Scene* m_RenderScene = nullptr;
+	RenderQueue m_RenderQueue; // reused between passes to keep allocations
+	InstanceBuffer m_InstanceBuffer;
+	std::vector<uint32> m_VisibleCasters;
+	std::vector<uint32> m_CasterLods; // per visible caster
 
 	ShadowRenderer m_ShadowRenderer;
 	Gbuffer m_GBuffer;
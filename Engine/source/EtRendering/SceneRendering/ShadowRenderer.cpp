@@ -30,6 +30,46 @@ void ShadowRenderer::Initialize()
 	m_Shader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("FwdNullShader.glsl"));
 }
 
+//---------------------------------
+// ShadowRenderer::FitCascadeProjection
+//
+// Orthographic projection around the corners of a cascade in light space, which only changes when the camera moved by at least a shadow map texel
+//  - the cascade is fit into a sphere, so that the size of the projection doesn't change as the camera rotates
+//  - the projection center is snapped to texel increments, and the far plane to increments of the projection size
+//  - this keeps shadow edges from shimmering, and allows caster lists to be reused while the camera doesn't move
+//
+mat4 ShadowRenderer::FitCascadeProjection(std::vector<vec3> const& cascadeCorners, float const zNear, ivec2 const resolution)
+{
+	static float const s_Mult = 0.25f;
+	static float const s_RadiusQuantization = 16.f; // keeps floating point noise from changing the projection size
+
+	vec3 center;
+	for (vec3 const& corner : cascadeCorners)
+	{
+		center = center + corner;
+	}
+
+	center = center / static_cast<float>(cascadeCorners.size());
+
+	float radius = 0.f;
+	float zFar = std::numeric_limits<float>::lowest();
+	for (vec3 const& corner : cascadeCorners)
+	{
+		radius = std::max(radius, math::distance(corner, center));
+		zFar = std::max(zFar, corner.z);
+	}
+
+	radius = std::ceil(radius * s_RadiusQuantization) / s_RadiusQuantization;
+
+	float const extent = radius * s_Mult;
+	vec2 const texelSize = vec2(2.f * extent) / math::vecCast<float>(resolution);
+
+	vec2 const snapped(std::floor((center.x * s_Mult) / texelSize.x) * texelSize.x, std::floor((center.y * s_Mult) / texelSize.y) * texelSize.y);
+	zFar = std::ceil((zFar * s_Mult) / (2.f * extent)) * (2.f * extent);
+
+	return math::orthographic(snapped.x - extent, snapped.x + extent, snapped.y - extent, snapped.y + extent, zNear, zFar);
+}
+
 //---------------------------------
 // ShadowRenderer::MapDirectional
 //
@@ -69,32 +109,16 @@ void ShadowRenderer::MapDirectional(mat4 const& lightTransform, DirectionalShado
 		cascade.push_back(corners.fc + (corners.fc - corners.nc)*cascadeEnd);
 		cascade.push_back(corners.fd + (corners.fd - corners.nd)*cascadeEnd);
 
-		float left = std::numeric_limits<float>::max();
-		float right = std::numeric_limits<float>::lowest();
-		float bottom = std::numeric_limits<float>::max();
-		float top = std::numeric_limits<float>::lowest();
-		float zFar = std::numeric_limits<float>::lowest();
-
 		float zNear = -graphicsSettings.CSMDrawDistance;//temp, should be calculated differently
 
-		for (size_t j = 0; j < cascade.size(); j++)
-		{
-			if (cascade[j].x < left) left = cascade[j].x;
-			if (cascade[j].x > right) right = cascade[j].x;
-			if (cascade[j].y < bottom) bottom = cascade[j].y;
-			if (cascade[j].y > top) top = cascade[j].y;
-			if (cascade[j].z > zFar) zFar = cascade[j].z;
-		}
-
-		float mult = 0.25f;
-		mat4 lightProjection = math::orthographic(left*mult, right*mult, bottom*mult, top*mult, zNear, zFar*mult);
+		ivec2 res = cascades[i].texture->GetResolution();
+		mat4 lightProjection = FitCascadeProjection(cascade, zNear, res);
 
 		//view projection
 		mat4 lightVP = lightView * lightProjection;
 		cascades[i].lightVP = lightVP;
 
 		//Set viewport
-		ivec2 res = cascades[i].texture->GetResolution();
 		api->SetViewport(ivec2(0), res);
 		//Set Framebuffer
 		api->BindFramebuffer(cascades[i].fbo);
@@ -105,7 +129,7 @@ void ShadowRenderer::MapDirectional(mat4 const& lightTransform, DirectionalShado
 		m_Shader->Upload("worldViewProj"_hash, lightVP);
 
 		//Draw scene with light matrix and null material
-		shadowRenderer->DrawShadow(RenderingSystems::Instance()->GetNullMaterial());
+		shadowRenderer->DrawShadow(RenderingSystems::Instance()->GetNullMaterial(), cascades[i]);
 	}
 }
 
@@ -20,9 +20,13 @@ class DirectionalShadowData;
 //
 class ShadowRenderer final
 {
+	// static functionality
+	//----------------------
+public:
+	static mat4 FitCascadeProjection(std::vector<vec3> const& cascadeCorners, float const zNear, ivec2 const resolution);
+
 	// construct destruct
 	//---------------------
-public:
 	ShadowRenderer() = default;
 	~ShadowRenderer() = default;
 
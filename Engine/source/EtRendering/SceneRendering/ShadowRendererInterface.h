@@ -1,4 +1,5 @@
 #pragma once
+#include <EtRendering/GraphicsTypes/DirectionalShadowData.h>
 
 
 namespace et {
@@ -13,13 +14,14 @@ class I_Material;
 // I_ShadowRenderer
 //
 // Interface for a class that can draw a shadow depth map
+//  - implementations should only draw casters inside the cascades light projection, and may cache them in its caster list
 //
 class I_ShadowRenderer
 {
 public:
 	virtual ~I_ShadowRenderer() = default;
 
-	virtual void DrawShadow(I_Material const* const nullMaterial) = 0;
+	virtual void DrawShadow(I_Material const* const nullMaterial, DirectionalShadowData::CascadeData& cascade) = 0;
 	virtual Camera const& GetCamera() const = 0;
 };
 
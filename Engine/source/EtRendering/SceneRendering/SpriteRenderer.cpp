@@ -35,7 +35,7 @@ SpriteRenderer::~SpriteRenderer()
 	}
 
 	api->DeleteVertexArray(m_VAO);
-	api->DeleteBuffer(m_VBO);
+	m_VertexBuffer.Deinit();
 
 	m_Sprites.clear();
 	m_Textures.clear();
@@ -52,17 +52,16 @@ void SpriteRenderer::Initialize()
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
 	m_Shader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("PostSprite.glsl"));
+	m_TransformHandle = m_Shader->GetUniformHandle("uTransform"_hash);
+	m_Draw3DHandle = m_Shader->GetUniformHandle("uDraw3D"_hash);
+	m_TextureHandle = m_Shader->GetUniformHandle("uTexture"_hash);
+	m_3DTextureHandle = m_Shader->GetUniformHandle("u3DTexture"_hash);
+	m_LayerHandle = m_Shader->GetUniformHandle("uLayer"_hash);
 
-	//Generate buffers and arrays
+	//Generate and bind arrays, the vertex buffer is left bound after initializing
 	m_VAO = api->CreateVertexArray();
-	m_VBO = api->CreateBuffer();
-
-	//bind
 	api->BindVertexArray(m_VAO);
-	api->BindBuffer(E_BufferType::Vertex, m_VBO);
-
-	//set data and attributes
-	api->SetBufferData(E_BufferType::Vertex, m_BufferSize, nullptr, E_UsageHint::Dynamic);
+	m_VertexBuffer.Initialize(sizeof(SpriteVertex));
 
 	//input layout
 	api->SetVertexAttributeArrayEnabled(0, true);
@@ -186,6 +185,100 @@ void SpriteRenderer::OnWindowResize()
 	CalculateTransform();
 }
 
+//---------------------------------
+// SpriteRenderer::SortSprites
+//
+// Group sprites into as few texture batches as possible without changing what ends up on screen
+//  - sprites are blended without depth testing, so the submission order decides which one is on top
+//  - a sprite joins the latest earlier batch with its texture, as long as its bounds don't touch any batch it would skip over
+//  - otherwise it starts a new batch, which keeps overlapping sprites in submission order regardless of their depth
+//  - texture ids are assigned in order of first use, which keeps the order stable between frames for the vertex buffer
+//
+void SpriteRenderer::SortSprites(std::vector<SpriteVertex>& sprites, BatchScratch& scratch)
+{
+	scratch.batches.clear();
+	scratch.spriteBatches.clear();
+
+	for (SpriteVertex const& sprite : sprites)
+	{
+		// screen space bounds of the quad the geometry shader emits, rotated around the sprite position
+		vec2 const position(sprite.TransformData.x, sprite.TransformData.y);
+		vec2 const pivot(sprite.TransformData2.x, sprite.TransformData2.y);
+		vec2 const scale(sprite.TransformData2.z, sprite.TransformData2.w);
+		float const cosRot = cos(sprite.TransformData.w);
+		float const sinRot = sin(sprite.TransformData.w);
+
+		vec2 spriteMin = position;
+		vec2 spriteMax = position;
+		for (vec2 const& corner : { vec2(0.f, 0.f), vec2(1.f, 0.f), vec2(0.f, 1.f), vec2(1.f, 1.f) })
+		{
+			vec2 const local = (corner - pivot) * scale;
+			vec2 const rotated = position + vec2(local.x * cosRot - local.y * sinRot, local.y * cosRot + local.x * sinRot);
+			spriteMin = vec2(std::min(spriteMin.x, rotated.x), std::min(spriteMin.y, rotated.y));
+			spriteMax = vec2(std::max(spriteMax.x, rotated.x), std::max(spriteMax.y, rotated.y));
+		}
+
+		// find a batch to join
+		size_t batchIdx = scratch.batches.size();
+		size_t const lookbackEnd = (scratch.batches.size() > s_MaxBatchLookback) ? scratch.batches.size() - s_MaxBatchLookback : 0u;
+		for (size_t candidateIdx = scratch.batches.size(); candidateIdx > lookbackEnd; --candidateIdx)
+		{
+			BatchScratch::Batch const& candidate = scratch.batches[candidateIdx - 1u];
+			if (candidate.textureId == sprite.TextureId)
+			{
+				batchIdx = candidateIdx - 1u;
+				break;
+			}
+
+			bool const overlaps = (spriteMin.x <= candidate.max.x) && (candidate.min.x <= spriteMax.x)
+				&& (spriteMin.y <= candidate.max.y) && (candidate.min.y <= spriteMax.y);
+			if (overlaps)
+			{
+				break;
+			}
+		}
+
+		if (batchIdx == scratch.batches.size())
+		{
+			scratch.batches.emplace_back();
+			scratch.batches.back().textureId = sprite.TextureId;
+			scratch.batches.back().min = spriteMin;
+			scratch.batches.back().max = spriteMax;
+		}
+		else
+		{
+			BatchScratch::Batch& batch = scratch.batches[batchIdx];
+			batch.min = vec2(std::min(batch.min.x, spriteMin.x), std::min(batch.min.y, spriteMin.y));
+			batch.max = vec2(std::max(batch.max.x, spriteMax.x), std::max(batch.max.y, spriteMax.y));
+		}
+
+		++scratch.batches[batchIdx].offset; // counts the sprites for now
+		scratch.spriteBatches.emplace_back(static_cast<uint32>(batchIdx));
+	}
+
+	if (scratch.batches.size() == sprites.size())
+	{
+		return; // nothing was merged
+	}
+
+	// place the sprites batch by batch, keeping their submission order within a batch
+	uint32 offset = 0u;
+	for (BatchScratch::Batch& batch : scratch.batches)
+	{
+		uint32 const count = batch.offset;
+		batch.offset = offset;
+		offset += count;
+	}
+
+	scratch.sorted.resize(sprites.size());
+	for (size_t spriteIdx = 0u; spriteIdx < sprites.size(); ++spriteIdx)
+	{
+		scratch.sorted[scratch.batches[scratch.spriteBatches[spriteIdx]].offset++] = sprites[spriteIdx];
+	}
+
+	sprites.swap(scratch.sorted);
+}
+
 //---------------------------------
 // SpriteRenderer::Draw
 //
@@ -200,14 +293,15 @@ void SpriteRenderer::Draw()
 
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
-	UpdateBuffer();
+	SortSprites(m_Sprites, m_BatchScratch);
+	m_VertexBuffer.Upload(m_Sprites.data(), m_Sprites.size());
 
 	api->BindVertexArray(m_VAO);
 
 	CalculateTransform();
 	api->SetShader(m_Shader.get());
 
-	m_Shader->Upload("uTransform"_hash, m_Transform);
+	m_Shader->Upload(m_TransformHandle, m_Transform);
 
 	uint32 batchSize = 1;
 	uint32 batchOffset = 0;
@@ -223,14 +317,14 @@ void SpriteRenderer::Draw()
 		TextureData const* const texData = m_Textures[m_Sprites[i].TextureId];
 		if (texData->GetTargetType() == E_TextureType::Texture2D)
 		{
-			m_Shader->Upload("uDraw3D"_hash, false);
-			m_Shader->Upload("uTexture"_hash, texData);
+			m_Shader->Upload(m_Draw3DHandle, false);
+			m_Shader->Upload(m_TextureHandle, texData);
 		}
 		else
 		{
-			m_Shader->Upload("uDraw3D"_hash, true);
-			m_Shader->Upload("u3DTexture"_hash, texData);
-			m_Shader->Upload("uLayer"_hash, m_Layer);
+			m_Shader->Upload(m_Draw3DHandle, true);
+			m_Shader->Upload(m_3DTextureHandle, texData);
+			m_Shader->Upload(m_LayerHandle, m_Layer);
 		}
 
 		//Draw
@@ -250,45 +344,6 @@ void SpriteRenderer::Draw()
 // Utility
 //---------
 
-//---------------------------------
-// SpriteRenderer::UpdateBuffer
-//
-// Recalculates the Vertex buffer
-//
-void SpriteRenderer::UpdateBuffer()
-{
-	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
-
-	//Bind Object vertex array
-	api->BindVertexArray(m_VAO);
-
-	//Send the vertex buffer again
-	api->BindBuffer(E_BufferType::Vertex, m_VBO);
-
-	bool bufferResize = m_Sprites.size() * sizeof( SpriteVertex ) > m_BufferSize;
-	if(!m_VBO || bufferResize) //first creation or resize
-	{
-		if (bufferResize)
-		{
-			m_BufferSize = (uint32)m_Sprites.size() * sizeof( SpriteVertex );
-		}
-
-		api->SetBufferData(E_BufferType::Vertex, m_BufferSize, m_Sprites.data(), E_UsageHint::Dynamic);
-	}
-	else
-	{
-		void* p = api->MapBuffer(E_BufferType::Vertex, E_AccessMode::Write);
-		memcpy( p, m_Sprites.data(), m_Sprites.size() * sizeof( SpriteVertex ) );
-		api->UnmapBuffer(E_BufferType::Vertex);
-	}
-
-
-	api->BindBuffer(E_BufferType::Vertex, 0);
-
-	//Done Modifying
-	api->BindVertexArray(0);
-}
-
 //---------------------------------
 // SpriteRenderer::CalculateTransform
 //
@@ -1,6 +1,9 @@
 #pragma once
 #include <EtCore/Content/AssetPointer.h>
 
+#include <EtRendering/GraphicsTypes/Shader.h>
+#include <EtRendering/SceneRendering/RetainedVertexBuffer.h>
+
 
 namespace et {
 namespace render {
@@ -14,6 +17,8 @@ class SplashScreenRenderer;
 // SpriteRenderer
 //
 // Rendering class that can draw 2D images to the current framebuffer
+//  - sprites are drawn in submission order, a sprite only moves into an earlier batch with the same texture if it doesn't overlap anything drawn in between
+//  - the vertex buffer is retained between frames and only rewritten where sprites changed
 //
 class SpriteRenderer final
 {
@@ -24,6 +29,7 @@ private:
 	friend class render::ShadedSceneRenderer;
 	friend class UIPortal;
 
+public:
 	//---------------------------------
 	// SpriteRenderer::SpriteVertex
 	//
@@ -37,7 +43,33 @@ private:
 		vec4 Color;
 	};
 
-public:
+	//---------------------------------
+	// SpriteRenderer::BatchScratch
+	//
+	// Storage reused between frames while sprites are grouped into batches
+	//
+	struct BatchScratch
+	{
+		//---------------------------------
+		// SpriteRenderer::BatchScratch::Batch
+		//
+		// Run of sprites sharing a texture, with the screen space bounds of all of them
+		//
+		struct Batch
+		{
+			uint32 textureId = 0u;
+			vec2 min;
+			vec2 max;
+			uint32 offset = 0u;
+		};
+
+		std::vector<Batch> batches;
+		std::vector<uint32> spriteBatches;
+		std::vector<SpriteVertex> sorted;
+	};
+
+	static size_t const s_MaxBatchLookback = 16u; // how many batches a sprite may skip back over to find one with its texture
+
 	//-------------------------------------
 	// SpriteRenderer::E_ScalingMode
 	//
@@ -77,13 +109,13 @@ public:
 
 	void OnWindowResize();
 
+	static void SortSprites(std::vector<SpriteVertex>& sprites, BatchScratch& scratch);
+
 private:
 	void Draw();
 
 	// Utility
 	//---------
-	void UpdateBuffer();
-
 	void CalculateTransform();
 
 	// Data
@@ -91,9 +123,9 @@ private:
 
 	//Vertices
 	std::vector<SpriteVertex> m_Sprites;
-	uint32 m_BufferSize = 50;
+	BatchScratch m_BatchScratch;
+	RetainedVertexBuffer m_VertexBuffer;
 	T_ArrayLoc m_VAO = 0;
-	T_BufferLoc m_VBO = 0;
 
 	//Textures
 	TextureData* m_EmptyTex = nullptr;
@@ -101,6 +133,11 @@ private:
 
 	//Shader and its uniforms
 	AssetPtr<ShaderData> m_Shader;
+	ShaderData::UniformHandle m_TransformHandle;
+	ShaderData::UniformHandle m_Draw3DHandle;
+	ShaderData::UniformHandle m_TextureHandle;
+	ShaderData::UniformHandle m_3DTextureHandle;
+	ShaderData::UniformHandle m_LayerHandle;
 
 	mat4 m_Transform;
 
@@ -12,29 +12,15 @@ namespace et {
 namespace render {
 
 
-//=============================
-// Text Renderer :: Text Cache
-//=============================
-
-
-//---------------------------------
-// TextRenderer::TextCache::c-tor
-//
-// Initialize a text cache
-//
-TextRenderer::TextCache::TextCache(std::string const& text, vec2 const pos, vec4 const& col, int16 const size)
-	: Text(text)
-	, Position(pos)
-	, Color(col)
-	, Size(size)
-{ }
-
-
 //===============
 // Text Renderer
 //===============
 
 
+// static
+size_t const TextRenderer::s_MaxCachedLayouts = 512u;
+
+
 //---------------------------------
 // TextRenderer::d-tor
 //
@@ -49,8 +35,13 @@ TextRenderer::~TextRenderer()
 		Viewport::GetCurrentViewport()->GetEventDispatcher().Unregister(m_VPCallbackId);
 	}
 
+	if (m_FontCallbackId != T_FontEventDispatcher::INVALID_ID)
+	{
+		FontAsset::GetEventDispatcher().Unregister(m_FontCallbackId);
+	}
+
 	api->DeleteVertexArray(m_VAO);
-	api->DeleteBuffer(m_VBO);
+	m_VertexBuffer.Deinit();
 }
 
 //---------------------------------
@@ -63,18 +54,14 @@ void TextRenderer::Initialize()
 	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
 
 	m_pTextShader = core::ResourceManager::Instance()->GetAssetData<ShaderData>(core::HashString("PostText.glsl"));
+	m_TransformHandle = m_pTextShader->GetUniformHandle("transform"_hash);
+	m_FontTexHandle = m_pTextShader->GetUniformHandle("fontTex"_hash);
+	m_TexSizeHandle = m_pTextShader->GetUniformHandle("texSize"_hash);
 
-	//Generate buffers and arrays
+	//Generate and bind arrays, the vertex buffer is left bound after initializing
 	m_VAO = api->CreateVertexArray();
-	m_VBO = api->CreateBuffer();
-
-
-	//bind
 	api->BindVertexArray(m_VAO);
-	api->BindBuffer(E_BufferType::Vertex, m_VBO);
-
-	//set data and attributes
-	api->SetBufferData(E_BufferType::Vertex, m_BufferSize, nullptr, E_UsageHint::Dynamic);
+	m_VertexBuffer.Initialize(sizeof(TextVertex));
 
 	//input layout
 
@@ -104,6 +91,12 @@ void TextRenderer::Initialize()
 		{
 			OnWindowResize();
 		}));
+
+	T_FontEventCallback fontCallback([this](T_FontEventFlags const, FontEventData const* const data) -> void
+		{
+			OnFontUnloaded(data->assetId);
+		});
+	m_FontCallbackId = FontAsset::GetEventDispatcher().Register(E_FontEvent::FE_Unloaded, fontCallback);
 }
 
 //---------------------------------
@@ -111,18 +104,20 @@ void TextRenderer::Initialize()
 //
 // Sets the active font and adds it to the queue if it's not there yet
 //
-void TextRenderer::SetFont(SpriteFont const* const font)
+void TextRenderer::SetFont(AssetPtr<SpriteFont> const& font)
 {
-	auto foundIt = std::find_if(m_QueuedFonts.begin(), m_QueuedFonts.end(), [font](QueuedFont const& queued)
+	core::HashString const fontId = font.GetId();
+	auto foundIt = std::find_if(m_QueuedFonts.begin(), m_QueuedFonts.end(), [fontId](QueuedFont const& queued)
 		{
-			return queued.m_Font == font;
+			return queued.m_FontId == fontId;
 		});
 
 	if (foundIt == m_QueuedFonts.cend())
 	{
 		m_ActiveFontIdx = m_QueuedFonts.size();
 		m_QueuedFonts.emplace_back(QueuedFont());
-		m_QueuedFonts[m_ActiveFontIdx].m_Font = font;
+		m_QueuedFonts[m_ActiveFontIdx].m_FontId = fontId;
+		m_QueuedFonts[m_ActiveFontIdx].m_Font = font.get();
 	}
 	else
 	{
@@ -133,20 +128,32 @@ void TextRenderer::SetFont(SpriteFont const* const font)
 //---------------------------------
 // TextRenderer::DrawText
 //
-// Creates a text cache and adds it to the active font
+// Adds the vertices of the text to the active font, placed at pos in the current color
 //
 void TextRenderer::DrawText(std::string const& text, vec2 const pos, int16 fontSize)
 {
-	ET_ASSERT(m_QueuedFonts.size() > 0u, "No active font set!");
+	ET_ASSERT(m_ActiveFontIdx < m_QueuedFonts.size(), "No active font set!");
 
+	QueuedFont& queued = m_QueuedFonts[m_ActiveFontIdx];
 	if (fontSize <= 0)
 	{
-		fontSize = m_QueuedFonts[m_ActiveFontIdx].m_Font->GetFontSize();
+		fontSize = queued.m_Font->GetFontSize();
+	}
+
+	TextLayout const& layout = GetLayout(queued, text, fontSize);
+
+	size_t const first = queued.m_Vertices.size();
+	queued.m_Vertices.insert(queued.m_Vertices.end(), layout.m_Vertices.cbegin(), layout.m_Vertices.cend());
+	for (size_t vertIdx = first; vertIdx < queued.m_Vertices.size(); ++vertIdx)
+	{
+		TextVertex& vText = queued.m_Vertices[vertIdx];
+		vText.Position.x += pos.x;
+		vText.Position.y += pos.y;
+		vText.Color = m_Color;
 	}
 
-	m_NumCharacters += static_cast<uint32>(text.size());
-	m_QueuedFonts[m_ActiveFontIdx].m_TextCache.emplace_back(TextCache(text, pos, m_Color, fontSize));
-	m_QueuedFonts[m_ActiveFontIdx].m_IsAddedToRenderer = true;
+	m_NumCharacters += static_cast<uint32>(layout.m_Vertices.size());
+	queued.m_IsAddedToRenderer = true;
 }
 
 //---------------------------------
@@ -228,7 +235,7 @@ void TextRenderer::Draw()
 	//Enable this objects shader
 	CalculateTransform();
 	api->SetShader(m_pTextShader.get());
-	m_pTextShader->Upload("transform"_hash, m_Transform);
+	m_pTextShader->Upload(m_TransformHandle, m_Transform);
 
 	//Bind Object vertex array
 	api->BindVertexArray(m_VAO);
@@ -238,8 +245,8 @@ void TextRenderer::Draw()
 		if (queued.m_IsAddedToRenderer)
 		{
 			TextureData const* const fontTex = queued.m_Font->GetAtlas();
-			m_pTextShader->Upload("fontTex"_hash, fontTex);
-			m_pTextShader->Upload("texSize"_hash, math::vecCast<float>(fontTex->GetResolution())); // #todo: possibly we can just query this in glsl
+			m_pTextShader->Upload(m_FontTexHandle, fontTex);
+			m_pTextShader->Upload(m_TexSizeHandle, math::vecCast<float>(fontTex->GetResolution())); // #todo: possibly we can just query this in glsl
 
 			//Draw the object
 			api->DrawArrays(E_DrawMode::Points, queued.m_BufferStart, queued.m_BufferSize);
@@ -250,95 +257,206 @@ void TextRenderer::Draw()
 
 	//unbind vertex array
 	api->BindVertexArray(0);
+
+	EvictLayouts();
+	++m_Frame;
 }
 
 //---------------------------------
 // TextRenderer::UpdateBuffer
 //
-// Updates the vertex buffer containing font vertices
+// Gathers the vertices of all queued fonts and updates the parts of the vertex buffer that changed since the last frame
 //
 void TextRenderer::UpdateBuffer()
 {
-	std::vector<TextVertex> tVerts;
+	m_Vertices.clear();
+	m_Vertices.reserve(static_cast<size_t>(m_NumCharacters));
 
 	for (QueuedFont& queued : m_QueuedFonts)
 	{
 		if (queued.m_IsAddedToRenderer)
 		{
-			queued.m_BufferStart = static_cast<int32>(tVerts.size() * (sizeof(TextVertex) / sizeof(float)));
-			queued.m_BufferSize = 0;
+			queued.m_BufferStart = static_cast<int32>(m_Vertices.size());
+			queued.m_BufferSize = static_cast<int32>(queued.m_Vertices.size());
 
-			for (TextCache const& cache : queued.m_TextCache)
-			{
-				float const sizeMult = static_cast<float>(cache.Size) / static_cast<float>(queued.m_Font->GetFontSize());
-
-				float totalAdvanceX = 0.f;
-				char previous = 0;
-				for (char const charId : cache.Text)
-				{
-					if (!SpriteFont::IsCharValid(charId))
-					{
-						LOG(FS("TextRenderer::UpdateBuffer > char '%c' not supported for current font", charId), core::LogLevel::Warning);
-						continue;
-					}
-
-					FontMetric const& metric = queued.m_Font->GetMetric(charId);
-					if (!metric.IsValid)
-					{
-						LOG(FS("TextRenderer::UpdateBuffer > char '%c' doesn't have a valid metric", charId), core::LogLevel::Warning);
-						continue;
-					}
-
-					vec2 kerningVec = 0;
-					if (queued.m_Font->m_UseKerning && m_bUseKerning)
-					{
-						kerningVec = metric.GetKerningVec(static_cast<wchar_t>(previous)) * sizeMult;
-					}
-					previous = charId;
-
-					totalAdvanceX += kerningVec.x;
-
-					if (charId == ' ')
-					{
-						totalAdvanceX += metric.AdvanceX;
-						continue;
-					}
-
-					tVerts.push_back(TextVertex());
-					TextVertex& vText = tVerts[tVerts.size()-1];
-
-					vText.Position.x = cache.Position.x + (totalAdvanceX + metric.OffsetX)*sizeMult;
-					vText.Position.y = cache.Position.y + (kerningVec.y + metric.OffsetY)*sizeMult;
-					vText.Position.z = 0;
-					vText.Color = cache.Color;
-					vText.TexCoord = metric.TexCoord;
-					vText.CharacterDimension = vec2(metric.Width, metric.Height);
-					vText.SizeMult = sizeMult;
-					vText.ChannelId = metric.Channel;
-
-					totalAdvanceX += metric.AdvanceX;
-				}
-			}
+			m_Vertices.insert(m_Vertices.end(), queued.m_Vertices.cbegin(), queued.m_Vertices.cend());
+			queued.m_Vertices.clear();
+		}
+	}
+
+	m_VertexBuffer.Upload(m_Vertices.data(), m_Vertices.size());
+
+	m_NumCharacters = 0;
+}
+
+//---------------------------------
+// TextRenderer::GetLayoutKey
+//
+// Combines font asset, text, size and kerning into the key for the layout cache
+//  - kerning changes glyph positions, so layouts made with and without it can't be shared
+//
+T_Hash TextRenderer::GetLayoutKey(core::HashString const fontId, std::string const& text, int16 const size, bool const useKerning)
+{
+	T_Hash const fontHash = fontId.Get();
+	T_Hash const textHash = GetHash(text);
+	uint8 const kerning = useKerning ? 1u : 0u;
+
+	uint8 keyData[sizeof(T_Hash) + sizeof(int16) + sizeof(T_Hash) + sizeof(uint8)];
+	memcpy(keyData, &fontHash, sizeof(T_Hash));
+	memcpy(keyData + sizeof(T_Hash), &size, sizeof(int16));
+	memcpy(keyData + sizeof(T_Hash) + sizeof(int16), &textHash, sizeof(T_Hash));
+	memcpy(keyData + sizeof(T_Hash) + sizeof(int16) + sizeof(T_Hash), &kerning, sizeof(uint8));
+
+	return GetDataHash(keyData, sizeof(keyData));
+}
+
+//---------------------------------
+// TextRenderer::GetLayout
+//
+// Returns the cached layout for the text, laying it out if it isn't cached yet
+//  - a layout with a colliding key is replaced rather than returned
+//
+TextRenderer::TextLayout const& TextRenderer::GetLayout(QueuedFont const& font, std::string const& text, int16 const size)
+{
+	TextLayout& layout = m_Layouts[GetLayoutKey(font.m_FontId, text, size, m_bUseKerning)];
+	if ((layout.m_FontId != font.m_FontId) || (layout.m_Size != size) || (layout.m_UseKerning != m_bUseKerning) || (layout.m_Text != text))
+	{
+		layout.m_FontId = font.m_FontId;
+		layout.m_Font = font.m_Font;
+		layout.m_Text = text;
+		layout.m_Size = size;
+		layout.m_UseKerning = m_bUseKerning;
+
+		LayoutText(layout);
+	}
+
+	layout.m_LastUsedFrame = m_Frame;
+	return layout;
+}
+
+//---------------------------------
+// TextRenderer::LayoutText
+//
+// Generates a vertex for every visible character, relative to the origin of the text
+//
+void TextRenderer::LayoutText(TextLayout& layout) const
+{
+	layout.m_Vertices.clear();
+
+	float const sizeMult = static_cast<float>(layout.m_Size) / static_cast<float>(layout.m_Font->GetFontSize());
+
+	float totalAdvanceX = 0.f;
+	char previous = 0;
+	for (char const charId : layout.m_Text)
+	{
+		if (!SpriteFont::IsCharValid(charId))
+		{
+			LOG(FS("TextRenderer::LayoutText > char '%c' not supported for current font", charId), core::LogLevel::Warning);
+			continue;
+		}
+
+		FontMetric const& metric = layout.m_Font->GetMetric(charId);
+		if (!metric.IsValid)
+		{
+			LOG(FS("TextRenderer::LayoutText > char '%c' doesn't have a valid metric", charId), core::LogLevel::Warning);
+			continue;
+		}
+
+		vec2 kerningVec = 0;
+		if (layout.m_Font->m_UseKerning && layout.m_UseKerning)
+		{
+			kerningVec = metric.GetKerningVec(static_cast<wchar_t>(previous)) * sizeMult;
+		}
+		previous = charId;
 
-			queued.m_BufferSize = static_cast<int32>(tVerts.size()) * (sizeof(TextVertex) / sizeof(float)) - queued.m_BufferStart;
-			queued.m_TextCache.clear();
+		totalAdvanceX += kerningVec.x;
+
+		if (charId == ' ')
+		{
+			totalAdvanceX += metric.AdvanceX;
+			continue;
 		}
+
+		layout.m_Vertices.push_back(TextVertex());
+		TextVertex& vText = layout.m_Vertices.back();
+
+		vText.Position.x = (totalAdvanceX + metric.OffsetX)*sizeMult;
+		vText.Position.y = (kerningVec.y + metric.OffsetY)*sizeMult;
+		vText.Position.z = 0;
+		vText.Color = vec4(0.f);
+		vText.TexCoord = metric.TexCoord;
+		vText.CharacterDimension = vec2(metric.Width, metric.Height);
+		vText.SizeMult = sizeMult;
+		vText.ChannelId = metric.Channel;
+
+		totalAdvanceX += metric.AdvanceX;
 	}
+}
 
-	I_GraphicsApiContext* const api = Viewport::GetCurrentApiContext();
+//---------------------------------
+// TextRenderer::EvictLayouts
+//
+// Once the cache grows too large, drop all layouts that weren't drawn this frame
+//
+void TextRenderer::EvictLayouts()
+{
+	if (m_Layouts.size() <= s_MaxCachedLayouts)
+	{
+		return;
+	}
 
-	//Bind Object vertex array
-	api->BindVertexArray(m_VAO);
+	for (auto layoutIt = m_Layouts.begin(); layoutIt != m_Layouts.end();)
+	{
+		if (layoutIt->second.m_LastUsedFrame != m_Frame)
+		{
+			layoutIt = m_Layouts.erase(layoutIt);
+		}
+		else
+		{
+			++layoutIt;
+		}
+	}
+}
 
-	//Send the vertex buffer again
-	api->BindBuffer(E_BufferType::Vertex, m_VBO);
-	api->SetBufferData(E_BufferType::Vertex, static_cast<uint32>(tVerts.size() * sizeof(TextVertex)), tVerts.data(), E_UsageHint::Dynamic);
-	api->BindBuffer(E_BufferType::Vertex, 0);
+//---------------------------------
+// TextRenderer::OnFontUnloaded
+//
+// Layouts and queued text of an unloaded font reference its metrics and atlas, so they can't outlive it
+//
+void TextRenderer::OnFontUnloaded(core::HashString const fontId)
+{
+	for (auto layoutIt = m_Layouts.begin(); layoutIt != m_Layouts.end();)
+	{
+		if (layoutIt->second.m_FontId == fontId)
+		{
+			layoutIt = m_Layouts.erase(layoutIt);
+		}
+		else
+		{
+			++layoutIt;
+		}
+	}
 
-	//Done Modifying
-	api->BindVertexArray(0);
+	auto const foundIt = std::find_if(m_QueuedFonts.begin(), m_QueuedFonts.end(), [fontId](QueuedFont const& queued)
+		{
+			return queued.m_FontId == fontId;
+		});
 
-	m_NumCharacters = 0;
+	if (foundIt != m_QueuedFonts.cend())
+	{
+		size_t const fontIdx = static_cast<size_t>(foundIt - m_QueuedFonts.begin());
+		m_NumCharacters -= static_cast<uint32>(foundIt->m_Vertices.size());
+		m_QueuedFonts.erase(foundIt);
+
+		if (m_ActiveFontIdx == fontIdx)
+		{
+			m_ActiveFontIdx = m_QueuedFonts.size(); // text can only be drawn again after a new font is set
+		}
+		else if (m_ActiveFontIdx > fontIdx)
+		{
+			--m_ActiveFontIdx;
+		}
+	}
 }
 
 //---------------------------------
@@ -1,13 +1,18 @@
 #pragma once
+#include <unordered_map>
+
 #include <EtCore/Content/AssetPointer.h>
 
+#include <EtRendering/GraphicsTypes/Shader.h>
+#include <EtRendering/GraphicsTypes/FontEvents.h>
+#include <EtRendering/SceneRendering/RetainedVertexBuffer.h>
+
 
 namespace et {
 namespace render {
 
 
 class SpriteFont;
-class ShaderData;
 class ShadedSceneRenderer;
 class SplashScreenRenderer;
 
@@ -16,6 +21,9 @@ class SplashScreenRenderer;
 // TextRenderer
 //
 // Draws sprite fonts in an efficient manner
+//  - laid out text is cached by font asset, string and size, so static text only costs a copy of its vertices per frame
+//  - cached layouts of a font are dropped when the font asset unloads
+//  - the vertex buffer is retained between frames and only rewritten where the drawn text changed
 //
 class TextRenderer final 
 {
@@ -42,28 +50,21 @@ private:
 	};
 
 	//---------------------------------
-	// TextRenderer::TextCache
+	// TextRenderer::TextLayout
 	//
-	// Cached text that will be rendered by the TextRenderer
+	// Glyph vertices of a text laid out at the origin, cached so that text which doesn't change isn't laid out every frame
 	//
-	struct TextCache
+	struct TextLayout
 	{
-		// construct 
-		//-----------
-	public:
-		TextCache(std::string const& text, vec2 const pos, vec4 const& col, int16 const size);
-
-	private:
-		TextCache& operator=(const TextCache &tmp); // disable assignment
+		core::HashString m_FontId;
+		SpriteFont const* m_Font = nullptr;
+		std::string m_Text;
+		int16 m_Size = 0;
+		bool m_UseKerning = true;
 
-		// Data
-		///////
+		uint64 m_LastUsedFrame = 0u;
 
-	public:
-		std::string const Text;
-		vec2 Position;
-		vec4 Color;
-		int16 Size;
+		std::vector<TextVertex> m_Vertices; // color is set when the text is drawn
 	};
 
 	//---------------------------------
@@ -73,15 +74,18 @@ private:
 	//
 	struct QueuedFont
 	{
+		core::HashString m_FontId;
 		SpriteFont const* m_Font = nullptr;
 
-		int32 m_BufferStart = 0;
+		int32 m_BufferStart = 0; // in vertices
 		int32 m_BufferSize = 0;
 		bool m_IsAddedToRenderer = false;
 
-		std::vector<TextCache> m_TextCache;
+		std::vector<TextVertex> m_Vertices;
 	};
 
+	static size_t const s_MaxCachedLayouts;
+
 	// c-tor d-tor
 	//-------------
 	TextRenderer() = default;
@@ -92,7 +96,7 @@ private:
 	// functionality
 	//---------------
 public:
-	void SetFont(SpriteFont const* const font);
+	void SetFont(AssetPtr<SpriteFont> const& font);
 	void SetColor(vec4 const& color) { m_Color = color; }
 	void DrawText(std::string const& text, vec2 const pos, int16 fontSize = 0);//fontSize 0 means using the fonts default size
 	void OnWindowResize();
@@ -104,9 +108,16 @@ public:
 	// utility
 	//---------
 private:
+	static T_Hash GetLayoutKey(core::HashString const fontId, std::string const& text, int16 const size, bool const useKerning);
+
 	void Draw();
 	void UpdateBuffer();
 
+	TextLayout const& GetLayout(QueuedFont const& font, std::string const& text, int16 const size);
+	void LayoutText(TextLayout& layout) const;
+	void EvictLayouts();
+	void OnFontUnloaded(core::HashString const fontId);
+
 	void CalculateTransform();
 
 	// Data
@@ -115,18 +126,27 @@ private:
 	bool m_bUseKerning = true;
 
 	AssetPtr<ShaderData> m_pTextShader;
+	ShaderData::UniformHandle m_TransformHandle;
+	ShaderData::UniformHandle m_FontTexHandle;
+	ShaderData::UniformHandle m_TexSizeHandle;
+
 	std::vector<QueuedFont> m_QueuedFonts;
 
-	uint32 m_BufferSize = 500;
+	std::unordered_map<T_Hash, TextLayout> m_Layouts;
+	uint64 m_Frame = 0u;
+
+	std::vector<TextVertex> m_Vertices;
+	RetainedVertexBuffer m_VertexBuffer;
+
 	uint32 m_NumCharacters = 0;
 	mat4 m_Transform;
 	vec4 m_Color = vec4(0, 0, 0, 1);
-	size_t m_ActiveFontIdx;
+	size_t m_ActiveFontIdx = 0u;
 
 	T_ArrayLoc m_VAO;
-	T_BufferLoc m_VBO;
 
 	render::T_ViewportEventCallbackId m_VPCallbackId = render::T_ViewportEventDispatcher::INVALID_ID;
+	T_FontEventCallbackId m_FontCallbackId = T_FontEventDispatcher::INVALID_ID;
 };
 
 
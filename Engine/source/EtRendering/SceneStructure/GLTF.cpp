@@ -3,7 +3,6 @@
 
 #include <EtCore/FileSystem/Entry.h>
 #include <EtCore/FileSystem/FileUtil.h>
-#include <EtCore/FileSystem/BinaryReader.h>
 #include <EtCore/FileSystem/Json/JsonParser.h>
 #include <EtCore/FileSystem/Json/JsonDom.h>
 
@@ -91,35 +90,36 @@ bool glTF::EvaluateURI(URI& uri, const std::string& basePath)
 
 bool glTF::DecodeBase64(const std::string& encoded, std::vector<uint8>& decoded)
 {
-	auto in_len = encoded.size();
-	uint32 i = 0;
-	uint8 char_array_4[4], char_array_3[3];
-
-	while (in_len-- && (encoded[i] != '='))
-	{
-		if (!IsBase64(encoded[i]))return false;
-
-		char_array_4[i%4] = static_cast<uint8>(Base64Mime.find(encoded[i]));
-		++i;
-		if (i%4 == 0) 
+	//Reverse lookup of the mime alphabet, invalid characters map to 0xFF
+	static std::array<uint8, 256> const s_Lookup = []()
 		{
-			char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-			char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-			char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-			for (uint32 j = 0; j < 3; j++)
+			std::array<uint8, 256> lookup;
+			lookup.fill(0xFF);
+			for (size_t i = 0; i < Base64Mime.size(); ++i)
 			{
-				decoded.push_back(char_array_3[j]);
+				lookup[static_cast<uint8>(Base64Mime[i])] = static_cast<uint8>(i);
 			}
-		}
-	}
+			return lookup;
+		}();
 
-	if (i%4) 
+	size_t const in_len = encoded.find('=');
+	size_t const length = (in_len == std::string::npos) ? encoded.size() : in_len;
+	decoded.reserve(decoded.size() + (length / 4) * 3 + 2);
+
+	uint32 accumulated = 0;
+	uint32 bits = 0;
+	for (size_t i = 0; i < length; ++i)
 	{
-		char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-		char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+		uint8 const value = s_Lookup[static_cast<uint8>(encoded[i])];
+		if (value == 0xFF)return false;
 
-		for (uint32 j = 0; (j < i%4 - 1); j++) decoded.push_back(char_array_3[j]);
+		accumulated = (accumulated << 6) | value;
+		bits += 6;
+		if (bits >= 8)
+		{
+			bits -= 8;
+			decoded.push_back(static_cast<uint8>(accumulated >> bits));
+		}
 	}
 
 	return true;
@@ -139,59 +139,54 @@ bool glTF::ParseGLTFData(const std::vector<uint8>& binaryContent, const std::str
 	}
 	if (lowerExt == "glb")
 	{
-		auto pBinReader = new core::BinaryReader();
-		pBinReader->Open(binaryContent);
-		if (!pBinReader->Exists())
+		if (binaryContent.empty())
 		{
-			delete pBinReader;
 			LOG("glTF Failed to read the assetFile!", core::LogLevel::Warning);
 			return false;
 		}
 
 		//Parse Header
-		if (!ParseGLBHeader(pBinReader, asset.header))
+		size_t position = 0;
+		if (!ParseGLBHeader(binaryContent, position, asset.header))
 		{
-			delete pBinReader;
 			return false;
 		}
 
 		//Parse structured Json
 		Chunk jsonChunk = Chunk();
-		if (!ParseGLBChunk(pBinReader, jsonChunk))
+		if (!ParseGLBChunk(binaryContent, position, jsonChunk))
 		{
-			delete pBinReader;
 			LOG("glTF failed to read json chunk from glb!", core::LogLevel::Warning);
 			return false;
 		}
 		if (!(jsonChunk.chunkType == Chunk::ChunkType::JSON))
 		{
-			delete pBinReader;
 			LOG("expected chunk type to be JSON", core::LogLevel::Warning);
 			return false;
 		}
-		core::JSON::Parser parser = core::JSON::Parser(core::FileUtil::AsText(jsonChunk.chunkData));
+		std::string jsonText;
+		core::FileUtil::AsText(jsonChunk.chunkData, jsonChunk.chunkLength, jsonText);
+		core::JSON::Parser parser = core::JSON::Parser(jsonText);
 		core::JSON::Object* root = parser.GetRoot();
 		if (root == nullptr)return false;
 		if (!glTF::ParseGlTFJson(root, asset.dom))return false;
 
-		//Parse binary chunks
-		while ((uint32)pBinReader->GetBufferPosition() < asset.header.length)
+		//Parse binary chunks - they point into the content rather than copying it
+		size_t const length = std::min(static_cast<size_t>(asset.header.length), binaryContent.size());
+		while (position < length)
 		{
 			asset.dataChunks.push_back(Chunk());
-			if (!ParseGLBChunk(pBinReader, asset.dataChunks[asset.dataChunks.size()-1]))
+			if (!ParseGLBChunk(binaryContent, position, asset.dataChunks[asset.dataChunks.size()-1]))
 			{
-				delete pBinReader;
 				LOG("glTF failed to read binary chunk from glb!", core::LogLevel::Warning);
 				return false;
 			}
 			if (!(asset.dataChunks[asset.dataChunks.size() - 1].chunkType == Chunk::ChunkType::BIN))
 			{
-				delete pBinReader;
 				LOG("expected chunk type to be BIN", core::LogLevel::Warning);
 				return false;
 			}
 		}
-		delete pBinReader;
 		return true;
 	}
 	else if (lowerExt == "gltf")
@@ -206,38 +201,57 @@ bool glTF::ParseGLTFData(const std::vector<uint8>& binaryContent, const std::str
 	return false;
 }
 
-bool glTF::ParseGLBHeader(core::BinaryReader* pBinReader, Header &header)
+bool glTF::ParseGLBHeader(const std::vector<uint8>& binaryContent, size_t& position, Header &header)
 {
-	header.magic = pBinReader->Read<uint32>();
-	if (!(header.magic == *reinterpret_cast<uint32*>("glTF")))
+	if (binaryContent.size() < position + sizeof(uint32) * 3)
+	{
+		LOG("glb file too small for header!", core::LogLevel::Warning);
+		return false;
+	}
+	memcpy(&header.magic, binaryContent.data() + position, sizeof(uint32));
+	if (!(memcmp(&header.magic, "glTF", sizeof(uint32)) == 0))
 	{
 		LOG("invalid glb file header!", core::LogLevel::Warning);
 		return false;
 	}
-	header.version = pBinReader->Read<uint32>();
+	memcpy(&header.version, binaryContent.data() + position + sizeof(uint32), sizeof(uint32));
 	if (!(header.version == 2))
 	{
 		LOG("invalid glb file header version!", core::LogLevel::Warning);
 		return false;
 	}
-	header.length = pBinReader->Read<uint32>();
+	memcpy(&header.length, binaryContent.data() + position + sizeof(uint32) * 2, sizeof(uint32));
+	position += sizeof(uint32) * 3;
 	return true;
 }
 
-bool glTF::ParseGLBChunk(core::BinaryReader* pBinReader, Chunk &chunk)
+bool glTF::ParseGLBChunk(const std::vector<uint8>& binaryContent, size_t& position, Chunk &chunk)
 {
-	if (!(pBinReader->GetBufferPosition() % 4 == 0))//Make sure 4 byte alignement is respected
+	if (!(position % 4 == 0))//Make sure 4 byte alignement is respected
 	{
 		LOG("Expected binary buffer position for glb to be 4 byte aligned", core::LogLevel::Warning);
-		pBinReader->SetBufferPosition(((pBinReader->GetBufferPosition() / 4) + 1) * 4);
+		position = ((position / 4) + 1) * 4;
 	}
-	chunk.chunkLength = pBinReader->Read<uint32>();
-	chunk.chunkType = static_cast<Chunk::ChunkType>(pBinReader->Read<uint32>());
-	chunk.chunkData.reserve(chunk.chunkLength);
-	for (uint32 i = 0; i < chunk.chunkLength; i++) chunk.chunkData.push_back(pBinReader->Read<uint8>());
-	if (!(pBinReader->GetBufferPosition() % 4 == 0))//Make sure 4 byte alignement is respected
+	if (binaryContent.size() < position + sizeof(uint32) * 2)
 	{
-		pBinReader->SetBufferPosition(((pBinReader->GetBufferPosition() / 4) + 1) * 4);
+		LOG("glb chunk header exceeds file size", core::LogLevel::Warning);
+		return false;
+	}
+	uint32 chunkType;
+	memcpy(&chunk.chunkLength, binaryContent.data() + position, sizeof(uint32));
+	memcpy(&chunkType, binaryContent.data() + position + sizeof(uint32), sizeof(uint32));
+	chunk.chunkType = static_cast<Chunk::ChunkType>(chunkType);
+	position += sizeof(uint32) * 2;
+	if (binaryContent.size() - position < chunk.chunkLength)
+	{
+		LOG("glb chunk exceeds file size", core::LogLevel::Warning);
+		return false;
+	}
+	chunk.chunkData = binaryContent.data() + position;
+	position += chunk.chunkLength;
+	if (!(position % 4 == 0))//Make sure 4 byte alignement is respected
+	{
+		position = ((position / 4) + 1) * 4;
 	}
 	return true;
 }
@@ -696,7 +710,7 @@ bool glTF::ParseAccessorsJson(core::JSON::Object* root, std::vector<Accessor>& a
 			for (auto el : arr) accessor.min.push_back(static_cast<float>(el));
 		}
 
-		accessors.push_back(accessor);
+		accessors.push_back(std::move(accessor));
 
 		JSON::Value* sparseVal = (*accessorObj)["sparse"];
 		if (sparseVal)
@@ -704,8 +718,8 @@ bool glTF::ParseAccessorsJson(core::JSON::Object* root, std::vector<Accessor>& a
 			if (!(sparseVal->GetType() == JSON::ValueType::JSON_Object)) return false;
 			JSON::Object* sparseObj = sparseVal->obj();
 
-			accessors[accessors.size()-1].sparse = new Accessor::Sparse();
-			Accessor::Sparse* sparse = accessors[accessors.size() - 1].sparse;
+			accessors[accessors.size()-1].sparse.reset(new Accessor::Sparse());
+			Accessor::Sparse* sparse = accessors[accessors.size() - 1].sparse.get();
 
 			if(!JSON::ApplyIntValue(sparseObj, sparse->count, "count"))return false;
 
@@ -1215,9 +1229,9 @@ void glTF::LogGLTFVersionSupport()
 	LOG(std::string("glTF minVersion ") + std::to_string(glTF::minVersion) + " maxVersion " + std::to_string(glTF::maxVersion));
 }
 
-bool glTF::OpenBufferViewReader(glTFAsset& asset, uint32 viewIdx, core::BinaryReader* pViewReader)
+bool glTF::GetBufferViewData(glTFAsset& asset, uint32 viewIdx, uint8 const*& data, uint64& size)
 {
-	if (viewIdx >= (int32)asset.dom.bufferViews.size())
+	if (viewIdx >= (uint32)asset.dom.bufferViews.size())
 	{
 		LOG("BufferView index out of range", core::LogLevel::Warning);
 		return false;
@@ -1237,6 +1251,9 @@ bool glTF::OpenBufferViewReader(glTFAsset& asset, uint32 viewIdx, core::BinaryRe
 			return false;
 		}
 	}
+
+	uint8 const* bufferData = nullptr;
+	uint64 bufferSize = 0;
 	if (buffer.uri.type == URI::URI_NONE)
 	{
 		if (view.buffer >= (uint32)asset.dataChunks.size())
@@ -1244,21 +1261,26 @@ bool glTF::OpenBufferViewReader(glTFAsset& asset, uint32 viewIdx, core::BinaryRe
 			LOG("No data chunk loaded for glb buffer", core::LogLevel::Warning);
 			return false;
 		}
-		pViewReader->Open(asset.dataChunks[view.buffer].chunkData, (uint32)view.byteOffset, (uint32)view.byteLength);
+		bufferData = asset.dataChunks[view.buffer].chunkData;
+		bufferSize = asset.dataChunks[view.buffer].chunkLength;
 	}
 	else
 	{
-		pViewReader->Open(buffer.uri.binData, (uint32)view.byteOffset, (uint32)view.byteLength);
+		bufferData = buffer.uri.binData.data();
+		bufferSize = buffer.uri.binData.size();
 	}
-	if (!pViewReader->Exists())
+	if (view.byteOffset + view.byteLength > bufferSize)
 	{
-		LOG("glTF Failed to read the buffer view!", core::LogLevel::Warning);
+		LOG("glTF buffer view exceeds its buffer!", core::LogLevel::Warning);
 		return false;
 	}
+
+	data = bufferData + view.byteOffset;
+	size = view.byteLength;
 	return true;
 }
 
-bool glTF::GetAccessorData(glTFAsset& asset, uint32 idx, std::vector<uint8>& data)
+bool glTF::GetAccessorView(glTFAsset& asset, uint32 idx, AccessorView& accessorView)
 {
 	if (idx >= (uint32)asset.dom.accessors.size())
 	{
@@ -1266,27 +1288,17 @@ bool glTF::GetAccessorData(glTFAsset& asset, uint32 idx, std::vector<uint8>& dat
 		return false;
 	}
 	Accessor& accessor = asset.dom.accessors[idx];
-	if (accessor.sparse || accessor.bufferView == -1)
-	{
-		LOG("Unsupported accessor type, sparse accessors are not yet implemented", core::LogLevel::Warning);
-		return false;
-	}
-	if (accessor.bufferView >= (int32)asset.dom.bufferViews.size())
-	{
-		LOG("BufferView index out of range", core::LogLevel::Warning);
-		return false;
-	}
-	BufferView& view = asset.dom.bufferViews[accessor.bufferView];
-	if (view.buffer >= (uint32)asset.dom.buffers.size())
-	{
-		LOG("Buffer index out of range", core::LogLevel::Warning);
-		return false;
-	}
 
 	uint8 compSize = ComponentTypes[accessor.componentType];
 	uint8 compsPerEl = AccessorTypes[accessor.type].first;
 	uint8 elSize = compSize*compsPerEl;
 
+	accessorView.count = accessor.count;
+	accessorView.componentType = accessor.componentType;
+	accessorView.componentCount = compsPerEl;
+	accessorView.stride = elSize;
+	accessorView.data = nullptr;
+
 	//Validation
 	if (!(accessor.byteOffset % compSize == 0)) LOG("Accessors byte offset needs to be a multiple of the component size", core::LogLevel::Warning);
 	if (accessor.min.size())
@@ -1298,28 +1310,31 @@ bool glTF::GetAccessorData(glTFAsset& asset, uint32 idx, std::vector<uint8>& dat
 		if (!((uint32)accessor.max.size() == (uint32)compsPerEl)) LOG("Accessors max array size must equal components per element", core::LogLevel::Warning);
 	}
 
-	uint32 stride = (view.byteStride == -1) ? (uint32)elSize : view.byteStride;
-	if (!(stride % compSize == 0)) LOG("Accessors byte stride needs to be a multiple of the component size", core::LogLevel::Warning);
-	if(accessor.byteOffset+stride*(accessor.count-1)+elSize > view.byteLength)LOG("Accessors doesn't fit buffer view", core::LogLevel::Warning);
+	//Without a buffer view all elements are zero, possibly overridden by a sparse accessor
+	if (accessor.bufferView == -1 || accessor.count == 0)
+	{
+		return true;
+	}
 
-	core::BinaryReader* pViewReader = new core::BinaryReader();
-	if (!OpenBufferViewReader(asset, accessor.bufferView, pViewReader))
+	uint8 const* viewData = nullptr;
+	uint64 viewSize = 0;
+	if (!GetBufferViewData(asset, static_cast<uint32>(accessor.bufferView), viewData, viewSize))
 	{
-		delete pViewReader;
 		LOG("Unable to read buffer view", core::LogLevel::Warning);
 		return false;
 	}
 
-	for (uint32 i = accessor.byteOffset; i < accessor.byteOffset + stride * accessor.count; i+=stride)
+	BufferView& view = asset.dom.bufferViews[accessor.bufferView];
+	uint32 stride = (view.byteStride == -1) ? (uint32)elSize : view.byteStride;
+	if (!(stride % compSize == 0)) LOG("Accessors byte stride needs to be a multiple of the component size", core::LogLevel::Warning);
+	if (accessor.byteOffset + stride * (accessor.count - 1) + elSize > viewSize)
 	{
-		pViewReader->SetBufferPosition(i);
-		for (uint32 j = 0; j < elSize; ++j)
-		{
-			data.push_back(pViewReader->Read<uint8>());
-		}
+		LOG("Accessors doesn't fit buffer view", core::LogLevel::Warning);
+		return false;
 	}
 
-	delete pViewReader;
+	accessorView.data = viewData + accessor.byteOffset;
+	accessorView.stride = stride;
 	return true;
 }
 
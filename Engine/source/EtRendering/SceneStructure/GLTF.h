@@ -2,11 +2,6 @@
 #include <EtCore/FileSystem/Json/JsonDom.h>
 
 
-namespace et { namespace core {
-	class BinaryReader;
-} }
-
-
 namespace et {
 namespace render {
 
@@ -171,14 +166,13 @@ namespace glTF
 				uint32 bufferView = 0;
 				uint32 byteOffset = 0;
 			}values;
-		} *sparse = nullptr;
+		};
+		std::unique_ptr<Sparse> sparse;
 
 		std::vector<float> max;
 		std::vector<float> min;
 
 		std::string name;
-
-		~Accessor() { delete sparse; }
 	};
 
 	struct Skin
@@ -392,9 +386,10 @@ namespace glTF
 			JSON	= 0x4E4F534A,
 			BIN		= 0x004E4942
 		} chunkType;
-		std::vector<uint8> chunkData;
+		uint8 const* chunkData = nullptr; // points into the content the asset was parsed from
 	};
 
+	//glb chunks are not copied, so the binary content passed to ParseGLTFData needs to outlive the asset
 	struct glTFAsset
 	{
 		Header header;
@@ -409,14 +404,24 @@ namespace glTF
 		return (isalnum(c) || (c == '+') || (c == '/'));
 	}
 
+	//Elements of an accessor in the buffer that holds them, without copying
+	struct AccessorView
+	{
+		uint8 const* data = nullptr; // null if the accessor has no buffer view, in which case all elements start out as zero
+		uint64 count = 0;
+		uint32 stride = 0;
+		ComponentType componentType = ComponentType::BYTE;
+		uint8 componentCount = 0;
+	};
+
 	bool EvaluateURI(URI& uri, const std::string& basePath);
 	bool DecodeBase64(const std::string& encoded, std::vector<uint8>& decoded);
 
 	//Unify GLTF and GLB
 	bool ParseGLTFData(const std::vector<uint8>& binaryContent, const std::string path, const std::string& extension, glTFAsset& asset);
 
-	bool ParseGLBHeader(core::BinaryReader* pBinReader, Header &header);
-	bool ParseGLBChunk(core::BinaryReader* pBinReader, Chunk &header);
+	bool ParseGLBHeader(const std::vector<uint8>& binaryContent, size_t& position, Header &header);
+	bool ParseGLBChunk(const std::vector<uint8>& binaryContent, size_t& position, Chunk &chunk);
 
 	bool ParseGlTFJson(core::JSON::Object* json, Dom& dom);
 
@@ -442,67 +447,145 @@ namespace glTF
 
 	void LogGLTFVersionSupport();
 
-	bool OpenBufferViewReader(glTFAsset& asset, uint32 viewIdx, core::BinaryReader* pViewReader);
-	bool GetAccessorData(glTFAsset& asset, uint32 idx, std::vector<uint8>& data);
+	bool GetBufferViewData(glTFAsset& asset, uint32 viewIdx, uint8 const*& data, uint64& size);
+	bool GetAccessorView(glTFAsset& asset, uint32 idx, AccessorView& view);
+
+	//Converts count elements with componentCount components each - tightly packed data of the same type is copied in one go
+	template<typename TSource, typename T>
+	void ConvertElements(uint8 const* data, uint64 count, uint32 stride, uint8 componentCount, T* out)
+	{
+		if (std::is_same<TSource, T>::value && (stride == static_cast<uint32>(componentCount * sizeof(T))))
+		{
+			memcpy(out, data, static_cast<size_t>(count * stride));
+			return;
+		}
+
+		for (uint64 i = 0; i < count; ++i)
+		{
+			uint8 const* element = data + i * stride;
+			for (uint8 j = 0; j < componentCount; ++j)
+			{
+				TSource value;
+				memcpy(&value, element + j * sizeof(TSource), sizeof(TSource)); // buffer data doesn't need to be aligned
+				*out++ = static_cast<T>(value);
+			}
+		}
+	}
 	template<typename T>
-	bool GetAccessorScalarArray(glTFAsset& asset, uint32 idx, std::vector<T>& data)
+	void ConvertComponents(uint8 const* data, uint64 count, uint32 stride, ComponentType componentType, uint8 componentCount, T* out)
 	{
-		if (idx >= (uint32)asset.dom.accessors.size())
+		switch (componentType)
+		{
+		case ComponentType::BYTE:
+			ConvertElements<int8>(data, count, stride, componentCount, out);
+			break;
+		case ComponentType::UNSIGNED_BYTE:
+			ConvertElements<uint8>(data, count, stride, componentCount, out);
+			break;
+		case ComponentType::SHORT:
+			ConvertElements<int16>(data, count, stride, componentCount, out);
+			break;
+		case ComponentType::UNSIGNED_SHORT:
+			ConvertElements<uint16>(data, count, stride, componentCount, out);
+			break;
+		case ComponentType::UNSIGNED_INT:
+			ConvertElements<uint32>(data, count, stride, componentCount, out);
+			break;
+		case ComponentType::FLOAT:
+			ConvertElements<float>(data, count, stride, componentCount, out);
+			break;
+		}
+	}
+	//Writes count * components values of the accessor to out, including sparse substitutions
+	template<typename T>
+	bool ReadAccessor(glTFAsset& asset, uint32 idx, T* out)
+	{
+		AccessorView view;
+		if (!GetAccessorView(asset, idx, view))
 		{
-			LOG("Accessor index out of range", core::LogLevel::Warning);
 			return false;
 		}
-		Accessor& accessor = asset.dom.accessors[idx];
-		uint8 compsPerEl = AccessorTypes[accessor.type].first;
-		std::vector<uint8> accessorData;
-		if (!GetAccessorData(asset, idx, accessorData))
+
+		uint64 const valueCount = view.count * view.componentCount;
+		if (view.data != nullptr)
 		{
-			LOG("Unable to get accessor data", core::LogLevel::Warning);
+			ConvertComponents(view.data, view.count, view.stride, view.componentType, view.componentCount, out);
+		}
+		else
+		{
+			std::fill(out, out + valueCount, static_cast<T>(0));
 		}
-		core::BinaryReader* pBinReader = new core::BinaryReader();
-		pBinReader->Open(accessorData);
-		if (!(pBinReader->Exists()))
+
+		Accessor const& accessor = asset.dom.accessors[idx];
+		if (!accessor.sparse)
+		{
+			return true;
+		}
+
+		Accessor::Sparse const& sparse = *accessor.sparse;
+
+		uint8 const* indices = nullptr;
+		uint64 indicesSize = 0;
+		uint8 const* values = nullptr;
+		uint64 valuesSize = 0;
+		if (!GetBufferViewData(asset, sparse.indices.bufferView, indices, indicesSize) 
+			|| !GetBufferViewData(asset, sparse.values.bufferView, values, valuesSize))
 		{
-			LOG("Unable to convert accessor data", core::LogLevel::Warning);
-			delete pBinReader;
+			LOG("Unable to read sparse accessor buffer views", core::LogLevel::Warning);
 			return false;
 		}
-		for (uint32 i = 0; i < accessor.count * compsPerEl; ++i)
+
+		uint32 const indexSize = ComponentTypes[sparse.indices.componentType];
+		uint32 const elementSize = ComponentTypes[view.componentType] * view.componentCount;
+		if ((sparse.indices.byteOffset + sparse.count * indexSize > indicesSize) || (sparse.values.byteOffset + sparse.count * elementSize > valuesSize))
 		{
-			if (pBinReader->GetBufferPosition() >= (int32)accessorData.size())
+			LOG("Sparse accessor doesn't fit its buffer views", core::LogLevel::Warning);
+			return false;
+		}
+
+		std::vector<uint32> targets(static_cast<size_t>(sparse.count));
+		ConvertComponents(indices + sparse.indices.byteOffset, sparse.count, indexSize, sparse.indices.componentType, 1u, targets.data());
+
+		for (uint64 i = 0; i < sparse.count; ++i)
+		{
+			if (targets[i] >= view.count)
 			{
-				LOG("Binary reader out of range", core::LogLevel::Warning);
-				delete pBinReader;
+				LOG("Sparse accessor index out of range", core::LogLevel::Warning);
 				return false;
 			}
-			switch (accessor.componentType)
-			{
-			case ComponentType::BYTE:
-				data.push_back(static_cast<T>(pBinReader->Read<int8>()));
-				break;
-			case ComponentType::UNSIGNED_BYTE:
-				data.push_back(static_cast<T>(pBinReader->Read<uint8>()));
-				break;
-			case ComponentType::SHORT:
-				data.push_back(static_cast<T>(pBinReader->Read<int16>()));
-				break;
-			case ComponentType::UNSIGNED_SHORT:
-				data.push_back(static_cast<T>(pBinReader->Read<uint16>()));
-				break;
-			case ComponentType::UNSIGNED_INT:
-				data.push_back(static_cast<T>(pBinReader->Read<uint32>()));
-				break;
-			case ComponentType::FLOAT:
-				data.push_back(static_cast<T>(pBinReader->Read<float>()));
-				break;
-			}
+
+			ConvertComponents(values + sparse.values.byteOffset + i * elementSize, 1u, elementSize, view.componentType, view.componentCount, 
+				out + targets[i] * view.componentCount);
+		}
+
+		return true;
+	}
+	template<typename T>
+	bool GetAccessorScalarArray(glTFAsset& asset, uint32 idx, std::vector<T>& data)
+	{
+		if (idx >= (uint32)asset.dom.accessors.size())
+		{
+			LOG("Accessor index out of range", core::LogLevel::Warning);
+			return false;
+		}
+		Accessor& accessor = asset.dom.accessors[idx];
+		uint8 compsPerEl = AccessorTypes[accessor.type].first;
+
+		size_t const first = data.size();
+		data.resize(first + static_cast<size_t>(accessor.count * compsPerEl));
+		if (!ReadAccessor(asset, idx, data.data() + first))
+		{
+			LOG("Unable to get accessor data", core::LogLevel::Warning);
+			data.resize(first);
+			return false;
 		}
-		delete pBinReader;
 		return true;
 	}
 	template <uint8 n, class T>
 	bool GetAccessorVectorArray(glTFAsset& asset, uint32 idx, std::vector<math::vector<n, T>>& data, bool convertCoords = false)
 	{
+		static_assert(sizeof(math::vector<n, T>) == n * sizeof(T), "vectors are expected to be tightly packed");
+
 		if (idx >= (uint32)asset.dom.accessors.size())
 		{
 			LOG("Accessor index out of range", core::LogLevel::Warning);
@@ -515,10 +598,12 @@ namespace glTF
 			LOG("Accessor type mismatch with vector size", core::LogLevel::Warning);
 			return false;
 		}
-		std::vector<T> scalars;
-		if(!GetAccessorScalarArray(asset, idx, scalars))
+		size_t const first = data.size();
+		data.resize(first + static_cast<size_t>(accessor.count));
+		if (!ReadAccessor(asset, idx, data[first].data.data()))
 		{
-			LOG("Unable to get accessor scalar array for vector array", core::LogLevel::Warning);
+			LOG("Unable to get accessor data for vector array", core::LogLevel::Warning);
+			data.resize(first);
 			return false;
 		}
 		if (convertCoords && n != 3)
@@ -526,15 +611,12 @@ namespace glTF
 			LOG("Converting coordinates of a non-3D vector", core::LogLevel::Warning);
 		}
 		convertCoords &= n > 1;
-		for (uint32 i = 0; i < scalars.size() / n; ++i)
+		if (convertCoords)
 		{
-			math::vector<n, T> vec;
-			for (uint32 j = 0; j < n; ++j)
+			for (size_t i = first; i < data.size(); ++i)
 			{
-				vec[(uint8)j] = scalars[i*(uint32)n + j];
+				data[i][1] = -data[i][1];
 			}
-			if (convertCoords)vec[1] = -vec[1];
-			data.push_back(vec);
 		}
 		return true;
 	}
@@ -5,6 +5,8 @@
 #include <EtCore/Content/AssetPointer.h>
 
 #include <EtRendering/GraphicsContext/GraphicsTypes.h>
+#include <EtRendering/GraphicsTypes/FrustumCulling.h>
+#include <EtRendering/GraphicsTypes/MeshLod.h>
 
 
 namespace et {
@@ -29,14 +31,18 @@ public:
 	// MaterialCollection::Mesh
 	//
 	// Mesh draw data and a list of all transformations of its instances
+	//  - world space bounds are kept in sync with the instance list so they can be culled without touching the transforms
+	//  - the index count is that of the full detail level, renderers that select a level of detail per instance use the LOD ranges
 	//
 	struct Mesh
 	{
 		T_ArrayLoc m_VAO;
 		uint32 m_IndexCount;
 		E_DataType m_IndexDataType;
+		std::vector<MeshLod> m_Lods;
 		math::Sphere m_BoundingVolume;
 		std::vector<T_NodeId> m_Instances;
+		SphereBounds m_InstanceBounds; // same order as m_Instances
 	};
 
 	//---------------------------------------
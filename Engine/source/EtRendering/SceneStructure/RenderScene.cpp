@@ -45,11 +45,41 @@ T_NodeId Scene::AddNode(mat4 const& transform)
 //----------------------
 // Scene::UpdateNode
 //
-// Change the transformation of an existing node
+// Change the transformation of an existing node, and the world space bounds of all mesh instances using it
+//  - cached shadow caster lists are only invalidated if the bounds of a caster changed
 //
 void Scene::UpdateNode(T_NodeId const node, mat4 const& transform)
 {
 	m_Nodes[node] = transform;
+
+	auto const foundIt = m_NodeInstances.find(node);
+	if (foundIt == m_NodeInstances.cend())
+	{
+		return;
+	}
+
+	bool hasCasterMoved = false;
+	for (T_InstanceId const instanceId : foundIt->second)
+	{
+		MeshInstance const& inst = m_Instances[instanceId];
+
+		MaterialCollection::Mesh& mesh = GetInstanceMesh(inst);
+		mesh.m_InstanceBounds.Set(inst.m_MeshSlot, SphereBounds::TransformSphere(mesh.m_BoundingVolume, transform));
+
+		MaterialCollection::Mesh& caster = m_ShadowCasters.m_Meshes[inst.m_ShadowCaster];
+		math::Sphere const prevBounds = caster.m_InstanceBounds.Get(inst.m_ShadowCasterSlot);
+		math::Sphere const bounds = SphereBounds::TransformSphere(caster.m_BoundingVolume, transform);
+		if ((bounds.radius != prevBounds.radius) || (bounds.pos.x != prevBounds.pos.x) || (bounds.pos.y != prevBounds.pos.y) || (bounds.pos.z != prevBounds.pos.z))
+		{
+			caster.m_InstanceBounds.Set(inst.m_ShadowCasterSlot, bounds);
+			hasCasterMoved = true;
+		}
+	}
+
+	if (hasCasterMoved)
+	{
+		++m_ShadowCasterRevision;
+	}
 }
 
 //----------------------
@@ -118,14 +148,17 @@ Scene::T_InstanceId Scene::AddInstance(I_Material const* const material, AssetPt
 	ET_ASSERT(materialId != core::slot_map<MaterialCollection::MaterialInstance>::s_InvalidIndex);
 
 	// find or create a mesh in the material instance
-	T_MeshId meshId = AddMeshToMaterial(*foundMaterialIt, mesh, node);
+	uint32 meshSlot;
+	T_MeshId meshId = AddMeshToMaterial(*foundMaterialIt, mesh, node, meshSlot);
 
 	// also make the mesh cast a shadow
 	if (m_ShadowCasters.m_Material == nullptr)
 	{
 		m_ShadowCasters.m_Material = RenderingSystems::Instance()->GetNullMaterial();
 	}
-	T_MeshId casterId = AddMeshToMaterial(m_ShadowCasters, mesh, node);
+	uint32 casterSlot;
+	T_MeshId casterId = AddMeshToMaterial(m_ShadowCasters, mesh, node, casterSlot);
+	++m_ShadowCasterRevision;
 
 	// link the instance data to its own ID
 	auto newInstance = m_Instances.insert(MeshInstance());
@@ -135,8 +168,12 @@ Scene::T_InstanceId Scene::AddInstance(I_Material const* const material, AssetPt
 	newInstance.first->m_Mesh = meshId;
 	newInstance.first->m_ShadowCaster = casterId;
 	newInstance.first->m_Transform = node;
+	newInstance.first->m_MeshSlot = meshSlot;
+	newInstance.first->m_ShadowCasterSlot = casterSlot;
 	newInstance.first->m_IsOpaque = opaque;
 
+	m_NodeInstances[node].push_back(newInstance.second);
+
 	return newInstance.second;
 }
 
@@ -145,14 +182,49 @@ Scene::T_InstanceId Scene::AddInstance(I_Material const* const material, AssetPt
 //
 void Scene::RemoveInstance(T_InstanceId const instance)
 {
-	MeshInstance const& inst = m_Instances[instance];
+	MeshInstance const inst = m_Instances[instance];
 
 	core::slot_map<MaterialCollection>& collectionGroup = inst.m_IsOpaque ? m_OpaqueRenderables : m_ForwardRenderables;
 
 	MaterialCollection& collection = collectionGroup[inst.m_Collection];
 	MaterialCollection::MaterialInstance& material = collection.m_Materials[inst.m_Material];
-	RemoveMeshFromMaterial(m_ShadowCasters, inst.m_ShadowCaster, inst.m_Transform);
-	RemoveMeshFromMaterial(material, inst.m_Mesh, inst.m_Transform);
+
+	// the last instance of each mesh moves into the freed slot, so the instance owning it needs to be pointed there
+	uint32 const lastCasterSlot = static_cast<uint32>(m_ShadowCasters.m_Meshes[inst.m_ShadowCaster].m_Instances.size()) - 1u;
+	T_NodeId const movedCaster = RemoveMeshFromMaterial(m_ShadowCasters, inst.m_ShadowCaster, inst.m_ShadowCasterSlot);
+	++m_ShadowCasterRevision;
+	if (movedCaster != core::INVALID_SLOT_ID)
+	{
+		for (T_InstanceId const otherId : m_NodeInstances[movedCaster])
+		{
+			MeshInstance& other = m_Instances[otherId];
+			if ((other.m_ShadowCaster == inst.m_ShadowCaster) && (other.m_ShadowCasterSlot == lastCasterSlot))
+			{
+				other.m_ShadowCasterSlot = inst.m_ShadowCasterSlot;
+				break;
+			}
+		}
+	}
+
+	uint32 const lastMeshSlot = static_cast<uint32>(material.m_Meshes[inst.m_Mesh].m_Instances.size()) - 1u;
+	T_NodeId const movedMesh = RemoveMeshFromMaterial(material, inst.m_Mesh, inst.m_MeshSlot);
+	if (movedMesh != core::INVALID_SLOT_ID)
+	{
+		for (T_InstanceId const otherId : m_NodeInstances[movedMesh])
+		{
+			MeshInstance& other = m_Instances[otherId];
+			if ((other.m_IsOpaque == inst.m_IsOpaque) 
+				&& (other.m_Collection == inst.m_Collection) 
+				&& (other.m_Material == inst.m_Material)
+				&& (other.m_Mesh == inst.m_Mesh) 
+				&& (other.m_MeshSlot == lastMeshSlot))
+			{
+				other.m_MeshSlot = inst.m_MeshSlot;
+				break;
+			}
+		}
+	}
+
 	if (material.m_Meshes.size() == 0u)
 	{
 		if (collection.m_Materials.size() == 1u)
@@ -172,6 +244,17 @@ void Scene::RemoveInstance(T_InstanceId const instance)
 		}
 	}
 	
+	auto const foundNodeIt = m_NodeInstances.find(inst.m_Transform);
+	if (foundNodeIt != m_NodeInstances.cend())
+	{
+		std::vector<T_InstanceId>& nodeInstances = foundNodeIt->second;
+		nodeInstances.erase(std::remove(nodeInstances.begin(), nodeInstances.end(), instance), nodeInstances.end());
+		if (nodeInstances.empty())
+		{
+			m_NodeInstances.erase(foundNodeIt);
+		}
+	}
+
 	m_Instances.erase(instance);
 }
 
@@ -515,7 +598,12 @@ render::I_SceneExtension* Scene::GetExtension(core::HashString const extensionId
 //--------------------------
 // Scene::AddMeshToMaterial
 //
-core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& material, AssetPtr<MeshData> const mesh, T_NodeId const node)
+// Returns the mesh ID, slot is set to the position of the instance within the meshes instance list
+//
+core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& material, 
+	AssetPtr<MeshData> const mesh, 
+	T_NodeId const node, 
+	uint32& slot)
 {
 	T_ArrayLoc const vao = mesh->GetSurface(material.m_Material->GetBaseMaterial())->GetVertexArray();
 
@@ -535,6 +623,7 @@ core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& ma
 		foundMeshIt->m_VAO = vao;
 		foundMeshIt->m_IndexCount = static_cast<uint32>(mesh->GetIndexCount());
 		foundMeshIt->m_IndexDataType = mesh->GetIndexDataType();
+		foundMeshIt->m_Lods = mesh->GetLods();
 		foundMeshIt->m_BoundingVolume = mesh->GetBoundingSphere();
 	}
 	else
@@ -544,7 +633,9 @@ core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& ma
 
 	ET_ASSERT(meshId != core::slot_map<MaterialCollection::Mesh>::s_InvalidIndex);
 
+	slot = static_cast<uint32>(foundMeshIt->m_Instances.size());
 	foundMeshIt->m_Instances.emplace_back(node);
+	foundMeshIt->m_InstanceBounds.Add(SphereBounds::TransformSphere(foundMeshIt->m_BoundingVolume, m_Nodes[node]));
 
 	return meshId;
 }
@@ -552,21 +643,39 @@ core::T_SlotId Scene::AddMeshToMaterial(MaterialCollection::MaterialInstance& ma
 //-------------------------------
 // Scene::RemoveMeshFromMaterial
 //
-void Scene::RemoveMeshFromMaterial(MaterialCollection::MaterialInstance& material, T_MeshId meshId, T_NodeId node)
+// Swap removes the instance in slot, returns the node of the instance that moved into the slot or INVALID_SLOT_ID if none did
+//
+T_NodeId Scene::RemoveMeshFromMaterial(MaterialCollection::MaterialInstance& material, T_MeshId const meshId, uint32 const slot)
 {
 	MaterialCollection::Mesh& mesh = material.m_Meshes[meshId];
 	if (mesh.m_Instances.size() == 1u)
 	{			
 		material.m_Meshes.erase(meshId);
+		return core::INVALID_SLOT_ID;
 	}
-	else
-	{
-		auto foundTransform = std::find(mesh.m_Instances.begin(), mesh.m_Instances.end(), node);
-		ET_ASSERT(foundTransform != mesh.m_Instances.cend());
 
-		std::iter_swap(foundTransform, std::prev(mesh.m_Instances.end()));
-		mesh.m_Instances.pop_back();
+	ET_ASSERT(slot < mesh.m_Instances.size());
+
+	size_t const last = mesh.m_Instances.size() - 1u;
+	std::swap(mesh.m_Instances[slot], mesh.m_Instances[last]);
+	mesh.m_Instances.pop_back();
+	mesh.m_InstanceBounds.RemoveSwap(slot);
+
+	if (slot == last)
+	{
+		return core::INVALID_SLOT_ID;
 	}
+
+	return mesh.m_Instances[slot];
+}
+
+//-------------------------------
+// Scene::GetInstanceMesh
+//
+MaterialCollection::Mesh& Scene::GetInstanceMesh(MeshInstance const& inst)
+{
+	core::slot_map<MaterialCollection>& collectionGroup = inst.m_IsOpaque ? m_OpaqueRenderables : m_ForwardRenderables;
+	return collectionGroup[inst.m_Collection].m_Materials[inst.m_Material].m_Meshes[inst.m_Mesh];
 }
 
 
@@ -1,4 +1,6 @@
 #pragma once
+#include <unordered_map>
+
 #include "RenderSceneFwd.h"
 #include "Skybox.h"
 #include "Sprite.h"
@@ -40,6 +42,8 @@ class Scene final
 		T_MeshId m_Mesh;
 		T_MeshId m_ShadowCaster;
 		T_NodeId m_Transform;
+		uint32 m_MeshSlot; // index into the meshes instance list and bounds
+		uint32 m_ShadowCasterSlot;
 		bool m_IsOpaque;
 	};
 
@@ -119,6 +123,7 @@ public:
 	core::slot_map<DirectionalShadowData> const& GetDirectionalShadowData() const { return m_DirectionalShadowData; }
 
 	MaterialCollection::MaterialInstance const& GetShadowCasters() const { return m_ShadowCasters; }
+	uint32 GetShadowCasterRevision() const { return m_ShadowCasterRevision; }
 
 	Skybox const& GetSkybox() const { return m_Skybox; }
 	StarField const* GetStarfield() const { return m_Starfield; }
@@ -136,8 +141,10 @@ public:
 	// utility
 	//---------
 private:
-	core::T_SlotId AddMeshToMaterial(MaterialCollection::MaterialInstance& material, AssetPtr<MeshData> const mesh, T_NodeId const node);
-	void RemoveMeshFromMaterial(MaterialCollection::MaterialInstance& material, T_MeshId meshId, T_NodeId node);
+	core::T_SlotId AddMeshToMaterial(MaterialCollection::MaterialInstance& material, AssetPtr<MeshData> const mesh, T_NodeId const node, uint32& slot);
+	T_NodeId RemoveMeshFromMaterial(MaterialCollection::MaterialInstance& material, T_MeshId const meshId, uint32 const slot);
+
+	MaterialCollection::Mesh& GetInstanceMesh(MeshInstance const& inst);
 
 
 	// Data
@@ -147,6 +154,7 @@ private:
 	//------------------
 	core::slot_map<MeshInstance> m_Instances;
 	core::slot_map<LightInstance> m_Lights;
+	std::unordered_map<T_NodeId, std::vector<T_InstanceId>> m_NodeInstances; // to update bounds when a node moves
 
 	// accessible render data
 	//------------------------
@@ -162,6 +170,7 @@ private:
 	core::slot_map<DirectionalShadowData> m_DirectionalShadowData;
 
 	MaterialCollection::MaterialInstance m_ShadowCasters;
+	uint32 m_ShadowCasterRevision = 0u; // changes whenever a caster is added, removed or moved
 
 	Skybox m_Skybox;
 	StarField* m_Starfield = nullptr;
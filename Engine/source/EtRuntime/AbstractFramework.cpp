@@ -4,7 +4,10 @@
 #include <EtBuild/EngineVersion.h>
 
 #include <EtCore/Util/PerformanceInfo.h>
+#include <EtCore/Util/Profiler.h>
 #include <EtCore/UpdateCycle/TickManager.h>
+#include <EtCore/Memory/FrameAllocator.h>
+#include <EtCore/Util/JobPool.h>
 
 #include <EtRendering/GraphicsContext/Viewport.h>
 #include <EtRendering/SceneRendering/ShadedSceneRenderer.h>
@@ -46,10 +49,13 @@ AbstractFramework::~AbstractFramework()
 	core::ContextManager::DestroyInstance();
 
 	core::PerformanceInfo::DestroyInstance();
+	core::Profiler::DestroyInstance();
 	
 	core::ResourceManager::DestroyInstance();
 
 	core::TickManager::DestroyInstance();
+	core::FrameAllocator::DestroyInstance();
+	core::JobPool::DestroyInstance(); // after physics, which runs on the pool
 
 	core::Logger::Release();
 }
@@ -146,10 +152,15 @@ void AbstractFramework::Run()
 	m_RenderArea.Update();
 
 	fw::AudioManager::GetInstance()->Initialize();
-	fw::PhysicsManager::GetInstance()->Initialize();
+	fw::Config::Settings::Physics const& physicsSettings = cfg->GetPhysics();
+	fw::PhysicsManager::GetInstance()->Initialize(physicsSettings.Multithreaded, physicsSettings.ThreadCount);
 
 	core::PerformanceInfo::GetInstance(); // Initialize performance measurment #todo: disable for shipped project?
 
+	fw::Config::Settings::Profiling const& profiling = cfg->GetProfiling();
+	core::Profiler::GetInstance()->SetEnabled(profiling.Enabled || (profiling.CaptureFrames > 0u));
+	ET_PROFILE_THREAD("main");
+
 	// init input manager
 	core::InputManager::GetInstance();	
 	GlfwEventManager::GetInstance()->Init(&m_RenderArea);
@@ -165,6 +176,12 @@ void AbstractFramework::Run()
 	OnInit();
 	fw::UnifiedScene::Instance().LoadScene(bootCfg.startScene);
 
+	// optionally trace the first frames of the scene
+	if ((profiling.CaptureFrames > 0u) && core::Profiler::IsActive())
+	{
+		core::Profiler::GetInstance()->BeginCapture(profiling.CaptureFrames, cfg->GetUserDirPath() + profiling.CaptureFile);
+	}
+
 	// update
 	MainLoop();
 }
@@ -176,12 +193,20 @@ void AbstractFramework::Run()
 //
 void AbstractFramework::MainLoop()
 {
+	fw::Config const* const cfg = fw::Config::GetInstance();
+
 	while (true)
 	{
 		if (!(core::InputManager::GetInstance()->IsRunning()))
 		{
 			return;
 		}
+
+		if (cfg->GetProfiling().ExitAfterCapture && core::Profiler::GetInstance()->HasCompletedCapture())
+		{
+			return;
+		}
+
 		TriggerTick(); // this will probably tick the scene manager, editor, framework etc
 
 		//****
@@ -190,9 +215,15 @@ void AbstractFramework::MainLoop()
 		fw::EcsController& ecs = fw::UnifiedScene::Instance().GetEcs();
 		fw::T_EntityId cam = fw::UnifiedScene::Instance().GetActiveCamera();
 
-		ecs.GetComponent<fw::CameraComponent>(cam).PopulateCamera(m_SceneRenderer->GetCamera(),
-			*m_Viewport,
-			ecs.GetComponent<fw::TransformComponent>(cam));
+		// view from the same point between simulation steps that scene nodes are blended to
+		vec3 camPosition;
+		quat camRotation;
+		fw::UnifiedScene::Instance().GetTransformInterpolator().Sample(ecs.GetComponent<fw::TransformComponent>(cam),
+			core::TickManager::GetInstance()->GetInterpolationAlpha(),
+			camPosition,
+			camRotation);
+
+		ecs.GetComponent<fw::CameraComponent>(cam).PopulateCamera(m_SceneRenderer->GetCamera(), *m_Viewport, camPosition, camRotation);
 
 		m_RenderArea.Update();
 	}
@@ -0,0 +1,358 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtFramework/Audio/AudioVoiceManager.h>
+
+#include <thread>
+
+#include <AL/alc.h>
+#include <AL/alext.h>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtFramework/Audio/AudioData.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	ALCint const s_Frequency = 44100;
+	float const s_FrameTime = 1.f / 60.f;
+	float const s_TimeTolerance = 0.02f;
+
+	//---------------------------------
+	// LoopbackDevice
+	//
+	// Device that only mixes when samples are rendered, so that playback advances exactly as far as the test says
+	//
+	class LoopbackDevice final
+	{
+	public:
+		LoopbackDevice()
+		{
+			if (alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback") == ALC_FALSE)
+			{
+				return;
+			}
+
+			LPALCLOOPBACKOPENDEVICESOFT const openDevice = 
+				reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+			m_RenderSamples = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+
+			m_Device = openDevice(nullptr);
+			if (m_Device == nullptr)
+			{
+				return;
+			}
+
+			ALCint const attributes[] = {
+				ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+				ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+				ALC_FREQUENCY, s_Frequency,
+				0
+			};
+
+			m_Context = alcCreateContext(m_Device, attributes);
+			if (m_Context != nullptr)
+			{
+				alcMakeContextCurrent(m_Context);
+			}
+		}
+
+		~LoopbackDevice()
+		{
+			alcMakeContextCurrent(nullptr);
+			if (m_Context != nullptr)
+			{
+				alcDestroyContext(m_Context);
+			}
+
+			if (m_Device != nullptr)
+			{
+				alcCloseDevice(m_Device);
+			}
+		}
+
+		bool IsOpen() const { return m_Context != nullptr; }
+
+		void Render(float const seconds)
+		{
+			ALCsizei const frames = static_cast<ALCsizei>(std::round(seconds * static_cast<float>(s_Frequency)));
+			std::vector<ALshort> samples(static_cast<size_t>(frames) * 2u);
+			m_RenderSamples(m_Device, samples.data(), frames);
+		}
+
+	private:
+		ALCdevice* m_Device = nullptr;
+		ALCcontext* m_Context = nullptr;
+		LPALCRENDERSAMPLESSOFT m_RenderSamples = nullptr;
+	};
+
+	//---------------------------------
+	// CreateSilentTrack
+	//
+	fw::AudioData* CreateSilentTrack(float const duration)
+	{
+		std::vector<ALshort> const samples(static_cast<size_t>(duration * static_cast<float>(s_Frequency)), 0);
+
+		ALuint buffer;
+		alGenBuffers(1, &buffer);
+		alBufferData(buffer, AL_FORMAT_MONO16, samples.data(), static_cast<ALsizei>(samples.size() * sizeof(ALshort)), s_Frequency);
+
+		return new fw::AudioData(buffer, AL_FORMAT_MONO16, s_Frequency, duration);
+	}
+
+	//---------------------------------
+	// ReadFile
+	//
+	std::vector<uint8> ReadFile(std::string const& path)
+	{
+		std::vector<uint8> data;
+
+		core::File* const file = new core::File(path, nullptr);
+		if (file->Open(core::FILE_ACCESS_MODE::Read))
+		{
+			data = file->Read();
+			file->Close();
+		}
+
+		delete file;
+		return data;
+	}
+
+	//---------------------------------
+	// PlayFrames
+	//
+	// Render and update in frame sized steps for a while or until the voice stops, returns the time played
+	//  - the streamer thread gets a moment every frame, as it would while the game renders
+	//
+	float PlayFrames(LoopbackDevice& device, fw::AudioVoiceManager& manager, fw::AudioVoiceManager::T_VoiceId const voice, float const maxTime)
+	{
+		float time = 0.f;
+		while ((time < maxTime) && (manager.GetState(voice) == fw::AudioVoiceManager::E_VoiceState::Playing))
+		{
+			device.Render(s_FrameTime);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			manager.Update(s_FrameTime);
+			time += s_FrameTime;
+		}
+
+		return time;
+	}
+
+} // namespace
+
+
+TEST_CASE("audio voice attenuation inverse", "[audio]")
+{
+	float const maxDist = std::numeric_limits<float>::max();
+
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_INVERSE_DISTANCE_CLAMPED, 1.f, 1.f, 1.f, maxDist), 1.f));
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_INVERSE_DISTANCE_CLAMPED, 2.f, 1.f, 1.f, maxDist), 0.5f));
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_INVERSE_DISTANCE_CLAMPED, 4.f, 2.f, 1.f, maxDist), 0.5f));
+
+	// closer than the reference distance is clamped for the clamped model only
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_INVERSE_DISTANCE_CLAMPED, 0.5f, 1.f, 1.f, maxDist), 1.f));
+	REQUIRE(fw::AudioVoiceManager::ComputeAttenuation(AL_INVERSE_DISTANCE, 0.5f, 1.f, 1.f, maxDist) > 1.f);
+
+	// beyond the max distance sources don't get any quieter
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_INVERSE_DISTANCE_CLAMPED, 10.f, 1.f, 1.f, 2.f), 0.5f));
+}
+
+TEST_CASE("audio voice attenuation linear and exponent", "[audio]")
+{
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_LINEAR_DISTANCE_CLAMPED, 1.f, 1.f, 1.f, 11.f), 1.f));
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_LINEAR_DISTANCE_CLAMPED, 6.f, 1.f, 1.f, 11.f), 0.5f));
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_LINEAR_DISTANCE_CLAMPED, 11.f, 1.f, 1.f, 11.f), 0.f));
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_LINEAR_DISTANCE_CLAMPED, 20.f, 1.f, 1.f, 11.f), 0.f));
+
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_EXPONENT_DISTANCE_CLAMPED, 4.f, 1.f, 0.5f, 100.f), 0.5f));
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_EXPONENT_DISTANCE_CLAMPED, 4.f, 1.f, 0.f, 100.f), 1.f));
+
+	// without a distance model sources are never attenuated
+	REQUIRE(math::nearEquals(fw::AudioVoiceManager::ComputeAttenuation(AL_NONE, 100.f, 1.f, 1.f, 10.f), 1.f));
+}
+
+TEST_CASE("audio voice virtualization", "[audio]")
+{
+	using E_VoiceState = fw::AudioVoiceManager::E_VoiceState;
+
+	LoopbackDevice device;
+	REQUIRE(device.IsOpen());
+
+	std::unique_ptr<fw::AudioData> const track(CreateSilentTrack(2.f));
+
+	fw::AudioVoiceManager manager;
+	manager.Initialize(2u);
+	REQUIRE(manager.GetSourceCount() == 2u);
+
+	// twice as many voices as sources, each half as audible as the one before
+	std::vector<fw::AudioVoiceManager::T_VoiceId> voices;
+	for (float const distance : { 1.f, 2.f, 4.f, 8.f })
+	{
+		fw::AudioVoiceManager::T_VoiceId const voice = manager.CreateVoice(false);
+		manager.SetTrack(voice, track.get());
+		manager.SetPosition(voice, vec3(distance, 0.f, 0.f));
+		manager.SetState(voice, E_VoiceState::Playing);
+
+		voices.push_back(voice);
+	}
+
+	manager.Update(0.f);
+
+	REQUIRE_FALSE(manager.IsVirtual(voices[0]));
+	REQUIRE_FALSE(manager.IsVirtual(voices[1]));
+	REQUIRE(manager.IsVirtual(voices[2]));
+	REQUIRE(manager.IsVirtual(voices[3]));
+
+	// virtual voices keep time with the real ones
+	device.Render(0.5f);
+	manager.Update(0.5f);
+
+	for (fw::AudioVoiceManager::T_VoiceId const voice : voices)
+	{
+		REQUIRE(manager.GetState(voice) == E_VoiceState::Playing);
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voice), 0.5f, s_TimeTolerance));
+	}
+
+	SECTION("swap")
+	{
+		// more audible than the second voice, even with the bias towards voices that are already real
+		manager.SetPosition(voices[3], vec3(0.f, 0.f, 1.f));
+		manager.Update(0.f);
+
+		REQUIRE_FALSE(manager.IsVirtual(voices[0]));
+		REQUIRE(manager.IsVirtual(voices[1]));
+		REQUIRE(manager.IsVirtual(voices[2]));
+		REQUIRE_FALSE(manager.IsVirtual(voices[3]));
+
+		// the voice that became real resumes where it would have been
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voices[3]), 0.5f, s_TimeTolerance));
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voices[1]), 0.5f, s_TimeTolerance));
+
+		device.Render(0.25f);
+		manager.Update(0.25f);
+
+		for (fw::AudioVoiceManager::T_VoiceId const voice : voices)
+		{
+			REQUIRE(math::nearEquals(manager.GetPlaybackTime(voice), 0.75f, s_TimeTolerance));
+		}
+	}
+
+	SECTION("end of track")
+	{
+		manager.SetLooping(voices[3], true);
+
+		device.Render(1.75f);
+		manager.Update(1.75f);
+
+		// real and virtual voices stop at the end of the track, looping voices start over and get a free source
+		REQUIRE(manager.GetState(voices[0]) == E_VoiceState::Stopped);
+		REQUIRE(manager.GetState(voices[1]) == E_VoiceState::Stopped);
+		REQUIRE(manager.GetState(voices[2]) == E_VoiceState::Stopped);
+		REQUIRE(manager.IsVirtual(voices[0]));
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voices[2]), 0.f));
+
+		REQUIRE(manager.GetState(voices[3]) == E_VoiceState::Playing);
+		REQUIRE_FALSE(manager.IsVirtual(voices[3]));
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voices[3]), 0.25f, s_TimeTolerance));
+	}
+
+	for (fw::AudioVoiceManager::T_VoiceId const voice : voices)
+	{
+		manager.DestroyVoice(voice);
+	}
+
+	manager.Deinit();
+}
+
+TEST_CASE("audio voice streaming", "[audio]")
+{
+	using E_VoiceState = fw::AudioVoiceManager::E_VoiceState;
+
+	LoopbackDevice device;
+	REQUIRE(device.IsOpen());
+
+	fw::AudioAsset asset;
+	asset.SetName("stream_track.ogg");
+	asset.m_IsStreamed = true;
+	REQUIRE(asset.LoadFromMemory(ReadFile(global::g_UnitTestDir + "Audio/stream_track.ogg")));
+
+	fw::AudioData const* const track = asset.GetData();
+	REQUIRE(track->IsStreamed());
+
+	float const duration = track->GetDuration();
+	REQUIRE(duration > 2.f); // several times the chunks that are queued at once
+
+	fw::AudioVoiceManager manager;
+	manager.Initialize(1u);
+
+	fw::AudioVoiceManager::T_VoiceId const voice = manager.CreateVoice(true);
+	manager.SetTrack(voice, track);
+
+	SECTION("play through")
+	{
+		manager.SetState(voice, E_VoiceState::Playing);
+		manager.Update(0.f);
+		REQUIRE_FALSE(manager.IsVirtual(voice));
+
+		// the stream keeps up with playback, so it neither stops early nor falls behind
+		float const halfTime = PlayFrames(device, manager, voice, duration * 0.5f);
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voice), halfTime, s_TimeTolerance));
+
+		float const time = halfTime + PlayFrames(device, manager, voice, duration);
+		REQUIRE(manager.GetState(voice) == E_VoiceState::Stopped);
+		REQUIRE(math::nearEquals(time, duration, 2.f * s_FrameTime));
+	}
+
+	SECTION("loop")
+	{
+		manager.SetLooping(voice, true);
+		manager.SetState(voice, E_VoiceState::Playing);
+		manager.Update(0.f);
+
+		float const time = PlayFrames(device, manager, voice, duration + 0.5f);
+		REQUIRE(manager.GetState(voice) == E_VoiceState::Playing);
+		REQUIRE_FALSE(manager.IsVirtual(voice));
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voice), time - duration, s_TimeTolerance));
+	}
+
+	SECTION("virtual")
+	{
+		manager.SetState(voice, E_VoiceState::Playing);
+		manager.Update(0.f);
+		PlayFrames(device, manager, voice, 0.5f);
+
+		// a second voice takes the only source, the stream is decoded from where it left off once the voice is real again
+		fw::AudioVoiceManager::T_VoiceId const louder = manager.CreateVoice(true);
+		manager.SetTrack(louder, track);
+		manager.SetGain(louder, 1.f, 1.f, 1.f);
+		manager.SetGain(voice, 0.5f, 0.f, 1.f);
+		manager.SetState(louder, E_VoiceState::Playing);
+
+		manager.Update(0.f);
+		REQUIRE(manager.IsVirtual(voice));
+		REQUIRE_FALSE(manager.IsVirtual(louder));
+
+		float const playbackTime = manager.GetPlaybackTime(voice);
+		float const virtualTime = PlayFrames(device, manager, voice, 0.5f);
+
+		manager.DestroyVoice(louder);
+		manager.Update(0.f);
+		REQUIRE_FALSE(manager.IsVirtual(voice));
+		REQUIRE(math::nearEquals(manager.GetPlaybackTime(voice), playbackTime + virtualTime, s_TimeTolerance));
+
+		PlayFrames(device, manager, voice, duration);
+		REQUIRE(manager.GetState(voice) == E_VoiceState::Stopped);
+	}
+
+	manager.DestroyVoice(voice);
+	manager.Deinit();
+
+	asset.Unload(true);
+}
@@ -31,6 +31,8 @@ TEST_CASE("component view", "[ecs]")
 	fw::Archetype arch = GenTestArchetype(entityCount);
 	REQUIRE(arch.GetSize() == entityCount);
 
+	core::ScratchScope const scratchScope;
+
 	// full iteration
 	fw::ComponentRange<TestBCView> range(nullptr, &arch, 0u, entityCount);
 
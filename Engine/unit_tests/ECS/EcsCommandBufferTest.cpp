@@ -176,4 +176,75 @@ TEST_CASE("command buffer add / duplicate / remove", "[ecs]")
 	REQUIRE(ecs.GetEntityCount() == 2u);
 }
 
+TEST_CASE("command buffer worker streams", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	size_t const entityCount = 8u;
+	for (uint32 idx = 0u; idx < static_cast<uint32>(entityCount); ++idx)
+	{
+		ecs.AddEntity(TestCComponent(idx));
+	}
+
+	// records commands from two worker threads, both workers try to remove the last entity
+	class TestWorkerSystem final : public fw::System<TestWorkerSystem, TestCView>
+	{
+	public:
+		TestWorkerSystem() = default;
+
+		void Process(fw::ComponentRange<TestCView>& range)
+		{
+			std::vector<fw::T_EntityId> entities;
+			for (TestCView& view : range)
+			{
+				entities.push_back(view.GetCurrentEntity());
+			}
+
+			fw::EcsCommandBuffer& cb = GetCommandBuffer();
+			cb.SetStreamCount(2u);
+
+			auto const recordFn = [&cb, &entities](uint32 const workerIdx)
+			{
+				fw::EcsCommandBuffer::SetWorkerIndex(workerIdx);
+
+				for (size_t idx = static_cast<size_t>(workerIdx); idx < entities.size(); idx += 2u)
+				{
+					if (workerIdx == 0u)
+					{
+						cb.AddComponents(entities[idx], TestAComponent());
+					}
+					else
+					{
+						cb.AddComponents(entities[idx], TestBComponent(std::to_string(idx)));
+					}
+				}
+
+				cb.RemoveEntity(entities.back());
+			};
+
+			std::thread worker0(recordFn, 0u);
+			std::thread worker1(recordFn, 1u);
+			worker0.join();
+			worker1.join();
+		}
+	};
+
+	ecs.RegisterSystem<TestWorkerSystem>();
+	ecs.Process();
 
+	REQUIRE(ecs.GetEntityCount() == entityCount - 1u);
+
+	for (fw::T_EntityId entity = 0u; entity < static_cast<fw::T_EntityId>(entityCount - 1u); ++entity)
+	{
+		if ((entity % 2u) == 0u)
+		{
+			REQUIRE(ecs.HasComponent<TestAComponent>(entity));
+			REQUIRE_FALSE(ecs.HasComponent<TestBComponent>(entity));
+		}
+		else
+		{
+			REQUIRE(ecs.HasComponent<TestBComponent>(entity));
+			REQUIRE(ecs.GetComponent<TestBComponent>(entity).name == std::to_string(entity));
+		}
+	}
+}
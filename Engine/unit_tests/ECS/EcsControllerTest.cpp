@@ -309,3 +309,52 @@ TEST_CASE("controller component construction, component events", "[ecs]")
 	REQUIRE(counter == 1u);
 	REQUIRE(counter2 == 0u);
 }
+
+TEST_CASE("controller add components to a run of entities", "[ecs]")
+{
+	fw::EcsController ecs;
+
+	uint32 addedCount = 0u;
+	auto onAdded = [&addedCount](fw::EcsController& controller, TestAComponent& comp, fw::T_EntityId const entity) -> void
+	{
+		UNUSED(comp);
+
+		REQUIRE(controller.HasComponent<TestCComponent>(entity));
+		++addedCount;
+	};
+
+	ecs.RegisterOnComponentAdded(fw::T_CompEventFn<TestAComponent>(onAdded));
+
+	// entities from different archetypes and hierachy layers that all end up with A and C
+	fw::T_EntityId const ent0 = ecs.AddEntity(TestCComponent(0u));
+	fw::T_EntityId const ent1 = ecs.AddEntity();
+	fw::T_EntityId const ent2 = ecs.AddEntityChild(ent0, TestCComponent(2u));
+
+	TestAComponent a0;
+	a0.x = 10;
+	TestAComponent a1;
+	a1.x = 11;
+	TestCComponent c1(1u);
+	TestAComponent a2;
+	a2.x = 12;
+
+	fw::T_EntityId const entities[] = { ent0, ent1, ent2 };
+	fw::RawComponentPtr components[] = { fw::MakeRawComponent(a0), fw::MakeRawComponent(a1), fw::MakeRawComponent(c1), fw::MakeRawComponent(a2) };
+	size_t const componentCounts[] = { 1u, 2u, 1u };
+
+	ecs.AddComponentsToEntities(entities, 3u, components, componentCounts);
+	REQUIRE(addedCount == 3u);
+
+	// pointers refer to the components within the ECS
+	REQUIRE(components[0].data == &ecs.GetComponent<TestAComponent>(ent0));
+	REQUIRE(components[3].data == &ecs.GetComponent<TestAComponent>(ent2));
+
+	for (fw::T_EntityId const entity : entities)
+	{
+		REQUIRE(ecs.GetComponentTypes(entity).size() == 2u);
+		REQUIRE(ecs.GetComponent<TestCComponent>(entity).val == static_cast<uint32>(entity));
+		REQUIRE(ecs.GetComponent<TestAComponent>(entity).x == 10 + static_cast<int32>(entity));
+	}
+
+	REQUIRE(ecs.GetParent(ent2) == ent0);
+}
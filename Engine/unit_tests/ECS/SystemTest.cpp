@@ -68,6 +68,7 @@ TEST_CASE("system overwrite", "[ecs]")
 		ReadAccess<TestCComponent> c;
 	};
 
+	core::ScratchScope const scratchScope;
 	fw::ComponentRange<COverwriteReadOnlyView> range(nullptr, &arch, 0u, entityCount);
 
 	size_t idx = 0u;
@@ -84,4 +84,107 @@ TEST_CASE("Parse GLB asset", "[gltf]")
 	REQUIRE(glTF::ParseGLTFData(binaryContent, input->GetPath(), input->GetExtension(), asset) == true);
 	delete input;
 	input = nullptr;
-}
\ No newline at end of file
+}
+TEST_CASE("Decode Base64 padding", "[gltf]")
+{
+	std::vector<uint8> decoded;
+
+	SECTION("two padding characters")
+	{
+		REQUIRE(glTF::DecodeBase64("VGVzdA==", decoded) == true);
+		REQUIRE(core::FileUtil::AsText(decoded) == "Test");
+	}
+	SECTION("one padding character")
+	{
+		REQUIRE(glTF::DecodeBase64("VGVzdFQ=", decoded) == true);
+		REQUIRE(core::FileUtil::AsText(decoded) == "TestT");
+	}
+	SECTION("no padding")
+	{
+		REQUIRE(glTF::DecodeBase64("VGVzdFRl", decoded) == true);
+		REQUIRE(core::FileUtil::AsText(decoded) == "TestTe");
+	}
+	SECTION("invalid characters")
+	{
+		REQUIRE(glTF::DecodeBase64("VGV*dA==", decoded) == false);
+		REQUIRE(glTF::DecodeBase64("VGVz dA==", decoded) == false);
+	}
+}
+
+// 4 floats [1, 2, 3, 4], followed by 2 uint16 sparse indices [1, 3] and 2 float sparse values [10, 30]
+std::string sparseBufferUri = "data:application/octet-stream;base64,AACAPwAAAEAAAEBAAACAQAEAAwAAACBBAADwQQ==";
+
+std::string sparseGltf = R"({
+	"asset": { "version": "2.0" },
+	"buffers": [ { "byteLength": 28, "uri": ")" + sparseBufferUri + R"(" } ],
+	"bufferViews": [
+		{ "buffer": 0, "byteOffset": 0, "byteLength": 16 },
+		{ "buffer": 0, "byteOffset": 16, "byteLength": 4 },
+		{ "buffer": 0, "byteOffset": 20, "byteLength": 8 }
+	],
+	"accessors": [
+		{
+			"bufferView": 0, "componentType": 5126, "count": 4, "type": "SCALAR",
+			"sparse": { "count": 2, "indices": { "bufferView": 1, "componentType": 5123 }, "values": { "bufferView": 2 } }
+		},
+		{
+			"componentType": 5126, "count": 4, "type": "SCALAR",
+			"sparse": { "count": 2, "indices": { "bufferView": 1, "componentType": 5123 }, "values": { "bufferView": 2 } }
+		}
+	]
+})";
+
+TEST_CASE("Read sparse accessors", "[gltf]")
+{
+	std::vector<uint8> content(sparseGltf.begin(), sparseGltf.end());
+
+	glTF::glTFAsset asset;
+	REQUIRE(glTF::ParseGLTFData(content, global::g_UnitTestDir + "Helper/", "gltf", asset) == true);
+	REQUIRE(asset.dom.accessors.size() == 2u);
+	REQUIRE(asset.dom.buffers.size() == 1u);
+
+	std::vector<float> data;
+
+	SECTION("data uri buffer")
+	{
+		REQUIRE(asset.dom.buffers[0].uri.type == glTF::URI::URI_UNEVALUATED);
+
+		REQUIRE(glTF::GetAccessorScalarArray(asset, 0u, data) == true);
+		REQUIRE(asset.dom.buffers[0].uri.type == glTF::URI::URI_DATA);
+		REQUIRE(asset.dom.buffers[0].uri.ext == "octet-stream");
+		REQUIRE(asset.dom.buffers[0].uri.binData.size() == 28u);
+	}
+	SECTION("with base buffer view")
+	{
+		REQUIRE(glTF::GetAccessorScalarArray(asset, 0u, data) == true);
+		REQUIRE(data == std::vector<float>({ 1.f, 10.f, 3.f, 30.f }));
+	}
+	SECTION("without base buffer view")
+	{
+		REQUIRE(glTF::GetAccessorScalarArray(asset, 1u, data) == true);
+		REQUIRE(data == std::vector<float>({ 0.f, 10.f, 0.f, 30.f }));
+	}
+	SECTION("index out of range")
+	{
+		asset.dom.accessors[1].count = 3u;
+		REQUIRE(glTF::GetAccessorScalarArray(asset, 1u, data) == false);
+		REQUIRE(data.empty());
+	}
+}
+
+TEST_CASE("Evaluate invalid data URI", "[gltf]")
+{
+	std::string const baseDir = global::g_UnitTestDir + "Helper/";
+
+	glTF::URI noData;
+	noData.path = "data:application/octet-stream;base64";
+	REQUIRE(glTF::EvaluateURI(noData, baseDir) == false);
+
+	glTF::URI noParameter;
+	noParameter.path = "data:application/octet-stream,VGVzdA==";
+	REQUIRE(glTF::EvaluateURI(noParameter, baseDir) == false);
+
+	glTF::URI badEncoding;
+	badEncoding.path = "data:application/octet-stream;base64,VGV*dA==";
+	REQUIRE(glTF::EvaluateURI(badEncoding, baseDir) == false);
+}
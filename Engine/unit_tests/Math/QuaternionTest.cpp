@@ -31,6 +31,7 @@ TEST_CASE("constructors", "[quat]")
 		REQUIRE( testQuat.w == 2.4f );
 	}
 }
+
 TEST_CASE("axis angles", "[quat]")
 {
 	float angle = math::PI_DIV4;
@@ -52,6 +53,7 @@ TEST_CASE("axis angles", "[quat]")
 		REQUIRE( math::nearEqualsV( rotated2, vec3( 0, 0, 1 ), 0.0001f ) );
 	}
 }
+
 TEST_CASE( "quaternion multiplication", "[quat]" )
 {
 	quat R1 = quat( vec3( 0, 0, 1 ), math::PI_DIV2 );
@@ -83,6 +85,7 @@ TEST_CASE( "quaternion multiplication", "[quat]" )
 		REQUIRE( math::nearEqualsV( math::inverse(R1).v4, math::inverseSafe(R1).v4, 0.0001f ) );
 	}
 }
+
 TEST_CASE( "matrix compatibility", "[quat]" )
 {
 	quat R1 = quat( vec3( 0, 0, 1 ), math::PI_DIV2 );
@@ -110,4 +113,28 @@ TEST_CASE( "matrix compatibility", "[quat]" )
 		vec3 mRot = tMat * initV;
 		REQUIRE(math::nearEqualsV(qRot, mRot, 0.0001f));
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE( "nlerp", "[quat]" )
+{
+	quat const identity;
+	quat const rot = quat( vec3( 0, 0, 1 ), math::PI_DIV2 );
+
+	SECTION( "endpoints" )
+	{
+		REQUIRE( math::nearEqualsV( math::nlerp( identity, rot, 0.f ).v4, identity.v4, 0.0001f ) );
+		REQUIRE( math::nearEqualsV( math::nlerp( identity, rot, 1.f ).v4, rot.v4, 0.0001f ) );
+	}
+	SECTION( "halfway" )
+	{
+		quat const half = math::nlerp( identity, rot, 0.5f );
+		REQUIRE( math::nearEquals( math::length( half.v4 ), 1.f, 0.0001f ) );
+		REQUIRE( math::nearEqualsV( half * vec3( 1, 0, 0 ), math::normalize( vec3( 1, 1, 0 ) ), 0.0001f ) );
+	}
+	SECTION( "shortest path" )
+	{
+		quat negated = rot;
+		negated.v4 = negated.v4 * -1.f;
+		REQUIRE( math::nearEqualsV( math::nlerp( identity, negated, 1.f ).v4, rot.v4, 0.0001f ) );
+	}
+}
@@ -585,5 +585,11 @@ TEST_CASE("vector math", "[vector]")
 		REQUIRE(math::nearEqualsV(math::normalize(vecC), vec3(-0.5732415845897409f, 0.6948382843512011f, -0.4342739277195007f)));
 		REQUIRE(math::nearEquals(math::length(math::normalize(vecC)), 1.f));
 	}
+	SECTION("lerp")
+	{
+		REQUIRE(math::nearEqualsV(math::lerp(vecA, vecB, 0.f), vecA));
+		REQUIRE(math::nearEqualsV(math::lerp(vecA, vecB, 1.f), vecB));
+		REQUIRE(math::nearEqualsV(math::lerp(vecA, vecC, 0.5f), (vecA + vecC) * 0.5f, 0.00001f));
+	}
 	//angles already tested by extension of specific vec 3 solution
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <EtFramework/stdafx.h>
+#include <EtCore/Memory/AllocationCounter.h>
+
+#include <new>
+#include <cstdlib>
+
+
+// replaces the global allocation functions for the test executable so that tests can verify code paths don't allocate
+//  - the engine libraries are linked statically, so their allocations are reported as well
+
+
+void* operator new(size_t const size)
+{
+	et::core::AllocationCounter::OnAllocate(size);
+
+	void* const ptr = std::malloc((size == 0u) ? 1u : size);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new[](size_t const size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* const ptr) noexcept
+{
+	if (ptr != nullptr)
+	{
+		et::core::AllocationCounter::OnFree();
+	}
+
+	std::free(ptr);
+}
+
+void operator delete[](void* const ptr) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete(void* const ptr, size_t const size) noexcept
+{
+	UNUSED(size);
+	operator delete(ptr);
+}
+
+void operator delete[](void* const ptr, size_t const size) noexcept
+{
+	UNUSED(size);
+	operator delete(ptr);
+}
@@ -0,0 +1,292 @@
+#include <EtFramework/stdafx.h>
+#include "../ECS/EcsTestUtilities.h"
+
+#include <EtCore/Memory/LinearArena.h>
+#include <EtCore/Memory/FrameAllocator.h>
+#include <EtCore/Memory/ScratchArena.h>
+#include <EtCore/Memory/PoolAllocator.h>
+#include <EtCore/Memory/StlAllocators.h>
+#include <EtCore/Memory/AllocationCounter.h>
+#include <EtCore/UpdateCycle/TickManager.h>
+#include <EtCore/UpdateCycle/Tickable.h>
+#include <EtCore/UpdateCycle/RealTimeTickTriggerer.h>
+#include <EtCore/Util/GenericEventDispatcher.h>
+
+#include <EtFramework/ECS/EcsController.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+
+#include <mainTesting.h>
+
+
+namespace {
+
+	//---------------------------------
+	// TestFrame
+	//
+	// Drives the tick manager like the main loop does, ticking an ECS once per frame and counting fixed steps
+	//
+	class TestFrame final : public core::I_RealTimeTickTriggerer, public core::I_Tickable
+	{
+	public:
+		TestFrame(fw::EcsController& ecs) : core::I_Tickable(0u), m_Ecs(ecs) { RegisterAsTriggerer(); }
+
+		void Trigger() { TriggerTick(); }
+
+		void OnFixedTick() override { ++m_FixedSteps; }
+		void OnTick() override { m_Ecs.Process(); }
+
+		fw::EcsController& m_Ecs;
+		uint32 m_FixedSteps = 0u;
+	};
+
+	//---------------------------------
+	// TestEventData
+	//
+	// Polymorphic event data, like render and scene events
+	//
+	class TestEventData final
+	{
+	public:
+		TestEventData(uint32 const value) : m_Value(value) {}
+		virtual ~TestEventData() = default;
+
+		uint32 m_Value;
+	};
+
+	typedef core::GenericEventDispatcher<uint8, TestEventData> T_TestEventDispatcher;
+
+} // namespace
+
+
+TEST_CASE("linear arena", "[memory]")
+{
+	core::LinearArena arena(256u);
+	REQUIRE(arena.GetCapacity() == 256u);
+	REQUIRE(arena.GetUsed() == 0u);
+
+	// alignment
+	uint8* const byte = arena.AllocateArray<uint8>(1u);
+	double* const dbl = arena.AllocateArray<double>(1u);
+	REQUIRE(arena.Owns(byte));
+	REQUIRE(arena.Owns(dbl));
+	REQUIRE(reinterpret_cast<uintptr_t>(dbl) % alignof(double) == 0u);
+
+	void* const aligned = arena.Allocate(8u, 64u);
+	REQUIRE(reinterpret_cast<uintptr_t>(aligned) % 64u == 0u);
+
+	// rewinding releases everything allocated after the marker
+	core::LinearArena::Marker const marker = arena.GetMarker();
+	size_t const usedAtMarker = arena.GetUsed();
+
+	uint32* const ints = arena.AllocateArray<uint32>(4u);
+	REQUIRE(arena.GetUsed() > usedAtMarker);
+
+	arena.Rewind(marker);
+	REQUIRE(arena.GetUsed() == usedAtMarker);
+	REQUIRE(arena.AllocateArray<uint32>(4u) == ints);
+
+	// freeing the latest allocation gives the memory back, older allocations are unaffected
+	size_t const usedBeforeFree = arena.GetUsed();
+	uint32* const last = arena.AllocateArray<uint32>(2u);
+	arena.Free(last, 2u * sizeof(uint32));
+	REQUIRE(arena.GetUsed() == usedBeforeFree);
+
+	arena.Free(dbl, sizeof(double));
+	REQUIRE(arena.GetUsed() == usedBeforeFree);
+
+	// exceeding the capacity spills over, and the arena grows on the next reset
+	void* const big = arena.Allocate(512u);
+	REQUIRE(big != nullptr);
+	REQUIRE_FALSE(arena.Owns(big));
+	REQUIRE(arena.GetOverflowCount() == 1u);
+
+	arena.Reset();
+	REQUIRE(arena.GetUsed() == 0u);
+	REQUIRE(arena.GetOverflowCount() == 0u);
+	REQUIRE(arena.GetCapacity() > 512u);
+
+	REQUIRE(arena.Owns(arena.Allocate(512u)));
+}
+
+TEST_CASE("frame allocator", "[memory]")
+{
+	core::FrameAllocator* const frameAlloc = core::FrameAllocator::GetInstance();
+	frameAlloc->SwapFrames();
+
+	uint64 const startFrame = frameAlloc->GetFrameIndex();
+
+	// data allocated in a frame survives the next frame
+	uint32* const data = frameAlloc->New<uint32>(42u);
+	core::LinearArena const* const firstArena = &frameAlloc->GetCurrentArena();
+
+	frameAlloc->SwapFrames();
+	REQUIRE(frameAlloc->GetFrameIndex() == startFrame + 1u);
+	REQUIRE(&frameAlloc->GetCurrentArena() != firstArena);
+	REQUIRE(*data == 42u);
+
+	// after another frame the original arena is reused
+	frameAlloc->SwapFrames();
+	REQUIRE(&frameAlloc->GetCurrentArena() == firstArena);
+	REQUIRE(frameAlloc->GetCurrentArena().GetUsed() == 0u);
+
+	core::FrameAllocator::DestroyInstance();
+}
+
+TEST_CASE("scratch scope", "[memory]")
+{
+	core::LinearArena& arena = core::GetScratchArena();
+	size_t const usedBefore = arena.GetUsed();
+	REQUIRE_FALSE(core::IsScratchScopeActive());
+
+	{
+		core::ScratchScope const outer;
+		REQUIRE(core::IsScratchScopeActive());
+		arena.AllocateArray<float>(16u);
+
+		size_t const usedOuter = arena.GetUsed();
+
+		{
+			core::ScratchScope const inner;
+			arena.AllocateArray<float>(16u);
+			REQUIRE(arena.GetUsed() > usedOuter);
+		}
+
+		REQUIRE(arena.GetUsed() == usedOuter);
+		REQUIRE(core::IsScratchScopeActive());
+	}
+
+	REQUIRE(arena.GetUsed() == usedBefore);
+	REQUIRE_FALSE(core::IsScratchScopeActive());
+}
+
+TEST_CASE("pool allocator", "[memory]")
+{
+	core::PoolAllocator pool(sizeof(uint32), 4u);
+	REQUIRE(pool.GetBlockSize() >= sizeof(uint32));
+	REQUIRE(pool.GetCapacity() == 0u);
+
+	void* const first = pool.Allocate();
+	void* const second = pool.Allocate();
+	REQUIRE(first != second);
+	REQUIRE(pool.Owns(first));
+	REQUIRE(pool.GetLiveCount() == 2u);
+	REQUIRE(pool.GetCapacity() == 4u);
+
+	// freed blocks are reused first
+	pool.Free(first);
+	REQUIRE(pool.Allocate() == first);
+
+	// exceeding a chunk adds a new one
+	std::vector<void*> blocks;
+	for (size_t idx = 0u; idx < 6u; ++idx)
+	{
+		blocks.push_back(pool.Allocate());
+	}
+
+	REQUIRE(pool.GetCapacity() == 8u);
+	REQUIRE(pool.GetLiveCount() == 8u);
+
+	for (void* const block : blocks)
+	{
+		pool.Free(block);
+	}
+
+	pool.Free(first);
+	pool.Free(second);
+	REQUIRE(pool.GetLiveCount() == 0u);
+}
+
+TEST_CASE("stl allocators", "[memory]")
+{
+	core::ScratchScope const scope;
+
+	core::ScratchVector<uint32> vec;
+	for (uint32 idx = 0u; idx < 100u; ++idx)
+	{
+		vec.push_back(idx);
+	}
+
+	REQUIRE(core::GetScratchArena().Owns(vec.data()));
+	REQUIRE(vec[99] == 99u);
+
+	std::map<uint32, float, std::less<uint32>, core::PoolStlAllocator<std::pair<uint32 const, float>>> map;
+	map[3u] = 3.f;
+	map[1u] = 1.f;
+	REQUIRE(map.size() == 2u);
+	REQUIRE(map.begin()->second == 1.f);
+}
+
+TEST_CASE("steady state allocations", "[memory][ecs]")
+{
+	fw::EcsController ecs;
+	for (uint32 idx = 0u; idx < static_cast<uint32>(16u); ++idx)
+	{
+		ecs.AddEntity(TestOverwriteComp(), TestCComponent(idx));
+	}
+
+	ecs.RegisterSystem<TestOverwriteSystem>(4u);
+
+	core::TickManager* const tickMan = core::TickManager::GetInstance();
+	TestFrame frame(ecs);
+
+	// listeners with captures too large for std::function to store inline
+	T_TestEventDispatcher events;
+	uint32 received = 0u;
+	uint32 valueSum = 0u;
+	TestFrame* const framePtr = &frame;
+	fw::EcsController* const ecsPtr = &ecs;
+
+	T_TestEventDispatcher::T_CallbackFn listener = [&received, &valueSum, framePtr, ecsPtr](uint8 const flags, TestEventData const* const data)
+		{
+			UNUSED(flags);
+			UNUSED(framePtr);
+			UNUSED(ecsPtr);
+
+			++received;
+			valueSum += data->m_Value;
+		};
+
+	T_TestEventDispatcher::T_CallbackId const listenerId = events.Register(1u, listener);
+	T_TestEventDispatcher::T_CallbackId const otherListenerId = events.Register(1u | 2u, listener);
+
+	auto const runFrame = [&frame, tickMan, &events](uint32 const idx)
+		{
+			frame.Trigger();
+			tickMan->RunFixedSteps(tickMan->GetFixedTimestep());
+
+			TestEventData const eventData(idx);
+			events.Notify(1u, &eventData);
+		};
+
+	// warm up - scratch arenas, pools and singletons are created on first use
+	runFrame(0u);
+
+	uint32 const fixedSteps = frame.m_FixedSteps;
+
+	size_t allocationCount = 0u;
+	{
+		core::ScopedAllocationCounter const counter;
+
+		for (uint32 frameIdx = 1u; frameIdx <= 10u; ++frameIdx)
+		{
+			runFrame(frameIdx);
+		}
+
+		allocationCount = counter.GetAllocationCount();
+	}
+
+	REQUIRE(allocationCount == 0u);
+
+	// the work actually happened
+	REQUIRE(frame.m_FixedSteps == fixedSteps + 10u);
+	REQUIRE(received == 2u * 11u);
+	REQUIRE(valueSum == 2u * 55u);
+
+	T_TestEventDispatcher::T_CallbackId removedId = listenerId;
+	events.Unregister(removedId);
+	removedId = otherListenerId;
+	events.Unregister(removedId);
+}
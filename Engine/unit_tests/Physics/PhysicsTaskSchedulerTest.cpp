@@ -0,0 +1,105 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtCore/Util/JobPool.h>
+
+#include <EtFramework/Physics/PhysicsTaskScheduler.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// CountBody
+	//
+	// Counts how often each index was visited
+	//
+	class CountBody final : public btIParallelForBody
+	{
+	public:
+		CountBody(size_t const count) : m_Visits(count) {}
+
+		void forLoop(int iBegin, int iEnd) const override
+		{
+			for (int idx = iBegin; idx < iEnd; ++idx)
+			{
+				++m_Visits[static_cast<size_t>(idx)];
+			}
+		}
+
+		mutable std::vector<std::atomic<uint32>> m_Visits;
+	};
+
+	//---------------------------------
+	// SumBody
+	//
+	class SumBody final : public btIParallelSumBody
+	{
+	public:
+		btScalar sumLoop(int iBegin, int iEnd) const override
+		{
+			btScalar sum = btScalar(0);
+			for (int idx = iBegin; idx < iEnd; ++idx)
+			{
+				sum += btScalar(1) / static_cast<btScalar>(idx + 1);
+			}
+
+			return sum;
+		}
+	};
+
+} // namespace
+
+
+TEST_CASE("physics task scheduler for", "[physics]")
+{
+	// the scheduler runs on the shared job pool, which may have fewer threads
+	int const threadCount = std::min(4, static_cast<int>(core::JobPool::GetInstance()->GetThreadCount()));
+
+	fw::PhysicsTaskScheduler scheduler(4u);
+	REQUIRE(scheduler.getNumThreads() == threadCount);
+
+	for (int32 const grainSize : { 1, 7, 64, 10000 })
+	{
+		CountBody body(1000u);
+		scheduler.parallelFor(0, 1000, grainSize, body);
+
+		for (std::atomic<uint32> const& visits : body.m_Visits)
+		{
+			REQUIRE(visits.load() == 1u);
+		}
+	}
+
+	// threads beyond the worker count are ignored
+	scheduler.setNumThreads(1000);
+	REQUIRE(scheduler.getNumThreads() == threadCount);
+
+	scheduler.setNumThreads(1);
+	REQUIRE(scheduler.getNumThreads() == 1);
+
+	CountBody body(100u);
+	scheduler.parallelFor(0, 100, 3, body);
+	REQUIRE(body.m_Visits[99].load() == 1u);
+}
+
+TEST_CASE("physics task scheduler sum", "[physics]")
+{
+	fw::PhysicsTaskScheduler scheduler(4u);
+
+	SumBody const body;
+	btScalar const expected = scheduler.parallelSum(0, 5000, 13, body);
+	REQUIRE(expected > btScalar(0));
+
+	// grains are summed in order, so the result doesn't depend on which thread finished first
+	for (uint32 run = 0u; run < 20u; ++run)
+	{
+		REQUIRE(scheduler.parallelSum(0, 5000, 13, body) == expected);
+	}
+
+	REQUIRE(scheduler.parallelSum(10, 10, 13, body) == btScalar(0));
+}
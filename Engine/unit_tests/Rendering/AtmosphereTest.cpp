@@ -0,0 +1,120 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+#include <EtCore/FileSystem/Json/JsonParser.h>
+
+#include <EtRendering/GlobalRenderingSystems/CIE.h>
+#include <EtRendering/GlobalRenderingSystems/AtmospherePrecompute.h>
+#include <EtRendering/PlanetTech/AtmosphereSettings.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	// a flat spectrum sampled only at the ends of the visible range, so that interpolation results are known
+	std::string const s_FlatAtmosphere(
+		"{"
+		"\"lambdaMin\": 360, \"lambdaMax\": 830, \"lambda increment\": 470,"
+		"\"solarIrradiance\": [1.5, 1.5], \"ozoneCrossSection\": [0, 0],"
+		"\"dobsonUnit\": 2.687e+20, \"ozone altitude\": 15000, \"ozone dobson units\": 300, \"ozone constant divisor\": 3.0,"
+		"\"rayleigh\": 1.24062e-06, \"rayleighScaleHeight\": 8000, \"rayleigh lambda exp\": -4,"
+		"\"mieScaleHeight\": 1200, \"mieAngstromAlpha\": 0, \"mieAngstromBeta\": 0.005328, \"mieSingleScatteringAlbedo\": 0.9,"
+		"\"groundAlbedo\": 0.1,"
+		"\"rayleigh layer\": {\"width\": 0, \"exp term\": 1, \"exp scale\": -1, \"linear term\": 0, \"constant term\": 0},"
+		"\"mie layer\": {\"width\": 0, \"exp term\": 1, \"exp scale\": -1, \"linear term\": 0, \"constant term\": 0},"
+		"\"ozone density\": [{\"width\": 25000.0, \"exp term\": 0, \"exp scale\": 0, \"linear term\": 1, \"constant term\": -2.0},"
+		" {\"width\": 0, \"exp term\": 0, \"exp scale\": 0, \"linear term\": -1, \"constant term\": 8}],"
+		"\"length unit in meters\": 1000, \"sun angular diameter\": 0.00935, \"bottom radius\": 6360000.0, \"top radius\": 6420000.0,"
+		"\"mie phase function\": 0.8, \"mu s min\": 102"
+		"}");
+
+	// linear sRGB of the equal energy illuminant at unit luminance
+	dvec3 const s_EqualEnergyRgb(1.2049, 0.9483, 0.9090);
+
+	// integral of the luminance matching function over the visible range
+	double const s_LuminanceIntegral = 106.857;
+
+	//---------------------------------
+	// LoadCie
+	//
+	// Color matching functions as the engine ships them
+	//
+	bool LoadCie(render::CIE& cie)
+	{
+		core::File* const cieFile = new core::File(global::g_UnitTestDir + "../resources/assets/cie.json", nullptr);
+		if (!cieFile->Open(core::FILE_ACCESS_MODE::Read))
+		{
+			delete cieFile;
+			return false;
+		}
+
+		core::JSON::Parser parser = core::JSON::Parser(core::FileUtil::AsText(cieFile->Read()));
+		delete cieFile;
+
+		return cie.Load(parser.GetRoot());
+	}
+
+	//---------------------------------
+	// IsNear
+	//
+	bool IsNear(dvec3 const& lhs, dvec3 const& rhs, double const tolerance)
+	{
+		return (std::abs(lhs.x - rhs.x) < tolerance) && (std::abs(lhs.y - rhs.y) < tolerance) && (std::abs(lhs.z - rhs.z) < tolerance);
+	}
+
+} // namespace
+
+
+TEST_CASE("cie equal energy white", "[graphics]")
+{
+	render::CIE cie;
+	REQUIRE(LoadCie(cie));
+	REQUIRE(cie.IsLoaded());
+
+	std::vector<double> const wavelengths = { 360.0, 830.0 };
+	std::vector<double> const spectrum = { 1.0, 1.0 };
+
+	dvec3 color;
+	render::AtmospherePrecompute::ComputeSpectralRadianceToLuminanceFactors(cie, wavelengths, spectrum, 0.0, color);
+
+	dvec3 const normalized = color / (render::AtmosphereSettings::MAX_LUMINOUS_EFFICACY * s_LuminanceIntegral);
+	REQUIRE(IsNear(normalized, s_EqualEnergyRgb, 1e-3));
+}
+
+TEST_CASE("atmosphere parameters headless", "[graphics]")
+{
+	render::CIE cie;
+	REQUIRE(LoadCie(cie));
+
+	core::JSON::Parser parser = core::JSON::Parser(s_FlatAtmosphere);
+	REQUIRE(parser.GetRoot() != nullptr);
+
+	dvec3 skyColor;
+	dvec3 sunColor;
+	render::AtmosphereParameters const params(parser.GetRoot(), cie, skyColor, sunColor);
+
+	REQUIRE(IsNear(math::vecCast<double>(params.solarIrradiance), dvec3(1.5), 1e-6));
+	REQUIRE(IsNear(math::vecCast<double>(params.groundAlbedo), dvec3(0.1), 1e-6));
+
+	// no angstrom exponent, so mie extinction is the same for all wavelengths, in units of kilometers
+	double const mieExtinction = 0.005328 / 1200.0 * 1000.0;
+	REQUIRE(IsNear(math::vecCast<double>(params.mieExtinction), dvec3(mieExtinction), 1e-6));
+	REQUIRE(IsNear(math::vecCast<double>(params.mieScattering), dvec3(mieExtinction * 0.9), 1e-6));
+
+	// rayleigh scattering falls off with the fourth power of the wavelength
+	REQUIRE(params.rayleighScattering.x < params.rayleighScattering.y);
+	REQUIRE(params.rayleighScattering.y < params.rayleighScattering.z);
+
+	// with a flat solar spectrum the sun is equal energy white
+	REQUIRE(IsNear(sunColor / (render::AtmosphereSettings::MAX_LUMINOUS_EFFICACY * s_LuminanceIntegral), s_EqualEnergyRgb, 1e-3));
+	REQUIRE(skyColor.x > 0.0);
+	REQUIRE(skyColor.y > 0.0);
+	REQUIRE(skyColor.z > 0.0);
+}
@@ -0,0 +1,193 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/GraphicsTypes/Frustum.h>
+#include <EtRendering/GraphicsTypes/FrustumCulling.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// GenBounds
+	//
+	// Deterministic spheres scattered around the origin
+	//
+	render::SphereBounds GenBounds(size_t const count)
+	{
+		render::SphereBounds bounds;
+
+		uint32 state = 2463534242u;
+		auto nextFloat = [&state]() -> float
+			{
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				return static_cast<float>(state & 0xFFFFu) / 65535.f;
+			};
+
+		for (size_t idx = 0u; idx < count; ++idx)
+		{
+			vec3 const pos((nextFloat() - 0.5f) * 1000.f, (nextFloat() - 0.5f) * 1000.f, (nextFloat() - 0.5f) * 1000.f);
+			bounds.Add(math::Sphere(pos, 1.f + nextFloat() * 4.f));
+		}
+
+		return bounds;
+	}
+
+	//---------------------------------
+	// SetupFrustum
+	//
+	void SetupFrustum(render::Frustum& frustum)
+	{
+		render::Camera camera;
+		camera.SetTransformation(vec3(0.f), vec3::FORWARD, vec3::UP, true);
+		camera.SetFieldOfView(45.f, true);
+		camera.SetClippingPlanes(0.1f, 400.f, true);
+
+		frustum.SetCullTransform(mat4());
+		frustum.SetToCamera(camera);
+		frustum.Update(16.f / 9.f);
+	}
+
+	//---------------------------------
+	// CheckAgainstFrustum
+	//
+	// Spheres touching a plane are skipped, as the batch test reorders the plane distance calculation
+	//
+	void CheckAgainstFrustum(render::Frustum const& frustum, render::SphereBounds const& bounds, std::vector<uint32> const& visible)
+	{
+		REQUIRE(std::is_sorted(visible.cbegin(), visible.cend()));
+
+		std::vector<bool> isVisible(bounds.Size(), false);
+		for (uint32 const idx : visible)
+		{
+			isVisible[idx] = true;
+		}
+
+		size_t checked = 0u;
+		for (size_t idx = 0u; idx < bounds.Size(); ++idx)
+		{
+			math::Sphere const sphere = bounds.Get(idx);
+
+			bool touchesPlane = false;
+			for (math::Plane const& plane : frustum.GetPlanes())
+			{
+				touchesPlane = touchesPlane || (std::abs(math::dot(plane.n, sphere.pos - plane.d) + sphere.radius) < 0.01f);
+			}
+
+			if (!touchesPlane)
+			{
+				REQUIRE(isVisible[idx] == (frustum.ContainsSphere(sphere) != render::VolumeCheck::OUTSIDE));
+				++checked;
+			}
+		}
+
+		REQUIRE(checked > bounds.Size() / 2u);
+	}
+
+} // namespace
+
+
+TEST_CASE("batch culling matches frustum", "[culling]")
+{
+	render::Frustum frustum;
+	SetupFrustum(frustum);
+
+	render::FrustumCuller const culler(frustum);
+	std::vector<uint32> visible;
+
+	SECTION("partial batch")
+	{
+		render::SphereBounds const bounds = GenBounds(render::FrustumCuller::s_BatchSize * 100u + 5u);
+		culler.Cull(bounds, visible);
+
+		REQUIRE_FALSE(visible.empty());
+		REQUIRE(visible.size() < bounds.Size());
+		CheckAgainstFrustum(frustum, bounds, visible);
+	}
+
+	SECTION("parallel chunks")
+	{
+		render::SphereBounds const bounds = GenBounds(render::FrustumCuller::s_ParallelThreshold * 2u + 3u);
+		culler.Cull(bounds, visible);
+
+		CheckAgainstFrustum(frustum, bounds, visible);
+	}
+
+	SECTION("empty")
+	{
+		visible.push_back(3u);
+		culler.Cull(render::SphereBounds(), visible);
+
+		REQUIRE(visible.empty());
+	}
+}
+
+TEST_CASE("batch culling against a light projection", "[culling]")
+{
+	// engine matrices combine left to right, so this projects after the view transform
+	mat4 const lightView = math::lookAt(vec3(0.f, 200.f, 0.f), vec3(0.f, 0.f, 50.f), vec3(0.f, 0.f, 1.f));
+	mat4 const lightVP = lightView * math::orthographic(-300.f, 300.f, 200.f, -200.f, -100.f, 400.f);
+
+	render::FrustumCuller culler;
+	culler.SetViewProjection(lightVP);
+
+	render::SphereBounds const bounds = GenBounds(1000u);
+
+	std::vector<uint32> visible;
+	culler.Cull(bounds, visible);
+	REQUIRE_FALSE(visible.empty());
+
+	std::vector<bool> isVisible(bounds.Size(), false);
+	for (uint32 const idx : visible)
+	{
+		isVisible[idx] = true;
+	}
+
+	// spheres touching the border of clip space are skipped
+	for (size_t idx = 0u; idx < bounds.Size(); ++idx)
+	{
+		math::Sphere const sphere = bounds.Get(idx);
+
+		vec4 const clipPos = lightVP * vec4(sphere.pos, 1.f);
+		vec3 const clipRadius = vec3(sphere.radius / 300.f, sphere.radius / 200.f, sphere.radius / 250.f);
+		vec3 const distance = vec3(std::abs(clipPos.x), std::abs(clipPos.y), std::abs(clipPos.z)) - vec3(1.f);
+
+		if ((distance.x > clipRadius.x) || (distance.y > clipRadius.y) || (distance.z > clipRadius.z))
+		{
+			REQUIRE_FALSE(isVisible[idx]);
+		}
+		else if ((distance.x < 0.f) && (distance.y < 0.f) && (distance.z < 0.f))
+		{
+			REQUIRE(isVisible[idx]);
+		}
+	}
+}
+
+TEST_CASE("sphere bounds", "[culling]")
+{
+	render::SphereBounds bounds;
+	bounds.Add(math::Sphere(vec3(1.f, 0.f, 0.f), 1.f));
+	bounds.Add(math::Sphere(vec3(2.f, 0.f, 0.f), 2.f));
+	bounds.Add(math::Sphere(vec3(3.f, 0.f, 0.f), 3.f));
+
+	bounds.RemoveSwap(0u);
+	REQUIRE(bounds.Size() == 2u);
+	REQUIRE(bounds.Get(0u).radius == Approx(3.f));
+	REQUIRE(bounds.Get(1u).radius == Approx(2.f));
+
+	bounds.RemoveSwap(1u);
+	REQUIRE(bounds.Size() == 1u);
+	REQUIRE(bounds.m_X[0] == Approx(3.f));
+
+	math::Sphere const transformed = render::SphereBounds::TransformSphere(math::Sphere(vec3(1.f, 0.f, 0.f), 1.f), math::translate(vec3(0.f, 5.f, 0.f)));
+	REQUIRE(transformed.pos.x == Approx(1.f));
+	REQUIRE(transformed.pos.y == Approx(5.f));
+}
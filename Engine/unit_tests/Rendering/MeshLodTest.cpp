@@ -0,0 +1,45 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsTypes/MeshLod.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+TEST_CASE("mesh lod select", "[graphics]")
+{
+	std::vector<render::MeshLod> lods(4u);
+	lods[1].m_Error = 0.01f;
+	lods[2].m_Error = 0.05f;
+	lods[3].m_Error = 0.2f;
+
+	float const threshold = 0.001f;
+
+	SECTION("close meshes use full detail")
+	{
+		REQUIRE(render::MeshLod::Select(lods, 1.f, threshold) == 0u);
+		REQUIRE(render::MeshLod::Select(lods, 0.2f, threshold) == 0u);
+	}
+
+	SECTION("coarser levels with distance")
+	{
+		REQUIRE(render::MeshLod::Select(lods, 0.08f, threshold) == 1u);
+		REQUIRE(render::MeshLod::Select(lods, 0.02f, threshold) == 2u);
+		REQUIRE(render::MeshLod::Select(lods, 0.001f, threshold) == 3u);
+	}
+
+	SECTION("larger thresholds select coarser levels")
+	{
+		REQUIRE(render::MeshLod::Select(lods, 0.1f, threshold * 4.f) == 1u);
+		REQUIRE(render::MeshLod::Select(lods, 0.015f, threshold * 4.f) == 3u);
+	}
+
+	SECTION("a single level is always selected")
+	{
+		REQUIRE(render::MeshLod::Select(std::vector<render::MeshLod>(1u), 0.f, threshold) == 0u);
+	}
+}
@@ -0,0 +1,247 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsContext/NullGraphicsContext.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	std::string const s_VertexSource(
+		"#version 400 core\n"
+		"#define NUM_CASCADES 3\n"
+		"layout (location = 0) in vec3 position;\n"
+		"layout (location = 2) in vec2 texCoord; // uv\n"
+		"in uint textureId;\n"
+		"out VSO { vec2 texCoord; } outputs;\n"
+		"layout (std140) uniform SharedVars { mat4 viewProjection; };\n"
+		"uniform mat4 model;\n"
+		"uniform float cascadeDistances[NUM_CASCADES];\n"
+		"/* uniform float commentedOut; */\n"
+		"vec4 Transform(in vec3 pos) { return model * vec4(pos, 1.0); }\n"
+		"void main() { outputs.texCoord = texCoord; gl_Position = viewProjection * Transform(position); }\n");
+
+	std::string const s_FragmentSource(
+		"#version 400 core\n"
+		"in VSO { vec2 texCoord; } inputs;\n"
+		"layout (location = 0) out vec4 outColor;\n"
+		"uniform sampler2D uTexture;\n"
+		"uniform mat4 model;\n"
+		"uniform vec4 uColor, uTint;\n"
+		"void main() { outColor = texture(uTexture, inputs.texCoord) * uColor * uTint; }\n");
+
+	render::T_ShaderLoc CreateTestProgram(render::NullGraphicsContext& context)
+	{
+		render::T_ShaderLoc const vertShader = context.CreateShader(render::E_ShaderType::Vertex);
+		context.CompileShader(vertShader, s_VertexSource);
+
+		render::T_ShaderLoc const fragShader = context.CreateShader(render::E_ShaderType::Fragment);
+		context.CompileShader(fragShader, s_FragmentSource);
+
+		render::T_ShaderLoc const program = context.CreateProgram();
+		context.AttachShader(program, vertShader);
+		context.AttachShader(program, fragShader);
+		context.LinkProgram(program);
+
+		return program;
+	}
+
+}
+
+
+TEST_CASE("null context shader reflection", "[graphics]")
+{
+	render::NullGraphicsContext context;
+	render::T_ShaderLoc const program = CreateTestProgram(context);
+
+	// blocks
+	std::vector<std::string> const blocks = context.GetUniformBlockNames(program);
+	REQUIRE(blocks.size() == 1u);
+	REQUIRE(blocks[0] == "SharedVars");
+	REQUIRE(context.IsBlockIndexValid(context.GetUniformBlockIndex(program, "SharedVars")));
+	REQUIRE_FALSE(context.IsBlockIndexValid(context.GetUniformBlockIndex(program, "Missing")));
+
+	// uniforms - duplicates across stages are merged, arrays are expanded
+	std::vector<int32> const blockIndices = context.GetUniformIndicesForBlock(program, 0);
+	REQUIRE(blockIndices.size() == 1u);
+
+	std::vector<render::UniformDescriptor> uniforms;
+	for (int32 uniIdx = 0; uniIdx < context.GetUniformCount(program); ++uniIdx)
+	{
+		if (std::find(blockIndices.cbegin(), blockIndices.cend(), uniIdx) == blockIndices.cend())
+		{
+			context.GetActiveUniforms(program, static_cast<uint32>(uniIdx), uniforms);
+		}
+	}
+
+	REQUIRE(uniforms.size() == 7u);
+	REQUIRE(uniforms[0].name == "model");
+	REQUIRE(uniforms[0].type == render::E_ParamType::Matrix4x4);
+	REQUIRE(uniforms[1].name == "cascadeDistances[0]");
+	REQUIRE(uniforms[3].name == "cascadeDistances[2]");
+	REQUIRE(uniforms[3].location == uniforms[1].location + 2);
+	REQUIRE(uniforms[4].type == render::E_ParamType::Texture2D);
+	REQUIRE(uniforms[6].name == "uTint");
+
+	// attributes
+	REQUIRE(context.GetAttributeCount(program) == 3);
+
+	render::AttributeDescriptor attribute;
+	context.GetActiveAttribute(program, 1u, attribute);
+	REQUIRE(attribute.name == "texCoord");
+	REQUIRE(attribute.dataType == render::E_DataType::Float);
+	REQUIRE(attribute.dataCount == 2u);
+
+	REQUIRE(context.GetAttributeLocation(program, "position") == 0);
+	REQUIRE(context.GetAttributeLocation(program, "texCoord") == 2);
+	REQUIRE(context.GetAttributeLocation(program, "textureId") == 3);
+	REQUIRE(context.GetAttributeLocation(program, "pos") == -1);
+}
+
+TEST_CASE("null context uniform block layout", "[graphics]")
+{
+	render::NullGraphicsContext context;
+
+	render::T_ShaderLoc const fragShader = context.CreateShader(render::E_ShaderType::Fragment);
+	context.CompileShader(fragShader, 
+		"#version 330 core\n"
+		"layout (std140) uniform MaterialParameters\n"
+		"{\n"
+		"	float uRoughness;\n"
+		"	vec3 uBaseColor;\n"
+		"	bool uUseTex, uUseNormal;\n"
+		"	vec2 uTiling;\n"
+		"	float uWeights[2];\n"
+		"	mat4 uUvTransform;\n"
+		"};\n"
+		"uniform sampler2D uTexture;\n"
+		"out vec4 outColor;\n"
+		"void main() { outColor = vec4(uBaseColor, uRoughness); }\n");
+
+	render::T_ShaderLoc const program = context.CreateProgram();
+	context.AttachShader(program, fragShader);
+	context.LinkProgram(program);
+
+	render::T_BlockIndex const blockIndex = context.GetUniformBlockIndex(program, "MaterialParameters");
+	REQUIRE(blockIndex == 0);
+
+	std::vector<int32> const indices = context.GetUniformIndicesForBlock(program, blockIndex);
+	REQUIRE(indices.size() == 7u);
+
+	std::vector<render::UniformDescriptor> members;
+	for (int32 const uniIdx : indices)
+	{
+		context.GetActiveUniforms(program, static_cast<uint32>(uniIdx), members);
+	}
+
+	REQUIRE(members.size() == 8u);
+	REQUIRE(members[0].blockOffset == 0);
+	REQUIRE(members[1].blockOffset == 16); // vec3 aligns to 16
+	REQUIRE(members[2].blockOffset == 28); // packs behind the vec3
+	REQUIRE(members[3].blockOffset == 32);
+	REQUIRE(members[4].blockOffset == 40);
+	REQUIRE(members[5].name == "uWeights[0]");
+	REQUIRE(members[5].blockOffset == 48); // array elements have a stride of 16
+	REQUIRE(members[6].blockOffset == 64);
+	REQUIRE(members[7].blockOffset == 80);
+
+	for (render::UniformDescriptor const& member : members)
+	{
+		REQUIRE(member.location == -1);
+	}
+
+	// default block uniforms come first and keep their locations
+	std::vector<render::UniformDescriptor> uniforms;
+	context.GetActiveUniforms(program, 0u, uniforms);
+	REQUIRE(uniforms.size() == 1u);
+	REQUIRE(uniforms[0].name == "uTexture");
+	REQUIRE(uniforms[0].blockOffset == -1);
+}
+
+TEST_CASE("null context command log", "[graphics]")
+{
+	render::NullGraphicsContext context;
+
+	render::T_ArrayLoc vao = context.CreateVertexArray();
+	context.BindVertexArray(vao);
+
+	render::T_BufferLoc buffer = context.CreateBuffer();
+	context.BindBuffer(render::E_BufferType::Vertex, buffer);
+	context.SetBufferData(render::E_BufferType::Vertex, 256, nullptr, render::E_UsageHint::Dynamic);
+
+	void* const mapped = context.MapBuffer(render::E_BufferType::Vertex, render::E_AccessMode::Write);
+	REQUIRE(mapped != nullptr);
+	memset(mapped, 1, 256u);
+	context.UnmapBuffer(render::E_BufferType::Vertex);
+
+	context.DebugPushGroup("draw");
+	context.DrawArrays(render::E_DrawMode::Triangles, 0u, 3u); // no shader bound
+	context.DebugPopGroup();
+
+	render::GraphicsCommandLog const& log = context.GetLog();
+	REQUIRE(log.GetDrawCount() == 1u);
+	REQUIRE(log.GetCount(render::E_GraphicsCommand::BindBuffer) == 1u);
+	REQUIRE(log.GetBytes(render::E_GraphicsCommand::SetBufferData) == 256u);
+	REQUIRE(log.GetTotalBytes() == 512u); // upload and map
+
+	SECTION("validation")
+	{
+		std::vector<std::string> errors;
+		REQUIRE_FALSE(log.Validate(errors));
+		REQUIRE(errors.size() == 1u);
+
+		context.DeleteBuffer(buffer);
+		context.BindBuffer(render::E_BufferType::Vertex, buffer);
+		context.DebugPushGroup("unbalanced");
+
+		errors.clear();
+		REQUIRE_FALSE(log.Validate(errors));
+		REQUIRE(errors.size() == 3u);
+	}
+
+	SECTION("comparison")
+	{
+		render::GraphicsCommandLog const golden = log;
+		REQUIRE(log.FindFirstDifference(golden) == render::GraphicsCommandLog::s_NoDifference);
+
+		size_t const commandCount = log.GetCommands().size();
+		context.DrawArrays(render::E_DrawMode::Triangles, 0u, 6u);
+		REQUIRE(log.FindFirstDifference(golden) == commandCount);
+
+		context.GetLog().Clear();
+		REQUIRE(log.GetCommands().empty());
+		REQUIRE(log.GetDrawCount() == 0u);
+	}
+}
+
+TEST_CASE("null context map buffer range", "[graphics]")
+{
+	render::NullGraphicsContext context;
+
+	render::T_BufferLoc buffer = context.CreateBuffer();
+	context.BindBuffer(render::E_BufferType::Vertex, buffer);
+	context.SetBufferData(render::E_BufferType::Vertex, 256, nullptr, render::E_UsageHint::Dynamic);
+
+	uint8* const mapped = static_cast<uint8*>(context.MapBuffer(render::E_BufferType::Vertex, render::E_AccessMode::Write));
+	REQUIRE(mapped != nullptr);
+	context.UnmapBuffer(render::E_BufferType::Vertex);
+
+	void* const range = context.MapBufferRange(render::E_BufferType::Vertex, 64, 128, true);
+	REQUIRE(range == static_cast<void*>(mapped + 64));
+	context.UnmapBuffer(render::E_BufferType::Vertex);
+
+	REQUIRE(context.MapBufferRange(render::E_BufferType::Vertex, 192, 128, false) == nullptr); // out of bounds
+	context.UnmapBuffer(render::E_BufferType::Vertex);
+
+	render::GraphicsCommandLog const& log = context.GetLog();
+	REQUIRE(log.GetCount(render::E_GraphicsCommand::MapBufferRange) == 2u);
+	REQUIRE(log.GetBytes(render::E_GraphicsCommand::MapBufferRange) == 256u);
+
+	std::vector<std::string> errors;
+	REQUIRE(log.Validate(errors));
+}
@@ -0,0 +1,179 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtCore/FileSystem/Entry.h>
+#include <EtCore/FileSystem/FileUtil.h>
+
+#include <EtRendering/GlobalRenderingSystems/PrecomputeCache.h>
+#include <EtRendering/GraphicsContext/NullGraphicsContext.h>
+#include <EtRendering/GraphicsContext/RenderArea.h>
+#include <EtRendering/GraphicsContext/Viewport.h>
+#include <EtRendering/GraphicsTypes/TextureData.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	render::PrecomputeCache::T_Key const s_Key = 0x1234u;
+
+	//---------------------------------
+	// TestRenderArea
+	//
+	// Render area that realizes its viewport with an externally provided context
+	//
+	class TestRenderArea final : public render::I_RenderArea
+	{
+	public:
+		void SetOnInit(std::function<void(render::I_GraphicsApiContext* const)>& callback) override { m_OnInit = callback; }
+		void SetOnDeinit(std::function<void()>& callback) override { UNUSED(callback); }
+		void SetOnResize(std::function<void(vec2 const)>& callback) override { UNUSED(callback); }
+		void SetOnRender(std::function<void(render::T_FbLoc const)>& callback) override { UNUSED(callback); }
+
+		void QueueDraw() override {}
+		bool MakeCurrent() override { return true; }
+
+		ivec2 GetDimensions() const override { return ivec2(64, 64); }
+
+		void Realize(render::I_GraphicsApiContext* const api) { m_OnInit(api); }
+
+	private:
+		std::function<void(render::I_GraphicsApiContext* const)> m_OnInit;
+	};
+
+	//---------------------------------
+	// ReadEntry
+	//
+	std::vector<uint8> ReadEntry(std::string const& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<uint8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	//---------------------------------
+	// GetStoredSize
+	//
+	// Size of all levels of a texture as they are written to the cache
+	//
+	size_t GetStoredSize(render::TextureData const& texture)
+	{
+		size_t size = 0u;
+		for (int32 levelIdx = 0; levelIdx < std::max(texture.GetNumMipLevels(), 1); ++levelIdx)
+		{
+			size += texture.GetLevelDataSize(static_cast<uint8>(levelIdx));
+		}
+
+		return size;
+	}
+
+} // namespace
+
+
+TEST_CASE("precompute cache round trip", "[graphics]")
+{
+	std::string const directory = global::g_UnitTestDir + "Rendering/" + render::PrecomputeCache::s_DirectoryName + "/";
+
+	render::NullGraphicsContext context;
+	TestRenderArea area;
+	render::Viewport viewport(&area);
+	area.Realize(&context);
+
+	render::PrecomputeCache cache;
+	cache.SetDirectory(directory);
+	REQUIRE(cache.IsEnabled());
+
+	// a volume without mips and a prefiltered cube map
+	render::TextureParameters volumeParams;
+	volumeParams.genMipMaps = false;
+
+	render::TextureData* const volume = new render::TextureData(ivec2(8, 4), render::E_ColorFormat::RGBA16f, render::E_ColorFormat::RGBA, render::E_DataType::Half, 4);
+	volume->Build();
+	volume->SetParameters(volumeParams);
+
+	render::TextureData* const cubeMap = new render::TextureData(render::E_TextureType::CubeMap, ivec2(16));
+	cubeMap->Build();
+	cubeMap->SetParameters(render::TextureParameters());
+
+	REQUIRE(volume->GetTargetType() == render::E_TextureType::Texture3D);
+	REQUIRE(cubeMap->GetNumMipLevels() == 5);
+
+	REQUIRE(cache.Store(s_Key, std::vector<render::TextureData const*>{ volume, cubeMap }));
+
+	render::GraphicsCommandLog& log = context.GetLog();
+	uint64 const storedBytes = log.GetBytes(render::E_GraphicsCommand::GetTextureData);
+	REQUIRE(storedBytes == static_cast<uint64>(GetStoredSize(*volume) + GetStoredSize(*cubeMap)));
+	REQUIRE(log.GetCount(render::E_GraphicsCommand::GetTextureData) == 6u);
+
+	std::string const filePath = cache.GetFilePath(s_Key);
+	std::vector<uint8> const entry = ReadEntry(filePath);
+	REQUIRE(entry.size() > storedBytes);
+
+	log.Clear();
+	std::vector<render::TextureData*> loaded;
+
+	SECTION("load")
+	{
+		REQUIRE(cache.Load(s_Key, loaded));
+		REQUIRE(loaded.size() == 2u);
+
+		REQUIRE(loaded[0]->GetTargetType() == render::E_TextureType::Texture3D);
+		REQUIRE(loaded[0]->GetResolution() == volume->GetResolution());
+		REQUIRE(loaded[0]->GetDepth() == 4);
+		REQUIRE(loaded[0]->GetInternalFormat() == render::E_ColorFormat::RGBA16f);
+		REQUIRE(loaded[0]->GetDataType() == render::E_DataType::Half);
+		REQUIRE(loaded[0]->GetNumMipLevels() == 1);
+
+		REQUIRE(loaded[1]->GetTargetType() == render::E_TextureType::CubeMap);
+		REQUIRE(loaded[1]->GetResolution() == cubeMap->GetResolution());
+		REQUIRE(loaded[1]->GetNumMipLevels() == cubeMap->GetNumMipLevels());
+
+		// every level is uploaded from the entry without being regenerated
+		REQUIRE(log.GetCount(render::E_GraphicsCommand::SetTextureMipData) == 6u);
+		REQUIRE(log.GetBytes(render::E_GraphicsCommand::SetTextureMipData) == storedBytes);
+
+		for (render::TextureData* const texture : loaded)
+		{
+			delete texture;
+		}
+	}
+
+	SECTION("missing")
+	{
+		REQUIRE_FALSE(cache.Load(s_Key + 1u, loaded));
+		REQUIRE(loaded.empty());
+		REQUIRE(log.GetCount(render::E_GraphicsCommand::GenerateTexture) == 0u);
+	}
+
+	SECTION("truncated")
+	{
+		// cut into the last level of the cube map, so that both textures are created before the entry is found to be invalid
+		REQUIRE(core::FileUtil::WriteFileAtomic(filePath, std::vector<uint8>(entry.cbegin(), entry.cend() - 1)));
+
+		REQUIRE_FALSE(cache.Load(s_Key, loaded));
+		REQUIRE(loaded.empty());
+		REQUIRE(log.GetCount(render::E_GraphicsCommand::GenerateTexture) == 2u);
+		REQUIRE(log.GetCount(render::E_GraphicsCommand::DeleteTexture) == 2u);
+	}
+
+	SECTION("outdated")
+	{
+		std::vector<uint8> outdated = entry;
+		++outdated[sizeof(uint32)]; // version follows the magic number
+		REQUIRE(core::FileUtil::WriteFileAtomic(filePath, outdated));
+
+		REQUIRE_FALSE(cache.Load(s_Key, loaded));
+		REQUIRE(loaded.empty());
+		REQUIRE(log.GetCount(render::E_GraphicsCommand::GenerateTexture) == 0u);
+	}
+
+	delete volume;
+	delete cubeMap;
+
+	core::Directory* const dir = new core::Directory(directory, nullptr);
+	REQUIRE(dir->Mount(true));
+	REQUIRE(dir->Delete());
+}
@@ -0,0 +1,137 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsContext/RenderArea.h>
+#include <EtRendering/GraphicsContext/Viewport.h>
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/SceneRendering/RenderQueue.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// TestRenderArea
+	//
+	// Render area without a context, only provides the dimensions for a viewport
+	//
+	class TestRenderArea final : public render::I_RenderArea
+	{
+	public:
+		void SetOnInit(std::function<void(render::I_GraphicsApiContext* const)>& callback) override { UNUSED(callback); }
+		void SetOnDeinit(std::function<void()>& callback) override { UNUSED(callback); }
+		void SetOnResize(std::function<void(vec2 const)>& callback) override { UNUSED(callback); }
+		void SetOnRender(std::function<void(render::T_FbLoc const)>& callback) override { UNUSED(callback); }
+
+		void QueueDraw() override {}
+		bool MakeCurrent() override { return true; }
+
+		ivec2 GetDimensions() const override { return ivec2(1920, 1080); }
+	};
+
+} // namespace
+
+
+TEST_CASE("render queue sort keys", "[render queue]")
+{
+	using E_SortMode = render::RenderQueue::E_SortMode;
+
+	SECTION("state front to back")
+	{
+		// state takes priority over depth
+		REQUIRE(render::RenderQueue::MakeKey(E_SortMode::StateFrontToBack, 0u, 5u, 5u, 0.9f)
+			< render::RenderQueue::MakeKey(E_SortMode::StateFrontToBack, 1u, 0u, 0u, 0.1f));
+		REQUIRE(render::RenderQueue::MakeKey(E_SortMode::StateFrontToBack, 1u, 0u, 5u, 0.9f)
+			< render::RenderQueue::MakeKey(E_SortMode::StateFrontToBack, 1u, 1u, 0u, 0.1f));
+
+		// closer first within the same state
+		REQUIRE(render::RenderQueue::MakeKey(E_SortMode::StateFrontToBack, 1u, 1u, 1u, 0.1f)
+			< render::RenderQueue::MakeKey(E_SortMode::StateFrontToBack, 1u, 1u, 1u, 0.2f));
+	}
+
+	SECTION("back to front")
+	{
+		// depth takes priority over state
+		REQUIRE(render::RenderQueue::MakeKey(E_SortMode::BackToFront, 3u, 3u, 3u, 0.9f)
+			< render::RenderQueue::MakeKey(E_SortMode::BackToFront, 0u, 0u, 0u, 0.1f));
+
+		// out of range depth is clamped
+		REQUIRE(render::RenderQueue::MakeKey(E_SortMode::BackToFront, 0u, 0u, 0u, -4.f)
+			== render::RenderQueue::MakeKey(E_SortMode::BackToFront, 0u, 0u, 0u, 0.f));
+	}
+}
+
+TEST_CASE("render queue radix sort", "[render queue]")
+{
+	std::vector<render::RenderQueue::SortEntry> entries;
+
+	uint64 state = 88172645463325252ull;
+	for (uint32 idx = 0u; idx < 1000u; ++idx)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		// few distinct upper bits so that duplicates test stability
+		entries.push_back(render::RenderQueue::SortEntry{ (state & 0xFF000000000000FFull) | (static_cast<uint64>(idx % 7u) << 32u), idx });
+	}
+
+	std::vector<render::RenderQueue::SortEntry> expected = entries;
+	std::stable_sort(expected.begin(), expected.end(), [](render::RenderQueue::SortEntry const& lhs, render::RenderQueue::SortEntry const& rhs)
+		{
+			return lhs.key < rhs.key;
+		});
+
+	std::vector<render::RenderQueue::SortEntry> scratch;
+	render::RenderQueue::RadixSort(entries, scratch);
+
+	REQUIRE(entries.size() == expected.size());
+	for (size_t idx = 0u; idx < entries.size(); ++idx)
+	{
+		REQUIRE(entries[idx].key == expected[idx].key);
+		REQUIRE(entries[idx].packet == expected[idx].packet);
+	}
+}
+
+TEST_CASE("render queue level of detail", "[render queue]")
+{
+	TestRenderArea area;
+	render::Viewport viewport(&area);
+	viewport.SynchDimensions();
+
+	render::Camera camera;
+	camera.SetViewport(&viewport, true);
+	camera.SetTransformation(vec3(0.f), vec3::FORWARD, vec3::UP, true);
+	camera.SetFieldOfView(45.f, true);
+	camera.SetClippingPlanes(0.1f, 1000.f, true);
+	camera.Recalculate();
+
+	std::vector<render::MeshLod> lods(4u);
+	lods[1].m_Error = 0.01f;
+	lods[2].m_Error = 0.05f;
+	lods[3].m_Error = 0.25f;
+
+	float const radius = 1.f;
+
+	float const nearRadius = render::RenderQueue::ProjectRadius(camera.GetProj(), 2.f, radius);
+	float const farRadius = render::RenderQueue::ProjectRadius(camera.GetProj(), 200.f, radius);
+
+	// a sphere further away covers less of the screen
+	REQUIRE(nearRadius > farRadius);
+	REQUIRE(math::nearEquals(nearRadius / farRadius, 100.f, 0.01f));
+
+	// relative to the height of the view at that depth
+	float const halfHeight = std::tan(math::radians(camera.GetFOV()) * 0.5f) * 200.f;
+	REQUIRE(math::nearEquals(farRadius, radius / (2.f * halfHeight), 0.0001f));
+
+	uint32 const nearLod = render::MeshLod::Select(lods, nearRadius, render::MeshLod::s_ScreenErrorThreshold);
+	uint32 const farLod = render::MeshLod::Select(lods, farRadius, render::MeshLod::s_ScreenErrorThreshold);
+
+	REQUIRE(nearLod == 0u);
+	REQUIRE(farLod > nearLod);
+}
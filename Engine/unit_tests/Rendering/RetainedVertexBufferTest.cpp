@@ -0,0 +1,74 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/SceneRendering/RetainedVertexBuffer.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+TEST_CASE("retained vertex buffer changed range", "[graphics]")
+{
+	std::vector<uint32> const previous = { 0u, 1u, 2u, 3u, 4u, 5u };
+	std::vector<uint32> current = previous;
+
+	auto findRange = [&previous, &current](size_t& first, size_t& count) -> bool
+		{
+			return render::RetainedVertexBuffer::FindChangedRange(reinterpret_cast<uint8 const*>(previous.data()),
+				previous.size(),
+				reinterpret_cast<uint8 const*>(current.data()),
+				current.size(),
+				sizeof(uint32),
+				first,
+				count);
+		};
+
+	size_t first = 0u;
+	size_t count = 0u;
+
+	SECTION("unchanged")
+	{
+		REQUIRE_FALSE(findRange(first, count));
+	}
+
+	SECTION("changed in the middle")
+	{
+		current[1] = 10u;
+		current[3] = 10u;
+
+		REQUIRE(findRange(first, count));
+		REQUIRE(first == 1u);
+		REQUIRE(count == 3u);
+	}
+
+	SECTION("grown")
+	{
+		current.push_back(6u);
+		current.push_back(7u);
+
+		REQUIRE(findRange(first, count));
+		REQUIRE(first == 6u);
+		REQUIRE(count == 2u);
+
+		current[0] = 10u;
+
+		REQUIRE(findRange(first, count));
+		REQUIRE(first == 0u);
+		REQUIRE(count == 8u);
+	}
+
+	SECTION("shrunk")
+	{
+		current.resize(4u);
+		REQUIRE_FALSE(findRange(first, count));
+
+		current[2] = 10u;
+
+		REQUIRE(findRange(first, count));
+		REQUIRE(first == 2u);
+		REQUIRE(count == 1u);
+	}
+}
@@ -0,0 +1,86 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/SceneRendering/ShadowRenderer.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	ivec2 const s_Resolution(1024);
+	float const s_ZNear = -500.f;
+
+	//---------------------------------
+	// GenCascade
+	//
+	// Corners of a box in light space, rotated around its center
+	//
+	std::vector<vec3> GenCascade(vec3 const& center, quat const& rotation)
+	{
+		vec3 const halfSize(31.f, 20.f, 60.f);
+
+		std::vector<vec3> corners;
+		for (uint32 cornerIdx = 0u; cornerIdx < 8u; ++cornerIdx)
+		{
+			vec3 const offset((cornerIdx & 1u) ? halfSize.x : -halfSize.x,
+				(cornerIdx & 2u) ? halfSize.y : -halfSize.y,
+				(cornerIdx & 4u) ? halfSize.z : -halfSize.z);
+
+			corners.push_back(center + rotation * offset);
+		}
+
+		return corners;
+	}
+
+	//---------------------------------
+	// GetCenter
+	//
+	// Center of an orthographic projection in light space
+	//
+	vec2 GetCenter(mat4 const& projection)
+	{
+		return vec2(-projection[3][0] / projection[0][0], -projection[3][1] / projection[1][1]);
+	}
+
+}
+
+
+TEST_CASE("shadow cascade projection", "[graphics]")
+{
+	vec3 const center(123.4f, -56.7f, -80.f);
+	mat4 const projection = render::ShadowRenderer::FitCascadeProjection(GenCascade(center, quat()), s_ZNear, s_Resolution);
+
+	float const texelSize = (2.f / projection[0][0]) / static_cast<float>(s_Resolution.x);
+	vec2 const projCenter = GetCenter(projection);
+
+	SECTION("rotation invariant")
+	{
+		// rotating around the light direction changes neither the size nor the depth range of the cascade
+		mat4 const rotated = render::ShadowRenderer::FitCascadeProjection(GenCascade(center, quat(vec3(0.f, 0.f, 1.f), 0.7f)), s_ZNear, s_Resolution);
+		REQUIRE(rotated == projection);
+	}
+
+	SECTION("snapped to texels")
+	{
+		REQUIRE(math::nearEquals(projCenter.x / texelSize, std::round(projCenter.x / texelSize), 0.01f));
+		REQUIRE(math::nearEquals(projCenter.y / texelSize, std::round(projCenter.y / texelSize), 0.01f));
+
+		// small movements move the projection by at most a single texel
+		for (uint32 stepIdx = 1u; stepIdx < 20u; ++stepIdx)
+		{
+			vec3 const moved = center + vec3(0.005f * static_cast<float>(stepIdx), 0.f, 0.f);
+			vec2 const movedCenter = GetCenter(render::ShadowRenderer::FitCascadeProjection(GenCascade(moved, quat()), s_ZNear, s_Resolution));
+
+			float const texelDelta = (movedCenter.x - projCenter.x) / texelSize;
+			REQUIRE(math::nearEquals(texelDelta, std::round(texelDelta), 0.01f));
+			REQUIRE(std::round(texelDelta) >= 0.f);
+			REQUIRE(std::round(texelDelta) <= 1.f);
+			REQUIRE(math::nearEquals(movedCenter.y, projCenter.y));
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/SceneRendering/SpriteRenderer.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// MakeSprite
+	//
+	// Sprite with its top left corner at position, covering size pixels
+	//
+	render::SpriteRenderer::SpriteVertex MakeSprite(uint32 const textureId, vec2 const& position, vec2 const& size, float const depth = 0.f)
+	{
+		render::SpriteRenderer::SpriteVertex sprite;
+		sprite.TextureId = textureId;
+		sprite.TransformData = vec4(position, depth, 0.f);
+		sprite.TransformData2 = vec4(vec2(0.f), size);
+		sprite.Color = vec4(1.f);
+		return sprite;
+	}
+
+	//---------------------------------
+	// GetTextureOrder
+	//
+	std::vector<uint32> GetTextureOrder(std::vector<render::SpriteRenderer::SpriteVertex> const& sprites)
+	{
+		std::vector<uint32> ret;
+		for (render::SpriteRenderer::SpriteVertex const& sprite : sprites)
+		{
+			ret.emplace_back(sprite.TextureId);
+		}
+
+		return ret;
+	}
+
+} // namespace
+
+
+TEST_CASE("sprite batching", "[sprites]")
+{
+	std::vector<render::SpriteRenderer::SpriteVertex> sprites;
+	render::SpriteRenderer::BatchScratch scratch;
+
+	SECTION("overlapping sprites keep submission order")
+	{
+		sprites.emplace_back(MakeSprite(0u, vec2(0.f), vec2(100.f)));
+		sprites.emplace_back(MakeSprite(1u, vec2(50.f), vec2(100.f)));
+		sprites.emplace_back(MakeSprite(0u, vec2(120.f), vec2(100.f)));
+
+		render::SpriteRenderer::SortSprites(sprites, scratch);
+		REQUIRE(GetTextureOrder(sprites) == std::vector<uint32>({ 0u, 1u, 0u }));
+		REQUIRE(sprites[2].TransformData.x == 120.f);
+	}
+
+	SECTION("depth doesn't reorder overlapping sprites")
+	{
+		sprites.emplace_back(MakeSprite(0u, vec2(0.f), vec2(100.f), 0.f));
+		sprites.emplace_back(MakeSprite(1u, vec2(50.f), vec2(100.f), 1.f));
+
+		render::SpriteRenderer::SortSprites(sprites, scratch);
+		REQUIRE(GetTextureOrder(sprites) == std::vector<uint32>({ 0u, 1u }));
+	}
+
+	SECTION("separate sprites are batched by texture")
+	{
+		sprites.emplace_back(MakeSprite(0u, vec2(0.f), vec2(100.f)));
+		sprites.emplace_back(MakeSprite(1u, vec2(200.f, 0.f), vec2(100.f)));
+		sprites.emplace_back(MakeSprite(0u, vec2(0.f, 200.f), vec2(100.f)));
+		sprites.emplace_back(MakeSprite(1u, vec2(200.f, 200.f), vec2(100.f)));
+
+		render::SpriteRenderer::SortSprites(sprites, scratch);
+		REQUIRE(GetTextureOrder(sprites) == std::vector<uint32>({ 0u, 0u, 1u, 1u }));
+
+		// submission order is kept within a batch
+		REQUIRE(sprites[0].TransformData.y == 0.f);
+		REQUIRE(sprites[1].TransformData.y == 200.f);
+		REQUIRE(sprites[2].TransformData.y == 0.f);
+		REQUIRE(sprites[3].TransformData.y == 200.f);
+	}
+
+	SECTION("rotated bounds")
+	{
+		sprites.emplace_back(MakeSprite(1u, vec2(60.f, 10.f), vec2(20.f)));
+
+		// rotated by 90 degrees around its position, this sprite covers the area left of it
+		render::SpriteRenderer::SpriteVertex rotated = MakeSprite(0u, vec2(100.f, 0.f), vec2(50.f));
+		rotated.TransformData.w = math::PI_DIV2;
+		sprites.emplace_back(rotated);
+
+		sprites.emplace_back(MakeSprite(1u, vec2(55.f, 30.f), vec2(10.f)));
+
+		render::SpriteRenderer::SortSprites(sprites, scratch);
+		REQUIRE(GetTextureOrder(sprites) == std::vector<uint32>({ 1u, 0u, 1u }));
+	}
+}
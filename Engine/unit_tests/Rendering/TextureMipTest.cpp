@@ -0,0 +1,280 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsTypes/TextureData.h>
+#include <EtRendering/GraphicsTypes/TextureCompression.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+TEST_CASE("texture mip resolution", "[graphics]")
+{
+	REQUIRE(render::TextureData::GetMipResolution(ivec2(256, 64), 0u) == ivec2(256, 64));
+	REQUIRE(render::TextureData::GetMipResolution(ivec2(256, 64), 1u) == ivec2(128, 32));
+	REQUIRE(render::TextureData::GetMipResolution(ivec2(256, 64), 7u) == ivec2(2, 1));
+	REQUIRE(render::TextureData::GetMipResolution(ivec2(256, 64), 8u) == ivec2(1, 1));
+	REQUIRE(render::TextureData::GetMipResolution(ivec2(5, 3), 1u) == ivec2(2, 1));
+}
+
+TEST_CASE("texture mip size", "[graphics]")
+{
+	// uncompressed levels are tightly packed
+	REQUIRE(render::TextureData::GetMipSize(render::E_ColorFormat::SRGB, render::E_ColorFormat::RGB, ivec2(5, 3)) == 45u);
+	REQUIRE(render::TextureData::GetMipSize(render::E_ColorFormat::RGBA8, render::E_ColorFormat::RGBA, ivec2(4, 4)) == 64u);
+
+	// partial blocks are padded
+	REQUIRE(render::TextureData::GetMipSize(render::E_ColorFormat::BC1_RGB, render::E_ColorFormat::RGB, ivec2(8, 8)) == 32u);
+	REQUIRE(render::TextureData::GetMipSize(render::E_ColorFormat::BC1_SRGB, render::E_ColorFormat::RGB, ivec2(5, 1)) == 16u);
+	REQUIRE(render::TextureData::GetMipSize(render::E_ColorFormat::BC7_RGBA, render::E_ColorFormat::RGBA, ivec2(1, 1)) == 16u);
+	REQUIRE(render::TextureData::GetMipSize(render::E_ColorFormat::BC5_RG, render::E_ColorFormat::RG, ivec2(12, 4)) == 48u);
+
+	REQUIRE(render::TextureData::IsCompressedFormat(render::E_ColorFormat::BC3_SRGBA));
+	REQUIRE(!render::TextureData::IsCompressedFormat(render::E_ColorFormat::SRGB));
+}
+
+
+namespace {
+
+	typedef float T_Block[16][4];
+
+	float const s_GradientRange = 160.f; // largest change of a channel across the gradient block
+
+	//---------------------------------
+	// GenGradientBlock
+	//
+	// 16 distinct colors on a line, which a single pair of endpoints can represent up to the palette spacing
+	//
+	void GenGradientBlock(T_Block& block)
+	{
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			float const t = static_cast<float>(texel) / 15.f;
+
+			block[texel][0] = 40.f + s_GradientRange * t;
+			block[texel][1] = 200.f - s_GradientRange * t;
+			block[texel][2] = 90.f + 60.f * t;
+			block[texel][3] = 255.f - 120.f * t;
+		}
+	}
+
+	//---------------------------------
+	// GenNoiseBlock
+	//
+	// Uncorrelated texels, the worst case for interpolated values
+	//
+	void GenNoiseBlock(T_Block& block)
+	{
+		uint32 state = 2463534242u;
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			for (uint32 channel = 0u; channel < 4u; ++channel)
+			{
+				state ^= state << 13u;
+				state ^= state >> 17u;
+				state ^= state << 5u;
+				block[texel][channel] = static_cast<float>(state % 256u);
+			}
+		}
+	}
+
+	//---------------------------------
+	// DecodeBC1Block
+	//
+	void DecodeBC1Block(uint8 const* const input, T_Block& decoded)
+	{
+		uint16 color0;
+		uint16 color1;
+		uint32 indices;
+		memcpy(&color0, input, sizeof(uint16));
+		memcpy(&color1, input + 2u, sizeof(uint16));
+		memcpy(&indices, input + 4u, sizeof(uint32));
+
+		float palette[4][3];
+		uint16 const colors[2] = { color0, color1 };
+		for (uint32 endpoint = 0u; endpoint < 2u; ++endpoint)
+		{
+			palette[endpoint][0] = static_cast<float>(((colors[endpoint] >> 11u) & 31u) * 255u / 31u);
+			palette[endpoint][1] = static_cast<float>(((colors[endpoint] >> 5u) & 63u) * 255u / 63u);
+			palette[endpoint][2] = static_cast<float>((colors[endpoint] & 31u) * 255u / 31u);
+		}
+
+		REQUIRE(color0 >= color1); // opaque blocks never use the 3 color mode
+		for (uint32 channel = 0u; channel < 3u; ++channel)
+		{
+			palette[2][channel] = (2.f * palette[0][channel] + palette[1][channel]) / 3.f;
+			palette[3][channel] = (palette[0][channel] + 2.f * palette[1][channel]) / 3.f;
+		}
+
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			uint32 const index = (indices >> (texel * 2u)) & 3u;
+			for (uint32 channel = 0u; channel < 3u; ++channel)
+			{
+				decoded[texel][channel] = palette[index][channel];
+			}
+		}
+	}
+
+	//---------------------------------
+	// DecodeBC4Block
+	//
+	void DecodeBC4Block(uint8 const* const input, uint32 const channel, T_Block& decoded)
+	{
+		float palette[8];
+		palette[0] = static_cast<float>(input[0]);
+		palette[1] = static_cast<float>(input[1]);
+
+		REQUIRE(input[0] >= input[1]); // the encoder only uses the 8 value mode
+		for (uint32 entry = 1u; entry < 7u; ++entry)
+		{
+			palette[entry + 1u] = (static_cast<float>(7u - entry) * palette[0] + static_cast<float>(entry) * palette[1]) / 7.f;
+		}
+
+		uint64 indices = 0u;
+		for (uint32 byteIdx = 0u; byteIdx < 6u; ++byteIdx)
+		{
+			indices |= static_cast<uint64>(input[2u + byteIdx]) << (byteIdx * 8u);
+		}
+
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			decoded[texel][channel] = palette[(indices >> (texel * 3u)) & 7u];
+		}
+	}
+
+	//---------------------------------
+	// DecodeBC7Block
+	//
+	// Only handles mode 6, which is all the encoder writes
+	//
+	void DecodeBC7Block(uint8 const* const input, T_Block& decoded)
+	{
+		static uint32 const s_Weights[16] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+		uint32 position = 0u;
+		auto read = [input, &position](uint32 const count) -> uint32
+			{
+				uint32 value = 0u;
+				for (uint32 bit = 0u; bit < count; ++bit, ++position)
+				{
+					value |= static_cast<uint32>((input[position / 8u] >> (position % 8u)) & 1u) << bit;
+				}
+
+				return value;
+			};
+
+		REQUIRE(read(7u) == (1u << 6u));
+
+		uint32 e0[4];
+		uint32 e1[4];
+		for (uint32 channel = 0u; channel < 4u; ++channel)
+		{
+			e0[channel] = read(7u) << 1u;
+			e1[channel] = read(7u) << 1u;
+		}
+
+		uint32 const p0 = read(1u);
+		uint32 const p1 = read(1u);
+		for (uint32 channel = 0u; channel < 4u; ++channel)
+		{
+			e0[channel] |= p0;
+			e1[channel] |= p1;
+		}
+
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			uint32 const weight = s_Weights[read((texel == 0u) ? 3u : 4u)];
+			for (uint32 channel = 0u; channel < 4u; ++channel)
+			{
+				decoded[texel][channel] = static_cast<float>(((64u - weight) * e0[channel] + weight * e1[channel] + 32u) >> 6u);
+			}
+		}
+
+		REQUIRE(position == 128u);
+	}
+
+	//---------------------------------
+	// GetMaxError
+	//
+	float GetMaxError(T_Block const& source, T_Block const& decoded, uint32 const firstChannel, uint32 const channelCount)
+	{
+		float maxError = 0.f;
+		for (uint32 texel = 0u; texel < 16u; ++texel)
+		{
+			for (uint32 channel = firstChannel; channel < firstChannel + channelCount; ++channel)
+			{
+				maxError = std::max(maxError, std::abs(source[texel][channel] - decoded[texel][channel]));
+			}
+		}
+
+		return maxError;
+	}
+
+} // namespace
+
+
+TEST_CASE("texture block compression", "[graphics]")
+{
+	T_Block gradient;
+	GenGradientBlock(gradient);
+
+	T_Block noise;
+	GenNoiseBlock(noise);
+
+	T_Block uniform;
+	for (uint32 texel = 0u; texel < 16u; ++texel)
+	{
+		uniform[texel][0] = 100.f;
+		uniform[texel][1] = 150.f;
+		uniform[texel][2] = 200.f;
+		uniform[texel][3] = 50.f;
+	}
+
+	T_Block decoded;
+	uint8 output[16];
+
+	SECTION("BC1")
+	{
+		render::texture_compression::CompressBC1Block(uniform, output);
+		DecodeBC1Block(output, decoded);
+		REQUIRE(GetMaxError(uniform, decoded, 0u, 3u) <= 4.f); // 565 quantization
+
+		// half the spacing of 4 palette entries, plus quantization
+		render::texture_compression::CompressBC1Block(gradient, output);
+		DecodeBC1Block(output, decoded);
+		REQUIRE(GetMaxError(gradient, decoded, 0u, 3u) <= s_GradientRange / 6.f + 4.f);
+	}
+
+	SECTION("BC4")
+	{
+		render::texture_compression::CompressBC4Block(uniform, 3u, output);
+		DecodeBC4Block(output, 3u, decoded);
+		REQUIRE(GetMaxError(uniform, decoded, 3u, 1u) == 0.f);
+
+		// any single channel block is within half a palette step
+		for (uint32 channel = 0u; channel < 4u; ++channel)
+		{
+			render::texture_compression::CompressBC4Block(noise, channel, output);
+			DecodeBC4Block(output, channel, decoded);
+
+			float const step = (static_cast<float>(output[0]) - static_cast<float>(output[1])) / 7.f;
+			REQUIRE(GetMaxError(noise, decoded, channel, 1u) <= step * 0.5f + 0.5f);
+		}
+	}
+
+	SECTION("BC7")
+	{
+		render::texture_compression::CompressBC7Block(uniform, output);
+		DecodeBC7Block(output, decoded);
+		REQUIRE(GetMaxError(uniform, decoded, 0u, 4u) <= 1.f); // 7 bit endpoints with a shared bit
+
+		// half the spacing of 16 palette entries, plus quantization
+		render::texture_compression::CompressBC7Block(gradient, output);
+		DecodeBC7Block(output, decoded);
+		REQUIRE(GetMaxError(gradient, decoded, 0u, 4u) <= s_GradientRange / 30.f + 2.f);
+	}
+}
@@ -0,0 +1,216 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsTypes/Camera.h>
+#include <EtRendering/PlanetTech/Triangulator.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	float const s_PlanetRadius = 1737.f;
+	float const s_PlanetMaxHeight = 10.7f;
+	ivec2 const s_ViewDimensions(1920, 1080);
+
+	//---------------------------------
+	// GetSortedPositions
+	//
+	// Patches in a fixed order, as the order within a subtree depends on how it was split into tasks
+	//
+	std::vector<render::PatchInstance> GetSortedPositions(render::Triangulator const& triangulator)
+	{
+		std::vector<render::PatchInstance> positions = triangulator.GetPositions();
+		std::sort(positions.begin(), positions.end(), [](render::PatchInstance const& lhs, render::PatchInstance const& rhs)
+			{
+				if (lhs.level != rhs.level)
+				{
+					return lhs.level < rhs.level;
+				}
+
+				// neighbouring patches can share a corner, so their edges are compared as well
+				vec3 const lhsVectors[] = { lhs.a, lhs.r, lhs.s };
+				vec3 const rhsVectors[] = { rhs.a, rhs.r, rhs.s };
+				for (uint8 vecIdx = 0u; vecIdx < 3u; ++vecIdx)
+				{
+					for (uint8 axis = 0u; axis < 3u; ++axis)
+					{
+						if (lhsVectors[vecIdx][axis] != rhsVectors[vecIdx][axis])
+						{
+							return lhsVectors[vecIdx][axis] < rhsVectors[vecIdx][axis];
+						}
+					}
+				}
+
+				return false;
+			});
+
+		return positions;
+	}
+
+	//---------------------------------
+	// IsSamePositions
+	//
+	bool IsSamePositions(render::Triangulator const& expectedTriangulator, render::Triangulator const& actualTriangulator)
+	{
+		std::vector<render::PatchInstance> const expected = GetSortedPositions(expectedTriangulator);
+		std::vector<render::PatchInstance> const actual = GetSortedPositions(actualTriangulator);
+
+		if (expected.size() != actual.size())
+		{
+			return false;
+		}
+
+		for (size_t idx = 0u; idx < expected.size(); ++idx)
+		{
+			if (!((expected[idx].level == actual[idx].level) && (expected[idx].a == actual[idx].a)
+				&& (expected[idx].r == actual[idx].r) && (expected[idx].s == actual[idx].s)))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//---------------------------------
+	// SetupCamera
+	//
+	void SetupCamera(render::Camera& camera, vec3 const& pos, vec3 const& forward)
+	{
+		camera.SetTransformation(pos, forward, vec3::UP, true);
+		camera.SetFieldOfView(45.f, true);
+		camera.SetClippingPlanes(0.1f, 10000.f, true);
+	}
+
+} // namespace
+
+
+TEST_CASE("planet triangulator coherent", "[graphics]")
+{
+	render::Triangulator full;
+	full.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+	full.SetCoherent(false);
+
+	render::Triangulator coherent;
+	coherent.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+	REQUIRE(coherent.IsCoherent());
+
+	mat4 const planetTransform;
+
+	size_t fullSubtrees = 0u;
+	size_t coherentSubtrees = 0u;
+
+	// fly low over the surface while slowly turning
+	for (uint32 frame = 0u; frame < 30u; ++frame)
+	{
+		float const angle = static_cast<float>(frame) * 0.0005f;
+		vec3 const up(std::sin(angle), std::cos(angle), 0.f);
+		vec3 const forward(std::cos(angle), -std::sin(angle), static_cast<float>(frame) * 0.002f);
+
+		render::Camera camera;
+		SetupCamera(camera, up * (s_PlanetRadius + 2.f), math::normalize(forward));
+
+		full.Update(planetTransform, camera, s_ViewDimensions);
+		full.GenerateGeometry();
+
+		coherent.Update(planetTransform, camera, s_ViewDimensions);
+		coherent.GenerateGeometry();
+
+		fullSubtrees += full.GetTriangulatedSubtreeCount();
+		coherentSubtrees += coherent.GetTriangulatedSubtreeCount();
+
+		REQUIRE(!full.GetPositions().empty());
+		REQUIRE(IsSamePositions(full, coherent));
+	}
+
+	// most subtrees should have been reused
+	REQUIRE(coherentSubtrees * 2u < fullSubtrees);
+}
+
+TEST_CASE("planet triangulator batched", "[graphics]")
+{
+	render::Triangulator recursive;
+	recursive.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+	recursive.SetCoherent(false);
+	recursive.SetBatched(false);
+
+	render::Triangulator batched;
+	batched.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+	batched.SetCoherent(false);
+	REQUIRE(batched.IsBatched());
+
+	mat4 const planetTransform;
+
+	// from orbit, towards the horizon close to the surface, and straight down
+	std::vector<std::pair<vec3, vec3>> const views = {
+		std::make_pair(vec3(0.f, 0.f, -3.f * s_PlanetRadius), vec3::FORWARD),
+		std::make_pair(vec3(0.f, s_PlanetRadius + 2.f, 0.f), vec3(1.f, 0.f, 0.f)),
+		std::make_pair(math::normalize(vec3(1.f, 2.f, 3.f)) * (s_PlanetRadius + 50.f), -math::normalize(vec3(1.f, 2.f, 3.f)))
+	};
+
+	for (std::pair<vec3, vec3> const& view : views)
+	{
+		render::Camera camera;
+		SetupCamera(camera, view.first, view.second);
+
+		recursive.Update(planetTransform, camera, s_ViewDimensions);
+		recursive.GenerateGeometry();
+
+		batched.Update(planetTransform, camera, s_ViewDimensions);
+		batched.GenerateGeometry();
+
+		REQUIRE(!recursive.GetPositions().empty());
+		REQUIRE(IsSamePositions(recursive, batched));
+		REQUIRE(recursive.GetEvaluatedTriangleCount() == batched.GetEvaluatedTriangleCount());
+	}
+}
+
+TEST_CASE("planet triangulator coherence toggle", "[graphics]")
+{
+	mat4 const planetTransform;
+	vec3 const direction = math::normalize(vec3(1.f, 2.f, 3.f));
+
+	// subtrees triangulated while coherence is off have no margins, they must not be reused once it is switched back on
+	for (bool const isBatched : { false, true })
+	{
+		render::Triangulator full;
+		full.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+		full.SetCoherent(false);
+		full.SetBatched(isBatched);
+
+		render::Triangulator toggled;
+		toggled.Init(s_PlanetRadius, s_PlanetMaxHeight, s_ViewDimensions);
+		toggled.SetBatched(isBatched);
+
+		for (uint32 frame = 0u; frame < 12u; ++frame)
+		{
+			// off for the first frame, on for a few, off again for a single frame and then back on
+			bool const isCoherent = (frame != 0u) && (frame != 5u);
+			bool const isSwitchedOn = isCoherent && !toggled.IsCoherent();
+			toggled.SetCoherent(isCoherent);
+
+			// approach the planet from orbit, so that split decisions change between frames
+			render::Camera camera;
+			SetupCamera(camera, direction * (s_PlanetRadius * (3.f - static_cast<float>(frame) * 0.15f)), -direction);
+
+			full.Update(planetTransform, camera, s_ViewDimensions);
+			full.GenerateGeometry();
+
+			toggled.Update(planetTransform, camera, s_ViewDimensions);
+			toggled.GenerateGeometry();
+
+			REQUIRE(!full.GetPositions().empty());
+			REQUIRE(IsSamePositions(full, toggled));
+
+			if (isSwitchedOn)
+			{
+				REQUIRE(toggled.GetTriangulatedSubtreeCount() == full.GetTriangulatedSubtreeCount());
+			}
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/GraphicsTypes/VertexInfo.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+TEST_CASE("vertex packing octahedral", "[graphics]")
+{
+	std::vector<vec3> const directions = {
+		vec3(1.f, 0.f, 0.f),
+		vec3(-1.f, 0.f, 0.f),
+		vec3(0.f, 1.f, 0.f),
+		vec3(0.f, -1.f, 0.f),
+		vec3(0.f, 0.f, 1.f),
+		vec3(0.f, 0.f, -1.f),
+		math::normalize(vec3(1.f, 2.f, 3.f)),
+		math::normalize(vec3(-3.f, 0.5f, -2.f)),
+		math::normalize(vec3(0.2f, -0.7f, -0.1f))
+	};
+
+	for (vec3 const& direction : directions)
+	{
+		vec2 const encoded = render::vertex_packing::EncodeOctahedral(direction);
+		vec2 const quantized(render::vertex_packing::UnpackSnorm16(render::vertex_packing::PackSnorm16(encoded.x)),
+			render::vertex_packing::UnpackSnorm16(render::vertex_packing::PackSnorm16(encoded.y)));
+
+		vec3 const decoded = render::vertex_packing::DecodeOctahedral(quantized);
+		REQUIRE(math::dot(direction, decoded) > 0.9999f);
+
+		vec4 const positive = render::vertex_packing::DecodeTangent(render::vertex_packing::EncodeTangent(direction, 1.f));
+		REQUIRE(positive.w == 1.f);
+		REQUIRE(math::dot(direction, positive.xyz) > 0.9999f);
+
+		vec4 const negative = render::vertex_packing::DecodeTangent(render::vertex_packing::EncodeTangent(direction, -1.f));
+		REQUIRE(negative.w == -1.f);
+		REQUIRE(math::dot(direction, negative.xyz) > 0.9999f);
+	}
+}
+
+TEST_CASE("vertex packing half", "[graphics]")
+{
+	REQUIRE(render::vertex_packing::PackHalf(0.f) == 0x0000u);
+	REQUIRE(render::vertex_packing::PackHalf(1.f) == 0x3C00u);
+	REQUIRE(render::vertex_packing::PackHalf(-2.5f) == 0xC100u);
+	REQUIRE(render::vertex_packing::PackHalf(65504.f) == 0x7BFFu);
+	REQUIRE(render::vertex_packing::PackHalf(1e6f) == 0x7C00u);
+
+	// every finite half survives a round trip through float
+	uint32 mismatches = 0u;
+	for (uint32 half = 0u; half < 0x7C00u; ++half)
+	{
+		uint16 const value = static_cast<uint16>(half);
+		if (render::vertex_packing::PackHalf(render::vertex_packing::UnpackHalf(value)) != value)
+		{
+			++mismatches;
+		}
+	}
+
+	REQUIRE(mismatches == 0u);
+}
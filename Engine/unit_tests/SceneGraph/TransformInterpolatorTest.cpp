@@ -0,0 +1,158 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtRendering/SceneStructure/RenderScene.h>
+
+#include <EtFramework/SceneGraph/TransformInterpolator.h>
+#include <EtFramework/SceneGraph/UnifiedScene.h>
+#include <EtFramework/Systems/TransformSystem.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// GetNodePosition
+	//
+	vec3 GetNodePosition(render::Scene const& renderScene, core::T_SlotId const node)
+	{
+		vec3 position;
+		quat rotation;
+		vec3 scale;
+		math::decomposeTRS(renderScene.GetNodes()[node], position, rotation, scale);
+
+		return position;
+	}
+
+} // namespace
+
+
+TEST_CASE("transform interpolator", "[scenegraph]")
+{
+	render::Scene renderScene;
+	core::T_SlotId const node = renderScene.AddNode(mat4());
+
+	fw::TransformInterpolator interpolator;
+
+	interpolator.BeginStep(renderScene);
+	interpolator.Record(node, mat4(), math::translate(vec3(4.f, 0.f, 0.f)));
+	REQUIRE(interpolator.GetActiveCount() == 1u);
+
+	interpolator.Apply(renderScene, 0.5f);
+	REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(2.f, 0.f, 0.f)));
+
+	// the next step blends from where the previous step ended
+	interpolator.BeginStep(renderScene);
+	interpolator.Record(node, math::translate(vec3(4.f, 0.f, 0.f)), math::translate(vec3(8.f, 0.f, 0.f)));
+
+	interpolator.Apply(renderScene, 0.25f);
+	REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(5.f, 0.f, 0.f)));
+
+	SECTION("come to rest")
+	{
+		// a step without movement holds the final transform
+		interpolator.BeginStep(renderScene);
+		REQUIRE(interpolator.GetActiveCount() == 1u);
+
+		interpolator.Apply(renderScene, 0.5f);
+		REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(8.f, 0.f, 0.f)));
+
+		// after which the node is released
+		interpolator.BeginStep(renderScene);
+		REQUIRE(interpolator.GetActiveCount() == 0u);
+		REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(8.f, 0.f, 0.f)));
+	}
+
+	SECTION("snap")
+	{
+		interpolator.Snap(renderScene, node, math::translate(vec3(20.f, 0.f, 0.f)));
+		REQUIRE(interpolator.GetActiveCount() == 0u);
+		REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(20.f, 0.f, 0.f)));
+
+		interpolator.Apply(renderScene, 0.5f);
+		REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(20.f, 0.f, 0.f)));
+	}
+
+	SECTION("remove")
+	{
+		interpolator.Remove(node);
+		REQUIRE(interpolator.GetActiveCount() == 0u);
+
+		interpolator.BeginStep(renderScene);
+		REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, node), vec3(5.f, 0.f, 0.f)));
+	}
+}
+
+TEST_CASE("skip interpolation", "[scenegraph]")
+{
+	// the transform system writes to the unified scene's render scene and interpolator
+	render::Scene& renderScene = fw::UnifiedScene::Instance().GetRenderScene();
+	fw::TransformInterpolator& interpolator = fw::UnifiedScene::Instance().GetTransformInterpolator();
+	interpolator.Clear();
+
+	fw::EcsController ecs;
+
+	fw::T_CompEventFn<fw::TransformComponent> onAdded(fw::TransformSystem::OnComponentAdded);
+	fw::T_CompEventFn<fw::TransformComponent> onRemoved(fw::TransformSystem::OnComponentRemoved);
+	ecs.RegisterOnComponentAdded(onAdded);
+	ecs.RegisterOnComponentRemoved(onRemoved);
+
+	ecs.RegisterSystem<fw::TransformSystem::Compute>();
+	ecs.RegisterSystem<fw::TransformSystem::Reset>();
+
+	fw::TransformComponent transform;
+	fw::T_EntityId const entity = ecs.AddEntity(transform);
+	fw::TransformComponent& transf = ecs.GetComponent<fw::TransformComponent>(entity);
+
+	auto runStep = [&interpolator, &renderScene, &ecs]()
+		{
+			interpolator.BeginStep(renderScene);
+			ecs.Process();
+		};
+
+	vec3 position;
+	quat rotation;
+
+	// new components appear where they are placed
+	transf.SetPosition(vec3(1.f, 0.f, 0.f));
+	runStep();
+	REQUIRE(interpolator.GetActiveCount() == 0u);
+	REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, transf.GetNodeId()), vec3(1.f, 0.f, 0.f)));
+
+	// after that movement is blended
+	transf.SetPosition(vec3(3.f, 0.f, 0.f));
+	runStep();
+	REQUIRE(interpolator.GetActiveCount() == 1u);
+
+	interpolator.Sample(transf, 0.5f, position, rotation);
+	REQUIRE(math::nearEqualsV(position, vec3(2.f, 0.f, 0.f)));
+
+	interpolator.Apply(renderScene, 0.5f);
+	REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, transf.GetNodeId()), vec3(2.f, 0.f, 0.f)));
+
+	// teleports are shown immediately
+	transf.SkipInterpolation();
+	transf.SetPosition(vec3(10.f, 0.f, 0.f));
+	runStep();
+	REQUIRE(interpolator.GetActiveCount() == 0u);
+	REQUIRE(math::nearEqualsV(GetNodePosition(renderScene, transf.GetNodeId()), vec3(10.f, 0.f, 0.f)));
+
+	interpolator.Sample(transf, 0.5f, position, rotation);
+	REQUIRE(math::nearEqualsV(position, vec3(10.f, 0.f, 0.f)));
+
+	// and only the next change is affected
+	transf.SetPosition(vec3(12.f, 0.f, 0.f));
+	runStep();
+	REQUIRE(interpolator.GetActiveCount() == 1u);
+
+	interpolator.Sample(transf, 0.5f, position, rotation);
+	REQUIRE(math::nearEqualsV(position, vec3(11.f, 0.f, 0.f)));
+
+	ecs.RemoveEntity(entity);
+	REQUIRE(interpolator.GetActiveCount() == 0u);
+}
@@ -0,0 +1,139 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtCore/UpdateCycle/TickManager.h>
+#include <EtCore/UpdateCycle/Tickable.h>
+
+#include <catch2/catch.hpp>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	float const s_Timestep = 0.25f; // exactly representable, so that step counts and alphas don't depend on rounding
+
+	//---------------------------------
+	// StepCounter
+	//
+	// Counts the fixed steps it receives
+	//
+	class StepCounter final : public core::I_Tickable
+	{
+	public:
+		StepCounter() : core::I_Tickable(0u) {}
+
+		void OnFixedTick() override { ++m_Steps; }
+
+		uint32 m_Steps = 0u;
+	};
+
+	//---------------------------------
+	// ResetFixedSteps
+	//
+	// Leave the tick manager with an empty accumulator and the test timestep
+	//  - a huge frame time absorbs whatever earlier tests left over, and dropping all but one step leaves no remainder
+	//
+	void ResetFixedSteps(core::TickManager* const tickMan)
+	{
+		tickMan->SetFixedTimestep(s_Timestep);
+		tickMan->SetMaxFixedSteps(1u);
+		tickMan->RunFixedSteps(1073741824.f);
+
+		tickMan->SetMaxFixedSteps(core::TickManager::s_DefaultMaxFixedSteps);
+	}
+
+} // namespace
+
+
+TEST_CASE("fixed steps", "[tick]")
+{
+	core::TickManager* const tickMan = core::TickManager::GetInstance();
+	ResetFixedSteps(tickMan);
+	REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+
+	StepCounter counter;
+	uint64 const totalSteps = tickMan->GetFixedStepCount();
+
+	SECTION("step count")
+	{
+		tickMan->RunFixedSteps(0.625f);
+		REQUIRE(counter.m_Steps == 2u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.5f);
+
+		// the remainder carries over into the next frame
+		tickMan->RunFixedSteps(0.125f);
+		REQUIRE(counter.m_Steps == 3u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+
+		tickMan->RunFixedSteps(0.125f);
+		REQUIRE(counter.m_Steps == 3u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.5f);
+
+		REQUIRE(tickMan->GetFixedStepCount() == totalSteps + 3u);
+	}
+
+	SECTION("frames shorter than a step")
+	{
+		tickMan->RunFixedSteps(0.f);
+		REQUIRE(counter.m_Steps == 0u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+
+		tickMan->RunFixedSteps(-1.f); // time doesn't run backwards
+		REQUIRE(counter.m_Steps == 0u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+
+		tickMan->RunFixedSteps(0.1875f);
+		REQUIRE(counter.m_Steps == 0u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.75f);
+	}
+
+	SECTION("step cap")
+	{
+		// 6.5 steps are due, only 4 run
+		tickMan->RunFixedSteps(1.625f);
+		REQUIRE(counter.m_Steps == core::TickManager::s_DefaultMaxFixedSteps);
+
+		// the whole steps that didn't run are dropped, only the partial step remains
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.5f);
+
+		tickMan->RunFixedSteps(0.f);
+		REQUIRE(counter.m_Steps == core::TickManager::s_DefaultMaxFixedSteps);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.5f);
+
+		tickMan->RunFixedSteps(0.125f);
+		REQUIRE(counter.m_Steps == core::TickManager::s_DefaultMaxFixedSteps + 1u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+	}
+
+	SECTION("lower cap")
+	{
+		tickMan->SetMaxFixedSteps(2u);
+
+		tickMan->RunFixedSteps(1.f);
+		REQUIRE(counter.m_Steps == 2u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+
+		tickMan->SetMaxFixedSteps(core::TickManager::s_DefaultMaxFixedSteps);
+	}
+
+	SECTION("change timestep")
+	{
+		tickMan->RunFixedSteps(0.125f);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.5f);
+
+		// the progress into the current step is kept
+		tickMan->SetFixedTimestep(0.5f);
+		tickMan->RunFixedSteps(0.f);
+		REQUIRE(counter.m_Steps == 0u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.5f);
+
+		tickMan->RunFixedSteps(0.25f);
+		REQUIRE(counter.m_Steps == 1u);
+		REQUIRE(tickMan->GetInterpolationAlpha() == 0.f);
+	}
+
+	tickMan->SetFixedTimestep(core::TickManager::s_DefaultFixedTimestep);
+}
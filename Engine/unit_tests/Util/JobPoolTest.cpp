@@ -0,0 +1,141 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtCore/Util/JobPool.h>
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	//---------------------------------
+	// VisitAll
+	//
+	// Run a loop over count indices and verify each one was visited exactly once
+	//
+	bool VisitAll(size_t const count, size_t const grainSize, size_t const maxThreads = 0u)
+	{
+		std::vector<std::atomic<uint32>> visits(count);
+		for (std::atomic<uint32>& visit : visits)
+		{
+			visit = 0u;
+		}
+
+		core::JobPool::GetInstance()->Run(0u, count, grainSize, [&visits](size_t const grainIdx, size_t const begin, size_t const end)
+			{
+				UNUSED(grainIdx);
+				for (size_t idx = begin; idx < end; ++idx)
+				{
+					++visits[idx];
+				}
+			}, maxThreads);
+
+		for (std::atomic<uint32> const& visit : visits)
+		{
+			if (visit.load() != 1u)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+} // namespace
+
+
+TEST_CASE("job pool", "[jobs]")
+{
+	core::JobPool* const pool = core::JobPool::GetInstance();
+	REQUIRE(pool->GetThreadCount() >= 1u);
+
+	SECTION("grains")
+	{
+		for (size_t const grainSize : { 1u, 7u, 64u, 10000u })
+		{
+			REQUIRE(VisitAll(1000u, grainSize));
+		}
+
+		REQUIRE(VisitAll(0u, 1u));
+	}
+
+	SECTION("grain ranges")
+	{
+		std::vector<std::pair<size_t, size_t>> ranges(4u);
+		pool->Run(10u, 40u, 8u, [&ranges](size_t const grainIdx, size_t const begin, size_t const end)
+			{
+				ranges[grainIdx] = std::make_pair(begin, end);
+			});
+
+		REQUIRE(ranges[0] == std::make_pair(static_cast<size_t>(10u), static_cast<size_t>(18u)));
+		REQUIRE(ranges[3] == std::make_pair(static_cast<size_t>(34u), static_cast<size_t>(40u)));
+	}
+
+	SECTION("single thread")
+	{
+		std::thread::id const callingThread = std::this_thread::get_id();
+
+		std::atomic<uint32> otherThreadGrains(0u);
+		pool->Run(0u, 64u, 1u, [callingThread, &otherThreadGrains](size_t const grainIdx, size_t const begin, size_t const end)
+			{
+				UNUSED(grainIdx);
+				UNUSED(begin);
+				UNUSED(end);
+				if (std::this_thread::get_id() != callingThread)
+				{
+					++otherThreadGrains;
+				}
+			}, 1u);
+
+		REQUIRE(otherThreadGrains.load() == 0u);
+	}
+
+	SECTION("nested")
+	{
+		// loops started from a grain run on the thread of that grain instead of waiting for the pool
+		std::atomic<uint32> innerVisits(0u);
+		pool->Run(0u, 8u, 1u, [pool, &innerVisits](size_t const grainIdx, size_t const begin, size_t const end)
+			{
+				UNUSED(grainIdx);
+				UNUSED(begin);
+				UNUSED(end);
+				pool->Run(0u, 16u, 2u, [&innerVisits](size_t const innerGrainIdx, size_t const innerBegin, size_t const innerEnd)
+					{
+						UNUSED(innerGrainIdx);
+						innerVisits += static_cast<uint32>(innerEnd - innerBegin);
+					});
+			});
+
+		REQUIRE(innerVisits.load() == 8u * 16u);
+	}
+
+	SECTION("concurrent callers")
+	{
+		bool otherResult = false;
+		std::thread other([&otherResult]()
+			{
+				otherResult = true;
+				for (uint32 run = 0u; run < 50u; ++run)
+				{
+					otherResult = VisitAll(500u, 3u) && otherResult;
+				}
+			});
+
+		bool result = true;
+		for (uint32 run = 0u; run < 50u; ++run)
+		{
+			result = VisitAll(700u, 5u) && result;
+		}
+
+		other.join();
+
+		REQUIRE(result);
+		REQUIRE(otherResult);
+	}
+}
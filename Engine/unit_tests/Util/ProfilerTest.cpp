@@ -0,0 +1,176 @@
+#include <EtFramework/stdafx.h>
+
+#include <EtCore/Util/Profiler.h>
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include <mainTesting.h>
+
+
+using namespace et;
+
+
+namespace {
+
+	char const* const s_OuterZone = "outer";
+	char const* const s_InnerZone = "inner";
+	char const* const s_WorkerZone = "worker";
+
+	core::ProfileZoneStats const* FindStats(core::Profiler const& profiler, char const* const name)
+	{
+		for (core::ProfileZoneStats const& stats : profiler.GetFrameStats())
+		{
+			if (stats.name == name)
+			{
+				return &stats;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void SpinFor(uint64 const ns)
+	{
+		uint64 const start = core::Profiler::Now();
+		while (core::Profiler::Now() - start < ns) {}
+	}
+
+}
+
+
+TEST_CASE("profiler zones", "[profiler]")
+{
+	core::Profiler* const profiler = core::Profiler::GetInstance();
+	REQUIRE_FALSE(core::Profiler::IsActive()); // nothing is recorded unless requested
+
+	profiler->SetEnabled(true);
+	REQUIRE(core::Profiler::IsActive());
+
+	profiler->EndFrame(); // discard zones recorded by other tests
+
+	{
+		core::ProfileZone const outer(s_OuterZone);
+		SpinFor(10000u);
+
+		for (uint32 idx = 0u; idx < 3u; ++idx)
+		{
+			core::ProfileZone const inner(s_InnerZone);
+			SpinFor(10000u);
+		}
+	}
+
+	std::thread worker([]()
+		{
+			core::Profiler::GetInstance()->SetThreadName("test worker");
+			core::ProfileZone const zone(s_WorkerZone);
+			SpinFor(10000u);
+		});
+	worker.join();
+
+	profiler->EndFrame();
+
+	core::ProfileZoneStats const* const outerStats = FindStats(*profiler, s_OuterZone);
+	core::ProfileZoneStats const* const innerStats = FindStats(*profiler, s_InnerZone);
+	core::ProfileZoneStats const* const workerStats = FindStats(*profiler, s_WorkerZone);
+
+	REQUIRE(outerStats != nullptr);
+	REQUIRE(innerStats != nullptr);
+	REQUIRE(workerStats != nullptr);
+
+	REQUIRE(outerStats->callCount == 1u);
+	REQUIRE(innerStats->callCount == 3u);
+	REQUIRE(workerStats->callCount == 1u);
+
+	// nested zones are excluded from the exclusive time of their parent
+	REQUIRE(outerStats->inclusiveNs >= innerStats->inclusiveNs + 10000u);
+	REQUIRE(outerStats->exclusiveNs == outerStats->inclusiveNs - innerStats->inclusiveNs);
+	REQUIRE(innerStats->exclusiveNs == innerStats->inclusiveNs);
+
+	// stats are sorted by inclusive time
+	REQUIRE(profiler->GetFrameStats().front().inclusiveNs >= profiler->GetFrameStats().back().inclusiveNs);
+
+	// the next frame starts empty
+	profiler->EndFrame();
+	REQUIRE(FindStats(*profiler, s_OuterZone) == nullptr);
+
+	core::Profiler::DestroyInstance();
+	REQUIRE(!core::Profiler::IsActive());
+}
+
+TEST_CASE("profiler disabled", "[profiler]")
+{
+	core::Profiler* const profiler = core::Profiler::GetInstance();
+	profiler->SetEnabled(false);
+
+	{
+		core::ProfileZone const zone(s_OuterZone);
+	}
+
+	profiler->SetEnabled(true);
+	profiler->EndFrame();
+
+	REQUIRE(FindStats(*profiler, s_OuterZone) == nullptr);
+
+	core::Profiler::DestroyInstance();
+}
+
+TEST_CASE("profiler full buffer", "[profiler]")
+{
+	core::Profiler* const profiler = core::Profiler::GetInstance();
+	profiler->SetEnabled(true);
+	profiler->EndFrame();
+
+	// events that don't fit are dropped instead of overwriting events that weren't collected yet
+	size_t const extraCount = 10u;
+	for (size_t idx = 0u; idx < core::Profiler::s_ThreadBufferCapacity + extraCount; ++idx)
+	{
+		core::ProfileZone const zone(s_InnerZone);
+	}
+
+	profiler->EndFrame();
+
+	core::ProfileZoneStats const* const stats = FindStats(*profiler, s_InnerZone);
+	REQUIRE(stats != nullptr);
+	REQUIRE(stats->callCount == static_cast<uint32>(core::Profiler::s_ThreadBufferCapacity));
+	REQUIRE(profiler->GetDroppedEventCount() == static_cast<uint64>(extraCount));
+
+	// collecting frees the buffer again
+	{
+		core::ProfileZone const zone(s_OuterZone);
+	}
+
+	profiler->EndFrame();
+	REQUIRE(FindStats(*profiler, s_OuterZone) != nullptr);
+	REQUIRE(profiler->GetDroppedEventCount() == static_cast<uint64>(extraCount));
+
+	core::Profiler::DestroyInstance();
+}
+
+TEST_CASE("profiler created from workers", "[profiler]")
+{
+	std::vector<core::Profiler*> instances(4u, nullptr);
+
+	std::vector<std::thread> workers;
+	for (size_t idx = 0u; idx < instances.size(); ++idx)
+	{
+		workers.emplace_back([&instances, idx]()
+			{
+				instances[idx] = core::Profiler::GetInstance();
+			});
+	}
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	for (core::Profiler* const instance : instances)
+	{
+		REQUIRE(instance != nullptr);
+		REQUIRE(instance == instances.front());
+	}
+
+	core::Profiler::DestroyInstance();
+}
@@ -1,10 +1,11 @@
 <VERTEX>
 	#version 330 core
 	#include "CommonSharedVars.glsl"
+	#include "CommonVertex.glsl"
 	
 	in vec3 position;
-	in vec3 normal;
-	in vec3 tangent;
+	in vec2 normal;
+	in vec2 tangent;
 	in vec2 texcoord;
 	
 	out vec3 Position;
@@ -20,8 +21,8 @@
 		
 		mat3 normMat = inverse(mat3(model));
 		normMat = transpose(normMat);
-		Normal = normalize(normMat*normal);
-		Tangent = normalize(normMat*tangent);
+		Normal = normalize(normMat*decodeOctahedral(normal));
+		Tangent = normalize(normMat*decodeTangent(tangent).xyz);
 		
 		vec4 pos = model*vec4(position, 1.0);
 		Position = vec3(pos.x, pos.y, pos.z);
@@ -1,9 +1,10 @@
 <VERTEX>
 	#version 330 core
 	#include "CommonSharedVars.glsl"
+	#include "CommonVertex.glsl"
 
 	in vec3 position;
-	in vec3 normal;
+	in vec2 normal;
 
 	out vec3 Position;
 	out vec3 Normal;
@@ -14,7 +15,7 @@
 	{
 		mat3 normMat = inverse(mat3(model));
 		normMat = transpose(normMat);
-		Normal = normalize(normMat*normal);
+		Normal = normalize(normMat*decodeOctahedral(normal));
 
 		vec4 pos = model*vec4(position, 1.0);
 		Position = pos.xyz;
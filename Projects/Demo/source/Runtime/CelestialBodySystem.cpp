@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "CelestialBodySystem.h"
 
+#include <EtCore/UpdateCycle/TickManager.h>
+
 #include <EtFramework/Systems/TransformSystem.h>
 
 
@@ -28,7 +30,7 @@ void CelestialBodySystem::Process(fw::ComponentRange<CelestialBodySystemView>& r
 {
 	// common variables
 	bool const toggle = (core::InputManager::GetInstance()->GetKeyState(E_KbdKey::R) == E_KeyState::Pressed);
-	float const dt = core::ContextManager::GetInstance()->GetActiveContext()->time->DeltaTime();
+	float const dt = core::TickManager::GetInstance()->GetFixedTimestep();
 
 	for (CelestialBodySystemView& view : range)
 	{
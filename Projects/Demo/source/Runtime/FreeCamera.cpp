@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "FreeCamera.h"
 
+#include <EtCore/UpdateCycle/TickManager.h>
 #include <EtCore/Reflection/Registration.h>
 
 #include <EtFramework/Systems/TransformSystem.h>
@@ -53,7 +54,7 @@ void FreeCameraSystem::Process(fw::ComponentRange<FreeCameraSystemView>& range)
 {
 	// common variables
 	core::InputManager* const input = core::InputManager::GetInstance();
-	float const dt = core::ContextManager::GetInstance()->GetActiveContext()->time->DeltaTime();
+	float const dt = core::TickManager::GetInstance()->GetFixedTimestep();
 
 	for (FreeCameraSystemView& view : range)
 	{
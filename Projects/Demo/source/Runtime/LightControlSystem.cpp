@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "LightControlSystem.h"
 
+#include <EtCore/UpdateCycle/TickManager.h>
+
 #include <EtFramework/Systems/TransformSystem.h>
 
 
@@ -28,7 +30,7 @@ void LightControlSystem::Process(fw::ComponentRange<LightControlSystemView>& ran
 {
 	// common vars
 	core::InputManager* const input = core::InputManager::GetInstance();
-	float const dt = core::ContextManager::GetInstance()->GetActiveContext()->time->DeltaTime();
+	float const dt = core::TickManager::GetInstance()->GetFixedTimestep();
 
 	// since input is likely to be rarer than the entity count in the range, we check it once and iterate multiple times
 	
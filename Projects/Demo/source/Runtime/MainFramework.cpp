@@ -151,7 +151,7 @@ void MainFramework::OnTick()
 		{
 			render::TextRenderer& textRenderer = sceneRenderer->GetTextRenderer();
 
-			textRenderer.SetFont(m_DebugFont.get());
+			textRenderer.SetFont(m_DebugFont);
 			textRenderer.SetColor(vec4(1, 0.3f, 0.3f, 1));
 			std::string outString = "FPS: " + std::to_string(PERFORMANCE->GetRegularFPS());
 			textRenderer.DrawText(outString, vec2(20, 20 + (m_DebugFont->GetFontSize()*1.1f) * 1));
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "SpawnSystem.h"
 
+#include <EtCore/UpdateCycle/TickManager.h>
+
 #include <EtFramework/Systems/RigidBodySystem.h>
 #include <EtFramework/Components/RigidBodyComponent.h>
 #include <EtFramework/Components/ModelComponent.h>
@@ -39,7 +41,7 @@ void SpawnSystem::Process(fw::ComponentRange<SpawnSystemView>& range)
 
 	// common variables
 	fw::EcsCommandBuffer& cb = GetCommandBuffer();
-	float const dt = core::ContextManager::GetInstance()->GetActiveContext()->time->DeltaTime();
+	float const dt = core::TickManager::GetInstance()->GetFixedTimestep();
 
 	for (SpawnSystemView& view : range)
 	{
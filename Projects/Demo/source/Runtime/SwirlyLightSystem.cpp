@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "SwirlyLightSystem.h"
 
+#include <EtCore/UpdateCycle/TickManager.h>
+
 #include <EtFramework/Systems/TransformSystem.h>
 
 
@@ -27,7 +29,7 @@ SwirlyLightSystem::SwirlyLightSystem()
 void SwirlyLightSystem::Process(fw::ComponentRange<SwirlyLightSystemView>& range)
 {
 	// common vars
-	float const dt = core::ContextManager::GetInstance()->GetActiveContext()->time->DeltaTime();
+	float const dt = core::TickManager::GetInstance()->GetFixedTimestep();
 
 	for (SwirlyLightSystemView& view : range)
 	{